@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// freeze_tuner.cpp
+//
+// Identification: src/brain/freeze_tuner.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/freeze_tuner.h"
+
+#include "common/logger.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace brain {
+
+FreezeTuner &FreezeTuner::GetInstance() {
+  static FreezeTuner freeze_tuner;
+  return freeze_tuner;
+}
+
+FreezeTuner::FreezeTuner() {
+  // Nothing to do here !
+}
+
+FreezeTuner::~FreezeTuner() {
+  // Nothing to do here !
+}
+
+void FreezeTuner::Start() {
+  // Set signal
+  freeze_tuning_stop = false;
+
+  // Launch thread
+  freeze_tuner_thread = std::thread(&brain::FreezeTuner::Tune, this);
+}
+
+oid_t FreezeTuner::FreezeTable(storage::DataTable *table) {
+  oid_t frozen_count = 0;
+  oid_t tile_group_count = table->GetTileGroupCount();
+  if (tile_group_count <= hot_tile_group_count) return frozen_count;
+
+  for (oid_t tile_group_offset = 0;
+       tile_group_offset < tile_group_count - hot_tile_group_count;
+       tile_group_offset++) {
+    if (table->GetTileGroup(tile_group_offset)->IsFrozen()) continue;
+
+    if (table->FreezeTileGroup(tile_group_offset)) {
+      frozen_count++;
+    }
+  }
+
+  return frozen_count;
+}
+
+void FreezeTuner::Tune() {
+  // Continue till signal is not false
+  while (freeze_tuning_stop == false) {
+    {
+      std::lock_guard<std::mutex> lock(freeze_tuner_mutex);
+
+      // Go over all tables
+      for (auto table : tables) {
+        auto frozen_count = FreezeTable(table);
+        if (frozen_count > 0) {
+          LOG_TRACE("Froze %u tile groups of table %u", frozen_count,
+                    table->GetOid());
+        }
+      }
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+  }
+}
+
+void FreezeTuner::Stop() {
+  // Stop tuning
+  freeze_tuning_stop = true;
+
+  // Stop thread
+  freeze_tuner_thread.join();
+}
+
+void FreezeTuner::AddTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(freeze_tuner_mutex);
+    LOG_TRACE("table : %p", table);
+
+    tables.push_back(table);
+  }
+}
+
+void FreezeTuner::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(freeze_tuner_mutex);
+    tables.clear();
+  }
+}
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -12,6 +12,8 @@
 
 #include <unordered_map>
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 #include "brain/index_tuner.h"
 #include "brain/clusterer.h"
@@ -19,6 +21,7 @@
 #include "catalog/schema.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "index/index_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
@@ -89,8 +92,13 @@ static void AddIndex(storage::DataTable* table,
   std::shared_ptr<index::Index> adhoc_index(
       index::IndexFactory::GetInstance(index_metadata));
 
-  // Add index
-  table->AddIndex(adhoc_index);
+  // Add index, the writers maintain it while it is built
+  table->AddIndexOnline(adhoc_index);
+
+  // Tuples inserted by the writers that did not see it are now in the table
+  // for BuildIndex to index
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.WaitForRunningTransactions();
 
   LOG_TRACE("Added suggested index : %s", index_metadata->GetInfo().c_str());
 
@@ -99,48 +107,17 @@ static void AddIndex(storage::DataTable* table,
 void IndexTuner::BuildIndex(storage::DataTable *table,
                             std::shared_ptr<index::Index> index) {
 
-  auto table_schema = table->GetSchema();
-  auto index_tile_group_offset = index->GetIndexedTileGroupOff();
-  auto table_tile_group_count = table->GetTileGroupCount();
-  oid_t tile_groups_indexed = 0;
-
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  while (index_tile_group_offset < table_tile_group_count &&
-      (tile_groups_indexed < max_tile_groups_indexed)) {
-
-    std::unique_ptr<storage::Tuple> tuple_ptr(new storage::Tuple(table_schema, true));
-
-    auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-      // Copy over the tuple
-      tile_group->CopyTuple(tuple_id, tuple_ptr.get());
-
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
-
-      // Set the key
-      key->SetFromTuple(tuple_ptr.get(), indexed_columns, index->GetPool());
-
-      // Insert in specific index
-      index->InsertEntry(key.get(), location);
-    }
-
-    // Update indexed tile group offset (set of tgs indexed)
-    index->IncrementIndexedTileGroupOffset();
-
-    // Sleep a bit
-    //std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
-
-    index_tile_group_offset++;
-    tile_groups_indexed++;
+  // Leave the cores to the writers in proportion to the writes
+  size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+  if (average_write_ratio != INVALID_RATIO) {
+    thread_count =
+        std::max<size_t>(1, thread_count * (1 - average_write_ratio));
   }
 
+  // Index the next tile groups of the index, it is readable once all are
+  table->BuildIndex(index, max_tile_groups_indexed, thread_count,
+                    sleep_duration);
+
 }
 
 void IndexTuner::BuildIndices(storage::DataTable *table) {
@@ -182,7 +159,7 @@ double IndexTuner::ComputeWorkloadWriteRatio(const std::vector<brain::Sample>& s
   // Compute write ratio
   auto total_duration = total_read_duration + total_write_duration;
   PL_ASSERT(total_duration > 0);
-  write_ratio = total_read_duration / (total_duration);
+  write_ratio = total_write_duration / (total_duration);
 
   // Compute exponential moving average
   if(average_write_ratio == INVALID_RATIO) {
@@ -195,7 +172,6 @@ double IndexTuner::ComputeWorkloadWriteRatio(const std::vector<brain::Sample>& s
 
   LOG_INFO("Average write Ratio : %.2lf", average_write_ratio);
 
-  // TODO: Use average write ratio to throttle index creation
   return average_write_ratio;
 }
 
@@ -235,8 +211,10 @@ GetFrequentSamples(const std::vector<brain::Sample>& samples){
   for(sample_frequency_map_itr = sample_frequency_map.begin();
       sample_frequency_map_itr != sample_frequency_map.end();
       ++sample_frequency_map_itr) {
-    // Normalize sample's utility
-    sample_frequency_map_itr->second /= total_metric;
+    // Normalize sample's utility, scans matching no tuple have none
+    if(total_metric > 0) {
+      sample_frequency_map_itr->second /= total_metric;
+    }
   }
 
   std::vector<sample_frequency_map_entry> sample_frequency_entry_list;
@@ -470,12 +448,14 @@ void PrintIndexInformation(storage::DataTable* table) {
 
 void IndexTuner::Analyze(storage::DataTable* table) {
 
-  // Process all samples in table
-  auto& samples = table->GetIndexSamples();
-  auto sample_count = samples.size();
-
   // Check if we have sufficient number of samples
-  if (sample_count < sample_count_threshold) {
+  if (table->GetIndexSampleCount() < sample_count_threshold) {
+    return;
+  }
+
+  // Process all samples in table, the executors keep recording new ones
+  auto samples = table->TakeIndexSamples();
+  if (samples.empty()) {
     return;
   }
 
@@ -501,9 +481,6 @@ void IndexTuner::Analyze(storage::DataTable* table) {
   // Add indexes if needed
   AddIndexes(table, suggested_indices, max_indexes_allowed);
 
-  // Clear all current samples in table
-  table->ClearIndexSamples();
-
   // Update index utility
   UpdateIndexUtility(table, sample_frequency_entry_list);
 
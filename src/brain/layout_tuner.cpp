@@ -52,7 +52,7 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
                              new_sample_weight);
 
   // Process all samples in table
-  auto& samples = table->GetLayoutSamples();
+  auto samples = table->TakeLayoutSamples();
 
   // Check if we have any samples
   if (samples.empty()) {
@@ -63,9 +63,6 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
     clusterer.ProcessSample(sample);
   }
 
-  // Clear all samples in table
-  table->ClearLayoutSamples();
-
   // Desired number of tiles
   auto layout = clusterer.GetPartitioning(tile_count);
 
@@ -20,6 +20,17 @@
 namespace peloton {
 namespace brain {
 
+Sample::Sample(const size_t column_count, const std::vector<oid_t> &column_ids,
+               double weight, SampleType sample_type, double metric)
+    : columns_accessed_(std::vector<double>(column_count, 0)),
+      weight_(weight),
+      sample_type_(sample_type),
+      metric_(metric) {
+  for (auto column_id : column_ids) {
+    if (column_id < column_count) columns_accessed_[column_id] = 1;
+  }
+}
+
 double Sample::GetDistance(const Sample &other) const {
   double dist = 0;
 
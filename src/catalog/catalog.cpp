@@ -10,11 +10,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "index/index_factory.h"
+#include "optimizer/stats_collector.h"
 
 #define CATALOG_DATABASE_NAME "catalog_db"
 #define DATABASE_CATALOG_NAME "database_catalog"
@@ -88,6 +92,7 @@ Result Catalog::CreateTable(std::string database_name, std::string table_name,
         database_id, table_id, schema.release(), table_name,
         DEFAULT_TUPLES_PER_TILEGROUP, own_schema, adapt_table);
     GetDatabaseWithOid(database_id)->AddTable(table);
+    optimizer::StatsCollector::GetInstance().AddTable(table);
 
     // Create the primary key index for that table
     CreatePrimaryIndex(database_name, table_name);
@@ -159,7 +164,8 @@ Result Catalog::CreateIndex(const std::string &database_name,
                             const std::string &table_name,
                             std::vector<std::string> index_attr,
                             std::string index_name, bool unique,
-                            IndexType index_type) {
+                            IndexType index_type,
+                            concurrency::Transaction *txn) {
 
   auto database = GetDatabaseWithName(database_name);
   if (database != nullptr) {
@@ -208,10 +214,26 @@ Result Catalog::CreateIndex(const std::string &database_name,
           INDEX_CONSTRAINT_TYPE_UNIQUE, schema, key_schema, key_attrs, true);
     }
 
-    // Add index to table
+    // Add index to table and build it without blocking the writers
     std::shared_ptr<index::Index> key_index(
         index::IndexFactory::GetInstance(index_metadata));
-    table->AddIndex(key_index);
+    table->AddIndexOnline(key_index);
+
+    // Tuples inserted by the writers that did not see it are now in the table
+    // for BuildIndex to index. The statement's own transaction never writes
+    // the table.
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    if (txn != nullptr) {
+      txn_manager.WaitForOtherTransactions(txn);
+    } else {
+      txn_manager.WaitForRunningTransactions();
+    }
+
+    size_t thread_count = std::max(1u, std::thread::hardware_concurrency() / 2);
+    while (table->BuildIndex(key_index, INDEX_BUILD_TILE_GROUP_COUNT,
+                             thread_count, INDEX_BUILD_SLEEP_DURATION) ==
+           false) {
+    }
 
     LOG_TRACE("Successfully add index for table %s", table->GetName().c_str());
     return Result::RESULT_SUCCESS;
@@ -234,6 +256,11 @@ Result Catalog::DropDatabase(std::string database_name, concurrency::Transaction
     for (auto database : databases) {
       if (database->GetDBName() == database_name) {
         LOG_TRACE("Deleting database object in database vector");
+        for (oid_t table_itr = 0; table_itr < database->GetTableCount();
+             table_itr++) {
+          optimizer::StatsCollector::GetInstance().RemoveTable(
+              database->GetTable(table_itr));
+        }
         delete database;
         break;
       }
@@ -267,6 +294,7 @@ Result Catalog::DropTable(std::string database_name, std::string table_name, con
                                ->GetTableWithName(TABLE_CATALOG_NAME),
                            table_id, txn);
       LOG_TRACE("Deleting table!");
+      optimizer::StatsCollector::GetInstance().RemoveTable(table);
       database->DropTableWithOid(table_id);
       return Result::RESULT_SUCCESS;
     } else {
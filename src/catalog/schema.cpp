@@ -81,6 +81,12 @@ Schema::Schema(const std::vector<Column> &columns)
     for (auto constraint : columns[column_itr].constraints)
       AddConstraint(column_itr, constraint);
   }
+
+  // Keep the storage options
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    this->columns[column_itr].is_dictionary_encoded =
+        columns[column_itr].is_dictionary_encoded;
+  }
 }
 
 // Copy schema
@@ -17,6 +17,30 @@ DEFINE_uint64(port, 5432, "Peloton port (default: 5432)");
 DEFINE_uint64(max_connections, 64,
               "Maximum number of connections (default: 64)");
 
+DEFINE_uint64(event_loops, 0,
+              "Number of wire server event loops, one per core if 0 "
+              "(default: 0)");
+
+DEFINE_uint64(plan_cache_size, 1000,
+              "Number of query plans cached across connections "
+              "(default: 1000)");
+
+DEFINE_uint64(import_threads, 0,
+              "Number of threads parsing a bulk import, one per core if 0 "
+              "(default: 0)");
+
+DEFINE_uint64(import_chunk_size, 4 << 20,
+              "Bytes of input parsed at a time by a bulk import thread "
+              "(default: 4MB)");
+
+DEFINE_uint64(parallel_degree, 1,
+              "Number of threads a query scans a table with, one per core "
+              "if 0 (default: 1)");
+
+DEFINE_bool(auto_analyze, true,
+            "Analyze tables in the background once enough of them changed "
+            "(default: true)");
+
 DEFINE_string(socket_family, "AF_INET", "Socket family (AF_UNIX, AF_INET)");
 
 DEFINE_bool(h, false, "Show help");
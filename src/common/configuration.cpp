@@ -16,6 +16,9 @@
 // Layout mode
 int peloton_layout_mode = LAYOUT_TYPE_ROW;
 
+// Sampling rate of the accesses of the tables for the brain
+int peloton_sample_rate = 64;
+
 // Logging mode
 LoggingType peloton_logging_mode = LOGGING_TYPE_INVALID;
 
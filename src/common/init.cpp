@@ -13,6 +13,7 @@
 #include "common/init.h"
 #include "common/thread_pool.h"
 #include "common/config.h"
+#include "optimizer/stats_collector.h"
 
 #include "libcds/cds/init.h"
 
@@ -30,10 +31,16 @@ void PelotonInit::Initialize() {
   cds::Initialize();
 
   thread_pool.Initialize(std::thread::hardware_concurrency());
+
+  if (FLAGS_auto_analyze) {
+    optimizer::StatsCollector::GetInstance().Start();
+  }
 }
 
 void PelotonInit::Shutdown() {
 
+  optimizer::StatsCollector::GetInstance().Stop();
+
   // Terminate CDS library
   cds::Terminate();
 
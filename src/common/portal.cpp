@@ -14,22 +14,28 @@
 #include "common/portal.h"
 #include "common/logger.h"
 #include "common/statement.h"
+#include "executor/plan_executor.h"
 
 namespace peloton {
 
 
 Portal::Portal(const std::string& portal_name,
                std::shared_ptr<Statement> statement,
-               const std::vector<std::pair<int, std::string>>& bind_parameters)
+               const std::vector<std::pair<int, std::string>>& bind_parameters,
+               const std::vector<Value>& param_values,
+               const std::vector<int16_t>& result_formats)
 : portal_name(portal_name),
   statement(statement),
-  bind_parameters(bind_parameters) {
+  bind_parameters(bind_parameters),
+  param_values(param_values),
+  result_formats(result_formats) {
 
 
 }
 
 Portal::~Portal() {
 
+  cursor.reset();
   statement.reset();
 
 }
@@ -38,5 +44,35 @@ std::shared_ptr<Statement> Portal::GetStatement() const {
   return statement;
 }
 
+const std::vector<Value>& Portal::GetParamValues() const {
+  return param_values;
+}
+
+std::vector<int16_t> Portal::GetResultFormats(size_t column_count) const {
+  if (result_formats.size() == 1) {
+    return std::vector<int16_t>(column_count, result_formats[0]);
+  }
+
+  std::vector<int16_t> formats(column_count, 0);
+  for (size_t column_itr = 0;
+       column_itr < column_count && column_itr < result_formats.size();
+       column_itr++) {
+    formats[column_itr] = result_formats[column_itr];
+  }
+  return formats;
+}
+
+bridge::PlanCursor *Portal::GetCursor() const {
+  return cursor.get();
+}
+
+void Portal::SetCursor(bridge::PlanCursor *cursor) {
+  this->cursor.reset(cursor);
+}
+
+std::unique_ptr<bridge::PlanCursor> Portal::ReleaseCursor() {
+  return std::move(cursor);
+}
+
 
 }  // namespace peloton
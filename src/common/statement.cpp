@@ -12,6 +12,7 @@
 
 #include "common/statement.h"
 #include "common/logger.h"
+#include "executor/plan_executor.h"
 #include "planner/abstract_plan.h"
 
 namespace peloton {
@@ -56,6 +57,8 @@ void Statement::SetTupleDescriptor(
 }
 
 void Statement::SetPlanTree(std::shared_ptr<planner::AbstractPlan> plan_tree_) {
+  // The executors of the idle cursor refer to the previous plan
+  idle_cursor.reset();
   plan_tree = std::move(plan_tree_);
 }
 
@@ -63,4 +66,22 @@ const std::shared_ptr<planner::AbstractPlan>& Statement::GetPlanTree() const {
   return plan_tree;
 }
 
+void Statement::SetParamValues(const std::vector<Value>& param_values_) {
+  param_values = param_values_;
+}
+
+const std::vector<Value>& Statement::GetParamValues() const {
+  return param_values;
+}
+
+std::unique_ptr<bridge::PlanCursor> Statement::TakeCursor() {
+  return std::move(idle_cursor);
+}
+
+void Statement::KeepCursor(std::unique_ptr<bridge::PlanCursor> cursor) {
+  if (cursor != nullptr && cursor->IsReusable()) {
+    idle_cursor = std::move(cursor);
+  }
+}
+
 }  // namespace peloton
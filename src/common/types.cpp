@@ -403,6 +403,7 @@ std::string StatementTypeToString(StatementType type) {
   switch (type) {
     case STATEMENT_TYPE_SELECT: { return "SELECT"; }
     case STATEMENT_TYPE_ALTER: { return "ALTER"; }
+    case STATEMENT_TYPE_ANALYZE: { return "ANALYZE"; }
     case STATEMENT_TYPE_CREATE: { return "CREATE"; }
     case STATEMENT_TYPE_DELETE: { return "DELETE"; }
     case STATEMENT_TYPE_DROP: { return "DROP"; }
@@ -702,6 +703,7 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PLAN_NODE_TYPE_SEND: { return "SEND"; }
     case PLAN_NODE_TYPE_RECEIVE: { return "RECEIVE"; }
     case PLAN_NODE_TYPE_PRINT: { return "PRINT"; }
+    case PLAN_NODE_TYPE_EXCHANGE: { return "EXCHANGE"; }
     case PLAN_NODE_TYPE_AGGREGATE: { return "AGGREGATE"; }
     case PLAN_NODE_TYPE_HASHAGGREGATE: { return "HASHAGGREGATE"; }
     case PLAN_NODE_TYPE_UNION: { return "UNION"; }
@@ -718,6 +720,8 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PLAN_NODE_TYPE_HASH: { return "HASH"; }
     case PLAN_NODE_TYPE_DROP: { return "DROP"; }
     case PLAN_NODE_TYPE_CREATE: { return "CREATE"; }
+    case PLAN_NODE_TYPE_IMPORT: { return "IMPORT"; }
+    case PLAN_NODE_TYPE_ANALYZE: { return "ANALYZE"; }
   }
   return "INVALID";
 }
@@ -741,12 +745,18 @@ PlanNodeType StringToPlanNodeType(const std::string& str) {
     return PLAN_NODE_TYPE_INSERT;
   } else if (str == "DELETE") {
     return PLAN_NODE_TYPE_DELETE;
+  } else if (str == "IMPORT") {
+    return PLAN_NODE_TYPE_IMPORT;
+  } else if (str == "ANALYZE") {
+    return PLAN_NODE_TYPE_ANALYZE;
   } else if (str == "SEND") {
     return PLAN_NODE_TYPE_SEND;
   } else if (str == "RECEIVE") {
     return PLAN_NODE_TYPE_RECEIVE;
   } else if (str == "PRINT") {
     return PLAN_NODE_TYPE_PRINT;
+  } else if (str == "EXCHANGE") {
+    return PLAN_NODE_TYPE_EXCHANGE;
   } else if (str == "AGGREGATE") {
     return PLAN_NODE_TYPE_AGGREGATE;
   } else if (str == "HASHAGGREGATE") {
@@ -1004,6 +1014,11 @@ ValueType PostgresValueTypeToPelotonValueType(
       value_type = VALUE_TYPE_VARCHAR;
       break;
 
+    /* BINARY */
+    case POSTGRES_VALUE_TYPE_BYTEA:
+      value_type = VALUE_TYPE_VARBINARY;
+      break;
+
     /* DATE */
     case POSTGRES_VALUE_TYPE_DATE:
       value_type = VALUE_TYPE_DATE;
@@ -54,6 +54,10 @@ bool AbstractJoinExecutor::DInit() {
   join_type_ = node.GetJoinType();
   proj_schema_ = node.GetSchema();
 
+  // Compiled predicates fold the parameters of the execution in
+  compiled_predicate_.reset();
+  predicate_compile_attempted_ = false;
+
   return true;
 }
 
@@ -356,6 +360,30 @@ void AbstractJoinExecutor::UpdateFullJoinRowSets() {
   UpdateRightJoinRowSets();
 }
 
+/**
+ * @brief Compile the join predicate for the input column types on first use
+ * and point it at the given pair of tiles.
+ * @return true if the compiled predicate can be used for this pair, false if
+ * the caller should interpret the predicate instead.
+ */
+bool AbstractJoinExecutor::BindCompiledPredicate(LogicalTile *left_tile,
+                                                 LogicalTile *right_tile) {
+  if (predicate_ == nullptr) return false;
+
+  if (compiled_predicate_ == nullptr) {
+    if (predicate_compile_attempted_) return false;
+    predicate_compile_attempted_ = true;
+    compiled_predicate_ = expression::CompiledExpression::Compile(
+        predicate_, expression::CompiledExpression::GetColumnTypes(left_tile),
+        expression::CompiledExpression::GetColumnTypes(right_tile),
+        executor_context_);
+    if (compiled_predicate_ == nullptr) return false;
+  }
+
+  return compiled_predicate_->Bind(0, left_tile) &&
+         compiled_predicate_->Bind(1, right_tile);
+}
+
 /**
  * In some case, outer join results can be determined only after all inner
  * join results are constructed, because, in order to build outer join result,
@@ -13,15 +13,19 @@
 
 #include "executor/abstract_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "brain/sample.h"
 #include "common/types.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
 #include "expression/container_tuple.h"
+#include "expression/expression_util.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 
@@ -53,9 +57,78 @@ bool AbstractScanExecutor::DInit() {
   // auto column_ids = node.GetColumnIds();
 
   column_ids_ = std::move(node.GetColumnIds());
+  sample_recorded_ = false;
 
+  zone_map_predicate_.reset();
+  if (predicate_ != nullptr) {
+    // Parameters are compared as the columns they are compared to, by the
+    // predicate and the zone maps alike
+    std::vector<ValueType> param_types;
+    expression::ExpressionUtil::GetParameterTypes(predicate_, param_types);
+    executor_context_->CastParams(param_types);
+
+    zone_map_predicate_.reset(new storage::ZoneMapPredicate(
+        predicate_, executor_context_->GetParams()));
+    if (zone_map_predicate_->IsEmpty()) zone_map_predicate_.reset();
+  }
+
+  return true;
+}
+
+bool AbstractScanExecutor::SkipTileGroup(
+    const storage::TileGroup *tile_group) {
+  if (zone_map_predicate_ == nullptr) return false;
+
+  if (zone_map_predicate_->CanSkip(tile_group->GetZoneMap()) == false)
+    return false;
+
+  LOG_TRACE("Skipping tile group %u", tile_group->GetTileGroupId());
+  executor_context_->num_tile_groups_skipped++;
   return true;
 }
 
+void AbstractScanExecutor::RecordSample(
+    storage::DataTable *table, const std::vector<oid_t> &key_column_ids,
+    size_t tuples_read, size_t tuples_returned) {
+  if (table == nullptr || sample_recorded_) return;
+  sample_recorded_ = true;
+  if (table->SampleAccess() == false) return;
+
+  std::vector<oid_t> predicate_column_ids(key_column_ids);
+  std::vector<int> predicate_columns;
+  expression::ExpressionUtil::ExtractTupleValuesColumnIdx(predicate_,
+                                                          predicate_columns);
+  for (auto column_id : predicate_columns) {
+    predicate_column_ids.push_back(column_id);
+  }
+
+  std::vector<oid_t> accessed_column_ids(column_ids_);
+  accessed_column_ids.insert(accessed_column_ids.end(),
+                             predicate_column_ids.begin(),
+                             predicate_column_ids.end());
+
+  // The work of the scan weighs its sample against those of the writes
+  auto column_count = table->GetSchema()->GetColumnCount();
+  double weight = std::max<size_t>(tuples_read, 1);
+  table->RecordLayoutSample(
+      brain::Sample(column_count, accessed_column_ids, weight));
+
+  // Scans without a predicate have no use for an index
+  if (predicate_column_ids.empty()) return;
+
+  // Index samples hold the ids of the columns an index would be built on
+  std::sort(predicate_column_ids.begin(), predicate_column_ids.end());
+  predicate_column_ids.erase(
+      std::unique(predicate_column_ids.begin(), predicate_column_ids.end()),
+      predicate_column_ids.end());
+  std::vector<double> index_columns(predicate_column_ids.begin(),
+                                    predicate_column_ids.end());
+
+  double tuple_count = std::max<size_t>(table->GetTupleCount(), 1);
+  double selectivity = std::min(1.0, tuples_returned / tuple_count);
+  table->RecordIndexSample(brain::Sample(
+      index_columns, weight, brain::SAMPLE_TYPE_ACCESS, selectivity));
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -173,45 +173,70 @@ HashAggregator::~HashAggregator() {
 }
 
 bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
-  AggregateList *aggregate_list;
-
-  // Configure a group-by-key and search for the required group.
-  group_by_key_values.clear();
-  for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
-       column_itr++) {
-    Value cur_tuple_val =
-        cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
-    group_by_key_values.push_back(cur_tuple_val);
+  AggregateList *aggregate_list = nullptr;
+
+  // Single dictionary encoded group-by column : look the group up by code
+  const storage::Dictionary *dictionary = nullptr;
+  storage::Dictionary::Code code = storage::Dictionary::NULL_CODE;
+  bool has_code =
+      (node->GetGroupbyColIds().size() == 1 &&
+       cur_tuple->GetDictionaryCode(node->GetGroupbyColIds()[0], &dictionary,
+                                    &code) &&
+       code != storage::Dictionary::NULL_CODE);
+  if (has_code && dictionary == code_dictionary && code < code_groups.size()) {
+    aggregate_list = code_groups[code];
   }
 
-  auto map_itr = aggregates_map.find(group_by_key_values);
-
-  // Group not found. Make a new entry in the hash for this new group.
-  if (map_itr == aggregates_map.end()) {
-    LOG_TRACE("Group-by key not found. Start a new group.");
-    // Allocate new aggregate list
-    aggregate_list = new AggregateList();
-    aggregate_list->aggregates = new Agg *[node->GetUniqueAggTerms().size()];
-    // Make a deep copy of the first tuple we meet
-    for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
-      aggregate_list->first_tuple_values.push_back(
-          ValueFactory::Clone(cur_tuple->GetValue(col_id), nullptr));
-    };
+  if (aggregate_list == nullptr) {
+    // Configure a group-by-key and search for the required group.
+    group_by_key_values.clear();
+    for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
+         column_itr++) {
+      Value cur_tuple_val =
+          cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
+      group_by_key_values.push_back(cur_tuple_val);
+    }
 
-    for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
-      aggregate_list->aggregates[aggno] =
-          GetAggInstance(node->GetUniqueAggTerms()[aggno].aggtype);
+    auto map_itr = aggregates_map.find(group_by_key_values);
+
+    // Group not found. Make a new entry in the hash for this new group.
+    if (map_itr == aggregates_map.end()) {
+      LOG_TRACE("Group-by key not found. Start a new group.");
+      // Allocate new aggregate list
+      aggregate_list = new AggregateList();
+      aggregate_list->aggregates = new Agg *[node->GetUniqueAggTerms().size()];
+      // Make a deep copy of the first tuple we meet
+      for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
+        aggregate_list->first_tuple_values.push_back(
+            ValueFactory::Clone(cur_tuple->GetValue(col_id), nullptr));
+      };
+
+      for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size();
+           aggno++) {
+        aggregate_list->aggregates[aggno] =
+            GetAggInstance(node->GetUniqueAggTerms()[aggno].aggtype);
+
+        bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
+        aggregate_list->aggregates[aggno]->SetDistinct(distinct);
+      }
 
-      bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
-      aggregate_list->aggregates[aggno]->SetDistinct(distinct);
+      aggregates_map.insert(HashAggregateMapType::value_type(
+          group_by_key_values, aggregate_list));
+    }
+    // Otherwise, the list is the second item of the pair.
+    else {
+      aggregate_list = map_itr->second;
     }
 
-    aggregates_map.insert(
-        HashAggregateMapType::value_type(group_by_key_values, aggregate_list));
-  }
-  // Otherwise, the list is the second item of the pair.
-  else {
-    aggregate_list = map_itr->second;
+    // Remember the group under its code. Only the first dictionary seen is
+    // cached, rows coded by any other dictionary keep using the hash table.
+    if (has_code) {
+      if (code_dictionary == nullptr) code_dictionary = dictionary;
+      if (dictionary == code_dictionary) {
+        if (code >= code_groups.size()) code_groups.resize(code + 1, nullptr);
+        code_groups[code] = aggregate_list;
+      }
+    }
   }
 
   // Update the aggregation calculation
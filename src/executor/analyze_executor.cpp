@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.cpp
+//
+// Identification: src/executor/analyze_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/analyze_executor.h"
+
+#include "catalog/bootstrapper.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "optimizer/plan_cache.h"
+#include "optimizer/stats_collector.h"
+#include "planner/analyze_plan.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for analyze executor.
+ * @param node Analyze node corresponding to this executor.
+ */
+AnalyzeExecutor::AnalyzeExecutor(const planner::AbstractPlan *node,
+                                 ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+bool AnalyzeExecutor::DInit() {
+  PL_ASSERT(children_.size() == 0);
+  return true;
+}
+
+/**
+ * @brief Analyze the table of the plan, or every table of the database.
+ * @return false, there are no tiles to return.
+ */
+bool AnalyzeExecutor::DExecute() {
+  const planner::AnalyzePlan &node = GetPlanNode<planner::AnalyzePlan>();
+  auto &stats_collector = optimizer::StatsCollector::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  if (node.GetTable() != nullptr) {
+    stats_collector.Analyze(node.GetTable(), current_txn);
+
+    // Plans cached before were costed with the old statistics
+    optimizer::PlanCache::GetInstance().Clear();
+    return false;
+  }
+
+  if (node.GetTableName().empty() == false) {
+    LOG_ERROR("Table %s not found", node.GetTableName().c_str());
+    auto &transaction_manager =
+        concurrency::TransactionManagerFactory::GetInstance();
+    transaction_manager.SetTransactionResult(current_txn,
+                                             Result::RESULT_FAILURE);
+    return false;
+  }
+
+  auto database =
+      catalog::Bootstrapper::global_catalog->GetDatabaseWithName(
+          DEFAULT_DB_NAME);
+  if (database == nullptr) return false;
+
+  for (oid_t table_itr = 0; table_itr < database->GetTableCount();
+       table_itr++) {
+    stats_collector.Analyze(database->GetTable(table_itr), current_txn);
+  }
+  optimizer::PlanCache::GetInstance().Clear();
+
+  return false;
+}
+
+}  // namespace executor
+}  // namespace peloton
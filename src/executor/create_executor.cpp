@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/bootstrapper.h"
+#include "optimizer/plan_cache.h"
 
 namespace peloton {
 namespace executor {
@@ -70,7 +71,7 @@ bool CreateExecutor::DExecute() {
     
     auto index_attrs = node.GetIndexAttributes();
 
-    Result result = catalog::Bootstrapper::global_catalog->CreateIndex(DEFAULT_DB_NAME, table_name, index_attrs , index_name , unique_flag , index_type);
+    Result result = catalog::Bootstrapper::global_catalog->CreateIndex(DEFAULT_DB_NAME, table_name, index_attrs , index_name , unique_flag , index_type, current_txn);
     current_txn->SetResult(result);
 
     if(current_txn->GetResult() == Result::RESULT_SUCCESS){
@@ -84,6 +85,10 @@ bool CreateExecutor::DExecute() {
     }
 
   }
+
+  // Plans cached before do not know of the new table or index
+  optimizer::PlanCache::GetInstance().Clear();
+
   return false;
 }
 
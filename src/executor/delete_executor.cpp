@@ -156,6 +156,9 @@ bool DeleteExecutor::DExecute() {
     }
   }
 
+  // Sample the write for the index tuner
+  target_table_->RecordWriteSample({}, source_tile->GetTupleCount());
+
   return true;
 }
 
@@ -15,6 +15,7 @@
 
 #include "executor/drop_executor.h"
 #include "catalog/bootstrapper.h"
+#include "optimizer/plan_cache.h"
 
 namespace peloton {
 namespace executor {
@@ -59,6 +60,9 @@ bool DropExecutor::DExecute() {
 	  LOG_TRACE("Result is: %d", current_txn->GetResult());
   }
 
+  // Plans cached before may read the dropped table
+  optimizer::PlanCache::GetInstance().Clear();
+
   return false;
 }
 
@@ -0,0 +1,222 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.cpp
+//
+// Identification: src/executor/exchange_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/exchange_executor.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "planner/exchange_plan.h"
+#include "planner/seq_scan_plan.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Whether the plan is a chain of operators with one input each over a
+ * scan of a table, the only plans whose scan can be split into morsels.
+ */
+static bool IsMorselDriven(const planner::AbstractPlan *plan) {
+  while (plan->GetChildren().size() == 1) {
+    plan = plan->GetChildren()[0].get();
+  }
+  if (plan->GetChildren().size() != 0 ||
+      plan->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN) {
+    return false;
+  }
+  return static_cast<const planner::SeqScanPlan *>(plan)->GetTable() !=
+         nullptr;
+}
+
+/**
+ * @brief Constructor for exchange executor.
+ * @param node Exchange node corresponding to this executor.
+ */
+ExchangeExecutor::ExchangeExecutor(const planner::AbstractPlan *node,
+                                   ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context), morsel_cursor_(START_OID) {}
+
+ExchangeExecutor::~ExchangeExecutor() { StopWorkers(); }
+
+/**
+ * @brief Builds and initializes the executor trees of the workers, which
+ * are started by the first call to DExecute().
+ * @return true on success, false otherwise.
+ */
+bool ExchangeExecutor::DInit() {
+  PL_ASSERT(children_.size() == 0);
+
+  StopWorkers();
+
+  const planner::ExchangePlan &node = GetPlanNode<planner::ExchangePlan>();
+  PL_ASSERT(node.GetChildren().size() == 1);
+  auto child_plan = node.GetChildren()[0].get();
+
+  if (IsMorselDriven(child_plan) == false) {
+    LOG_ERROR("Exchange over a plan that is not a chain over a table scan");
+    return false;
+  }
+
+  morsel_cursor_ = START_OID;
+  started_ = false;
+  stopping_ = false;
+  worker_exception_ = nullptr;
+
+  for (size_t worker_itr = 0; worker_itr < node.GetDegreeOfParallelism();
+       worker_itr++) {
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->executor_context.reset(new ExecutorContext(
+        executor_context_->GetTransaction(), executor_context_->GetParams()));
+    worker->executor_context->SetMorselCursor(&morsel_cursor_);
+    worker->executor_tree.reset(bridge::BuildExecutorTree(
+        nullptr, child_plan, worker->executor_context.get()));
+
+    auto status = worker->executor_tree->Init();
+    workers_.push_back(std::move(worker));
+    if (status == false) return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Returns the next tile of any of the workers.
+ * @return true on success, false once every worker is done or one failed.
+ */
+bool ExchangeExecutor::DExecute() {
+  if (started_ == false) {
+    started_ = true;
+    running_workers_ = workers_.size();
+    for (auto &worker : workers_) {
+      worker->thread =
+          std::thread(&ExchangeExecutor::RunWorker, this, worker.get());
+    }
+  }
+
+  std::unique_ptr<LogicalTile> tile;
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    queue_not_empty_.wait(lock, [this] {
+      return stopping_ || queue_.empty() == false || running_workers_ == 0;
+    });
+    if (stopping_ == false && queue_.empty() == false) {
+      tile = std::move(queue_.front());
+      queue_.pop_front();
+    }
+  }
+
+  if (tile != nullptr) {
+    queue_not_full_.notify_one();
+    SetOutput(tile.release());
+    return true;
+  }
+
+  JoinWorkers();
+
+  if (worker_exception_ != nullptr) {
+    auto worker_exception = worker_exception_;
+    worker_exception_ = nullptr;
+    std::rethrow_exception(worker_exception);
+  }
+  return false;
+}
+
+/**
+ * @brief Runs the executor tree of a worker to completion, handing its tiles
+ * over to the queue. Gives up as soon as the executor is stopping.
+ */
+void ExchangeExecutor::RunWorker(Worker *worker) {
+  // Keeps a few tiles per worker in flight
+  const size_t queue_capacity = 2 * workers_.size();
+
+  auto current_txn = worker->executor_context->GetTransaction();
+  std::exception_ptr worker_exception;
+
+  try {
+    while (worker->executor_tree->Execute()) {
+      std::unique_ptr<LogicalTile> tile(worker->executor_tree->GetOutput());
+      if (tile == nullptr || tile->GetTupleCount() == 0) continue;
+
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_not_full_.wait(lock, [this, queue_capacity] {
+        return stopping_ || queue_.size() < queue_capacity;
+      });
+      if (stopping_) break;
+
+      queue_.push_back(std::move(tile));
+      lock.unlock();
+      queue_not_empty_.notify_one();
+    }
+  } catch (...) {
+    worker_exception = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (worker_exception != nullptr && worker_exception_ == nullptr) {
+      worker_exception_ = worker_exception;
+    }
+    // The other workers need not go on once the transaction failed
+    if (worker_exception != nullptr ||
+        current_txn->GetResult() == RESULT_FAILURE) {
+      stopping_ = true;
+    }
+    running_workers_--;
+  }
+  queue_not_empty_.notify_all();
+  queue_not_full_.notify_all();
+}
+
+/**
+ * @brief Waits for the workers to finish and adds their statistics to the
+ * context of the query.
+ */
+void ExchangeExecutor::JoinWorkers() {
+  for (auto &worker : workers_) {
+    if (worker->thread.joinable() == false) continue;
+    worker->thread.join();
+
+    executor_context_->num_processed +=
+        worker->executor_context->num_processed;
+    executor_context_->num_tile_groups_skipped +=
+        worker->executor_context->num_tile_groups_skipped;
+  }
+}
+
+/**
+ * @brief Stops the workers and releases their executor trees.
+ */
+void ExchangeExecutor::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stopping_ = true;
+  }
+  queue_not_full_.notify_all();
+
+  for (auto &worker : workers_) {
+    if (worker->thread.joinable()) worker->thread.join();
+  }
+  queue_.clear();
+
+  for (auto &worker : workers_) {
+    bridge::CleanExecutorTree(worker->executor_tree.get());
+  }
+  workers_.clear();
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
+
 #include "common/value.h"
 #include "executor/executor_context.h"
 #include "concurrency/transaction.h"
@@ -46,6 +48,28 @@ void ExecutorContext::ClearParams() {
   params_.clear();
 }
 
+void ExecutorContext::CastParams(const std::vector<ValueType> &param_types) {
+  auto param_count = std::min(params_.size(), param_types.size());
+  for (size_t param_itr = 0; param_itr < param_count; param_itr++) {
+    auto param_type = param_types[param_itr];
+    if (param_type == VALUE_TYPE_INVALID ||
+        params_[param_itr].GetValueType() == param_type) {
+      continue;
+    }
+    params_[param_itr] = params_[param_itr].CastAs(param_type);
+  }
+}
+
+void ExecutorContext::Reset(concurrency::Transaction *transaction,
+                            const std::vector<Value> &params) {
+  transaction_ = transaction;
+  params_ = params;
+  // Varlen values of the previous execution are not referenced anymore
+  pool_.reset();
+  num_processed = 0;
+  num_tile_groups_skipped = 0;
+}
+
 VarlenPool *ExecutorContext::GetExecutorContextPool() {
   // construct pool if needed
   if (pool_.get() == nullptr) pool_.reset(new VarlenPool(BACKEND_TYPE_MM));
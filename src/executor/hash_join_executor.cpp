@@ -105,6 +105,13 @@ bool HashJoinExecutor::DExecute() {
     auto &hash_table = hash_executor_->GetHashTable();
     auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
 
+    // The left tile is probed on its own key columns when they are given,
+    // otherwise both sides share the key column ids
+    auto &outer_hash_ids =
+        GetPlanNode<planner::HashJoinPlan>().GetOuterHashIds();
+    auto &probe_col_ids =
+        outer_hash_ids.empty() ? hashed_col_ids : outer_hash_ids;
+
     oid_t prev_tile = INVALID_OID;
     std::unique_ptr<LogicalTile> output_tile;
     LogicalTile::PositionListsBuilder pos_lists_builder;
@@ -112,16 +119,25 @@ bool HashJoinExecutor::DExecute() {
     // Go over the left tile
     for (auto left_tile_itr : *left_tile) {
       const expression::ContainerTuple<executor::LogicalTile> left_tuple(
-          left_tile, left_tile_itr, &hashed_col_ids);
+          left_tile, left_tile_itr, &probe_col_ids);
 
       // Find matching tuples in the hash table built on top of the right table
       auto right_tuples = hash_table.find(left_tuple);
 
       if (right_tuples != hash_table.end()) {
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
-
         // Go over the matching right tuples
         for (auto &location : right_tuples->second) {
+          // Check the rest of the join predicate on the matching pair
+          if (predicate_ != nullptr) {
+            const expression::ContainerTuple<executor::LogicalTile>
+                right_tuple(right_result_tiles_[location.first].get(),
+                            location.second);
+            if (predicate_->Evaluate(&left_tuple, &right_tuple,
+                                     executor_context_).IsFalse()) {
+              continue;
+            }
+          }
+
           // Check if we got a new right tile itr
           if (prev_tile != location.first) {
             // Check if we have any join tuples
@@ -149,6 +165,7 @@ bool HashJoinExecutor::DExecute() {
           // Add join tuple
           pos_lists_builder.AddRow(left_tile_itr, location.second);
 
+          RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
           RecordMatchedRightRow(location.first, location.second);
 
           // Cache prev logical tile itr
@@ -12,6 +12,7 @@
 
 
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 #include <string>
@@ -189,6 +190,12 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip tile groups whose zone maps rule out the predicate
+    if (SkipTileGroup(tile_group.get())) {
+      continue;
+    }
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -0,0 +1,572 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_executor.cpp
+//
+// Identification: src/executor/import_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/import_executor.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "catalog/manager.h"
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/pool.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "expression/container_tuple.h"
+#include "index/index.h"
+#include "planner/import_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Parsing
+//===--------------------------------------------------------------------===//
+
+/*
+ * Read the fields of the CSV row at pos and move pos to the next row.
+ * Quoted fields may hold delimiters, newlines and doubled quotes. An
+ * unquoted empty field is NULL, "" is the empty string. Returns false if a
+ * quote is left open.
+ */
+static bool ParseCSVRow(const char *&pos, const char *end,
+                        std::vector<std::string> &fields,
+                        std::vector<bool> &nulls, size_t &field_count) {
+  field_count = 0;
+  for (;;) {
+    if (field_count == fields.size()) {
+      fields.emplace_back();
+      nulls.push_back(false);
+    }
+    auto &field = fields[field_count];
+    field.clear();
+
+    bool quoted = (pos < end && *pos == '"');
+    if (quoted) {
+      pos++;
+      for (;;) {
+        auto quote = static_cast<const char *>(memchr(pos, '"', end - pos));
+        if (quote == nullptr) return false;
+        field.append(pos, quote);
+        pos = quote + 1;
+        if (pos < end && *pos == '"') {
+          field += '"';
+          pos++;
+        } else {
+          break;
+        }
+      }
+    }
+
+    auto field_begin = pos;
+    while (pos < end && *pos != ',' && *pos != '\n') pos++;
+    auto field_end = pos;
+    if (field_end > field_begin && field_end[-1] == '\r' &&
+        (pos == end || *pos == '\n'))
+      field_end--;
+    field.append(field_begin, field_end);
+
+    nulls[field_count] = (!quoted && field.empty());
+    field_count++;
+
+    if (pos < end && *pos == ',') {
+      pos++;
+      continue;
+    }
+    if (pos < end) pos++;
+    return true;
+  }
+}
+
+/*
+ * Read the fields of the row at pos in the text format of COPY : fields
+ * separated by tabs, backslash escapes and \N for NULL. Returns false if
+ * the row is malformed.
+ */
+static bool ParseTextRow(const char *&pos, const char *end,
+                         std::vector<std::string> &fields,
+                         std::vector<bool> &nulls, size_t &field_count) {
+  field_count = 0;
+  for (;;) {
+    if (field_count == fields.size()) {
+      fields.emplace_back();
+      nulls.push_back(false);
+    }
+    auto &field = fields[field_count];
+    field.clear();
+
+    auto field_begin = pos;
+    bool null = false;
+    while (pos < end && *pos != '\t' && *pos != '\n') {
+      if (*pos != '\\') {
+        auto run = pos;
+        while (pos < end && *pos != '\t' && *pos != '\n' && *pos != '\\')
+          pos++;
+        field.append(run, pos);
+        continue;
+      }
+
+      if (++pos == end) return false;
+      switch (*pos) {
+        case 'N':
+          null = true;
+          break;
+        case 't':
+          field += '\t';
+          break;
+        case 'n':
+          field += '\n';
+          break;
+        case 'r':
+          field += '\r';
+          break;
+        case 'b':
+          field += '\b';
+          break;
+        case 'f':
+          field += '\f';
+          break;
+        case 'v':
+          field += '\v';
+          break;
+        default:
+          field += *pos;
+          break;
+      }
+      pos++;
+    }
+    // a raw carriage return ends the row along with the newline
+    if (pos > field_begin && pos[-1] == '\r' && (pos == end || *pos == '\n'))
+      field.pop_back();
+
+    // \N stands for the whole field
+    if (null && !field.empty()) return false;
+    nulls[field_count] = null;
+    field_count++;
+
+    if (pos < end && *pos == '\t') {
+      pos++;
+      continue;
+    }
+    if (pos < end) pos++;
+    return true;
+  }
+}
+
+// The text format may end with a \. line, what follows it is ignored
+static size_t FindEndOfData(const char *data, size_t size) {
+  for (size_t pos = 0; pos + 1 < size; pos++) {
+    auto marker =
+        static_cast<const char *>(memchr(data + pos, '\\', size - pos));
+    if (marker == nullptr) break;
+    pos = marker - data;
+    if (pos + 1 < size && data[pos + 1] == '.' &&
+        (pos == 0 || data[pos - 1] == '\n') &&
+        (pos + 2 == size || data[pos + 2] == '\n' || data[pos + 2] == '\r'))
+      return pos;
+  }
+  return size;
+}
+
+// Convert the text of a field to a value of the column's type
+static Value ParseValue(const std::string &text, ValueType type,
+                        VarlenPool *pool) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT: {
+      char *end;
+      errno = 0;
+      long long number = strtoll(text.c_str(), &end, 10);
+      if (end == text.c_str() || *end != '\0' || errno == ERANGE) {
+        throw ConversionException("invalid integer \"" + text + "\"");
+      }
+      return ValueFactory::GetBigIntValue(number).CastAs(type);
+    }
+    case VALUE_TYPE_DOUBLE: {
+      char *end;
+      double number = strtod(text.c_str(), &end);
+      if (end == text.c_str() || *end != '\0') {
+        throw ConversionException("invalid number \"" + text + "\"");
+      }
+      return ValueFactory::GetDoubleValue(number);
+    }
+    case VALUE_TYPE_VARCHAR:
+      return ValueFactory::GetStringValue(text, pool);
+    default:
+      return ValueFactory::GetStringValue(text).CastAs(type);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Import Executor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Constructor for import executor.
+ * @param node Import node corresponding to this executor.
+ */
+ImportExecutor::ImportExecutor(const planner::AbstractPlan *node,
+                               ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+bool ImportExecutor::DInit() {
+  PL_ASSERT(children_.size() == 0);
+
+  const planner::ImportPlan &node = GetPlanNode<planner::ImportPlan>();
+  target_table_ = node.GetTable();
+  csv_ = (node.GetImportType() == parser::ImportStatement::kImportCSV);
+  done_ = false;
+
+  return true;
+}
+
+/**
+ * @brief Load the whole input into the table.
+ * @return true on success, false otherwise.
+ */
+bool ImportExecutor::DExecute() {
+  if (done_) return false;
+  done_ = true;
+
+  const planner::ImportPlan &node = GetPlanNode<planner::ImportPlan>();
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  if (target_table_ == nullptr) {
+    LOG_ERROR("Table %s not found", node.GetTableName().c_str());
+    transaction_manager.SetTransactionResult(current_txn,
+                                             Result::RESULT_FAILURE);
+    return false;
+  }
+
+  if (node.IsFromStdin()) {
+    auto &input = node.GetInput();
+    return Import(input.data(), input.size());
+  }
+
+  // The file is mapped rather than read, the parsing threads share it
+  auto &file_path = node.GetFilePath();
+  int fd = open(file_path.c_str(), O_RDONLY);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd, &file_stat) < 0) {
+    LOG_ERROR("Failed to open %s : %s", file_path.c_str(), strerror(errno));
+    if (fd >= 0) close(fd);
+    transaction_manager.SetTransactionResult(current_txn,
+                                             Result::RESULT_FAILURE);
+    return false;
+  }
+
+  size_t size = file_stat.st_size;
+  if (size == 0) {
+    close(fd);
+    return Import(nullptr, 0);
+  }
+
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("Failed to map %s : %s", file_path.c_str(), strerror(errno));
+    transaction_manager.SetTransactionResult(current_txn,
+                                             Result::RESULT_FAILURE);
+    return false;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+
+  bool status = Import(static_cast<const char *>(data), size);
+  munmap(data, size);
+  return status;
+}
+
+bool ImportExecutor::Import(const char *data, size_t size) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  if (!csv_) size = FindEndOfData(data, size);
+
+  // Cut the input into chunks of whole rows. Newlines within quoted CSV
+  // fields don't end a row, so the quotes are tracked up to each cut.
+  std::vector<Chunk> chunks;
+  size_t chunk_size = std::max<size_t>(1, FLAGS_import_chunk_size);
+  const char *end = data + size;
+  const char *chunk_begin = data;
+  const char *scan = data;
+  bool quoted = false;
+  while (chunk_begin < end) {
+    auto cut = chunk_begin + std::min<size_t>(chunk_size, end - chunk_begin);
+    if (csv_) {
+      for (; scan < cut; scan++) {
+        if (*scan == '"') quoted = !quoted;
+      }
+    }
+    for (; cut < end; cut++) {
+      if (csv_ && *cut == '"') {
+        quoted = !quoted;
+      } else if (*cut == '\n' && !quoted) {
+        cut++;
+        break;
+      }
+    }
+
+    Chunk chunk;
+    chunk.begin = chunk_begin;
+    chunk.end = cut;
+    chunks.push_back(std::move(chunk));
+    chunk_begin = scan = cut;
+  }
+
+  // Parse the chunks in parallel, the calling thread takes part
+  size_t thread_count = FLAGS_import_threads;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  thread_count = std::min(thread_count, chunks.size());
+
+  std::atomic<size_t> next_chunk(0);
+  auto parse_chunks = [this, &chunks, &next_chunk] {
+    for (size_t chunk_itr = next_chunk++; chunk_itr < chunks.size();
+         chunk_itr = next_chunk++) {
+      ParseChunk(&chunks[chunk_itr]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    threads.push_back(std::thread(parse_chunks));
+  }
+  parse_chunks();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto &chunk : chunks) {
+    if (chunk.error.empty() == false) {
+      LOG_ERROR("Failed to import into %s : %s",
+                target_table_->GetName().c_str(), chunk.error.c_str());
+      transaction_manager.SetTransactionResult(current_txn,
+                                               Result::RESULT_FAILURE);
+      return false;
+    }
+  }
+
+  // Hand the tile groups over to the table in input order and insert their
+  // tuples. They can't be seen before the transaction commits.
+  bool has_indexes = (target_table_->GetIndexCount() > 0);
+  std::vector<ItemPointer *> index_entries;
+  size_t tuple_count = 0;
+  for (auto &chunk : chunks) {
+    for (auto &tile_group : chunk.tile_groups) {
+      target_table_->AppendTileGroup(tile_group);
+
+      auto tile_group_id = tile_group->GetTileGroupId();
+      auto tuple_slot_count = tile_group->GetNextTupleSlot();
+      for (oid_t tuple_slot = 0; tuple_slot < tuple_slot_count;
+           tuple_slot++) {
+        ItemPointer location(tile_group_id, tuple_slot);
+        ItemPointer *index_entry_ptr = nullptr;
+        if (has_indexes) {
+          index_entry_ptr = new ItemPointer(location);
+          index_entries.push_back(index_entry_ptr);
+        }
+        transaction_manager.PerformInsert(current_txn, location,
+                                          index_entry_ptr);
+      }
+      tuple_count += tuple_slot_count;
+    }
+  }
+  target_table_->IncreaseTupleCount(tuple_count);
+  executor_context_->num_processed += tuple_count;
+
+  LOG_TRACE("Imported %lu tuples into %s in %lu chunks", tuple_count,
+            target_table_->GetName().c_str(), chunks.size());
+
+  if (BuildIndexes(index_entries) == false) {
+    transaction_manager.SetTransactionResult(current_txn,
+                                             Result::RESULT_FAILURE);
+    return false;
+  }
+  return true;
+}
+
+void ImportExecutor::ParseChunk(Chunk *chunk) {
+  auto schema = target_table_->GetSchema();
+  auto column_count = schema->GetColumnCount();
+  bool check_foreign_keys = target_table_->HasForeignKeys();
+
+  // Uninlined values of the chunk's rows, until they are copied in
+  VarlenPool pool(BACKEND_TYPE_MM);
+  storage::Tuple tuple(schema, true);
+  std::vector<std::string> fields;
+  std::vector<bool> nulls;
+  size_t field_count;
+  std::shared_ptr<storage::TileGroup> tile_group;
+
+  auto pos = chunk->begin;
+  while (pos < chunk->end) {
+    auto row_begin = pos;
+    auto row_error = [&chunk, row_begin](const std::string &reason) {
+      auto row_end = static_cast<const char *>(
+          memchr(row_begin, '\n', chunk->end - row_begin));
+      if (row_end == nullptr) row_end = chunk->end;
+      chunk->error = reason + " : " + std::string(row_begin, row_end);
+    };
+
+    bool parsed =
+        csv_ ? ParseCSVRow(pos, chunk->end, fields, nulls, field_count)
+             : ParseTextRow(pos, chunk->end, fields, nulls, field_count);
+    if (parsed == false) {
+      row_error("malformed row");
+      return;
+    }
+    if (field_count != column_count) {
+      row_error("expected " + std::to_string(column_count) + " columns, got " +
+                std::to_string(field_count));
+      return;
+    }
+
+    try {
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        auto column_type = schema->GetType(column_itr);
+        if (nulls[column_itr]) {
+          tuple.SetValue(column_itr,
+                         ValueFactory::GetNullValueByType(column_type), &pool);
+        } else {
+          tuple.SetValue(column_itr,
+                         ParseValue(fields[column_itr], column_type, &pool),
+                         &pool);
+        }
+      }
+    } catch (Exception &e) {
+      row_error(e.what());
+      return;
+    }
+
+    if (check_foreign_keys &&
+        target_table_->CheckForeignKeyConstraints(&tuple) == false) {
+      row_error("foreign key constraint violated");
+      return;
+    }
+
+    // Fill tile groups of the chunk's own
+    if (tile_group == nullptr ||
+        tile_group->InsertTuple(&tuple) == INVALID_OID) {
+      tile_group.reset(target_table_->GetTileGroupWithDefaultLayout());
+      chunk->tile_groups.push_back(tile_group);
+      tile_group->InsertTuple(&tuple);
+    }
+  }
+}
+
+/*
+ * Insert the loaded tuples into the indexes, a thread per index. Empty
+ * indexes are bulk loaded, the others are inserted into one entry at a time.
+ * Returns false if they violate the primary key.
+ */
+bool ImportExecutor::BuildIndexes(
+    const std::vector<ItemPointer *> &index_entries) {
+  auto index_count = target_table_->GetIndexCount();
+  if (index_count == 0) return true;
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  std::function<bool(const ItemPointer &)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, current_txn, std::placeholders::_1);
+
+  // The entries are split into runs the threads bulk loading an index sort
+  size_t run_count =
+      std::max<size_t>(std::thread::hardware_concurrency() / index_count, 1);
+  std::vector<std::vector<ItemPointer *>> runs(run_count);
+  for (size_t entry_itr = 0; entry_itr < index_entries.size(); entry_itr++) {
+    runs[entry_itr * run_count / index_entries.size()].push_back(
+        index_entries[entry_itr]);
+  }
+
+  std::unique_ptr<bool[]> built(new bool[index_count]);
+  auto build_index = [this, &index_entries, &runs, &fn,
+                      &built](oid_t index_itr) {
+    auto index = target_table_->GetIndex(index_itr);
+
+    built[index_itr] = true;
+    // not maintained on insert either, see DataTable::InsertInIndexes
+    if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_UNIQUE) return;
+    if (index->BulkLoad(runs) == true) return;
+
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    auto &manager = catalog::Manager::GetInstance();
+    std::shared_ptr<storage::TileGroup> tile_group;
+
+    for (auto index_entry_ptr : index_entries) {
+      if (tile_group == nullptr ||
+          tile_group->GetTileGroupId() != index_entry_ptr->block) {
+        tile_group = manager.GetTileGroup(index_entry_ptr->block);
+      }
+      expression::ContainerTuple<storage::TileGroup> tuple(
+          tile_group.get(), index_entry_ptr->offset);
+      key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+      switch (index->GetIndexType()) {
+        case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY:
+          if (index->CondInsertEntry(key.get(), index_entry_ptr, fn) == false) {
+            LOG_TRACE("Primary key of %s violated", index->GetName().c_str());
+            built[index_itr] = false;
+            return;
+          }
+          break;
+        case INDEX_CONSTRAINT_TYPE_UNIQUE:
+          // not maintained on insert either, see DataTable::InsertInIndexes
+          break;
+        case INDEX_CONSTRAINT_TYPE_DEFAULT:
+        default:
+          index->InsertEntry(key.get(), index_entry_ptr);
+          break;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (oid_t index_itr = 1; index_itr < index_count; index_itr++) {
+    threads.push_back(std::thread(build_index, index_itr));
+  }
+  build_index(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    if (built[index_itr] == false) return false;
+  }
+  return true;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,11 +12,15 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
+#include "catalog/schema.h"
 #include "common/types.h"
+#include "common/value_peeker.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
@@ -24,8 +28,10 @@
 #include "expression/container_tuple.h"
 #include "index/index.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
+#include "storage/tuple.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "common/logger.h"
 #include "catalog/manager.h"
@@ -63,6 +69,10 @@ bool IndexScanExecutor::DInit() {
   index_ = node.GetIndex();
   PL_ASSERT(index_ != nullptr);
 
+  // Tiles a previous execution didn't return
+  for (oid_t tile_itr = result_itr_; tile_itr < result_.size(); tile_itr++) {
+    delete result_[tile_itr];
+  }
   result_itr_ = START_OID;
   result_.clear();
   done_ = false;
@@ -74,6 +84,46 @@ bool IndexScanExecutor::DInit() {
   values_ = node.GetValues();
   runtime_keys_ = node.GetRunTimeKeys();
   predicate_ = node.GetPredicate();
+  table_ = node.GetTable();
+  index_only_ = node.IsIndexOnly();
+  bitmap_scan_ = node.IsBitmapScan();
+  scan_direction_ = node.GetScanDirection();
+  limit_ = node.GetLimit();
+
+  // Parameters are bound into the executor's own scan predicate, so the plan
+  // is left as it is and can be executed again without rebinding it
+  auto &params = executor_context_->GetParams();
+  auto &values_with_params = node.GetValuesWithParams();
+  bind_params_ = false;
+  for (auto &value : values_with_params) {
+    if (value.GetValueType() != VALUE_TYPE_PARAMETER_OFFSET) continue;
+    auto param_offset = ValuePeeker::PeekParameterOffset(value);
+    bind_params_ = param_offset >= 0 &&
+                   static_cast<size_t>(param_offset) < params.size();
+    if (bind_params_ == false) break;
+  }
+
+  if (bind_params_) {
+    for (oid_t value_itr = 0; value_itr < values_with_params.size();
+         value_itr++) {
+      auto &value = values_with_params[value_itr];
+      if (value.GetValueType() != VALUE_TYPE_PARAMETER_OFFSET) continue;
+
+      auto column_id = key_column_ids_[value_itr];
+      values_[value_itr] =
+          params[ValuePeeker::PeekParameterOffset(value)].CastAs(
+              table_->GetSchema()->GetColumn(column_id).GetType());
+    }
+
+    // Built once, rebound on every execution
+    if (index_predicate_.GetConjunctionList().empty()) {
+      index_predicate_.AddConjunctionScanPredicate(
+          index_.get(), values_with_params, key_column_ids_, expr_types_);
+    }
+    if (index_predicate_.IsFullIndexScan() == false) {
+      index_predicate_.LateBindValues(index_.get(), params);
+    }
+  }
 
   if (runtime_keys_.size() != 0) {
     PL_ASSERT(runtime_keys_.size() == values_.size());
@@ -91,8 +141,6 @@ bool IndexScanExecutor::DInit() {
     }
   }
 
-  table_ = node.GetTable();
-
   if (table_ != nullptr) {
     full_column_ids_.resize(table_->GetSchema()->GetColumnCount());
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
@@ -108,14 +156,71 @@ bool IndexScanExecutor::DInit() {
 bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
+  // A scan with a limit probes the index for as many entries first
   if (!done_) {
-    if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
-      auto status = ExecPrimaryIndexLookup();
+    scan_limit_ = limit_;
+  }
+
+  while (!done_) {
+    std::vector<ItemPointer *> tuple_location_ptrs;
+
+    // The entries an index only scan cannot answer are looked up in the
+    // table as usual
+    if (index_only_) {
+      auto status = ExecIndexOnlyLookup(tuple_location_ptrs);
       if (status == false) return false;
     } else {
-      auto status = ExecSecondaryIndexLookup();
-      if (status == false) return false;
+      ScanIndex(tuple_location_ptrs, nullptr);
     }
+
+    size_t match_count = tuple_location_ptrs.size();
+    for (auto result_tile : result_) {
+      match_count += result_tile->GetTupleCount();
+    }
+
+    // Visit every tile group once, reading its matches front to back
+    if (bitmap_scan_) {
+      std::sort(tuple_location_ptrs.begin(), tuple_location_ptrs.end(),
+                [](const ItemPointer *left, const ItemPointer *right) {
+                  if (left->block != right->block) {
+                    return left->block < right->block;
+                  }
+                  return left->offset < right->offset;
+                });
+    }
+
+    bool status = true;
+    if (index_only_ && tuple_location_ptrs.empty()) {
+      done_ = true;
+    } else if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+      status = ExecPrimaryIndexLookup(tuple_location_ptrs);
+    } else {
+      status = ExecSecondaryIndexLookup(tuple_location_ptrs);
+    }
+
+    // The entries the transaction cannot see or the predicate rejects leave
+    // the scan short of its limit, the index is probed again for twice as
+    // many while it has more
+    if (done_ && scanned_all_ == false) {
+      size_t row_count = 0;
+      for (auto result_tile : result_) {
+        row_count += result_tile->GetTupleCount();
+      }
+      if (row_count < limit_) {
+        for (auto result_tile : result_) {
+          delete result_tile;
+        }
+        result_.clear();
+        done_ = false;
+        scan_limit_ *= 2;
+        continue;
+      }
+    }
+
+    // Sample the scan the rows are returned from
+    RecordSample(GetPlanNode<planner::IndexScanPlan>().GetTable(),
+                 key_column_ids_, match_count, match_count);
+    if (status == false) return false;
   }
   // Already performed the index lookup
   PL_ASSERT(done_);
@@ -136,25 +241,150 @@ bool IndexScanExecutor::DExecute() {
   return false;
 }
 
-bool IndexScanExecutor::ExecPrimaryIndexLookup() {
-  LOG_TRACE("Exec primary index lookup");
-  PL_ASSERT(!done_);
-
-  std::vector<ItemPointer *> tuple_location_ptrs;
+/**
+ * @brief The conjunction to probe the index with, the plan's one unless the
+ * parameters were bound by the executor.
+ */
+const index::ConjunctionScanPredicate *IndexScanExecutor::GetScanPredicate() {
+  if (bind_params_) return &index_predicate_.GetConjunctionList()[0];
 
-  // Grab info from plan node
   const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
+  return &node.GetIndexPredicate().GetConjunctionList()[0];
+}
 
-  PL_ASSERT(index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
-
+/**
+ * @brief Probes the index for the locations of the entries satisfying the
+ * scan predicate, and the values of their keys if keys is not null.
+ */
+void IndexScanExecutor::ScanIndex(
+    std::vector<ItemPointer *> &tuple_location_ptrs, std::vector<Value> *keys) {
   if (0 == key_column_ids_.size()) {
+    PL_ASSERT(keys == nullptr);
     index_->ScanAllKeys(tuple_location_ptrs);
+    scanned_all_ = true;
   } else {
-    index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs,
-                 &node.GetIndexPredicate().GetConjunctionList()[0]);
+    index_->Scan(values_, key_column_ids_, expr_types_, scan_direction_,
+                 tuple_location_ptrs, GetScanPredicate(), scan_limit_, keys);
+    scanned_all_ =
+        (scan_limit_ == 0) || (tuple_location_ptrs.size() < scan_limit_);
+  }
+}
+
+/**
+ * @brief Builds the result from the keys of the index entries, without
+ * reading the table.
+ *
+ * An entry leads to the head of a version chain. If the head has no older
+ * version, the chain was never updated and all of its entries were built
+ * from the head, so if the head is also visible to the transaction, the
+ * entry holds the columns the transaction reads. Only the tile group header
+ * is needed to find out. The other entries are left for a lookup in the
+ * table, as their keys may be stale or an older version may be visible.
+ * The predicate of the scan only reads key columns and is evaluated on the
+ * keys as well.
+ * @return false if the transaction failed.
+ */
+bool IndexScanExecutor::ExecIndexOnlyLookup(
+    std::vector<ItemPointer *> &tuple_location_ptrs) {
+  LOG_TRACE("Exec index only lookup");
+  PL_ASSERT(!done_);
+
+  std::vector<ItemPointer *> entry_location_ptrs;
+  std::vector<Value> entry_keys;
+  ScanIndex(entry_location_ptrs, &entry_keys);
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto current_txn = executor_context_->GetTransaction();
+
+  auto &key_attrs = index_->GetMetadata()->GetKeyAttrs();
+  auto key_column_count = index_->GetColumnCount();
+
+  // The predicate only reads key columns, which are set in a tuple of the
+  // table to evaluate it on
+  std::unique_ptr<storage::Tuple> predicate_tuple;
+  if (predicate_ != nullptr) {
+    predicate_tuple.reset(new storage::Tuple(table_->GetSchema(), true));
+  }
+
+  // Entries answered by their keys
+  std::vector<oid_t> covered_entries;
+
+  for (oid_t entry_itr = 0; entry_itr < entry_location_ptrs.size();
+       entry_itr++) {
+    ItemPointer tuple_location = *entry_location_ptrs[entry_itr];
+    auto tile_group_header =
+        manager.GetTileGroup(tuple_location.block)->GetHeader();
+
+    if (tile_group_header->GetNextItemPointer(tuple_location.offset)
+            .IsNull() == false ||
+        transaction_manager.IsVisible(current_txn, tile_group_header,
+                                      tuple_location.offset) !=
+            VISIBILITY_OK) {
+      tuple_location_ptrs.push_back(entry_location_ptrs[entry_itr]);
+      continue;
+    }
+
+    if (predicate_ != nullptr) {
+      auto key_offset = entry_itr * key_column_count;
+      for (oid_t column_itr = 0; column_itr < key_column_count;
+           column_itr++) {
+        predicate_tuple->SetValue(key_attrs[column_itr],
+                                  entry_keys[key_offset + column_itr],
+                                  executor_context_->GetExecutorContextPool());
+      }
+      if (predicate_->Evaluate(predicate_tuple.get(), nullptr,
+                               executor_context_).IsTrue() == false) {
+        continue;
+      }
+    }
+
+    auto res = transaction_manager.PerformRead(current_txn, tuple_location);
+    if (!res) {
+      transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+      return res;
+    }
+    covered_entries.push_back(entry_itr);
   }
 
+  LOG_TRACE("Covered entries : %lu of %lu", covered_entries.size(),
+            entry_location_ptrs.size());
+
+  if (covered_entries.empty() == false) {
+    std::unique_ptr<catalog::Schema> schema(
+        catalog::Schema::CopySchema(table_->GetSchema(), column_ids_));
+    std::shared_ptr<storage::Tile> tile(
+        storage::TileFactory::GetTempTile(*schema, covered_entries.size()));
+
+    // Key column each of the columns is read from
+    auto &tuple_to_index = index_->GetMetadata()->GetTupleToIndexMapping();
+
+    for (oid_t tuple_itr = 0; tuple_itr < covered_entries.size();
+         tuple_itr++) {
+      auto key_offset = covered_entries[tuple_itr] * key_column_count;
+      for (oid_t column_itr = 0; column_itr < column_ids_.size();
+           column_itr++) {
+        auto key_column_id = tuple_to_index[column_ids_[column_itr]];
+        tile->SetValue(entry_keys[key_offset + key_column_id], tuple_itr,
+                       column_itr);
+      }
+    }
+
+    result_.push_back(LogicalTileFactory::WrapTiles({tile}));
+  }
+
+  return true;
+}
+
+bool IndexScanExecutor::ExecPrimaryIndexLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs) {
+  LOG_TRACE("Exec primary index lookup");
+  PL_ASSERT(!done_);
+
+  PL_ASSERT(index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
+
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
@@ -297,25 +527,13 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   return true;
 }
 
-bool IndexScanExecutor::ExecSecondaryIndexLookup() {
+bool IndexScanExecutor::ExecSecondaryIndexLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs) {
   LOG_TRACE("ExecSecondaryIndexLookup");
   PL_ASSERT(!done_);
 
-  std::vector<ItemPointer *> tuple_location_ptrs;
-
-  // Grab info from plan node
-  const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
-
   PL_ASSERT(index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs,
-                 &node.GetIndexPredicate().GetConjunctionList()[0]);
-  }
-
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
@@ -35,7 +35,8 @@ InsertExecutor::InsertExecutor(const planner::AbstractPlan *node,
     : AbstractExecutor(node, executor_context) {}
 
 /**
- * @brief Nothing to init at the moment.
+ * @brief Bind the parameters of the execution into a copy of the plan's
+ * tuple, the plan itself is left unbound.
  * @return true on success, false otherwise.
  */
 bool InsertExecutor::DInit() {
@@ -43,6 +44,46 @@ bool InsertExecutor::DInit() {
   PL_ASSERT(executor_context_);
 
   done_ = false;
+
+  const planner::InsertPlan &node = GetPlanNode<planner::InsertPlan>();
+  auto parameter_vector = node.GetParameterVector();
+  auto &params = executor_context_->GetParams();
+  if (node.GetTuple() == nullptr || parameter_vector == nullptr ||
+      parameter_vector->empty() || params.empty()) {
+    bound_tuple_.reset();
+    bound_tuple_pool_.reset();
+    return true;
+  }
+
+  auto executor_pool = executor_context_->GetExecutorContextPool();
+  auto params_value_type = node.GetParamsValueType();
+
+  // Constant columns are copied once into the executor's own pool,
+  // parameters on every execution into the pool of the execution
+  if (bound_tuple_ == nullptr) {
+    auto tuple = node.GetTuple();
+    bound_tuple_.reset(new storage::Tuple(tuple->GetSchema(), true));
+    bound_tuple_pool_.reset(new VarlenPool(BACKEND_TYPE_MM));
+    for (oid_t column_itr = 0; column_itr < tuple->GetColumnCount();
+         column_itr++) {
+      bound_tuple_->SetValue(column_itr, tuple->GetValue(column_itr),
+                             bound_tuple_pool_.get());
+    }
+  }
+
+  for (oid_t param_itr = 0; param_itr < parameter_vector->size();
+       param_itr++) {
+    auto &column_param = parameter_vector->at(param_itr);
+    if (column_param.second >= params.size()) {
+      LOG_ERROR("Missing value of parameter %u", column_param.second);
+      return false;
+    }
+    auto param_type = params_value_type->at(param_itr);
+    bound_tuple_->SetValue(column_param.first,
+                           params[column_param.second].CastAs(param_type),
+                           executor_pool);
+  }
+
   return true;
 }
 
@@ -117,6 +158,9 @@ bool InsertExecutor::DExecute() {
       executor_context_->num_processed += 1;  // insert one
     }
 
+    // Sample the write for the index tuner
+    target_table->RecordWriteSample({}, logical_tile->GetTupleCount());
+
     return true;
   }
   // Inserting a collection of tuples from plan node
@@ -127,7 +171,8 @@ bool InsertExecutor::DExecute() {
     // For now we just handle a single tuple
     auto schema = target_table->GetSchema();
     auto project_info = node.GetProjectInfo();
-    auto tuple = node.GetTuple();
+    const storage::Tuple *tuple = node.GetTuple();
+    if (bound_tuple_ != nullptr) tuple = bound_tuple_.get();
     std::unique_ptr<storage::Tuple> project_tuple;
 
     // Check if this is not a raw tuple
@@ -175,6 +220,9 @@ bool InsertExecutor::DExecute() {
       executor_context_->num_processed += 1;  // insert one
     }
 
+    // Sample the write for the index tuner
+    target_table->RecordWriteSample({}, bulk_insert_count);
+
     done_ = true;
     return true;
   }
@@ -179,6 +179,31 @@ Value LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
   }
 }
 
+/**
+ * @brief Get the dictionary code of a value from its base tile.
+ *
+ * @return false if the base column is not dictionary encoded or the row
+ * has no base tuple (outer join padding).
+ */
+bool LogicalTile::GetDictionaryCode(oid_t tuple_id, oid_t column_id,
+                                    const storage::Dictionary **dictionary,
+                                    storage::Dictionary::Code *code) {
+  PL_ASSERT(column_id < schema_.size());
+  PL_ASSERT(tuple_id < total_tuples_);
+
+  ColumnInfo &cp = schema_[column_id];
+  oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_id];
+  if (base_tuple_id == NULL_OID) return false;
+
+  storage::Tile *base_tile = cp.base_tile.get();
+  auto codes = base_tile->GetDictionaryCodes(cp.origin_column_id);
+  if (codes == nullptr) return false;
+
+  *dictionary = base_tile->GetDictionary(cp.origin_column_id);
+  *code = codes[base_tuple_id];
+  return true;
+}
+
 // this function is designed for overriding pure virtual function.
 void LogicalTile::SetValue(Value &value UNUSED_ATTRIBUTE, 
                            oid_t tuple_id UNUSED_ATTRIBUTE, 
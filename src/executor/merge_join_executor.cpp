@@ -135,6 +135,8 @@ bool MergeJoinExecutor::DExecute() {
   // Build position lists
   LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
 
+  bool use_compiled = BindCompiledPredicate(left_tile, right_tile);
+
   while ((left_end_row > left_start_row) && (right_end_row > right_start_row)) {
     expression::ContainerTuple<executor::LogicalTile> left_tuple(
         left_tile, left_start_row);
@@ -183,8 +185,13 @@ bool MergeJoinExecutor::DExecute() {
 
     // Join predicate exists
     if (predicate_ != nullptr) {
-      if (predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_)
-              .IsFalse()) {
+      bool is_false =
+          use_compiled
+              ? compiled_predicate_->EvaluatesFalse(left_start_row,
+                                                    right_start_row)
+              : predicate_->Evaluate(&left_tuple, &right_tuple,
+                                     executor_context_).IsFalse();
+      if (is_false) {
         // Join predicate is false. Advance both.
         left_start_row = left_end_row;
         left_end_row = Advance(left_tile, left_start_row, true);
@@ -0,0 +1,362 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_index_join_executor.cpp
+//
+// Identification: src/executor/nested_loop_index_join_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "executor/nested_loop_index_join_executor.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/types.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/abstract_expression.h"
+#include "expression/container_tuple.h"
+#include "index/index.h"
+#include "planner/nested_loop_index_join_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for nested loop index join executor.
+ * @param node Nested loop index join node corresponding to this executor.
+ */
+NestedLoopIndexJoinExecutor::NestedLoopIndexJoinExecutor(
+    const planner::AbstractPlan *node, ExecutorContext *executor_context)
+    : AbstractJoinExecutor(node, executor_context) {}
+
+/**
+ * @brief Grab the plan info, bind the values and parameters of the keys and
+ * build the predicate the index is probed with.
+ * @return true on success, false otherwise.
+ */
+bool NestedLoopIndexJoinExecutor::DInit() {
+  // The inner side is the index, not a child
+  PL_ASSERT(children_.size() == 1);
+
+  const planner::NestedLoopIndexJoinPlan &node =
+      GetPlanNode<planner::NestedLoopIndexJoinPlan>();
+
+  predicate_ = node.GetPredicate();
+  proj_info_ = node.GetProjInfo();
+  join_type_ = node.GetJoinType();
+  proj_schema_ = node.GetSchema();
+
+  index_ = node.GetIndex();
+  inner_table_ = node.GetInnerTable();
+  inner_column_ids_ = node.GetInnerColumnIds();
+  key_column_ids_ = node.GetKeyColumnIds();
+  expr_types_ = node.GetExprTypes();
+  outer_column_ids_ = node.GetOuterColumnIds();
+
+  // Tiles a previous execution didn't return
+  result_.clear();
+  result_itr_ = 0;
+
+  // Values and parameters are the same for every probe, the keys taken from
+  // the outer side are bound tuple by tuple
+  auto &params = executor_context_->GetParams();
+  key_values_ = node.GetValues();
+  for (oid_t key_itr = 0; key_itr < key_values_.size(); key_itr++) {
+    auto &value = key_values_[key_itr];
+    if (outer_column_ids_[key_itr] != INVALID_OID ||
+        value.GetValueType() != VALUE_TYPE_PARAMETER_OFFSET) {
+      continue;
+    }
+
+    if (ValuePeeker::PeekParameterOffset(value) < 0) {
+      LOG_ERROR("Negative parameter offset in the join key");
+      return false;
+    }
+    size_t param_offset = ValuePeeker::PeekParameterOffset(value);
+    if (param_offset >= params.size()) {
+      LOG_ERROR("No value for parameter %lu of the join key", param_offset);
+      return false;
+    }
+    value = params[param_offset].CastAs(
+        inner_table_->GetSchema()->GetType(key_column_ids_[key_itr]));
+  }
+
+  // Every key is a binding slot of its own, so that the whole key can be
+  // rebound from key_values_ before each probe
+  if (probe_predicate_ == nullptr) {
+    std::vector<Value> bindings;
+    for (oid_t key_itr = 0; key_itr < key_column_ids_.size(); key_itr++) {
+      bindings.push_back(ValueFactory::GetBindingOnlyIntegerValue(key_itr));
+    }
+    probe_predicate_.reset(new index::ConjunctionScanPredicate(
+        index_.get(), bindings, key_column_ids_, expr_types_));
+  }
+
+  return true;
+}
+
+/**
+ * @brief Creates the join tiles of the next outer tile that has a match.
+ * @return true on success, false otherwise.
+ */
+bool NestedLoopIndexJoinExecutor::DExecute() {
+  LOG_TRACE("********** Nested Loop Index %s Join executor :: 1 child ",
+            GetJoinTypeString());
+
+  for (;;) {
+    if (result_itr_ < result_.size()) {
+      SetOutput(result_[result_itr_].release());
+      result_itr_++;
+      return true;
+    }
+    result_.clear();
+    result_itr_ = 0;
+
+    if (children_[0]->Execute() == false) {
+      LOG_TRACE("Outer child is exhausted.");
+      return false;
+    }
+
+    std::unique_ptr<LogicalTile> outer_tile(children_[0]->GetOutput());
+    if (JoinOuterTile(outer_tile.get()) == false) {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Probes the index for every tuple of the outer tile, building a join
+ * tile per inner tile group that has a match.
+ * @return false if the transaction has to abort, true otherwise.
+ */
+bool NestedLoopIndexJoinExecutor::JoinOuterTile(LogicalTile *outer_tile) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  // Outer row and inner offset of each match, by inner tile group
+  std::map<oid_t, std::vector<std::pair<oid_t, oid_t>>> matches;
+  std::vector<oid_t> unmatched_rows;
+  std::vector<ItemPointer *> tuple_location_ptrs;
+
+  for (auto outer_row : *outer_tile) {
+    bool has_match = false;
+
+    // A null key matches nothing
+    tuple_location_ptrs.clear();
+    if (BindOuterKeys(outer_tile, outer_row)) {
+      index_->Scan(key_values_, key_column_ids_, expr_types_,
+                   SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs,
+                   probe_predicate_.get());
+    }
+
+    expression::ContainerTuple<LogicalTile> outer_tuple(outer_tile, outer_row);
+    for (auto tuple_location_ptr : tuple_location_ptrs) {
+      ItemPointer tuple_location = *tuple_location_ptr;
+      std::shared_ptr<storage::TileGroup> tile_group;
+
+      if (GetVisibleVersion(tuple_location, tile_group) == false) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+      if (tuple_location.IsNull()) {
+        continue;
+      }
+
+      if (predicate_ != nullptr) {
+        expression::ContainerTuple<storage::TileGroup> inner_tuple(
+            tile_group.get(), tuple_location.offset);
+        if (predicate_->Evaluate(&outer_tuple, &inner_tuple, executor_context_)
+                .IsTrue() == false) {
+          continue;
+        }
+      }
+
+      if (transaction_manager.PerformRead(current_txn, tuple_location) ==
+          false) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+
+      matches[tuple_location.block].push_back(
+          std::make_pair(outer_row, oid_t(tuple_location.offset)));
+      has_match = true;
+    }
+
+    if (has_match == false && join_type_ == JOIN_TYPE_LEFT) {
+      unmatched_rows.push_back(outer_row);
+    }
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &tile_group_matches : matches) {
+    auto &rows = tile_group_matches.second;
+
+    // The matched versions of the tile group, one row per match
+    std::unique_ptr<LogicalTile> inner_tile(LogicalTileFactory::GetTile());
+    inner_tile->AddColumns(manager.GetTileGroup(tile_group_matches.first),
+                           inner_column_ids_);
+    std::vector<oid_t> inner_positions;
+    inner_positions.reserve(rows.size());
+    for (auto &row : rows) {
+      inner_positions.push_back(row.second);
+    }
+    inner_tile->AddPositionList(std::move(inner_positions));
+
+    auto output_tile = BuildOutputLogicalTile(outer_tile, inner_tile.get());
+    LogicalTile::PositionListsBuilder pos_lists_builder(outer_tile,
+                                                        inner_tile.get());
+    for (oid_t inner_row = 0; inner_row < rows.size(); inner_row++) {
+      pos_lists_builder.AddRow(rows[inner_row].first, inner_row);
+    }
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    result_.push_back(std::move(output_tile));
+  }
+
+  // Outer tuples without a match, with nulls on the inner side
+  if (unmatched_rows.empty() == false) {
+    auto output_tile =
+        BuildOutputLogicalTile(outer_tile, nullptr, proj_schema_);
+    LogicalTile::PositionListsBuilder pos_lists_builder(
+        &outer_tile->GetPositionLists(), nullptr);
+    for (auto outer_row : unmatched_rows) {
+      pos_lists_builder.AddRightNullRow(outer_row);
+    }
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    result_.push_back(std::move(output_tile));
+  }
+
+  return true;
+}
+
+/**
+ * @brief Binds the keys taken from the outer side to the probe predicate.
+ * @return false if one of them is null, true otherwise.
+ */
+bool NestedLoopIndexJoinExecutor::BindOuterKeys(LogicalTile *outer_tile,
+                                                oid_t outer_row) {
+  auto inner_schema = inner_table_->GetSchema();
+  for (oid_t key_itr = 0; key_itr < outer_column_ids_.size(); key_itr++) {
+    if (outer_column_ids_[key_itr] == INVALID_OID) continue;
+
+    auto value = outer_tile->GetValue(outer_row, outer_column_ids_[key_itr]);
+    if (value.IsNull()) return false;
+
+    auto column_type = inner_schema->GetType(key_column_ids_[key_itr]);
+    if (value.GetValueType() == column_type) {
+      key_values_[key_itr] = value;
+    } else {
+      key_values_[key_itr] = value.CastAs(column_type);
+    }
+  }
+
+  if (probe_predicate_->IsFullIndexScan() == false) {
+    probe_predicate_->LateBindValues(index_.get(), key_values_);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Walks the version chain of an index entry to the version the
+ * transaction sees, the same way the index scan does.
+ * @return false if the chain has no version it should see, which aborts the
+ * transaction. tuple_location is null when there is nothing to join with.
+ */
+bool NestedLoopIndexJoinExecutor::GetVisibleVersion(
+    ItemPointer &tuple_location,
+    std::shared_ptr<storage::TileGroup> &tile_group) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  tile_group = manager.GetTileGroup(tuple_location.block);
+  auto tile_group_header = tile_group->GetHeader();
+
+  size_t chain_length = 0;
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+
+    if (visibility == VISIBILITY_DELETED) {
+      LOG_TRACE("encounter deleted tuple: %u, %u", tuple_location.block,
+                tuple_location.offset);
+      tuple_location = INVALID_ITEMPOINTER;
+      return true;
+    }
+
+    if (visibility == VISIBILITY_OK) {
+      if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+        return true;
+      }
+
+      // The visible version of a secondary index entry may have been updated
+      // to another key
+      storage::Tuple key_tuple(index_->GetKeySchema(), true);
+      expression::ContainerTuple<storage::TileGroup> candidate_tuple(
+          tile_group.get(), tuple_location.offset);
+      oid_t key_column_itr = 0;
+      for (auto column_id : index_->GetKeySchema()->GetIndexedColumns()) {
+        key_tuple.SetValue(key_column_itr++,
+                           candidate_tuple.GetValue(column_id),
+                           index_->GetPool());
+      }
+      if (index_->Compare(key_tuple, key_column_ids_, expr_types_,
+                          key_values_) == false) {
+        LOG_TRACE("Secondary key mismatch: %u, %u", tuple_location.block,
+                  tuple_location.offset);
+        tuple_location = INVALID_ITEMPOINTER;
+      }
+      return true;
+    }
+
+    PL_ASSERT(visibility == VISIBILITY_INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     current_txn->GetBeginCommitId());
+    if (is_acquired && is_alive) {
+      // Another transaction has modified the version chain, search it again
+      // from its current head
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      tile_group = manager.GetTileGroup(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
+      chain_length = 0;
+      continue;
+    }
+
+    tuple_location =
+        tile_group_header->GetNextItemPointer(tuple_location.offset);
+    if (tuple_location.IsNull()) {
+      // Only an aborted insert leaves a chain without a visible version
+      return chain_length == 1;
+    }
+
+    tile_group = manager.GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -167,13 +167,21 @@ bool NestedLoopJoinExecutor::DExecute() {
     // Build position lists
     LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
 
+    bool use_compiled = BindCompiledPredicate(left_tile, right_tile);
+
     // Go over every pair of tuples in left and right logical tiles
     for (auto right_tile_row_itr : *right_tile) {
       bool has_left_match = false;
 
       for (auto left_tile_row_itr : *left_tile) {
         // Join predicate exists
-        if (predicate_ != nullptr) {
+        if (use_compiled) {
+          // Join predicate is false. Skip pair and continue.
+          if (compiled_predicate_->EvaluatesFalse(left_tile_row_itr,
+                                                  right_tile_row_itr)) {
+            continue;
+          }
+        } else if (predicate_ != nullptr) {
           expression::ContainerTuple<executor::LogicalTile> left_tuple(
               left_tile, left_tile_row_itr);
           expression::ContainerTuple<executor::LogicalTile> right_tuple(
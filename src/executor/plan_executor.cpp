@@ -29,22 +29,18 @@ namespace bridge {
 executor::ExecutorContext *BuildExecutorContext(
     const std::vector<Value> &params, concurrency::Transaction *txn);
 
-executor::AbstractExecutor *BuildExecutorTree(
-    executor::AbstractExecutor *root, const planner::AbstractPlan *plan,
-    executor::ExecutorContext *executor_context);
-
-void CleanExecutorTree(executor::AbstractExecutor *root);
-
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<Value> as params to make it more elegant for networking
  * Before ExecutePlan, a node first receives value list, so we should pass
  * value list directly rather than passing Postgres's ParamListInfo
+ * The plan runs within txn if given, the caller then commits or aborts it.
  * @return status of execution.
  */
 peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
                                          const std::vector<Value> &params,
-                                         std::vector<ResultType> &result) {
+                                         std::vector<ResultType> &result,
+                                         concurrency::Transaction *txn) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
@@ -56,12 +52,12 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   bool single_statement_txn = false;
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  // auto txn = peloton::concurrency::current_txn;
+
   // This happens for single statement queries in PG
-  // if (txn == nullptr) {
-  single_statement_txn = true;
-  auto txn = txn_manager.BeginTransaction();
-  // }
+  if (txn == nullptr) {
+    single_statement_txn = true;
+    txn = txn_manager.BeginTransaction();
+  }
   PL_ASSERT(txn);
 
   LOG_TRACE("Txn ID = %lu ", txn->GetTransactionId());
@@ -136,8 +132,9 @@ cleanup:
   LOG_TRACE("About to commit: single stmt: %d, init_failure: %d, status: %d",
             single_statement_txn, init_failure, txn->GetResult());
 
-  // should we commit or abort ?
-  if (single_statement_txn == true || init_failure == true) {
+  // should we commit or abort ? a multi-statement transaction is ended by
+  // its owner
+  if (single_statement_txn == true) {
     auto status = txn->GetResult();
     switch (status) {
       case Result::RESULT_SUCCESS:
@@ -152,6 +149,8 @@ cleanup:
         LOG_TRACE("Abort Transaction");
         p_status.m_result = txn_manager.AbortTransaction(txn);
     }
+  } else {
+    p_status.m_result = txn->GetResult();
   }
 
   // clean up executor tree
@@ -261,6 +260,156 @@ cleanup:
   return executor_context->num_processed;
 }
 
+//===--------------------------------------------------------------------===//
+// Plan Cursor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Whether the executors of the plan reset all of their state when
+ * they are initialized again.
+ */
+static bool IsReusablePlan(const planner::AbstractPlan *plan) {
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN:
+    case PLAN_NODE_TYPE_INDEXSCAN:
+    case PLAN_NODE_TYPE_INSERT:
+    case PLAN_NODE_TYPE_LIMIT:
+      break;
+    default:
+      return false;
+  }
+
+  for (auto &child : plan->GetChildren()) {
+    if (IsReusablePlan(child.get()) == false) return false;
+  }
+  return true;
+}
+
+PlanCursor::PlanCursor(const planner::AbstractPlan *plan,
+                       const std::vector<Value> &params,
+                       concurrency::Transaction *txn) {
+  BeginTransaction(txn);
+
+  executor_context_.reset(BuildExecutorContext(params, txn_));
+  executor_tree_.reset(
+      BuildExecutorTree(nullptr, plan, executor_context_.get()));
+  reusable_ = (executor_tree_ != nullptr && IsReusablePlan(plan));
+
+  InitExecutorTree();
+}
+
+PlanCursor::~PlanCursor() {
+  Close();
+
+  CleanExecutorTree(executor_tree_.get());
+}
+
+bool PlanCursor::Reopen(const std::vector<Value> &params,
+                        concurrency::Transaction *txn) {
+  PL_ASSERT(closed_);
+  if (reusable_ == false) return false;
+
+  BeginTransaction(txn);
+
+  executor_context_->Reset(txn_, params);
+  exhausted_ = false;
+  closed_ = false;
+  status_ = peloton_status();
+
+  InitExecutorTree();
+  return true;
+}
+
+void PlanCursor::BeginTransaction(concurrency::Transaction *txn) {
+  if (txn != nullptr) {
+    txn_ = txn;
+    owns_txn_ = false;
+  } else {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    txn_ = txn_manager.BeginTransaction();
+    owns_txn_ = true;
+  }
+  PL_ASSERT(txn_);
+
+  LOG_TRACE("Txn ID = %lu ", txn_->GetTransactionId());
+}
+
+void PlanCursor::InitExecutorTree() {
+  // Nothing to run
+  if (executor_tree_ == nullptr) {
+    exhausted_ = true;
+    return;
+  }
+
+  if (executor_tree_->Init() == false) {
+    txn_->SetResult(Result::RESULT_FAILURE);
+    exhausted_ = true;
+  }
+}
+
+bool PlanCursor::Next() {
+  // Rest of the current tile
+  if (tile_ != nullptr && ++(*tuple_itr_) != tile_->end()) return true;
+
+  tuple_itr_.reset();
+  tile_.reset();
+
+  // Pull the next non-empty tile
+  while (exhausted_ == false) {
+    if (executor_tree_->Execute() == false) {
+      exhausted_ = true;
+      break;
+    }
+
+    // Some executors don't return logical tiles (e.g., Update).
+    tile_.reset(executor_tree_->GetOutput());
+    if (tile_ == nullptr || tile_->GetTupleCount() == 0) continue;
+
+    tuple_itr_.reset(new executor::LogicalTile::iterator(tile_->begin()));
+    return true;
+  }
+
+  tile_.reset();
+  return false;
+}
+
+peloton_status PlanCursor::Close() {
+  if (closed_) return status_;
+  closed_ = true;
+
+  tuple_itr_.reset();
+  tile_.reset();
+
+  status_.m_processed = executor_context_->num_processed;
+
+  // Executors may still be working in the transaction, like the workers of
+  // an exchange, so they are released before it ends
+  if (reusable_ == false) {
+    CleanExecutorTree(executor_tree_.get());
+    executor_tree_.reset();
+  }
+
+  // The caller ends its own transaction
+  if (owns_txn_ == false) {
+    status_.m_result = txn_->GetResult();
+  } else {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    switch (txn_->GetResult()) {
+      case Result::RESULT_SUCCESS:
+        LOG_TRACE("Commit Transaction");
+        status_.m_result = txn_manager.CommitTransaction(txn_);
+        break;
+
+      case Result::RESULT_FAILURE:
+      default:
+        LOG_TRACE("Abort Transaction");
+        status_.m_result = txn_manager.AbortTransaction(txn_);
+    }
+  }
+
+  return status_;
+}
+
 /**
  * @brief Pretty print the plan tree.
  * @param The plan tree
@@ -352,6 +501,12 @@ executor::AbstractExecutor *BuildExecutorTree(
           new executor::NestedLoopJoinExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_NESTLOOPINDEX:
+      LOG_TRACE("Adding Nested Loop Index Join Executer");
+      child_executor =
+          new executor::NestedLoopIndexJoinExecutor(plan, executor_context);
+      break;
+
     case PLAN_NODE_TYPE_MERGEJOIN:
       LOG_TRACE("Adding Merge Join Executer");
       child_executor = new executor::MergeJoinExecutor(plan, executor_context);
@@ -398,6 +553,21 @@ executor::AbstractExecutor *BuildExecutorTree(
       child_executor = new executor::CreateExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_IMPORT:
+      LOG_TRACE("Adding Import Executer");
+      child_executor = new executor::ImportExecutor(plan, executor_context);
+      break;
+
+    case PLAN_NODE_TYPE_ANALYZE:
+      LOG_TRACE("Adding Analyze Executer");
+      child_executor = new executor::AnalyzeExecutor(plan, executor_context);
+      break;
+
+    case PLAN_NODE_TYPE_EXCHANGE:
+      LOG_TRACE("Adding Exchange Executer");
+      child_executor = new executor::ExchangeExecutor(plan, executor_context);
+      break;
+
     default:
       LOG_ERROR("Unsupported plan node type : %d ", plan_node_type);
       break;
@@ -411,6 +581,9 @@ executor::AbstractExecutor *BuildExecutorTree(
       root = child_executor;
   }
 
+  // The workers of an exchange build their own trees of its child
+  if (plan_node_type == PLAN_NODE_TYPE_EXCHANGE) return root;
+
   // Recurse
   auto &children = plan->GetChildren();
   for (auto &child : children) {
@@ -16,6 +16,7 @@
 #include "planner/projection_plan.h"
 #include "common/logger.h"
 #include "common/types.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/container_tuple.h"
@@ -45,6 +46,12 @@ bool ProjectionExecutor::DInit() {
   this->project_info_ = node.GetProjectInfo();
   this->schema_ = node.GetSchema();
 
+  // Compiled targets fold the parameters of the execution in
+  compiled_targets_.clear();
+  bound_targets_.clear();
+  target_list_compiled_ = false;
+  has_compiled_targets_ = false;
+
   return true;
 }
 
@@ -75,13 +82,32 @@ bool ProjectionExecutor::DExecute() {
     std::shared_ptr<storage::Tile> dest_tile(
         storage::TileFactory::GetTempTile(*schema_, num_tuples));
 
+    if (target_list_compiled_ == false) {
+      CompileTargetList(source_tile.get());
+    }
+
+    bool use_compiled = false;
+    if (has_compiled_targets_) {
+      for (oid_t target_itr = 0; target_itr < compiled_targets_.size();
+           target_itr++) {
+        auto &compiled = compiled_targets_[target_itr];
+        bound_targets_[target_itr] =
+            compiled != nullptr && compiled->Bind(0, source_tile.get());
+        use_compiled = use_compiled || bound_targets_[target_itr];
+      }
+    }
+
     // Create projections tuple-at-a-time from original tile
     oid_t new_tuple_id = 0;
     for (oid_t old_tuple_id : *source_tile) {
       storage::Tuple *buffer = new storage::Tuple(schema_, true);
-      expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
-                                                    old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      if (use_compiled) {
+        EvaluateCompiled(buffer, source_tile.get(), old_tuple_id);
+      } else {
+        expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
+                                                      old_tuple_id);
+        project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      }
 
       // Insert projected tuple into the new tile
       dest_tile.get()->InsertTuple(new_tuple_id, buffer);
@@ -99,5 +125,66 @@ bool ProjectionExecutor::DExecute() {
   return false;
 }
 
+/**
+ * @brief Compile the non-trivial target list entries for the column types of
+ * the child's output. Varchar results stay interpreted since boxing them
+ * would copy the string anyway.
+ */
+void ProjectionExecutor::CompileTargetList(LogicalTile *source_tile) {
+  target_list_compiled_ = true;
+
+  auto column_types =
+      expression::CompiledExpression::GetColumnTypes(source_tile);
+  auto &target_list = project_info_->GetTargetList();
+
+  compiled_targets_.resize(target_list.size());
+  bound_targets_.resize(target_list.size(), false);
+  for (oid_t target_itr = 0; target_itr < target_list.size(); target_itr++) {
+    auto compiled = expression::CompiledExpression::Compile(
+        target_list[target_itr].second, column_types, {}, executor_context_);
+    if (compiled == nullptr ||
+        compiled->GetValueType() == VALUE_TYPE_VARCHAR) {
+      continue;
+    }
+    compiled_targets_[target_itr] = std::move(compiled);
+    has_compiled_targets_ = true;
+  }
+}
+
+/**
+ * @brief Same as ProjectInfo::Evaluate, except that compiled target list
+ * entries read the source tile directly.
+ */
+void ProjectionExecutor::EvaluateCompiled(storage::Tuple *dest,
+                                          LogicalTile *source_tile,
+                                          oid_t tuple_id) {
+  VarlenPool *pool = nullptr;
+  if (executor_context_ != nullptr)
+    pool = executor_context_->GetExecutorContextPool();
+  expression::ContainerTuple<LogicalTile> tuple(source_tile, tuple_id);
+
+  // (A) Execute target list
+  auto &target_list = project_info_->GetTargetList();
+  for (oid_t target_itr = 0; target_itr < target_list.size(); target_itr++) {
+    auto col_id = target_list[target_itr].first;
+    if (bound_targets_[target_itr]) {
+      dest->SetValue(col_id,
+                     compiled_targets_[target_itr]->EvaluateValue(tuple_id),
+                     pool);
+    } else {
+      auto expr = target_list[target_itr].second;
+      dest->SetValue(col_id, expr->Evaluate(&tuple, nullptr, executor_context_),
+                     pool);
+    }
+  }
+
+  // (B) Execute direct map
+  for (auto dm : project_info_->GetDirectMapList()) {
+    auto dest_col_id = dm.first;
+    auto src_col_id = dm.second.second;
+    dest->SetValue(dest_col_id, tuple.GetValue(src_col_id), pool);
+  }
+}
+
 } /* namespace executor */
 } /* namespace peloton */
@@ -13,6 +13,7 @@
 #include "executor/seq_scan_executor.h"
 
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -55,6 +56,12 @@ bool SeqScanExecutor::DInit() {
   target_table_ = node.GetTable();
 
   current_tile_group_offset_ = START_OID;
+  tuples_read_ = 0;
+  tuples_returned_ = 0;
+
+  // Compiled predicates fold the parameters of the execution in
+  compiled_predicate_.reset();
+  predicate_compile_attempted_ = false;
 
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
@@ -63,6 +70,18 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    // Compile the predicate against the table's column types.
+    if (predicate_ != nullptr) {
+      std::vector<ValueType> column_types;
+      auto schema = target_table_->GetSchema();
+      for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+           column_itr++) {
+        column_types.push_back(schema->GetType(column_itr));
+      }
+      compiled_predicate_ = expression::CompiledExpression::Compile(
+          predicate_, column_types, {}, executor_context_);
+    }
   }
 
   return true;
@@ -85,11 +104,29 @@ bool SeqScanExecutor::DExecute() {
       std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
       if (predicate_ != nullptr) {
+        // Compile the predicate once we know the child's column types.
+        if (compiled_predicate_ == nullptr && !predicate_compile_attempted_) {
+          predicate_compile_attempted_ = true;
+          compiled_predicate_ = expression::CompiledExpression::Compile(
+              predicate_,
+              expression::CompiledExpression::GetColumnTypes(tile.get()), {},
+              executor_context_);
+        }
+        bool use_compiled = compiled_predicate_ != nullptr &&
+                            compiled_predicate_->Bind(0, tile.get());
+
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
-          expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                  .IsFalse()) {
+          bool is_false;
+          if (use_compiled) {
+            is_false = compiled_predicate_->EvaluatesFalse(tuple_id);
+          } else {
+            expression::ContainerTuple<LogicalTile> tuple(tile.get(),
+                                                          tuple_id);
+            is_false = predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                           .IsFalse();
+          }
+          if (is_false) {
             tile->RemoveVisibility(tuple_id);
           }
         }
@@ -121,13 +158,23 @@ bool SeqScanExecutor::DExecute() {
     auto current_txn = executor_context_->GetTransaction();
 
     // Retrieve next tile group.
-    while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
+    for (oid_t tile_group_offset = NextTileGroupOffset();
+         tile_group_offset < table_tile_group_count_;
+         tile_group_offset = NextTileGroupOffset()) {
+      auto tile_group = target_table_->GetTileGroup(tile_group_offset);
+
+      // Skip tile groups whose zone maps rule out the predicate
+      if (SkipTileGroup(tile_group.get())) {
+        continue;
+      }
+
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      bool use_compiled = compiled_predicate_ != nullptr &&
+                          compiled_predicate_->Bind(0, tile_group.get());
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
@@ -148,11 +195,16 @@ bool SeqScanExecutor::DExecute() {
               return res;
             }
           } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
             LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                            .IsTrue();
+            bool eval;
+            if (use_compiled) {
+              eval = compiled_predicate_->EvaluatesTrue(tuple_id);
+            } else {
+              expression::ContainerTuple<storage::TileGroup> tuple(
+                  tile_group.get(), tuple_id);
+              eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                         .IsTrue();
+            }
             LOG_TRACE("Evaluation result: %d", eval);
             if (eval == true) {
               position_list.push_back(tuple_id);
@@ -168,6 +220,9 @@ bool SeqScanExecutor::DExecute() {
         }
       }
 
+      tuples_read_ += active_tuple_count;
+      tuples_returned_ += position_list.size();
+
       // Don't return empty tiles
       if (position_list.size() == 0) {
         continue;
@@ -182,10 +237,25 @@ bool SeqScanExecutor::DExecute() {
       SetOutput(logical_tile.release());
       return true;
     }
+
+    RecordSample(target_table_, {}, tuples_read_, tuples_returned_);
   }
 
   return false;
 }
 
+/**
+ * @brief Claims the next tile group to scan. The workers of a parallel scan
+ * draw them from the cursor they share, so each one is scanned only once.
+ * @return The offset of the tile group in the table.
+ */
+oid_t SeqScanExecutor::NextTileGroupOffset() {
+  auto morsel_cursor = executor_context_->GetMorselCursor();
+  if (morsel_cursor != nullptr) {
+    return morsel_cursor->fetch_add(1);
+  }
+  return current_tile_group_offset_++;
+}
+
 }  // namespace executor
 }  // namespace peloton
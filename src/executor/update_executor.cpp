@@ -18,6 +18,8 @@
 #include "executor/logical_tile.h"
 #include "executor/executor_context.h"
 #include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
@@ -53,6 +55,25 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  // Parameters set a column as values of its type
+  std::vector<ValueType> param_types;
+  auto schema = target_table_->GetSchema();
+  for (auto &target : project_info_->GetTargetList()) {
+    auto expr = target.second;
+    if (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_PARAMETER) {
+      auto param_idx =
+          static_cast<const expression::ParameterValueExpression *>(expr)
+              ->GetValueIdx();
+      if (param_idx >= param_types.size()) {
+        param_types.resize(param_idx + 1, VALUE_TYPE_INVALID);
+      }
+      param_types[param_idx] = schema->GetType(target.first);
+    } else {
+      expression::ExpressionUtil::GetParameterTypes(expr, param_types);
+    }
+  }
+  executor_context_->CastParams(param_types);
+
   return true;
 }
 
@@ -179,6 +200,14 @@ bool UpdateExecutor::DExecute() {
       }
     }
   }
+  // Sample the write for the index tuner
+  std::vector<oid_t> updated_column_ids;
+  for (auto &target : project_info_->GetTargetList()) {
+    updated_column_ids.push_back(target.first);
+  }
+  target_table_->RecordWriteSample(updated_column_ids,
+                                   source_tile->GetTupleCount());
+
   return true;
 }
 
@@ -0,0 +1,1026 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.cpp
+//
+// Identification: src/expression/compiled_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/compiled_expression.h"
+
+#include <cstring>
+#include <sstream>
+
+#include <arpa/inet.h>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "common/varlen.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/like_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/string_expression.h"
+#include "expression/string_kernels.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Storage helpers
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Decode a varchar stored in tuple storage without building a Value.
+ * Mirrors Value::InitFromTupleStorage.
+ * @return false if the stored value is NULL.
+ */
+static inline bool DecodeVarchar(const char *storage, bool is_inlined,
+                                 const char **data, int32_t *length) {
+  const char *object;
+  if (is_inlined) {
+    object = storage;
+    if ((object[0] & OBJECT_NULL_BIT) != 0) return false;
+    *length = object[0];
+    *data = object + SHORT_OBJECT_LENGTHLENGTH;
+    return true;
+  }
+
+  const Varlen *varlen = *reinterpret_cast<const Varlen *const *>(storage);
+  if (varlen == nullptr) return false;
+
+  object = varlen->Get();
+  const char mask =
+      ~static_cast<char>(OBJECT_NULL_BIT | OBJECT_CONTINUATION_BIT);
+  if ((object[0] & OBJECT_CONTINUATION_BIT) != 0) {
+    char length_bytes[4];
+    length_bytes[0] = static_cast<char>(object[0] & mask);
+    length_bytes[1] = object[1];
+    length_bytes[2] = object[2];
+    length_bytes[3] = object[3];
+    *length = ntohl(*reinterpret_cast<int32_t *>(length_bytes));
+    *data = object + LONG_OBJECT_LENGTHLENGTH;
+  } else {
+    *length = object[0] & mask;
+    *data = object + SHORT_OBJECT_LENGTHLENGTH;
+  }
+  return true;
+}
+
+// Same ordering as Value::CompareStringValue (length first)
+static inline int CompareVarchar(const char *left, int32_t left_length,
+                                 const char *right, int32_t right_length) {
+  if (left_length != right_length) {
+    return (left_length > right_length) ? VALUE_COMPARE_GREATERTHAN
+                                        : VALUE_COMPARE_LESSTHAN;
+  }
+  const int result = ::strncmp(left, right, left_length);
+  if (result > 0) return VALUE_COMPARE_GREATERTHAN;
+  if (result < 0) return VALUE_COMPARE_LESSTHAN;
+  return VALUE_COMPARE_EQUAL;
+}
+
+//===--------------------------------------------------------------------===//
+// Compilation
+//===--------------------------------------------------------------------===//
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const AbstractExpression *expr, const std::vector<ValueType> &left_types,
+    const std::vector<ValueType> &right_types,
+    executor::ExecutorContext *context) {
+  if (expr == nullptr) return nullptr;
+
+  std::unique_ptr<CompiledExpression> program(new CompiledExpression());
+  program->input_types_[0] = left_types;
+  program->input_types_[1] = right_types;
+  program->context_ = context;
+
+  auto result = program->CompileNode(expr);
+  if (result == INVALID_OID) {
+    LOG_TRACE("Expression cannot be compiled, using interpreter");
+    return nullptr;
+  }
+
+  program->result_register_ = result;
+  program->result_type_ = program->register_types_[result];
+
+  LOG_TRACE("Compiled expression : %s", program->GetInfo().c_str());
+  return program;
+}
+
+oid_t CompiledExpression::NewRegister(RegisterKind kind, ValueType type) {
+  Register reg;
+  reg.i = 0;
+  reg.str = nullptr;
+  reg.len = 0;
+  reg.is_null = true;
+
+  registers_.push_back(reg);
+  register_kinds_.push_back(kind);
+  register_types_.push_back(type);
+  return registers_.size() - 1;
+}
+
+void CompiledExpression::Emit(OpCode op, oid_t dst, oid_t a, oid_t b) {
+  Instruction instruction;
+  instruction.op = op;
+  instruction.dst = dst;
+  instruction.a = a;
+  // unary instructions read their operand twice
+  instruction.b = (b == INVALID_OID) ? a : b;
+  instruction.target = INVALID_OID;
+  program_.push_back(instruction);
+}
+
+oid_t CompiledExpression::CompileNode(const AbstractExpression *expr) {
+  if (expr == nullptr) return INVALID_OID;
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_TUPLE:
+      return CompileColumn(expr);
+
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto constant = dynamic_cast<const ConstantValueExpression *>(expr);
+      if (constant == nullptr) return INVALID_OID;
+      return CompileConstant(constant->getValue());
+    }
+
+    case EXPRESSION_TYPE_VALUE_PARAMETER: {
+      // Parameters are fixed for the lifetime of the executor context,
+      // so they are folded into constant registers.
+      auto parameter = dynamic_cast<const ParameterValueExpression *>(expr);
+      if (parameter == nullptr || context_ == nullptr) return INVALID_OID;
+      auto &params = context_->GetParams();
+      if (parameter->GetValueIdx() >= params.size()) return INVALID_OID;
+      return CompileConstant(params[parameter->GetValueIdx()]);
+    }
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return CompileComparison(expr);
+
+    case EXPRESSION_TYPE_COMPARE_LIKE:
+    case EXPRESSION_TYPE_COMPARE_NOTLIKE:
+      return CompileLike(expr);
+
+    case EXPRESSION_TYPE_CHAR_LEN:
+    case EXPRESSION_TYPE_OCTET_LEN:
+    case EXPRESSION_TYPE_SUBSTR:
+      return CompileStringFunction(expr);
+
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY:
+      return CompileArithmetic(expr);
+
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR:
+      return CompileConjunction(expr);
+
+    case EXPRESSION_TYPE_OPERATOR_NOT: {
+      auto operand = CompileNode(expr->GetLeft());
+      if (operand == INVALID_OID || register_kinds_[operand] != KIND_BOOLEAN)
+        return INVALID_OID;
+      auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+      Emit(OP_NOT, dst, operand);
+      return dst;
+    }
+
+    case EXPRESSION_TYPE_OPERATOR_IS_NULL: {
+      auto operand = CompileNode(expr->GetLeft());
+      if (operand == INVALID_OID) return INVALID_OID;
+      auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+      Emit(OP_IS_NULL, dst, operand);
+      return dst;
+    }
+
+    default:
+      return INVALID_OID;
+  }
+}
+
+oid_t CompiledExpression::CompileColumn(const AbstractExpression *expr) {
+  auto tuple_value = dynamic_cast<const TupleValueExpression *>(expr);
+  if (tuple_value == nullptr) return INVALID_OID;
+
+  oid_t input_idx = (tuple_value->GetTupleIdx() == 0) ? 0 : 1;
+  oid_t column_id = tuple_value->GetColumnId();
+  auto &types = input_types_[input_idx];
+  if (column_id >= types.size()) return INVALID_OID;
+
+  ValueType type = types[column_id];
+  OpCode op;
+  RegisterKind kind;
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+      op = OP_LOAD_TINYINT;
+      kind = KIND_INT;
+      break;
+    case VALUE_TYPE_SMALLINT:
+      op = OP_LOAD_SMALLINT;
+      kind = KIND_INT;
+      break;
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_DATE:
+      op = OP_LOAD_INTEGER;
+      kind = KIND_INT;
+      break;
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+      op = OP_LOAD_BIGINT;
+      kind = KIND_INT;
+      break;
+    case VALUE_TYPE_DOUBLE:
+      op = OP_LOAD_DOUBLE;
+      kind = KIND_DOUBLE;
+      break;
+    case VALUE_TYPE_VARCHAR:
+      op = OP_LOAD_VARCHAR;
+      kind = KIND_VARCHAR;
+      break;
+    default:
+      return INVALID_OID;
+  }
+
+  // Share one slot per referenced column
+  oid_t slot_id = INVALID_OID;
+  for (oid_t slot_itr = 0; slot_itr < slots_.size(); slot_itr++) {
+    if (slots_[slot_itr].input_idx == input_idx &&
+        slots_[slot_itr].column_id == column_id) {
+      slot_id = slot_itr;
+      break;
+    }
+  }
+  if (slot_id == INVALID_OID) {
+    ColumnSlot slot;
+    slot.input_idx = input_idx;
+    slot.column_id = column_id;
+    slot.type = type;
+    slots_.push_back(slot);
+    slot_id = slots_.size() - 1;
+  }
+
+  auto dst = NewRegister(kind, type);
+  Emit(op, dst, slot_id);
+  return dst;
+}
+
+oid_t CompiledExpression::CompileConstant(const Value &value) {
+  ValueType type = value.GetValueType();
+  oid_t dst;
+
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      dst = NewRegister(KIND_INT, type);
+      registers_[dst].is_null = value.IsNull();
+      if (!value.IsNull()) registers_[dst].i = ValuePeeker::PeekAsBigInt(value);
+      break;
+    case VALUE_TYPE_DOUBLE:
+      dst = NewRegister(KIND_DOUBLE, type);
+      registers_[dst].is_null = value.IsNull();
+      if (!value.IsNull()) registers_[dst].d = ValuePeeker::PeekDouble(value);
+      break;
+    case VALUE_TYPE_BOOLEAN:
+      dst = NewRegister(KIND_BOOLEAN, type);
+      registers_[dst].is_null = value.IsNull();
+      if (!value.IsNull()) registers_[dst].i = value.IsTrue() ? 1 : 0;
+      break;
+    case VALUE_TYPE_VARCHAR: {
+      dst = NewRegister(KIND_VARCHAR, type);
+      registers_[dst].is_null = value.IsNull();
+      if (!value.IsNull()) {
+        // Keep our own reference so the bytes outlive the caller's Value
+        pinned_values_.push_back(value);
+        auto &pinned = pinned_values_.back();
+        registers_[dst].str = reinterpret_cast<const char *>(
+            ValuePeeker::PeekObjectValueWithoutNull(pinned));
+        registers_[dst].len = ValuePeeker::PeekObjectLengthWithoutNull(pinned);
+      }
+    } break;
+    default:
+      return INVALID_OID;
+  }
+
+  return dst;
+}
+
+oid_t CompiledExpression::CoerceToDouble(oid_t reg) {
+  if (register_kinds_[reg] == KIND_DOUBLE) return reg;
+  PL_ASSERT(register_kinds_[reg] == KIND_INT);
+  auto dst = NewRegister(KIND_DOUBLE, VALUE_TYPE_DOUBLE);
+  Emit(OP_INT_TO_DOUBLE, dst, reg);
+  return dst;
+}
+
+oid_t CompiledExpression::CompileComparison(const AbstractExpression *expr) {
+  auto left = CompileNode(expr->GetLeft());
+  if (left == INVALID_OID) return INVALID_OID;
+  auto right = CompileNode(expr->GetRight());
+  if (right == INVALID_OID) return INVALID_OID;
+
+  auto left_kind = register_kinds_[left];
+  auto right_kind = register_kinds_[right];
+
+  // Offsets into the *_INT, *_DOUBLE and *_VARCHAR opcode groups
+  int base;
+  if (left_kind == KIND_INT && right_kind == KIND_INT) {
+    base = OP_EQ_INT;
+  } else if ((left_kind == KIND_INT || left_kind == KIND_DOUBLE) &&
+             (right_kind == KIND_INT || right_kind == KIND_DOUBLE)) {
+    left = CoerceToDouble(left);
+    right = CoerceToDouble(right);
+    base = OP_EQ_DOUBLE;
+  } else if (left_kind == KIND_VARCHAR && right_kind == KIND_VARCHAR) {
+    auto dst = CompileDictionaryComparison(expr, left, right);
+    if (dst != INVALID_OID) return dst;
+    base = OP_EQ_VARCHAR;
+  } else {
+    return INVALID_OID;
+  }
+
+  int offset;
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      offset = 0;
+      break;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      offset = 1;
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      offset = 2;
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      offset = 3;
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      offset = 4;
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      offset = 5;
+      break;
+    default:
+      return INVALID_OID;
+  }
+
+  auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+  Emit(static_cast<OpCode>(base + offset), dst, left, right);
+  return dst;
+}
+
+/**
+ * @brief Fuse "column = constant" and "column <> constant" on varchars into
+ * one instruction that compares dictionary codes when the bound tile is
+ * dictionary encoded.
+ * @return INVALID_OID if the comparison does not have that shape.
+ */
+oid_t CompiledExpression::CompileDictionaryComparison(
+    const AbstractExpression *expr, oid_t left, oid_t right) {
+  auto type = expr->GetExpressionType();
+  if (type != EXPRESSION_TYPE_COMPARE_EQUAL &&
+      type != EXPRESSION_TYPE_COMPARE_NOTEQUAL) {
+    return INVALID_OID;
+  }
+
+  // Constants and parameters are the only registers no instruction writes
+  auto is_constant = [this](oid_t reg) {
+    for (auto &instruction : program_) {
+      if (instruction.dst == reg) return false;
+    }
+    return true;
+  };
+
+  // The column load is the last instruction emitted for either operand order
+  if (program_.empty() || program_.back().op != OP_LOAD_VARCHAR) {
+    return INVALID_OID;
+  }
+  auto column = program_.back().dst;
+  auto constant = (column == left) ? right : left;
+  if ((column != left && column != right) || !is_constant(constant)) {
+    return INVALID_OID;
+  }
+
+  DictionaryProbe probe;
+  probe.slot = program_.back().a;
+  probe.constant = constant;
+  probes_.push_back(probe);
+  program_.pop_back();
+
+  auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+  Emit(type == EXPRESSION_TYPE_COMPARE_EQUAL ? OP_EQ_DICT : OP_NE_DICT, dst,
+       probe.slot, constant);
+  program_.back().target = probes_.size() - 1;
+  return dst;
+}
+
+oid_t CompiledExpression::CompileArithmetic(const AbstractExpression *expr) {
+  auto left = CompileNode(expr->GetLeft());
+  if (left == INVALID_OID) return INVALID_OID;
+  auto right = CompileNode(expr->GetRight());
+  if (right == INVALID_OID) return INVALID_OID;
+
+  // Follow Value::PromoteForOp; DATE operands are not promotable there
+  auto promotable = [this](oid_t reg) {
+    return register_kinds_[reg] != KIND_VARCHAR &&
+           register_kinds_[reg] != KIND_BOOLEAN &&
+           register_types_[reg] != VALUE_TYPE_DATE;
+  };
+  if (!promotable(left) || !promotable(right)) return INVALID_OID;
+
+  bool is_double = register_kinds_[left] == KIND_DOUBLE ||
+                   register_kinds_[right] == KIND_DOUBLE;
+  if (is_double) {
+    left = CoerceToDouble(left);
+    right = CoerceToDouble(right);
+  }
+
+  OpCode op;
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+      op = is_double ? OP_ADD_DOUBLE : OP_ADD_INT;
+      break;
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+      op = is_double ? OP_SUB_DOUBLE : OP_SUB_INT;
+      break;
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY:
+      op = is_double ? OP_MUL_DOUBLE : OP_MUL_INT;
+      break;
+    default:
+      return INVALID_OID;
+  }
+
+  auto dst = is_double ? NewRegister(KIND_DOUBLE, VALUE_TYPE_DOUBLE)
+                       : NewRegister(KIND_INT, VALUE_TYPE_BIGINT);
+  Emit(op, dst, left, right);
+  return dst;
+}
+
+oid_t CompiledExpression::CompileConjunction(const AbstractExpression *expr) {
+  bool is_and = (expr->GetExpressionType() == EXPRESSION_TYPE_CONJUNCTION_AND);
+
+  auto left = CompileNode(expr->GetLeft());
+  if (left == INVALID_OID || register_kinds_[left] != KIND_BOOLEAN)
+    return INVALID_OID;
+
+  // Skip the right subtree when the left side already decides the result
+  auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+  auto jump = program_.size();
+  Emit(is_and ? OP_JUMP_IF_FALSE : OP_JUMP_IF_TRUE, dst, left);
+
+  auto right = CompileNode(expr->GetRight());
+  if (right == INVALID_OID || register_kinds_[right] != KIND_BOOLEAN)
+    return INVALID_OID;
+
+  Emit(is_and ? OP_AND : OP_OR, dst, left, right);
+  program_[jump].target = program_.size();
+  return dst;
+}
+
+oid_t CompiledExpression::CompileLike(const AbstractExpression *expr) {
+  auto value = CompileNode(expr->GetLeft());
+  if (value == INVALID_OID || register_kinds_[value] != KIND_VARCHAR)
+    return INVALID_OID;
+
+  // Only patterns known at compile time are precompiled
+  auto like = dynamic_cast<const LikeExpression *>(expr);
+  if (like != nullptr) {
+    patterns_.push_back(like->GetPattern());
+  } else {
+    auto pattern = CompileNode(expr->GetRight());
+    if (pattern == INVALID_OID || register_kinds_[pattern] != KIND_VARCHAR)
+      return INVALID_OID;
+    // a constant register is never written by the program
+    auto &pattern_register = registers_[pattern];
+    bool is_constant = true;
+    for (auto &instruction : program_) {
+      if (instruction.dst == pattern) is_constant = false;
+    }
+    if (!is_constant || pattern_register.is_null) return INVALID_OID;
+    patterns_.emplace_back(pattern_register.str, pattern_register.len);
+  }
+
+  auto dst = NewRegister(KIND_BOOLEAN, VALUE_TYPE_BOOLEAN);
+  Emit(expr->GetExpressionType() == EXPRESSION_TYPE_COMPARE_LIKE ? OP_LIKE
+                                                                 : OP_NOT_LIKE,
+       dst, value);
+  program_.back().target = patterns_.size() - 1;
+  return dst;
+}
+
+oid_t CompiledExpression::CompileStringFunction(
+    const AbstractExpression *expr) {
+  auto value = CompileNode(expr->GetLeft());
+  if (value == INVALID_OID || register_kinds_[value] != KIND_VARCHAR)
+    return INVALID_OID;
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_CHAR_LEN: {
+      auto dst = NewRegister(KIND_INT, VALUE_TYPE_BIGINT);
+      Emit(OP_CHAR_LENGTH, dst, value);
+      return dst;
+    }
+    case EXPRESSION_TYPE_OCTET_LEN: {
+      auto dst = NewRegister(KIND_INT, VALUE_TYPE_INTEGER);
+      Emit(OP_OCTET_LENGTH, dst, value);
+      return dst;
+    }
+    default:
+      break;
+  }
+
+  // SUBSTRING(value FROM start [FOR length]) slices the input in place
+  auto substring = dynamic_cast<const SubstringExpression *>(expr);
+  if (substring == nullptr) return INVALID_OID;
+
+  auto start = CompileNode(expr->GetRight());
+  if (start == INVALID_OID || register_kinds_[start] != KIND_INT)
+    return INVALID_OID;
+
+  auto length = INVALID_OID;
+  if (substring->GetLengthExpression() != nullptr) {
+    length = CompileNode(substring->GetLengthExpression());
+    if (length == INVALID_OID || register_kinds_[length] != KIND_INT)
+      return INVALID_OID;
+  }
+
+  auto dst = NewRegister(KIND_VARCHAR, VALUE_TYPE_VARCHAR);
+  Emit(OP_SUBSTRING, dst, value, start);
+  program_.back().target = length;
+  return dst;
+}
+
+//===--------------------------------------------------------------------===//
+// Binding
+//===--------------------------------------------------------------------===//
+
+std::vector<ValueType> CompiledExpression::GetColumnTypes(
+    storage::TileGroup *tile_group) {
+  std::vector<ValueType> types;
+  auto &tile_schemas = tile_group->GetTileSchemas();
+  for (auto &entry : tile_group->GetColumnMap()) {
+    if (entry.first >= types.size())
+      types.resize(entry.first + 1, VALUE_TYPE_INVALID);
+    types[entry.first] =
+        tile_schemas[entry.second.first].GetType(entry.second.second);
+  }
+  return types;
+}
+
+std::vector<ValueType> CompiledExpression::GetColumnTypes(
+    executor::LogicalTile *tile) {
+  std::vector<ValueType> types;
+  for (auto &column_info : tile->GetSchema()) {
+    if (column_info.base_tile == nullptr) {
+      types.push_back(VALUE_TYPE_INVALID);
+    } else {
+      types.push_back(column_info.base_tile->GetSchema()->GetType(
+          column_info.origin_column_id));
+    }
+  }
+  return types;
+}
+
+bool CompiledExpression::Bind(oid_t input_idx, storage::TileGroup *tile_group) {
+  auto &column_map = tile_group->GetColumnMap();
+
+  for (auto &slot : slots_) {
+    if (slot.input_idx != input_idx) continue;
+
+    auto entry = column_map.find(slot.column_id);
+    if (entry == column_map.end()) return false;
+
+    auto tile = tile_group->GetTile(entry->second.first);
+    auto schema = tile->GetSchema();
+    auto tile_column_id = entry->second.second;
+    if (schema->GetType(tile_column_id) != slot.type) return false;
+
+    BindColumn(slot, tile, tile_column_id);
+    slot.positions = nullptr;
+  }
+
+  BindDictionaryProbes(input_idx);
+  return true;
+}
+
+bool CompiledExpression::Bind(oid_t input_idx, executor::LogicalTile *tile) {
+  auto &position_lists = tile->GetPositionLists();
+
+  for (auto &slot : slots_) {
+    if (slot.input_idx != input_idx) continue;
+
+    if (slot.column_id >= tile->GetColumnCount()) return false;
+    auto &column_info = tile->GetColumnInfo(slot.column_id);
+    auto base_tile = column_info.base_tile.get();
+    if (base_tile == nullptr) return false;
+
+    auto schema = base_tile->GetSchema();
+    auto origin_column_id = column_info.origin_column_id;
+    if (schema->GetType(origin_column_id) != slot.type) return false;
+
+    BindColumn(slot, base_tile, origin_column_id);
+    slot.positions = position_lists[column_info.position_list_idx].data();
+  }
+
+  BindDictionaryProbes(input_idx);
+  return true;
+}
+
+// Point a slot at a tile column. Frozen columns are decoded in one batch
+// into the slot, so the loads read them like a hot tile's fields.
+void CompiledExpression::BindColumn(ColumnSlot &slot, storage::Tile *tile,
+                                    oid_t column_id) {
+  auto schema = tile->GetSchema();
+  slot.is_inlined = schema->IsInlined(column_id);
+  slot.codes = tile->GetDictionaryCodes(column_id);
+  slot.dictionary = tile->GetDictionary(column_id);
+
+  if (tile->IsFrozen()) {
+    auto encoded_column = tile->GetEncodedColumn(column_id);
+    slot.stride = encoded_column->GetFieldLength();
+    slot.decoded.resize(encoded_column->GetTupleCount() * slot.stride);
+    encoded_column->Decode(0, encoded_column->GetTupleCount(),
+                           slot.decoded.data());
+    slot.base = slot.decoded.data();
+    return;
+  }
+
+  slot.base = tile->GetTupleLocation(0) + schema->GetOffset(column_id);
+  slot.stride = schema->GetLength();
+}
+
+// Look the constants of dictionary comparisons up in the newly bound
+// dictionaries. A constant missing from the dictionary matches no code.
+void CompiledExpression::BindDictionaryProbes(oid_t input_idx) {
+  for (auto &probe : probes_) {
+    auto &slot = slots_[probe.slot];
+    if (slot.input_idx != input_idx || slot.codes == nullptr) continue;
+
+    auto &constant = registers_[probe.constant];
+    probe.found = !constant.is_null &&
+                  slot.dictionary->Lookup(constant.str, constant.len,
+                                          &probe.code);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Evaluation
+//===--------------------------------------------------------------------===//
+
+const CompiledExpression::Register &CompiledExpression::Run(oid_t tuple1,
+                                                            oid_t tuple2) {
+  const oid_t tuple_ids[2] = {tuple1, tuple2};
+  Register *regs = registers_.data();
+  const Instruction *code = program_.data();
+  const size_t code_size = program_.size();
+
+  size_t pc = 0;
+  while (pc < code_size) {
+    const Instruction &ins = code[pc++];
+    Register &dst = regs[ins.dst];
+
+    // Column loads read the field straight out of the bound tile
+    if (ins.op <= OP_NE_DICT) {
+      const ColumnSlot &slot = slots_[ins.a];
+      oid_t row = tuple_ids[slot.input_idx];
+      if (slot.positions != nullptr) row = slot.positions[row];
+      if (row == NULL_OID) {
+        dst.is_null = true;
+        continue;
+      }
+      const char *field = slot.base + row * slot.stride;
+
+      switch (ins.op) {
+        case OP_LOAD_TINYINT: {
+          auto value = *reinterpret_cast<const int8_t *>(field);
+          dst.i = value;
+          dst.is_null = (value == INT8_NULL);
+        } break;
+        case OP_LOAD_SMALLINT: {
+          auto value = *reinterpret_cast<const int16_t *>(field);
+          dst.i = value;
+          dst.is_null = (value == INT16_NULL);
+        } break;
+        case OP_LOAD_INTEGER: {
+          auto value = *reinterpret_cast<const int32_t *>(field);
+          dst.i = value;
+          dst.is_null = (value == INT32_NULL);
+        } break;
+        case OP_LOAD_BIGINT: {
+          auto value = *reinterpret_cast<const int64_t *>(field);
+          dst.i = value;
+          dst.is_null = (value == INT64_NULL);
+        } break;
+        case OP_LOAD_DOUBLE: {
+          auto value = *reinterpret_cast<const double *>(field);
+          dst.d = value;
+          dst.is_null = (value <= DOUBLE_NULL);
+        } break;
+        case OP_LOAD_VARCHAR:
+          dst.is_null =
+              !DecodeVarchar(field, slot.is_inlined, &dst.str, &dst.len);
+          break;
+        default: {
+          const Register &constant = regs[ins.b];
+          bool equal;
+          if (slot.codes != nullptr) {
+            auto code = slot.codes[row];
+            dst.is_null = constant.is_null ||
+                          code == storage::Dictionary::NULL_CODE;
+            const DictionaryProbe &probe = probes_[ins.target];
+            equal = probe.found && code == probe.code;
+          } else {
+            const char *str;
+            int32_t len;
+            dst.is_null = constant.is_null ||
+                          !DecodeVarchar(field, slot.is_inlined, &str, &len);
+            equal = !dst.is_null &&
+                    CompareVarchar(str, len, constant.str, constant.len) ==
+                        VALUE_COMPARE_EQUAL;
+          }
+          dst.i = (equal == (ins.op == OP_EQ_DICT));
+        } break;
+      }
+      continue;
+    }
+
+    const Register &a = regs[ins.a];
+    const Register &b = regs[ins.b];
+
+    switch (ins.op) {
+      case OP_INT_TO_DOUBLE:
+        dst.d = static_cast<double>(a.i);
+        dst.is_null = a.is_null;
+        break;
+
+      case OP_EQ_INT:
+        dst.i = (a.i == b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_NE_INT:
+        dst.i = (a.i != b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_LT_INT:
+        dst.i = (a.i < b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_GT_INT:
+        dst.i = (a.i > b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_LE_INT:
+        dst.i = (a.i <= b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_GE_INT:
+        dst.i = (a.i >= b.i);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+
+      case OP_EQ_DOUBLE:
+        dst.i = (a.d == b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_NE_DOUBLE:
+        dst.i = (a.d != b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_LT_DOUBLE:
+        dst.i = (a.d < b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_GT_DOUBLE:
+        dst.i = (a.d > b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_LE_DOUBLE:
+        dst.i = (a.d <= b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+      case OP_GE_DOUBLE:
+        dst.i = (a.d >= b.d);
+        dst.is_null = a.is_null || b.is_null;
+        break;
+
+      case OP_EQ_VARCHAR:
+      case OP_NE_VARCHAR:
+      case OP_LT_VARCHAR:
+      case OP_GT_VARCHAR:
+      case OP_LE_VARCHAR:
+      case OP_GE_VARCHAR: {
+        dst.is_null = a.is_null || b.is_null;
+        if (dst.is_null) break;
+        int cmp = CompareVarchar(a.str, a.len, b.str, b.len);
+        switch (ins.op) {
+          case OP_EQ_VARCHAR:
+            dst.i = (cmp == VALUE_COMPARE_EQUAL);
+            break;
+          case OP_NE_VARCHAR:
+            dst.i = (cmp != VALUE_COMPARE_EQUAL);
+            break;
+          case OP_LT_VARCHAR:
+            dst.i = (cmp == VALUE_COMPARE_LESSTHAN);
+            break;
+          case OP_GT_VARCHAR:
+            dst.i = (cmp == VALUE_COMPARE_GREATERTHAN);
+            break;
+          case OP_LE_VARCHAR:
+            dst.i = (cmp != VALUE_COMPARE_GREATERTHAN);
+            break;
+          default:
+            dst.i = (cmp != VALUE_COMPARE_LESSTHAN);
+            break;
+        }
+      } break;
+
+      case OP_ADD_INT:
+      case OP_SUB_INT:
+      case OP_MUL_INT: {
+        dst.is_null = a.is_null || b.is_null;
+        if (dst.is_null) break;
+        long long result;
+        bool overflow;
+        const char *name;
+        if (ins.op == OP_ADD_INT) {
+          overflow = __builtin_add_overflow(a.i, b.i, &result);
+          name = "Adding";
+        } else if (ins.op == OP_SUB_INT) {
+          overflow = __builtin_sub_overflow(a.i, b.i, &result);
+          name = "Subtracting";
+        } else {
+          overflow = __builtin_mul_overflow(a.i, b.i, &result);
+          name = "Multiplying";
+        }
+        // INT64_NULL is reserved as the NULL sentinel
+        if (overflow || result == INT64_NULL) {
+          char message[4096];
+          snprintf(message, 4096, "%s %jd and %jd will overflow BigInt storage",
+                   name, (intmax_t)a.i, (intmax_t)b.i);
+          throw Exception(message);
+        }
+        dst.i = result;
+      } break;
+
+      case OP_ADD_DOUBLE:
+        dst.is_null = a.is_null || b.is_null;
+        if (dst.is_null) break;
+        dst.d = a.d + b.d;
+        ThrowDataExceptionIfInfiniteOrNaN(dst.d, "'+' operator");
+        break;
+      case OP_SUB_DOUBLE:
+        dst.is_null = a.is_null || b.is_null;
+        if (dst.is_null) break;
+        dst.d = a.d - b.d;
+        ThrowDataExceptionIfInfiniteOrNaN(dst.d, "'-' operator");
+        break;
+      case OP_MUL_DOUBLE:
+        dst.is_null = a.is_null || b.is_null;
+        if (dst.is_null) break;
+        dst.d = a.d * b.d;
+        ThrowDataExceptionIfInfiniteOrNaN(dst.d, "'*' operator");
+        break;
+
+      case OP_AND:
+        // FALSE dominates, then NULL
+        if ((!a.is_null && a.i == 0) || (!b.is_null && b.i == 0)) {
+          dst.i = 0;
+          dst.is_null = false;
+        } else {
+          dst.i = 1;
+          dst.is_null = a.is_null || b.is_null;
+        }
+        break;
+      case OP_OR:
+        // TRUE dominates, then NULL
+        if ((!a.is_null && a.i != 0) || (!b.is_null && b.i != 0)) {
+          dst.i = 1;
+          dst.is_null = false;
+        } else {
+          dst.i = 0;
+          dst.is_null = a.is_null || b.is_null;
+        }
+        break;
+      case OP_NOT:
+        dst.i = (a.i == 0);
+        dst.is_null = a.is_null;
+        break;
+      case OP_IS_NULL:
+        dst.i = a.is_null;
+        dst.is_null = false;
+        break;
+
+      case OP_LIKE:
+      case OP_NOT_LIKE:
+        dst.is_null = a.is_null;
+        if (dst.is_null) break;
+        dst.i = (patterns_[ins.target].Match(a.str, a.len) ==
+                 (ins.op == OP_LIKE));
+        break;
+      case OP_CHAR_LENGTH:
+        dst.is_null = a.is_null;
+        if (dst.is_null) break;
+        dst.i = StringKernels::CharLength(a.str, a.len);
+        break;
+      case OP_OCTET_LENGTH:
+        dst.is_null = a.is_null;
+        if (dst.is_null) break;
+        dst.i = a.len;
+        break;
+      case OP_SUBSTRING:
+        dst.is_null = a.is_null || b.is_null ||
+                      (ins.target != INVALID_OID && regs[ins.target].is_null);
+        if (dst.is_null) break;
+        if (ins.target == INVALID_OID) {
+          StringKernels::SubstringFrom(a.str, a.len, b.i, &dst.str, &dst.len);
+        } else {
+          StringKernels::Substring(a.str, a.len, b.i, regs[ins.target].i,
+                                   &dst.str, &dst.len);
+        }
+        break;
+
+      case OP_JUMP_IF_FALSE:
+        if (!a.is_null && a.i == 0) {
+          dst.i = 0;
+          dst.is_null = false;
+          pc = ins.target;
+        }
+        break;
+      case OP_JUMP_IF_TRUE:
+        if (!a.is_null && a.i != 0) {
+          dst.i = 1;
+          dst.is_null = false;
+          pc = ins.target;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  return regs[result_register_];
+}
+
+Value CompiledExpression::EvaluateValue(oid_t tuple1, oid_t tuple2) {
+  const Register &result = Run(tuple1, tuple2);
+
+  if (result.is_null) return ValueFactory::GetNullValueByType(result_type_);
+
+  switch (result_type_) {
+    case VALUE_TYPE_TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(result.i));
+    case VALUE_TYPE_SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(result.i));
+    case VALUE_TYPE_INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(result.i));
+    case VALUE_TYPE_BIGINT:
+      return ValueFactory::GetBigIntValue(result.i);
+    case VALUE_TYPE_DATE:
+      return ValueFactory::GetDateValue(result.i);
+    case VALUE_TYPE_TIMESTAMP:
+      return ValueFactory::GetTimestampValue(result.i);
+    case VALUE_TYPE_DOUBLE:
+      return ValueFactory::GetDoubleValue(result.d);
+    case VALUE_TYPE_BOOLEAN:
+      return ValueFactory::GetBooleanValue(result.i != 0);
+    case VALUE_TYPE_VARCHAR: {
+      VarlenPool *pool = nullptr;
+      if (context_ != nullptr) pool = context_->GetExecutorContextPool();
+      return ValueFactory::GetStringValue(std::string(result.str, result.len),
+                                          pool);
+    }
+    default:
+      throw Exception("CompiledExpression::EvaluateValue invalid result type " +
+                      ValueTypeToString(result_type_));
+  }
+}
+
+const std::string CompiledExpression::GetInfo() const {
+  std::ostringstream os;
+  os << "CompiledExpression[" << program_.size() << " instructions, "
+     << registers_.size() << " registers, " << slots_.size()
+     << " column slots, result " << ValueTypeToString(result_type_) << "]";
+  return os.str();
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -23,6 +23,7 @@
 #include "expression/hash_range_expression.h"
 #include "expression/operator_expression.h"
 #include "expression/comparison_expression.h"
+#include "expression/like_expression.h"
 #include "expression/case_expression.h"
 #include "expression/conjunction_expression.h"
 #include "expression/constant_value_expression.h"
@@ -140,6 +141,15 @@ AbstractExpression *ExpressionUtil::ComparisonFactory(ExpressionType c,
       ConstantValueExpression *r_const =
           dynamic_cast<ConstantValueExpression *>(rc);
 
+      // constant LIKE patterns are compiled once up front
+      if ((c == EXPRESSION_TYPE_COMPARE_LIKE ||
+           c == EXPRESSION_TYPE_COMPARE_NOTLIKE) &&
+          r_const != nullptr &&
+          r_const->getValue().GetValueType() == VALUE_TYPE_VARCHAR &&
+          !r_const->getValue().IsNull()) {
+        return new LikeExpression(c, lc, r_const);
+      }
+
       // this will inline getValue(), hooray!
       if (l_const != nullptr &&
           r_const != nullptr) {  // CONST-CONST can it happen?
@@ -538,5 +548,35 @@ void ExpressionUtil::ConvertParameterExpressions(
   }
 }
 
+// The parameter of a pair of operands takes the type of the other one
+static void SetParameterType(const AbstractExpression *param_expr,
+                             const AbstractExpression *other_expr,
+                             std::vector<ValueType> &param_types) {
+  if (param_expr == nullptr || other_expr == nullptr ||
+      param_expr->GetExpressionType() != EXPRESSION_TYPE_VALUE_PARAMETER ||
+      other_expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_PARAMETER ||
+      other_expr->GetValueType() == VALUE_TYPE_INVALID) {
+    return;
+  }
+
+  auto param_idx =
+      static_cast<const ParameterValueExpression *>(param_expr)->GetValueIdx();
+  if (param_idx >= param_types.size()) {
+    param_types.resize(param_idx + 1, VALUE_TYPE_INVALID);
+  }
+  param_types[param_idx] = other_expr->GetValueType();
+}
+
+void ExpressionUtil::GetParameterTypes(const AbstractExpression *expr,
+                                       std::vector<ValueType> &param_types) {
+  if (expr == nullptr) return;
+
+  SetParameterType(expr->GetLeft(), expr->GetRight(), param_types);
+  SetParameterType(expr->GetRight(), expr->GetLeft(), param_types);
+
+  GetParameterTypes(expr->GetLeft(), param_types);
+  GetParameterTypes(expr->GetRight(), param_types);
+}
+
 }  // End expression namespace
 }  // End peloton namespace
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_pattern.cpp
+//
+// Identification: src/expression/like_pattern.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/like_pattern.h"
+
+#include "common/logger.h"
+#include "expression/string_kernels.h"
+
+namespace peloton {
+namespace expression {
+
+LikePattern::LikePattern(const char *pattern, int32_t length)
+    : pattern_(pattern, length) {
+  // Split on '%', dropping the empty segments of stacked '%'s
+  bool has_percent = false;
+  Segment current = {"", false, 0};
+  for (int32_t offset = 0; offset < length;) {
+    const char c = pattern[offset];
+    if (c == '%') {
+      has_percent = true;
+      if (offset == 0) leading_percent_ = true;
+      if (!current.chars.empty()) segments_.push_back(current);
+      current = {"", false, 0};
+      offset++;
+      continue;
+    }
+
+    int32_t code_point_length = StringKernels::CodePointLength(c);
+    if (offset + code_point_length > length) code_point_length = length - offset;
+    current.chars.append(pattern + offset, code_point_length);
+    current.code_points++;
+    if (c == '_') current.has_wildcard = true;
+    offset += code_point_length;
+  }
+  trailing_percent_ = (length > 0 && pattern[length - 1] == '%');
+  if (!current.chars.empty()) segments_.push_back(current);
+
+  // Pick a fast path
+  kind_ = LIKE_MATCH_GENERAL;
+  if (segments_.empty()) {
+    // '' only matches the empty string, '%' matches everything
+    kind_ = has_percent ? LIKE_MATCH_ANY : LIKE_MATCH_EXACT;
+  } else if (segments_.size() == 1 && !segments_[0].has_wildcard) {
+    if (!has_percent) {
+      kind_ = LIKE_MATCH_EXACT;
+    } else if (!leading_percent_) {
+      kind_ = LIKE_MATCH_PREFIX;
+    } else if (!trailing_percent_) {
+      kind_ = LIKE_MATCH_SUFFIX;
+    } else {
+      kind_ = LIKE_MATCH_CONTAINS;
+    }
+    literal_ = segments_[0].chars;
+  }
+  literal_length_ = static_cast<int32_t>(literal_.size());
+
+  LOG_TRACE("LIKE pattern '%s' : kind %d, %lu segments", pattern_.c_str(),
+            kind_, segments_.size());
+}
+
+bool LikePattern::Contains(const char *value, int32_t length) const {
+  if (literal_length_ > length) return false;
+  if (literal_length_ == 1) {
+    return ::memchr(value, literal_[0], length) != nullptr;
+  }
+  return ::memmem(value, length, literal_.data(), literal_length_) != nullptr;
+}
+
+bool LikePattern::MatchSegmentAt(const Segment &segment, const char *begin,
+                                 const char *end, const char **match_end) {
+  const char *cursor = begin;
+  const char *chars = segment.chars.data();
+  const size_t chars_length = segment.chars.size();
+
+  for (size_t offset = 0; offset < chars_length; offset++) {
+    if (cursor >= end) return false;
+    if (chars[offset] == '_') {
+      cursor += StringKernels::CodePointLength(*cursor);
+      if (cursor > end) return false;
+    } else {
+      // multi-byte code points are compared byte by byte
+      if (*cursor != chars[offset]) return false;
+      cursor++;
+    }
+  }
+
+  *match_end = cursor;
+  return true;
+}
+
+bool LikePattern::FindSegment(const Segment &segment, const char *begin,
+                              const char *end, const char **match_end) {
+  if (!segment.has_wildcard) {
+    auto found = static_cast<const char *>(::memmem(
+        begin, end - begin, segment.chars.data(), segment.chars.size()));
+    if (found == nullptr) return false;
+    *match_end = found + segment.chars.size();
+    return true;
+  }
+
+  const char first = segment.chars[0];
+  const char *cursor = begin;
+  while (cursor < end) {
+    // jump straight to candidates when the segment starts with a literal
+    if (first != '_') {
+      cursor = static_cast<const char *>(::memchr(cursor, first, end - cursor));
+      if (cursor == nullptr) return false;
+    }
+    if (MatchSegmentAt(segment, cursor, end, match_end)) return true;
+    cursor += StringKernels::CodePointLength(*cursor);
+  }
+  return false;
+}
+
+bool LikePattern::MatchGeneral(const char *value, int32_t length) const {
+  const char *cursor = value;
+  const char *end = value + length;
+  size_t first = 0;
+  size_t last = segments_.size();
+
+  // The first segment is anchored at the start unless the pattern opens
+  // with '%'
+  if (!leading_percent_) {
+    if (!MatchSegmentAt(segments_[0], cursor, end, &cursor)) return false;
+    first = 1;
+    if (segments_.size() == 1 && !trailing_percent_) return cursor == end;
+  }
+
+  // The last segment is anchored at the end unless the pattern closes
+  // with '%'. It covers exactly its code point count from the end.
+  const char *tail_end = end;
+  if (!trailing_percent_ && last > first) {
+    auto &tail = segments_[last - 1];
+    const char *tail_begin = end;
+    int32_t code_points = 0;
+    while (code_points < tail.code_points && tail_begin > cursor) {
+      tail_begin--;
+      if ((*tail_begin & 0xc0) != 0x80) code_points++;
+    }
+    if (code_points < tail.code_points) return false;
+
+    const char *tail_match_end;
+    if (!MatchSegmentAt(tail, tail_begin, end, &tail_match_end) ||
+        tail_match_end != end) {
+      return false;
+    }
+    tail_end = tail_begin;
+    last--;
+  }
+
+  // Middle segments: leftmost match of each in turn is always safe
+  for (size_t segment_itr = first; segment_itr < last; segment_itr++) {
+    if (!FindSegment(segments_[segment_itr], cursor, tail_end, &cursor)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -61,6 +61,9 @@ class configuration {
 
   // store ints
   bool ints_mode;
+
+  // run reads as a prepared statement
+  bool prepared_mode;
 };
 
 extern configuration state;
@@ -81,6 +84,8 @@ void ValidateDuration(const configuration &state);
 
 void ValidateTransactionCount(const configuration &state);
 
+void ValidatePreparedMode(const configuration &state);
+
 }  // namespace ycsb
 }  // namespace benchmark
 }  // namespace peloton
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// freeze_tuner.h
+//
+// Identification: src/include/brain/freeze_tuner.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+#include "common/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Freeze Tuner
+//===--------------------------------------------------------------------===//
+
+// Background step that freezes the cold tile groups of its tables
+// (see DataTable::FreezeTileGroup)
+class FreezeTuner {
+ public:
+  FreezeTuner(const FreezeTuner &) = delete;
+  FreezeTuner &operator=(const FreezeTuner &) = delete;
+  FreezeTuner(FreezeTuner &&) = delete;
+  FreezeTuner &operator=(FreezeTuner &&) = delete;
+
+  FreezeTuner();
+
+  ~FreezeTuner();
+
+  // Singleton
+  static FreezeTuner &GetInstance();
+
+  // Start tuning
+  void Start();
+
+  // Freeze cold tile groups till stopped
+  void Tune();
+
+  // Stop tuning
+  void Stop();
+
+  // Add table to list of tables whose tile groups must be frozen
+  void AddTable(storage::DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+ protected:
+  // Freeze the cold tile groups of a table, returns how many were frozen
+  oid_t FreezeTable(storage::DataTable *table);
+
+ private:
+  // Tables whose tile groups must be frozen
+  std::vector<storage::DataTable *> tables;
+
+  std::mutex freeze_tuner_mutex;
+
+  // Stop signal
+  std::atomic<bool> freeze_tuning_stop;
+
+  // Tuner thread
+  std::thread freeze_tuner_thread;
+
+  //===--------------------------------------------------------------------===//
+  // Tuner Parameters
+  //===--------------------------------------------------------------------===//
+
+  // Newest tile groups that are left alone, they are likely still updated
+  oid_t hot_tile_group_count = 2;
+
+  // Sleeping period (in us)
+  oid_t sleep_duration = 1000;
+};
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <atomic>
 #include <thread>
@@ -26,6 +26,9 @@ namespace brain {
 #define DEFAULT_COLUMN_VALUE 0.5
 #define DEFAULT_METRIC_VALUE 0
 
+// Samples a table holds until the tuners take them, later ones are dropped
+#define SAMPLE_BUFFER_SIZE 256
+
 enum SampleType {
   SAMPLE_TYPE_INVALID = 0,
 
@@ -54,6 +57,12 @@ class Sample : public Printable {
         sample_type_(sample_type),
         metric_(metric){}
 
+  // Sample accessing the given columns of a table with column_count columns
+  Sample(const size_t column_count, const std::vector<oid_t> &column_ids,
+         double weight = DEFAULT_SAMPLE_WEIGHT,
+         SampleType sample_type = SAMPLE_TYPE_ACCESS,
+         double metric = DEFAULT_METRIC_VALUE);
+
   // get the distance from other sample
   double GetDistance(const Sample &other) const;
 
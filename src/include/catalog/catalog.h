@@ -60,7 +60,8 @@ class Catalog {
   Result CreateIndex(const std::string &database_name,
                      const std::string &table_name,
                      std::vector<std::string> index_attr,
-                     std::string index_name, bool unique, IndexType index_type);
+                     std::string index_name, bool unique, IndexType index_type,
+                     concurrency::Transaction *txn = nullptr);
 
   // Drop a database
   Result DropDatabase(std::string database_name, concurrency::Transaction *txn);
@@ -70,6 +70,14 @@ class Column : public Printable {
 
   bool IsPrimary() const { return is_primary_; }
 
+  // Dictionary encoding only applies to uninlined VARCHAR columns
+  void SetDictionaryEncoded(bool dictionary_encoded) {
+    is_dictionary_encoded = dictionary_encoded &&
+                            column_type == VALUE_TYPE_VARCHAR && !is_inlined;
+  }
+
+  bool IsDictionaryEncoded() const { return is_dictionary_encoded; }
+
   // Add a constraint to the column
   void AddConstraint(const catalog::Constraint &constraint) {
     constraints.push_back(constraint);
@@ -117,6 +125,9 @@ class Column : public Printable {
   // is the column contained the primary key?
   bool is_primary_ = false;
 
+  // are cold tiles allowed to store this column as dictionary codes ?
+  bool is_dictionary_encoded = false;
+
   // offset of column in tuple
   oid_t column_offset = INVALID_OID;
 
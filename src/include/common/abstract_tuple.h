@@ -15,6 +15,7 @@
 
 #include "common/types.h"
 #include "common/value.h"
+#include "storage/dictionary.h"
 
 namespace peloton {
 
@@ -39,6 +40,16 @@ class AbstractTuple {
   /** @brief Get the raw location of the tuple's contents i.e. tuple.value_data.
    */
   virtual char *GetData() const = 0;
+
+  /** @brief Get the dictionary code of the value at the given column id.
+   * Returns false if the column is not dictionary encoded.
+   */
+  virtual bool GetDictionaryCode(
+      oid_t column_id UNUSED_ATTRIBUTE,
+      const storage::Dictionary **dictionary UNUSED_ATTRIBUTE,
+      storage::Dictionary::Code *code UNUSED_ATTRIBUTE) const {
+    return false;
+  }
 };
 
 }  // namespace peloton
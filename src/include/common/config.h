@@ -20,6 +20,24 @@ DECLARE_uint64(port);
 // Maximum number of connections
 DECLARE_uint64(max_connections);
 
+// Number of event loops of the wire server, one per core if 0
+DECLARE_uint64(event_loops);
+
+// Number of query plans cached across connections
+DECLARE_uint64(plan_cache_size);
+
+// Number of threads parsing a bulk import, one per core if 0
+DECLARE_uint64(import_threads);
+
+// Bytes of input parsed at a time by a bulk import thread
+DECLARE_uint64(import_chunk_size);
+
+// Number of threads a query scans a table with, one per core if 0
+DECLARE_uint64(parallel_degree);
+
+// Whether tables are analyzed in the background once enough of them changed
+DECLARE_bool(auto_analyze);
+
 // Socket family (AF_UNIX, AF_INET)
 DECLARE_string(socket_family);
 
@@ -16,11 +16,18 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstdint>
+
+#include "common/value.h"
 
 namespace peloton {
 
 class Statement;
 
+namespace bridge {
+class PlanCursor;
+}
+
 class Portal {
 
  public:
@@ -33,12 +40,29 @@ class Portal {
 
   Portal(const std::string& portal_name,
          std::shared_ptr<Statement> statement,
-         const std::vector<std::pair<int, std::string>>& bind_parameters);
+         const std::vector<std::pair<int, std::string>>& bind_parameters,
+         const std::vector<Value>& param_values,
+         const std::vector<int16_t>& result_formats);
 
   ~Portal();
 
   std::shared_ptr<Statement> GetStatement() const;
 
+  // Values bound to the parameters of the statement's plan
+  const std::vector<Value>& GetParamValues() const;
+
+  // Format code of every result column, 0 (text) or 1 (binary)
+  std::vector<int16_t> GetResultFormats(size_t column_count) const;
+
+  // Execution suspended after a row limit, nullptr if there is none
+  bridge::PlanCursor *GetCursor() const;
+
+  // Take ownership of the cursor, closing the previous one
+  void SetCursor(bridge::PlanCursor *cursor);
+
+  // Give up the cursor without closing it
+  std::unique_ptr<bridge::PlanCursor> ReleaseCursor();
+
  private:
 
   // Portal name
@@ -50,6 +74,17 @@ class Portal {
   // Group the parameter types and the parameters in this vector
   std::vector<std::pair<int, std::string>> bind_parameters;
 
+  // Parameter values of this portal, other portals of the statement have
+  // their own
+  std::vector<Value> param_values;
+
+  // Result format codes sent with BIND: none for all text, one shared by
+  // all the columns or one per column
+  std::vector<int16_t> result_formats;
+
+  // Open cursor of a suspended execution
+  std::unique_ptr<bridge::PlanCursor> cursor;
+
 };
 
 }  // namespace peloton
@@ -17,12 +17,17 @@
 #include <memory>
 
 #include "common/types.h"
+#include "common/value.h"
 
 namespace peloton {
 namespace planner {
 class AbstractPlan;
 }
 
+namespace bridge {
+class PlanCursor;
+}
+
 typedef std::pair<std::vector<unsigned char>, std::vector<unsigned char>>
     ResultType;
 
@@ -66,6 +71,16 @@ class Statement {
 
   const std::shared_ptr<planner::AbstractPlan>& GetPlanTree() const;
 
+  void SetParamValues(const std::vector<Value>& param_values);
+
+  const std::vector<Value>& GetParamValues() const;
+
+  // The executor tree of a previous execution, nullptr if there is none
+  std::unique_ptr<bridge::PlanCursor> TakeCursor();
+
+  // Keep the closed cursor of an execution to reopen it for the next one
+  void KeepCursor(std::unique_ptr<bridge::PlanCursor> cursor);
+
  private:
   // logical name of statement
   std::string statement_name;
@@ -84,6 +99,12 @@ class Statement {
 
   // cached plan tree
   std::shared_ptr<planner::AbstractPlan> plan_tree;
+
+  // values bound to the parameters of the plan tree
+  std::vector<Value> param_values;
+
+  // closed cursor over the plan tree, freed before it
+  std::unique_ptr<bridge::PlanCursor> idle_cursor;
 };
 
 }  // namespace peloton
@@ -175,6 +175,7 @@ extern int TEST_TUPLES_PER_TILEGROUP;
 enum PostgresValueType {
   POSTGRES_VALUE_TYPE_INVALID = -1,
   POSTGRES_VALUE_TYPE_BOOLEAN = 16,
+  POSTGRES_VALUE_TYPE_BYTEA = 17,
   POSTGRES_VALUE_TYPE_SMALLINT = 21,
   POSTGRES_VALUE_TYPE_INTEGER = 23,
   POSTGRES_VALUE_TYPE_BIGINT = 20,
@@ -511,10 +512,17 @@ enum PlanNodeType {
   PLAN_NODE_TYPE_DROP = 33,
   PLAN_NODE_TYPE_CREATE = 34,
 
+  // Bulk Load Nodes
+  PLAN_NODE_TYPE_IMPORT = 35,
+
+  // Statistics Nodes
+  PLAN_NODE_TYPE_ANALYZE = 36,
+
   // Communication Nodes
   PLAN_NODE_TYPE_SEND = 40,
   PLAN_NODE_TYPE_RECEIVE = 41,
   PLAN_NODE_TYPE_PRINT = 42,
+  PLAN_NODE_TYPE_EXCHANGE = 43,
 
   // Algebra Nodes
   PLAN_NODE_TYPE_AGGREGATE = 50,
@@ -567,7 +575,8 @@ enum StatementType {
   STATEMENT_TYPE_RENAME = 11,       // rename statement type
   STATEMENT_TYPE_ALTER = 12,        // alter statement type
   STATEMENT_TYPE_TRANSACTION = 13,  // transaction statement type,
-  STATEMENT_TYPE_IMPORT = 14        // import type
+  STATEMENT_TYPE_IMPORT = 14,       // import type
+  STATEMENT_TYPE_ANALYZE = 15       // analyze type
 };
 
 //===--------------------------------------------------------------------===//
@@ -4028,8 +4028,17 @@ inline Value Value::Like(const Value rhs) const {
              * This saves doing a function Call per character and allows us to
              *skip if there is no match.
              */
-            while (!m_value.AtEnd()) {
+            while (true) {
               const char *preExtractionValueIterator = m_value.GetCursor();
+
+              // An exhausted value still matches if only '%'s remain
+              if (m_value.AtEnd()) {
+                Liker recursionContext(*this, preExtractionValueIterator,
+                                       postPercentPatternIterator);
+                return nextPatternCodePointAfterPercent == '%' &&
+                       recursionContext.Like();
+              }
+
               const uint32_t nextValueCodePoint = m_value.ExtractCodePoint();
 
               const bool
@@ -4046,7 +4055,6 @@ inline Value Value::Like(const Value rhs) const {
                 }
               }
             }
-            return false;
           }
           case '_': {
             if (m_value.AtEnd()) {
@@ -140,6 +140,12 @@ class ValuePeeker {
     return value.CastAsBigIntAndGetValue();
   }
 
+  // cast as double and Peek at value. this is used by the wire protocol to
+  // send a numeric column in the binary format of its described type.
+  static inline double PeekAsDouble(const Value &value) {
+    return value.CastAsDoubleAndGetValue();
+  }
+
   /// Given an Value, return a pointer to its data bytes.  Also return
   /// The length of the data bytes via output parameter.
   ///
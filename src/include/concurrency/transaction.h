@@ -125,6 +125,9 @@ class Transaction : public Printable {
 
   std::map<oid_t, std::map<oid_t, RWType>> rw_set_;
 
+  // reads are recorded concurrently by the workers of a parallel scan
+  std::mutex rw_set_mutex_;
+
   // result of the transaction
   Result result_ = peloton::RESULT_SUCCESS;
 
@@ -154,6 +154,31 @@ class TransactionManager {
     return EpochManagerFactory::GetInstance().GetMaxDeadTxnCid();
   }
 
+  // Waits until the transactions running now have ended. It must not be
+  // called from within a transaction, that would never end.
+  void WaitForRunningTransactions() {
+    auto txn = BeginTransaction();
+    cid_t begin_cid = txn->GetBeginCommitId();
+    CommitTransaction(txn);
+
+    while (GetMaxCommittedCid() < begin_cid) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    }
+  }
+
+  // Waits until the transactions running now, but the current one, have
+  // ended. The current transaction leaves its epoch meanwhile, so the
+  // versions that end while it waits may be reclaimed under it.
+  void WaitForOtherTransactions(Transaction *const current_txn) {
+    auto &epoch_manager = EpochManagerFactory::GetInstance();
+    epoch_manager.ExitEpoch(current_txn->GetEpochId());
+
+    WaitForRunningTransactions();
+
+    current_txn->SetEpochId(
+        epoch_manager.EnterEpoch(current_txn->GetBeginCommitId()));
+  }
+
   void SetDirtyRange(std::pair<cid_t, cid_t> dirty_range) {
     this->dirty_range_ = dirty_range;
   }
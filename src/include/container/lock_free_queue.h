@@ -37,6 +37,12 @@ class LockFreeQueue {
     queue_.enqueue(item);
   }
 
+  // Enqueues one item only if there is space left, returning false if the
+  // queue appeared full
+  bool TryEnqueue(const T& item) {
+    return queue_.try_enqueue(item);
+  }
+
   // Dequeues one item, returning true if an item was found
   // or false if the queue appeared empty
   bool Dequeue(T& item) {
@@ -51,6 +57,10 @@ class LockFreeQueue {
     return queue_.size_approx() == 0;
   }
 
+  size_t GetSizeApprox() const {
+    return queue_.size_approx();
+  }
+
  private:
 
   // Underlying moodycamel's concurrent queue
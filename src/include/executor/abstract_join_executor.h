@@ -15,6 +15,7 @@
 
 #include "catalog/schema.h"
 #include "executor/abstract_executor.h"
+#include "expression/compiled_expression.h"
 #include "planner/project_info.h"
 
 #include <vector>
@@ -158,6 +159,8 @@ class AbstractJoinExecutor : public AbstractExecutor {
   bool BuildLeftJoinOutput();
   bool BuildRightJoinOutput();
 
+  bool BindCompiledPredicate(LogicalTile *left_tile, LogicalTile *right_tile);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -172,6 +175,11 @@ class AbstractJoinExecutor : public AbstractExecutor {
   /** @brief Join predicate. */
   const expression::AbstractExpression *predicate_ = nullptr;
 
+  /** @brief Join predicate compiled on the first pair of input tiles. */
+  std::unique_ptr<expression::CompiledExpression> compiled_predicate_;
+
+  bool predicate_compile_attempted_ = false;
+
   /** @brief Projection info */
   const planner::ProjectInfo *proj_info_ = nullptr;
 
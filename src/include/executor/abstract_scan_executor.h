@@ -16,6 +16,8 @@
 #include "planner/abstract_scan_plan.h"
 #include "common/types.h"
 #include "executor/abstract_executor.h"
+#include "expression/compiled_expression.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 namespace executor {
@@ -40,6 +42,17 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual bool DExecute() = 0;
 
+  // Whether the tile group's zone map rules out every tuple for the
+  // predicate; counts the skip in the executor context
+  bool SkipTileGroup(const storage::TileGroup *tile_group);
+
+  // Records a sample of the scan of the table for the tuners of the brain
+  // if the table samples it: the columns it reads for the layout tuner, the
+  // columns of its predicate and its selectivity for the index tuner
+  void RecordSample(storage::DataTable *table,
+                    const std::vector<oid_t> &key_column_ids,
+                    size_t tuples_read, size_t tuples_returned);
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -48,8 +61,23 @@ class AbstractScanExecutor : public AbstractExecutor {
   /** @brief Selection predicate. */
   const expression::AbstractExpression *predicate_ = nullptr;
 
+  /**
+   * @brief Selection predicate compiled for this execution, or nullptr if
+   * the predicate has to be interpreted.
+   */
+  std::unique_ptr<expression::CompiledExpression> compiled_predicate_;
+
+  /**
+   * @brief Range conjuncts of the predicate checked against zone maps, or
+   * nullptr if the predicate has none.
+   */
+  std::unique_ptr<storage::ZoneMapPredicate> zone_map_predicate_;
+
   /** @brief Columns from tile group to be added to logical tile output. */
   std::vector<oid_t> column_ids_;
+
+  /** @brief Whether the execution already recorded its sample. */
+  bool sample_recorded_ = false;
 };
 
 }  // namespace executor
@@ -315,6 +315,14 @@ class HashAggregator : public AbstractAggregator {
 
   /** @brief Hash table */
   HashAggregateMapType aggregates_map;
+
+  /**
+   * @brief Groups indexed by dictionary code, for a single dictionary
+   * encoded group-by column. Rows of encoded tiles find their group without
+   * building or hashing a key.
+   */
+  const storage::Dictionary *code_dictionary = nullptr;
+  std::vector<AggregateList *> code_groups;
 };
 
 /**
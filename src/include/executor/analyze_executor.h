@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.h
+//
+// Identification: src/include/executor/analyze_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_executor.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Computes the statistics of the tables of an analyze plan with the tuples
+ * visible to the transaction. Produces no tiles.
+ */
+class AnalyzeExecutor : public AbstractExecutor {
+ public:
+  AnalyzeExecutor(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor &operator=(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor(AnalyzeExecutor &&) = delete;
+  AnalyzeExecutor &operator=(AnalyzeExecutor &&) = delete;
+
+  explicit AnalyzeExecutor(const planner::AbstractPlan *node,
+                           ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.h
+//
+// Identification: src/include/executor/exchange_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_executor.h"
+#include "executor/executor_context.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Gathers the tiles of the workers running the child of an exchange plan.
+ *
+ * Every worker owns an executor tree of the child and a context of its own
+ * bound to the transaction and parameters of the query. The workers push
+ * their tiles into a bounded queue the executor pops from, and the scans at
+ * the bottom of their trees claim tile groups from a shared cursor.
+ */
+class ExchangeExecutor : public AbstractExecutor {
+ public:
+  ExchangeExecutor(const ExchangeExecutor &) = delete;
+  ExchangeExecutor &operator=(const ExchangeExecutor &) = delete;
+  ExchangeExecutor(ExchangeExecutor &&) = delete;
+  ExchangeExecutor &operator=(ExchangeExecutor &&) = delete;
+
+  explicit ExchangeExecutor(const planner::AbstractPlan *node,
+                            ExecutorContext *executor_context);
+
+  // Stops the workers that are still running
+  ~ExchangeExecutor();
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  // A thread running its own executor tree of the child plan
+  struct Worker {
+    std::unique_ptr<ExecutorContext> executor_context;
+
+    std::unique_ptr<AbstractExecutor> executor_tree;
+
+    std::thread thread;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Helper
+  //===--------------------------------------------------------------------===//
+
+  void RunWorker(Worker *worker);
+
+  void JoinWorkers();
+
+  void StopWorkers();
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  /** @brief Offset of the next tile group the workers scan */
+  std::atomic<oid_t> morsel_cursor_;
+
+  bool started_ = false;
+
+  /** @brief Guards the queue and the state of the workers below */
+  std::mutex queue_mutex_;
+
+  std::condition_variable queue_not_empty_;
+
+  std::condition_variable queue_not_full_;
+
+  std::deque<std::unique_ptr<LogicalTile>> queue_;
+
+  size_t running_workers_ = 0;
+
+  /** @brief Set when a worker failed or the executor is torn down */
+  bool stopping_ = false;
+
+  /** @brief Exception a worker failed with, rethrown by the executor */
+  std::exception_ptr worker_exception_;
+};
+
+}  // namespace executor
+}  // namespace peloton
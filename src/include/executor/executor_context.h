@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include "common/pool.h"
+#include "common/types.h"
 
 namespace peloton {
 
@@ -51,12 +55,34 @@ class ExecutorContext {
 
   void ClearParams();
 
-  // Get a varlen pool (will construct the pool only if needed)
+  // Cast the parameters to the given types, VALUE_TYPE_INVALID leaves a
+  // parameter as it is. Untyped parameters arrive as VARCHAR values.
+  void CastParams(const std::vector<ValueType> &param_types);
+
+  // Rebind the context to another execution of the same executor tree,
+  // freeing the varlen pool of the previous one
+  void Reset(concurrency::Transaction *transaction,
+             const std::vector<Value> &params);
+
+  // Get a varlen pool (will construct the pool only if needed). It lives
+  // until the next Reset, values kept across executions need a pool of
+  // their own.
   VarlenPool *GetExecutorContextPool();
 
+  // Offset of the next tile group to scan, shared by the contexts of the
+  // workers of an exchange. Null unless the scan runs in parallel.
+  std::atomic<oid_t> *GetMorselCursor() const { return morsel_cursor_; }
+
+  void SetMorselCursor(std::atomic<oid_t> *morsel_cursor) {
+    morsel_cursor_ = morsel_cursor;
+  }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
+  // num of tile groups scans skipped using their zone maps
+  uint32_t num_tile_groups_skipped = 0;
+
  private:
   //===--------------------------------------------------------------------===//
   // MEMBERS
@@ -71,6 +97,9 @@ class ExecutorContext {
   // pool
   std::unique_ptr<VarlenPool> pool_;
 
+  // tile group cursor of a parallel scan
+  std::atomic<oid_t> *morsel_cursor_ = nullptr;
+
 };
 
 }  // namespace executor
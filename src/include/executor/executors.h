@@ -26,10 +26,14 @@
 #include "executor/delete_executor.h"
 #include "executor/update_executor.h"
 #include "executor/nested_loop_join_executor.h"
+#include "executor/nested_loop_index_join_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/hash_join_executor.h"
 #include "executor/hash_executor.h"
 #include "executor/order_by_executor.h"
 #include "executor/hash_set_op_executor.h"
+#include "executor/import_executor.h"
+#include "executor/analyze_executor.h"
+#include "executor/exchange_executor.h"
 #include "executor/append_executor.h"
 #include "executor/projection_executor.h"
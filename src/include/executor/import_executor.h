@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_executor.h
+//
+// Identification: src/include/executor/import_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_executor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace executor {
+
+/**
+ * Bulk load of a table from delimited text, either CSV or the tab separated
+ * text format of COPY.
+ *
+ * The input is split into chunks at row boundaries which are parsed in
+ * parallel, each chunk straight into tile groups of its own. The filled
+ * tile groups are then appended to the table as a whole, their tuples
+ * inserted by the transaction, and each index is built by a thread of its
+ * own once all the tuples are in.
+ */
+class ImportExecutor : public AbstractExecutor {
+ public:
+  ImportExecutor(const ImportExecutor &) = delete;
+  ImportExecutor &operator=(const ImportExecutor &) = delete;
+  ImportExecutor(ImportExecutor &&) = delete;
+  ImportExecutor &operator=(ImportExecutor &&) = delete;
+
+  explicit ImportExecutor(const planner::AbstractPlan *node,
+                          ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  // A part of the input holding whole rows
+  struct Chunk {
+    const char *begin;
+    const char *end;
+
+    // the tile groups the rows were parsed into
+    std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+
+    // why the chunk could not be parsed, empty on success
+    std::string error;
+  };
+
+  bool Import(const char *data, size_t size);
+
+  void ParseChunk(Chunk *chunk);
+
+  bool BuildIndexes(const std::vector<ItemPointer *> &index_entries);
+
+  bool done_ = false;
+
+  storage::DataTable *target_table_ = nullptr;
+
+  bool csv_ = true;
+};
+
+}  // namespace executor
+}  // namespace peloton
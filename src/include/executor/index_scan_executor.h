@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
+#include "index/scan_optimizer.h"
 #include "planner/index_scan_plan.h"
 
 namespace peloton {
@@ -45,8 +46,16 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   // Helper
   //===--------------------------------------------------------------------===//
-  bool ExecPrimaryIndexLookup();
-  bool ExecSecondaryIndexLookup();
+  void ScanIndex(std::vector<ItemPointer *> &tuple_location_ptrs,
+                 std::vector<Value> *keys);
+
+  bool ExecIndexOnlyLookup(std::vector<ItemPointer *> &tuple_location_ptrs);
+  bool ExecPrimaryIndexLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs);
+  bool ExecSecondaryIndexLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs);
+
+  const index::ConjunctionScanPredicate *GetScanPredicate();
 
   //===--------------------------------------------------------------------===//
   // Executor State
@@ -88,6 +97,29 @@ class IndexScanExecutor : public AbstractScanExecutor {
   std::vector<expression::AbstractExpression *> runtime_keys_;
 
   bool key_ready_ = false;
+
+  /** @brief Whether the columns are read from the index entries */
+  bool index_only_ = false;
+
+  /** @brief Whether the matches are looked up in the order of location */
+  bool bitmap_scan_ = false;
+
+  ScanDirectionType scan_direction_ = SCAN_DIRECTION_TYPE_FORWARD;
+
+  /** @brief Rows the scan returns at least, 0 for all of them */
+  size_t limit_ = 0;
+
+  /** @brief Entries the index is probed for, 0 for all of them */
+  size_t scan_limit_ = 0;
+
+  /** @brief Whether the last probe returned all the matching entries */
+  bool scanned_all_ = true;
+
+  /** @brief Parameters of the execution bound into index_predicate_ */
+  bool bind_params_ = false;
+
+  /** @brief Scan predicate bound to the parameters of the execution */
+  index::IndexScanPredicate index_predicate_;
 };
 
 }  // namespace executor
@@ -13,8 +13,11 @@
 
 #pragma once
 
+#include "common/pool.h"
 #include "executor/abstract_executor.h"
+#include "storage/tuple.h"
 
+#include <memory>
 #include <vector>
 
 namespace peloton {
@@ -37,6 +40,12 @@ class InsertExecutor : public AbstractExecutor {
 
  private:
   bool done_ = false;
+
+  // Varlen constants of the bound tuple, kept across executions
+  std::unique_ptr<VarlenPool> bound_tuple_pool_;
+
+  // The plan's tuple bound to the parameters of the execution
+  std::unique_ptr<storage::Tuple> bound_tuple_;
 };
 
 }  // namespace executor
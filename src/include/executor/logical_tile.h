@@ -21,6 +21,7 @@
 #include "common/printable.h"
 #include "common/types.h"
 #include "common/macros.h"
+#include "storage/dictionary.h"
 
 namespace peloton {
 
@@ -86,6 +87,10 @@ class LogicalTile : public Printable {
 
   void SetValue(Value &value, oid_t tuple_id, oid_t column_id);
 
+  bool GetDictionaryCode(oid_t tuple_id, oid_t column_id,
+                         const storage::Dictionary **dictionary,
+                         storage::Dictionary::Code *code);
+
   size_t GetTupleCount();
 
   size_t GetColumnCount();
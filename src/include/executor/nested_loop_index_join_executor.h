@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_index_join_executor.h
+//
+// Identification: src/include/executor/nested_loop_index_join_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_join_executor.h"
+#include "index/scan_optimizer.h"
+
+#include <memory>
+#include <vector>
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace executor {
+
+/**
+ * Joins every tile of its only child with the inner table by probing the
+ * inner index once per outer tuple. The keys of the probe are bound into a
+ * conjunction scan predicate built once per execution, and the versions the
+ * index points to are resolved the way the index scan does.
+ */
+class NestedLoopIndexJoinExecutor : public AbstractJoinExecutor {
+  NestedLoopIndexJoinExecutor(const NestedLoopIndexJoinExecutor &) = delete;
+  NestedLoopIndexJoinExecutor &operator=(const NestedLoopIndexJoinExecutor &) =
+      delete;
+
+ public:
+  explicit NestedLoopIndexJoinExecutor(const planner::AbstractPlan *node,
+                                       ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Helper
+  //===--------------------------------------------------------------------===//
+
+  bool JoinOuterTile(LogicalTile *outer_tile);
+
+  bool BindOuterKeys(LogicalTile *outer_tile, oid_t outer_row);
+
+  bool GetVisibleVersion(ItemPointer &tuple_location,
+                         std::shared_ptr<storage::TileGroup> &tile_group);
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  /** @brief Join tiles of the current outer tile */
+  std::vector<std::unique_ptr<LogicalTile>> result_;
+
+  size_t result_itr_ = 0;
+
+  /** @brief Keys of the probe, the outer ones rebound for every tuple */
+  std::vector<Value> key_values_;
+
+  /** @brief Index predicate the keys are bound to */
+  std::unique_ptr<index::ConjunctionScanPredicate> probe_predicate_;
+
+  //===--------------------------------------------------------------------===//
+  // Plan Info
+  //===--------------------------------------------------------------------===//
+
+  std::shared_ptr<index::Index> index_;
+
+  storage::DataTable *inner_table_ = nullptr;
+
+  std::vector<oid_t> inner_column_ids_;
+
+  std::vector<oid_t> key_column_ids_;
+
+  std::vector<ExpressionType> expr_types_;
+
+  std::vector<oid_t> outer_column_ids_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -13,9 +13,12 @@
 
 #pragma once
 
+#include "common/serializer.h"
 #include "common/types.h"
 #include "common/statement.h"
 #include "executor/abstract_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
 
 namespace peloton {
 namespace bridge {
@@ -80,10 +83,12 @@ class PlanExecutor {
    *        Before ExecutePlan, a node first receives value list, so we should
    * pass
    *        value list directly rather than passing Postgres's ParamListInfo
+   *        Runs in a transaction of its own unless txn is given
    */
   static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
                                     const std::vector<Value> &params,
-									std::vector<ResultType> &result);
+                                    std::vector<ResultType> &result,
+                                    concurrency::Transaction *txn = nullptr);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
@@ -95,5 +100,93 @@ class PlanExecutor {
       std::vector<std::unique_ptr<executor::LogicalTile>> &logical_tile_list);
 };
 
+/*
+ * @brief Build the executor tree of a plan below root, which is nullptr when
+ * the plan is the root of the tree
+ * @return The root of the executor tree
+ */
+executor::AbstractExecutor *BuildExecutorTree(
+    executor::AbstractExecutor *root, const planner::AbstractPlan *plan,
+    executor::ExecutorContext *executor_context);
+
+/*
+ * @brief Release the executors below root, root is left to the caller
+ */
+void CleanExecutorTree(executor::AbstractExecutor *root);
+
+/**
+ * Runs a plan one logical tile at a time, so its rows can be consumed (e.g.
+ * streamed to a client) while it executes instead of after it finished.
+ * Owns the statement's transaction and executor tree until it is closed,
+ * unless it runs within a transaction of the caller.
+ *
+ * Once closed, the executor tree of a reusable plan is kept and can be
+ * reopened for another execution with other parameters, which saves
+ * rebuilding it for every execution of a prepared statement.
+ */
+class PlanCursor {
+ public:
+  PlanCursor(const PlanCursor &) = delete;
+  PlanCursor &operator=(const PlanCursor &) = delete;
+  PlanCursor(PlanCursor &&) = delete;
+  PlanCursor &operator=(PlanCursor &&) = delete;
+
+  // Runs in its own transaction if txn is nullptr
+  PlanCursor(const planner::AbstractPlan *plan,
+             const std::vector<Value> &params,
+             concurrency::Transaction *txn = nullptr);
+
+  // Closes the cursor if it is still open
+  ~PlanCursor();
+
+  // Whether the executor tree survives Close()
+  bool IsReusable() const { return reusable_; }
+
+  // Execute the plan again on the executor tree of a closed cursor, false if
+  // the tree is not reusable
+  bool Reopen(const std::vector<Value> &params,
+              concurrency::Transaction *txn = nullptr);
+
+  // Move to the next row, false once the plan is exhausted
+  bool Next();
+
+  // The current row is GetTupleId() of GetTile()
+  executor::LogicalTile *GetTile() const { return tile_.get(); }
+
+  oid_t GetTupleId() const { return **tuple_itr_; }
+
+  // Commit the transaction (abort it if execution failed) and release the
+  // executor tree. A transaction of the caller is left to the caller, only
+  // its result is reported. Idempotent.
+  peloton_status Close();
+
+ private:
+  void BeginTransaction(concurrency::Transaction *txn);
+
+  void InitExecutorTree();
+
+  std::unique_ptr<executor::ExecutorContext> executor_context_;
+
+  std::unique_ptr<executor::AbstractExecutor> executor_tree_;
+
+  concurrency::Transaction *txn_ = nullptr;
+
+  // whether the cursor began txn_ and has to end it
+  bool owns_txn_ = true;
+
+  // tile holding the current row and the position within it
+  std::unique_ptr<executor::LogicalTile> tile_;
+  std::unique_ptr<executor::LogicalTile::iterator> tuple_itr_;
+
+  bool exhausted_ = false;
+
+  bool closed_ = false;
+
+  // whether every executor of the tree can be initialized again
+  bool reusable_ = false;
+
+  peloton_status status_;
+};
+
 }  // namespace bridge
 }  // namespace peloton
@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "executor/abstract_executor.h"
+#include "expression/compiled_expression.h"
 #include "planner/project_info.h"
 
 namespace peloton {
@@ -35,6 +39,11 @@ class ProjectionExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
+  void CompileTargetList(LogicalTile *source_tile);
+
+  void EvaluateCompiled(storage::Tuple *dest, LogicalTile *source_tile,
+                        oid_t tuple_id);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -44,6 +53,20 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** @brief Schema of projected tuples. */
   const catalog::Schema *schema_ = nullptr;
+
+  /** @brief Compiled target list entries, nullptr where the expression
+   * has to be interpreted. Compiled on the first input tile of each
+   * execution. */
+  std::vector<std::unique_ptr<expression::CompiledExpression>>
+      compiled_targets_;
+
+  /** @brief Which compiled targets are bound to the current input tile. */
+  std::vector<bool> bound_targets_;
+
+  bool target_list_compiled_ = false;
+
+  /** @brief Whether any target list entry is compiled at all. */
+  bool has_compiled_targets_ = false;
 };
 
 } /* namespace executor */
@@ -35,6 +35,12 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  //===--------------------------------------------------------------------===//
+  // Helper
+  //===--------------------------------------------------------------------===//
+
+  oid_t NextTileGroupOffset();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -45,6 +51,14 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Whether we already tried to compile the predicate for the
+   * child's logical tiles. */
+  bool predicate_compile_attempted_ = false;
+
+  /** @brief Tuples the scan read and returned so far, for its sample. */
+  size_t tuples_read_ = 0;
+  size_t tuples_returned_ = 0;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
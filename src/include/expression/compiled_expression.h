@@ -0,0 +1,312 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.h
+//
+// Identification: src/include/expression/compiled_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+#include "expression/like_pattern.h"
+#include "storage/dictionary.h"
+
+namespace peloton {
+
+namespace storage {
+class Tile;
+class TileGroup;
+}
+
+namespace executor {
+class ExecutorContext;
+class LogicalTile;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===----------------------------------------------------------------------===//
+// CompiledExpression
+//
+// A flat, register-based program compiled from an expression tree.
+//
+// The interpreter walks the tree with one virtual Evaluate() per node and
+// boxes every intermediate result into a Value. A compiled program instead
+// runs a linear sequence of typed instructions over int64/double/string
+// registers and loads column data straight from tile storage, so a predicate
+// such as "a < 24 AND b >= 0.05" costs a handful of switch dispatches and no
+// Value construction per tuple.
+//
+// Unlike the expression tree, a program carries per-execution state (bound
+// columns, parameter values and registers) and must be owned by a single
+// executor. Compile() returns nullptr for trees with nodes the program does
+// not handle; callers then keep using AbstractExpression::Evaluate().
+//===----------------------------------------------------------------------===//
+
+class CompiledExpression {
+ public:
+  CompiledExpression(const CompiledExpression &) = delete;
+  CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+  /**
+   * @brief Compile an expression tree.
+   * @param expr Expression to compile.
+   * @param left_types Column types of the first input (tuple1).
+   * @param right_types Column types of the second input (tuple2), if any.
+   * @param context Executor context supplying parameter values, may be null.
+   * @return The program, or nullptr if the tree cannot be compiled.
+   */
+  static std::unique_ptr<CompiledExpression> Compile(
+      const AbstractExpression *expr, const std::vector<ValueType> &left_types,
+      const std::vector<ValueType> &right_types,
+      executor::ExecutorContext *context);
+
+  // Column types as seen by ContainerTuple over the given container
+  static std::vector<ValueType> GetColumnTypes(storage::TileGroup *tile_group);
+
+  static std::vector<ValueType> GetColumnTypes(executor::LogicalTile *tile);
+
+  //===--------------------------------------------------------------------===//
+  // Binding
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * @brief Point the column loads of one input at a container.
+   * @param input_idx 0 for tuple1, 1 for tuple2.
+   * @return false if the container's layout doesn't match the types the
+   * program was compiled for; the caller must then fall back to the
+   * interpreter for this container.
+   */
+  bool Bind(oid_t input_idx, storage::TileGroup *tile_group);
+
+  bool Bind(oid_t input_idx, executor::LogicalTile *tile);
+
+  //===--------------------------------------------------------------------===//
+  // Evaluation
+  //===--------------------------------------------------------------------===//
+
+  // Is the result a non-null TRUE (Value::IsTrue() semantics)
+  inline bool EvaluatesTrue(oid_t tuple1, oid_t tuple2 = INVALID_OID) {
+    const Register &result = Run(tuple1, tuple2);
+    return !result.is_null && result.i != 0;
+  }
+
+  // Is the result a non-null FALSE (Value::IsFalse() semantics)
+  inline bool EvaluatesFalse(oid_t tuple1, oid_t tuple2 = INVALID_OID) {
+    const Register &result = Run(tuple1, tuple2);
+    return !result.is_null && result.i == 0;
+  }
+
+  // Box the result into a Value of GetValueType()
+  Value EvaluateValue(oid_t tuple1, oid_t tuple2 = INVALID_OID);
+
+  // Result type, identical to what the interpreter would produce
+  ValueType GetValueType() const { return result_type_; }
+
+  size_t GetInstructionCount() const { return program_.size(); }
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Program representation
+  //===--------------------------------------------------------------------===//
+
+  enum OpCode : uint8_t {
+    // loads from a bound column slot
+    OP_LOAD_TINYINT,
+    OP_LOAD_SMALLINT,
+    OP_LOAD_INTEGER,
+    OP_LOAD_BIGINT,
+    OP_LOAD_DOUBLE,
+    OP_LOAD_VARCHAR,
+
+    // varchar column (slot a) =/<> constant register b, fused with the load
+    // so dictionary encoded tiles compare codes; target is the probe index
+    OP_EQ_DICT,
+    OP_NE_DICT,
+
+    OP_INT_TO_DOUBLE,
+
+    // comparisons, result is a boolean register
+    OP_EQ_INT,
+    OP_NE_INT,
+    OP_LT_INT,
+    OP_GT_INT,
+    OP_LE_INT,
+    OP_GE_INT,
+    OP_EQ_DOUBLE,
+    OP_NE_DOUBLE,
+    OP_LT_DOUBLE,
+    OP_GT_DOUBLE,
+    OP_LE_DOUBLE,
+    OP_GE_DOUBLE,
+    OP_EQ_VARCHAR,
+    OP_NE_VARCHAR,
+    OP_LT_VARCHAR,
+    OP_GT_VARCHAR,
+    OP_LE_VARCHAR,
+    OP_GE_VARCHAR,
+
+    // arithmetic
+    OP_ADD_INT,
+    OP_SUB_INT,
+    OP_MUL_INT,
+    OP_ADD_DOUBLE,
+    OP_SUB_DOUBLE,
+    OP_MUL_DOUBLE,
+
+    // three-valued logic
+    OP_AND,
+    OP_OR,
+    OP_NOT,
+    OP_IS_NULL,
+
+    // string kernels; LIKE takes its precompiled pattern from target and
+    // SUBSTRING its optional length register
+    OP_LIKE,
+    OP_NOT_LIKE,
+    OP_CHAR_LENGTH,
+    OP_OCTET_LENGTH,
+    OP_SUBSTRING,
+
+    // short circuits: dst = a and jump to target if a is FALSE (resp. TRUE)
+    OP_JUMP_IF_FALSE,
+    OP_JUMP_IF_TRUE
+  };
+
+  struct Instruction {
+    OpCode op;
+    oid_t dst;
+    // source registers, or the column slot for loads
+    oid_t a;
+    oid_t b;
+    // jump target or extra operand
+    oid_t target;
+  };
+
+  // A typed register. Booleans use i.
+  struct Register {
+    union {
+      int64_t i;
+      double d;
+    };
+    const char *str;
+    int32_t len;
+    bool is_null;
+  };
+
+  // Where a column load reads from once bound
+  struct ColumnSlot {
+    oid_t input_idx;
+    oid_t column_id;
+    ValueType type;
+
+    // bound state
+    const char *base = nullptr;
+    size_t stride = 0;
+    bool is_inlined = true;
+    const oid_t *positions = nullptr;
+
+    // codes of a dictionary encoded column, nullptr otherwise
+    const storage::Dictionary::Code *codes = nullptr;
+    const storage::Dictionary *dictionary = nullptr;
+
+    // fields of a frozen tile's column, decoded when bound
+    std::vector<char> decoded;
+  };
+
+  // The code of an OP_EQ_DICT/OP_NE_DICT constant in its slot's dictionary,
+  // looked up when the slot is bound
+  struct DictionaryProbe {
+    oid_t slot;
+    oid_t constant;
+
+    // bound state
+    storage::Dictionary::Code code = storage::Dictionary::NULL_CODE;
+    bool found = false;
+  };
+
+  enum RegisterKind { KIND_INT, KIND_DOUBLE, KIND_VARCHAR, KIND_BOOLEAN };
+
+  CompiledExpression() {}
+
+  // Returns the register holding the node's result or INVALID_OID
+  oid_t CompileNode(const AbstractExpression *expr);
+
+  oid_t CompileComparison(const AbstractExpression *expr);
+
+  oid_t CompileDictionaryComparison(const AbstractExpression *expr, oid_t left,
+                                    oid_t right);
+
+  oid_t CompileArithmetic(const AbstractExpression *expr);
+
+  oid_t CompileConjunction(const AbstractExpression *expr);
+
+  oid_t CompileLike(const AbstractExpression *expr);
+
+  oid_t CompileStringFunction(const AbstractExpression *expr);
+
+  oid_t CompileColumn(const AbstractExpression *expr);
+
+  oid_t CompileConstant(const Value &value);
+
+  oid_t CoerceToDouble(oid_t reg);
+
+  oid_t NewRegister(RegisterKind kind, ValueType type);
+
+  void Emit(OpCode op, oid_t dst, oid_t a, oid_t b = INVALID_OID);
+
+  void BindColumn(ColumnSlot &slot, storage::Tile *tile, oid_t column_id);
+
+  void BindDictionaryProbes(oid_t input_idx);
+
+  const Register &Run(oid_t tuple1, oid_t tuple2);
+
+  //===--------------------------------------------------------------------===//
+  // Members
+  //===--------------------------------------------------------------------===//
+
+  std::vector<Instruction> program_;
+
+  std::vector<Register> registers_;
+
+  // static kind and SQL type of each register
+  std::vector<RegisterKind> register_kinds_;
+  std::vector<ValueType> register_types_;
+
+  std::vector<ColumnSlot> slots_;
+
+  std::vector<DictionaryProbe> probes_;
+
+  // column types of both inputs at compile time
+  std::vector<ValueType> input_types_[2];
+
+  executor::ExecutorContext *context_ = nullptr;
+
+  // keeps constant and parameter strings referenced by registers alive
+  std::vector<Value> pinned_values_;
+
+  // LIKE patterns, parsed at compile time
+  std::vector<LikePattern> patterns_;
+
+  oid_t result_register_ = INVALID_OID;
+
+  ValueType result_type_ = VALUE_TYPE_INVALID;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
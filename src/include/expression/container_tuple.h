@@ -74,19 +74,27 @@ class ContainerTuple : public AbstractTuple {
     return nullptr;
   }
 
+  /** @brief Get the dictionary code of the value at the given column id. */
+  bool GetDictionaryCode(oid_t column_id,
+                         const storage::Dictionary **dictionary,
+                         storage::Dictionary::Code *code) const override {
+    PL_ASSERT(container_ != nullptr);
+
+    return container_->GetDictionaryCode(tuple_id_, column_id, dictionary,
+                                         code);
+  }
+
   /** @brief Compute the hash value based on all valid columns and a given seed.
    */
   size_t HashCode(size_t seed = 0) const {
     if (column_ids_) {
       for (auto &column_itr : *column_ids_) {
-        const Value value = GetValue(column_itr);
-        value.HashCombine(seed);
+        HashColumn(column_itr, seed);
       }
     } else {
       oid_t column_count = container_->GetColumnCount();
       for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
-        const Value value = GetValue(column_itr);
-        value.HashCombine(seed);
+        HashColumn(column_itr, seed);
       }
     }
     return seed;
@@ -98,18 +106,14 @@ class ContainerTuple : public AbstractTuple {
   bool EqualsNoSchemaCheck(const ContainerTuple<T> &other) const {
     if (column_ids_) {
       for (auto &column_itr : *column_ids_) {
-        const Value lhs = GetValue(column_itr);
-        const Value rhs = other.GetValue(column_itr);
-        if (lhs.OpNotEquals(rhs).IsTrue()) {
+        if (ColumnEquals(column_itr, other) == false) {
           return false;
         }
       }
     } else {
       oid_t column_count = container_->GetColumnCount();
       for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
-        const Value lhs = GetValue(column_itr);
-        const Value rhs = other.GetValue(column_itr);
-        if (lhs.OpNotEquals(rhs).IsTrue()) {
+        if (ColumnEquals(column_itr, other) == false) {
           return false;
         }
       }
@@ -146,6 +150,39 @@ class ContainerTuple : public AbstractTuple {
   }
 
  private:
+  // Hash one column. Dictionary encoded columns use the entry's precomputed
+  // hash, combined the same way Value::HashCombine() does.
+  inline void HashColumn(oid_t column_id, size_t &seed) const {
+    const storage::Dictionary *dictionary;
+    storage::Dictionary::Code code;
+    if (GetDictionaryCode(column_id, &dictionary, &code)) {
+      size_t hash = (code == storage::Dictionary::NULL_CODE)
+                        ? storage::Dictionary::GetNullHash()
+                        : dictionary->GetHash(code);
+      seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return;
+    }
+    GetValue(column_id).HashCombine(seed);
+  }
+
+  // Compare one column. Values coded by the same dictionary are equal iff
+  // their codes are, which also makes NULL equal only to NULL like
+  // Value::Compare().
+  inline bool ColumnEquals(oid_t column_id,
+                           const ContainerTuple<T> &other) const {
+    const storage::Dictionary *lhs_dictionary, *rhs_dictionary;
+    storage::Dictionary::Code lhs_code, rhs_code;
+    if (GetDictionaryCode(column_id, &lhs_dictionary, &lhs_code) &&
+        other.GetDictionaryCode(column_id, &rhs_dictionary, &rhs_code) &&
+        lhs_dictionary == rhs_dictionary) {
+      return lhs_code == rhs_code;
+    }
+
+    const Value lhs = GetValue(column_id);
+    const Value rhs = other.GetValue(column_id);
+    return lhs.OpNotEquals(rhs).IsTrue() == false;
+  }
+
   /** @brief Underlying container behind this tuple interface. */
   T *container_;
 
@@ -94,6 +94,12 @@ class ExpressionUtil {
 		  std::vector<Value>* values,
 		  catalog::Schema* schema);
 
+  // Sets the type of each parameter of the expression to the type of the
+  // column or value it is compared to or combined with. The others are left
+  // as they are, VALUE_TYPE_INVALID unless set before.
+  static void GetParameterTypes(const AbstractExpression *expr,
+                                std::vector<ValueType> &param_types);
+
 };
 
 }  // End expression namespace
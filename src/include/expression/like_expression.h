@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_expression.h
+//
+// Identification: src/include/expression/like_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "common/value_peeker.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/like_pattern.h"
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// [NOT] LIKE against a constant pattern. The pattern is compiled once when
+// the expression is built rather than re-parsed by Value::Like() per tuple.
+//===----------------------------------------------------------------------===//
+
+class LikeExpression : public AbstractExpression {
+ public:
+  LikeExpression(ExpressionType type, AbstractExpression *left,
+                 ConstantValueExpression *right)
+      : AbstractExpression(type, VALUE_TYPE_BOOLEAN, left, right),
+        pattern_(reinterpret_cast<const char *>(
+                     ValuePeeker::PeekObjectValueWithoutNull(right->getValue())),
+                 ValuePeeker::PeekObjectLengthWithoutNull(right->getValue())),
+        negated_(type == EXPRESSION_TYPE_COMPARE_NOTLIKE) {}
+
+  Value Evaluate(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                 executor::ExecutorContext *context) const override {
+    PL_ASSERT(m_left != nullptr);
+
+    Value lnv = m_left->Evaluate(tuple1, tuple2, context);
+    if (lnv.IsNull()) {
+      return Value::GetNullValue(VALUE_TYPE_BOOLEAN);
+    }
+    if (lnv.GetValueType() != VALUE_TYPE_VARCHAR) {
+      throw Exception("lhs of LIKE expression is " +
+                      ValueTypeToString(lnv.GetValueType()) + " not " +
+                      ValueTypeToString(VALUE_TYPE_VARCHAR));
+    }
+
+    bool match = pattern_.Match(
+        reinterpret_cast<const char *>(
+            ValuePeeker::PeekObjectValueWithoutNull(lnv)),
+        ValuePeeker::PeekObjectLengthWithoutNull(lnv));
+    return (match != negated_) ? Value::GetTrue() : Value::GetFalse();
+  }
+
+  const LikePattern &GetPattern() const { return pattern_; }
+
+  std::string DebugInfo(const std::string &spacer) const override {
+    return (spacer + "LikeExpression '" + pattern_.GetPattern() + "'\n");
+  }
+
+  AbstractExpression *Copy() const override {
+    return new LikeExpression(
+        m_type, CopyUtil(m_left),
+        static_cast<ConstantValueExpression *>(CopyUtil(m_right)));
+  }
+
+ private:
+  LikePattern pattern_;
+
+  bool negated_;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
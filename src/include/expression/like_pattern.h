@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_pattern.h
+//
+// Identification: src/include/expression/like_pattern.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// LikePattern
+//
+// A LIKE pattern parsed once, up front, instead of on every Value::Like()
+// call. Common shapes get dedicated matchers:
+//
+//   'abc'      exact      length check + memcmp
+//   'abc%'     prefix     memcmp on the head
+//   '%abc'     suffix     memcmp on the tail
+//   '%abc%'    contains   memchr / memmem
+//   '%'        any        always true
+//
+// Everything else is split on '%' into segments that are matched greedily
+// left to right; '_' consumes one UTF-8 code point like Value::Like does.
+//===----------------------------------------------------------------------===//
+
+class LikePattern {
+ public:
+  enum MatchKind {
+    LIKE_MATCH_EXACT,
+    LIKE_MATCH_PREFIX,
+    LIKE_MATCH_SUFFIX,
+    LIKE_MATCH_CONTAINS,
+    LIKE_MATCH_ANY,
+    LIKE_MATCH_GENERAL
+  };
+
+  LikePattern(const char *pattern, int32_t length);
+
+  explicit LikePattern(const std::string &pattern)
+      : LikePattern(pattern.data(), static_cast<int32_t>(pattern.size())) {}
+
+  // Does the UTF-8 string [value, value + length) match the pattern
+  inline bool Match(const char *value, int32_t length) const {
+    switch (kind_) {
+      case LIKE_MATCH_EXACT:
+        return length == literal_length_ &&
+               ::memcmp(value, literal_.data(), literal_length_) == 0;
+      case LIKE_MATCH_PREFIX:
+        return length >= literal_length_ &&
+               ::memcmp(value, literal_.data(), literal_length_) == 0;
+      case LIKE_MATCH_SUFFIX:
+        return length >= literal_length_ &&
+               ::memcmp(value + length - literal_length_, literal_.data(),
+                        literal_length_) == 0;
+      case LIKE_MATCH_CONTAINS:
+        return Contains(value, length);
+      case LIKE_MATCH_ANY:
+        return true;
+      default:
+        return MatchGeneral(value, length);
+    }
+  }
+
+  MatchKind GetKind() const { return kind_; }
+
+  const std::string &GetPattern() const { return pattern_; }
+
+ private:
+  // A run of pattern characters between two '%'
+  struct Segment {
+    std::string chars;
+    // does chars contain '_'
+    bool has_wildcard;
+    // length in code points, '_' counting as one
+    int32_t code_points;
+  };
+
+  bool Contains(const char *value, int32_t length) const;
+
+  bool MatchGeneral(const char *value, int32_t length) const;
+
+  // Match a segment starting exactly at begin; on success set *match_end
+  static bool MatchSegmentAt(const Segment &segment, const char *begin,
+                             const char *end, const char **match_end);
+
+  // Leftmost match of a segment in [begin, end)
+  static bool FindSegment(const Segment &segment, const char *begin,
+                          const char *end, const char **match_end);
+
+  std::string pattern_;
+
+  MatchKind kind_;
+
+  // the literal of the exact/prefix/suffix/contains fast paths
+  std::string literal_;
+  int32_t literal_length_ = 0;
+
+  std::vector<Segment> segments_;
+
+  // does the pattern start (end) with '%'
+  bool leading_percent_ = false;
+  bool trailing_percent_ = false;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -62,6 +62,8 @@ class SubstringExpression : public AbstractExpression {
     return (spacer + "OperatorSubstringExpression");
   }
 
+  const AbstractExpression *GetLengthExpression() const { return len_; }
+
   AbstractExpression *Copy() const override {
     return new SubstringExpression(CopyUtil(GetLeft()), CopyUtil(GetRight()),
                                    CopyUtil(len_));
@@ -22,6 +22,7 @@
 
 #include "common/macros.h"
 #include "expression/function_expression.h"
+#include "expression/string_kernels.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/scoped_array.hpp>
@@ -56,8 +57,8 @@ inline Value Value::CallUnary<FUNC_CHAR_LENGTH>() const {
   if (IsNull()) return GetNullValue();
 
   char *valueChars = reinterpret_cast<char *>(GetObjectValueWithoutNull());
-  return GetBigIntValue(static_cast<int64_t>(
-      GetCharLength(valueChars, GetObjectLengthWithoutNull())));
+  return GetBigIntValue(static_cast<int64_t>(expression::StringKernels::CharLength(
+      valueChars, GetObjectLengthWithoutNull())));
 }
 
 /** implement the 1-argument SQL SPACE function */
@@ -87,10 +88,12 @@ inline Value Value::CallUnary<FUNC_FOLD_LOWER>() const {
   const char *ptr = reinterpret_cast<const char *>(GetObjectValueWithoutNull());
   int32_t objectLength = GetObjectLengthWithoutNull();
 
-  std::string inputStr = std::string(ptr, objectLength);
-  boost::algorithm::to_lower(inputStr);
-
-  return GetTempStringValue(inputStr.c_str(), objectLength);
+  // Copy once into the result and fold it in place
+  Value result = GetTempStringValue(ptr, objectLength);
+  char *resultChars =
+      reinterpret_cast<char *>(result.GetObjectValueWithoutNull());
+  expression::StringKernels::FoldLower(resultChars, objectLength, resultChars);
+  return result;
 }
 
 template <>
@@ -104,10 +107,12 @@ inline Value Value::CallUnary<FUNC_FOLD_UPPER>() const {
   const char *ptr = reinterpret_cast<const char *>(GetObjectValueWithoutNull());
   int32_t objectLength = GetObjectLengthWithoutNull();
 
-  std::string inputStr = std::string(ptr, objectLength);
-  boost::algorithm::to_upper(inputStr);
-
-  return GetTempStringValue(inputStr.c_str(), objectLength);
+  // Copy once into the result and fold it in place
+  Value result = GetTempStringValue(ptr, objectLength);
+  char *resultChars =
+      reinterpret_cast<char *>(result.GetObjectValueWithoutNull());
+  expression::StringKernels::FoldUpper(resultChars, objectLength, resultChars);
+  return result;
 }
 
 /** implement the 2-argument SQL REPEAT function */
@@ -343,14 +348,12 @@ inline Value Value::Call<FUNC_VOLT_SUBSTRING_CHAR_FROM>(
   const int32_t valueUTF8Length = strValue.GetObjectLengthWithoutNull();
   char *valueChars =
       reinterpret_cast<char *>(strValue.GetObjectValueWithoutNull());
-  const char *valueEnd = valueChars + valueUTF8Length;
-
-  int64_t start =
-      std::max(startArg.CastAsBigIntAndGetValue(), static_cast<int64_t>(1L));
-
-  UTF8Iterator iter(valueChars, valueEnd);
-  const char *startChar = iter.SkipCodePoints(start - 1);
-  return GetTempStringValue(startChar, (int32_t)(valueEnd - startChar));
+  const char *startChar;
+  int32_t resultLength;
+  expression::StringKernels::SubstringFrom(
+      valueChars, valueUTF8Length, startArg.CastAsBigIntAndGetValue(),
+      &startChar, &resultLength);
+  return GetTempStringValue(startChar, resultLength);
 }
 
 static inline std::string trim_function(std::string source,
@@ -509,31 +512,15 @@ inline Value Value::Call<FUNC_SUBSTRING_CHAR>(
   const int32_t valueUTF8Length = strValue.GetObjectLengthWithoutNull();
   const char *valueChars =
       reinterpret_cast<char *>(strValue.GetObjectValueWithoutNull());
-  const char *valueEnd = valueChars + valueUTF8Length;
   int64_t start = startArg.CastAsBigIntAndGetValue();
   int64_t length = lengthArg.CastAsBigIntAndGetValue();
-  if (length < 0) {
-    char message[128];
-    snprintf(message, 128,
-             "data exception -- substring error, negative length argument %ld",
-             (long)length);
-    throw Exception(message);
-  }
-  if (start < 1) {
-    // According to the standard, START < 1 effectively moves the end point
-    // based on (LENGTH + START)
-    // to the left while fixing the start point at 1.
-    length += (start - 1);  // T.Is moves endChar in.
-    start = 1;
-    if (length < 0) {
-      // The standard considers this a 0-length result -- not a substring error.
-      length = 0;
-    }
-  }
-  UTF8Iterator iter(valueChars, valueEnd);
-  const char *startChar = iter.SkipCodePoints(start - 1);
-  const char *endChar = iter.SkipCodePoints(length);
-  return GetTempStringValue(startChar, endChar - startChar);
+  // Throws on a negative length; START < 1 moves the end point to the left
+  // while fixing the start point at 1, per the standard
+  const char *startChar;
+  int32_t resultLength;
+  expression::StringKernels::Substring(valueChars, valueUTF8Length, start,
+                                       length, &startChar, &resultLength);
+  return GetTempStringValue(startChar, resultLength);
 }
 
 static inline std::string overlay_function(const char *ptrSource,
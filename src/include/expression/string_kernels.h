@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_kernels.h
+//
+// Identification: src/include/expression/string_kernels.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// StringKernels
+//
+// String primitives over raw UTF-8 slices (pointer + byte length). None of
+// them allocates: results are either a slice of the input or written into a
+// buffer supplied by the caller, so they can run over column data directly.
+//===----------------------------------------------------------------------===//
+
+class StringKernels {
+ public:
+  // Number of bytes in the code point that starts with this byte
+  static inline int32_t CodePointLength(char lead) {
+    const unsigned char byte = static_cast<unsigned char>(lead);
+    if (byte < 0x80) return 1;
+    if ((byte & 0xe0) == 0xc0) return 2;
+    if ((byte & 0xf0) == 0xe0) return 3;
+    if ((byte & 0xf8) == 0xf0) return 4;
+    // stray continuation or invalid byte, consume it alone
+    return 1;
+  }
+
+  // Advance over up to count code points, stopping at end
+  static inline const char *SkipCodePoints(const char *begin, const char *end,
+                                           int64_t count) {
+    while (count-- > 0 && begin < end) {
+      begin += CodePointLength(*begin);
+    }
+    return (begin < end) ? begin : end;
+  }
+
+  // CHAR_LENGTH : counts the bytes that are not UTF-8 continuation bytes,
+  // eight at a time
+  static inline int32_t CharLength(const char *data, int32_t length) {
+    int32_t continuation_bytes = 0;
+    int32_t offset = 0;
+    for (; offset + 8 <= length; offset += 8) {
+      uint64_t word;
+      ::memcpy(&word, data + offset, sizeof(word));
+      // a continuation byte is 10xxxxxx
+      const uint64_t high = word & 0x8080808080808080ULL;
+      const uint64_t second = (word << 1) & 0x8080808080808080ULL;
+      continuation_bytes += __builtin_popcountll(high & ~second);
+    }
+    for (; offset < length; offset++) {
+      if ((data[offset] & 0xc0) == 0x80) continuation_bytes++;
+    }
+    return length - continuation_bytes;
+  }
+
+  // UPPER / LOWER : ASCII case folding (same as boost::to_upper/to_lower
+  // in the "C" locale), multi-byte code points are copied unchanged.
+  // output must hold length bytes and may alias data.
+  static inline void FoldUpper(const char *data, int32_t length,
+                               char *output) {
+    for (int32_t offset = 0; offset < length; offset++) {
+      const char c = data[offset];
+      output[offset] = (c >= 'a' && c <= 'z') ? (c - ('a' - 'A')) : c;
+    }
+  }
+
+  static inline void FoldLower(const char *data, int32_t length,
+                               char *output) {
+    for (int32_t offset = 0; offset < length; offset++) {
+      const char c = data[offset];
+      output[offset] = (c >= 'A' && c <= 'Z') ? (c + ('a' - 'A')) : c;
+    }
+  }
+
+  /**
+   * @brief SUBSTRING(data FROM start FOR length) as a slice of the input.
+   * Follows Value::Call<FUNC_SUBSTRING_CHAR>: positions are 1-based code
+   * points and a start before 1 shortens the result.
+   */
+  static inline void Substring(const char *data, int32_t data_length,
+                               int64_t start, int64_t length,
+                               const char **result, int32_t *result_length) {
+    const char *end = data + data_length;
+
+    if (length < 0) {
+      char message[128];
+      snprintf(message, 128,
+               "data exception -- substring error, negative length argument "
+               "%ld",
+               (long)length);
+      throw Exception(message);
+    }
+    if (start < 1) {
+      length += (start - 1);
+      start = 1;
+      if (length < 0) length = 0;
+    }
+
+    const char *first = SkipCodePoints(data, end, start - 1);
+    const char *last = SkipCodePoints(first, end, length);
+    *result = first;
+    *result_length = static_cast<int32_t>(last - first);
+  }
+
+  // SUBSTRING(data FROM start), the rest of the string from start
+  static inline void SubstringFrom(const char *data, int32_t data_length,
+                                   int64_t start, const char **result,
+                                   int32_t *result_length) {
+    const char *end = data + data_length;
+    if (start < 1) start = 1;
+    const char *first = SkipCodePoints(data, end, start - 1);
+    *result = first;
+    *result_length = static_cast<int32_t>(end - first);
+  }
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -55,12 +55,15 @@ class BTreeIndex : public Index {
   bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                        std::function<bool(const ItemPointer &)> predicate);
 
+  bool BulkLoad(const std::vector<std::vector<ItemPointer *>> &runs);
+
   void Scan(const std::vector<Value> &value_list,
             const std::vector<oid_t> &tuple_column_id_list,
             const std::vector<ExpressionType> &expr_list,
             const ScanDirectionType &scan_direction,
             std::vector<ItemPointer *> &result,
-            const ConjunctionScanPredicate *csp_p);
+            const ConjunctionScanPredicate *csp_p, size_t limit = 0,
+            std::vector<Value> *result_keys = nullptr);
 
   void ScanAllKeys(std::vector<ItemPointer *> &result);
 
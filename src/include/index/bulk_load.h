@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bulk_load.h
+//
+// Identification: src/include/index/bulk_load.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catalog/manager.h"
+#include "catalog/schema.h"
+#include "expression/container_tuple.h"
+#include "index/index.h"
+#include "index/index_key.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * SortBulkLoadEntries() - Builds the sorted (key, location) entries an index
+ *                         is bulk loaded from
+ *
+ * Every run of locations is handled by a thread of its own, which extracts
+ * the keys of the tuples and sorts them with the comparator of the index.
+ * The sorted runs are then merged pairwise. Returns false if the keys of a
+ * unique index are not unique, or if the index keys are TupleKeys, which
+ * point to key tuples that do not outlive the extraction.
+ */
+template <typename KeyType, typename KeyComparator>
+bool SortBulkLoadEntries(
+    Index *index, const std::vector<std::vector<ItemPointer *>> &runs,
+    const KeyComparator &comparator,
+    std::vector<std::pair<KeyType, ItemPointer *>> &entries) {
+  if (std::is_same<KeyType, TupleKey>::value) return false;
+
+  // Offset of the entries of every run
+  std::vector<size_t> run_offsets;
+  size_t entry_count = 0;
+  for (auto &run : runs) {
+    run_offsets.push_back(entry_count);
+    entry_count += run.size();
+  }
+  entries.resize(entry_count);
+
+  auto key_less = [&comparator](const std::pair<KeyType, ItemPointer *> &lhs,
+                                const std::pair<KeyType, ItemPointer *> &rhs) {
+    return comparator(lhs.first, rhs.first);
+  };
+
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  auto sort_run = [&](size_t run_itr) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    auto &manager = catalog::Manager::GetInstance();
+    std::shared_ptr<storage::TileGroup> tile_group;
+
+    auto run_begin = entries.begin() + run_offsets[run_itr];
+    auto entry_itr = run_begin;
+    for (auto location : runs[run_itr]) {
+      if (tile_group == nullptr ||
+          tile_group->GetTileGroupId() != location->block) {
+        tile_group = manager.GetTileGroup(location->block);
+      }
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           location->offset);
+      key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+      entry_itr->first.SetFromKey(key.get());
+      entry_itr->second = location;
+      entry_itr++;
+    }
+
+    std::sort(run_begin, entry_itr, key_less);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t run_itr = 1; run_itr < runs.size(); run_itr++) {
+    threads.push_back(std::thread(sort_run, run_itr));
+  }
+  if (runs.empty() == false) sort_run(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Merge neighbouring runs until a single one is left
+  for (size_t width = 1; width < runs.size(); width *= 2) {
+    for (size_t run_itr = 0; run_itr + width < runs.size();
+         run_itr += 2 * width) {
+      auto merge_end = (run_itr + 2 * width < runs.size())
+                           ? entries.begin() + run_offsets[run_itr + 2 * width]
+                           : entries.end();
+      std::inplace_merge(entries.begin() + run_offsets[run_itr],
+                         entries.begin() + run_offsets[run_itr + width],
+                         merge_end, key_less);
+    }
+  }
+
+  if (index->HasUniqueKeys()) {
+    for (size_t entry_itr = 1; entry_itr < entries.size(); entry_itr++) {
+      if (key_less(entries[entry_itr - 1], entries[entry_itr]) == false) {
+        LOG_TRACE("Duplicate key in bulk load of %s",
+                  index->GetName().c_str());
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // End index namespace
+}  // End peloton namespace
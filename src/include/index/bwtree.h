@@ -30,7 +30,10 @@
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <functional>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -132,6 +135,9 @@ static void dummy(const char*, ...) {}
 // The maximum number of nodes we could map in this index
 #define MAPPING_TABLE_SIZE ((size_t)(1 << 20))
 
+// The mapping table is allocated in segments of this many entries
+#define MAPPING_TABLE_SEGMENT_SIZE ((size_t)(1 << 12))
+
 // If the length of delta chain exceeds ( >= ) this then we consolidate the node
 #define INNER_DELTA_CHAIN_LENGTH_THRESHOLD ((int)8)
 #define LEAF_DELTA_CHAIN_LENGTH_THRESHOLD ((int)8)
@@ -143,6 +149,125 @@ static void dummy(const char*, ...) {}
 #define LEAF_NODE_SIZE_UPPER_THRESHOLD ((int)128)
 #define LEAF_NODE_SIZE_LOWER_THRESHOLD ((int)32)
 
+// Bulk loading fills nodes up to this fraction of the upper thresholds
+// to leave room for inserts before they split
+#define BULK_LOAD_FILL_FACTOR ((double)0.75)
+
+/*
+ * class GarbageCollector - Cleaner thread shared by all BwTree instances
+ *
+ * Trees that want their garbage collected in the background register a
+ * callback here, and a single thread runs the callbacks of all registered
+ * trees every GC_INTERVAL ms. This replaces one cleaner thread per tree,
+ * which does not scale to schemas with hundreds of indexes.
+ *
+ * The callbacks run with the registry lock held, so once Unregister()
+ * returns the callback of a tree is neither running nor called again.
+ *
+ * NOTE: The instance is never destroyed since trees could be destroyed
+ * during static destruction after it
+ */
+class GarbageCollector {
+ public:
+  // Garbage collection interval (milliseconds)
+  constexpr static int GC_INTERVAL = 50;
+
+  /*
+   * GetInstance() - Return the collector of the process
+   */
+  static GarbageCollector &GetInstance() {
+    static GarbageCollector *gc_p = new GarbageCollector{};
+
+    return *gc_p;
+  }
+
+  /*
+   * Register() - Call gc_func in every round of garbage collection
+   *
+   * The cleaner thread is started by the first registration
+   */
+  void Register(const void *owner_p, std::function<void()> gc_func) {
+    std::lock_guard<std::mutex> lock{registry_mutex};
+
+    registry[owner_p] = std::move(gc_func);
+
+    if(thread_p == nullptr) {
+      bwt_printf("Starting garbage collector thread...\n");
+
+      thread_p = new std::thread{[this](){this->ThreadFunc();}};
+    }
+
+    return;
+  }
+
+  /*
+   * Unregister() - Stop calling the function registered by the owner
+   *
+   * This waits for the round of garbage collection currently running
+   */
+  void Unregister(const void *owner_p) {
+    std::lock_guard<std::mutex> lock{registry_mutex};
+
+    registry.erase(owner_p);
+
+    return;
+  }
+
+  /*
+   * GetRegisteredCount() - Return the number of trees being collected
+   */
+  size_t GetRegisteredCount() {
+    std::lock_guard<std::mutex> lock{registry_mutex};
+
+    return registry.size();
+  }
+
+  /*
+   * GetThreadCount() - Return the number of cleaner threads
+   */
+  size_t GetThreadCount() {
+    std::lock_guard<std::mutex> lock{registry_mutex};
+
+    return thread_p == nullptr ? 0UL : 1UL;
+  }
+
+ private:
+  GarbageCollector() :
+    thread_p{nullptr}
+  {}
+
+  /*
+   * ThreadFunc() - Collect the garbage of every tree each GC_INTERVAL ms
+   */
+  void ThreadFunc() {
+    std::unique_lock<std::mutex> lock{registry_mutex};
+
+    while(1) {
+      for(auto &registry_item : registry) {
+        registry_item.second();
+      }
+
+      // Trees could be registered and unregistered while we sleep
+      lock.unlock();
+
+      std::chrono::milliseconds duration{static_cast<int64_t>(GC_INTERVAL)};
+      std::this_thread::sleep_for(duration);
+
+      lock.lock();
+    }
+
+    return;
+  }
+
+  // Protects the registry; held during a round of garbage collection
+  std::mutex registry_mutex;
+
+  std::unordered_map<const void *, std::function<void()>> registry;
+
+  // Started by the first registration and never stopped
+  std::thread *thread_p;
+};
+
 /*
  * class BwTree - Lock-free BwTree index implementation
  *
@@ -1699,9 +1824,11 @@ class BwTree {
    *
    * Some properties of the tree should be specified in the argument.
    *
-   *   start_gc_thread - If set to true then a separate gc thred will be
-   *                     started. Otherwise GC must be done by the user
-   *                     using PerformGarbageCollection() interface
+   *   start_gc_thread - If set to true then the garbage of the tree is
+   *                     collected by the cleaner thread shared by all
+   *                     trees (see GarbageCollector). Otherwise GC must be
+   *                     done by the user using PerformGarbageCollection()
+   *                     interface
    */
   BwTree(bool start_gc_thread = true,
          KeyComparator p_key_cmp_obj = KeyComparator{},
@@ -1757,11 +1884,11 @@ class BwTree {
     bwt_printf("sizeof(KeyType) = %lu is the size of key\n",
                sizeof(KeyType));
 
-    // We could choose not to start GC thread inside the BwTree
+    // We could choose not to collect garbage in the background
     // in that case GC must be done by calling the interface
     if(start_gc_thread == true) {
-      bwt_printf("Starting epoch manager thread...\n");
-      epoch_manager.StartThread();
+      bwt_printf("Registering with the garbage collector...\n");
+      epoch_manager.RegisterCollector();
     }
 
     dummy("Call it here to avoid compiler warning\n");
@@ -1777,6 +1904,10 @@ class BwTree {
    * has been called before we free the whole tree
    */
   ~BwTree() {
+    // The shared cleaner thread must not touch the tree while it is
+    // being freed
+    epoch_manager.UnregisterCollector();
+
     bwt_printf("Next node ID at exit: %lu\n", next_unused_node_id.load());
     bwt_printf("Destructor: Free tree nodes\n");
 
@@ -2080,7 +2211,7 @@ class BwTree {
   void InitMappingTable() {
     bwt_printf("Initializing mapping table.... size = %lu\n",
                MAPPING_TABLE_SIZE);
-    bwt_printf("Fast initialization: Do not set to zero\n");
+    bwt_printf("Segments are allocated on first use\n");
 
     return;
   }
@@ -2392,6 +2523,63 @@ abort_traverse:
     return;
   }
 
+  /*
+   * KeyLowerBound() - Find the first element in a sorted range of key pairs
+   *                   whose key is >= search key
+   *
+   * This works like std::lower_bound() on KeyNodeIDPair or KeyValuePair
+   * with only keys being compared, except that the range is halved without
+   * a branch on the comparison result. The choice compiles into a
+   * conditional move, which for keys compared with a few integer
+   * instructions (e.g. IntsKey) saves the branch misprediction that
+   * std::lower_bound() suffers on about half of its steps
+   */
+  template <typename IteratorType>
+  inline IteratorType KeyLowerBound(IteratorType first,
+                                    IteratorType last,
+                                    const KeyType &search_key) const {
+    size_t count = static_cast<size_t>(last - first);
+    if(count == 0) {
+      return first;
+    }
+
+    // The result is always inside [first, first + count]
+    while(count > 1) {
+      size_t half = count / 2;
+      first = KeyCmpLess((first + half)->first, search_key) ? \
+              first + half : first;
+      count -= half;
+    }
+
+    return first + (KeyCmpLess(first->first, search_key) ? 1 : 0);
+  }
+
+  /*
+   * KeyUpperBound() - Find the first element in a sorted range of key pairs
+   *                   whose key is > search key
+   *
+   * This is the branch free version of std::upper_bound(). See
+   * KeyLowerBound() for more details
+   */
+  template <typename IteratorType>
+  inline IteratorType KeyUpperBound(IteratorType first,
+                                    IteratorType last,
+                                    const KeyType &search_key) const {
+    size_t count = static_cast<size_t>(last - first);
+    if(count == 0) {
+      return first;
+    }
+
+    while(count > 1) {
+      size_t half = count / 2;
+      first = KeyCmpLessEqual((first + half)->first, search_key) ? \
+              first + half : first;
+      count -= half;
+    }
+
+    return first + (KeyCmpLessEqual(first->first, search_key) ? 1 : 0);
+  }
+
   /*
    * LocateSeparatorByKey() - Locate the child node for a key
    *
@@ -2408,11 +2596,10 @@ abort_traverse:
     // Inner node could not be empty
     assert(sep_list_p->size() != 0UL);
 
-    // Hopefully std::upper_bound would use binary search here
-    auto it = std::upper_bound(sep_list_p->begin() + 1,
-                               sep_list_p->end(),
-                               std::make_pair(search_key, INVALID_NODE_ID),
-                               key_node_id_pair_cmp_obj);
+    // The first element > given key
+    auto it = KeyUpperBound(sep_list_p->begin() + 1,
+                            sep_list_p->end(),
+                            search_key);
 
     // Since upper_bound returns the first element > given key
     // so we need to decrease it to find the last element <= given key
@@ -2420,6 +2607,87 @@ abort_traverse:
     return (it - 1)->second;
   }
 
+  /*
+   * LocateLeftLeaf() - Find the leaf node holding the keys right before
+   *                    a given key
+   *
+   * This is the mirror of Traverse() used by backward iteration: on every
+   * level we choose the child whose low key is < search key (rather than
+   * <=), and go right as long as the high key of the node is < search key.
+   * The leaf found therefore satisfies low key < search key <= high key.
+   * If the key pointer is nullptr then it is treated as +Inf, and the last
+   * leaf node of the tree is returned
+   *
+   * Inner nodes with a delta chain are consolidated into a private copy.
+   * If a remove or abort delta is observed then we retry from the root
+   * since the thread posting it will finish the SMO
+   *
+   * NOTE: The caller must have joined the epoch, and must not call this
+   * with a key that is the low key of the left most leaf node
+   */
+  void LocateLeftLeaf(const KeyType *search_key_p,
+                      NodeSnapshot *snapshot_p) {
+retry_locate:
+    NodeID node_id = root_id.load();
+    const BaseNode *node_p = GetNode(node_id);
+
+    while(1) {
+      // The node has no key < search key on its right side
+      if((node_p->GetNextNodeID() != INVALID_NODE_ID) && \
+         ((search_key_p == nullptr) || \
+          (KeyCmpLess(node_p->GetHighKey(), *search_key_p)))) {
+        node_id = node_p->GetNextNodeID();
+        node_p = GetNode(node_id);
+
+        continue;
+      }
+
+      NodeType type = node_p->GetType();
+      if((type == NodeType::LeafRemoveType) || \
+         (type == NodeType::InnerRemoveType) || \
+         (type == NodeType::InnerAbortType)) {
+        bwt_printf("Remove or abort delta on backward traverse. RETRY\n");
+
+        goto retry_locate;
+      }
+
+      if(node_p->IsOnLeafDeltaChain() == true) {
+        snapshot_p->node_id = node_id;
+        snapshot_p->node_p = node_p;
+
+        return;
+      }
+
+      // Consolidate the delta chain of inner nodes
+      const InnerNode *inner_node_p = static_cast<const InnerNode *>(node_p);
+      if(node_p->IsInnerNode() == false) {
+        NodeSnapshot inner_snapshot{node_id, node_p};
+
+        inner_node_p = CollectAllSepsOnInner(&inner_snapshot,
+                                             node_p->GetDepth() + 1);
+
+        epoch_manager.AddGarbageNode(inner_node_p);
+      }
+
+      const std::vector<KeyNodeIDPair> *sep_list_p = &inner_node_p->sep_list;
+
+      // The last element whose key < search key. The low key is
+      // never compared since it is always < search key
+      auto it = sep_list_p->end();
+      if(search_key_p != nullptr) {
+        it = KeyLowerBound(sep_list_p->begin() + 1,
+                           sep_list_p->end(),
+                           *search_key_p);
+      }
+
+      node_id = (it - 1)->second;
+      node_p = GetNode(node_id);
+    } // while(1)
+
+    assert(false);
+    return;
+  }
+
   /*
    * NavigateInnerNode() - Traverse down through the inner node delta chain
    *                       and probably horizontally to right sibling nodes
@@ -3030,11 +3298,7 @@ abort_traverse:
           // Here we know the search key < high key of current node
           // NOTE: We only compare keys here, so it will get to the first
           // element >= search key
-          auto copy_start_it = \
-            std::lower_bound(start_it,
-                             end_it,
-                             std::make_pair(search_key, ValueType{}),
-                             key_value_pair_cmp_obj);
+          auto copy_start_it = KeyLowerBound(start_it, end_it, search_key);
 
           // If there is something to copy
           while((copy_start_it != leaf_node_p->data_list.end()) && \
@@ -3212,10 +3476,9 @@ abort_traverse:
           // NOTE: We only compare keys here, so it will get to the first
           // element >= search key
           auto scan_start_it = \
-            std::lower_bound(leaf_node_p->data_list.begin(),
-                             leaf_node_p->data_list.end(),
-                             std::make_pair(search_key, ValueType{}),
-                             key_value_pair_cmp_obj);
+            KeyLowerBound(leaf_node_p->data_list.begin(),
+                          leaf_node_p->data_list.end(),
+                          search_key);
 
           // Search all values with the search key
           while((scan_start_it != leaf_node_p->data_list.end()) && \
@@ -3405,10 +3668,9 @@ abort_traverse:
             static_cast<const LeafNode *>(node_p);
 
           auto copy_start_it = \
-            std::lower_bound(leaf_node_p->data_list.begin(),
-                             leaf_node_p->data_list.end(),
-                             std::make_pair(search_key, ValueType{}),
-                             key_value_pair_cmp_obj);
+            KeyLowerBound(leaf_node_p->data_list.begin(),
+                          leaf_node_p->data_list.end(),
+                          search_key);
 
           while((copy_start_it != leaf_node_p->data_list.end()) && \
                 (KeyCmpEqual(search_key, copy_start_it->first))) {
@@ -5620,10 +5882,7 @@ before_switch:
           start_it++;
         }
 
-        auto it = std::lower_bound(start_it,
-                                   sep_list_p->end(),
-                                   std::make_pair(search_key, INVALID_NODE_ID),
-                                   key_node_id_pair_cmp_obj);
+        auto it = KeyLowerBound(start_it, sep_list_p->end(), search_key);
                                    
         if(it == sep_list_p->end()) {
           // This is special case since we could not compare the iterator
@@ -6419,6 +6678,205 @@ before_switch:
     return;
   }
 
+  /*
+   * BulkLoad() - Builds the tree bottom up from key-value pairs sorted
+   *              by key
+   *
+   * Leaf nodes are filled with BULK_LOAD_FILL_FACTOR of the upper threshold
+   * without spreading a key over two of them, and every level of inner
+   * nodes is built from the low keys of the level below the same way, until
+   * a single node remains which replaces the root.
+   *
+   * This only works on an empty tree, and returns false if it is not. The
+   * empty leaf is replaced with CAS first, so that a concurrent insert
+   * either makes this function fail, or follows the sibling chain of the
+   * new leaves until the new root is installed. If the root changed in the
+   * meantime the new inner nodes are dropped, and the leaves are only
+   * reachable through that chain.
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &kvp_list) {
+    if(kvp_list.size() == 0) {
+      return true;
+    }
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // Only the layout built in the constructor could be replaced, i.e.
+    // a root with a single separator pointing to an empty leaf
+    NodeID old_root_id = root_id.load();
+    const BaseNode *old_root_p = GetNode(old_root_id);
+    const BaseNode *old_leaf_p = GetNode(first_leaf_id);
+    if((old_root_p->GetType() != NodeType::InnerType) || \
+       (old_root_p->GetItemCount() != 1) || \
+       (old_leaf_p->GetType() != NodeType::LeafType) || \
+       (old_leaf_p->GetItemCount() != 0)) {
+      bwt_printf("Bulk load into a tree that is not empty\n");
+
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    // Spreads item_count items evenly over as few nodes as possible
+    auto get_node_size = [](size_t item_count, int upper_threshold) {
+      size_t max_node_size = std::max(
+        static_cast<size_t>(upper_threshold * BULK_LOAD_FILL_FACTOR), 1UL);
+      size_t node_count = (item_count + max_node_size - 1) / max_node_size;
+
+      return (item_count + node_count - 1) / node_count;
+    };
+
+    // Index of the first item of each leaf; a leaf takes the items with
+    // the same key as its last one as well
+    size_t leaf_size = get_node_size(kvp_list.size(),
+                                     LEAF_NODE_SIZE_UPPER_THRESHOLD);
+    std::vector<size_t> leaf_start_list{0};
+    for(size_t item_index = leaf_size; item_index < kvp_list.size();) {
+      if(KeyCmpEqual(kvp_list[item_index - 1].first,
+                     kvp_list[item_index].first) == true) {
+        item_index++;
+      } else {
+        leaf_start_list.push_back(item_index);
+        item_index += leaf_size;
+      }
+    }
+
+    // Low key and NodeID of every node on the level being built; the
+    // first node of each level has the low key of the empty leaf (-Inf)
+    size_t leaf_count = leaf_start_list.size();
+    std::vector<KeyNodeIDPair> node_list{};
+    node_list.reserve(leaf_count);
+    node_list.push_back(std::make_pair(old_leaf_p->GetLowKey(),
+                                       first_leaf_id));
+    for(size_t leaf_index = 1; leaf_index < leaf_count; leaf_index++) {
+      node_list.push_back(
+        std::make_pair(kvp_list[leaf_start_list[leaf_index]].first,
+                       GetNextNodeID()));
+    }
+
+    // The high key of the last node of each level is +Inf
+    const KeyNodeIDPair &last_high_key = old_leaf_p->GetHighKeyPair();
+
+    const LeafNode *first_leaf_p = nullptr;
+    std::vector<std::pair<NodeID, const LeafNode *>> leaf_node_list{};
+    for(size_t leaf_index = 0; leaf_index < leaf_count; leaf_index++) {
+      auto copy_start_it = kvp_list.begin() + leaf_start_list[leaf_index];
+      auto copy_end_it = (leaf_index + 1 == leaf_count) ? \
+                         kvp_list.end() : \
+                         kvp_list.begin() + leaf_start_list[leaf_index + 1];
+
+      LeafNode *leaf_node_p = \
+        new LeafNode{std::make_pair(node_list[leaf_index].first,
+                                    INVALID_NODE_ID),
+                     (leaf_index + 1 == leaf_count) ? \
+                       last_high_key : node_list[leaf_index + 1],
+                     static_cast<int>(std::distance(copy_start_it,
+                                                    copy_end_it))};
+      leaf_node_p->data_list.assign(copy_start_it, copy_end_it);
+
+      // The first leaf is installed last
+      if(leaf_index == 0) {
+        first_leaf_p = leaf_node_p;
+      } else {
+        InstallNewNode(node_list[leaf_index].second, leaf_node_p);
+        leaf_node_list.push_back(
+          std::make_pair(node_list[leaf_index].second, leaf_node_p));
+      }
+    }
+
+    // Inner nodes other than the root, which are not reachable until the
+    // root is installed
+    std::vector<std::pair<NodeID, const InnerNode *>> inner_node_list{};
+    const InnerNode *new_root_p = nullptr;
+    size_t height = 1;
+
+    while(new_root_p == nullptr) {
+      size_t inner_size = get_node_size(node_list.size(),
+                                        INNER_NODE_SIZE_UPPER_THRESHOLD);
+      size_t inner_count = (node_list.size() + inner_size - 1) / inner_size;
+
+      // The separators of an inner node are the low keys of its children,
+      // the first of which is also its own low key
+      std::vector<KeyNodeIDPair> parent_list{};
+      parent_list.reserve(inner_count);
+      for(size_t inner_index = 0; inner_index < inner_count; inner_index++) {
+        parent_list.push_back(
+          std::make_pair(node_list[inner_index * inner_size].first,
+                         (inner_count == 1) ? old_root_id : GetNextNodeID()));
+      }
+
+      for(size_t inner_index = 0; inner_index < inner_count; inner_index++) {
+        auto copy_start_it = node_list.begin() + inner_index * inner_size;
+        auto copy_end_it = (inner_index + 1 == inner_count) ? \
+                           node_list.end() : \
+                           copy_start_it + inner_size;
+
+        InnerNode *inner_node_p = \
+          new InnerNode{(inner_index + 1 == inner_count) ? \
+                          last_high_key : parent_list[inner_index + 1],
+                        static_cast<int>(std::distance(copy_start_it,
+                                                       copy_end_it))};
+        inner_node_p->sep_list.assign(copy_start_it, copy_end_it);
+
+        if(inner_count == 1) {
+          new_root_p = inner_node_p;
+        } else {
+          InstallNewNode(parent_list[inner_index].second, inner_node_p);
+          inner_node_list.push_back(
+            std::make_pair(parent_list[inner_index].second, inner_node_p));
+        }
+      }
+
+      node_list.swap(parent_list);
+      height++;
+    }
+
+    // Nodes that are not reachable are freed directly. Their NodeIDs are
+    // not recycled since other threads may be popping the free list
+    auto drop_inner_nodes = [this, &inner_node_list, new_root_p]() {
+      for(auto &inner_node_pair : inner_node_list) {
+        mapping_table[inner_node_pair.first] = nullptr;
+        delete inner_node_pair.second;
+      }
+
+      delete new_root_p;
+    };
+
+    // A concurrent insert got in first, and nothing has been published
+    if(InstallNodeToReplace(first_leaf_id,
+                            first_leaf_p,
+                            old_leaf_p) == false) {
+      bwt_printf("Bulk load lost the empty leaf to an insert. ABORT\n");
+
+      drop_inner_nodes();
+      for(auto &leaf_node_pair : leaf_node_list) {
+        mapping_table[leaf_node_pair.first] = nullptr;
+        delete leaf_node_pair.second;
+      }
+      delete first_leaf_p;
+
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    epoch_manager.AddGarbageNode(old_leaf_p);
+
+    if(InstallNodeToReplace(old_root_id, new_root_p, old_root_p) == true) {
+      epoch_manager.AddGarbageNode(old_root_p);
+
+      tree_height = height;
+    } else {
+      bwt_printf("Root changed during bulk load; keep the sibling chain\n");
+
+      drop_inner_nodes();
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return true;
+  }
+
  /*
   * Private Method Implementation
   */
@@ -6471,8 +6929,91 @@ before_switch:
   // This value is non-atomic, but it remains constant after constructor
   NodeID first_leaf_id;
 
+  /*
+   * class MappingTable - Maps NodeID to nodes, allocated segment by segment
+   *
+   * NodeIDs are handed out from a counter and recycled, so they are dense
+   * and a small tree only ever touches its first segment instead of a
+   * table of MAPPING_TABLE_SIZE entries. The first thread accessing a
+   * segment allocates it and installs it with CAS; segments are zeroed and
+   * only freed together with the table.
+   */
+  class MappingTable {
+   public:
+    constexpr static size_t SEGMENT_COUNT = \
+      MAPPING_TABLE_SIZE / MAPPING_TABLE_SEGMENT_SIZE;
+
+    using Segment = \
+      std::array<std::atomic<const BaseNode *>, MAPPING_TABLE_SEGMENT_SIZE>;
+
+    MappingTable() :
+      segment_count{0UL} {
+      for(auto &segment_p : segment_list) {
+        segment_p.store(nullptr);
+      }
+    }
+
+    ~MappingTable() {
+      for(auto &segment_p : segment_list) {
+        delete segment_p.load();
+      }
+    }
+
+    /*
+     * operator[] - Return the entry of a NodeID, allocating its segment
+     *              if it does not exist yet
+     */
+    inline std::atomic<const BaseNode *> &operator[](NodeID node_id) {
+      assert(node_id < MAPPING_TABLE_SIZE);
+
+      std::atomic<Segment *> &segment_slot = \
+        segment_list[node_id / MAPPING_TABLE_SEGMENT_SIZE];
+
+      Segment *segment_p = segment_slot.load();
+      if(segment_p == nullptr) {
+        segment_p = AllocateSegment(segment_slot);
+      }
+
+      return (*segment_p)[node_id % MAPPING_TABLE_SEGMENT_SIZE];
+    }
+
+    /*
+     * GetMemoryFootprint() - Return the bytes allocated for the table
+     */
+    size_t GetMemoryFootprint() const {
+      return sizeof(MappingTable) + segment_count.load() * sizeof(Segment);
+    }
+
+   private:
+    /*
+     * AllocateSegment() - Install a new segment unless another thread
+     *                     did so first, and return the installed one
+     */
+    Segment *AllocateSegment(std::atomic<Segment *> &segment_slot) {
+      Segment *segment_p = new Segment;
+      for(auto &entry : *segment_p) {
+        entry.store(nullptr);
+      }
+
+      Segment *expected_p = nullptr;
+      if(segment_slot.compare_exchange_strong(expected_p, segment_p)) {
+        segment_count.fetch_add(1);
+
+        return segment_p;
+      }
+
+      delete segment_p;
+
+      return expected_p;
+    }
+
+    std::array<std::atomic<Segment *>, SEGMENT_COUNT> segment_list;
+
+    std::atomic<size_t> segment_count;
+  };
+
   std::atomic<NodeID> next_unused_node_id;
-  std::array<std::atomic<const BaseNode *>, MAPPING_TABLE_SIZE> mapping_table;
+  MappingTable mapping_table;
 
   // This list holds free NodeID which was removed by remove delta
   // We recycle NodeID in epoch manager
@@ -6503,9 +7044,6 @@ before_switch:
    public:
     BwTree *tree_p;
 
-    // Garbage collection interval (milliseconds)
-    constexpr static int GC_INTERVAL = 50;
-
     /*
      * struct GarbageNode - A linked list of garbages
      */
@@ -6553,10 +7091,12 @@ before_switch:
     // Therefore, strict ordering is required
     std::atomic<bool> exited_flag;
 
-    // If GC is done with external thread then this should be set
-    // to nullptr
-    // Otherwise it points to a thread created by EpochManager internally
-    std::thread *thread_p;
+    // Whether the tree is registered with the shared garbage collector
+    bool registered_flag;
+
+    // Serializes rounds of GC, which could be started both by the
+    // shared garbage collector and by external threads
+    std::mutex gc_mutex;
 
     // The counter that counts how many free is called
     // inside the epoch manager
@@ -6598,8 +7138,8 @@ before_switch:
 
       head_epoch_p = current_epoch_p;
 
-      // We allocate and run this later
-      thread_p = nullptr;
+      // We register with the garbage collector later
+      registered_flag = false;
 
       // This is used to notify the cleaner thread that it has ended
       exited_flag.store(false);
@@ -6622,42 +7162,25 @@ before_switch:
     }
 
     /*
-     * Destructor - Stop the worker thread and cleanup resources not freed
-     *
-     * This function waits for the worker thread using join() method. After the
-     * worker thread has exited, it synchronously clears all epochs that have
-     * not been recycled by calling ClearEpoch()
+     * Destructor - Stop garbage collection and cleanup resources not freed
      *
-     * NOTE: If no internal GC is started then thread_p would be a nullptr
-     * and we neither wait nor free the pointer.
+     * This function unregisters from the shared garbage collector, which
+     * waits for a round of GC on this tree to finish. After that it
+     * synchronously clears all epochs that have not been recycled by
+     * calling ClearEpoch()
      */
     ~EpochManager() {
-      // Set stop flag and let thread terminate
+      // Set stop flag
       // Also if there is an external GC thread then it should
       // check this flag everytime it does cleaning since otherwise
       // the un-thread-safe function ClearEpoch() would be ran
       // by more than 1 threads
       exited_flag.store(true);
 
-      // If thread pointer is nullptr then we know the GC thread
-      // is not started. In this case do not wait for the thread, and just
-      // call destructor
-      //
       // NOTE: The destructor routine is not thread-safe, so if an external
       // GC thread is being used then that thread should check for
       // exited_flag everytime it wants to do GC
-      //
-      // If the external thread calls ThreadFunc() then it is safe
-      if(thread_p != nullptr) {
-        bwt_printf("Waiting for thread\n");
-        
-        thread_p->join();
-
-        // Free memory
-        delete thread_p;
-        
-        bwt_printf("Thread stops\n");
-      }
+      UnregisterCollector();
 
       // So that in the following function the comparison
       // would always fail, until we have cleaned all epoch nodes
@@ -7116,42 +7639,41 @@ try_join_again:
      * its own GC thread using the loop
      */
     void PerformGarbageCollection() {
+      std::lock_guard<std::mutex> lock{gc_mutex};
+
       ClearEpoch();
       CreateNewEpoch();
     }
 
     /*
-     * ThreadFunc() - The cleaner thread executes this every GC_INTERVAL ms
+     * RegisterCollector() - Let the shared garbage collector do GC for
+     *                       this tree every GarbageCollector::GC_INTERVAL ms
      *
-     * This function exits when exit flag is set to true
+     * NOTE: This is not called in the constructor, and needs to be
+     * called manually
      */
-    void ThreadFunc() {
-      // While the parent is still running
-      // We do not worry about race condition here
-      // since even if we missed one we could always
-      // hit the correct value on next try
-      while(exited_flag.load() == false) {
-        //printf("Start new epoch cycle\n");
-        PerformGarbageCollection();
-
-        // Sleep for 50 ms
-        std::chrono::milliseconds duration(GC_INTERVAL);
-        std::this_thread::sleep_for(duration);
-      }
+    void RegisterCollector() {
+      registered_flag = true;
 
-      bwt_printf("exit flag is true; thread return\n");
+      GarbageCollector::GetInstance().Register(
+        this,
+        [this](){this->PerformGarbageCollection();});
 
       return;
     }
 
     /*
-     * StartThread() - Start cleaner thread for garbage collection
+     * UnregisterCollector() - Stop GC by the shared garbage collector
      *
-     * NOTE: This is not called in the constructor, and needs to be
-     * called manually
+     * After this returns no round of GC started by the collector is running
+     * on this tree. Calling it more than once is harmless
      */
-    void StartThread() {
-      thread_p = new std::thread{[this](){this->ThreadFunc();}};
+    void UnregisterCollector() {
+      if(registered_flag == true) {
+        registered_flag = false;
+
+        GarbageCollector::GetInstance().Unregister(this);
+      }
 
       return;
     }
@@ -7185,6 +7707,26 @@ try_join_again:
     return ForwardIterator{this, start_key};
   }
 
+  /*
+   * ReverseBegin() - Return an iterator pointing to the last element in
+   *                  the tree, used for backward iteration with operator--
+   *
+   * If the tree is empty then the iterator is an end iterator
+   */
+  ForwardIterator ReverseBegin() {
+    return ForwardIterator{this, static_cast<const KeyType *>(nullptr)};
+  }
+
+  /*
+   * ReverseBegin() - Return an iterator pointing to the last element whose
+   *                  key is less than or equal to the given key
+   *
+   * If there is no such element then the iterator is an end iterator
+   */
+  ForwardIterator ReverseBegin(const KeyType &end_key) {
+    return ForwardIterator{this, &end_key};
+  }
+
   /*
    * NullIterator() - Returns an empty iterator that cannot do anything
    *
@@ -7206,6 +7748,11 @@ try_join_again:
    * class ForwardIterator - Iterator that supports forward iteration of
    *                         tree elements
    *
+   * Backward iteration is supported through operator--. Since there is no
+   * left sibling link, the previous leaf page is reached by traversing down
+   * with the low key of the current page (see LocateLeftLeaf()). Moving
+   * before the first element sets the end flag as well
+   *
    * NOTE: An iterator could be begin() and end() iterator at the same time,
    * as long as the container is empty. To correctly identify this case, we
    * need to try loading the first page with key = -Inf to test whether
@@ -7248,6 +7795,8 @@ try_join_again:
 
       NodeSnapshot snapshot{FIRST_LEAF_NODE_ID, node_p};
 
+      SetPrevKeyPair(&snapshot);
+
       // Consolidate the current node (this does not change high key)
       leaf_node_p = tree_p->CollectAllValuesOnLeaf(&snapshot);
 
@@ -7286,6 +7835,24 @@ try_join_again:
       return;
     }
 
+    /*
+     * Constructor - Construct a backward iterator given an end key
+     *
+     * The iterator is located on the last data item whose key is <= the
+     * given key, or on the last data item of the tree if the key pointer
+     * is nullptr. If there is no such item then is_end is set
+     */
+    ForwardIterator(BwTree *p_tree_p,
+                    const KeyType *end_key_p) :
+      tree_p{p_tree_p},
+      leaf_node_p{nullptr},
+      is_end{false} {
+
+      UpperBound(end_key_p, true);
+
+      return;
+    }
+
     /*
      * Copy Constructor - Constructs a new iterator instance from existing one
      *
@@ -7298,6 +7865,7 @@ try_join_again:
       // This copy constructs all members recursively by default
       leaf_node_p{new LeafNode{*other.leaf_node_p}},
       next_key_pair{other.next_key_pair},
+      prev_key_pair{other.prev_key_pair},
       is_end{other.is_end} {
 
       // Move the iterator ahead
@@ -7336,6 +7904,7 @@ try_join_again:
       // Copy everything that could be copied
       tree_p = other.tree_p;
       next_key_pair = other.next_key_pair;
+      prev_key_pair = other.prev_key_pair;
 
       is_end = other.is_end;
 
@@ -7372,6 +7941,7 @@ try_join_again:
 
       tree_p = other.tree_p;
       next_key_pair = other.next_key_pair;
+      prev_key_pair = other.prev_key_pair;
 
       is_end = other.is_end;
 
@@ -7506,6 +8076,22 @@ try_join_again:
       return temp;
     }
 
+    /*
+     * Prefix operator-- - Move the iterator back and return the new iterator
+     *
+     * Moving back from the first element sets the end flag. If the iterator
+     * is end() iterator then we do nothing
+     */
+    inline ForwardIterator &operator--() {
+      if(is_end == true) {
+        return *this;
+      }
+
+      MoveBackByOne();
+
+      return *this;
+    }
+
     /*
      * IsEnd() - Returns true if we have reached the end of iteration
      *
@@ -7539,6 +8125,12 @@ try_join_again:
     // node into the iterator
     KeyNodeIDPair next_key_pair;
 
+    // The low key of current logical leaf node, used to access the previous
+    // leaf node in the same way as next_key_pair. The node ID is
+    // INVALID_NODE_ID if the current node is the left most leaf node,
+    // in which case the low key is -Inf
+    KeyNodeIDPair prev_key_pair;
+
     // This is the actual iterator
     typename std::vector<KeyValuePair>::const_iterator it;
 
@@ -7610,6 +8202,8 @@ try_join_again:
         // Set high key pair for next call of this function
         next_key_pair = node_p->GetHighKeyPair();
 
+        SetPrevKeyPair(snapshot_p);
+
         // If this is nullptr then we are calling it from the constructor
         if(leaf_node_p != nullptr) {
           // Only we call it from the constructor will the start key pointer
@@ -7631,10 +8225,9 @@ try_join_again:
         // Find the lower bound of the current start search key
         // NOTE: Do not use start_key_p since it has been changed by the
         // assignment to next_key_pair
-        it = std::lower_bound(leaf_node_p->data_list.begin(),
-                              leaf_node_p->data_list.end(),
-                              std::make_pair(start_key, ValueType{}),
-                              this->tree_p->key_value_pair_cmp_obj);
+        it = tree_p->KeyLowerBound(leaf_node_p->data_list.begin(),
+                                   leaf_node_p->data_list.end(),
+                                   start_key);
 
         // All keys in the leaf page are < start key. Switch the next key until
         // we have found the key or until we have reached end of tree
@@ -7673,6 +8266,138 @@ try_join_again:
 
       return;
     }
+
+    /*
+     * SetPrevKeyPair() - Save the low key of the leaf node being loaded
+     */
+    inline void SetPrevKeyPair(const NodeSnapshot *snapshot_p) {
+      if(snapshot_p->node_id == FIRST_LEAF_NODE_ID) {
+        prev_key_pair = std::make_pair(KeyType(), INVALID_NODE_ID);
+      } else {
+        prev_key_pair = std::make_pair(snapshot_p->node_p->GetLowKey(),
+                                       snapshot_p->node_id);
+      }
+
+      return;
+    }
+
+    /*
+     * UpperBound() - Load leaf page whose key <= end_key (or < end_key if
+     *                inclusive is false) and locate the last such key
+     *
+     * This is the mirror of LowerBound(). If a leaf page has no such key
+     * then we switch to the page on its left using the low key, until the
+     * left most leaf node has been scanned, which sets is_end
+     *
+     * NOTE: For the same reason as in LowerBound(), after loading a logical
+     * node we locate the key using the end key, rather than assuming that
+     * all keys in the page qualify, since the page might have been merged
+     * with its right sibling
+     *
+     * NOTE 2: If end_key_p is nullptr then the last page is loaded and
+     * the iterator is located on its last key
+     */
+    void UpperBound(const KeyType *end_key_p, bool inclusive) {
+      assert(is_end == false);
+
+      while(1) {
+        // We need to save this since the end key pointer might point to
+        // prev_key_pair which will be overwritten
+        const KeyType end_key = \
+          (end_key_p == nullptr) ? KeyType() : *end_key_p;
+
+        EpochNode *epoch_node_p = tree_p->epoch_manager.JoinEpoch();
+
+        NodeSnapshot snapshot;
+
+        if((inclusive == true) && (end_key_p != nullptr)) {
+          // The leaf node whose low key <= end key < high key
+          Context context{end_key};
+
+          tree_p->Traverse(&context, nullptr, nullptr);
+
+          snapshot = *tree_p->GetLatestNodeSnapshot(&context);
+        } else {
+          // The leaf node whose low key < end key <= high key
+          tree_p->LocateLeftLeaf(end_key_p == nullptr ? nullptr : &end_key,
+                                 &snapshot);
+        }
+
+        assert(snapshot.node_p->IsOnLeafDeltaChain() == true);
+
+        next_key_pair = snapshot.node_p->GetHighKeyPair();
+
+        SetPrevKeyPair(&snapshot);
+
+        if(leaf_node_p != nullptr) {
+          delete leaf_node_p;
+        }
+
+        leaf_node_p = tree_p->CollectAllValuesOnLeaf(&snapshot);
+
+        tree_p->epoch_manager.LeaveEpoch(epoch_node_p);
+
+        // One past the last key that qualifies
+        it = leaf_node_p->data_list.end();
+        if(end_key_p != nullptr) {
+          if(inclusive == true) {
+            it = tree_p->KeyUpperBound(leaf_node_p->data_list.begin(),
+                                       leaf_node_p->data_list.end(),
+                                       end_key);
+          } else {
+            it = tree_p->KeyLowerBound(leaf_node_p->data_list.begin(),
+                                       leaf_node_p->data_list.end(),
+                                       end_key);
+          }
+        }
+
+        if(it != leaf_node_p->data_list.begin()) {
+          it--;
+
+          return;
+        }
+
+        // All keys in the leaf page are > end key. If this is the left most
+        // leaf node then we have reached the end
+        if(prev_key_pair.second == INVALID_NODE_ID) {
+          is_end = true;
+
+          return;
+        }
+
+        end_key_p = &prev_key_pair.first;
+        inclusive = false;
+      } // while(1)
+
+      assert(false);
+      return;
+    }
+
+    /*
+     * MoveBackByOne() - Move the iterator back by one
+     *
+     * If the iterator is on the first key of the leaf page then the page on
+     * its left is loaded using the low key of the current page
+     */
+    inline void MoveBackByOne() {
+      assert(leaf_node_p != nullptr);
+
+      if(it != leaf_node_p->data_list.begin()) {
+        it--;
+
+        return;
+      }
+
+      if(prev_key_pair.second == INVALID_NODE_ID) {
+        is_end = true;
+
+        return;
+      }
+
+      UpperBound(&prev_key_pair.first, false);
+
+      return;
+    }
   }; // ForwardIterator
 
 }; // class BwTree
@@ -97,6 +97,8 @@ class BWTreeIndex : public Index {
                        ItemPointer *location,
                        std::function<bool(const ItemPointer &)> predicate);
 
+  bool BulkLoad(const std::vector<std::vector<ItemPointer *>> &runs);
+
   void Scan(const std::vector<Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -112,7 +114,9 @@ class BWTreeIndex : public Index {
             const std::vector<ExpressionType> &expr_types,
             const ScanDirectionType &scan_direction,
             std::vector<ItemPointer *> &result,
-            const ConjunctionScanPredicate *csp_p);
+            const ConjunctionScanPredicate *csp_p,
+            size_t limit = 0,
+            std::vector<Value> *result_keys = nullptr);
 
   void ScanAllKeys(std::vector<ItemPointer *> &result);
 
@@ -60,7 +60,8 @@ class IndexMetadata : public Printable {
                 IndexConstraintType index_type,
                 const catalog::Schema *tuple_schema,
                 const catalog::Schema *key_schema,
-                const std::vector<oid_t> &key_attrs, bool unique_keys);
+                const std::vector<oid_t> &key_attrs, bool unique_keys,
+                oid_t included_column_count = 0);
 
   ~IndexMetadata();
 
@@ -87,6 +88,16 @@ class IndexMetadata : public Printable {
 
   bool HasUniqueKeys() const { return unique_keys; }
 
+  /*
+   * GetIncludedColumnCount() - Returns the number of included columns, which
+   *                            are the trailing columns of the key
+   *
+   * Included columns are not meant to be searched on. They are kept in the
+   * key, and maintained like any other key column, so that a scan reading
+   * them can be answered from the index alone
+   */
+  oid_t GetIncludedColumnCount() const { return included_column_count; }
+
   /*
    * GetKeyAttrs() - Returns the mapping relation between indexed columns
    *                 and base table columns
@@ -147,6 +158,9 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   bool unique_keys;
 
+  // Number of trailing key columns that are included columns
+  oid_t included_column_count;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 };
@@ -211,16 +225,41 @@ class Index : public Printable {
       const storage::Tuple *key, ItemPointer *location,
       std::function<bool(const ItemPointer &)> predicate) = 0;
 
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Loading
+  ///////////////////////////////////////////////////////////////////
+
+  // Fills an empty index with the tuples at the given locations at once,
+  // instead of inserting them one at a time. Each run of locations (e.g.
+  // a range of tile groups) has its keys extracted and sorted by a thread,
+  // the sorted runs are merged and the nodes are built bottom up.
+  // Returns false without changing the index if it is not empty or a unique
+  // key is violated, in which case the caller inserts the entries instead.
+  // Only COPY into a table whose indexes are empty uses it : an index built
+  // online is maintained by writers from the start, so it is never empty
+  // and DataTable::BuildIndex inserts its entries one at a time.
+  virtual bool BulkLoad(
+      const std::vector<std::vector<ItemPointer *>> &runs) = 0;
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
 
+  // Appends the locations of the entries satisfying the predicate to the
+  // result, in ascending key order or in descending key order for a
+  // SCAN_DIRECTION_TYPE_BACKWARD scan. If limit is not 0 then the scan
+  // stops as soon as limit entries have been appended, so a descending
+  // top-N query only visits the entries it returns. If result_keys is not
+  // null then the values of all the key columns of every appended entry are
+  // appended to it as well, for scans that are answered from the index.
   virtual void Scan(const std::vector<Value> &value_list,
                     const std::vector<oid_t> &tuple_column_id_list,
                     const std::vector<ExpressionType> &expr_list,
                     const ScanDirectionType &scan_direction,
                     std::vector<ItemPointer *> &result,
-                    const ConjunctionScanPredicate *csp_p) = 0;
+                    const ConjunctionScanPredicate *csp_p,
+                    size_t limit = 0,
+                    std::vector<Value> *result_keys = nullptr) = 0;
 
   // This is the version used to test scan
   // Since it does scan planning everytime, it is slow, and should
@@ -229,7 +268,8 @@ class Index : public Printable {
                         const std::vector<oid_t> &tuple_column_id_list,
                         const std::vector<ExpressionType> &expr_list,
                         const ScanDirectionType &scan_direction,
-                        std::vector<ItemPointer *> &result);
+                        std::vector<ItemPointer *> &result,
+                        size_t limit = 0);
 
   virtual void ScanAllKeys(std::vector<ItemPointer *> &result) = 0;
 
@@ -327,6 +367,12 @@ class Index : public Printable {
     return;
   }
 
+  // Whether scans may read the index. An index added to a table online is
+  // maintained by the writers, but only readable once it is built.
+  bool IsReadable() const { return readable.load(); }
+
+  void SetReadable(bool p_readable) { readable = p_readable; }
+
  protected:
   Index(IndexMetadata *schema);
 
@@ -336,6 +382,11 @@ class Index : public Printable {
                                 const std::vector<oid_t> &key_column_ids,
                                 const std::vector<ExpressionType> &expr_types);
 
+  // Appends the values of the columns of the key to the result keys of a
+  // scan, copying the values inlined in the key
+  static void AppendKeyValues(const storage::Tuple &key,
+                              std::vector<Value> &result_keys);
+
   //===--------------------------------------------------------------------===//
   //  Data members
   //===--------------------------------------------------------------------===//
@@ -361,6 +412,9 @@ class Index : public Printable {
 
   // This is used by index tuner
   std::atomic<size_t> indexed_tile_group_offset;
+
+  // Whether scans may read the index, see DataTable::AddIndexOnline
+  std::atomic<bool> readable;
 };
 
 }  // End index namespace
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "common/value_factory.h"
 #include "common/value_peeker.h"
 #include "common/logger.h"
 #include "common/macros.h"
@@ -170,9 +171,68 @@ class IntsKey {
     return retval;
   }
 
+  /*
+   * GetTupleForComparison() - Unpacks the key into a key tuple, which is
+   *                           used to evaluate scan predicates
+   *
+   * The tuple points to a buffer of the calling thread, so it is only
+   * valid until the next call on the same thread
+   */
   const storage::Tuple GetTupleForComparison(
-      UNUSED_ATTRIBUTE const catalog::Schema *key_schema) const {
-    throw IndexException("Tuple conversion not supported");
+      const catalog::Schema *key_schema) const {
+    static thread_local char tuple_data[KeySize * sizeof(uint64_t)];
+    PL_ASSERT(key_schema->GetLength() <= sizeof(tuple_data));
+
+    storage::Tuple tuple(key_schema, tuple_data);
+    int key_offset = 0;
+    int intra_key_offset = sizeof(uint64_t) - 1;
+    const int GetColumnCount = key_schema->GetColumnCount();
+    for (int ii = 0; ii < GetColumnCount; ii++) {
+      switch (key_schema->GetColumn(ii).column_type) {
+        case VALUE_TYPE_BIGINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint64_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, ValueFactory::GetBigIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int64_t, INT64_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case VALUE_TYPE_INTEGER: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint32_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, ValueFactory::GetIntegerValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int32_t, INT32_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case VALUE_TYPE_SMALLINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint16_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, ValueFactory::GetSmallIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int16_t, INT16_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case VALUE_TYPE_TINYINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint8_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, ValueFactory::GetTinyIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int8_t, INT8_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        default:
+          throw IndexException(
+              "We currently only support a specific set of "
+              "column index sizes...");
+          break;
+      }
+    }
+    return tuple;
   }
 
   std::string Debug(const catalog::Schema *key_schema) const {
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// access_path.h
+//
+// Identification: src/include/optimizer/access_path.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace optimizer {
+
+// Index matches read to estimate the selectivity of the predicates of an
+// index on a table without statistics
+#define INDEX_SAMPLE_LIMIT 1000
+
+//===--------------------------------------------------------------------===//
+// Access Path
+//===--------------------------------------------------------------------===//
+
+enum class AccessPathType {
+  SeqScan,
+  // The matches of the index are read in the order of their keys
+  IndexScan,
+  // The matches of the index are read in the order of their locations
+  BitmapScan
+};
+
+/**
+ * The way a scan reads the tuples of a table satisfying a conjunction of
+ * comparisons of columns with values.
+ */
+struct AccessPath {
+  AccessPathType type = AccessPathType::SeqScan;
+
+  // Offset of the index in the table, INVALID_OID for a sequential scan
+  oid_t index_offset = INVALID_OID;
+
+  // Offsets of the comparisons the index is probed with
+  std::vector<oid_t> key_predicates;
+
+  // Estimated fraction of the tuples the index returns and the cost of the
+  // scan, see CostModel
+  double selectivity = 1;
+  double cost = 0;
+};
+
+/**
+ * Chooses the cheapest access path for the scan of the table with the
+ * predicates column_ids[i] expr_types[i] values[i].
+ *
+ * An index can only narrow a scan down to the entries of a prefix of its
+ * key: the comparisons on its leading key columns, up to the first one that
+ * is not an equality. The fraction of the tuples it returns comes from the
+ * statistics of the table if it was analyzed, otherwise from a bounded
+ * probe of the index. The sequential scan, the index scan and the bitmap
+ * scan of every index are then costed with the CostModel.
+ */
+AccessPath ChooseAccessPath(storage::DataTable *table,
+                            const std::vector<oid_t> &column_ids,
+                            const std::vector<ExpressionType> &expr_types,
+                            const std::vector<Value> &values);
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -56,6 +56,9 @@ class GroupBindingIterator : public BindingIterator {
   std::shared_ptr<OpExpression> Next() override;
 
  private:
+  // The whole expression rooted at the group, for Tree patterns
+  std::shared_ptr<OpExpression> BuildTree(GroupID id);
+
   GroupID group_id;
   std::shared_ptr<Pattern> pattern;
   Group *target_group;
@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_stats.h
+//
+// Identification: src/include/optimizer/column_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/printable.h"
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Selectivities of predicates on columns without statistics
+#define DEFAULT_EQUALITY_SELECTIVITY 0.005
+#define DEFAULT_RANGE_SELECTIVITY (1.0 / 3.0)
+
+//===--------------------------------------------------------------------===//
+// Column Stats
+//===--------------------------------------------------------------------===//
+
+/**
+ * Distribution of the values of a column: the fraction of nulls, the number
+ * of distinct values, the most common values with their frequencies and an
+ * equi-depth histogram of the other values. The frequencies are fractions
+ * of all the rows of the table, nulls included.
+ */
+class ColumnStats : public Printable {
+ public:
+  // Builds the statistics from a sample of the non null values of the
+  // column. The fraction of nulls and the distinct count are taken from all
+  // the rows of the table.
+  ColumnStats(std::vector<Value> &&sample, double null_fraction,
+              double distinct_count, size_t max_mcv_count,
+              size_t histogram_bucket_count);
+
+  double GetNullFraction() const { return null_fraction_; }
+
+  double GetDistinctCount() const { return distinct_count_; }
+
+  const std::vector<Value> &GetMostCommonValues() const { return mcvs_; }
+
+  const std::vector<double> &GetMostCommonFrequencies() const {
+    return mcv_frequencies_;
+  }
+
+  // Bounds of the buckets, each holding the same share of the values that
+  // are not among the most common ones
+  const std::vector<Value> &GetHistogramBounds() const {
+    return histogram_bounds_;
+  }
+
+  // Fraction of the rows of the table satisfying "column <compare> value"
+  double EstimateSelectivity(ExpressionType compare_type,
+                             const Value &value) const;
+
+  const std::string GetInfo() const;
+
+ private:
+  // Fraction of the rows whose value is equal to the given one
+  double EstimateEqual(const Value &value) const;
+
+  // Fraction of the rows whose value is less than the given one
+  double EstimateLess(const Value &value, bool inclusive) const;
+
+  // Fraction of the histogram values less than the given one
+  double HistogramFractionBelow(const Value &value) const;
+
+  double null_fraction_;
+
+  double distinct_count_;
+
+  std::vector<Value> mcvs_;
+
+  std::vector<double> mcv_frequencies_;
+
+  // Fraction of the rows covered by the histogram
+  double histogram_fraction_ = 0;
+
+  std::vector<Value> histogram_bounds_;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
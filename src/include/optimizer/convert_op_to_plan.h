@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "optimizer/column.h"
 #include "optimizer/op_expression.h"
 #include "expression/abstract_expression.h"
 #include "planner/abstract_plan.h"
@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cost_model.h
+//
+// Identification: src/include/optimizer/cost_model.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "optimizer/group_expression.h"
+#include "optimizer/op_expression.h"
+#include "optimizer/operator_visitor.h"
+#include "optimizer/stats.h"
+
+namespace peloton {
+namespace optimizer {
+
+class Memo;
+
+// Costs are in units of reading one tuple sequentially from memory
+#define SEQ_TUPLE_COST 1.0
+// Reading a tuple at a random location, e.g. fetching an index match
+#define RANDOM_TUPLE_COST 4.0
+// Passing a tuple on to the parent operator
+#define CPU_TUPLE_COST 0.1
+// Evaluating a predicate on a tuple or a pair of tuples
+#define CPU_OPERATOR_COST 0.025
+// Inserting a tuple into a hash table and probing it with one
+#define HASH_BUILD_COST 0.5
+#define HASH_PROBE_COST 0.25
+// Reading an index entry while scanning the matches of an index
+#define INDEX_TUPLE_COST 0.5
+
+//===--------------------------------------------------------------------===//
+// Cost Model
+//===--------------------------------------------------------------------===//
+
+/**
+ * Derives the output statistics and the cost of physical operators.
+ *
+ * An operator costs the CPU work per tuple it processes plus its memory
+ * accesses, random ones costing more than sequential ones. Cardinalities
+ * come from the table statistics of the analyzed tables, the others are
+ * assumed to hold their tuple counts and to match the default
+ * selectivities.
+ */
+class CostModel : public OperatorVisitor {
+ public:
+  CostModel(Memo *memo);
+
+  // Derive the stats and the cost of the expression from the stats and
+  // costs of the best expressions of its child groups
+  void DeriveStatsAndCost(const GroupExpression &gexpr,
+                          const std::vector<std::shared_ptr<Stats>> &child_stats,
+                          const std::vector<double> &child_costs,
+                          std::shared_ptr<Stats> &output_stats,
+                          double &output_cost);
+
+  //===--------------------------------------------------------------------===//
+  // Estimates
+  //===--------------------------------------------------------------------===//
+
+  // Stats of all the tuples of the table
+  static std::shared_ptr<Stats> GetTableStats(storage::DataTable *table);
+
+  // Fraction of the input tuples satisfying the predicate
+  static double EstimateSelectivity(const OpExpression &predicate,
+                                    const Stats &input);
+
+  // Stats of the tuples of the two sides satisfying the join predicate
+  static std::shared_ptr<Stats> EstimateJoin(const Stats &left,
+                                             const Stats &right,
+                                             const OpExpression &predicate);
+
+  // Cost of the join operators themselves, excluding their children
+  static double NLJoinCost(double outer, double inner, double output);
+
+  static double HashJoinCost(double probe, double build, double output);
+
+  // The index matches are fetched and checked against the join predicate
+  static double IndexNLJoinCost(double outer, double inner, double matches,
+                                double output);
+
+  // Cost of the scans of a table, checking their predicates on the tuples
+  // they read
+  static double SeqScanCost(double tuples);
+
+  // The index matches are fetched from the table in the order of their keys
+  static double IndexScanCost(double tuples, double matches);
+
+  // The index matches are fetched from the table in the order of their
+  // locations, each tile group they are in being visited once
+  static double BitmapScanCost(double tuples, double matches,
+                               double tile_groups);
+
+  //===--------------------------------------------------------------------===//
+  // Operators
+  //===--------------------------------------------------------------------===//
+
+  void visit(const PhysicalScan *) override;
+
+  void visit(const PhysicalComputeExprs *) override;
+
+  void visit(const PhysicalFilter *) override;
+
+  void visit(const PhysicalInnerNLJoin *) override;
+
+  void visit(const PhysicalLeftNLJoin *) override;
+
+  void visit(const PhysicalRightNLJoin *) override;
+
+  void visit(const PhysicalOuterNLJoin *) override;
+
+  void visit(const PhysicalInnerHashJoin *) override;
+
+  void visit(const PhysicalLeftHashJoin *) override;
+
+  void visit(const PhysicalRightHashJoin *) override;
+
+  void visit(const PhysicalOuterHashJoin *) override;
+
+  void visit(const PhysicalInnerIndexNLJoin *) override;
+
+ private:
+  // The predicate whose root is in the group
+  std::shared_ptr<OpExpression> GetPredicate(GroupID group_id) const;
+
+  // Stats of a join of the first two children on the third one, keeping the
+  // unmatched tuples of the outer sides
+  std::shared_ptr<Stats> DeriveJoinStats(bool keep_left, bool keep_right);
+
+  void DeriveNLJoin(bool keep_left, bool keep_right);
+
+  void DeriveHashJoin(bool keep_left, bool keep_right);
+
+  Memo *memo;
+
+  // Expression being costed
+  const GroupExpression *gexpr;
+  const std::vector<std::shared_ptr<Stats>> *child_stats;
+  const std::vector<double> *child_costs;
+
+  std::shared_ptr<Stats> output_stats;
+  double output_cost;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -26,6 +26,8 @@ namespace optimizer {
 
 using GroupID = int32_t;
 
+class Memo;
+
 //===--------------------------------------------------------------------===//
 // Group Expression
 //===--------------------------------------------------------------------===//
@@ -45,7 +47,10 @@ class GroupExpression {
 
   double GetCost() const;
 
-  void DeriveStatsAndCost(std::vector<std::shared_ptr<Stats>> child_stats,
+  // Derive the stats and the cost from those of the best expressions of the
+  // child groups, the memo holds the predicates of filters and joins
+  void DeriveStatsAndCost(Memo *memo,
+                          std::vector<std::shared_ptr<Stats>> child_stats,
                           std::vector<double> child_costs);
 
   hash_t Hash() const;
@@ -58,7 +63,7 @@ class GroupExpression {
   std::vector<GroupID> child_groups;
 
   std::shared_ptr<Stats> stats;
-  double cost;
+  double cost = 0;
 };
 
 } /* namespace optimizer */
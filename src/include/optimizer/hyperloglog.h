@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.h
+//
+// Identification: src/include/optimizer/hyperloglog.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace peloton {
+
+class Value;
+
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// HyperLogLog
+//===--------------------------------------------------------------------===//
+
+/**
+ * Sketch of the number of distinct values added to it, kept in 2^precision
+ * registers of a byte each. The relative error of the estimate is about
+ * 1.04 / sqrt(2^precision), 1.6% with the default precision.
+ */
+class HyperLogLog {
+ public:
+  explicit HyperLogLog(uint8_t precision = 12);
+
+  void AddValue(const Value &value);
+
+  // The hash has to be well mixed, all of its bits are used
+  void AddHash(uint64_t hash);
+
+  // Adds the values of a sketch of the same precision
+  void Merge(const HyperLogLog &other);
+
+  double Estimate() const;
+
+ private:
+  uint8_t precision_;
+
+  std::vector<uint8_t> registers_;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_enumerator.h
+//
+// Identification: src/include/optimizer/join_enumerator.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "optimizer/column.h"
+#include "optimizer/op_expression.h"
+#include "optimizer/stats.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Join graphs of more relations are joined greedily, the number of join
+// trees to enumerate grows exponentially with it
+#define DP_JOIN_RELATION_LIMIT 10
+
+//===--------------------------------------------------------------------===//
+// Join Enumerator
+//===--------------------------------------------------------------------===//
+
+/**
+ * Orders the inner joins of an operator tree by their estimated cost.
+ *
+ * A tree of inner joins, along with a filter right above it, is flattened
+ * into its relations and the terms of its predicates. Terms on a single
+ * relation are pushed down onto it and the others are the edges of the join
+ * graph. Small graphs get their cheapest join tree by dynamic programming
+ * over the pairs of connected subgraphs and their connected complements
+ * (DPccp), larger ones are joined greedily, smallest result first. A join
+ * costs the cheapest of its nested loop, hash and index nested loop joins.
+ *
+ * The memo still chooses the join algorithms and the sides of every join.
+ */
+class JoinEnumerator {
+ public:
+  static std::shared_ptr<OpExpression> ReorderJoins(
+      std::shared_ptr<OpExpression> expr);
+
+ private:
+  // Set of relations of the join graph, one bit per relation
+  typedef uint64_t RelationSet;
+
+  // Cheapest join tree of a set of relations
+  struct JoinPlan {
+    std::shared_ptr<OpExpression> expr;
+    std::shared_ptr<Stats> stats;
+    double cost;
+  };
+
+  JoinEnumerator() {}
+
+  // Order the join graph of the inner joins under expr, the terms being
+  // those of a filter above them
+  std::shared_ptr<OpExpression> OrderJoinGraph(
+      std::shared_ptr<OpExpression> expr,
+      std::vector<std::shared_ptr<OpExpression>> terms);
+
+  void FlattenJoins(std::shared_ptr<OpExpression> expr,
+                    std::vector<std::shared_ptr<OpExpression>> &terms);
+
+  // Estimated output and cost of an operator tree that is not reordered
+  static JoinPlan EstimatePlan(std::shared_ptr<OpExpression> expr);
+
+  // Columns the operator tree outputs
+  static std::vector<Column *> GetOutputColumns(const OpExpression &expr);
+
+  //===--------------------------------------------------------------------===//
+  // Join graph
+  //===--------------------------------------------------------------------===//
+
+  // Relations adjacent to the set, outside of it
+  RelationSet GetNeighbors(RelationSet relation_set) const;
+
+  // Terms on both sets and no other relation
+  std::vector<std::shared_ptr<OpExpression>> GetJoinTerms(
+      RelationSet left, RelationSet right) const;
+
+  // Cheapest join of the left plan as the outer side with the right one
+  JoinPlan MakeJoin(const JoinPlan &left, RelationSet left_set,
+                    const JoinPlan &right, RelationSet right_set) const;
+
+  // Keep the cheaper of the two joins of the sets as the best plan of their
+  // union
+  void ConsiderJoins(RelationSet left_set, RelationSet right_set);
+
+  //===--------------------------------------------------------------------===//
+  // Enumeration
+  //===--------------------------------------------------------------------===//
+
+  void EnumerateCsg();
+
+  void EnumerateCsgRec(RelationSet subgraph, RelationSet excluded);
+
+  void EmitCsg(RelationSet subgraph);
+
+  void EnumerateCmpRec(RelationSet subgraph, RelationSet complement,
+                       RelationSet excluded);
+
+  void EmitCsgCmp(RelationSet subgraph, RelationSet complement);
+
+  // Join the connected components of the graph, smallest first
+  JoinPlan JoinComponents();
+
+  JoinPlan JoinGreedily();
+
+  std::vector<std::shared_ptr<OpExpression>> relations;
+  std::vector<std::vector<Column *>> relation_columns;
+  std::vector<RelationSet> neighbors;
+
+  // Terms on more than one relation and the relations they are on
+  std::vector<std::pair<RelationSet, std::shared_ptr<OpExpression>>>
+      join_terms;
+
+  // Pairs of connected subgraphs with connected complements, in the order
+  // they are found
+  std::vector<std::pair<RelationSet, RelationSet>> csg_cmp_pairs;
+
+  std::unordered_map<RelationSet, JoinPlan> best_plans;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -49,6 +49,7 @@ enum class OpType {
   LeftHashJoin,
   RightHashJoin,
   OuterHashJoin,
+  InnerIndexNLJoin,
   // Exprs
   Variable,
   Constant,
@@ -47,6 +47,7 @@ class OperatorVisitor {
   virtual void visit(const PhysicalLeftHashJoin *);
   virtual void visit(const PhysicalRightHashJoin *);
   virtual void visit(const PhysicalOuterHashJoin *);
+  virtual void visit(const PhysicalInnerIndexNLJoin *);
   virtual void visit(const ExprVariable *);
   virtual void visit(const ExprConstant *);
   virtual void visit(const ExprCompare *);
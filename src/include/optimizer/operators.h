@@ -208,6 +208,33 @@ class PhysicalOuterHashJoin : public OperatorNode<PhysicalOuterHashJoin> {
   static Operator make();
 };
 
+//===--------------------------------------------------------------------===//
+// InnerIndexNLJoin
+//===--------------------------------------------------------------------===//
+
+// Probes an index of the inner table with every outer tuple. The children
+// are the outer side and the join predicate, the inner table is scanned
+// through the index only.
+class PhysicalInnerIndexNLJoin
+    : public OperatorNode<PhysicalInnerIndexNLJoin> {
+ public:
+  static Operator make(storage::DataTable *table, std::vector<Column *> cols,
+                       oid_t index_offset, Column *inner_key_column,
+                       Column *outer_key_column);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  storage::DataTable *table;
+  std::vector<Column *> columns;
+  // Index of the inner table whose leading key column is inner_key_column
+  oid_t index_offset;
+  Column *inner_key_column;
+  // Column of the outer side equal to inner_key_column
+  Column *outer_key_column;
+};
+
 //===--------------------------------------------------------------------===//
 // Variable
 //===--------------------------------------------------------------------===//
@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.h
+//
+// Identification: src/include/optimizer/plan_cache.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/statement.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+}
+
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// Cached Plan
+//===--------------------------------------------------------------------===//
+
+/**
+ * Plan template of a query fingerprint, shared by all connections.
+ *
+ * A plan tree serves one statement at a time : a statement keeps the
+ * executor tree of its last execution over it. The template keeps the idle
+ * instances of its plan and lends them out, an instance goes back to the
+ * template once the last reference to it is released.
+ */
+class CachedPlan : public std::enable_shared_from_this<CachedPlan> {
+ public:
+  CachedPlan(const CachedPlan &) = delete;
+  CachedPlan &operator=(const CachedPlan &) = delete;
+
+  CachedPlan(const std::string &fingerprint,
+             const std::vector<FieldInfoType> &tuple_descriptor);
+
+  // A fingerprint whose parameterized form can't be planned
+  explicit CachedPlan(const std::string &fingerprint);
+
+  const std::string &GetFingerprint() const { return fingerprint_; }
+
+  const std::vector<FieldInfoType> &GetTupleDescriptor() const {
+    return tuple_descriptor_;
+  }
+
+  // false if the queries of the fingerprint have to be planned one by one
+  bool IsParameterized() const { return parameterized_; }
+
+  // An idle instance of the plan, nullptr if all of them are in use
+  std::shared_ptr<planner::AbstractPlan> Acquire();
+
+  // Lend out a new instance of the plan, it is kept once released
+  std::shared_ptr<planner::AbstractPlan> Lend(
+      const std::shared_ptr<planner::AbstractPlan> &instance);
+
+  // Drop the instances, e.g. once the tables they refer to changed
+  void Invalidate();
+
+ private:
+  void Release(const std::shared_ptr<planner::AbstractPlan> &instance);
+
+  const std::string fingerprint_;
+
+  const std::vector<FieldInfoType> tuple_descriptor_;
+
+  const bool parameterized_;
+
+  std::mutex instances_lock_;
+
+  std::vector<std::shared_ptr<planner::AbstractPlan>> idle_instances_;
+
+  bool invalidated_ = false;
+};
+
+//===--------------------------------------------------------------------===//
+// Plan Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * Process-wide cache of plan templates keyed by query fingerprint : the
+ * query with its literals replaced by parameters ($1, $2, ...), so all the
+ * instances of a statement shape share one plan. Split into independently
+ * locked LRU shards.
+ */
+class PlanCache {
+ public:
+  PlanCache(const PlanCache &) = delete;
+  PlanCache &operator=(const PlanCache &) = delete;
+
+  // Holds up to FLAGS_plan_cache_size templates
+  static PlanCache &GetInstance();
+
+  explicit PlanCache(size_t capacity);
+
+  /* Get the fingerprint of a query and its literals, in the order of their
+   * parameters. Queries which have parameters of their own ($1, ...) keep
+   * their literals, their fingerprint is just the normalized query. Returns
+   * false for queries that are not cached : anything but SELECT, INSERT,
+   * UPDATE and DELETE. */
+  static bool Fingerprint(const std::string &query, std::string &fingerprint,
+                          std::vector<Value> &literals);
+
+  // The template of the fingerprint, nullptr on a miss
+  std::shared_ptr<CachedPlan> Find(const std::string &fingerprint);
+
+  // Add a template, evicting the least recently used one of its shard
+  void Insert(const std::shared_ptr<CachedPlan> &plan);
+
+  // Drop every template, plans may refer to tables that changed
+  void Clear();
+
+  // Account the time taken to plan a miss
+  void RecordPlanning(double duration_us);
+
+  //===--------------------------------------------------------------------===//
+  // Metrics
+  //===--------------------------------------------------------------------===//
+
+  size_t GetSize() const;
+
+  uint64_t GetHitCount() const { return hit_count_; }
+
+  uint64_t GetMissCount() const { return miss_count_; }
+
+  double GetHitRate() const;
+
+  uint64_t GetEvictionCount() const { return eviction_count_; }
+
+  uint64_t GetPlanningCount() const { return planning_count_; }
+
+  // Total time spent planning, in microseconds
+  uint64_t GetPlanningTime() const { return planning_time_us_; }
+
+  const std::string GetInfo() const;
+
+ private:
+  static const size_t shard_count = 16;
+
+  struct Shard {
+    mutable std::mutex lock;
+
+    // fingerprints, most recently used first
+    std::list<std::string> lru;
+
+    std::unordered_map<std::string,
+                       std::pair<std::shared_ptr<CachedPlan>,
+                                 std::list<std::string>::iterator>> plans;
+  };
+
+  Shard &GetShard(const std::string &fingerprint);
+
+  size_t shard_capacity_;
+
+  Shard shards_[shard_count];
+
+  std::atomic<uint64_t> hit_count_;
+
+  std::atomic<uint64_t> miss_count_;
+
+  std::atomic<uint64_t> eviction_count_;
+
+  std::atomic<uint64_t> planning_count_;
+
+  std::atomic<uint64_t> planning_time_us_;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
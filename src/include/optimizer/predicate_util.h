@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// predicate_util.h
+//
+// Identification: src/include/optimizer/predicate_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "optimizer/column.h"
+#include "optimizer/op_expression.h"
+#include "storage/data_table.h"
+
+#include <memory>
+#include <vector>
+
+namespace peloton {
+namespace optimizer {
+
+// Terms of a conjunction, the predicate itself if it is no AND
+std::vector<std::shared_ptr<OpExpression>> SplitConjunction(
+    std::shared_ptr<OpExpression> predicate);
+
+// AND of the terms, the constant true if there are none
+std::shared_ptr<OpExpression> MakeConjunction(
+    const std::vector<std::shared_ptr<OpExpression>> &terms);
+
+// Add the columns the predicate refers to
+void GetPredicateColumns(const OpExpression &predicate,
+                         std::vector<Column *> &columns);
+
+// Whether the term is "column = column" on columns of two different tables
+bool IsEquiJoinTerm(const OpExpression &term, Column *&left_column,
+                    Column *&right_column);
+
+// Whether any term of the predicate is an equi-join term
+bool HasEquiJoinTerm(std::shared_ptr<OpExpression> predicate);
+
+// Find an index of the table whose leading key column, one of the given
+// columns of the table, is equal to a column of another table in the
+// predicate
+bool FindJoinIndex(storage::DataTable *table,
+                   const std::vector<Column *> &table_columns,
+                   std::shared_ptr<OpExpression> predicate,
+                   oid_t &index_offset, Column *&inner_key_column,
+                   Column *&outer_key_column);
+
+} /* namespace optimizer */
+} /* namespace peloton */
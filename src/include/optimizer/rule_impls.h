@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "optimizer/column.h"
 #include "optimizer/rule.h"
 
 #include <memory>
@@ -176,5 +177,29 @@ class OuterJoinToOuterHashJoin : public Rule {
       std::vector<std::shared_ptr<OpExpression>> &transformed) const override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerIndexNLJoin
+class InnerJoinToInnerIndexNLJoin : public Rule {
+ public:
+  // Whether the inner table is matched under a filter, which then becomes
+  // part of the join predicate
+  InnerJoinToInnerIndexNLJoin(bool filtered_inner);
+
+  bool Check(std::shared_ptr<OpExpression> plan) const override;
+
+  void Transform(
+      std::shared_ptr<OpExpression> input,
+      std::vector<std::shared_ptr<OpExpression>> &transformed) const override;
+
+ private:
+  // Find an index of the inner table whose leading key column is equal to an
+  // outer column in the join predicate
+  bool FindJoinIndex(std::shared_ptr<OpExpression> plan, oid_t &index_offset,
+                     Column *&inner_key_column,
+                     Column *&outer_key_column) const;
+
+  bool filtered_inner;
+};
+
 } /* namespace optimizer */
 } /* namespace peloton */
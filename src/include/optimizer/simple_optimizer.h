@@ -80,6 +80,12 @@ class SimpleOptimizer : public AbstractOptimizer {
   static std::unique_ptr<planner::AbstractScan> CreateScanPlan(
       storage::DataTable *target_table, parser::SelectStatement *select_stmt);
 
+  // find the index of the inner table of a join that can be probed for every
+  // outer tuple, INVALID_OID if there is none
+  static oid_t GetJoinIndex(storage::DataTable *inner_table,
+                            oid_t join_column_id,
+                            const std::vector<oid_t> &bound_column_ids);
+
   static std::unique_ptr<planner::AbstractPlan> CreateHackingJoinPlan();
 };
 }  // namespace optimizer
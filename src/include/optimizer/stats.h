@@ -13,7 +13,11 @@
 
 #pragma once
 
-#include "optimizer/tuple_sample.h"
+#include <map>
+#include <memory>
+
+#include "optimizer/column.h"
+#include "optimizer/table_stats.h"
 
 namespace peloton {
 namespace optimizer {
@@ -21,12 +25,30 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 // Stats
 //===--------------------------------------------------------------------===//
+
+// Statistics derived for the output of a group expression
 class Stats {
  public:
-  Stats(TupleSample *sample);
+  Stats(double cardinality);
+
+  // Estimated number of output rows
+  double GetCardinality() const { return cardinality; }
+
+  // Statistics of a base table whose columns are in the output
+  void AddTableStats(oid_t table_oid,
+                     std::shared_ptr<const TableStats> table_stats);
+
+  // Add the tables of the other output, for joins
+  void AddTableStats(const Stats &other);
+
+  // Statistics of a base table column of the output, nullptr if the table
+  // was never analyzed or the column is computed
+  const ColumnStats *GetColumnStats(const Column *column) const;
 
  private:
-  TupleSample *sample;
+  double cardinality;
+
+  std::map<oid_t, std::shared_ptr<const TableStats>> table_stats;
 };
 
 } /* namespace optimizer */
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_collector.h
+//
+// Identification: src/include/optimizer/stats_collector.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace optimizer {
+
+class TableStats;
+
+//===--------------------------------------------------------------------===//
+// Stats Collector
+//===--------------------------------------------------------------------===//
+
+/**
+ * Computes the statistics of tables, for ANALYZE and in the background once
+ * enough of a table changed since its last analyze.
+ *
+ * An analyze makes a single pass over the tile groups of the table. The
+ * null counts and the distinct count sketches see every visible tuple, the
+ * histograms and the most common values are built from a reservoir sample.
+ */
+class StatsCollector {
+ public:
+  StatsCollector(const StatsCollector &) = delete;
+  StatsCollector &operator=(const StatsCollector &) = delete;
+  StatsCollector(StatsCollector &&) = delete;
+  StatsCollector &operator=(StatsCollector &&) = delete;
+
+  StatsCollector();
+
+  ~StatsCollector();
+
+  // Singleton
+  static StatsCollector &GetInstance();
+
+  // Analyze the tuples visible to the transaction, the statistics are
+  // stored in the table
+  std::shared_ptr<const TableStats> Analyze(storage::DataTable *table,
+                                            concurrency::Transaction *txn);
+
+  // Whether enough tuples changed since the table was last analyzed
+  bool NeedsAnalyze(storage::DataTable *table) const;
+
+  // Start analyzing in the background
+  void Start();
+
+  // Stop analyzing in the background
+  void Stop();
+
+  // Add table to list of tables analyzed in the background
+  void AddTable(storage::DataTable *table);
+
+  // Remove table from the list, waits for its analyze to finish
+  void RemoveTable(storage::DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+ protected:
+  // Analyze the tables that need it till stopped
+  void AutoAnalyze();
+
+ private:
+  // Tables analyzed in the background
+  std::vector<storage::DataTable *> tables;
+
+  // Held while going over the tables
+  std::mutex stats_collector_mutex;
+
+  // Stop signal
+  std::atomic<bool> auto_analyze_stop;
+
+  std::mutex auto_analyze_stop_mutex;
+
+  std::condition_variable auto_analyze_stop_condition;
+
+  // Analyze thread
+  std::thread auto_analyze_thread;
+
+  //===--------------------------------------------------------------------===//
+  // Collector Parameters
+  //===--------------------------------------------------------------------===//
+
+  // # of tuples sampled for the histograms and most common values
+  size_t sample_size = 30000;
+
+  // # of most common values kept per column
+  size_t max_mcv_count = 20;
+
+  // # of histogram buckets per column
+  size_t histogram_bucket_count = 100;
+
+  // Sleeping period (in ms)
+  oid_t sleep_duration = 1000;
+
+  // A table is analyzed again once more than analyze_threshold +
+  // analyze_scale_factor * (# of tuples) tuple versions changed
+  size_t analyze_threshold = 50;
+
+  double analyze_scale_factor = 0.1;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.h
+//
+// Identification: src/include/optimizer/table_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "optimizer/column_stats.h"
+
+namespace peloton {
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// Table Stats
+//===--------------------------------------------------------------------===//
+
+/**
+ * Statistics of a table as of its last ANALYZE. They are immutable, a new
+ * analyze replaces them as a whole.
+ */
+class TableStats : public Printable {
+ public:
+  TableStats(size_t tuple_count, size_t modification_count,
+             std::vector<ColumnStats> &&column_stats);
+
+  // Number of tuples visible to the analyze
+  size_t GetTupleCount() const { return tuple_count_; }
+
+  // Modification count of the table when it was analyzed
+  size_t GetModificationCount() const { return modification_count_; }
+
+  oid_t GetColumnCount() const { return column_stats_.size(); }
+
+  const ColumnStats &GetColumnStats(oid_t column_id) const;
+
+  // Fraction of the tuples satisfying "column <compare> value"
+  double EstimateSelectivity(oid_t column_id, ExpressionType compare_type,
+                             const Value &value) const;
+
+  const std::string GetInfo() const;
+
+ private:
+  size_t tuple_count_;
+
+  size_t modification_count_;
+
+  std::vector<ColumnStats> column_stats_;
+};
+
+}  // End optimizer namespace
+}  // End peloton namespace
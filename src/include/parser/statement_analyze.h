@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// statement_analyze.h
+//
+// Identification: src/include/parser/statement_analyze.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parser/sql_statement.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct AnalyzeStatement
+ * @brief Represents "ANALYZE [table]"
+ */
+struct AnalyzeStatement : SQLStatement {
+  AnalyzeStatement()
+      : SQLStatement(STATEMENT_TYPE_ANALYZE), table_name(NULL){};
+
+  virtual ~AnalyzeStatement() { free(table_name); }
+
+  // NULL analyzes every table of the database
+  char* table_name;
+};
+
+}  // End parser namespace
+}  // End peloton namespace
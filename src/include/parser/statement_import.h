@@ -39,6 +39,7 @@ struct ImportStatement : SQLStatement {
   }
 
   ImportType type;
+  // NULL for COPY ... FROM STDIN, the rows then come from the client
   char* file_path;
   char* table_name;
 };
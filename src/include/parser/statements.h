@@ -24,3 +24,4 @@
 #include "parser/statement_transaction.h"
 #include "parser/statement_update.h"
 #include "parser/statement_import.h"
+#include "parser/statement_analyze.h"
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_plan.h
+//
+// Identification: src/include/planner/analyze_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "planner/abstract_plan.h"
+#include "parser/statement_analyze.h"
+
+namespace peloton {
+namespace storage {
+class DataTable;
+}
+
+namespace planner {
+
+/**
+ * Computes the statistics of a table (ANALYZE t), or of every table of the
+ * database (ANALYZE).
+ */
+class AnalyzePlan : public AbstractPlan {
+ public:
+  AnalyzePlan() = delete;
+  AnalyzePlan(const AnalyzePlan &) = delete;
+  AnalyzePlan &operator=(const AnalyzePlan &) = delete;
+  AnalyzePlan(AnalyzePlan &&) = delete;
+  AnalyzePlan &operator=(AnalyzePlan &&) = delete;
+
+  // A null table analyzes every table of the database
+  explicit AnalyzePlan(storage::DataTable *table);
+
+  explicit AnalyzePlan(parser::AnalyzeStatement *parse_tree);
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_ANALYZE;
+  }
+
+  const std::string GetInfo() const {
+    std::string returned_string = "AnalyzePlan:\n";
+    returned_string += "\tTable name: " + table_name_ + "\n";
+    return returned_string;
+  }
+
+  void SetParameterValues(UNUSED_ATTRIBUTE std::vector<Value> *values){};
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    auto new_plan = new AnalyzePlan(target_table_);
+    new_plan->table_name_ = table_name_;
+    return std::unique_ptr<AbstractPlan>(new_plan);
+  }
+
+  storage::DataTable *GetTable() const { return target_table_; }
+
+  // Empty when every table is analyzed
+  const std::string &GetTableName() const { return table_name_; }
+
+ private:
+  // Target Table
+  storage::DataTable *target_table_ = nullptr;
+  std::string table_name_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_plan.h
+//
+// Identification: src/include/planner/exchange_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/abstract_plan.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace planner {
+
+/**
+ * Runs its only child on several worker threads and gathers their tiles.
+ *
+ * The child is a chain of operators with a single input each over a
+ * sequential scan of a table. Every worker executes its own copy of the
+ * chain in the transaction of the query, and the scans of the workers share
+ * a cursor over the tile groups of the table, so each tile group (morsel) is
+ * scanned by exactly one of them. Tiles are returned in no particular order.
+ */
+class ExchangePlan : public AbstractPlan {
+ public:
+  ExchangePlan(const ExchangePlan &) = delete;
+  ExchangePlan &operator=(const ExchangePlan &) = delete;
+  ExchangePlan(ExchangePlan &&) = delete;
+  ExchangePlan &operator=(ExchangePlan &&) = delete;
+
+  explicit ExchangePlan(size_t degree_of_parallelism)
+      : degree_of_parallelism_(degree_of_parallelism) {
+    PL_ASSERT(degree_of_parallelism_ > 0);
+  }
+
+  // Number of workers running the child
+  size_t GetDegreeOfParallelism() const { return degree_of_parallelism_; }
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_EXCHANGE;
+  }
+
+  const std::string GetInfo() const { return "Exchange"; }
+
+  void SetParameterValues(std::vector<Value> *values) {
+    for (auto &child_plan : GetChildren()) {
+      child_plan->SetParameterValues(values);
+    }
+  }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    return std::unique_ptr<AbstractPlan>(
+        new ExchangePlan(degree_of_parallelism_));
+  }
+
+ private:
+  const size_t degree_of_parallelism_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_plan.h
+//
+// Identification: src/include/planner/import_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "planner/abstract_plan.h"
+#include "parser/statement_import.h"
+
+namespace peloton {
+namespace storage {
+class DataTable;
+}
+
+namespace planner {
+
+/**
+ * Bulk load of a table from a delimited file (IMPORT, COPY ... FROM), or
+ * from the rows the client sends for COPY ... FROM STDIN.
+ */
+class ImportPlan : public AbstractPlan {
+ public:
+  ImportPlan() = delete;
+  ImportPlan(const ImportPlan &) = delete;
+  ImportPlan &operator=(const ImportPlan &) = delete;
+  ImportPlan(ImportPlan &&) = delete;
+  ImportPlan &operator=(ImportPlan &&) = delete;
+
+  // An empty file path reads the rows given with SetInput()
+  ImportPlan(storage::DataTable *table, const std::string &file_path,
+             parser::ImportStatement::ImportType import_type);
+
+  explicit ImportPlan(parser::ImportStatement *parse_tree);
+
+  inline PlanNodeType GetPlanNodeType() const { return PLAN_NODE_TYPE_IMPORT; }
+
+  const std::string GetInfo() const {
+    std::string returned_string = "ImportPlan:\n";
+    returned_string += "\tTable name: " + table_name_ + "\n";
+    returned_string +=
+        "\tFile: " + (IsFromStdin() ? std::string("STDIN") : file_path_) + "\n";
+    return returned_string;
+  }
+
+  void SetParameterValues(UNUSED_ATTRIBUTE std::vector<Value> *values){};
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    return std::unique_ptr<AbstractPlan>(
+        new ImportPlan(target_table_, file_path_, import_type_));
+  }
+
+  storage::DataTable *GetTable() const { return target_table_; }
+
+  const std::string &GetTableName() const { return table_name_; }
+
+  const std::string &GetFilePath() const { return file_path_; }
+
+  bool IsFromStdin() const { return file_path_.empty(); }
+
+  parser::ImportStatement::ImportType GetImportType() const {
+    return import_type_;
+  }
+
+  // The rows of COPY ... FROM STDIN, as sent by the client
+  void SetInput(std::string &&input) { input_ = std::move(input); }
+
+  const std::string &GetInput() const { return input_; }
+
+ private:
+  // Target Table
+  storage::DataTable *target_table_ = nullptr;
+  std::string table_name_;
+
+  std::string file_path_;
+
+  parser::ImportStatement::ImportType import_type_;
+
+  std::string input_;
+};
+
+}  // namespace planner
+}  // namespace peloton
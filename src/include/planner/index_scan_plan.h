@@ -119,6 +119,47 @@ class IndexScanPlan : public AbstractScan {
 
   const std::vector<oid_t> &GetKeyColumnIds() const { return key_column_ids_; }
 
+  // Whether the columns the scan returns and the columns its predicate
+  // reads are all kept in the keys of the index
+  bool IsCoveredByIndex() const { return covered_by_index_; }
+
+  // An index only scan is answered from the index entries wherever they
+  // are known to hold the version the transaction sees. Its tiles are not
+  // backed by the table, so it is only meant for scans whose rows are not
+  // modified (e.g. not below an update or a delete).
+  bool IsIndexOnly() const { return index_only_; }
+
+  void SetIndexOnly(bool index_only) {
+    PL_ASSERT(index_only == false || covered_by_index_ == true);
+    index_only_ = index_only;
+  }
+
+  // A bitmap scan reads the table matches of the index in the order of
+  // their locations rather than of their keys, so every tile group is
+  // visited once and front to back. It pays off when the matches are too
+  // many for random lookups but too few for a sequential scan. The result
+  // is not in key order.
+  bool IsBitmapScan() const { return bitmap_scan_; }
+
+  void SetBitmapScan(bool bitmap_scan) { bitmap_scan_ = bitmap_scan; }
+
+  // The direction the index is scanned in. The rows are not returned in
+  // key order either way, but a scan with a limit returns the first rows
+  // in that direction.
+  ScanDirectionType GetScanDirection() const { return scan_direction_; }
+
+  void SetScanDirection(ScanDirectionType scan_direction) {
+    scan_direction_ = scan_direction;
+  }
+
+  // The number of rows a LIMIT above the scan reads, offset included, or 0
+  // for all of them. The scan returns at least the first limit rows the
+  // transaction sees, if there are as many, and leaves the LIMIT to drop
+  // the others.
+  size_t GetLimit() const { return limit_; }
+
+  void SetLimit(size_t limit) { limit_ = limit; }
+
   const std::vector<ExpressionType> &GetExprTypes() const {
     return expr_types_;
   }
@@ -129,6 +170,11 @@ class IndexScanPlan : public AbstractScan {
 
   const std::vector<Value> &GetValues() const { return values_; }
 
+  // Values before binding, parameters are VALUE_TYPE_PARAMETER_OFFSET
+  const std::vector<Value> &GetValuesWithParams() const {
+    return values_with_params_;
+  }
+
   const std::vector<expression::AbstractExpression *> &GetRunTimeKeys() const {
     return runtime_keys_;
   }
@@ -151,6 +197,10 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc);
+    new_plan->SetIndexOnly(index_only_);
+    new_plan->SetBitmapScan(bitmap_scan_);
+    new_plan->SetScanDirection(scan_direction_);
+    new_plan->SetLimit(limit_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -189,6 +239,16 @@ class IndexScanPlan : public AbstractScan {
   // In the future this might be extended into an array of conjunctive
   // predicates connected by disjunction
   index::IndexScanPredicate index_predicate_;
+
+  bool covered_by_index_ = false;
+
+  bool index_only_ = false;
+
+  bool bitmap_scan_ = false;
+
+  ScanDirectionType scan_direction_ = SCAN_DIRECTION_TYPE_FORWARD;
+
+  size_t limit_ = 0;
 };
 
 }  // namespace planner
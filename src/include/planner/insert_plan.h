@@ -75,6 +75,15 @@ class InsertPlan : public AbstractPlan {
 
   const storage::Tuple *GetTuple() const { return tuple_.get(); }
 
+  // <tuple_column_index, parameter_index>, nullptr without parameters
+  const std::vector<std::pair<oid_t, oid_t>> *GetParameterVector() const {
+    return parameter_vector_.get();
+  }
+
+  const std::vector<ValueType> *GetParamsValueType() const {
+    return params_value_type_.get();
+  }
+
   const std::string GetInfo() const { return "InsertPlan"; }
 
   std::unique_ptr<AbstractPlan> Copy() const {
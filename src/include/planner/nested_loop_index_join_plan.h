@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_index_join_plan.h
+//
+// Identification: src/include/planner/nested_loop_index_join_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/abstract_join_plan.h"
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace planner {
+
+/**
+ * Nested loop join that probes an index of the inner table with the keys of
+ * every outer tuple instead of scanning the inner side.
+ *
+ * The plan has a single child, the outer side. Each key column of the inner
+ * index is compared either with a column of the outer tile or with a value,
+ * which may be a parameter. The join predicate sees the outer tuple as its
+ * left tuple and the whole inner table tuple as its right one, so it can
+ * refer to inner columns that are not part of the output. Only inner and
+ * left joins are supported, the inner side is never enumerated.
+ */
+class NestedLoopIndexJoinPlan : public AbstractJoinPlan {
+ public:
+  NestedLoopIndexJoinPlan(const NestedLoopIndexJoinPlan &) = delete;
+  NestedLoopIndexJoinPlan &operator=(const NestedLoopIndexJoinPlan &) = delete;
+  NestedLoopIndexJoinPlan(NestedLoopIndexJoinPlan &&) = delete;
+  NestedLoopIndexJoinPlan &operator=(NestedLoopIndexJoinPlan &&) = delete;
+
+  NestedLoopIndexJoinPlan(
+      PelotonJoinType join_type,
+      std::unique_ptr<const expression::AbstractExpression> &&predicate,
+      std::unique_ptr<const ProjectInfo> &&proj_info,
+      std::shared_ptr<const catalog::Schema> &proj_schema,
+      storage::DataTable *inner_table,
+      const std::vector<oid_t> &inner_column_ids,
+      std::shared_ptr<index::Index> inner_index,
+      const std::vector<oid_t> &key_column_ids,
+      const std::vector<ExpressionType> &expr_types,
+      const std::vector<Value> &values,
+      const std::vector<oid_t> &outer_column_ids);
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_NESTLOOPINDEX;
+  }
+
+  const std::string GetInfo() const { return "NestedLoopIndexJoin"; }
+
+  void SetParameterValues(std::vector<Value> *values);
+
+  storage::DataTable *GetInnerTable() const { return inner_table_; }
+
+  // Columns of the inner table in the inner tile of the join
+  const std::vector<oid_t> &GetInnerColumnIds() const {
+    return inner_column_ids_;
+  }
+
+  std::shared_ptr<index::Index> GetIndex() const { return index_; }
+
+  const std::vector<oid_t> &GetKeyColumnIds() const { return key_column_ids_; }
+
+  const std::vector<ExpressionType> &GetExprTypes() const {
+    return expr_types_;
+  }
+
+  // Values of the keys that are not taken from the outer tile, parameters
+  // are VALUE_TYPE_PARAMETER_OFFSET
+  const std::vector<Value> &GetValues() const { return values_; }
+
+  // Column of the outer tile each key is probed with, INVALID_OID when the
+  // key is compared with its value instead
+  const std::vector<oid_t> &GetOuterColumnIds() const {
+    return outer_column_ids_;
+  }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    std::unique_ptr<const expression::AbstractExpression> predicate_copy(
+        GetPredicate() != nullptr ? GetPredicate()->Copy() : nullptr);
+    std::unique_ptr<const ProjectInfo> proj_info_copy(
+        GetProjInfo() != nullptr ? GetProjInfo()->Copy() : nullptr);
+    std::shared_ptr<const catalog::Schema> schema_copy(
+        catalog::Schema::CopySchema(GetSchema()));
+    NestedLoopIndexJoinPlan *new_plan = new NestedLoopIndexJoinPlan(
+        GetJoinType(), std::move(predicate_copy), std::move(proj_info_copy),
+        schema_copy, inner_table_, inner_column_ids_, index_, key_column_ids_,
+        expr_types_, values_, outer_column_ids_);
+    return std::unique_ptr<AbstractPlan>(new_plan);
+  }
+
+ private:
+  storage::DataTable *inner_table_;
+
+  const std::vector<oid_t> inner_column_ids_;
+
+  std::shared_ptr<index::Index> index_;
+
+  const std::vector<oid_t> key_column_ids_;
+
+  const std::vector<ExpressionType> expr_types_;
+
+  const std::vector<Value> values_;
+
+  const std::vector<oid_t> outer_column_ids_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -29,6 +29,10 @@
 
 extern LayoutType peloton_layout_mode;
 
+// One in every peloton_sample_rate accesses of a table is sampled for the
+// tuners of the brain, none if it is zero
+extern int peloton_sample_rate;
+
 //===--------------------------------------------------------------------===//
 // Configuration Variables
 //===--------------------------------------------------------------------===//
@@ -37,10 +41,18 @@ extern std::vector<peloton::oid_t> sdbench_column_ids;
 
 const int ACTIVE_TILEGROUP_COUNT = 1;
 
+// Tile groups of an index added online built at a time, and the pause (in
+// us) after each one that keeps the build from starving the writers
+#define INDEX_BUILD_TILE_GROUP_COUNT 50
+#define INDEX_BUILD_SLEEP_DURATION 10
+
 namespace peloton {
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
+template <typename T>
+class LockFreeQueue;
+
 namespace brain {
 class Sample;
 }
@@ -57,6 +69,10 @@ namespace logging {
 class LogManager;
 }
 
+namespace optimizer {
+class TableStats;
+}
+
 namespace concurrency {
 class Transaction;
 }
@@ -65,6 +81,7 @@ namespace storage {
 
 class Tuple;
 class TileGroup;
+class Dictionary;
 
 //===--------------------------------------------------------------------===//
 // DataTable
@@ -139,12 +156,35 @@ class DataTable : public AbstractTable {
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
 
+  // Get a tile group with the layout of the table's new tile groups
+  TileGroup *GetTileGroupWithDefaultLayout();
+
+  // Append a tile group filled by a bulk load. Unlike AddTileGroup, it is not
+  // made active : inserts never claim its remaining slots
+  void AppendTileGroup(const std::shared_ptr<TileGroup> &tile_group);
+
   //===--------------------------------------------------------------------===//
   // INDEX
   //===--------------------------------------------------------------------===//
 
   void AddIndex(std::shared_ptr<index::Index> index);
 
+  // Adds an index without blocking the writers. They maintain it from now
+  // on, but the scans only read it once BuildIndex has indexed the tuples
+  // already in the table.
+  void AddIndexOnline(std::shared_ptr<index::Index> index);
+
+  // Indexes up to tile_group_count tile groups of an index added online,
+  // from the first one it has not indexed yet, split across thread_count
+  // threads that sleep sleep_duration us after each tile group. Returns
+  // true once the index is readable, or for a unique index, which is left
+  // unreadable since the writers do not maintain it. Entries are inserted
+  // conditionally, not bulk loaded, since writers may have added some of
+  // them already.
+  bool BuildIndex(const std::shared_ptr<index::Index> &index,
+                  oid_t tile_group_count, size_t thread_count,
+                  size_t sleep_duration);
+
   std::shared_ptr<index::Index> GetIndexWithOid(const oid_t &index_oid);
 
   void DropIndexWithOid(const oid_t &index_oid);
@@ -178,6 +218,23 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  // Dictionary encode the dictionary encoded columns of a cold tile group
+  // and free the tiles' copies of their strings. Only full tile groups whose
+  // versions are all committed are encoded. It waits for the running
+  // transactions, so it must not be called from within one. Returns false
+  // if some column could not be encoded.
+  bool EncodeTileGroup(const oid_t &tile_group_offset);
+
+  // Shared dictionary of a column, nullptr if it is not dictionary encoded
+  std::shared_ptr<Dictionary> GetDictionary(const oid_t &column_id) const;
+
+  // Replace a cold tile group by an immutable, encoded copy of it. Only
+  // tile groups that no longer take inserts and whose versions are all
+  // committed and unowned are frozen. Returns false if the tile group was
+  // left alone. It waits for the running transactions, so it must not be
+  // called from within one.
+  bool FreezeTileGroup(const oid_t &tile_group_offset);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -194,13 +251,32 @@ class DataTable : public AbstractTable {
 
   void ResetDirty();
 
+  // Number of tuple versions added or removed since the table was created,
+  // which drives the background analyze
+  size_t GetModificationCount() const;
+
+  // Statistics of the last analyze of the table, nullptr if there was none
+  std::shared_ptr<const optimizer::TableStats> GetTableStats() const;
+
+  void SetTableStats(std::shared_ptr<const optimizer::TableStats> table_stats);
+
   //===--------------------------------------------------------------------===//
   // LAYOUT TUNER
   //===--------------------------------------------------------------------===//
 
+  // Whether the executor accessing the table is to record a sample of the
+  // access, one in every peloton_sample_rate of them is
+  bool SampleAccess();
+
+  // The samples are kept in lock free buffers of SAMPLE_BUFFER_SIZE samples,
+  // samples recorded while the buffer is full are dropped
   void RecordLayoutSample(const brain::Sample &sample);
 
-  const std::vector<brain::Sample> &GetLayoutSamples() const;
+  // Approximate number of samples recorded and not taken yet
+  size_t GetLayoutSampleCount() const;
+
+  // Removes and returns the samples recorded so far
+  std::vector<brain::Sample> TakeLayoutSamples();
 
   void ClearLayoutSamples();
 
@@ -212,7 +288,15 @@ class DataTable : public AbstractTable {
 
   void RecordIndexSample(const brain::Sample &sample);
 
-  const std::vector<brain::Sample> &GetIndexSamples() const;
+  // Records the sample of a write of tuple_count tuples for the index tuner
+  // if the table samples it, column_ids being the columns written or empty
+  // for all of them
+  void RecordWriteSample(const std::vector<oid_t> &column_ids,
+                         size_t tuple_count);
+
+  size_t GetIndexSampleCount() const;
+
+  std::vector<brain::Sample> TakeIndexSamples();
 
   void ClearIndexSamples();
 
@@ -238,6 +322,9 @@ class DataTable : public AbstractTable {
                        concurrency::Transaction *transaction, 
                        ItemPointer **index_entry_ptr);
 
+  // check the foreign key constraints
+  bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
+
  protected:
 
   //===--------------------------------------------------------------------===//
@@ -270,8 +357,9 @@ class DataTable : public AbstractTable {
                                 const TargetList *targets_ptr, 
                                 ItemPointer *index_entry_ptr);
 
-  // check the foreign key constraints
-  bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
+  // Insert the versions of a tile group an index added online is missing
+  void BuildIndexTileGroup(index::Index *index, oid_t tile_group_offset,
+                           cid_t snapshot_cid);
 
  private:
   //===--------------------------------------------------------------------===//
@@ -312,6 +400,15 @@ class DataTable : public AbstractTable {
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
+  // # of tuple versions added or removed, never reset
+  std::atomic<size_t> modification_count_ = ATOMIC_VAR_INIT(0);
+
+  // statistics of the last analyze, swapped atomically by the analyze
+  std::shared_ptr<const optimizer::TableStats> table_stats_;
+
+  // DICTIONARIES shared by all tile groups, one per dictionary encoded column
+  std::vector<std::shared_ptr<Dictionary>> dictionaries_;
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -322,17 +419,14 @@ class DataTable : public AbstractTable {
   // default partition map for table
   column_map_type default_partition_;
 
-  // samples for layout tuning
-  std::vector<brain::Sample> layout_samples_;
-
-  // layout samples mutex
-  std::mutex layout_samples_mutex_;
+  // accesses of the table, counted to sample one in peloton_sample_rate
+  std::atomic<size_t> access_count_ = ATOMIC_VAR_INIT(0);
 
   // samples for layout tuning
-  std::vector<brain::Sample> index_samples_;
+  std::unique_ptr<LockFreeQueue<brain::Sample>> layout_samples_;
 
-  // index samples mutex
-  std::mutex index_samples_mutex_;
+  // samples for index tuning
+  std::unique_ptr<LockFreeQueue<brain::Sample>> index_samples_;
 
   static oid_t invalid_tile_group_id;
 };
@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary.h
+//
+// Identification: src/include/storage/dictionary.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/macros.h"
+#include "common/types.h"
+
+namespace peloton {
+
+class Varlen;
+class VarlenPool;
+
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Dictionary
+//===--------------------------------------------------------------------===//
+
+/**
+ * Append-only string dictionary shared by all tiles of one table column.
+ *
+ * Every distinct string gets a fixed-width code. Encoded tiles keep one code
+ * per tuple slot and point their Varlen slots at the dictionary's single copy
+ * of each string. Codes are stable and shared across tile groups, so
+ * equality, hashing and grouping can work on codes without touching string
+ * bytes.
+ *
+ * Reading an entry by its code never blocks : entries are published
+ * through an atomic count and never move once published. Mapping a string
+ * to its code, Encode() and Lookup(), takes the lock; compiled scans look
+ * their constants up once per tile group, not per tuple.
+ */
+class Dictionary {
+  Dictionary(Dictionary const &) = delete;
+
+ public:
+  typedef uint16_t Code;
+
+  // code stored for NULL values
+  static const Code NULL_CODE = UINT16_MAX;
+
+  // codes 0 .. MAX_ENTRY_COUNT - 1 are available for strings
+  static const size_t MAX_ENTRY_COUNT = UINT16_MAX;
+
+  Dictionary(BackendType backend_type);
+
+  ~Dictionary();
+
+  /**
+   * @brief Get the code of a string, adding it if it is new.
+   * @return false if the dictionary is full.
+   */
+  bool Encode(const char *data, int32_t length, Code *code);
+
+  /**
+   * @brief Get the code of a string without adding it. Takes the lock.
+   * @return false if the string is not in the dictionary.
+   */
+  bool Lookup(const char *data, int32_t length, Code *code) const;
+
+  size_t GetEntryCount() const {
+    return entry_count_.load(std::memory_order_acquire);
+  }
+
+  // The entry as a Varlen in tuple storage format
+  inline Varlen *GetVarlen(const Code code) const {
+    return GetEntry(code).varlen;
+  }
+
+  inline void GetString(const Code code, const char **data,
+                        int32_t *length) const {
+    const Entry &entry = GetEntry(code);
+    *data = entry.data;
+    *length = entry.length;
+  }
+
+  // Same value std::hash<std::string> gives the string, so hashes built from
+  // codes match Value::HashCombine()
+  inline size_t GetHash(const Code code) const { return GetEntry(code).hash; }
+
+  // Hash of a NULL value, Value::HashCombine() hashes it as ''
+  static size_t GetNullHash() {
+    static const size_t null_hash = std::hash<std::string>()(std::string());
+    return null_hash;
+  }
+
+  // Bytes used by entries, strings and the lookup table
+  int64_t GetMemorySize() const;
+
+ private:
+  struct Entry {
+    Varlen *varlen;
+    const char *data;
+    int32_t length;
+    size_t hash;
+  };
+
+  static const size_t ENTRIES_PER_CHUNK = 1024;
+
+  static const size_t CHUNK_COUNT =
+      (MAX_ENTRY_COUNT + ENTRIES_PER_CHUNK - 1) / ENTRIES_PER_CHUNK;
+
+  inline const Entry &GetEntry(const Code code) const {
+    PL_ASSERT(code < GetEntryCount());
+    return chunks_[code / ENTRIES_PER_CHUNK]
+        .load(std::memory_order_acquire)[code % ENTRIES_PER_CHUNK];
+  }
+
+  // fixed array of chunk pointers, so published entries never move
+  std::array<std::atomic<Entry *>, CHUNK_COUNT> chunks_;
+
+  std::atomic<size_t> entry_count_;
+
+  // string -> code, guarded by dictionary_mutex_
+  std::unordered_map<std::string, Code> codes_;
+
+  mutable std::mutex dictionary_mutex_;
+
+  // storage for the entries' strings
+  std::unique_ptr<VarlenPool> pool_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// encoded_column.h
+//
+// Identification: src/include/storage/encoded_column.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+#include "storage/dictionary.h"
+
+namespace peloton {
+
+class VarlenPool;
+
+namespace storage {
+
+class Tile;
+
+//===--------------------------------------------------------------------===//
+// Encoded Column
+//===--------------------------------------------------------------------===//
+
+/**
+ * Immutable, compressed copy of one column of a frozen tile.
+ *
+ * Integer-like columns (TINYINT .. BIGINT, DATE, TIMESTAMP) are stored as
+ * runs or as bit-packed offsets from the column minimum, whichever is
+ * smaller. Uninlined VARCHAR columns are stored as dictionary codes. Every
+ * other column keeps its plain fixed-width fields.
+ *
+ * Decode() expands a range of slots back into tuple storage format, so scan
+ * kernels can run over a decoded batch exactly as over a hot tile.
+ */
+class EncodedColumn {
+  EncodedColumn() = delete;
+  EncodedColumn(EncodedColumn const &) = delete;
+
+ public:
+  enum EncodingType {
+    ENCODING_TYPE_PLAIN = 0,
+    ENCODING_TYPE_RLE = 1,
+    ENCODING_TYPE_BITPACKED = 2,
+    ENCODING_TYPE_DICTIONARY = 3
+  };
+
+  /**
+   * @brief Encode the first tuple_count slots of a tile column.
+   *
+   * VARCHAR columns are encoded against the tile's own dictionary if it has
+   * one, otherwise against the given dictionary, otherwise against a new
+   * one. Strings that can't be dictionary encoded are copied to the pool.
+   */
+  EncodedColumn(Tile *tile, const oid_t column_id, const oid_t tuple_count,
+                const std::shared_ptr<Dictionary> &dictionary,
+                VarlenPool *pool);
+
+  EncodingType GetEncodingType() const { return encoding_type_; }
+
+  oid_t GetTupleCount() const { return tuple_count_; }
+
+  // Length of one decoded field in tuple storage format
+  size_t GetFieldLength() const { return field_length_; }
+
+  // Value at a slot, same as reading it from the original tile
+  Value GetValue(const oid_t tuple_offset) const;
+
+  // Decode count slots starting at begin into consecutive fields
+  void Decode(const oid_t begin, const oid_t count, char *output) const;
+
+  // Per-slot codes of a dictionary encoded column, nullptr otherwise
+  const Dictionary::Code *GetDictionaryCodes() const { return codes_.get(); }
+
+  Dictionary *GetDictionary() const { return dictionary_.get(); }
+
+  // Bytes used by the encoded data, not counting shared dictionaries
+  int64_t GetMemorySize() const;
+
+  static std::string EncodingTypeToString(EncodingType encoding_type);
+
+ private:
+  // Raw integer stored in a field of the given width
+  static int64_t ReadInteger(const char *field, size_t width);
+
+  static void WriteInteger(char *field, size_t width, int64_t value);
+
+  void EncodeIntegers(Tile *tile, const oid_t column_id);
+
+  bool EncodeDictionary(Tile *tile, const oid_t column_id,
+                        const std::shared_ptr<Dictionary> &dictionary);
+
+  void EncodePlain(Tile *tile, const oid_t column_id, VarlenPool *pool);
+
+  // Raw integer of a RLE or bit-packed slot
+  int64_t GetInteger(const oid_t tuple_offset) const;
+
+  template <typename T>
+  void DecodeBitPacked(const oid_t begin, const oid_t count, char *output) const;
+
+  EncodingType encoding_type_;
+
+  ValueType value_type_;
+
+  bool is_inlined_;
+
+  oid_t tuple_count_;
+
+  size_t field_length_;
+
+  // ENCODING_TYPE_RLE : run values and exclusive run ends, NULLs are stored
+  // as the type's NULL sentinel
+  std::vector<int64_t> run_values_;
+  std::vector<oid_t> run_ends_;
+
+  // ENCODING_TYPE_BITPACKED : offsets from base_ packed into words, the
+  // largest offset null_offset_ stands for NULL if the column has NULLs
+  std::vector<uint64_t> packed_;
+  int64_t base_ = 0;
+  uint32_t bit_width_ = 0;
+  bool has_nulls_ = false;
+  uint64_t null_offset_ = 0;
+
+  // ENCODING_TYPE_DICTIONARY
+  std::shared_ptr<Dictionary> dictionary_;
+  std::unique_ptr<Dictionary::Code[]> codes_;
+
+  // ENCODING_TYPE_PLAIN : fields in tuple storage format
+  std::unique_ptr<char[]> plain_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -18,8 +18,12 @@
 #include "common/serializer.h"
 #include "common/pool.h"
 #include "common/printable.h"
+#include "storage/dictionary.h"
+#include "storage/encoded_column.h"
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace peloton {
 namespace storage {
@@ -56,6 +60,14 @@ class Tile : public Printable {
 
   virtual ~Tile();
 
+ protected:
+  // Frozen tile creator, see TileFactory::GetFrozenTile()
+  Tile(Tile *tile, TileGroupHeader *tile_header, TileGroup *tile_group,
+       const oid_t tuple_count,
+       const std::vector<std::shared_ptr<Dictionary>> &column_dictionaries);
+
+ public:
+
   //===--------------------------------------------------------------------===//
   // Operations
   //===--------------------------------------------------------------------===//
@@ -109,6 +121,77 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  //===--------------------------------------------------------------------===//
+  // Dictionary Encoding
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * @brief Encode an uninlined VARCHAR column against a shared dictionary.
+   *
+   * Every slot gets a code and its Varlen pointer is redirected to the
+   * dictionary's copy of the string, so readers that go through tuple
+   * storage keep working unchanged. Only tiles of full tile groups whose
+   * versions are all committed are encoded, their slots are not written
+   * anymore once the transactions filling them have ended (see
+   * DataTable::EncodeTileGroup).
+   *
+   * @return false if the column can't be encoded (wrong type, tile group
+   * still written or the dictionary filled up); the tile is left readable
+   * either way.
+   */
+  bool EncodeDictionary(const oid_t column_id,
+                        const std::shared_ptr<Dictionary> &dictionary);
+
+  /**
+   * @brief Copy the strings of the columns that are not dictionary encoded
+   * into a new pool, dropping the tile's copies of the encoded ones.
+   *
+   * @return the previous pool, to be freed once no reader can hold its
+   * strings anymore; nullptr if the tile has no uninlined column.
+   */
+  std::unique_ptr<VarlenPool> CompactPool();
+
+  // Per-slot codes of an encoded column, nullptr if not encoded
+  inline const Dictionary::Code *GetDictionaryCodes(
+      const oid_t column_id) const {
+    if (IsFrozen()) return encoded_columns[column_id]->GetDictionaryCodes();
+    if (column_id >= dictionary_codes.size()) return nullptr;
+    return dictionary_codes[column_id].get();
+  }
+
+  inline Dictionary *GetDictionary(const oid_t column_id) const {
+    if (IsFrozen()) return encoded_columns[column_id]->GetDictionary();
+    if (column_id >= dictionaries.size()) return nullptr;
+    return dictionaries[column_id].get();
+  }
+
+  // Shared reference to the dictionary of a hot encoded column
+  std::shared_ptr<Dictionary> GetDictionaryReference(
+      const oid_t column_id) const {
+    if (column_id >= dictionaries.size()) return nullptr;
+    return dictionaries[column_id];
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Frozen Tiles
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * A frozen tile holds an immutable encoded copy of a cold tile and no
+   * tuple slots. Reads go through GetValue(), GetValueFast() or a decoded
+   * batch of an encoded column; writes are not allowed. Updates of frozen
+   * tuples create new versions in hot tile groups as usual.
+   */
+  inline bool IsFrozen() const { return encoded_columns.empty() == false; }
+
+  inline const EncodedColumn *GetEncodedColumn(const oid_t column_id) const {
+    PL_ASSERT(IsFrozen());
+    return encoded_columns[column_id].get();
+  }
+
+  // Bytes used by the encoded columns of a frozen tile
+  int64_t GetEncodedSize() const;
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -215,6 +298,13 @@ class Tile : public Printable {
 
   oid_t column_header_size;
 
+  // Dictionaries and per-slot codes of dictionary encoded columns
+  std::vector<std::shared_ptr<Dictionary>> dictionaries;
+  std::vector<std::unique_ptr<Dictionary::Code[]>> dictionary_codes;
+
+  // Encoded columns of a frozen tile, empty for hot tiles
+  std::vector<std::unique_ptr<EncodedColumn>> encoded_columns;
+
   /**
    * NOTE : Tiles don't keep track of number of occupied slots.
    * This is maintained by shared Tile Header.
@@ -284,6 +374,25 @@ class TileFactory {
     return tile;
   }
 
+  /**
+   * @brief Creates an immutable encoded copy of the first tuple_count slots
+   * of a cold tile.
+   * @param column_dictionaries  shared dictionary for each tile column, or
+   * nullptr to build one for the column
+   */
+  static Tile *GetFrozenTile(
+      Tile *tile, TileGroupHeader *tile_header, TileGroup *tile_group,
+      oid_t tuple_count,
+      const std::vector<std::shared_ptr<Dictionary>> &column_dictionaries) {
+    Tile *frozen_tile = new Tile(tile, tile_header, tile_group, tuple_count,
+                                 column_dictionaries);
+
+    TileFactory::InitCommon(frozen_tile, tile->database_id, tile->table_id,
+                            tile->tile_group_id, tile->tile_id, tile->schema);
+
+    return frozen_tile;
+  }
+
  private:
   static void InitCommon(Tile *tile, oid_t database_id, oid_t table_id,
                          oid_t tile_group_id, oid_t tile_id,
@@ -22,6 +22,8 @@
 
 #include "common/types.h"
 #include "common/printable.h"
+#include "storage/dictionary.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 
@@ -75,14 +77,21 @@ class TileGroup : public Printable {
 
   ~TileGroup();
 
+ protected:
+  // Frozen tile group constructor, see TileGroupFactory::GetFrozenTileGroup()
+  TileGroup(TileGroup *tile_group, TileGroupHeader *tile_group_header,
+            const std::vector<std::shared_ptr<Dictionary>> &dictionaries);
+
+ public:
+
   //===--------------------------------------------------------------------===//
   // Operations
   //===--------------------------------------------------------------------===//
 
   void ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id);
 
-  // copy tuple in place.
-  void CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id);
+  // copy tuple in place, returns false if the tile group is frozen
+  bool CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id);
 
   void CopyTuple(const oid_t &tuple_slot_id, Tuple *tuple);
 
@@ -167,6 +176,27 @@ class TileGroup : public Printable {
 
   void SetValue(Value &value, oid_t tuple_id, oid_t column_id);
 
+  // Dictionary encode a column in the tile holding it
+  // (see Tile::EncodeDictionary)
+  bool EncodeDictionary(oid_t column_id,
+                        const std::shared_ptr<Dictionary> &dictionary);
+
+  // Get the dictionary and code of a value, false if its column is not
+  // dictionary encoded
+  bool GetDictionaryCode(oid_t tuple_id, oid_t column_id,
+                         const Dictionary **dictionary,
+                         Dictionary::Code *code);
+
+  // Whether the tiles are frozen (see Tile::IsFrozen)
+  bool IsFrozen() const;
+
+  // Zone map over every version the tile group has held
+  ZoneMap *GetZoneMap() const { return zone_map.get(); }
+
+  // Recompute the zone map from the allocated slots. Only safe before the
+  // tile group is published, e.g. after it is transformed or frozen.
+  void RebuildZoneMap();
+
   double GetSchemaDifference(const storage::column_map_type &new_column_map);
 
   // Sync the contents
@@ -208,6 +238,9 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // per-column statistics, widened on every insert
+  std::unique_ptr<ZoneMap> zone_map;
 };
 
 }  // End storage namespace
@@ -35,6 +35,16 @@ class TileGroupFactory {
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
                                  int tuple_count);
+
+  /**
+   * @brief Creates an immutable, encoded copy of a cold tile group, with the
+   * same id and a copy of its header.
+   * @param dictionaries  shared dictionary for each table column, or nullptr
+   * to build one per column
+   */
+  static TileGroup *GetFrozenTileGroup(
+      TileGroup *tile_group,
+      const std::vector<std::shared_ptr<Dictionary>> &dictionaries);
 };
 
 }  // End storage namespace
@@ -126,6 +126,9 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount();
 
+  // Whether no version of the tile group is owned by a running transaction
+  bool IsFullyCommitted() const;
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -199,6 +202,16 @@ class TileGroupHeader : public Printable {
     *((const ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset)) = indirection;
   }
 
+  // Sets the indirection of a tuple that has none, e.g. inserted while its
+  // table had no index. Returns false if it already had one.
+  inline bool SetAtomicIndirection(const oid_t &tuple_slot_id,
+                                   const ItemPointer *indirection) const {
+    const ItemPointer **indirection_ptr =
+        (const ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset);
+    return __sync_bool_compare_and_swap(
+        indirection_ptr, (const ItemPointer *)nullptr, indirection);
+  }
+
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/printable.h"
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-column minimum, maximum and NULL count of a tile group.
+ *
+ * Ranges only ever widen, so they bound every version the tile group has
+ * ever held, visible or not. Types without a total order (BOOLEAN,
+ * VARBINARY, ...) only keep the NULL count.
+ */
+class ZoneMap : public Printable {
+  ZoneMap() = delete;
+  ZoneMap(ZoneMap const &) = delete;
+
+ public:
+  ZoneMap(const std::vector<ValueType> &column_types);
+
+  // Widen the column's statistics by a value
+  void Update(const oid_t column_id, const Value &value);
+
+  /**
+   * @brief Copy the column's range out.
+   * @return false if the column has no range: it holds no non-NULL value or
+   * its type has no total order.
+   */
+  bool GetRange(const oid_t column_id, Value *min, Value *max) const;
+
+  oid_t GetNullCount(const oid_t column_id) const;
+
+  /**
+   * @brief Whether some value in the column's range may satisfy
+   * "column <comparison> value". NULLs never satisfy a comparison, so a
+   * column holding only NULLs satisfies none.
+   * @return true whenever the answer is not known.
+   */
+  bool MaySatisfy(const oid_t column_id, const ExpressionType comparison,
+                  const Value &value) const;
+
+  oid_t GetColumnCount() const { return columns_.size(); }
+
+  // Whether min/max are kept for the type
+  static bool IsOrdered(const ValueType type);
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+ private:
+  struct ColumnZone {
+    ValueType type;
+    // nullptr until the first non-NULL value; Value's assignment would
+    // leak the string it overwrites
+    std::unique_ptr<Value> min;
+    std::unique_ptr<Value> max;
+    oid_t null_count = 0;
+  };
+
+  std::vector<ColumnZone> columns_;
+
+  // guards the zones, Values can't be updated atomically
+  mutable Spinlock zone_map_lock_;
+};
+
+//===--------------------------------------------------------------------===//
+// Zone Map Predicate
+//===--------------------------------------------------------------------===//
+
+/**
+ * The "column <comparison> constant" conjuncts of a scan predicate, checked
+ * against zone maps to skip tile groups none of whose tuples can qualify.
+ * Other conjuncts are ignored; they can only reject more tuples.
+ */
+class ZoneMapPredicate {
+  ZoneMapPredicate() = delete;
+  ZoneMapPredicate(ZoneMapPredicate const &) = delete;
+
+ public:
+  // Parameter expressions are resolved with params
+  ZoneMapPredicate(const expression::AbstractExpression *predicate,
+                   const std::vector<Value> &params);
+
+  // Whether any conjunct could be used
+  bool IsEmpty() const { return conjuncts_.empty(); }
+
+  // Whether no tuple within the zone map can satisfy the predicate
+  bool CanSkip(const ZoneMap *zone_map) const;
+
+ private:
+  void AddConjuncts(const expression::AbstractExpression *expr,
+                    const std::vector<Value> &params);
+
+  struct Conjunct {
+    oid_t column_id;
+    ExpressionType comparison;
+    Value value;
+  };
+
+  std::vector<Conjunct> conjuncts_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
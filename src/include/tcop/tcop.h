@@ -21,6 +21,9 @@
 #include "common/portal.h"
 #include "common/statement.h"
 #include "common/types.h"
+#include "executor/plan_executor.h"
+#include "optimizer/plan_cache.h"
+#include "parser/sql_statement.h"
 
 namespace peloton {
 namespace tcop {
@@ -46,14 +49,41 @@ class TrafficCop {
                           std::vector<ResultType> &result,
                           std::vector<FieldInfoType> &tuple_descriptor,
                           int &rows_changed,
-                          std::string &error_message);
+                          std::string &error_message,
+                          concurrency::Transaction* txn = nullptr);
 
-  // ExecPrepStmt - Execute a statement from a prepared and bound statement
+  // ExecPrepStmt - Execute a statement from a prepared and bound statement.
+  // It runs within txn if given, in a transaction of its own otherwise.
   Result ExecuteStatement(const std::shared_ptr<Statement>& statement,
                           const bool unnamed,
                           std::vector<ResultType> &result,
                           int &rows_change,
-                          std::string &error_message);
+                          std::string &error_message,
+                          concurrency::Transaction* txn = nullptr);
+
+  // Transactions spanning several statements of a session (BEGIN ... COMMIT)
+  concurrency::Transaction* BeginTransaction();
+
+  // Commit txn, or abort it if one of its statements failed
+  Result CommitTransaction(concurrency::Transaction* txn);
+
+  Result AbortTransaction(concurrency::Transaction* txn);
+
+  // Start executing a prepared statement bound to params; its rows are
+  // pulled from the returned cursor as they are produced. It runs within
+  // txn if given, in a transaction of its own otherwise.
+  // The executor tree of the statement's previous execution is reused
+  // when it can be.
+  std::unique_ptr<bridge::PlanCursor> OpenCursor(
+      const std::shared_ptr<Statement>& statement,
+      const std::vector<Value>& params,
+      concurrency::Transaction* txn = nullptr);
+
+  // Close a cursor of the statement, keeping its executor tree for the next
+  // execution
+  bridge::peloton_status CloseCursor(
+      const std::shared_ptr<Statement>& statement,
+      std::unique_ptr<bridge::PlanCursor> cursor);
 
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string& statement_name,
@@ -62,6 +92,9 @@ class TrafficCop {
 
   std::vector<FieldInfoType> GenerateTupleDescriptor(std::string query);
 
+  std::vector<FieldInfoType> GenerateTupleDescriptor(
+      parser::SQLStatement* select_stmt);
+
   FieldInfoType GetColumnFieldForValueType(std::string column_name , ValueType column_type);
   
   FieldInfoType GetColumnFieldForAggregates(std::string name , ExpressionType expr_type);  
@@ -70,6 +103,19 @@ class TrafficCop {
                      Statement **stmt,
                      std::string &error_message);
 
+ private:
+  // Parse and plan a query, a SELECT also gets its tuple descriptor.
+  // Returns nullptr if the query can't be parsed.
+  std::shared_ptr<planner::AbstractPlan> BuildPlanTree(
+      const std::string& query_string,
+      std::vector<FieldInfoType> &tuple_descriptor);
+
+  // Give the statement an instance of a cached plan, its literals are the
+  // parameter values of the executions
+  void BindCachedPlan(Statement &statement,
+                      const optimizer::CachedPlan &cached_plan,
+                      const std::shared_ptr<planner::AbstractPlan> &plan_tree,
+                      const std::vector<Value> &literals);
 };
 
 }  // End tcop namespace
@@ -25,6 +25,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <iostream>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "common/logger.h"
@@ -36,36 +41,97 @@ namespace peloton {
 
 namespace wire {
 
+/*
+ * ServerLoop - An event loop on its own thread, pinned to a core. It owns
+ * 	the connections the server hands it and parses and executes their
+ * 	requests on that thread, so a request never changes threads. Queries
+ * 	run on the loop thread too: while one runs, the other connections of
+ * 	the loop wait, so long queries should be spread over more loops.
+ */
+class ServerLoop {
+  ServerLoop() = delete;
+  ServerLoop(ServerLoop const &) = delete;
+
+ public:
+  ServerLoop(const int loop_id, const int core_id);
+
+  // Stops the loop and closes its connections
+  ~ServerLoop();
+
+  // Run the loop on a new thread
+  void Start();
+
+  // Stop the loop and wait for its thread, thread safe
+  void Stop();
+
+  // Take ownership of an accepted connection, thread safe
+  void AddConnection(SocketManager<PktBuf> *socket_manager);
+
+  // Close a connection of this loop, on the loop's thread. This is the only
+  // place, with the destructor, that a connection's socket is closed.
+  void RemoveConnection(SocketManager<PktBuf> *socket_manager);
+
+  int GetLoopId() const { return loop_id_; }
+
+  size_t GetConnectionCount() const { return connection_count_; }
+
+ private:
+  // Wake the loop up with a notification byte
+  void Notify(const char notification);
+
+  static void NotifyCallback(evutil_socket_t fd, short what, void *arg);
+
+  // Register the connections handed over since the last notification
+  void AcceptPendingConnections();
+
+  int loop_id_;
+  int core_id_;
+
+  struct event_base *base_;
+
+  // Other threads talk to the loop through a pipe
+  int notify_fds_[2];
+  struct event *notify_event_;
+
+  std::thread thread_;
+
+  // Connections handed over but not registered yet
+  std::mutex pending_lock_;
+  std::vector<SocketManager<PktBuf> *> pending_connections_;
+
+  // Connections owned by the loop, by socket manager id
+  std::unordered_map<unsigned int, std::unique_ptr<SocketManager<PktBuf>>>
+      connections_;
+
+  std::atomic<size_t> connection_count_;
+};
+
+/*
+ * Server - Accepts connections on the listening socket and assigns them
+ * 	round-robin to the event loops
+ */
 class Server {
 
   public:
+  // Bind the listening socket and set up the event loops
   Server();
 
-  inline ~Server() {
-    for (auto socket_manager : socket_manager_vector_) {
-      delete (socket_manager);
-    }
-  }
+  ~Server();
 
-	// Remove socket manager with the same fd and add the new one
-  inline static void AddSocketManager(SocketManager<PktBuf>* socket_manager) {
-  // If a socket manager with the same file descriptor exists, remove it first
-    auto it = std::begin(socket_manager_vector_);
-    while(it != std::end(socket_manager_vector_)) {
-	  if((*it)->GetSocketFD() == socket_manager->GetSocketFD()) {
-		  LOG_INFO("Removing socket manager on existing fd");
-		  delete(*it);
-		  it = socket_manager_vector_.erase(it);
-	  }
-	  else {
-	    ++it;
-	  }
-	}
-	socket_manager_vector_.push_back(socket_manager);
-  }
+  // Run the server until CloseServer is called or SIGHUP is received
+  void StartServer();
+
+  // Make StartServer return, thread safe
+  void CloseServer();
+
+  // Hand an accepted connection to the next event loop
+  void DispatchConnection(evutil_socket_t client_fd);
 
-  // To keep track of socket managers for deletion
-  static std::vector<SocketManager<PktBuf>*> socket_manager_vector_;
+  size_t GetLoopCount() const { return loops_.size(); }
+
+  ServerLoop *GetLoop(const size_t loop_itr) const {
+    return loops_[loop_itr].get();
+  }
 
   // socket manager id cntr
   static unsigned int socket_manager_id;
@@ -74,8 +140,25 @@ class Server {
  private:
   // For logging purposes
   static void LogCallback(int severity, const char* msg);
+
+  static void CloseCallback(evutil_socket_t fd, short what, void *arg);
+
   int port_;             // port number
   int max_connections_;  // maximum number of connections
+
+  // The accepting event loop, running on the thread of StartServer
+  struct event_base *base_;
+  struct evconnlistener *listener_;
+  struct event *evstop_;
+
+  // CloseServer wakes up the accepting loop through a pipe
+  int close_fds_[2];
+  struct event *close_event_;
+
+  std::vector<std::unique_ptr<ServerLoop>> loops_;
+
+  // Loop the next connection is assigned to
+  size_t next_loop_;
 };
 }
 }
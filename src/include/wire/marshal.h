@@ -19,6 +19,8 @@
 #include "wire/socket_base.h"
 #include "wire/wire.h"
 #include "common/logger.h"
+#include "common/types.h"
+#include "common/value.h"
 
 namespace peloton {
 namespace wire {
@@ -73,10 +75,38 @@ extern void PacketGetBytes(Packet *pkt, size_t len, PktBuf &result);
  */
 extern void GetStringToken(Packet *pkt, std::string &result);
 
+/*
+ * Value marshallers - Format code 0 is text and 1 is binary
+ */
+
+#define TEXT_FORMAT_CODE 0
+#define BINARY_FORMAT_CODE 1
+
+/*
+ * packet_put_value - used to write a column value, preceded by its length
+ * 	or -1 for NULL. Binary values are encoded as the Postgres type the
+ * 	column was described as, straight from the value's storage.
+ */
+extern void PacketPutValue(std::unique_ptr<Packet> &pkt, const Value &value,
+                           const PostgresValueType type, const int format);
+
+/*
+ * packet_get_binary_value - Decode a bind parameter sent in binary format.
+ * 	Returns false if the type has no binary decoding or the length does
+ * 	not match it.
+ */
+extern bool PacketGetBinaryValue(const PktBuf &data,
+                                 const PostgresValueType type, Value &result);
+
 /*
  * Socket layer interface - Link the protocol to the socket buffers
  */
 
+/* Copy a batch of packets into the socket write buffer, which is only
+ * flushed when it fills up */
+extern bool BufferPackets(std::vector<std::unique_ptr<Packet>> &packets,
+                          Client *client);
+
 /* Write a batch of packets to the socket write buffer */
 extern bool WritePackets(std::vector<std::unique_ptr<Packet>> &packets,
                          Client *client);
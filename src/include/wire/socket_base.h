@@ -39,6 +39,7 @@ namespace wire {
 
 class PacketManager;
 class Server;
+class ServerLoop;
 
 typedef unsigned char uchar;
 
@@ -70,6 +71,7 @@ class SocketManager {
   int sock_fd;  // file descriptor
   Buffer rbuf;  // socket's read buffer
   Buffer wbuf;  // socket's write buffer
+  bool disconnected;  // the client closed the connection or it failed
 
  private:
   /* refill_read_buffer - Used to repopulate read buffer with a fresh
@@ -82,14 +84,18 @@ class SocketManager {
   bool first_packet;
   std::unique_ptr<PacketManager> socket_pkt_manager;
   struct event *ev_read;  // the read event
-  std::mutex execution_mutex;  // only one thread executing
-  SocketManager<B>* self;
+  ServerLoop *loop;  // the event loop owning the connection
 
   inline SocketManager(int sock_fd, unsigned int assigned_id) : sock_fd(sock_fd),
-		  id(assigned_id), first_packet(false), ev_read(NULL), self(NULL) { }
+		  disconnected(false), id(assigned_id), first_packet(false),
+		  ev_read(NULL), loop(NULL) { }
 
   int GetSocketFD() { return sock_fd; }
 
+  // Whether the last read found the connection closed, rather than just
+  // drained
+  bool IsDisconnected() const { return disconnected; }
+
   // Check if there is data to read from buffer
   bool CanRead();
 
@@ -102,6 +108,7 @@ class SocketManager {
   // Used to invoke a write into the Socket, once the write buffer is ready
   bool FlushWriteBuffer();
 
+  // Close the socket, does nothing if it is already closed
   void CloseSocket();
 };
 
@@ -32,6 +32,18 @@
 #define TXN_FAIL 'E'
 
 namespace peloton {
+
+namespace bridge {
+class PlanCursor;
+}
+
+namespace concurrency {
+class Transaction;
+}
+namespace planner {
+class ImportPlan;
+}
+
 namespace wire {
 
 typedef std::vector<uchar> PktBuf;
@@ -77,6 +89,22 @@ class PacketManager {
   // gloabl txn state
   uchar txn_state;
 
+  // reused for every data row, so streaming doesn't allocate per row
+  std::unique_ptr<Packet> row_packet_;
+
+  // Transaction of the session's current statements : the explicit one of a
+  // BEGIN block, or else the implicit one of a simple query or of an
+  // extended protocol batch (ended by SYNC). nullptr until a statement
+  // executes.
+  concurrency::Transaction* txn_ = nullptr;
+
+  // A message of the batch failed, the rest is ignored until SYNC
+  bool skip_to_sync_ = false;
+
+  // COPY ... FROM STDIN waiting for its rows, and the rows received so far
+  std::shared_ptr<Statement> copy_statement_;
+  std::string copy_data_;
+
   // state to mang skipped queries
   bool skipped_stmt_ = false;
   std::string skipped_query_string_;
@@ -96,16 +124,24 @@ class PacketManager {
   // Sends ready for query packet to the frontend
   void SendReadyForQuery(uchar txn_status, ResponseBuffer& responses);
 
-  // Sends the attribute headers required by SELECT queries
+  /* Sends the attribute headers required by SELECT queries, along with
+   * the format code of each column. No format codes means all text. */
   void PutTupleDescriptor(const std::vector<FieldInfoType>& tuple_descriptor,
+                          const std::vector<int16_t>& result_formats,
                           ResponseBuffer& responses);
 
-  // Send each row, one packet at a time, used by SELECT queries
-  void SendDataRows(std::vector<ResultType>& results, int colcount,
-                    int& rows_affected, ResponseBuffer& responses);
-
-  // Used to send a packet that indicates the completion of a query. Also has
-  // txn state mgmt
+  /* Stream the cursor's rows straight into the socket write buffer, which
+   * is flushed whenever it fills up. Columns are sent in the formats of the
+   * tuple descriptor. Stops after max_rows rows if it is not 0 and sets
+   * suspended. Statements without a tuple descriptor are just run to
+   * completion. Returns false if the socket write failed. */
+  bool SendDataRows(bridge::PlanCursor& cursor,
+                    const std::vector<FieldInfoType>& tuple_descriptor,
+                    const std::vector<int16_t>& result_formats, int max_rows,
+                    int& rows_sent, bool& suspended,
+                    ResponseBuffer& responses);
+
+  // Used to send a packet that indicates the completion of a query
   void CompleteCommand(const std::string& query_type,
                        int rows,
                        ResponseBuffer& responses);
@@ -125,8 +161,30 @@ class PacketManager {
    */
   bool HardcodedExecuteFilter(std::string query_type);
 
-  /* Execute a Simple query protocol message */
-  void ExecQueryMessage(Packet* pkt, ResponseBuffer& responses);
+  /* Execute a Simple query protocol message, false if the result could not
+   * be written */
+  bool ExecQueryMessage(Packet* pkt, ResponseBuffer& responses);
+
+  /* End the implicit transaction of a simple query, unless it runs in a
+   * BEGIN block, and send ready for query */
+  void FinishQuery(bool failed, ResponseBuffer& responses);
+
+  /* The import plan of a COPY ... FROM STDIN statement, nullptr for other
+   * statements */
+  static planner::ImportPlan* GetStdinImportPlan(const Statement& statement);
+
+  /* Ask the client for the rows of COPY ... FROM STDIN */
+  void SendCopyInResponse(int column_count, ResponseBuffer& responses);
+
+  /* Process the COPY DATA message, a part of the rows being copied in */
+  void ExecCopyDataMessage(Packet* pkt);
+
+  /* Process the COPY DONE message: load the rows and complete the query,
+   * false if the result could not be written */
+  bool ExecCopyDoneMessage(ResponseBuffer& responses);
+
+  /* Process the COPY FAIL message: the client gave up on the copy */
+  void ExecCopyFailMessage(Packet* pkt, ResponseBuffer& responses);
 
   /* Process the PARSE message of the extended query protocol */
   void ExecParseMessage(Packet* pkt, ResponseBuffer& responses);
@@ -137,11 +195,36 @@ class PacketManager {
   /* Process the DESCRIBE message of the extended query protocol */
   void ExecDescribeMessage(Packet* pkt, ResponseBuffer& responses);
 
-  /* Process the EXECUTE message of the extended query protocol */
-  void ExecExecuteMessage(Packet* pkt, ResponseBuffer& response);
+  /* Process the EXECUTE message of the extended query protocol, false if
+   * the result could not be written */
+  bool ExecExecuteMessage(Packet* pkt, ResponseBuffer& response);
+
+  /* Begin the session's transaction unless it already is */
+  concurrency::Transaction* GetTransaction();
+
+  /* Commit (or abort) the session's transaction along with the executions
+   * suspended in it. Returns the outcome. */
+  Result EndTransaction(bool commit);
 
-  /* closes the socket connection with the client */
-  void CloseClient();
+  /* A failed statement dooms an explicit transaction, the following ones
+   * are refused until it is ended */
+  void FailTransaction();
+
+  /* Whether the query is BEGIN, COMMIT or ROLLBACK */
+  static bool IsTransactionCommand(const std::string& query_type);
+
+  /* Run BEGIN, COMMIT or ROLLBACK on the session's transaction */
+  void ExecTransactionCommand(const std::string& query_type,
+                              ResponseBuffer& responses);
+
+  /* Report an error of an extended protocol message, the remaining
+   * messages of the batch are ignored until SYNC */
+  void SendBatchError(const std::string& error_message,
+                      ResponseBuffer& responses);
+
+  /* Process the SYNC message: outside of a BEGIN block, commit the batch
+   * transaction, or abort it if the batch failed */
+  void ExecSyncMessage(ResponseBuffer& responses);
 
  public:
   // Statement cache
@@ -152,7 +235,10 @@ class PacketManager {
 
 
   inline PacketManager(SocketManager<PktBuf>* sock)
-      : client(sock), txn_state(TXN_IDLE) {}
+      : client(sock), txn_state(TXN_IDLE), row_packet_(new Packet()) {}
+
+  // Aborts the session's unfinished transaction
+  ~PacketManager();
 
   /* Startup packet processing logic */
   bool ProcessStartupPacket(Packet* pkt, ResponseBuffer& responses);
@@ -161,10 +247,12 @@ class PacketManager {
    * packet */
   bool ProcessPacket(Packet* pkt, ResponseBuffer& responses);
 
-  /* Manage the startup packet */
+  /* Manage the startup packet, returns false if the connection must be
+   * closed. The caller closes it. */
   bool ManageFirstPacket();
 
-  /* Manage subsequent packets */
+  /* Manage subsequent packets, returns false if the connection must be
+   * closed. The caller closes it. */
   bool ManagePacket();
 
 };
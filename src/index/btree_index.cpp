@@ -12,6 +12,7 @@
 
 
 #include "index/btree_index.h"
+#include "index/bulk_load.h"
 #include "index/index_key.h"
 #include "index/index_util.h"
 #include "common/logger.h"
@@ -172,17 +173,67 @@ bool BTREE_TEMPLATE_TYPE::CondInsertEntry(const storage::Tuple *key,
   return true;
 }
 
+BTREE_TEMPLATE_ARGUMENT
+bool BTREE_TEMPLATE_TYPE::BulkLoad(
+    const std::vector<std::vector<ItemPointer *>> &runs) {
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  if (SortBulkLoadEntries(this, runs, comparator, entries) == false) {
+    return false;
+  }
+
+  {
+    index_lock.WriteLock();
+
+    // Only an empty tree could be built bottom up, with full leaves
+    if (container.empty() == false) {
+      index_lock.Unlock();
+
+      return false;
+    }
+    container.bulk_load(entries.begin(), entries.end());
+
+    index_lock.Unlock();
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////////////////////////
 // Scan operations
 /////////////////////////////////////////////////////////////////////
 
+/*
+ * VisitRange() - Calls visit on every iterator in [begin_itr, end_itr),
+ *                from the back if backward is true, until it returns false
+ */
+template <typename IteratorType, typename VisitorType>
+static void VisitRange(IteratorType begin_itr, IteratorType end_itr,
+                       bool backward, VisitorType visit) {
+  if(backward == true) {
+    while(end_itr != begin_itr) {
+      --end_itr;
+      if(visit(end_itr) == false) {
+        return;
+      }
+    }
+  } else {
+    for(; begin_itr != end_itr; ++begin_itr) {
+      if(visit(begin_itr) == false) {
+        return;
+      }
+    }
+  }
+}
+
 BTREE_TEMPLATE_ARGUMENT
 void BTREE_TEMPLATE_TYPE::Scan(const std::vector<Value> &value_list,
                                const std::vector<oid_t> &tuple_column_id_list,
                                const std::vector<ExpressionType> &expr_list,
                                const ScanDirectionType &scan_direction,
                                std::vector<ItemPointer *> &result,
-                               const ConjunctionScanPredicate *csp_p) {
+                               const ConjunctionScanPredicate *csp_p,
+                               size_t limit,
+                               std::vector<Value> *result_keys) {
       
   // First make sure all three components of the scan predicate are
   // of the same length
@@ -190,17 +241,51 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<Value> &value_list,
   PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
   PL_ASSERT(tuple_column_id_list.size() == value_list.size());
   
-  // This is a hack - we do not support backward scan
   if(scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
     throw Exception("Invalid scan direction \n");
   }
 
-  LOG_TRACE("Point Query = %d; Full Scan = %d ",
+  bool backward = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD);
+
+  LOG_TRACE("Point Query = %d; Full Scan = %d; Backward = %d; Limit = %lu",
             csp_p->IsPointQuery(),
-            csp_p->IsFullIndexScan());
+            csp_p->IsFullIndexScan(),
+            backward,
+            limit);
+
+  // The limit counts the entries appended by this scan
+  const size_t result_offset = result.size();
+
+  // Appends the location of the entry if its key satisfies the predicate,
+  // and returns false once the limit has been reached
+  // Since we just narrowed down search range using low key and
+  // high key for scan, it is still possible that there are tuples
+  // for which the predicate is not true
+  auto collect = [&](const typename MapType::const_iterator &scan_itr) {
+    // Unpack the key as a standard tuple for comparison
+    auto scan_current_key = scan_itr->first;
+    auto tuple = \
+      scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+    if(Compare(tuple,
+               tuple_column_id_list,
+               expr_list,
+               value_list) == true) {
+      result.push_back(scan_itr->second);
+
+      // Along with the values of its key columns, if they are asked for
+      if(result_keys != nullptr) {
+        AppendKeyValues(tuple, *result_keys);
+      }
+    }
+
+    return (limit == 0) || (result.size() - result_offset < limit);
+  };
 
   index_lock.ReadLock();
 
+  const MapType &map = container;
+
   if(csp_p->IsPointQuery() == true) {
     // For point query we construct the key and use equal_range
     
@@ -210,47 +295,12 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<Value> &value_list,
     point_query_key.SetFromKey(point_query_key_p);
 
     // Use equal_range to mark two ends of the scan
-    auto scan_itr_pair = container.equal_range(point_query_key);
-    
-    auto scan_begin_itr = scan_itr_pair.first;
-    auto scan_end_itr = scan_itr_pair.second;
-
-    for (auto scan_itr = scan_begin_itr;
-         scan_itr != scan_end_itr;
-         scan_itr++) {
-      auto scan_current_key = scan_itr->first;
-      auto tuple = \
-        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-      if (Compare(tuple,
-                  tuple_column_id_list,
-                  expr_list,
-                  value_list) == true) {
-        result.push_back(scan_itr->second);
-      }
-    }
+    auto scan_itr_pair = map.equal_range(point_query_key);
+
+    VisitRange(scan_itr_pair.first, scan_itr_pair.second, backward, collect);
   } else if(csp_p->IsFullIndexScan() == true) {
     // If it is a full index scan, then just do the scan
-    
-    for (auto scan_itr = container.begin();
-         scan_itr != container.end();
-         scan_itr++) {
-      // Unpack the key as a standard tuple for comparison
-      auto scan_current_key = scan_itr->first;
-      auto tuple = \
-        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-      // Compare whether the current key satisfies the predicate
-      // since we just narrowed down search range using low key and
-      // high key for scan, it is still possible that there are tuples
-      // for which the predicate is not true
-      if(Compare(tuple,
-                 tuple_column_id_list,
-                 expr_list,
-                 value_list) == true) {
-        result.push_back(scan_itr->second);
-      }
-    } // for it from begin() to end()
+    VisitRange(map.begin(), map.end(), backward, collect);
   } else {
     const storage::Tuple *low_key_p = csp_p->GetLowKey();
     const storage::Tuple *high_key_p = csp_p->GetHighKey();
@@ -262,23 +312,14 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<Value> &value_list,
     index_low_key.SetFromKey(low_key_p);
     index_high_key.SetFromKey(high_key_p);
     
-    // It is good that we have equal_range
-    auto scan_begin_itr = container.equal_range(index_low_key).first;
-    auto scan_end_itr = container.equal_range(index_high_key).second;
-
-    for (auto scan_itr = scan_begin_itr;
-         scan_itr != scan_end_itr;
-         scan_itr++) {
-      auto scan_current_key = scan_itr->first;
-      auto tuple = \
-        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-        
-      if (Compare(tuple,
-                  tuple_column_id_list,
-                  expr_list,
-                  value_list) == true) {
-        result.push_back(scan_itr->second);
-      }
+    // Both ends of the scan are located before iterating in either
+    // direction
+    auto scan_begin_itr = map.lower_bound(index_low_key);
+    auto scan_end_itr = map.upper_bound(index_high_key);
+
+    // An empty range whose ends cross each other
+    if(map.key_comp()(index_high_key, index_low_key) == false) {
+      VisitRange(scan_begin_itr, scan_end_itr, backward, collect);
     }
   } // if is full scan
 
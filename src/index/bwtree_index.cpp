@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "common/logger.h"
+#include "index/bulk_load.h"
 #include "index/bwtree_index.h"
 #include "index/index_key.h"
 #include "storage/tuple.h"
@@ -34,9 +35,10 @@ BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
       // NOTE: These two arguments need to be constructed in advance
       // and do not have trivial constructor
       //
-      // NOTE 2: We set the first parameter to false to disable automatic GC
+      // NOTE 2: We set the first parameter to true so that garbage is
+      // collected by the cleaner thread shared by all trees
       //
-      container{false, comparator, equals, hash_func} {
+      container{true, comparator, equals, hash_func} {
 
   return;
 }
@@ -138,26 +140,69 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * BulkLoad() - Builds the tree bottom up from the sorted runs
+ *
+ * If the tree is not empty it is left unchanged and false is returned
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::BulkLoad(
+    const std::vector<std::vector<ItemPointer *>> &runs) {
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  if (SortBulkLoadEntries(this, runs, comparator, entries) == false) {
+    return false;
+  }
+
+  bool ret = container.BulkLoad(entries);
+
+  return ret;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &value_list,
                              const std::vector<oid_t> &tuple_column_id_list,
                              const std::vector<ExpressionType> &expr_list,
                              const ScanDirectionType &scan_direction,
                              std::vector<ItemPointer *> &result,
-                             const ConjunctionScanPredicate *csp_p) {
+                             const ConjunctionScanPredicate *csp_p,
+                             size_t limit,
+                             std::vector<Value> *result_keys) {
   // First make sure all three components of the scan predicate are
   // of the same length
   // Since there is a 1-to-1 correspondense between these three vectors
   PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
   PL_ASSERT(tuple_column_id_list.size() == value_list.size());
 
-  // This is a hack - we do not support backward scan
   if (scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
     throw Exception("Invalid scan direction \n");
   }
 
-  LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
-            csp_p->IsFullIndexScan());
+  bool backward = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD);
+
+  LOG_TRACE("Point Query = %d; Full Scan = %d; Backward = %d; Limit = %lu",
+            csp_p->IsPointQuery(), csp_p->IsFullIndexScan(), backward,
+            limit);
+
+  // The limit counts the entries appended by this scan
+  const size_t result_offset = result.size();
+  auto limit_reached = [&result, result_offset, limit]() {
+    return (limit != 0) && (result.size() - result_offset >= limit);
+  };
+
+  // Appends the location of the current entry if its key satisfies the
+  // predicate. Since we just narrowed down search range using low key and
+  // high key for scan, it is still possible that there are tuples for which
+  // the predicate is not true
+  auto collect = [&](KeyType scan_current_key, ItemPointer *location) {
+    // Unpack the key as a standard tuple for comparison
+    auto tuple =
+        scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+    if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
+      result.push_back(location);
+      if (result_keys != nullptr) AppendKeyValues(tuple, *result_keys);
+    }
+  };
 
   if (csp_p->IsPointQuery() == true) {
     // For point query we construct the key and use equal_range
@@ -172,26 +217,36 @@ void BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &value_list,
     // this would induce an overhead for point query, which must be highly
     // optimized and super fast
     container.GetValue(point_query_key, result);
-  } else if (csp_p->IsFullIndexScan() == true) {
 
+    // All values of the key are collected at once
+    if (limit_reached() == true) {
+      result.resize(result_offset + limit);
+    }
+
+    // They all share the key being looked up
+    if (result_keys != nullptr) {
+      for (size_t entry_itr = result_offset; entry_itr < result.size();
+           entry_itr++) {
+        AppendKeyValues(*point_query_key_p, *result_keys);
+      }
+    }
+  } else if (csp_p->IsFullIndexScan() == true) {
     // If it is a full index scan, then just do the scan
     // until we have reached the end of the index by the same
     // we take the snapshot of the last leaf node
-    for (auto scan_itr = container.Begin(); (scan_itr.IsEnd() == false);
-         scan_itr++) {
-      // Unpack the key as a standard tuple for comparison
-      auto scan_current_key = scan_itr->first;
-      auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-      // Compare whether the current key satisfies the predicate
-      // since we just narrowed down search range using low key and
-      // high key for scan, it is still possible that there are tuples
-      // for which the predicate is not true
-      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
-        result.push_back(scan_itr->second);
+    if (backward == true) {
+      for (auto scan_itr = container.ReverseBegin();
+           (scan_itr.IsEnd() == false) && (limit_reached() == false);
+           --scan_itr) {
+        collect(scan_itr->first, scan_itr->second);
       }
-    }  // for it from begin() to end()
+    } else {
+      for (auto scan_itr = container.Begin();
+           (scan_itr.IsEnd() == false) && (limit_reached() == false);
+           ++scan_itr) {
+        collect(scan_itr->first, scan_itr->second);
+      }
+    }
   } else {
     const storage::Tuple *low_key_p = csp_p->GetLowKey();
     const storage::Tuple *high_key_p = csp_p->GetHighKey();
@@ -206,20 +261,29 @@ void BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &value_list,
     index_low_key.SetFromKey(low_key_p);
     index_high_key.SetFromKey(high_key_p);
 
-    // We use bwtree Begin() to first reach the lower bound
-    // of the search key
-    // Also we keep scanning until we have reached the end of the index
-    // or we have seen a key higher than the high key
-    for (auto scan_itr = container.Begin(index_low_key);
-         (scan_itr.IsEnd() == false) &&
-             (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
-         scan_itr++) {
-      auto scan_current_key = scan_itr->first;
-      auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
-
-      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
-        result.push_back(scan_itr->second);
+    if (backward == true) {
+      // Start from the last key <= high key, and go back until we have
+      // reached the beginning of the index or seen a key lower than the
+      // low key
+      for (auto scan_itr = container.ReverseBegin(index_high_key);
+           (scan_itr.IsEnd() == false) &&
+               (container.KeyCmpGreaterEqual(scan_itr->first,
+                                             index_low_key)) &&
+               (limit_reached() == false);
+           --scan_itr) {
+        collect(scan_itr->first, scan_itr->second);
+      }
+    } else {
+      // We use bwtree Begin() to first reach the lower bound
+      // of the search key
+      // Also we keep scanning until we have reached the end of the index
+      // or we have seen a key higher than the high key
+      for (auto scan_itr = container.Begin(index_low_key);
+           (scan_itr.IsEnd() == false) &&
+               (container.KeyCmpLessEqual(scan_itr->first, index_high_key)) &&
+               (limit_reached() == false);
+           ++scan_itr) {
+        collect(scan_itr->first, scan_itr->second);
       }
     }
   }  // if is full scan
@@ -255,11 +319,7 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
-// NOTE: If ints key is used as an optimization just uncommend
-// the following in order to instanciation the template before it is
-// linked in linking stage
-
-/*
+// Ints key, used for keys made of integer columns only
 template class BWTreeIndex<IntsKey<1>,
                            ItemPointer *,
                            IntsComparator<1>,
@@ -288,7 +348,6 @@ template class BWTreeIndex<IntsKey<4>,
                            IntsHasher<4>,
                            ItemPointerComparator,
                            ItemPointerHashFunc>;
-*/
 
 // Generic key
 template class BWTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
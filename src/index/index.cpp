@@ -52,7 +52,8 @@ IndexMetadata::IndexMetadata(std::string index_name,
                              const catalog::Schema *tuple_schema,
                              const catalog::Schema *key_schema,
                              const std::vector<oid_t>& key_attrs,
-                             bool unique_keys) :
+                             bool unique_keys,
+                             oid_t included_column_count) :
   index_name(index_name),
   index_oid(index_oid),
   method_type(method_type),
@@ -61,7 +62,8 @@ IndexMetadata::IndexMetadata(std::string index_name,
   key_schema(key_schema),
   key_attrs(key_attrs),
   tuple_attrs(),
-  unique_keys(unique_keys) {
+  unique_keys(unique_keys),
+  included_column_count(included_column_count) {
 
   // Push the reverse mapping relation into tuple_attrs which maps
   // tuple key's column into index key's column
@@ -80,6 +82,12 @@ IndexMetadata::IndexMetadata(std::string index_name,
     tuple_attrs[tuple_column_id] = i;
   }
 
+  // Included columns trail the columns being searched on. A unique index
+  // compares whole keys, so it would tell keys apart by their included
+  // columns and cannot have any
+  PL_ASSERT(included_column_count <= key_attrs.size());
+  PL_ASSERT(unique_keys == false || included_column_count == 0);
+
   return;
 }
 
@@ -120,7 +128,8 @@ const std::string IndexMetadata::GetInfo() const {
  */
 Index::Index(IndexMetadata *metadata) :
   metadata(metadata),
-  indexed_tile_group_offset(0) {
+  indexed_tile_group_offset(0),
+  readable(true) {
 
   // This is redundant
   index_oid = metadata->GetOid();
@@ -150,11 +159,24 @@ Index::~Index() {
   return;
 }
 
+void Index::AppendKeyValues(const storage::Tuple &key,
+                            std::vector<Value> &result_keys) {
+  for (oid_t column_itr = 0; column_itr < key.GetColumnCount(); column_itr++) {
+    Value value = key.GetValue(column_itr);
+    if (value.GetValueType() == VALUE_TYPE_VARCHAR ||
+        value.GetValueType() == VALUE_TYPE_VARBINARY) {
+      value = value.copyValue();
+    }
+    result_keys.push_back(value);
+  }
+}
+
 void Index::ScanTest(const std::vector<Value> &value_list,
                      const std::vector<oid_t> &tuple_column_id_list,
                      const std::vector<ExpressionType> &expr_list,
                      const ScanDirectionType &scan_direction,
-                     std::vector<ItemPointer *> &result) {
+                     std::vector<ItemPointer *> &result,
+                     size_t limit) {
   IndexScanPredicate isp{};
 
   isp.AddConjunctionScanPredicate(this,
@@ -167,7 +189,8 @@ void Index::ScanTest(const std::vector<Value> &value_list,
        expr_list,
        scan_direction,
        result,
-       &isp.GetConjunctionList()[0]);
+       &isp.GetConjunctionList()[0],
+       limit);
 
   return;
 }
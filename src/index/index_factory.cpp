@@ -23,6 +23,26 @@
 namespace peloton {
 namespace index {
 
+/*
+ * HasIntegerColumnsOnly() - Whether every column of the key schema is an
+ * integer, in which case the key can be packed into an IntsKey
+ */
+static bool HasIntegerColumnsOnly(const catalog::Schema *key_schema) {
+  for (oid_t column_itr = 0; column_itr < key_schema->GetColumnCount();
+       column_itr++) {
+    switch (key_schema->GetType(column_itr)) {
+      case VALUE_TYPE_TINYINT:
+      case VALUE_TYPE_SMALLINT:
+      case VALUE_TYPE_INTEGER:
+      case VALUE_TYPE_BIGINT:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
 Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
 
   LOG_TRACE("Creating index %s", metadata->GetName().c_str());
@@ -58,6 +78,33 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
                             TupleKeyEqualityChecker>(metadata);
     }
   } else if (index_type == INDEX_TYPE_BWTREE) {
+    // Integer keys are packed into words that compare like unsigned
+    // integers, instead of being deserialized column by column
+    if (HasIntegerColumnsOnly(metadata->key_schema) &&
+        key_size <= 4 * sizeof(uint64_t)) {
+      if (key_size <= sizeof(uint64_t)) {
+        return new BWTreeIndex<IntsKey<1>, ItemPointer *, IntsComparator<1>,
+                               IntsEqualityChecker<1>, IntsHasher<1>,
+                               ItemPointerComparator, ItemPointerHashFunc>(
+            metadata);
+      } else if (key_size <= 2 * sizeof(uint64_t)) {
+        return new BWTreeIndex<IntsKey<2>, ItemPointer *, IntsComparator<2>,
+                               IntsEqualityChecker<2>, IntsHasher<2>,
+                               ItemPointerComparator, ItemPointerHashFunc>(
+            metadata);
+      } else if (key_size <= 3 * sizeof(uint64_t)) {
+        return new BWTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
+                               IntsEqualityChecker<3>, IntsHasher<3>,
+                               ItemPointerComparator, ItemPointerHashFunc>(
+            metadata);
+      } else {
+        return new BWTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
+                               IntsEqualityChecker<4>, IntsHasher<4>,
+                               ItemPointerComparator, ItemPointerHashFunc>(
+            metadata);
+      }
+    }
+
     if (key_size <= 4) {
       return new BWTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
                              GenericEqualityChecker<4>, GenericHasher<4>,
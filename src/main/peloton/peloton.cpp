@@ -38,6 +38,7 @@ int main(int argc, char *argv[]) {
 
   // Launch server
   peloton::wire::Server server;
+  server.StartServer();
 
   // Teardown
   peloton::PelotonInit::Shutdown();
@@ -32,6 +32,9 @@ void RunBenchmark() {
   // Initialize settings
   peloton_layout_mode = state.layout_mode;
 
+  // The workload records its own samples, timed per query
+  peloton_sample_rate = 0;
+
   // Generate sequence
   GenerateSequence(state.column_count);
 
@@ -32,6 +32,7 @@ void Usage(FILE *out) {
           "   -u --update-ratio      :  Fraction of updates \n"
           "   -t --transaction-count :  # of transactions \n"
           "   -i --ints-mode         :  Store ints \n"
+          "   -p --prepared-mode     :  Reuse the plan and executors of reads \n"
           );
 }
 
@@ -43,6 +44,7 @@ static struct option opts[] = {
     { "update-ratio", optional_argument, NULL, 'u'},
     { "transaction-count", optional_argument, NULL, 't'},
     { "ints-mode", optional_argument, NULL, 'i'},
+    { "prepared-mode", optional_argument, NULL, 'p'},
     { NULL, 0, NULL, 0}};
 
 void ValidateScaleFactor(const configuration &state) {
@@ -108,6 +110,10 @@ void ValidateIntsMode(const configuration &state) {
   LOG_INFO("%s : %d", "ints_mode", state.ints_mode);
 }
 
+void ValidatePreparedMode(const configuration &state) {
+  LOG_INFO("%s : %d", "prepared_mode", state.prepared_mode);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.scale_factor = 1;
@@ -117,11 +123,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.backend_count = 2;
   state.transaction_count = 0;
   state.ints_mode = true;
+  state.prepared_mode = false;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hb:c:d:k:t:u:i:", opts, &idx);
+    int c = getopt_long(argc, argv, "hb:c:d:k:t:u:i:p:", opts, &idx);
 
     if (c == -1) break;
 
@@ -147,6 +154,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'i':
         state.ints_mode = atoi(optarg);
         break;
+      case 'p':
+        state.prepared_mode = atoi(optarg);
+        break;
 
       case 'h':
         Usage(stderr);
@@ -169,6 +179,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateDuration(state);
   ValidateTransactionCount(state);
   ValidateIntsMode(state);
+  ValidatePreparedMode(state);
 
 }
 
@@ -44,6 +44,7 @@
 
 #include "executor/executor_context.h"
 #include "executor/abstract_executor.h"
+#include "executor/plan_executor.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/materialization_executor.h"
@@ -178,6 +179,16 @@ class ZipfDistribution {
 
 bool RunRead(ZipfDistribution &zipf);
 
+// Plan and executor tree of a backend's reads, built once and bound to the
+// lookup key of every read
+struct PreparedRead {
+  std::unique_ptr<planner::IndexScanPlan> plan;
+  std::unique_ptr<bridge::PlanCursor> cursor;
+  std::vector<Value> params;
+};
+
+bool RunPreparedRead(ZipfDistribution &zipf, PreparedRead &prepared_read);
+
 bool RunInsert(ZipfDistribution &zipf, oid_t next_insert_key);
 
 /////////////////////////////////////////////////////////
@@ -202,6 +213,7 @@ void RunBackend(oid_t thread_id) {
   ZipfDistribution zipf((state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP) - 1,
                         zipf_theta);
   auto committed_transaction_count = 0;
+  PreparedRead prepared_read;
 
   // Partition the domain across backends
   auto insert_key_offset = state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP;
@@ -238,6 +250,8 @@ void RunBackend(oid_t thread_id) {
     if (rng_val < update_ratio) {
       next_insert_key += state.backend_count;
       transaction_status = RunInsert(zipf, next_insert_key);
+    } else if (state.prepared_mode) {
+      transaction_status = RunPreparedRead(zipf, prepared_read);
     } else {
       transaction_status = RunRead(zipf);
     }
@@ -423,6 +437,44 @@ bool RunRead(ZipfDistribution &zipf) {
   return txn_status;
 }
 
+bool RunPreparedRead(ZipfDistribution &zipf, PreparedRead &prepared_read) {
+  // Prepare : index scan on the key given as parameter $1
+  if (prepared_read.plan == nullptr) {
+    std::vector<oid_t> column_ids;
+    oid_t column_count = state.column_count + 1;
+
+    for (oid_t col_itr = 0; col_itr < column_count; col_itr++) {
+      column_ids.push_back(col_itr);
+    }
+
+    auto ycsb_pkey_index =
+        user_table->GetIndexWithOid(user_table_pkey_index_oid);
+
+    planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+        ycsb_pkey_index, {0}, {ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL},
+        {ValueFactory::GetBindingOnlyIntegerValue(0)}, {});
+
+    prepared_read.plan.reset(new planner::IndexScanPlan(
+        user_table, nullptr, column_ids, index_scan_desc));
+    prepared_read.params.resize(1);
+  }
+
+  // Execute : bind the key and run the executor tree of the last read again
+  prepared_read.params[0] = ValueFactory::GetIntegerValue(zipf.GetNextNumber());
+
+  auto &cursor = prepared_read.cursor;
+  if (cursor == nullptr || cursor->Reopen(prepared_read.params) == false) {
+    cursor.reset(
+        new bridge::PlanCursor(prepared_read.plan.get(), prepared_read.params));
+  }
+
+  while (cursor->Next())
+    ;
+
+  auto status = cursor->Close();
+  return status.m_result == Result::RESULT_SUCCESS;
+}
+
 bool RunInsert(UNUSED_ATTRIBUTE ZipfDistribution &zipf, oid_t next_insert_key) {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// access_path.cpp
+//
+// Identification: src/optimizer/access_path.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/access_path.h"
+
+#include <algorithm>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "index/index.h"
+#include "index/scan_optimizer.h"
+#include "optimizer/column_stats.h"
+#include "optimizer/cost_model.h"
+#include "optimizer/table_stats.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Whether the index can be probed with the value for the column, e.g. not a
+// string for an integer column
+static bool IsComparable(ValueType column_type, const Value &value) {
+  ValueType value_type = value.GetValueType();
+  if (value_type == VALUE_TYPE_PARAMETER_OFFSET) return true;
+  if (value_type == column_type) return true;
+  return IsNumeric(value_type) && IsNumeric(column_type);
+}
+
+// Whether the comparison bounds the range of keys the index scan reads
+static bool IsBoundingComparison(ExpressionType compare_type) {
+  switch (compare_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static double EstimateSelectivity(const TableStats *table_stats,
+                                  oid_t column_id, ExpressionType compare_type,
+                                  const Value &value) {
+  if (table_stats != nullptr && column_id < table_stats->GetColumnCount() &&
+      value.GetValueType() != VALUE_TYPE_PARAMETER_OFFSET) {
+    return table_stats->EstimateSelectivity(column_id, compare_type, value);
+  }
+  return (compare_type == EXPRESSION_TYPE_COMPARE_EQUAL)
+             ? DEFAULT_EQUALITY_SELECTIVITY
+             : DEFAULT_RANGE_SELECTIVITY;
+}
+
+// Fraction of the tuples of the table the index matches with the
+// comparisons. Past INDEX_SAMPLE_LIMIT matches the count is only a lower
+// bound, so the estimate is kept if it is higher.
+static double SampleSelectivity(index::Index *index, double tuple_count,
+                                const std::vector<oid_t> &column_ids,
+                                const std::vector<ExpressionType> &expr_types,
+                                const std::vector<Value> &values,
+                                double estimate) {
+  if (tuple_count <= 0) return estimate;
+
+  index::IndexScanPredicate index_predicate;
+  index_predicate.AddConjunctionScanPredicate(index, values, column_ids,
+                                              expr_types);
+
+  std::vector<ItemPointer *> matches;
+  index->Scan(values, column_ids, expr_types, SCAN_DIRECTION_TYPE_FORWARD,
+              matches, &index_predicate.GetConjunctionList()[0],
+              INDEX_SAMPLE_LIMIT);
+
+  double selectivity = std::min(1.0, matches.size() / tuple_count);
+  if (matches.size() < INDEX_SAMPLE_LIMIT) return selectivity;
+  return std::max(selectivity, estimate);
+}
+
+AccessPath ChooseAccessPath(storage::DataTable *table,
+                            const std::vector<oid_t> &column_ids,
+                            const std::vector<ExpressionType> &expr_types,
+                            const std::vector<Value> &values) {
+  PL_ASSERT(column_ids.size() == expr_types.size());
+  PL_ASSERT(column_ids.size() == values.size());
+
+  auto table_stats = table->GetTableStats();
+  double tuple_count = (table_stats != nullptr) ? table_stats->GetTupleCount()
+                                                : table->GetTupleCount();
+  double tile_group_count = table->GetTileGroupCount();
+  auto schema = table->GetSchema();
+
+  AccessPath best_path;
+  best_path.cost = CostModel::SeqScanCost(tuple_count);
+
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); index_itr++) {
+    auto index = table->GetIndex(index_itr);
+    if (index == nullptr || index->IsReadable() == false) continue;
+    auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+
+    // Comparisons the index can evaluate on its keys
+    std::vector<oid_t> key_predicates;
+    for (oid_t predicate_itr = 0; predicate_itr < column_ids.size();
+         predicate_itr++) {
+      oid_t column_id = column_ids[predicate_itr];
+      if (std::find(key_attrs.begin(), key_attrs.end(), column_id) ==
+          key_attrs.end()) {
+        continue;
+      }
+      if (!IsComparable(schema->GetColumn(column_id).GetType(),
+                        values[predicate_itr])) {
+        continue;
+      }
+      key_predicates.push_back(predicate_itr);
+    }
+
+    // Comparisons on the prefix of the key that bounds the scan: equalities
+    // on the leading key columns, then the comparisons on the next one
+    std::vector<oid_t> prefix_column_ids;
+    std::vector<ExpressionType> prefix_expr_types;
+    std::vector<Value> prefix_values;
+    bool has_parameters = false;
+    for (auto key_column_id : key_attrs) {
+      bool bound = false;
+      bool equal = false;
+      for (auto predicate_itr : key_predicates) {
+        if (column_ids[predicate_itr] != key_column_id ||
+            !IsBoundingComparison(expr_types[predicate_itr])) {
+          continue;
+        }
+        bound = true;
+        equal |= (expr_types[predicate_itr] == EXPRESSION_TYPE_COMPARE_EQUAL);
+        has_parameters |= (values[predicate_itr].GetValueType() ==
+                           VALUE_TYPE_PARAMETER_OFFSET);
+
+        prefix_column_ids.push_back(key_column_id);
+        prefix_expr_types.push_back(expr_types[predicate_itr]);
+        prefix_values.push_back(values[predicate_itr]);
+      }
+      if (!bound || !equal) break;
+    }
+
+    // The index would be scanned in full
+    if (prefix_column_ids.empty()) continue;
+
+    // The comparisons are assumed to be independent
+    double selectivity = 1;
+    for (oid_t prefix_itr = 0; prefix_itr < prefix_column_ids.size();
+         prefix_itr++) {
+      selectivity *= EstimateSelectivity(
+          table_stats.get(), prefix_column_ids[prefix_itr],
+          prefix_expr_types[prefix_itr], prefix_values[prefix_itr]);
+    }
+    if (table_stats == nullptr && !has_parameters) {
+      selectivity =
+          SampleSelectivity(index.get(), tuple_count, prefix_column_ids,
+                            prefix_expr_types, prefix_values, selectivity);
+    }
+
+    double matches = tuple_count * selectivity;
+    double index_cost = CostModel::IndexScanCost(tuple_count, matches);
+    double bitmap_cost =
+        CostModel::BitmapScanCost(tuple_count, matches, tile_group_count);
+    LOG_TRACE("Index %u : selectivity %f index scan %f bitmap scan %f",
+              index_itr, selectivity, index_cost, bitmap_cost);
+
+    double cost = std::min(index_cost, bitmap_cost);
+    if (cost >= best_path.cost) continue;
+
+    best_path.type = (bitmap_cost < index_cost) ? AccessPathType::BitmapScan
+                                                : AccessPathType::IndexScan;
+    best_path.index_offset = index_itr;
+    best_path.key_predicates = key_predicates;
+    best_path.selectivity = selectivity;
+    best_path.cost = cost;
+  }
+
+  return best_path;
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -51,7 +51,7 @@ GroupBindingIterator::GroupBindingIterator(Optimizer &optimizer, GroupID id,
 
 bool GroupBindingIterator::HasNext() {
   LOG_TRACE("HasNext");
-  if (pattern->Type() == OpType::Leaf) {
+  if (pattern->Type() == OpType::Leaf || pattern->Type() == OpType::Tree) {
     return current_item_index == 0;
   }
 
@@ -87,9 +87,24 @@ std::shared_ptr<OpExpression> GroupBindingIterator::Next() {
     current_item_index = num_group_items;
     return std::make_shared<OpExpression>(LeafOperator::make(group_id));
   }
+  if (pattern->Type() == OpType::Tree) {
+    current_item_index = num_group_items;
+    return BuildTree(group_id);
+  }
   return current_iterator->Next();
 }
 
+std::shared_ptr<OpExpression> GroupBindingIterator::BuildTree(GroupID id) {
+  // Expression groups hold a single expression
+  std::shared_ptr<GroupExpression> gexpr =
+      memo.GetGroupByID(id)->GetExpressions()[0];
+  auto tree = std::make_shared<OpExpression>(gexpr->Op());
+  for (GroupID child_group : gexpr->GetChildGroupIDs()) {
+    tree->PushChild(BuildTree(child_group));
+  }
+  return tree;
+}
+
 //===--------------------------------------------------------------------===//
 // Item Binding Iterator
 //===--------------------------------------------------------------------===//
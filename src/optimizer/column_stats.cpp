@@ -0,0 +1,217 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_stats.cpp
+//
+// Identification: src/optimizer/column_stats.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/column_stats.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "common/value_peeker.h"
+
+namespace peloton {
+namespace optimizer {
+
+static bool ValueLess(const Value &lhs, const Value &rhs) {
+  return lhs.Compare(rhs) == VALUE_COMPARE_LESSTHAN;
+}
+
+static double ClampFraction(double fraction) {
+  return std::min(1.0, std::max(0.0, fraction));
+}
+
+// Whether the histogram can interpolate between values of the type
+static bool IsInterpolable(ValueType value_type) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DECIMAL:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ColumnStats::ColumnStats(std::vector<Value> &&sample, double null_fraction,
+                         double distinct_count, size_t max_mcv_count,
+                         size_t histogram_bucket_count)
+    : null_fraction_(null_fraction), distinct_count_(distinct_count) {
+  if (sample.empty()) return;
+
+  std::sort(sample.begin(), sample.end(), ValueLess);
+
+  // Runs of equal values in the sorted sample, as (offset, length)
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (size_t run_begin = 0; run_begin < sample.size();) {
+    size_t run_end = run_begin + 1;
+    while (run_end < sample.size() &&
+           sample[run_end].Compare(sample[run_begin]) == VALUE_COMPARE_EQUAL) {
+      run_end++;
+    }
+    runs.emplace_back(run_begin, run_end - run_begin);
+    run_begin = run_end;
+  }
+
+  // Every distinct value of the sample is in the table
+  distinct_count_ = std::max(distinct_count_, static_cast<double>(runs.size()));
+
+  // The values sampled more often than the average one are the most common
+  // ones, or all of them if there are only a few
+  std::vector<std::pair<size_t, size_t>> mcv_runs;
+  if (runs.size() <= max_mcv_count) {
+    mcv_runs = runs;
+  } else {
+    double average_run_length =
+        static_cast<double>(sample.size()) / runs.size();
+    for (auto &run : runs) {
+      if (run.second > 1 && run.second > 1.25 * average_run_length) {
+        mcv_runs.push_back(run);
+      }
+    }
+  }
+  std::stable_sort(mcv_runs.begin(), mcv_runs.end(),
+                   [](const std::pair<size_t, size_t> &lhs,
+                      const std::pair<size_t, size_t> &rhs) {
+                     return lhs.second > rhs.second;
+                   });
+  if (mcv_runs.size() > max_mcv_count) mcv_runs.resize(max_mcv_count);
+
+  // Share of the rows of the table a sampled value stands for
+  double value_share = (1 - null_fraction_) / sample.size();
+
+  std::vector<bool> is_mcv(sample.size(), false);
+  for (auto &run : mcv_runs) {
+    mcvs_.push_back(sample[run.first]);
+    mcv_frequencies_.push_back(run.second * value_share);
+    std::fill(is_mcv.begin() + run.first,
+              is_mcv.begin() + run.first + run.second, true);
+  }
+
+  // Equi-depth histogram of the remaining values, which are still sorted
+  std::vector<Value> histogram_values;
+  for (size_t value_itr = 0; value_itr < sample.size(); value_itr++) {
+    if (is_mcv[value_itr] == false) {
+      histogram_values.push_back(std::move(sample[value_itr]));
+    }
+  }
+  if (histogram_values.empty()) return;
+
+  histogram_fraction_ = histogram_values.size() * value_share;
+
+  size_t last_value = histogram_values.size() - 1;
+  size_t bucket_count =
+      std::max<size_t>(1, std::min(histogram_bucket_count, last_value));
+  for (size_t bound_itr = 0; bound_itr <= bucket_count; bound_itr++) {
+    histogram_bounds_.push_back(
+        histogram_values[bound_itr * last_value / bucket_count]);
+  }
+}
+
+double ColumnStats::EstimateSelectivity(ExpressionType compare_type,
+                                        const Value &value) const {
+  // Comparisons with nulls are never true
+  if (value.IsNull()) return 0;
+
+  switch (compare_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return EstimateEqual(value);
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      return ClampFraction(1 - null_fraction_ - EstimateEqual(value));
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EstimateLess(value, false);
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EstimateLess(value, true);
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return ClampFraction(1 - null_fraction_ - EstimateLess(value, true));
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return ClampFraction(1 - null_fraction_ - EstimateLess(value, false));
+    default:
+      return DEFAULT_RANGE_SELECTIVITY;
+  }
+}
+
+double ColumnStats::EstimateEqual(const Value &value) const {
+  for (size_t mcv_itr = 0; mcv_itr < mcvs_.size(); mcv_itr++) {
+    if (mcvs_[mcv_itr].Compare(value) == VALUE_COMPARE_EQUAL) {
+      return mcv_frequencies_[mcv_itr];
+    }
+  }
+
+  // The other values are assumed to be equally frequent
+  double other_distinct_count =
+      std::max(1.0, distinct_count_ - static_cast<double>(mcvs_.size()));
+  return ClampFraction(histogram_fraction_ / other_distinct_count);
+}
+
+double ColumnStats::EstimateLess(const Value &value, bool inclusive) const {
+  double fraction = 0;
+  for (size_t mcv_itr = 0; mcv_itr < mcvs_.size(); mcv_itr++) {
+    auto compare = mcvs_[mcv_itr].Compare(value);
+    if (compare == VALUE_COMPARE_LESSTHAN ||
+        (inclusive && compare == VALUE_COMPARE_EQUAL)) {
+      fraction += mcv_frequencies_[mcv_itr];
+    }
+  }
+
+  fraction += histogram_fraction_ * HistogramFractionBelow(value);
+  return ClampFraction(fraction);
+}
+
+double ColumnStats::HistogramFractionBelow(const Value &value) const {
+  if (histogram_bounds_.empty()) return 0;
+
+  if (value.Compare(histogram_bounds_.front()) != VALUE_COMPARE_GREATERTHAN) {
+    return 0;
+  }
+  if (value.Compare(histogram_bounds_.back()) != VALUE_COMPARE_LESSTHAN) {
+    return 1;
+  }
+
+  // The value lies in the bucket ending at the first bound greater than it
+  auto upper_bound = std::upper_bound(
+      histogram_bounds_.begin(), histogram_bounds_.end(), value, ValueLess);
+  size_t bucket = upper_bound - histogram_bounds_.begin() - 1;
+  const Value &lower_bound = histogram_bounds_[bucket];
+
+  // Values are spread evenly within a bucket
+  double position = 0.5;
+  if (IsInterpolable(value.GetValueType()) &&
+      IsInterpolable(lower_bound.GetValueType())) {
+    double low = ValuePeeker::PeekAsDouble(lower_bound);
+    double high = ValuePeeker::PeekAsDouble(*upper_bound);
+    if (high > low) {
+      position = ClampFraction((ValuePeeker::PeekAsDouble(value) - low) /
+                               (high - low));
+    }
+  }
+
+  return (bucket + position) / (histogram_bounds_.size() - 1);
+}
+
+const std::string ColumnStats::GetInfo() const {
+  std::ostringstream os;
+
+  os << "ColumnStats: null fraction " << null_fraction_ << ", distinct count "
+     << distinct_count_ << ", " << mcvs_.size() << " most common values, "
+     << (histogram_bounds_.empty() ? 0 : histogram_bounds_.size() - 1)
+     << " histogram buckets";
+
+  return os.str();
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -13,8 +13,12 @@
 
 #include "optimizer/convert_op_to_plan.h"
 #include "optimizer/operator_visitor.h"
+#include "optimizer/predicate_util.h"
+#include "common/value_factory.h"
 
 #include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/nested_loop_index_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/seq_scan_plan.h"
 #include "planner/projection_plan.h"
@@ -152,7 +156,7 @@ class OpToPlanTransformer : public OperatorVisitor {
   planner::AbstractPlan *ConvertOpExpression(
       std::shared_ptr<OpExpression> plan) {
     VisitOpExpression(plan);
-    return output_plan.get();
+    return output_plan.release();
   }
 
   void visit(const PhysicalScan *op) override {
@@ -223,29 +227,18 @@ class OpToPlanTransformer : public OperatorVisitor {
     auto children = current_children;
     assert(children.size() == 3);
 
-    /* TODO: Fix ownership
     VisitOpExpression(children[0]);
-    //planner::AbstractPlan *left_child = output_plan;
-    left_columns = output_columns;
+    std::unique_ptr<planner::AbstractPlan> left_child = std::move(output_plan);
+    std::vector<Column *> left_output_columns = output_columns;
 
     VisitOpExpression(children[1]);
-    //planner::AbstractPlan *right_child = output_plan;
+    std::unique_ptr<planner::AbstractPlan> right_child =
+        std::move(output_plan);
     right_columns = output_columns;
+    left_columns = left_output_columns;
 
-    expression::AbstractExpression *predicate =
-      ConvertToAbstractExpression(children[2]);
-
-    output_columns = ConcatLeftAndRightColumns();
-
-    catalog::Schema *project_schema = BuildSchemaFromColumns(output_columns);
-    planner::ProjectInfo *proj_info =
-      BuildProjectInfoFromColumns(output_columns);
-
-    output_plan = new planner::NestedLoopJoinPlan(
-      JOIN_TYPE_INNER, predicate, proj_info, project_schema, nullptr);
-    output_plan->AddChild(left_child);
-    output_plan->AddChild(right_child);
-    */
+    MakeNLJoinPlan(children[2], std::move(left_child),
+                   std::move(right_child));
   }
 
   void visit(const PhysicalLeftNLJoin *) override {}
@@ -255,19 +248,71 @@ class OpToPlanTransformer : public OperatorVisitor {
   void visit(const PhysicalOuterNLJoin *) override {}
 
   void visit(const PhysicalInnerHashJoin *) override {
-    // auto children = current_children;
-    // assert(children.size() == 2);
+    auto children = current_children;
+    assert(children.size() == 3);
+
+    VisitOpExpression(children[0]);
+    std::unique_ptr<planner::AbstractPlan> left_child = std::move(output_plan);
+    std::vector<Column *> left_output_columns = output_columns;
+
+    VisitOpExpression(children[1]);
+    std::unique_ptr<planner::AbstractPlan> right_child =
+        std::move(output_plan);
+    right_columns = output_columns;
+    left_columns = left_output_columns;
+
+    // The right side is hashed on its columns of the equality terms and
+    // probed with the matching left columns
+    std::vector<oid_t> left_key_ids;
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        hash_keys;
+    for (std::shared_ptr<OpExpression> term : SplitConjunction(children[2])) {
+      Column *left_column;
+      Column *right_column;
+      if (IsEquiJoinTerm(*term, left_column, right_column) == false) continue;
+
+      oid_t left_table_idx, left_column_idx;
+      oid_t right_table_idx, right_column_idx;
+      std::tie(left_table_idx, left_column_idx) =
+          FindRelativeIndex(left_columns, right_columns, left_column);
+      std::tie(right_table_idx, right_column_idx) =
+          FindRelativeIndex(left_columns, right_columns, right_column);
+      if (left_table_idx == 1 && right_table_idx == 0) {
+        std::swap(left_column_idx, right_column_idx);
+      } else if (left_table_idx != 0 || right_table_idx != 1) {
+        continue;
+      }
+
+      left_key_ids.push_back(left_column_idx);
+      hash_keys.emplace_back(expression::ExpressionUtil::TupleValueFactory(
+          VALUE_TYPE_NULL, 1, right_column_idx));
+    }
+
+    if (hash_keys.empty()) {
+      MakeNLJoinPlan(children[2], std::move(left_child),
+                     std::move(right_child));
+      return;
+    }
 
-    // VisitOpExpression(children[0]);
-    // planner::AbstractPlan *lef_child = output_plan;
-    // left_columns = output_columns;
+    std::unique_ptr<planner::AbstractPlan> hash_plan(
+        new planner::HashPlan(hash_keys));
+    hash_plan->AddChild(std::move(right_child));
 
-    // VisitOpExpression(children[1]);
-    // planner::AbstractPlan *right_child = output_plan;
-    // right_columns = output_columns;
+    // Matches of the hash table are checked against the whole predicate
+    std::unique_ptr<const expression::AbstractExpression> predicate(
+        ConvertToAbstractExpression(children[2]));
 
-    // planner::AbstractPlan *right_hash =
-    //   new planner::HashPlan();
+    output_columns = ConcatLeftAndRightColumns();
+    std::shared_ptr<const catalog::Schema> schema(
+        BuildSchemaFromColumns(output_columns));
+    std::unique_ptr<const planner::ProjectInfo> proj_info(
+        BuildProjectInfoFromColumns(output_columns));
+
+    output_plan.reset(new planner::HashJoinPlan(
+        JOIN_TYPE_INNER, std::move(predicate), std::move(proj_info), schema,
+        left_key_ids));
+    output_plan->AddChild(std::move(left_child));
+    output_plan->AddChild(std::move(hash_plan));
   }
 
   void visit(const PhysicalLeftHashJoin *) override {}
@@ -276,6 +321,53 @@ class OpToPlanTransformer : public OperatorVisitor {
 
   void visit(const PhysicalOuterHashJoin *) override {}
 
+  void visit(const PhysicalInnerIndexNLJoin *op) override {
+    auto children = current_children;
+    assert(children.size() == 2);
+
+    VisitOpExpression(children[0]);
+    std::unique_ptr<planner::AbstractPlan> outer_child =
+        std::move(output_plan);
+    left_columns = output_columns;
+    right_columns = op->columns;
+
+    // Gets hold all the columns of their tables in schema order, so the
+    // predicate can refer to the table tuples of the inner side by the
+    // offsets of their columns
+    std::vector<oid_t> inner_column_ids;
+    for (Column *column : op->columns) {
+      TableColumn *table_column = dynamic_cast<TableColumn *>(column);
+      assert(table_column != nullptr);
+      assert(table_column->ColumnIndexOid() == inner_column_ids.size());
+      inner_column_ids.push_back(table_column->ColumnIndexOid());
+    }
+
+    // The index is probed with the key of each outer tuple
+    oid_t outer_table_idx, outer_column_idx;
+    std::tie(outer_table_idx, outer_column_idx) =
+        FindRelativeIndex(left_columns, {}, op->outer_key_column);
+    assert(outer_table_idx == 0);
+    std::vector<oid_t> key_column_ids = {
+        static_cast<TableColumn *>(op->inner_key_column)->ColumnIndexOid()};
+    std::vector<ExpressionType> expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL};
+    std::vector<Value> values = {ValueFactory::GetNullValue()};
+
+    std::unique_ptr<const expression::AbstractExpression> predicate(
+        ConvertToAbstractExpression(children[1]));
+
+    output_columns = ConcatLeftAndRightColumns();
+    std::shared_ptr<const catalog::Schema> schema(
+        BuildSchemaFromColumns(output_columns));
+    std::unique_ptr<const planner::ProjectInfo> proj_info(
+        BuildProjectInfoFromColumns(output_columns));
+
+    output_plan.reset(new planner::NestedLoopIndexJoinPlan(
+        JOIN_TYPE_INNER, std::move(predicate), std::move(proj_info), schema,
+        op->table, inner_column_ids, op->table->GetIndex(op->index_offset),
+        key_column_ids, expr_types, values, {outer_column_idx}));
+    output_plan->AddChild(std::move(outer_child));
+  }
+
  private:
   void VisitOpExpression(std::shared_ptr<OpExpression> op) {
     std::vector<std::shared_ptr<OpExpression>> prev_children = current_children;
@@ -294,6 +386,26 @@ class OpToPlanTransformer : public OperatorVisitor {
                                                    right_columns);
   }
 
+  // Nested loop join of the two children, whose output columns are the left
+  // and right columns
+  void MakeNLJoinPlan(std::shared_ptr<OpExpression> predicate_expr,
+                      std::unique_ptr<planner::AbstractPlan> left_child,
+                      std::unique_ptr<planner::AbstractPlan> right_child) {
+    std::unique_ptr<const expression::AbstractExpression> predicate(
+        ConvertToAbstractExpression(predicate_expr));
+
+    output_columns = ConcatLeftAndRightColumns();
+    std::shared_ptr<const catalog::Schema> schema(
+        BuildSchemaFromColumns(output_columns));
+    std::unique_ptr<const planner::ProjectInfo> proj_info(
+        BuildProjectInfoFromColumns(output_columns));
+
+    output_plan.reset(new planner::NestedLoopJoinPlan(
+        JOIN_TYPE_INNER, std::move(predicate), std::move(proj_info), schema));
+    output_plan->AddChild(std::move(left_child));
+    output_plan->AddChild(std::move(right_child));
+  }
+
   catalog::Schema *BuildSchemaFromColumns(std::vector<Column *> columns) {
     std::vector<catalog::Column> schema_columns;
     for (Column *column : columns) {
@@ -0,0 +1,386 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cost_model.cpp
+//
+// Identification: src/optimizer/cost_model.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "optimizer/memo.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace optimizer {
+
+static double ClampFraction(double fraction) {
+  return std::min(1.0, std::max(0.0, fraction));
+}
+
+// The comparison with its operands swapped
+static ExpressionType CommuteComparison(ExpressionType compare_type) {
+  switch (compare_type) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return compare_type;
+  }
+}
+
+// Selectivity of a comparison on columns without statistics
+static double DefaultSelectivity(ExpressionType compare_type) {
+  switch (compare_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return DEFAULT_EQUALITY_SELECTIVITY;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      return 1 - DEFAULT_EQUALITY_SELECTIVITY;
+    default:
+      return DEFAULT_RANGE_SELECTIVITY;
+  }
+}
+
+static double EstimateCompareSelectivity(const OpExpression &compare,
+                                         const Stats &input) {
+  ExpressionType compare_type = compare.Op().as<ExprCompare>()->expr_type;
+  auto &children = compare.Children();
+  if (children.size() != 2) return DefaultSelectivity(compare_type);
+
+  auto left_type = children[0]->Op().type();
+  auto right_type = children[1]->Op().type();
+
+  // Column compared with a value
+  if (left_type == OpType::Variable && right_type == OpType::Constant) {
+    auto column_stats = input.GetColumnStats(
+        children[0]->Op().as<ExprVariable>()->column);
+    if (column_stats == nullptr) return DefaultSelectivity(compare_type);
+    return column_stats->EstimateSelectivity(
+        compare_type, children[1]->Op().as<ExprConstant>()->value);
+  }
+  if (left_type == OpType::Constant && right_type == OpType::Variable) {
+    auto column_stats = input.GetColumnStats(
+        children[1]->Op().as<ExprVariable>()->column);
+    if (column_stats == nullptr) return DefaultSelectivity(compare_type);
+    return column_stats->EstimateSelectivity(
+        CommuteComparison(compare_type),
+        children[0]->Op().as<ExprConstant>()->value);
+  }
+
+  // Two columns are equal as often as a value of the column with more
+  // distinct values is, assuming the values of the other one are among them
+  if (left_type == OpType::Variable && right_type == OpType::Variable &&
+      (compare_type == EXPRESSION_TYPE_COMPARE_EQUAL ||
+       compare_type == EXPRESSION_TYPE_COMPARE_NOTEQUAL)) {
+    auto left_stats =
+        input.GetColumnStats(children[0]->Op().as<ExprVariable>()->column);
+    auto right_stats =
+        input.GetColumnStats(children[1]->Op().as<ExprVariable>()->column);
+    if (left_stats == nullptr && right_stats == nullptr) {
+      return DefaultSelectivity(compare_type);
+    }
+
+    double distinct_count = 1;
+    double null_fraction = 0;
+    for (auto column_stats : {left_stats, right_stats}) {
+      if (column_stats == nullptr) continue;
+      distinct_count =
+          std::max(distinct_count, column_stats->GetDistinctCount());
+      null_fraction = std::max(null_fraction, column_stats->GetNullFraction());
+    }
+    double equal_selectivity = (1 - null_fraction) / distinct_count;
+    if (compare_type == EXPRESSION_TYPE_COMPARE_EQUAL) return equal_selectivity;
+    return 1 - null_fraction - equal_selectivity;
+  }
+
+  return DefaultSelectivity(compare_type);
+}
+
+CostModel::CostModel(Memo *memo)
+    : memo(memo),
+      gexpr(nullptr),
+      child_stats(nullptr),
+      child_costs(nullptr),
+      output_cost(0) {}
+
+void CostModel::DeriveStatsAndCost(
+    const GroupExpression &gexpr,
+    const std::vector<std::shared_ptr<Stats>> &child_stats,
+    const std::vector<double> &child_costs,
+    std::shared_ptr<Stats> &output_stats, double &output_cost) {
+  this->gexpr = &gexpr;
+  this->child_stats = &child_stats;
+  this->child_costs = &child_costs;
+
+  // Expressions have no stats of their own and cost nothing, their cost is
+  // part of the operator evaluating them
+  this->output_stats.reset();
+  this->output_cost = 0;
+
+  gexpr.Op().accept(this);
+
+  output_stats = this->output_stats;
+  output_cost = this->output_cost;
+}
+
+//===--------------------------------------------------------------------===//
+// Estimates
+//===--------------------------------------------------------------------===//
+
+std::shared_ptr<Stats> CostModel::GetTableStats(storage::DataTable *table) {
+  auto table_stats = table->GetTableStats();
+  double cardinality = (table_stats != nullptr) ? table_stats->GetTupleCount()
+                                                : table->GetTupleCount();
+
+  std::shared_ptr<Stats> stats(new Stats(cardinality));
+  stats->AddTableStats(table->GetOid(), table_stats);
+  return stats;
+}
+
+double CostModel::EstimateSelectivity(const OpExpression &predicate,
+                                      const Stats &input) {
+  switch (predicate.Op().type()) {
+    case OpType::Constant: {
+      const Value &value = predicate.Op().as<ExprConstant>()->value;
+      if (value.GetValueType() != VALUE_TYPE_BOOLEAN) return 1;
+      return value.IsTrue() ? 1 : 0;
+    }
+
+    case OpType::Compare:
+      return ClampFraction(EstimateCompareSelectivity(predicate, input));
+
+    case OpType::BoolOp: {
+      std::vector<double> selectivities;
+      for (auto &child : predicate.Children()) {
+        selectivities.push_back(EstimateSelectivity(*child, input));
+      }
+
+      // The terms are assumed to be independent
+      switch (predicate.Op().as<ExprBoolOp>()->bool_type) {
+        case BoolOpType::Not:
+          return 1 - selectivities.front();
+        case BoolOpType::And: {
+          double selectivity = 1;
+          for (double term : selectivities) selectivity *= term;
+          return selectivity;
+        }
+        case BoolOpType::Or: {
+          double miss_fraction = 1;
+          for (double term : selectivities) miss_fraction *= 1 - term;
+          return 1 - miss_fraction;
+        }
+      }
+      return DEFAULT_RANGE_SELECTIVITY;
+    }
+
+    default:
+      return DEFAULT_RANGE_SELECTIVITY;
+  }
+}
+
+std::shared_ptr<Stats> CostModel::EstimateJoin(const Stats &left,
+                                               const Stats &right,
+                                               const OpExpression &predicate) {
+  // The predicate sees the columns of both sides
+  Stats input(left.GetCardinality() * right.GetCardinality());
+  input.AddTableStats(left);
+  input.AddTableStats(right);
+
+  std::shared_ptr<Stats> output(new Stats(
+      input.GetCardinality() * EstimateSelectivity(predicate, input)));
+  output->AddTableStats(input);
+  return output;
+}
+
+double CostModel::NLJoinCost(double outer, double inner, double output) {
+  // Every pair of tuples is checked
+  return outer * inner * CPU_OPERATOR_COST + output * CPU_TUPLE_COST;
+}
+
+double CostModel::HashJoinCost(double probe, double build, double output) {
+  return build * HASH_BUILD_COST + probe * HASH_PROBE_COST +
+         output * CPU_TUPLE_COST;
+}
+
+double CostModel::IndexNLJoinCost(double outer, double inner, double matches,
+                                  double output) {
+  // Each probe descends the index, each match is fetched from the table
+  double probe_cost =
+      std::log2(inner + 2) * CPU_OPERATOR_COST + RANDOM_TUPLE_COST;
+  return outer * probe_cost +
+         matches * (RANDOM_TUPLE_COST + CPU_OPERATOR_COST) +
+         output * CPU_TUPLE_COST;
+}
+
+double CostModel::SeqScanCost(double tuples) {
+  return tuples * (SEQ_TUPLE_COST + CPU_OPERATOR_COST);
+}
+
+double CostModel::IndexScanCost(double tuples, double matches) {
+  double descent_cost = std::log2(tuples + 2) * CPU_OPERATOR_COST;
+  return descent_cost +
+         matches * (INDEX_TUPLE_COST + RANDOM_TUPLE_COST + CPU_OPERATOR_COST);
+}
+
+double CostModel::BitmapScanCost(double tuples, double matches,
+                                 double tile_groups) {
+  double descent_cost = std::log2(tuples + 2) * CPU_OPERATOR_COST;
+  double sort_cost = std::log2(matches + 2) * CPU_OPERATOR_COST;
+
+  // Tile groups holding at least one match, the matches being spread
+  // uniformly over the table
+  double visited_tile_groups = 0;
+  if (tuples > 0 && tile_groups > 0) {
+    double selectivity = ClampFraction(matches / tuples);
+    visited_tile_groups =
+        tile_groups *
+        (1 - std::pow(1 - selectivity, tuples / tile_groups));
+  }
+
+  // A tile group is reached at random, its matches are then read in order
+  return descent_cost + visited_tile_groups * RANDOM_TUPLE_COST +
+         matches * (INDEX_TUPLE_COST + sort_cost + SEQ_TUPLE_COST +
+                    CPU_OPERATOR_COST);
+}
+
+//===--------------------------------------------------------------------===//
+// Operators
+//===--------------------------------------------------------------------===//
+
+void CostModel::visit(const PhysicalScan *op) {
+  output_stats = GetTableStats(op->table);
+  output_cost = output_stats->GetCardinality() * SEQ_TUPLE_COST;
+}
+
+void CostModel::visit(const PhysicalComputeExprs *) {
+  auto &input = *child_stats->at(0);
+
+  output_stats.reset(new Stats(input.GetCardinality()));
+  output_cost =
+      child_costs->at(0) + input.GetCardinality() * CPU_TUPLE_COST;
+}
+
+void CostModel::visit(const PhysicalFilter *) {
+  auto &input = *child_stats->at(0);
+  auto predicate = GetPredicate(gexpr->GetChildGroupIDs()[1]);
+  double cardinality =
+      input.GetCardinality() * EstimateSelectivity(*predicate, input);
+
+  output_stats.reset(new Stats(cardinality));
+  output_stats->AddTableStats(input);
+  output_cost = child_costs->at(0) +
+                input.GetCardinality() * CPU_OPERATOR_COST +
+                cardinality * CPU_TUPLE_COST;
+}
+
+void CostModel::visit(const PhysicalInnerNLJoin *) {
+  DeriveNLJoin(false, false);
+}
+
+void CostModel::visit(const PhysicalLeftNLJoin *) { DeriveNLJoin(true, false); }
+
+void CostModel::visit(const PhysicalRightNLJoin *) {
+  DeriveNLJoin(false, true);
+}
+
+void CostModel::visit(const PhysicalOuterNLJoin *) { DeriveNLJoin(true, true); }
+
+void CostModel::visit(const PhysicalInnerHashJoin *) {
+  DeriveHashJoin(false, false);
+}
+
+void CostModel::visit(const PhysicalLeftHashJoin *) {
+  DeriveHashJoin(true, false);
+}
+
+void CostModel::visit(const PhysicalRightHashJoin *) {
+  DeriveHashJoin(false, true);
+}
+
+void CostModel::visit(const PhysicalOuterHashJoin *) {
+  DeriveHashJoin(true, true);
+}
+
+void CostModel::visit(const PhysicalInnerIndexNLJoin *op) {
+  // The inner table is only read through the index
+  auto &outer = *child_stats->at(0);
+  auto inner = GetTableStats(op->table);
+  auto predicate = GetPredicate(gexpr->GetChildGroupIDs()[1]);
+
+  // The index returns the tuples matching on the key
+  OpExpression key_term(ExprCompare::make(EXPRESSION_TYPE_COMPARE_EQUAL));
+  key_term.PushChild(
+      std::make_shared<OpExpression>(ExprVariable::make(op->outer_key_column)));
+  key_term.PushChild(
+      std::make_shared<OpExpression>(ExprVariable::make(op->inner_key_column)));
+  auto matches = EstimateJoin(outer, *inner, key_term);
+
+  output_stats = EstimateJoin(outer, *inner, *predicate);
+  output_cost = child_costs->at(0) +
+                IndexNLJoinCost(outer.GetCardinality(), inner->GetCardinality(),
+                                matches->GetCardinality(),
+                                output_stats->GetCardinality());
+}
+
+std::shared_ptr<OpExpression> CostModel::GetPredicate(GroupID group_id) const {
+  // Expression groups hold a single expression
+  std::shared_ptr<GroupExpression> predicate_gexpr =
+      memo->GetGroupByID(group_id)->GetExpressions()[0];
+
+  auto predicate = std::make_shared<OpExpression>(predicate_gexpr->Op());
+  for (GroupID child_group : predicate_gexpr->GetChildGroupIDs()) {
+    predicate->PushChild(GetPredicate(child_group));
+  }
+  return predicate;
+}
+
+std::shared_ptr<Stats> CostModel::DeriveJoinStats(bool keep_left,
+                                                  bool keep_right) {
+  auto &left = *child_stats->at(0);
+  auto &right = *child_stats->at(1);
+  auto predicate = GetPredicate(gexpr->GetChildGroupIDs()[2]);
+
+  auto stats = EstimateJoin(left, right, *predicate);
+
+  // Outer joins return each tuple of their outer sides at least once
+  double cardinality = stats->GetCardinality();
+  if (keep_left) cardinality = std::max(cardinality, left.GetCardinality());
+  if (keep_right) cardinality = std::max(cardinality, right.GetCardinality());
+  if (cardinality == stats->GetCardinality()) return stats;
+
+  std::shared_ptr<Stats> outer_stats(new Stats(cardinality));
+  outer_stats->AddTableStats(*stats);
+  return outer_stats;
+}
+
+void CostModel::DeriveNLJoin(bool keep_left, bool keep_right) {
+  output_stats = DeriveJoinStats(keep_left, keep_right);
+  output_cost = child_costs->at(0) + child_costs->at(1) +
+                NLJoinCost(child_stats->at(0)->GetCardinality(),
+                           child_stats->at(1)->GetCardinality(),
+                           output_stats->GetCardinality());
+}
+
+void CostModel::DeriveHashJoin(bool keep_left, bool keep_right) {
+  // The right side is hashed, the left one probes
+  output_stats = DeriveJoinStats(keep_left, keep_right);
+  output_cost = child_costs->at(0) + child_costs->at(1) +
+                HashJoinCost(child_stats->at(0)->GetCardinality(),
+                             child_stats->at(1)->GetCardinality(),
+                             output_stats->GetCardinality());
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -13,6 +13,7 @@
 
 #include "optimizer/group_expression.h"
 #include "optimizer/group.h"
+#include "optimizer/cost_model.h"
 
 namespace peloton {
 namespace optimizer {
@@ -38,10 +39,10 @@ std::shared_ptr<Stats> GroupExpression::GetStats() const { return stats; }
 double GroupExpression::GetCost() const { return cost; }
 
 void GroupExpression::DeriveStatsAndCost(
-    std::vector<std::shared_ptr<Stats>> child_stats,
+    Memo *memo, std::vector<std::shared_ptr<Stats>> child_stats,
     std::vector<double> child_costs) {
-  (void)child_stats;
-  (void)child_costs;
+  CostModel cost_model(memo);
+  cost_model.DeriveStatsAndCost(*this, child_stats, child_costs, stats, cost);
 }
 
 hash_t GroupExpression::Hash() const {
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.cpp
+//
+// Identification: src/optimizer/hyperloglog.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/hyperloglog.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/macros.h"
+#include "common/value.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Finalizer of MurmurHash3, spreads the bits of the value hashes, which are
+// not mixed well enough for the registers
+static uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+    : precision_(precision), registers_(1 << precision, 0) {
+  PL_ASSERT(precision >= 4 && precision <= 16);
+}
+
+void HyperLogLog::AddValue(const Value &value) {
+  std::size_t hash = 0;
+  value.HashCombine(hash);
+  AddHash(MixHash(hash));
+}
+
+void HyperLogLog::AddHash(uint64_t hash) {
+  // The leading bits pick the register, which keeps the longest run of
+  // leading zeros of the remaining bits. The sentinel bit bounds the run.
+  uint64_t register_id = hash >> (64 - precision_);
+  uint64_t remaining_bits =
+      (hash << precision_) | (uint64_t(1) << (precision_ - 1));
+  uint8_t rank = __builtin_clzll(remaining_bits) + 1;
+
+  registers_[register_id] = std::max(registers_[register_id], rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+  PL_ASSERT(precision_ == other.precision_);
+  for (size_t register_id = 0; register_id < registers_.size();
+       register_id++) {
+    registers_[register_id] =
+        std::max(registers_[register_id], other.registers_[register_id]);
+  }
+}
+
+double HyperLogLog::Estimate() const {
+  double register_count = registers_.size();
+  double alpha = 0.7213 / (1 + 1.079 / register_count);
+
+  double sum = 0;
+  size_t empty_registers = 0;
+  for (auto rank : registers_) {
+    sum += std::ldexp(1.0, -rank);
+    if (rank == 0) empty_registers++;
+  }
+
+  double estimate = alpha * register_count * register_count / sum;
+
+  // Linear counting is more accurate for small cardinalities. The 64 bit
+  // hashes need no correction for large ones.
+  if (estimate <= 2.5 * register_count && empty_registers != 0) {
+    estimate = register_count * std::log(register_count / empty_registers);
+  }
+
+  return estimate;
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
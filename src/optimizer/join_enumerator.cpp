@@ -0,0 +1,530 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_enumerator.cpp
+//
+// Identification: src/optimizer/join_enumerator.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/join_enumerator.h"
+
+#include <algorithm>
+
+#include "common/logger.h"
+#include "optimizer/cost_model.h"
+#include "optimizer/operators.h"
+#include "optimizer/predicate_util.h"
+
+namespace peloton {
+namespace optimizer {
+
+static int CountRelations(uint64_t relation_set) {
+  return __builtin_popcountll(relation_set);
+}
+
+static bool IsInnerJoin(const OpExpression &expr) {
+  return expr.Op().type() == OpType::InnerJoin;
+}
+
+std::shared_ptr<OpExpression> JoinEnumerator::ReorderJoins(
+    std::shared_ptr<OpExpression> expr) {
+  auto &children = expr->Children();
+
+  if (IsInnerJoin(*expr)) {
+    return JoinEnumerator().OrderJoinGraph(expr, {});
+  }
+
+  // The filter above the joins is part of the join graph
+  if (expr->Op().type() == OpType::Select && IsInnerJoin(*children[0])) {
+    return JoinEnumerator().OrderJoinGraph(children[0],
+                                           SplitConjunction(children[1]));
+  }
+
+  if (children.empty()) return expr;
+
+  auto reordered = std::make_shared<OpExpression>(expr->Op());
+  for (std::shared_ptr<OpExpression> child : children) {
+    reordered->PushChild(ReorderJoins(child));
+  }
+  return reordered;
+}
+
+std::shared_ptr<OpExpression> JoinEnumerator::OrderJoinGraph(
+    std::shared_ptr<OpExpression> expr,
+    std::vector<std::shared_ptr<OpExpression>> terms) {
+  auto filter_terms = terms;
+  FlattenJoins(expr, terms);
+
+  size_t relation_count = relations.size();
+  if (relation_count > sizeof(RelationSet) * 8) {
+    LOG_TRACE("Too many relations to reorder: %lu", relation_count);
+    if (filter_terms.empty()) return expr;
+
+    auto filter = std::make_shared<OpExpression>(LogicalSelect::make());
+    filter->PushChild(expr);
+    filter->PushChild(MakeConjunction(filter_terms));
+    return filter;
+  }
+
+  for (std::shared_ptr<OpExpression> relation : relations) {
+    relation_columns.push_back(GetOutputColumns(*relation));
+  }
+  neighbors.assign(relation_count, 0);
+
+  // Place each term on the relations whose columns it refers to
+  std::vector<std::vector<std::shared_ptr<OpExpression>>> relation_terms(
+      relation_count);
+  std::vector<std::shared_ptr<OpExpression>> remaining_terms;
+  for (std::shared_ptr<OpExpression> term : terms) {
+    std::vector<Column *> columns;
+    GetPredicateColumns(*term, columns);
+
+    RelationSet term_set = 0;
+    bool is_placed = (columns.empty() == false);
+    for (Column *column : columns) {
+      bool is_found = false;
+      for (size_t relation_itr = 0; relation_itr < relation_count;
+           relation_itr++) {
+        auto &output_columns = relation_columns[relation_itr];
+        if (std::find(output_columns.begin(), output_columns.end(), column) !=
+            output_columns.end()) {
+          term_set |= RelationSet(1) << relation_itr;
+          is_found = true;
+        }
+      }
+      is_placed = is_placed && is_found;
+    }
+
+    if (is_placed == false) {
+      remaining_terms.push_back(term);
+    } else if (CountRelations(term_set) == 1) {
+      relation_terms[__builtin_ctzll(term_set)].push_back(term);
+    } else {
+      join_terms.emplace_back(term_set, term);
+      for (size_t relation_itr = 0; relation_itr < relation_count;
+           relation_itr++) {
+        RelationSet relation = RelationSet(1) << relation_itr;
+        if (term_set & relation) neighbors[relation_itr] |= term_set;
+      }
+    }
+  }
+
+  // Terms on a single relation filter it before it is joined
+  for (size_t relation_itr = 0; relation_itr < relation_count;
+       relation_itr++) {
+    auto &pushed_terms = relation_terms[relation_itr];
+    std::shared_ptr<OpExpression> relation = relations[relation_itr];
+    if (pushed_terms.empty() == false) {
+      if (relation->Op().type() == OpType::Select) {
+        auto select_terms = SplitConjunction(relation->Children()[1]);
+        pushed_terms.insert(pushed_terms.begin(), select_terms.begin(),
+                            select_terms.end());
+        relation = relation->Children()[0];
+      }
+
+      auto filter = std::make_shared<OpExpression>(LogicalSelect::make());
+      filter->PushChild(relation);
+      filter->PushChild(MakeConjunction(pushed_terms));
+      relations[relation_itr] = filter;
+    }
+
+    best_plans[RelationSet(1) << relation_itr] =
+        EstimatePlan(relations[relation_itr]);
+  }
+
+  JoinPlan plan;
+  if (relation_count <= DP_JOIN_RELATION_LIMIT) {
+    EnumerateCsg();
+    plan = JoinComponents();
+  } else {
+    plan = JoinGreedily();
+  }
+
+  if (remaining_terms.empty()) return plan.expr;
+
+  auto filter = std::make_shared<OpExpression>(LogicalSelect::make());
+  filter->PushChild(plan.expr);
+  filter->PushChild(MakeConjunction(remaining_terms));
+  return filter;
+}
+
+void JoinEnumerator::FlattenJoins(
+    std::shared_ptr<OpExpression> expr,
+    std::vector<std::shared_ptr<OpExpression>> &terms) {
+  if (IsInnerJoin(*expr) == false) {
+    relations.push_back(ReorderJoins(expr));
+    return;
+  }
+
+  auto &children = expr->Children();
+  FlattenJoins(children[0], terms);
+  FlattenJoins(children[1], terms);
+
+  auto predicate_terms = SplitConjunction(children[2]);
+  terms.insert(terms.end(), predicate_terms.begin(), predicate_terms.end());
+}
+
+JoinEnumerator::JoinPlan JoinEnumerator::EstimatePlan(
+    std::shared_ptr<OpExpression> expr) {
+  auto &children = expr->Children();
+  JoinPlan plan;
+  plan.expr = expr;
+
+  switch (expr->Op().type()) {
+    case OpType::Get: {
+      plan.stats = CostModel::GetTableStats(expr->Op().as<LogicalGet>()->table);
+      plan.cost = plan.stats->GetCardinality() * SEQ_TUPLE_COST;
+    } break;
+
+    case OpType::Select: {
+      JoinPlan input = EstimatePlan(children[0]);
+      double input_cardinality = input.stats->GetCardinality();
+      plan.stats.reset(new Stats(
+          input_cardinality *
+          CostModel::EstimateSelectivity(*children[1], *input.stats)));
+      plan.stats->AddTableStats(*input.stats);
+      plan.cost = input.cost + input_cardinality * CPU_OPERATOR_COST;
+    } break;
+
+    case OpType::InnerJoin:
+    case OpType::LeftJoin:
+    case OpType::RightJoin:
+    case OpType::OuterJoin: {
+      JoinPlan left = EstimatePlan(children[0]);
+      JoinPlan right = EstimatePlan(children[1]);
+      auto join_stats =
+          CostModel::EstimateJoin(*left.stats, *right.stats, *children[2]);
+
+      // Outer joins keep the tuples of their outer sides
+      double cardinality = join_stats->GetCardinality();
+      auto type = expr->Op().type();
+      if (type == OpType::LeftJoin || type == OpType::OuterJoin) {
+        cardinality = std::max(cardinality, left.stats->GetCardinality());
+      }
+      if (type == OpType::RightJoin || type == OpType::OuterJoin) {
+        cardinality = std::max(cardinality, right.stats->GetCardinality());
+      }
+
+      plan.stats.reset(new Stats(cardinality));
+      plan.stats->AddTableStats(*join_stats);
+      plan.cost = left.cost + right.cost +
+                  CostModel::NLJoinCost(left.stats->GetCardinality(),
+                                        right.stats->GetCardinality(),
+                                        cardinality);
+    } break;
+
+    default: {
+      if (children.empty()) {
+        plan.stats.reset(new Stats(1));
+        plan.cost = 0;
+        break;
+      }
+
+      JoinPlan input = EstimatePlan(children[0]);
+      plan.stats = input.stats;
+      plan.cost =
+          input.cost + input.stats->GetCardinality() * CPU_TUPLE_COST;
+    } break;
+  }
+
+  return plan;
+}
+
+std::vector<Column *> JoinEnumerator::GetOutputColumns(
+    const OpExpression &expr) {
+  auto &children = expr.Children();
+  std::vector<Column *> columns;
+
+  switch (expr.Op().type()) {
+    case OpType::Get:
+      columns = expr.Op().as<LogicalGet>()->columns;
+      break;
+
+    case OpType::Project:
+      for (std::shared_ptr<OpExpression> project_column :
+           children[1]->Children()) {
+        if (project_column->Op().type() == OpType::ProjectColumn) {
+          columns.push_back(
+              project_column->Op().as<ExprProjectColumn>()->column);
+        }
+      }
+      break;
+
+    case OpType::InnerJoin:
+    case OpType::LeftJoin:
+    case OpType::RightJoin:
+    case OpType::OuterJoin: {
+      columns = GetOutputColumns(*children[0]);
+      auto right_columns = GetOutputColumns(*children[1]);
+      columns.insert(columns.end(), right_columns.begin(),
+                     right_columns.end());
+    } break;
+
+    default:
+      if (children.empty() == false) columns = GetOutputColumns(*children[0]);
+      break;
+  }
+
+  return columns;
+}
+
+//===--------------------------------------------------------------------===//
+// Join graph
+//===--------------------------------------------------------------------===//
+
+JoinEnumerator::RelationSet JoinEnumerator::GetNeighbors(
+    RelationSet relation_set) const {
+  RelationSet result = 0;
+  for (size_t relation_itr = 0; relation_itr < relations.size();
+       relation_itr++) {
+    if (relation_set & (RelationSet(1) << relation_itr)) {
+      result |= neighbors[relation_itr];
+    }
+  }
+  return result & ~relation_set;
+}
+
+std::vector<std::shared_ptr<OpExpression>> JoinEnumerator::GetJoinTerms(
+    RelationSet left, RelationSet right) const {
+  std::vector<std::shared_ptr<OpExpression>> terms;
+  RelationSet joined = left | right;
+  for (auto &join_term : join_terms) {
+    RelationSet term_set = join_term.first;
+    if ((term_set & ~joined) == 0 && (term_set & ~left) != 0 &&
+        (term_set & ~right) != 0) {
+      terms.push_back(join_term.second);
+    }
+  }
+  return terms;
+}
+
+JoinEnumerator::JoinPlan JoinEnumerator::MakeJoin(const JoinPlan &left,
+                                                  RelationSet left_set,
+                                                  const JoinPlan &right,
+                                                  RelationSet right_set) const {
+  auto predicate = MakeConjunction(GetJoinTerms(left_set, right_set));
+
+  JoinPlan plan;
+  plan.expr = std::make_shared<OpExpression>(LogicalInnerJoin::make());
+  plan.expr->PushChild(left.expr);
+  plan.expr->PushChild(right.expr);
+  plan.expr->PushChild(predicate);
+  plan.stats = CostModel::EstimateJoin(*left.stats, *right.stats, *predicate);
+
+  double outer = left.stats->GetCardinality();
+  double inner = right.stats->GetCardinality();
+  double output = plan.stats->GetCardinality();
+
+  plan.cost =
+      left.cost + right.cost + CostModel::NLJoinCost(outer, inner, output);
+  if (HasEquiJoinTerm(predicate)) {
+    plan.cost = std::min(plan.cost, left.cost + right.cost +
+                                        CostModel::HashJoinCost(
+                                            outer, inner, output));
+  }
+
+  // A base table on the inner side can be read through an index instead
+  if (CountRelations(right_set) != 1) return plan;
+  std::shared_ptr<OpExpression> inner_expr = right.expr;
+  if (inner_expr->Op().type() == OpType::Select) {
+    inner_expr = inner_expr->Children()[0];
+  }
+  if (inner_expr->Op().type() != OpType::Get) return plan;
+
+  const LogicalGet *get = inner_expr->Op().as<LogicalGet>();
+  oid_t index_offset;
+  Column *inner_key_column;
+  Column *outer_key_column;
+  if (FindJoinIndex(get->table, get->columns, predicate, index_offset,
+                    inner_key_column, outer_key_column)) {
+    auto table_stats = CostModel::GetTableStats(get->table);
+
+    OpExpression key_term(ExprCompare::make(EXPRESSION_TYPE_COMPARE_EQUAL));
+    key_term.PushChild(
+        std::make_shared<OpExpression>(ExprVariable::make(outer_key_column)));
+    key_term.PushChild(
+        std::make_shared<OpExpression>(ExprVariable::make(inner_key_column)));
+    double matches =
+        CostModel::EstimateJoin(*left.stats, *table_stats, key_term)
+            ->GetCardinality();
+
+    plan.cost = std::min(
+        plan.cost, left.cost + CostModel::IndexNLJoinCost(
+                                   outer, table_stats->GetCardinality(),
+                                   matches, output));
+  }
+
+  return plan;
+}
+
+void JoinEnumerator::ConsiderJoins(RelationSet left_set,
+                                   RelationSet right_set) {
+  const JoinPlan &left = best_plans.at(left_set);
+  const JoinPlan &right = best_plans.at(right_set);
+
+  JoinPlan plan = MakeJoin(left, left_set, right, right_set);
+  JoinPlan swapped_plan = MakeJoin(right, right_set, left, left_set);
+  if (swapped_plan.cost < plan.cost) plan = swapped_plan;
+
+  RelationSet joined = left_set | right_set;
+  auto best_plan = best_plans.find(joined);
+  if (best_plan == best_plans.end() || plan.cost < best_plan->second.cost) {
+    best_plans[joined] = plan;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Enumeration
+//===--------------------------------------------------------------------===//
+
+void JoinEnumerator::EnumerateCsg() {
+  for (size_t relation_itr = relations.size(); relation_itr-- > 0;) {
+    RelationSet relation = RelationSet(1) << relation_itr;
+    EmitCsg(relation);
+    EnumerateCsgRec(relation, (relation << 1) - 1);
+  }
+
+  // The plans of both sides of a pair have to be known before it is joined,
+  // so smaller pairs go first
+  std::stable_sort(csg_cmp_pairs.begin(), csg_cmp_pairs.end(),
+                   [](const std::pair<RelationSet, RelationSet> &lhs,
+                      const std::pair<RelationSet, RelationSet> &rhs) {
+                     return CountRelations(lhs.first | lhs.second) <
+                            CountRelations(rhs.first | rhs.second);
+                   });
+  for (auto &csg_cmp_pair : csg_cmp_pairs) {
+    ConsiderJoins(csg_cmp_pair.first, csg_cmp_pair.second);
+  }
+}
+
+void JoinEnumerator::EnumerateCsgRec(RelationSet subgraph,
+                                     RelationSet excluded) {
+  RelationSet candidates = GetNeighbors(subgraph) & ~excluded;
+  for (RelationSet subset = candidates; subset != 0;
+       subset = (subset - 1) & candidates) {
+    EmitCsg(subgraph | subset);
+  }
+  for (RelationSet subset = candidates; subset != 0;
+       subset = (subset - 1) & candidates) {
+    EnumerateCsgRec(subgraph | subset, excluded | candidates);
+  }
+}
+
+void JoinEnumerator::EmitCsg(RelationSet subgraph) {
+  // Complements only hold relations after the first one of the subgraph
+  RelationSet first_relation = subgraph & (~subgraph + 1);
+  RelationSet excluded = subgraph | ((first_relation << 1) - 1);
+  RelationSet candidates = GetNeighbors(subgraph) & ~excluded;
+
+  for (size_t relation_itr = relations.size(); relation_itr-- > 0;) {
+    RelationSet relation = RelationSet(1) << relation_itr;
+    if ((candidates & relation) == 0) continue;
+
+    EmitCsgCmp(subgraph, relation);
+    EnumerateCmpRec(subgraph, relation,
+                    excluded | (((relation << 1) - 1) & candidates));
+  }
+}
+
+void JoinEnumerator::EnumerateCmpRec(RelationSet subgraph,
+                                     RelationSet complement,
+                                     RelationSet excluded) {
+  RelationSet candidates = GetNeighbors(complement) & ~excluded;
+  for (RelationSet subset = candidates; subset != 0;
+       subset = (subset - 1) & candidates) {
+    EmitCsgCmp(subgraph, complement | subset);
+  }
+  for (RelationSet subset = candidates; subset != 0;
+       subset = (subset - 1) & candidates) {
+    EnumerateCmpRec(subgraph, complement | subset, excluded | candidates);
+  }
+}
+
+void JoinEnumerator::EmitCsgCmp(RelationSet subgraph, RelationSet complement) {
+  csg_cmp_pairs.emplace_back(subgraph, complement);
+}
+
+JoinEnumerator::JoinPlan JoinEnumerator::JoinComponents() {
+  RelationSet remaining = (RelationSet(1) << (relations.size() - 1));
+  remaining |= remaining - 1;
+
+  std::vector<RelationSet> components;
+  while (remaining != 0) {
+    RelationSet component = remaining & (~remaining + 1);
+    for (;;) {
+      RelationSet next = GetNeighbors(component);
+      if (next == 0) break;
+      component |= next;
+    }
+    components.push_back(component);
+    remaining &= ~component;
+  }
+
+  // Cross products of the smallest components are the cheapest
+  std::stable_sort(components.begin(), components.end(),
+                   [this](RelationSet lhs, RelationSet rhs) {
+                     return best_plans.at(lhs).stats->GetCardinality() <
+                            best_plans.at(rhs).stats->GetCardinality();
+                   });
+
+  RelationSet joined = components.front();
+  for (size_t component_itr = 1; component_itr < components.size();
+       component_itr++) {
+    ConsiderJoins(joined, components[component_itr]);
+    joined |= components[component_itr];
+  }
+  return best_plans.at(joined);
+}
+
+JoinEnumerator::JoinPlan JoinEnumerator::JoinGreedily() {
+  std::vector<RelationSet> joined_sets;
+  for (size_t relation_itr = 0; relation_itr < relations.size();
+       relation_itr++) {
+    joined_sets.push_back(RelationSet(1) << relation_itr);
+  }
+
+  while (joined_sets.size() > 1) {
+    // Join the connected pair with the smallest result, cross products only
+    // come last
+    size_t best_left = 0;
+    size_t best_right = 0;
+    double best_cardinality = -1;
+    for (bool connected_only : {true, false}) {
+      for (size_t left_itr = 0; left_itr < joined_sets.size(); left_itr++) {
+        for (size_t right_itr = left_itr + 1; right_itr < joined_sets.size();
+             right_itr++) {
+          RelationSet left_set = joined_sets[left_itr];
+          RelationSet right_set = joined_sets[right_itr];
+          if (connected_only && (GetNeighbors(left_set) & right_set) == 0) {
+            continue;
+          }
+
+          auto predicate = MakeConjunction(GetJoinTerms(left_set, right_set));
+          double cardinality =
+              CostModel::EstimateJoin(*best_plans.at(left_set).stats,
+                                      *best_plans.at(right_set).stats,
+                                      *predicate)->GetCardinality();
+          if (best_cardinality < 0 || cardinality < best_cardinality) {
+            best_left = left_itr;
+            best_right = right_itr;
+            best_cardinality = cardinality;
+          }
+        }
+      }
+      if (best_cardinality >= 0) break;
+    }
+
+    ConsiderJoins(joined_sets[best_left], joined_sets[best_right]);
+    joined_sets[best_left] |= joined_sets[best_right];
+    joined_sets.erase(joined_sets.begin() + best_right);
+  }
+
+  return best_plans.at(joined_sets.front());
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -62,6 +62,8 @@ void OperatorVisitor::visit(const PhysicalRightHashJoin*) {}
 
 void OperatorVisitor::visit(const PhysicalOuterHashJoin*) {}
 
+void OperatorVisitor::visit(const PhysicalInnerIndexNLJoin*) {}
+
 void OperatorVisitor::visit(const ExprVariable*) {}
 
 void OperatorVisitor::visit(const ExprConstant*) {}
@@ -234,6 +234,49 @@ Operator PhysicalOuterHashJoin::make() {
   return Operator(join);
 }
 
+//===--------------------------------------------------------------------===//
+// InnerIndexNLJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalInnerIndexNLJoin::make(storage::DataTable *table,
+                                        std::vector<Column *> cols,
+                                        oid_t index_offset,
+                                        Column *inner_key_column,
+                                        Column *outer_key_column) {
+  PhysicalInnerIndexNLJoin *join = new PhysicalInnerIndexNLJoin;
+  join->table = table;
+  join->columns = cols;
+  join->index_offset = index_offset;
+  join->inner_key_column = inner_key_column;
+  join->outer_key_column = outer_key_column;
+  return Operator(join);
+}
+
+bool PhysicalInnerIndexNLJoin::operator==(const BaseOperatorNode &node) {
+  if (node.type() != OpType::InnerIndexNLJoin) return false;
+  const PhysicalInnerIndexNLJoin &r =
+      *static_cast<const PhysicalInnerIndexNLJoin *>(&node);
+  if (table->GetOid() != r.table->GetOid()) return false;
+  if (index_offset != r.index_offset) return false;
+  if (inner_key_column != r.inner_key_column) return false;
+  if (outer_key_column != r.outer_key_column) return false;
+  if (columns.size() != r.columns.size()) return false;
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i] != r.columns[i]) return false;
+  }
+  return true;
+}
+
+hash_t PhysicalInnerIndexNLJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  oid_t table_oid = table->GetOid();
+  hash = util::CombineHashes(hash, util::Hash<oid_t>(&table_oid));
+  hash = util::CombineHashes(hash, util::Hash<oid_t>(&index_offset));
+  hash = util::CombineHashes(hash, inner_key_column->Hash());
+  hash = util::CombineHashes(hash, outer_key_column->Hash());
+  return hash;
+}
+
 //===--------------------------------------------------------------------===//
 // Variable
 //===--------------------------------------------------------------------===//
@@ -464,6 +507,11 @@ void OperatorNode<PhysicalOuterHashJoin>::accept(OperatorVisitor *v) const {
   v->visit((const PhysicalOuterHashJoin *)this);
 }
 template <>
+void OperatorNode<PhysicalInnerIndexNLJoin>::accept(
+    OperatorVisitor *v) const {
+  v->visit((const PhysicalInnerIndexNLJoin *)this);
+}
+template <>
 void OperatorNode<ExprVariable>::accept(OperatorVisitor *v) const {
   v->visit((const ExprVariable *)this);
 }
@@ -538,6 +586,9 @@ template <>
 std::string OperatorNode<PhysicalOuterHashJoin>::_name =
     "PhysicalOuterHashJoin";
 template <>
+std::string OperatorNode<PhysicalInnerIndexNLJoin>::_name =
+    "PhysicalInnerIndexNLJoin";
+template <>
 std::string OperatorNode<ExprVariable>::_name = "ExprVariable";
 template <>
 std::string OperatorNode<ExprConstant>::_name = "ExprConstant";
@@ -595,6 +646,9 @@ OpType OperatorNode<PhysicalRightHashJoin>::_type = OpType::RightHashJoin;
 template <>
 OpType OperatorNode<PhysicalOuterHashJoin>::_type = OpType::OuterHashJoin;
 template <>
+OpType OperatorNode<PhysicalInnerIndexNLJoin>::_type =
+    OpType::InnerIndexNLJoin;
+template <>
 OpType OperatorNode<ExprVariable>::_type = OpType::Variable;
 template <>
 OpType OperatorNode<ExprConstant>::_type = OpType::Constant;
@@ -694,6 +748,10 @@ bool OperatorNode<PhysicalOuterHashJoin>::IsLogical() const {
   return false;
 }
 template <>
+bool OperatorNode<PhysicalInnerIndexNLJoin>::IsLogical() const {
+  return false;
+}
+template <>
 bool OperatorNode<ExprVariable>::IsLogical() const {
   return true;
 }
@@ -807,6 +865,10 @@ bool OperatorNode<PhysicalOuterHashJoin>::IsPhysical() const {
   return true;
 }
 template <>
+bool OperatorNode<PhysicalInnerIndexNLJoin>::IsPhysical() const {
+  return true;
+}
+template <>
 bool OperatorNode<ExprVariable>::IsPhysical() const {
   return true;
 }
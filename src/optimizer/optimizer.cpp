@@ -15,6 +15,7 @@
 #include "optimizer/operator_visitor.h"
 #include "optimizer/convert_query_to_op.h"
 #include "optimizer/convert_op_to_plan.h"
+#include "optimizer/join_enumerator.h"
 #include "optimizer/rule_impls.h"
 
 #include "planner/projection_plan.h"
@@ -40,7 +41,9 @@ Optimizer::Optimizer() {
   rules.emplace_back(new LeftJoinToLeftNLJoin());
   rules.emplace_back(new RightJoinToRightNLJoin());
   rules.emplace_back(new OuterJoinToOuterNLJoin());
-  // rules.emplace_back(new InnerJoinToInnerHashJoin());
+  rules.emplace_back(new InnerJoinToInnerHashJoin());
+  rules.emplace_back(new InnerJoinToInnerIndexNLJoin(false));
+  rules.emplace_back(new InnerJoinToInnerIndexNLJoin(true));
 }
 
 Optimizer &Optimizer::GetInstance() {
@@ -50,6 +53,9 @@ Optimizer &Optimizer::GetInstance() {
 
 std::shared_ptr<planner::AbstractPlan> Optimizer::GeneratePlan(
     std::shared_ptr<Select> select_tree) {
+  // Groups of earlier queries are of no use to this one
+  memo = Memo();
+
   // Generate initial operator tree from query tree
   std::shared_ptr<GroupExpression> gexpr = InsertQueryTree(select_tree);
   GroupID root_id = gexpr->GetGroupID();
@@ -75,8 +81,14 @@ std::shared_ptr<GroupExpression> Optimizer::InsertQueryTree(
     std::shared_ptr<Select> tree) {
   std::shared_ptr<OpExpression> initial =
       ConvertQueryToOpExpression(column_manager, tree);
+
+  // The rules only commute joins, so the join order is chosen up front
+  initial = JoinEnumerator::ReorderJoins(initial);
+
   std::shared_ptr<GroupExpression> gexpr;
-  assert(RecordTransformedExpression(initial, gexpr));
+  bool inserted = RecordTransformedExpression(initial, gexpr);
+  assert(inserted);
+  (void)inserted;
   return gexpr;
 }
 
@@ -211,7 +223,7 @@ void Optimizer::CostExpression(std::shared_ptr<GroupExpression> gexpr) {
   }
 
   // Perform costing
-  gexpr->DeriveStatsAndCost(best_child_stats, best_child_costs);
+  gexpr->DeriveStatsAndCost(&memo, best_child_stats, best_child_costs);
 }
 
 void Optimizer::ExploreGroup(GroupID id) {
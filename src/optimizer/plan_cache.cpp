@@ -0,0 +1,319 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.cpp
+//
+// Identification: src/optimizer/plan_cache.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+#include "common/config.h"
+#include "common/logger.h"
+#include "common/value_factory.h"
+#include "optimizer/plan_cache.h"
+#include "planner/abstract_plan.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Idle instances kept per template, beyond that they are freed
+static const size_t max_idle_instances = 32;
+
+//===--------------------------------------------------------------------===//
+// Cached Plan
+//===--------------------------------------------------------------------===//
+
+CachedPlan::CachedPlan(const std::string &fingerprint,
+                       const std::vector<FieldInfoType> &tuple_descriptor)
+    : fingerprint_(fingerprint),
+      tuple_descriptor_(tuple_descriptor),
+      parameterized_(true) {}
+
+CachedPlan::CachedPlan(const std::string &fingerprint)
+    : fingerprint_(fingerprint), parameterized_(false) {}
+
+std::shared_ptr<planner::AbstractPlan> CachedPlan::Acquire() {
+  std::shared_ptr<planner::AbstractPlan> instance;
+  {
+    std::lock_guard<std::mutex> lock(instances_lock_);
+    if (idle_instances_.empty()) return nullptr;
+    instance = std::move(idle_instances_.back());
+    idle_instances_.pop_back();
+  }
+  return Lend(instance);
+}
+
+std::shared_ptr<planner::AbstractPlan> CachedPlan::Lend(
+    const std::shared_ptr<planner::AbstractPlan> &instance) {
+  if (instance == nullptr) return nullptr;
+
+  // The template outlives the instances it lent out, even once evicted
+  auto cached_plan = shared_from_this();
+  return std::shared_ptr<planner::AbstractPlan>(
+      instance.get(), [cached_plan, instance](planner::AbstractPlan *) {
+        cached_plan->Release(instance);
+      });
+}
+
+void CachedPlan::Release(
+    const std::shared_ptr<planner::AbstractPlan> &instance) {
+  std::lock_guard<std::mutex> lock(instances_lock_);
+  if (invalidated_ || idle_instances_.size() >= max_idle_instances) return;
+  idle_instances_.push_back(instance);
+}
+
+void CachedPlan::Invalidate() {
+  std::lock_guard<std::mutex> lock(instances_lock_);
+  invalidated_ = true;
+  idle_instances_.clear();
+}
+
+//===--------------------------------------------------------------------===//
+// Plan Cache
+//===--------------------------------------------------------------------===//
+
+PlanCache &PlanCache::GetInstance() {
+  static PlanCache plan_cache(FLAGS_plan_cache_size);
+  return plan_cache;
+}
+
+PlanCache::PlanCache(size_t capacity)
+    : shard_capacity_(std::max<size_t>(1, capacity / shard_count)),
+      hit_count_(0),
+      miss_count_(0),
+      eviction_count_(0),
+      planning_count_(0),
+      planning_time_us_(0) {}
+
+// Whether a number starts at pos
+static bool IsNumberStart(const std::string &query, size_t pos) {
+  if (pos >= query.size()) return false;
+  return isdigit(query[pos]) ||
+         (query[pos] == '.' && pos + 1 < query.size() &&
+          isdigit(query[pos + 1]));
+}
+
+// Keywords an expression may follow, a minus sign after them is a sign
+static bool IsExpressionKeyword(const std::string &word) {
+  static const std::set<std::string> keywords = {
+      "select", "where", "and", "or", "not", "when", "then",
+      "else", "like", "between", "having", "on", "limit", "offset"};
+  return keywords.count(word) != 0;
+}
+
+// Normalize the query, replacing its literals by parameters if
+// extract_literals is set. Fails on unterminated strings, and on parameters
+// of the query itself when literals are extracted, whose numbers would clash.
+static bool Normalize(const std::string &query, bool extract_literals,
+                      std::string &fingerprint, std::vector<Value> &literals) {
+  fingerprint.clear();
+  literals.clear();
+
+  // Tokens the way the SQL scanner reads them : keywords and identifiers
+  // are case insensitive, strings run to the next quote on the same line
+  // that is not doubled
+  size_t pos = 0;
+  bool space = false;
+  // Whether the last token ends an operand, a minus sign after it subtracts
+  bool operand = false;
+  while (pos < query.size()) {
+    char c = query[pos];
+
+    if (isspace(c)) {
+      space = true;
+      pos++;
+      continue;
+    }
+    if (space && !fingerprint.empty()) fingerprint += ' ';
+    space = false;
+
+    bool negative = (c == '-' && operand == false &&
+                     IsNumberStart(query, pos + 1));
+
+    if (c == '\'' || c == '"') {
+      // A doubled quote stands for the quote itself
+      std::string text;
+      auto end = pos + 1;
+      for (;; end++) {
+        if (end >= query.size() || query[end] == '\n') return false;
+        if (query[end] != c) {
+          text += query[end];
+        } else if (end + 1 < query.size() && query[end + 1] == c) {
+          text += c;
+          end++;
+        } else {
+          break;
+        }
+      }
+
+      if (c == '"' || extract_literals == false) {
+        // quoted identifier, or a string left in place
+        fingerprint.append(query, pos, end + 1 - pos);
+      } else {
+        literals.push_back(ValueFactory::GetStringValue(text));
+        fingerprint += "$" + std::to_string(literals.size());
+      }
+      pos = end + 1;
+      operand = true;
+    } else if (c == '$') {
+      if (extract_literals) return false;
+      fingerprint += query[pos++];
+      while (pos < query.size() && isdigit(query[pos]))
+        fingerprint += query[pos++];
+      operand = true;
+    } else if (isalpha(c) || c == '_') {
+      std::string word;
+      while (pos < query.size() && (isalnum(query[pos]) || query[pos] == '_'))
+        word += tolower(query[pos++]);
+      fingerprint += word;
+      operand = (IsExpressionKeyword(word) == false);
+    } else if (negative || IsNumberStart(query, pos)) {
+      auto end = negative ? pos + 1 : pos;
+      while (end < query.size() && isdigit(query[end])) end++;
+      bool is_float = (end < query.size() && query[end] == '.');
+      if (is_float) {
+        end++;
+        while (end < query.size() && isdigit(query[end])) end++;
+      }
+
+      auto text = query.substr(pos, end - pos);
+      pos = end;
+      operand = true;
+      if (extract_literals == false) {
+        fingerprint += text;
+        continue;
+      }
+
+      if (is_float) {
+        literals.push_back(ValueFactory::GetDoubleValue(atof(text.c_str())));
+      } else {
+        // The minimum of the integer type is its NULL
+        auto number = atoll(text.c_str());
+        if (number <= INT32_MAX && number > INT32_MIN) {
+          literals.push_back(ValueFactory::GetIntegerValue(number));
+        } else {
+          literals.push_back(ValueFactory::GetBigIntValue(number));
+        }
+      }
+      fingerprint += "$" + std::to_string(literals.size());
+    } else {
+      fingerprint += c;
+      pos++;
+      operand = (c == ')');
+    }
+  }
+  return true;
+}
+
+bool PlanCache::Fingerprint(const std::string &query, std::string &fingerprint,
+                            std::vector<Value> &literals) {
+  // A query that has parameters of its own, e.g. a prepared statement, is
+  // already in the form of its plan : its literals are left in place
+  if (Normalize(query, true, fingerprint, literals) == false &&
+      Normalize(query, false, fingerprint, literals) == false) {
+    return false;
+  }
+
+  // Only data manipulation is cached, other statements change the catalog
+  auto query_type = fingerprint.substr(0, fingerprint.find(' '));
+  return query_type == "select" || query_type == "insert" ||
+         query_type == "update" || query_type == "delete";
+}
+
+PlanCache::Shard &PlanCache::GetShard(const std::string &fingerprint) {
+  return shards_[std::hash<std::string>()(fingerprint) % shard_count];
+}
+
+std::shared_ptr<CachedPlan> PlanCache::Find(const std::string &fingerprint) {
+  auto &shard = GetShard(fingerprint);
+  std::lock_guard<std::mutex> lock(shard.lock);
+
+  auto itr = shard.plans.find(fingerprint);
+  if (itr == shard.plans.end()) {
+    miss_count_++;
+    return nullptr;
+  }
+
+  // Most recently used first
+  shard.lru.splice(shard.lru.begin(), shard.lru, itr->second.second);
+  hit_count_++;
+  return itr->second.first;
+}
+
+void PlanCache::Insert(const std::shared_ptr<CachedPlan> &plan) {
+  auto &fingerprint = plan->GetFingerprint();
+  auto &shard = GetShard(fingerprint);
+  std::lock_guard<std::mutex> lock(shard.lock);
+
+  // Planned concurrently by another connection
+  if (shard.plans.count(fingerprint) != 0) return;
+
+  while (shard.plans.size() >= shard_capacity_) {
+    auto &victim = shard.lru.back();
+    LOG_TRACE("Evict plan %s", victim.c_str());
+    shard.plans.erase(victim);
+    shard.lru.pop_back();
+    eviction_count_++;
+  }
+
+  shard.lru.push_front(fingerprint);
+  shard.plans[fingerprint] = std::make_pair(plan, shard.lru.begin());
+}
+
+void PlanCache::Clear() {
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    for (auto &entry : shard.plans) {
+      entry.second.first->Invalidate();
+    }
+    shard.plans.clear();
+    shard.lru.clear();
+  }
+}
+
+void PlanCache::RecordPlanning(double duration_us) {
+  planning_count_++;
+  planning_time_us_ += static_cast<uint64_t>(duration_us);
+}
+
+size_t PlanCache::GetSize() const {
+  size_t size = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    size += shard.plans.size();
+  }
+  return size;
+}
+
+double PlanCache::GetHitRate() const {
+  uint64_t lookup_count = hit_count_ + miss_count_;
+  if (lookup_count == 0) return 0;
+  return static_cast<double>(hit_count_) / lookup_count;
+}
+
+const std::string PlanCache::GetInfo() const {
+  std::ostringstream os;
+
+  os << "\tPLAN CACHE\n";
+  os << "\tTemplates : " << GetSize() << "\n";
+  os << "\tHits : " << hit_count_ << " Misses : " << miss_count_
+     << " Hit rate : " << GetHitRate() << "\n";
+  os << "\tEvictions : " << eviction_count_ << "\n";
+  os << "\tPlanned : " << planning_count_ << " in " << planning_time_us_
+     << " us\n";
+
+  return os.str();
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
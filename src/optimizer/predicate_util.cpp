@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// predicate_util.cpp
+//
+// Identification: src/optimizer/predicate_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/predicate_util.h"
+#include "optimizer/operators.h"
+#include "index/index.h"
+
+#include <algorithm>
+
+namespace peloton {
+namespace optimizer {
+
+static bool IsTrueConstant(const OpExpression &predicate) {
+  if (predicate.Op().type() != OpType::Constant) return false;
+  const Value &value = predicate.Op().as<ExprConstant>()->value;
+  return value.GetValueType() == VALUE_TYPE_BOOLEAN && value.IsTrue();
+}
+
+std::vector<std::shared_ptr<OpExpression>> SplitConjunction(
+    std::shared_ptr<OpExpression> predicate) {
+  std::vector<std::shared_ptr<OpExpression>> terms;
+  if (predicate->Op().type() == OpType::BoolOp &&
+      predicate->Op().as<ExprBoolOp>()->bool_type == BoolOpType::And) {
+    for (std::shared_ptr<OpExpression> child : predicate->Children()) {
+      auto child_terms = SplitConjunction(child);
+      terms.insert(terms.end(), child_terms.begin(), child_terms.end());
+    }
+  } else if (IsTrueConstant(*predicate) == false) {
+    // The constant true adds nothing to a conjunction
+    terms.push_back(predicate);
+  }
+  return terms;
+}
+
+std::shared_ptr<OpExpression> MakeConjunction(
+    const std::vector<std::shared_ptr<OpExpression>> &terms) {
+  if (terms.empty()) {
+    return std::make_shared<OpExpression>(ExprConstant::make(Value::GetTrue()));
+  }
+  if (terms.size() == 1) return terms.front();
+
+  auto conjunction =
+      std::make_shared<OpExpression>(ExprBoolOp::make(BoolOpType::And));
+  for (std::shared_ptr<OpExpression> term : terms) {
+    conjunction->PushChild(term);
+  }
+  return conjunction;
+}
+
+void GetPredicateColumns(const OpExpression &predicate,
+                         std::vector<Column *> &columns) {
+  if (predicate.Op().type() == OpType::Variable) {
+    columns.push_back(predicate.Op().as<ExprVariable>()->column);
+  }
+  for (std::shared_ptr<OpExpression> child : predicate.Children()) {
+    GetPredicateColumns(*child, columns);
+  }
+}
+
+bool IsEquiJoinTerm(const OpExpression &term, Column *&left_column,
+                    Column *&right_column) {
+  if (term.Op().type() != OpType::Compare ||
+      term.Op().as<ExprCompare>()->expr_type !=
+          EXPRESSION_TYPE_COMPARE_EQUAL) {
+    return false;
+  }
+
+  auto &children = term.Children();
+  if (children.size() != 2 || children[0]->Op().type() != OpType::Variable ||
+      children[1]->Op().type() != OpType::Variable) {
+    return false;
+  }
+
+  left_column = children[0]->Op().as<ExprVariable>()->column;
+  right_column = children[1]->Op().as<ExprVariable>()->column;
+  auto left_table_column = dynamic_cast<TableColumn *>(left_column);
+  auto right_table_column = dynamic_cast<TableColumn *>(right_column);
+  if (left_table_column == nullptr || right_table_column == nullptr) {
+    return false;
+  }
+  return left_table_column->BaseTableOid() !=
+         right_table_column->BaseTableOid();
+}
+
+bool HasEquiJoinTerm(std::shared_ptr<OpExpression> predicate) {
+  Column *left_column;
+  Column *right_column;
+  for (std::shared_ptr<OpExpression> term : SplitConjunction(predicate)) {
+    if (IsEquiJoinTerm(*term, left_column, right_column)) return true;
+  }
+  return false;
+}
+
+bool FindJoinIndex(storage::DataTable *table,
+                   const std::vector<Column *> &table_columns,
+                   std::shared_ptr<OpExpression> predicate,
+                   oid_t &index_offset, Column *&inner_key_column,
+                   Column *&outer_key_column) {
+  for (std::shared_ptr<OpExpression> term : SplitConjunction(predicate)) {
+    Column *left_column;
+    Column *right_column;
+    if (IsEquiJoinTerm(*term, left_column, right_column) == false) continue;
+
+    // One side of the term is a column of the table
+    if (std::find(table_columns.begin(), table_columns.end(), left_column) !=
+        table_columns.end()) {
+      std::swap(left_column, right_column);
+    }
+    if (std::find(table_columns.begin(), table_columns.end(), right_column) ==
+        table_columns.end()) {
+      continue;
+    }
+    oid_t column_id =
+        static_cast<TableColumn *>(right_column)->ColumnIndexOid();
+
+    // An index whose key starts with the column can be probed
+    for (oid_t index_itr = 0; index_itr < table->GetIndexCount();
+         index_itr++) {
+      auto index = table->GetIndex(index_itr);
+      if (index == nullptr || index->IsReadable() == false) continue;
+
+      auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+      if (key_attrs.empty() == false && key_attrs[0] == column_id) {
+        index_offset = index_itr;
+        inner_key_column = right_column;
+        outer_key_column = left_column;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+} /* namespace optimizer */
+} /* namespace peloton */
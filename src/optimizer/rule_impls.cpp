@@ -13,6 +13,7 @@
 
 #include "optimizer/rule_impls.h"
 #include "optimizer/operators.h"
+#include "optimizer/predicate_util.h"
 
 #include <memory>
 #include <cassert>
@@ -304,10 +305,11 @@ void OuterJoinToOuterNLJoin::Transform(
 InnerJoinToInnerHashJoin::InnerJoinToInnerHashJoin() {
   physical = true;
 
-  // Make three node types for pattern matching
+  // Make three node types for pattern matching, the whole predicate is
+  // needed to find its equality terms
   std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
   std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
-  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Tree));
 
   // Initialize a pattern for optimizer to match
   match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
@@ -321,9 +323,8 @@ InnerJoinToInnerHashJoin::InnerJoinToInnerHashJoin() {
 }
 
 bool InnerJoinToInnerHashJoin::Check(std::shared_ptr<OpExpression> plan) const {
-  (void)plan;
-  // TODO(abpoms): Figure out how to determine if the join condition is hashable
-  return false;
+  // The sides are hashed on the columns of the equality terms
+  return HasEquiJoinTerm(plan->Children()[2]);
 }
 
 void InnerJoinToInnerHashJoin::Transform(
@@ -465,5 +466,80 @@ void OuterJoinToOuterHashJoin::Transform(
   return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerIndexNLJoin
+InnerJoinToInnerIndexNLJoin::InnerJoinToInnerIndexNLJoin(bool filtered_inner)
+    : filtered_inner(filtered_inner) {
+  physical = true;
+
+  // The inner side is a table, possibly filtered, that is read through one
+  // of its indexes
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Get));
+  if (filtered_inner) {
+    std::shared_ptr<Pattern> filter(std::make_shared<Pattern>(OpType::Select));
+    filter->AddChild(right_child);
+    filter->AddChild(std::make_shared<Pattern>(OpType::Tree));
+    right_child = filter;
+  }
+  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Tree));
+
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+  match_pattern->AddChild(predicate);
+}
+
+bool InnerJoinToInnerIndexNLJoin::Check(
+    std::shared_ptr<OpExpression> plan) const {
+  oid_t index_offset;
+  Column *inner_key_column;
+  Column *outer_key_column;
+  return FindJoinIndex(plan, index_offset, inner_key_column, outer_key_column);
+}
+
+void InnerJoinToInnerIndexNLJoin::Transform(
+    std::shared_ptr<OpExpression> input,
+    std::vector<std::shared_ptr<OpExpression>> &transformed) const {
+  oid_t index_offset = INVALID_OID;
+  Column *inner_key_column = nullptr;
+  Column *outer_key_column = nullptr;
+  FindJoinIndex(input, index_offset, inner_key_column, outer_key_column);
+
+  std::vector<std::shared_ptr<OpExpression>> children = input->Children();
+  assert(children.size() == 3);
+
+  // The filter of the inner table is checked along with the join predicate
+  std::vector<std::shared_ptr<OpExpression>> terms =
+      SplitConjunction(children[2]);
+  std::shared_ptr<OpExpression> inner = children[1];
+  if (filtered_inner) {
+    auto filter_terms = SplitConjunction(inner->Children()[1]);
+    terms.insert(terms.end(), filter_terms.begin(), filter_terms.end());
+    inner = inner->Children()[0];
+  }
+  const LogicalGet *get = inner->Op().as<LogicalGet>();
+
+  auto result_plan = std::make_shared<OpExpression>(
+      PhysicalInnerIndexNLJoin::make(get->table, get->columns, index_offset,
+                                     inner_key_column, outer_key_column));
+  result_plan->PushChild(children[0]);
+  result_plan->PushChild(MakeConjunction(terms));
+
+  transformed.push_back(result_plan);
+}
+
+bool InnerJoinToInnerIndexNLJoin::FindJoinIndex(
+    std::shared_ptr<OpExpression> plan, oid_t &index_offset,
+    Column *&inner_key_column, Column *&outer_key_column) const {
+  std::shared_ptr<OpExpression> inner = plan->Children()[1];
+  if (filtered_inner) inner = inner->Children()[0];
+  const LogicalGet *get = inner->Op().as<LogicalGet>();
+
+  return optimizer::FindJoinIndex(get->table, get->columns,
+                                  plan->Children()[2], index_offset,
+                                  inner_key_column, outer_key_column);
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
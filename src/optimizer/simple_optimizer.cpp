@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/simple_optimizer.h"
+#include "optimizer/access_path.h"
 
 #include "parser/abstract_parse.h"
 #include "parser/insert_parse.h"
@@ -27,6 +28,10 @@
 #include "planner/aggregate_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/import_plan.h"
+#include "planner/analyze_plan.h"
+#include "planner/nested_loop_index_join_plan.h"
+#include "planner/exchange_plan.h"
 #include "parser/abstract_parse.h"
 #include "parser/drop_parse.h"
 #include "parser/create_parse.h"
@@ -37,15 +42,19 @@
 #include "expression/constant_value_expression.h"
 #include "expression/operator_expression.h"
 #include "expression/conjunction_expression.h"
+#include "index/index.h"
 #include "parser/sql_statement.h"
 #include "parser/statements.h"
 #include "catalog/bootstrapper.h"
 #include "storage/data_table.h"
 
+#include "common/config.h"
 #include "common/logger.h"
 #include "common/value_factory.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 namespace peloton {
 namespace planner {
@@ -57,6 +66,145 @@ SimpleOptimizer::SimpleOptimizer() {};
 
 SimpleOptimizer::~SimpleOptimizer() {};
 
+/**
+ * @brief Splits an aggregation over a sequential scan into partial
+ * aggregations of the morsels of the table, run by the workers of an
+ * exchange, and a final aggregation merging them.
+ *
+ * The partial aggregation outputs the group by columns followed by the
+ * aggregates, which are merged by aggregating them once more (counts are
+ * summed up). Averages and DISTINCT aggregates can't be merged that way.
+ *
+ * @return The final aggregation, nullptr if the query runs serially, in
+ * which case nothing was taken from the arguments.
+ */
+static std::unique_ptr<planner::AbstractPlan> CreateParallelAggregatePlan(
+    storage::DataTable* target_table,
+    std::vector<planner::AggregatePlan::AggTerm>& agg_terms,
+    const std::vector<oid_t>& group_by_columns,
+    const DirectMapList& direct_map_list,
+    const std::vector<catalog::Column>& output_schema_columns,
+    PelotonAggType agg_type,
+    std::unique_ptr<planner::AbstractScan>& scan_node) {
+  size_t degree_of_parallelism = FLAGS_parallel_degree;
+  if (degree_of_parallelism == 0) {
+    degree_of_parallelism = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (degree_of_parallelism == 1 ||
+      scan_node->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN) {
+    return nullptr;
+  }
+
+  // Output columns of the partial aggregates
+  std::vector<const catalog::Column*> agg_columns(agg_terms.size(), nullptr);
+  for (auto& direct_map : direct_map_list) {
+    if (direct_map.second.first == 1) {
+      agg_columns[direct_map.second.second] =
+          &output_schema_columns[direct_map.first];
+    }
+  }
+
+  oid_t group_by_count = group_by_columns.size();
+  std::vector<planner::AggregatePlan::AggTerm> merge_agg_terms;
+  for (oid_t agg_itr = 0; agg_itr < agg_terms.size(); agg_itr++) {
+    auto& agg_term = agg_terms[agg_itr];
+    auto agg_column = agg_columns[agg_itr];
+    ExpressionType merge_type = EXPRESSION_TYPE_INVALID;
+    switch (agg_term.aggtype) {
+      case EXPRESSION_TYPE_AGGREGATE_COUNT:
+      case EXPRESSION_TYPE_AGGREGATE_COUNT_STAR:
+        if (agg_column != nullptr &&
+            agg_column->GetType() != VALUE_TYPE_INTEGER &&
+            agg_column->GetType() != VALUE_TYPE_BIGINT) {
+          agg_column = nullptr;
+        }
+        merge_type = EXPRESSION_TYPE_AGGREGATE_SUM;
+        break;
+      case EXPRESSION_TYPE_AGGREGATE_SUM:
+      case EXPRESSION_TYPE_AGGREGATE_MIN:
+      case EXPRESSION_TYPE_AGGREGATE_MAX:
+        merge_type = agg_term.aggtype;
+        break;
+      default:
+        break;
+    }
+
+    if (agg_term.distinct || agg_column == nullptr ||
+        merge_type == EXPRESSION_TYPE_INVALID) {
+      for (auto& merge_agg_term : merge_agg_terms) {
+        delete merge_agg_term.expression;
+      }
+      return nullptr;
+    }
+    merge_agg_terms.emplace_back(
+        merge_type, expression::ExpressionUtil::TupleValueFactory(
+                        agg_column->GetType(), 0, group_by_count + agg_itr));
+  }
+
+  // The group by columns are the first ones of the partial aggregates
+  DirectMapList merge_direct_map_list;
+  for (auto& direct_map : direct_map_list) {
+    auto column_id = direct_map.second.second;
+    if (direct_map.second.first == 0) {
+      auto group_by_itr = std::find(group_by_columns.begin(),
+                                    group_by_columns.end(), column_id);
+      if (group_by_itr == group_by_columns.end()) {
+        for (auto& merge_agg_term : merge_agg_terms) {
+          delete merge_agg_term.expression;
+        }
+        return nullptr;
+      }
+      column_id = group_by_itr - group_by_columns.begin();
+    }
+    merge_direct_map_list.emplace_back(
+        direct_map.first, std::make_pair(direct_map.second.first, column_id));
+  }
+
+  DirectMapList partial_direct_map_list;
+  std::vector<catalog::Column> partial_columns;
+  std::vector<oid_t> merge_group_by_columns;
+  for (oid_t column_itr = 0; column_itr < group_by_count; column_itr++) {
+    partial_direct_map_list.emplace_back(
+        column_itr, std::make_pair(0, group_by_columns[column_itr]));
+    partial_columns.push_back(
+        target_table->GetSchema()->GetColumn(group_by_columns[column_itr]));
+    merge_group_by_columns.push_back(column_itr);
+  }
+  for (oid_t agg_itr = 0; agg_itr < agg_terms.size(); agg_itr++) {
+    partial_direct_map_list.emplace_back(group_by_count + agg_itr,
+                                         std::make_pair(1, agg_itr));
+    partial_columns.push_back(*agg_columns[agg_itr]);
+  }
+
+  LOG_TRACE("Aggregating with %lu workers", degree_of_parallelism);
+  std::unique_ptr<const planner::ProjectInfo> partial_proj_info(
+      new planner::ProjectInfo(TargetList(),
+                               std::move(partial_direct_map_list)));
+  std::shared_ptr<const catalog::Schema> partial_schema(
+      new catalog::Schema(partial_columns));
+  std::unique_ptr<planner::AggregatePlan> partial_agg_plan(
+      new planner::AggregatePlan(
+          std::move(partial_proj_info), nullptr, std::move(agg_terms),
+          std::vector<oid_t>(group_by_columns), partial_schema, agg_type));
+  partial_agg_plan->AddChild(std::move(scan_node));
+
+  std::unique_ptr<planner::ExchangePlan> exchange_plan(
+      new planner::ExchangePlan(degree_of_parallelism));
+  exchange_plan->AddChild(std::move(partial_agg_plan));
+
+  std::unique_ptr<const planner::ProjectInfo> merge_proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(merge_direct_map_list)));
+  std::shared_ptr<const catalog::Schema> output_schema(
+      new catalog::Schema(output_schema_columns));
+  std::unique_ptr<planner::AggregatePlan> merge_agg_plan(
+      new planner::AggregatePlan(
+          std::move(merge_proj_info), nullptr, std::move(merge_agg_terms),
+          std::move(merge_group_by_columns), output_schema, agg_type));
+  merge_agg_plan->AddChild(std::move(exchange_plan));
+
+  return std::move(merge_agg_plan);
+}
+
 std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
     const std::unique_ptr<parser::SQLStatementList>& parse_tree) {
 
@@ -289,6 +437,17 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
           }
           ++new_col_id;
         }
+
+        if (having == nullptr) {
+          auto parallel_agg_plan = CreateParallelAggregatePlan(
+              target_table, agg_terms, group_by_columns, direct_map_list,
+              output_schema_columns, agg_type, scan_node);
+          if (parallel_agg_plan != nullptr) {
+            child_plan = std::move(parallel_agg_plan);
+            break;
+          }
+        }
+
         LOG_TRACE("Creating a ProjectInfo");
         std::unique_ptr<const planner::ProjectInfo> proj_info(
             new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
@@ -332,6 +491,20 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       child_plan = std::move(child_InsertPlan);
     } break;
 
+    case STATEMENT_TYPE_IMPORT: {
+      LOG_TRACE("Adding Import plan...");
+      std::unique_ptr<planner::AbstractPlan> child_ImportPlan(
+          new planner::ImportPlan((parser::ImportStatement*)parse_tree2));
+      child_plan = std::move(child_ImportPlan);
+    } break;
+
+    case STATEMENT_TYPE_ANALYZE: {
+      LOG_TRACE("Adding Analyze plan...");
+      std::unique_ptr<planner::AbstractPlan> child_AnalyzePlan(
+          new planner::AnalyzePlan((parser::AnalyzeStatement*)parse_tree2));
+      child_plan = std::move(child_AnalyzePlan);
+    } break;
+
     default:
       LOG_TRACE("Unsupported Parse Node Type");
   }
@@ -358,7 +531,6 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
     storage::DataTable* target_table, parser::SelectStatement* select_stmt) {
 
   bool index_searchable = false;
-  int index_id = 0;
 
   // column predicates passing to the index
   std::vector<oid_t> key_column_ids;
@@ -371,6 +543,8 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
   std::vector<ExpressionType> predicate_expr_types;
   std::vector<Value> predicate_values;
 
+  AccessPath access_path;
+
   if (select_stmt->where_clause != NULL) {
     index_searchable = true;
 
@@ -380,37 +554,16 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
                         predicate_values, index_searchable);
     LOG_TRACE("Finished Getting predicate columns");
 
+    // Scan the index only if it is cheaper than a sequential scan for the
+    // fraction of the table the predicates select
     if (index_searchable == true) {
-      index_searchable = false;
-
-      // Loop through the indexes to find to most proper one (if any)
-      int max_columns = 0;
-      int index_index = 0;
-      for (auto& column_set : target_table->GetIndexColumns()) {
-        int matched_columns = 0;
-        for (auto column_id : predicate_column_ids)
-          if (column_set.find(column_id) != column_set.end()) matched_columns++;
-        if (matched_columns > max_columns) {
-          index_searchable = true;
-          index_id = index_index;
-        }
-        index_index++;
-      }
+      access_path = ChooseAccessPath(target_table, predicate_column_ids,
+                                     predicate_expr_types, predicate_values);
+      index_searchable = (access_path.type != AccessPathType::SeqScan);
     }
   }
 
-  // index_searchable = false;
-  // using the index scan causes an error:
-  // Exception Type :: Mismatch Type
-  // Message :: Type VARCHAR does not match with BIGINTType VARCHAR can't be
-  // cast as BIGINT...
-  // terminate called after throwing an instance of
-  // 'peloton::TypeMismatchException'
-  // what():  Type VARCHAR does not match with BIGINTType VARCHAR can't be cast
-  // as BIGINT...
-
   if (!index_searchable) {
-    //  if (true) {
     // Create sequential scan plan
     LOG_TRACE("Creating a sequential scan plan");
     std::unique_ptr<planner::SeqScanPlan> child_SelectPlan(
@@ -421,21 +574,17 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
 
   // Create index scan plan
   LOG_TRACE("Creating a index scan plan");
-  auto index = target_table->GetIndex(index_id);
+  auto index = target_table->GetIndex(access_path.index_offset);
   std::vector<expression::AbstractExpression*> runtime_keys;
 
-  auto index_columns = target_table->GetIndexColumns()[index_id];
-  int column_idx = 0;
-  for (auto column_id : predicate_column_ids) {
-    if (index_columns.find(column_id) != index_columns.end()) {
-      key_column_ids.push_back(column_id);
-      expr_types.push_back(predicate_expr_types[column_idx]);
-      values.push_back(predicate_values[column_idx]);
-      LOG_TRACE("Adding for IndexScanDesc: id(%d), expr(%s), values(%s)",
-                column_id, ExpressionTypeToString(*expr_types.rbegin()).c_str(),
-                values.rbegin()->GetInfo().c_str());
-    }
-    column_idx++;
+  for (auto predicate_itr : access_path.key_predicates) {
+    key_column_ids.push_back(predicate_column_ids[predicate_itr]);
+    expr_types.push_back(predicate_expr_types[predicate_itr]);
+    values.push_back(predicate_values[predicate_itr]);
+    LOG_TRACE("Adding for IndexScanDesc: id(%d), expr(%s), values(%s)",
+              key_column_ids.back(),
+              ExpressionTypeToString(expr_types.back()).c_str(),
+              values.back().GetInfo().c_str());
   }
 
   // Create index scan desc
@@ -470,6 +619,15 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
   // Create plan node.
   std::unique_ptr<planner::IndexScanPlan> node(new planner::IndexScanPlan(
       target_table, select_stmt->where_clause, column_ids, index_scan_desc));
+
+  // A query reading only columns of the index need not read the table
+  if (node->IsCoveredByIndex()) {
+    LOG_TRACE("Index scan is covered by the index");
+    node->SetIndexOnly(true);
+  } else if (access_path.type == AccessPathType::BitmapScan) {
+    LOG_TRACE("Index scan reads the table in the order of the locations");
+    node->SetBitmapScan(true);
+  }
   LOG_TRACE("Index scan plan created");
 
   return std::move(node);
@@ -557,6 +715,44 @@ void SimpleOptimizer::GetPredicateColumns(
   }
 }
 
+/**
+ * The inner index of a join qualifies when the leading columns of its key are
+ * all bound, by the join column or by a value, and the join column is one of
+ * them. Of those the one with the longest bound prefix is probed.
+ */
+oid_t SimpleOptimizer::GetJoinIndex(
+    storage::DataTable* inner_table, oid_t join_column_id,
+    const std::vector<oid_t>& bound_column_ids) {
+  oid_t join_index_id = INVALID_OID;
+  size_t join_index_prefix = 0;
+
+  for (oid_t index_itr = 0; index_itr < inner_table->GetIndexCount();
+       index_itr++) {
+    auto index = inner_table->GetIndex(index_itr);
+    if (index == nullptr || index->IsReadable() == false) continue;
+    auto& key_attrs = index->GetMetadata()->GetKeyAttrs();
+
+    size_t prefix = 0;
+    bool has_join_column = false;
+    for (auto column_id : key_attrs) {
+      if (column_id == join_column_id) {
+        has_join_column = true;
+      } else if (std::find(bound_column_ids.begin(), bound_column_ids.end(),
+                           column_id) == bound_column_ids.end()) {
+        break;
+      }
+      prefix++;
+    }
+
+    if (has_join_column && prefix > join_index_prefix) {
+      join_index_id = index_itr;
+      join_index_prefix = prefix;
+    }
+  }
+
+  return join_index_id;
+}
+
 static std::unique_ptr<const planner::ProjectInfo> CreateHackProjection();
 static std::shared_ptr<const peloton::catalog::Schema> CreateHackJoinSchema();
 
@@ -631,69 +827,121 @@ SimpleOptimizer::CreateHackingJoinPlan() {
                                  index_scan_desc));
   LOG_DEBUG("Index scan for order_line plan created");
 
-  // predicate for scanning stock table
-  char s_w_id_name[] = "s_w_id";
-  char s_quantity_name[] = "s_quantity";
-  auto s_w_id =
-      new expression::ParserExpression(EXPRESSION_TYPE_COLUMN_REF, s_w_id_name);
-  auto s_quantity = new expression::ParserExpression(EXPRESSION_TYPE_COLUMN_REF,
-                                                     s_quantity_name);
-  auto predicate9 = new expression::ComparisonExpression<expression::CmpEq>(
-      EXPRESSION_TYPE_COMPARE_EQUAL, s_w_id, params[4]);
-  auto predicate10 = new expression::ComparisonExpression<expression::CmpLt>(
-      EXPRESSION_TYPE_COMPARE_LESSTHAN, s_quantity, params[5]);
-  auto predicate11 =
-      new expression::ConjunctionExpression<expression::ConjunctionAnd>(
-          EXPRESSION_TYPE_CONJUNCTION_AND, predicate9, predicate10);
-
-  predicate_column_ids = {0};
-  predicate_expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL};
-  predicate_values = {ValueFactory::GetBindingOnlyIntegerValue(4)};
-  column_ids = {1};
-
-  index = stock_table->GetIndex(0);
-  planner::IndexScanPlan::IndexScanDesc index_scan_desc2(
-      index, predicate_column_ids, predicate_expr_types, predicate_values,
-      runtime_keys);
-
-  // Create the index scan plan for STOCK
-  std::unique_ptr<planner::IndexScanPlan> stock_scan_node(
-      new planner::IndexScanPlan(stock_table, predicate11, column_ids,
-                                 index_scan_desc2));
-  LOG_DEBUG("Index scan plan for STOCK created");
-
-  // Create hash plan node
-  expression::AbstractExpression* right_table_attr_1 =
-      new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 0);
-
-  std::vector<std::unique_ptr<const expression::AbstractExpression>> hash_keys;
-  hash_keys.emplace_back(right_table_attr_1);
-
-  // Create hash plan node
-  std::unique_ptr<planner::HashPlan> hash_plan_node(
-      new planner::HashPlan(hash_keys));
-  hash_plan_node->AddChild(std::move(stock_scan_node));
+  // Probe the stock index with the item of every order line if it can be,
+  // rather than hashing the stock of the whole warehouse
+  auto stock_schema = stock_table->GetSchema();
+  oid_t s_i_id_column = stock_schema->GetColumnID("s_i_id");
+  oid_t s_w_id_column = stock_schema->GetColumnID("s_w_id");
+  oid_t s_quantity_column = stock_schema->GetColumnID("s_quantity");
+  oid_t stock_index_id =
+      GetJoinIndex(stock_table, s_i_id_column, {s_w_id_column});
+
+  std::unique_ptr<planner::AbstractPlan> join_plan_node;
+  if (stock_index_id != INVALID_OID) {
+    index = stock_table->GetIndex(stock_index_id);
+
+    // S_I_ID = LEFT.0 AND S_W_ID = $4, in the order of the index key
+    std::vector<oid_t> key_column_ids;
+    std::vector<ExpressionType> expr_types;
+    std::vector<Value> values;
+    std::vector<oid_t> outer_column_ids;
+    for (auto column_id : index->GetMetadata()->GetKeyAttrs()) {
+      if (column_id == s_i_id_column) {
+        values.push_back(ValueFactory::GetNullValue());
+        outer_column_ids.push_back(0);
+      } else if (column_id == s_w_id_column) {
+        values.push_back(ValueFactory::GetBindingOnlyIntegerValue(4));
+        outer_column_ids.push_back(INVALID_OID);
+      } else {
+        break;
+      }
+      key_column_ids.push_back(column_id);
+      expr_types.push_back(EXPRESSION_TYPE_COMPARE_EQUAL);
+    }
 
-  // LEFT.4 == RIGHT.1
-  expression::TupleValueExpression* left_table_attr_4 =
-      new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 0, 0);
-  right_table_attr_1 =
-      new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 0);
-  std::unique_ptr<const expression::AbstractExpression> join_predicate(
-      new expression::ComparisonExpression<expression::CmpEq>(
-          EXPRESSION_TYPE_COMPARE_EQUAL, left_table_attr_4,
-          right_table_attr_1));
-
-  auto projection = CreateHackProjection();
-  auto schema = CreateHackJoinSchema();
-  // Create hash join plan node.
-  std::unique_ptr<planner::HashJoinPlan> hash_join_plan_node(
-      new planner::HashJoinPlan(JOIN_TYPE_INNER, std::move(join_predicate),
-                                std::move(projection), schema));
-
-  // left or right?
-  hash_join_plan_node->AddChild(std::move(orderline_scan_node));
-  hash_join_plan_node->AddChild(std::move(hash_plan_node));
+    // $4 is a key of the index, RIGHT.S_QUANTITY < $5 is left to check
+    delete params[4];
+    std::unique_ptr<const expression::AbstractExpression> join_predicate(
+        new expression::ComparisonExpression<expression::CmpLt>(
+            EXPRESSION_TYPE_COMPARE_LESSTHAN,
+            new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1,
+                                                 s_quantity_column),
+            params[5]));
+
+    auto projection = CreateHackProjection();
+    auto schema = CreateHackJoinSchema();
+    join_plan_node.reset(new planner::NestedLoopIndexJoinPlan(
+        JOIN_TYPE_INNER, std::move(join_predicate), std::move(projection),
+        schema, stock_table, {s_i_id_column}, index, key_column_ids,
+        expr_types, values, outer_column_ids));
+    join_plan_node->AddChild(std::move(orderline_scan_node));
+    LOG_DEBUG("Index join with STOCK created");
+  } else {
+    // predicate for scanning stock table
+    char s_w_id_name[] = "s_w_id";
+    char s_quantity_name[] = "s_quantity";
+    auto s_w_id = new expression::ParserExpression(EXPRESSION_TYPE_COLUMN_REF,
+                                                   s_w_id_name);
+    auto s_quantity = new expression::ParserExpression(
+        EXPRESSION_TYPE_COLUMN_REF, s_quantity_name);
+    auto predicate9 = new expression::ComparisonExpression<expression::CmpEq>(
+        EXPRESSION_TYPE_COMPARE_EQUAL, s_w_id, params[4]);
+    auto predicate10 = new expression::ComparisonExpression<expression::CmpLt>(
+        EXPRESSION_TYPE_COMPARE_LESSTHAN, s_quantity, params[5]);
+    auto predicate11 =
+        new expression::ConjunctionExpression<expression::ConjunctionAnd>(
+            EXPRESSION_TYPE_CONJUNCTION_AND, predicate9, predicate10);
+
+    predicate_column_ids = {0};
+    predicate_expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL};
+    predicate_values = {ValueFactory::GetBindingOnlyIntegerValue(4)};
+    column_ids = {1};
+
+    index = stock_table->GetIndex(0);
+    planner::IndexScanPlan::IndexScanDesc index_scan_desc2(
+        index, predicate_column_ids, predicate_expr_types, predicate_values,
+        runtime_keys);
+
+    // Create the index scan plan for STOCK
+    std::unique_ptr<planner::IndexScanPlan> stock_scan_node(
+        new planner::IndexScanPlan(stock_table, predicate11, column_ids,
+                                   index_scan_desc2));
+    LOG_DEBUG("Index scan plan for STOCK created");
+
+    // Create hash plan node
+    expression::AbstractExpression* right_table_attr_1 =
+        new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 0);
+
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        hash_keys;
+    hash_keys.emplace_back(right_table_attr_1);
+
+    // Create hash plan node
+    std::unique_ptr<planner::HashPlan> hash_plan_node(
+        new planner::HashPlan(hash_keys));
+    hash_plan_node->AddChild(std::move(stock_scan_node));
+
+    // LEFT.4 == RIGHT.1
+    expression::TupleValueExpression* left_table_attr_4 =
+        new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 0, 0);
+    right_table_attr_1 =
+        new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 0);
+    std::unique_ptr<const expression::AbstractExpression> join_predicate(
+        new expression::ComparisonExpression<expression::CmpEq>(
+            EXPRESSION_TYPE_COMPARE_EQUAL, left_table_attr_4,
+            right_table_attr_1));
+
+    auto projection = CreateHackProjection();
+    auto schema = CreateHackJoinSchema();
+    // Create hash join plan node.
+    join_plan_node.reset(
+        new planner::HashJoinPlan(JOIN_TYPE_INNER, std::move(join_predicate),
+                                  std::move(projection), schema));
+
+    // left or right?
+    join_plan_node->AddChild(std::move(orderline_scan_node));
+    join_plan_node->AddChild(std::move(hash_plan_node));
+  }
 
   expression::TupleValueExpression* left_table_attr_1 =
       new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 0, 0);
@@ -734,7 +982,7 @@ SimpleOptimizer::CreateHackingJoinPlan() {
       std::move(group_by_columns), output_table_schema, AGGREGATE_TYPE_PLAIN));
   LOG_DEBUG("Aggregation plan constructed");
 
-  agg_plan->AddChild(std::move(hash_join_plan_node));
+  agg_plan->AddChild(std::move(join_plan_node));
 
   return std::move(agg_plan);
 }
@@ -20,5 +20,28 @@ namespace optimizer {
 // Stats
 //===--------------------------------------------------------------------===//
 
+Stats::Stats(double cardinality) : cardinality(cardinality) {}
+
+void Stats::AddTableStats(oid_t table_oid,
+                          std::shared_ptr<const TableStats> stats) {
+  if (stats != nullptr) table_stats[table_oid] = stats;
+}
+
+void Stats::AddTableStats(const Stats &other) {
+  table_stats.insert(other.table_stats.begin(), other.table_stats.end());
+}
+
+const ColumnStats *Stats::GetColumnStats(const Column *column) const {
+  auto table_column = dynamic_cast<const TableColumn *>(column);
+  if (table_column == nullptr) return nullptr;
+
+  auto itr = table_stats.find(table_column->BaseTableOid());
+  if (itr == table_stats.end()) return nullptr;
+
+  oid_t column_id = table_column->ColumnIndexOid();
+  if (column_id >= itr->second->GetColumnCount()) return nullptr;
+  return &itr->second->GetColumnStats(column_id);
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
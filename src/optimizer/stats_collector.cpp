@@ -0,0 +1,220 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_collector.cpp
+//
+// Identification: src/optimizer/stats_collector.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/stats_collector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "optimizer/hyperloglog.h"
+#include "optimizer/table_stats.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace optimizer {
+
+StatsCollector &StatsCollector::GetInstance() {
+  static StatsCollector stats_collector;
+  return stats_collector;
+}
+
+StatsCollector::StatsCollector() : auto_analyze_stop(true) {}
+
+StatsCollector::~StatsCollector() {
+  // Nothing to do here !
+}
+
+std::shared_ptr<const TableStats> StatsCollector::Analyze(
+    storage::DataTable *table, concurrency::Transaction *txn) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+
+  // Changes made while the table is scanned count towards the next analyze
+  size_t modification_count = table->GetModificationCount();
+
+  size_t tuple_count = 0;
+  std::vector<size_t> null_counts(column_count, 0);
+  std::vector<HyperLogLog> distinct_sketches(column_count);
+
+  // Fixed seed, analyzing the same tuples gives the same plans
+  std::vector<std::vector<Value>> sample_rows;
+  std::mt19937_64 random_generator(table->GetOid());
+
+  oid_t tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) !=
+          VISIBILITY_OK) {
+        continue;
+      }
+      tuple_count++;
+
+      // Reservoir sampling, the n-th tuple replaces a random sampled one
+      // with probability sample_size / n
+      std::vector<Value> *sample_row = nullptr;
+      if (sample_rows.size() < sample_size) {
+        sample_rows.emplace_back();
+        sample_row = &sample_rows.back();
+      } else {
+        size_t sample_slot = std::uniform_int_distribution<size_t>(
+            0, tuple_count - 1)(random_generator);
+        if (sample_slot < sample_size) {
+          sample_row = &sample_rows[sample_slot];
+          sample_row->clear();
+        }
+      }
+
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        Value value = tile_group->GetValue(tuple_id, column_itr);
+        if (value.IsNull()) {
+          null_counts[column_itr]++;
+        } else {
+          distinct_sketches[column_itr].AddValue(value);
+        }
+
+        if (sample_row == nullptr) continue;
+        // Inlined varlen values point into the tile
+        if (value.IsNull() == false &&
+            (value.GetValueType() == VALUE_TYPE_VARCHAR ||
+             value.GetValueType() == VALUE_TYPE_VARBINARY)) {
+          value = value.copyValue();
+        }
+        sample_row->push_back(value);
+      }
+    }
+  }
+
+  std::vector<ColumnStats> column_stats;
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    std::vector<Value> column_sample;
+    for (auto &sample_row : sample_rows) {
+      if (sample_row[column_itr].IsNull() == false) {
+        column_sample.push_back(sample_row[column_itr]);
+      }
+    }
+
+    size_t non_null_count = tuple_count - null_counts[column_itr];
+    double null_fraction =
+        (tuple_count == 0) ? 0 : double(null_counts[column_itr]) / tuple_count;
+    double distinct_count =
+        std::min(distinct_sketches[column_itr].Estimate(),
+                 static_cast<double>(non_null_count));
+
+    column_stats.emplace_back(std::move(column_sample), null_fraction,
+                              distinct_count, max_mcv_count,
+                              histogram_bucket_count);
+  }
+
+  std::shared_ptr<const TableStats> table_stats(
+      new TableStats(tuple_count, modification_count, std::move(column_stats)));
+  table->SetTableStats(table_stats);
+
+  LOG_TRACE("Analyzed table %s : %s", table->GetName().c_str(),
+            table_stats->GetInfo().c_str());
+  return table_stats;
+}
+
+bool StatsCollector::NeedsAnalyze(storage::DataTable *table) const {
+  auto table_stats = table->GetTableStats();
+  size_t analyzed_modification_count = 0;
+  size_t analyzed_tuple_count = 0;
+  if (table_stats != nullptr) {
+    analyzed_modification_count = table_stats->GetModificationCount();
+    analyzed_tuple_count = table_stats->GetTupleCount();
+  }
+
+  size_t modifications =
+      table->GetModificationCount() - analyzed_modification_count;
+  return modifications >
+         analyze_threshold + analyze_scale_factor * analyzed_tuple_count;
+}
+
+void StatsCollector::Start() {
+  // Set signal
+  auto_analyze_stop = false;
+
+  // Launch thread
+  auto_analyze_thread = std::thread(&StatsCollector::AutoAnalyze, this);
+}
+
+void StatsCollector::AutoAnalyze() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Continue till signal is not false
+  while (auto_analyze_stop == false) {
+    {
+      std::lock_guard<std::mutex> lock(stats_collector_mutex);
+      for (auto table : tables) {
+        if (auto_analyze_stop == true) break;
+        if (NeedsAnalyze(table) == false) continue;
+
+        auto txn = txn_manager.BeginTransaction();
+        Analyze(table, txn);
+        txn_manager.CommitTransaction(txn);
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(auto_analyze_stop_mutex);
+    auto_analyze_stop_condition.wait_for(
+        lock, std::chrono::milliseconds(sleep_duration),
+        [this] { return auto_analyze_stop == true; });
+  }
+}
+
+void StatsCollector::Stop() {
+  // Stop analyzing
+  {
+    std::lock_guard<std::mutex> lock(auto_analyze_stop_mutex);
+    auto_analyze_stop = true;
+  }
+  auto_analyze_stop_condition.notify_all();
+
+  // Stop thread
+  if (auto_analyze_thread.joinable()) auto_analyze_thread.join();
+}
+
+void StatsCollector::AddTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(stats_collector_mutex);
+    tables.push_back(table);
+  }
+}
+
+void StatsCollector::RemoveTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(stats_collector_mutex);
+    tables.erase(std::remove(tables.begin(), tables.end(), table),
+                 tables.end());
+  }
+}
+
+void StatsCollector::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(stats_collector_mutex);
+    tables.clear();
+  }
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
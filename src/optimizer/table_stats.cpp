@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.cpp
+//
+// Identification: src/optimizer/table_stats.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/table_stats.h"
+
+#include <sstream>
+#include <utility>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace optimizer {
+
+TableStats::TableStats(size_t tuple_count, size_t modification_count,
+                       std::vector<ColumnStats> &&column_stats)
+    : tuple_count_(tuple_count),
+      modification_count_(modification_count),
+      column_stats_(std::move(column_stats)) {}
+
+const ColumnStats &TableStats::GetColumnStats(oid_t column_id) const {
+  PL_ASSERT(column_id < column_stats_.size());
+  return column_stats_[column_id];
+}
+
+double TableStats::EstimateSelectivity(oid_t column_id,
+                                       ExpressionType compare_type,
+                                       const Value &value) const {
+  return GetColumnStats(column_id).EstimateSelectivity(compare_type, value);
+}
+
+const std::string TableStats::GetInfo() const {
+  std::ostringstream os;
+
+  os << "TableStats: " << tuple_count_ << " tuples\n";
+  for (oid_t column_itr = 0; column_itr < column_stats_.size(); column_itr++) {
+    os << "Column " << column_itr << " : "
+       << column_stats_[column_itr].GetInfo() << "\n";
+  }
+
+  return os.str();
+}
+
+}  // End optimizer namespace
+}  // End peloton namespace
@@ -148,6 +148,8 @@ struct PARSER_CUST_LTYPE {
 	peloton::parser::DeleteStatement* 	  delete_stmt;
 	peloton::parser::UpdateStatement* 	  update_stmt;
 	peloton::parser::DropStatement*   	  drop_stmt;
+	peloton::parser::ImportStatement* 	  import_stmt;
+	peloton::parser::AnalyzeStatement* 	  analyze_stmt;
 	peloton::parser::PrepareStatement*     prep_stmt;
 	peloton::parser::ExecuteStatement*     exec_stmt;
 	peloton::parser::TransactionStatement* txn_stmt;
@@ -196,6 +198,7 @@ struct PARSER_CUST_LTYPE {
 %token LOAD NULL PART PLAN SHOW TEXT TIME VIEW WITH ADD ALL
 %token AND ASC CSV FOR INT KEY NOT OFF SET TOP AS BY IF
 %token IN IS OF ON OR TO
+%token IMPORT COPY STDIN TSV
 
 
 /*********************************
@@ -211,10 +214,13 @@ struct PARSER_CUST_LTYPE {
 %type <delete_stmt> delete_statement truncate_statement
 %type <update_stmt> update_statement
 %type <drop_stmt>	drop_statement
+%type <import_stmt>	import_statement
+%type <analyze_stmt>	analyze_statement
 %type <txn_stmt>    transaction_statement
-%type <sval> 		table_name opt_alias alias
+%type <sval> 		table_name opt_alias alias file_path
 %type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update
 %type <uval>		opt_join_type column_type opt_column_width opt_index_type
+%type <uval>		import_file_type opt_import_file_type
 %type <table> 		from_clause table_ref table_ref_atomic table_ref_name
 %type <table>		join_clause join_table table_ref_name_no_alias
 %type <expr> 		expr scalar_expr unary_expr binary_expr function_expr star_expr expr_alias placeholder_expr parameter_expr opt_default
@@ -292,6 +298,8 @@ preparable_statement:
 	|	truncate_statement { $$ = $1; }
 	|	update_statement { $$ = $1; }
 	|	drop_statement { $$ = $1; }
+	|	import_statement { $$ = $1; }
+	|	analyze_statement { $$ = $1; }
 	|	execute_statement { $$ = $1; }
 	|	transaction_statement { $$ = $1; }	
 	;
@@ -476,6 +484,65 @@ drop_statement:
 		}
 	;
 
+/******************************
+ * Import Statement
+ * IMPORT FROM CSV FILE 'students.csv' INTO students;
+ * COPY students FROM 'students.csv' WITH CSV;
+ * COPY students FROM STDIN;
+ ******************************/
+
+import_statement:
+		IMPORT FROM import_file_type FILE file_path INTO table_name {
+			$$ = new ImportStatement();
+			$$->type = (ImportStatement::ImportType) $3;
+			$$->file_path = $5;
+			$$->table_name = $7;
+		}
+	|	COPY table_name FROM file_path opt_import_file_type {
+			$$ = new ImportStatement();
+			$$->type = (ImportStatement::ImportType) $5;
+			$$->file_path = $4;
+			$$->table_name = $2;
+		}
+	|	COPY table_name FROM STDIN opt_import_file_type {
+			$$ = new ImportStatement();
+			$$->type = (ImportStatement::ImportType) $5;
+			$$->table_name = $2;
+		}
+	;
+
+import_file_type:
+		CSV { $$ = ImportStatement::kImportCSV; }
+	|	TSV { $$ = ImportStatement::kImportTSV; }
+	;
+
+/* COPY defaults to the tab separated text format */
+opt_import_file_type:
+		WITH import_file_type { $$ = $2; }
+	|	import_file_type { $$ = $1; }
+	|	/* empty */ { $$ = ImportStatement::kImportTSV; }
+	;
+
+file_path:
+		STRING
+	;
+
+/******************************
+ * Analyze Statement
+ * ANALYZE students;
+ * ANALYZE;
+ ******************************/
+
+analyze_statement:
+		ANALYZE table_name {
+			$$ = new AnalyzeStatement();
+			$$->table_name = $2;
+		}
+	|	ANALYZE {
+			$$ = new AnalyzeStatement();
+		}
+	;
+
 opt_exists:
 	IF EXISTS { $$ = true; }
 	|	/* empty */ { $$ = false; }
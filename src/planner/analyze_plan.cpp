@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_plan.cpp
+//
+// Identification: src/planner/analyze_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/analyze_plan.h"
+
+#include "catalog/bootstrapper.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace planner {
+
+AnalyzePlan::AnalyzePlan(storage::DataTable *table) : target_table_(table) {
+  if (target_table_ != nullptr) table_name_ = target_table_->GetName();
+}
+
+AnalyzePlan::AnalyzePlan(parser::AnalyzeStatement *parse_tree) {
+  if (parse_tree->table_name == nullptr) return;
+
+  table_name_ = parse_tree->table_name;
+  target_table_ = catalog::Bootstrapper::global_catalog->GetTableFromDatabase(
+      DEFAULT_DB_NAME, table_name_);
+}
+
+}  // namespace planner
+}  // namespace peloton
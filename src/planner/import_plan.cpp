@@ -0,0 +1,36 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_plan.cpp
+//
+// Identification: src/planner/import_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/import_plan.h"
+
+#include "catalog/bootstrapper.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace planner {
+
+ImportPlan::ImportPlan(storage::DataTable *table, const std::string &file_path,
+                       parser::ImportStatement::ImportType import_type)
+    : target_table_(table), file_path_(file_path), import_type_(import_type) {
+  if (target_table_ != nullptr) table_name_ = target_table_->GetName();
+}
+
+ImportPlan::ImportPlan(parser::ImportStatement *parse_tree)
+    : table_name_(parse_tree->table_name),
+      import_type_(parse_tree->type) {
+  if (parse_tree->file_path != nullptr) file_path_ = parse_tree->file_path;
+  target_table_ = catalog::Bootstrapper::global_catalog->GetTableFromDatabase(
+      DEFAULT_DB_NAME, table_name_);
+}
+
+}  // namespace planner
+}  // namespace peloton
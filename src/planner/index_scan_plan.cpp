@@ -15,10 +15,47 @@
 #include "common/types.h"
 #include "expression/expression_util.h"
 #include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "index/index.h"
 
 namespace peloton {
 namespace planner {
 
+/**
+ * @brief Whether the predicate only compares columns kept in the index with
+ * constants and parameters, so that it can be evaluated on the index keys.
+ */
+static bool IsEvaluableOnKey(const expression::AbstractExpression *expr,
+                             const std::vector<oid_t> &tuple_to_index) {
+  if (expr == nullptr) return true;
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_TUPLE: {
+      auto tuple_value =
+          static_cast<const expression::TupleValueExpression *>(expr);
+      auto column_id = tuple_value->GetColumnId();
+      return tuple_value->GetTupleIdx() == 0 && column_id >= 0 &&
+             (size_t)column_id < tuple_to_index.size() &&
+             tuple_to_index[column_id] != INVALID_OID;
+    }
+    case EXPRESSION_TYPE_VALUE_CONSTANT:
+    case EXPRESSION_TYPE_VALUE_PARAMETER:
+      return true;
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR:
+      return IsEvaluableOnKey(expr->GetLeft(), tuple_to_index) &&
+             IsEvaluableOnKey(expr->GetRight(), tuple_to_index);
+    default:
+      return false;
+  }
+}
+
 IndexScanPlan::IndexScanPlan(storage::DataTable *table,
                              expression::AbstractExpression *predicate,
                              const std::vector<oid_t> &column_ids,
@@ -55,6 +92,16 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
   index_predicate_.AddConjunctionScanPredicate(index_.get(), values_,
                                                key_column_ids_, expr_types_);
 
+  // An empty list of columns returns all of them, which are not checked
+  auto &tuple_to_index = index_->GetMetadata()->GetTupleToIndexMapping();
+  covered_by_index_ = (key_column_ids_.empty() == false) &&
+                      (column_ids_.empty() == false) &&
+                      IsEvaluableOnKey(predicate_with_params_.get(),
+                                       tuple_to_index);
+  for (auto column_id : column_ids_) {
+    if (tuple_to_index[column_id] == INVALID_OID) covered_by_index_ = false;
+  }
+
   return;
 }
 
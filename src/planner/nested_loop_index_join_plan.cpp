@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_index_join_plan.cpp
+//
+// Identification: src/planner/nested_loop_index_join_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/nested_loop_index_join_plan.h"
+
+#include "common/types.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/project_info.h"
+
+namespace peloton {
+namespace planner {
+
+NestedLoopIndexJoinPlan::NestedLoopIndexJoinPlan(
+    PelotonJoinType join_type,
+    std::unique_ptr<const expression::AbstractExpression> &&predicate,
+    std::unique_ptr<const ProjectInfo> &&proj_info,
+    std::shared_ptr<const catalog::Schema> &proj_schema,
+    storage::DataTable *inner_table, const std::vector<oid_t> &inner_column_ids,
+    std::shared_ptr<index::Index> inner_index,
+    const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const std::vector<Value> &values,
+    const std::vector<oid_t> &outer_column_ids)
+    : AbstractJoinPlan(join_type, std::move(predicate), std::move(proj_info),
+                       proj_schema),
+      inner_table_(inner_table),
+      inner_column_ids_(inner_column_ids),
+      index_(inner_index),
+      key_column_ids_(key_column_ids),
+      expr_types_(expr_types),
+      values_(values),
+      outer_column_ids_(outer_column_ids) {
+  PL_ASSERT(join_type == JOIN_TYPE_INNER || join_type == JOIN_TYPE_LEFT);
+  PL_ASSERT(index_ != nullptr);
+  PL_ASSERT(key_column_ids_.size() == expr_types_.size());
+  PL_ASSERT(key_column_ids_.size() == values_.size());
+  PL_ASSERT(key_column_ids_.size() == outer_column_ids_.size());
+}
+
+void NestedLoopIndexJoinPlan::SetParameterValues(std::vector<Value> *values) {
+  // The parameters of the keys are bound by the executor
+  for (auto &child_plan : GetChildren()) {
+    child_plan->SetParameterValues(values);
+  }
+}
+
+}  // namespace planner
+}  // namespace peloton
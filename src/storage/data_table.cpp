@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
+#include <numeric>
+#include <thread>
 #include <utility>
 
 #include "brain/clusterer.h"
@@ -18,12 +21,15 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "container/lock_free_queue.h"
 #include "catalog/foreign_key.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "concurrency/transaction.h"
+#include "expression/container_tuple.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
+#include "optimizer/plan_cache.h"
 #include "storage/tile_group.h"
 #include "storage/tuple.h"
 #include "storage/tile.h"
@@ -43,6 +49,9 @@ double peloton_projectivity;
 
 int peloton_num_groups;
 
+// Logging mode
+extern LoggingType peloton_logging_mode;
+
 namespace peloton {
 namespace storage {
 
@@ -54,12 +63,24 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
                      const bool adapt_table)
     : AbstractTable(database_oid, table_oid, table_name, schema, own_schema),
       tuples_per_tilegroup_(tuples_per_tilegroup),
-      adapt_table_(adapt_table) {
+      adapt_table_(adapt_table),
+      layout_samples_(new LockFreeQueue<brain::Sample>(SAMPLE_BUFFER_SIZE)),
+      index_samples_(new LockFreeQueue<brain::Sample>(SAMPLE_BUFFER_SIZE)) {
   // Init default partition
   auto col_count = schema->GetColumnCount();
   for (oid_t col_itr = 0; col_itr < col_count; col_itr++) {
     default_partition_[col_itr] = std::make_pair(0, col_itr);
   }
+
+  // Create the dictionaries of dictionary encoded columns
+  dictionaries_.resize(col_count);
+  for (oid_t col_itr = 0; col_itr < col_count; col_itr++) {
+    if (schema->IsDictionaryEncoded(col_itr)) {
+      dictionaries_[col_itr].reset(
+          new Dictionary(GetBackendType(peloton_logging_mode)));
+    }
+  }
+
   // Create a tile group.
   for (size_t i = 0; i < ACTIVE_TILEGROUP_COUNT; ++i) {
     AddDefaultTileGroup(i);
@@ -483,6 +504,7 @@ bool DataTable::CheckForeignKeyConstraints(const storage::Tuple *tuple
  */
 void DataTable::IncreaseTupleCount(const size_t &amount) {
   number_of_tuples_ += amount;
+  modification_count_ += amount;
   dirty_ = true;
 }
 
@@ -492,6 +514,7 @@ void DataTable::IncreaseTupleCount(const size_t &amount) {
  */
 void DataTable::DecreaseTupleCount(const size_t &amount) {
   number_of_tuples_ -= amount;
+  modification_count_ += amount;
   dirty_ = true;
 }
 
@@ -521,6 +544,29 @@ bool DataTable::IsDirty() const { return dirty_; }
  */
 void DataTable::ResetDirty() { dirty_ = false; }
 
+/**
+ * @brief Get the number of tuple versions added or removed so far
+ * @return modification count
+ */
+size_t DataTable::GetModificationCount() const { return modification_count_; }
+
+/**
+ * @brief Get the statistics of the last analyze of this table
+ * @return table statistics, nullptr if the table was never analyzed
+ */
+std::shared_ptr<const optimizer::TableStats> DataTable::GetTableStats() const {
+  return std::atomic_load(&table_stats_);
+}
+
+/**
+ * @brief Replace the statistics of this table
+ * @param table_stats statistics of a new analyze
+ */
+void DataTable::SetTableStats(
+    std::shared_ptr<const optimizer::TableStats> table_stats) {
+  std::atomic_store(&table_stats_, table_stats);
+}
+
 //===--------------------------------------------------------------------===//
 // TILE GROUP
 //===--------------------------------------------------------------------===//
@@ -585,6 +631,11 @@ column_map_type DataTable::GetTileGroupLayout(LayoutType layout_type) {
   return column_map;
 }
 
+TileGroup *DataTable::GetTileGroupWithDefaultLayout() {
+  return GetTileGroupWithLayout(
+      GetTileGroupLayout((LayoutType)peloton_layout_mode));
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
   size_t active_tile_group_id = number_of_tuples_ % ACTIVE_TILEGROUP_COUNT;
   return AddDefaultTileGroup(active_tile_group_id);
@@ -668,6 +719,10 @@ void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
 
   active_tile_groups_[active_tile_group_id] = tile_group;
 
+  AppendTileGroup(tile_group);
+}
+
+void DataTable::AppendTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
   tile_groups_.Append(tile_group_id);
@@ -780,6 +835,145 @@ void DataTable::AddIndex(std::shared_ptr<index::Index> index) {
   }
 }
 
+void DataTable::AddIndexOnline(std::shared_ptr<index::Index> index) {
+  // The writers maintain the index as soon as they see it, the scans wait
+  // for BuildIndex to index the tuples of the tile groups it has
+  index->SetReadable(false);
+  AddIndex(index);
+}
+
+bool DataTable::BuildIndex(const std::shared_ptr<index::Index> &index,
+                           oid_t tile_group_count, size_t thread_count,
+                           size_t sleep_duration) {
+  oid_t table_tile_group_count = GetTileGroupCount();
+
+  // A readable index holds the tuples of every tile group
+  if (index->IsReadable() == true) {
+    while (index->GetIndexedTileGroupOff() < table_tile_group_count) {
+      index->IncrementIndexedTileGroupOffset();
+    }
+    return true;
+  }
+
+  oid_t begin_offset = index->GetIndexedTileGroupOff();
+  oid_t end_offset =
+      std::min<oid_t>(table_tile_group_count, begin_offset + tile_group_count);
+
+  // Unique indexes are not maintained on insert either, see InsertInIndexes,
+  // so they are never complete enough to be read
+  if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_UNIQUE) {
+    while (index->GetIndexedTileGroupOff() < table_tile_group_count) {
+      index->IncrementIndexedTileGroupOffset();
+    }
+    return true;
+  }
+
+  if (begin_offset < end_offset) {
+    // Versions that ended before the snapshot are garbage to the scans of
+    // the built index. The others are not garbage collected before it ends.
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto snapshot_txn = txn_manager.BeginTransaction();
+    cid_t snapshot_cid = snapshot_txn->GetBeginCommitId();
+
+    // A chunk of the tile groups per thread
+    oid_t batch_size = end_offset - begin_offset;
+    thread_count = std::max<size_t>(1, std::min<size_t>(thread_count,
+                                                        batch_size));
+    std::vector<std::thread> threads;
+    for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+      oid_t chunk_begin = begin_offset + batch_size * thread_itr / thread_count;
+      oid_t chunk_end =
+          begin_offset + batch_size * (thread_itr + 1) / thread_count;
+
+      threads.push_back(std::thread([this, &index, chunk_begin, chunk_end,
+                                     snapshot_cid, sleep_duration]() {
+        for (oid_t tile_group_offset = chunk_begin;
+             tile_group_offset < chunk_end; tile_group_offset++) {
+          BuildIndexTileGroup(index.get(), tile_group_offset, snapshot_cid);
+
+          // Leave the cores to the writers for a while
+          if (sleep_duration > 0) {
+            std::this_thread::sleep_for(
+                std::chrono::microseconds(sleep_duration));
+          }
+        }
+      }));
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    txn_manager.CommitTransaction(snapshot_txn);
+  }
+
+  for (oid_t tile_group_offset = begin_offset; tile_group_offset < end_offset;
+       tile_group_offset++) {
+    index->IncrementIndexedTileGroupOffset();
+  }
+
+  if (index->GetIndexedTileGroupOff() < GetTileGroupCount()) {
+    return false;
+  }
+
+  // Every tuple is either indexed or inserted by a writer seeing the index
+  index->SetReadable(true);
+
+  // Plans cached before could not scan it
+  optimizer::PlanCache::GetInstance().Clear();
+
+  LOG_TRACE("Built index %s", index->GetName().c_str());
+  return true;
+}
+
+void DataTable::BuildIndexTileGroup(index::Index *index,
+                                    oid_t tile_group_offset,
+                                    cid_t snapshot_cid) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    // Skip the empty slots and the versions that ended before the snapshot
+    if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_id) < snapshot_cid) {
+      continue;
+    }
+
+    // The entries of the index point to the head of the version chain
+    ItemPointer *index_entry_ptr = tile_group_header->GetIndirection(tuple_id);
+    if (index_entry_ptr == nullptr) {
+      // Inserted while the table had no index, the version is its own head
+      if (tile_group_header->GetPrevItemPointer(tuple_id).IsNull() == false) {
+        continue;
+      }
+      index_entry_ptr = new ItemPointer(tile_group_id, tuple_id);
+      if (tile_group_header->SetAtomicIndirection(tuple_id, index_entry_ptr) ==
+          false) {
+        delete index_entry_ptr;
+        index_entry_ptr = tile_group_header->GetIndirection(tuple_id);
+      }
+    }
+
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                         tuple_id);
+    key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+    // Unless a writer has already inserted the entry of the version
+    index->CondInsertEntry(
+        key.get(), index_entry_ptr,
+        [index_entry_ptr](const ItemPointer &location) {
+          return location.block == index_entry_ptr->block &&
+                 location.offset == index_entry_ptr->offset;
+        });
+  }
+}
+
 std::shared_ptr<index::Index> DataTable::GetIndexWithOid(
     const oid_t &index_oid) {
 
@@ -815,6 +1009,9 @@ void DataTable::DropIndexWithOid(const oid_t &index_oid) {
 
   // Drop index column info
   indexes_columns_.erase(indexes_columns_.begin() + index_offset);
+
+  // Plans cached before may scan it
+  optimizer::PlanCache::GetInstance().Clear();
 }
 
 std::shared_ptr<index::Index> DataTable::GetIndex(const oid_t &index_offset) {
@@ -985,6 +1182,7 @@ storage::TileGroup *DataTable::TransformTileGroup(
 
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+  new_tile_group->RebuildZoneMap();
 
   // Set the location of the new tile group
   // and clean up the orig tile group
@@ -993,46 +1191,209 @@ storage::TileGroup *DataTable::TransformTileGroup(
   return new_tile_group.get();
 }
 
-void DataTable::RecordLayoutSample(const brain::Sample &sample) {
-  // Add layout sample
-  {
-    std::lock_guard<std::mutex> lock(layout_samples_mutex_);
-    layout_samples_.push_back(sample);
+bool DataTable::EncodeTileGroup(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= GetTileGroupCount()) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return false;
+  }
+  auto tile_group = GetTileGroup(tile_group_offset);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  bool frozen = tile_group->IsFrozen();
+
+  // Only full tile groups are encoded. Once the transactions that may still
+  // be filling their slots have ended, their strings are no longer written.
+  if (frozen == false) {
+    auto header = tile_group->GetHeader();
+    if (header->GetCurrentNextTupleSlot() <
+        tile_group->GetAllocatedTupleCount()) {
+      LOG_TRACE("Tile group %u still takes inserts",
+                tile_group->GetTileGroupId());
+      return false;
+    }
+
+    txn_manager.WaitForRunningTransactions();
+    if (header->IsFullyCommitted() == false) {
+      LOG_TRACE("Tile group %u has in-flight versions",
+                tile_group->GetTileGroupId());
+      return false;
+    }
+  }
+
+  bool encoded = true;
+  for (oid_t column_itr = 0; column_itr < dictionaries_.size(); column_itr++) {
+    if (dictionaries_[column_itr] == nullptr) continue;
+    if (tile_group->EncodeDictionary(column_itr, dictionaries_[column_itr]) ==
+        false) {
+      LOG_TRACE("Column %u of tile group %u not dictionary encoded",
+                column_itr, tile_group->GetTileGroupId());
+      encoded = false;
+    }
   }
+  if (frozen) return encoded;
+
+  // The tiles' own copies of the encoded strings are dropped, and freed once
+  // the transactions that may still be reading them have ended
+  std::vector<std::unique_ptr<VarlenPool>> retired_pools;
+  for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount();
+       tile_itr++) {
+    retired_pools.push_back(tile_group->GetTile(tile_itr)->CompactPool());
+  }
+  txn_manager.WaitForRunningTransactions();
+
+  return encoded;
 }
 
-const std::vector<brain::Sample> &DataTable::GetLayoutSamples() const {
-  return layout_samples_;
+// Hand back the versions claimed by a freeze
+static void ReleaseVersions(TileGroupHeader *header,
+                            const std::vector<oid_t> &claimed_slots,
+                            const txn_id_t &freeze_txn_id) {
+  for (auto tuple_slot_id : claimed_slots) {
+    header->SetAtomicTransactionId(tuple_slot_id, freeze_txn_id,
+                                   INITIAL_TXN_ID);
+  }
 }
 
-void DataTable::ClearLayoutSamples() {
-  // Clear layout samples list
-  {
-    std::lock_guard<std::mutex> lock(layout_samples_mutex_);
-    layout_samples_.clear();
+bool DataTable::FreezeTileGroup(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= GetTileGroupCount()) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return false;
+  }
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr || tile_group->IsFrozen()) return false;
+
+  // Inserts still go to the active tile groups
+  for (size_t active_itr = 0; active_itr < ACTIVE_TILEGROUP_COUNT;
+       active_itr++) {
+    auto active_tile_group = active_tile_groups_[active_itr];
+    if (active_tile_group != nullptr &&
+        active_tile_group->GetTileGroupId() == tile_group_id) {
+      return false;
+    }
+  }
+
+  // Own every committed version, as a writer would, so that no transaction
+  // reads or writes the hot tile group from now on
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto freeze_txn_id = txn_manager.GetNextTransactionId();
+  auto header = tile_group->GetHeader();
+  oid_t tuple_count = header->GetCurrentNextTupleSlot();
+  std::vector<oid_t> claimed_slots;
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+       tuple_slot_id++) {
+    auto txn_id = header->SetAtomicTransactionId(tuple_slot_id, INITIAL_TXN_ID,
+                                                 freeze_txn_id);
+    if (txn_id == INITIAL_TXN_ID) {
+      claimed_slots.push_back(tuple_slot_id);
+    } else if (txn_id != INVALID_TXN_ID) {
+      LOG_TRACE("Tile group %u has in-flight versions", tile_group_id);
+      ReleaseVersions(header, claimed_slots, freeze_txn_id);
+      return false;
+    }
+  }
+
+  LOG_TRACE("Freezing tile group : %u", tile_group_offset);
+
+  // The transactions that got to the versions first are done with them
+  // once the ones running now have ended
+  txn_manager.WaitForRunningTransactions();
+
+  std::shared_ptr<storage::TileGroup> frozen_tile_group(
+      TileGroupFactory::GetFrozenTileGroup(tile_group.get(), dictionaries_));
+
+  // The copied versions are unowned, and their read timestamps are older
+  // than any running transaction
+  auto frozen_header = frozen_tile_group->GetHeader();
+  for (auto tuple_slot_id : claimed_slots) {
+    frozen_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+    PL_MEMSET(frozen_header->GetReservedFieldRef(tuple_slot_id), 0,
+              TileGroupHeader::GetReservedSize());
   }
+
+  // Set the location of the frozen tile group. Transactions still holding
+  // the hot tile group find its versions owned and abort.
+  catalog_manager.AddTileGroup(tile_group_id, frozen_tile_group);
+
+  return true;
 }
 
-void DataTable::RecordIndexSample(const brain::Sample &sample) {
-  // Add index sample
-  {
-    std::lock_guard<std::mutex> lock(index_samples_mutex_);
-    index_samples_.push_back(sample);
+std::shared_ptr<Dictionary> DataTable::GetDictionary(
+    const oid_t &column_id) const {
+  PL_ASSERT(column_id < dictionaries_.size());
+  return dictionaries_[column_id];
+}
+
+bool DataTable::SampleAccess() {
+  if (peloton_sample_rate <= 0) return false;
+  return access_count_.fetch_add(1, std::memory_order_relaxed) %
+             peloton_sample_rate ==
+         0;
+}
+
+// Dequeue the samples in the buffer
+static std::vector<brain::Sample> TakeSamples(
+    LockFreeQueue<brain::Sample> &samples) {
+  std::vector<brain::Sample> taken_samples;
+  brain::Sample sample(0);
+  while (samples.Dequeue(sample)) {
+    taken_samples.push_back(sample);
   }
+  return taken_samples;
 }
 
-const std::vector<brain::Sample> &DataTable::GetIndexSamples() const {
-  return index_samples_;
+void DataTable::RecordLayoutSample(const brain::Sample &sample) {
+  if (layout_samples_->TryEnqueue(sample) == false) {
+    LOG_TRACE("Dropping layout sample of table %u", GetOid());
+  }
 }
 
-void DataTable::ClearIndexSamples() {
-  // Clear index samples list
-  {
-    std::lock_guard<std::mutex> lock(index_samples_mutex_);
-    index_samples_.clear();
+size_t DataTable::GetLayoutSampleCount() const {
+  return layout_samples_->GetSizeApprox();
+}
+
+std::vector<brain::Sample> DataTable::TakeLayoutSamples() {
+  return TakeSamples(*layout_samples_);
+}
+
+void DataTable::ClearLayoutSamples() { TakeSamples(*layout_samples_); }
+
+void DataTable::RecordIndexSample(const brain::Sample &sample) {
+  if (index_samples_->TryEnqueue(sample) == false) {
+    LOG_TRACE("Dropping index sample of table %u", GetOid());
   }
 }
 
+void DataTable::RecordWriteSample(const std::vector<oid_t> &column_ids,
+                                  size_t tuple_count) {
+  if (SampleAccess() == false) return;
+
+  // Index samples hold the ids of the columns
+  std::vector<double> written_columns(column_ids.begin(), column_ids.end());
+  if (written_columns.empty()) {
+    written_columns.resize(schema->GetColumnCount());
+    std::iota(written_columns.begin(), written_columns.end(), 0);
+  }
+
+  // The tuples written weigh the sample against those of the scans
+  double weight = std::max<size_t>(tuple_count, 1);
+  RecordIndexSample(
+      brain::Sample(written_columns, weight, brain::SAMPLE_TYPE_UPDATE));
+}
+
+size_t DataTable::GetIndexSampleCount() const {
+  return index_samples_->GetSizeApprox();
+}
+
+std::vector<brain::Sample> DataTable::TakeIndexSamples() {
+  return TakeSamples(*index_samples_);
+}
+
+void DataTable::ClearIndexSamples() { TakeSamples(*index_samples_); }
+
 std::map<oid_t, oid_t> DataTable::GetColumnMapStats() {
   std::map<oid_t, oid_t> column_map_stats;
 
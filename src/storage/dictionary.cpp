@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary.cpp
+//
+// Identification: src/storage/dictionary.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/dictionary.h"
+
+#include "common/logger.h"
+#include "common/pool.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "common/varlen.h"
+
+namespace peloton {
+namespace storage {
+
+Dictionary::Dictionary(BackendType backend_type)
+    : entry_count_(0), pool_(new VarlenPool(backend_type)) {
+  for (auto &chunk : chunks_) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+Dictionary::~Dictionary() {
+  // the strings themselves go away with the pool
+  for (auto &chunk : chunks_) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+bool Dictionary::Encode(const char *data, int32_t length, Code *code) {
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  std::string key(data, length);
+  auto entry_itr = codes_.find(key);
+  if (entry_itr != codes_.end()) {
+    *code = entry_itr->second;
+    return true;
+  }
+
+  size_t entry_count = entry_count_.load(std::memory_order_relaxed);
+  if (entry_count >= MAX_ENTRY_COUNT) {
+    LOG_TRACE("Dictionary is full with %lu entries", entry_count);
+    return false;
+  }
+
+  // Store the string exactly like Tile::SetValue would
+  Value value = ValueFactory::GetStringValue(key);
+  Varlen *varlen = nullptr;
+  value.SerializeToTupleStorageAllocateForObjects(
+      reinterpret_cast<char *>(&varlen), false, length, false, pool_.get());
+  Value stored =
+      Value::InitFromTupleStorage(&varlen, VALUE_TYPE_VARCHAR, false);
+
+  auto chunk_id = entry_count / ENTRIES_PER_CHUNK;
+  Entry *chunk = chunks_[chunk_id].load(std::memory_order_relaxed);
+  if (chunk == nullptr) {
+    chunk = new Entry[ENTRIES_PER_CHUNK];
+    chunks_[chunk_id].store(chunk, std::memory_order_release);
+  }
+
+  Entry &entry = chunk[entry_count % ENTRIES_PER_CHUNK];
+  entry.varlen = varlen;
+  entry.data = reinterpret_cast<const char *>(
+      ValuePeeker::PeekObjectValueWithoutNull(stored));
+  entry.length = length;
+  entry.hash = std::hash<std::string>()(key);
+
+  *code = static_cast<Code>(entry_count);
+  codes_.emplace(std::move(key), *code);
+
+  // publish the entry
+  entry_count_.store(entry_count + 1, std::memory_order_release);
+  return true;
+}
+
+bool Dictionary::Lookup(const char *data, int32_t length, Code *code) const {
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  auto entry_itr = codes_.find(std::string(data, length));
+  if (entry_itr == codes_.end()) return false;
+
+  *code = entry_itr->second;
+  return true;
+}
+
+int64_t Dictionary::GetMemorySize() const {
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  int64_t size = pool_->GetAllocatedMemory();
+  for (auto &chunk : chunks_) {
+    if (chunk.load(std::memory_order_relaxed) != nullptr) {
+      size += ENTRIES_PER_CHUNK * sizeof(Entry);
+    }
+  }
+  for (auto &entry : codes_) {
+    size += sizeof(entry) + entry.first.capacity();
+  }
+  return size;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,456 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// encoded_column.cpp
+//
+// Identification: src/storage/encoded_column.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/pool.h"
+#include "common/value_peeker.h"
+#include "storage/encoded_column.h"
+#include "storage/tile.h"
+
+namespace peloton {
+namespace storage {
+
+EncodedColumn::EncodedColumn(Tile *tile, const oid_t column_id,
+                             const oid_t tuple_count,
+                             const std::shared_ptr<Dictionary> &dictionary,
+                             VarlenPool *pool)
+    : encoding_type_(ENCODING_TYPE_PLAIN),
+      value_type_(tile->GetSchema()->GetType(column_id)),
+      is_inlined_(tile->GetSchema()->IsInlined(column_id)),
+      tuple_count_(tuple_count),
+      field_length_(tile->GetSchema()->GetLength(column_id)) {
+  PL_ASSERT(tile->IsFrozen() == false);
+  PL_ASSERT(tuple_count <= tile->GetAllocatedTupleCount());
+
+  switch (value_type_) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      EncodeIntegers(tile, column_id);
+      break;
+
+    case VALUE_TYPE_VARCHAR:
+      if (is_inlined_ == false &&
+          EncodeDictionary(tile, column_id, dictionary) == true) {
+        break;
+      }
+      EncodePlain(tile, column_id, pool);
+      break;
+
+    default:
+      EncodePlain(tile, column_id, pool);
+      break;
+  }
+
+  LOG_TRACE("Column %u : %s, %ld bytes", column_id,
+            EncodingTypeToString(encoding_type_).c_str(), GetMemorySize());
+}
+
+//===--------------------------------------------------------------------===//
+// Encoding
+//===--------------------------------------------------------------------===//
+
+int64_t EncodedColumn::ReadInteger(const char *field, size_t width) {
+  switch (width) {
+    case 1:
+      return *reinterpret_cast<const int8_t *>(field);
+    case 2:
+      return *reinterpret_cast<const int16_t *>(field);
+    case 4:
+      return *reinterpret_cast<const int32_t *>(field);
+    case 8:
+      return *reinterpret_cast<const int64_t *>(field);
+    default:
+      throw Exception("EncodedColumn : invalid integer width " +
+                      std::to_string(width));
+  }
+}
+
+void EncodedColumn::WriteInteger(char *field, size_t width, int64_t value) {
+  switch (width) {
+    case 1:
+      *reinterpret_cast<int8_t *>(field) = static_cast<int8_t>(value);
+      break;
+    case 2:
+      *reinterpret_cast<int16_t *>(field) = static_cast<int16_t>(value);
+      break;
+    case 4:
+      *reinterpret_cast<int32_t *>(field) = static_cast<int32_t>(value);
+      break;
+    case 8:
+      *reinterpret_cast<int64_t *>(field) = value;
+      break;
+    default:
+      throw Exception("EncodedColumn : invalid integer width " +
+                      std::to_string(width));
+  }
+}
+
+// NULL sentinel of an integer field of the given width
+static int64_t GetIntegerNull(size_t width) {
+  switch (width) {
+    case 1:
+      return INT8_NULL;
+    case 2:
+      return INT16_NULL;
+    case 4:
+      return INT32_NULL;
+    default:
+      return INT64_NULL;
+  }
+}
+
+void EncodedColumn::EncodeIntegers(Tile *tile, const oid_t column_id) {
+  const size_t column_offset = tile->GetSchema()->GetOffset(column_id);
+  const int64_t null_value = GetIntegerNull(field_length_);
+
+  std::vector<int64_t> values(tuple_count_);
+  bool has_values = false;
+  int64_t min = 0, max = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+    int64_t value = ReadInteger(
+        tile->GetTupleLocation(tuple_itr) + column_offset, field_length_);
+    values[tuple_itr] = value;
+
+    // Count runs as we go
+    if (tuple_itr == 0 || value != run_values_.back()) {
+      run_values_.push_back(value);
+      run_ends_.push_back(tuple_itr + 1);
+    } else {
+      run_ends_.back() = tuple_itr + 1;
+    }
+
+    if (value == null_value) {
+      has_nulls_ = true;
+    } else if (has_values == false) {
+      min = max = value;
+      has_values = true;
+    } else {
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+  }
+
+  // Offsets from the minimum, one more for NULL
+  uint64_t max_offset =
+      static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  if (has_nulls_ && max_offset == UINT64_MAX) {
+    run_values_.clear();
+    run_ends_.clear();
+    encoding_type_ = ENCODING_TYPE_PLAIN;
+    plain_.reset(new char[tuple_count_ * field_length_]);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+      WriteInteger(plain_.get() + tuple_itr * field_length_, field_length_,
+                   values[tuple_itr]);
+    }
+    return;
+  }
+  if (has_nulls_) max_offset++;
+
+  bit_width_ = 0;
+  while (bit_width_ < 64 && (max_offset >> bit_width_) != 0) bit_width_++;
+
+  size_t rle_size = run_values_.size() * (sizeof(int64_t) + sizeof(oid_t));
+  size_t packed_words = (tuple_count_ * bit_width_ + 63) / 64;
+  size_t packed_size = packed_words * sizeof(uint64_t);
+
+  if (rle_size <= packed_size) {
+    encoding_type_ = ENCODING_TYPE_RLE;
+    run_values_.shrink_to_fit();
+    run_ends_.shrink_to_fit();
+    return;
+  }
+
+  run_values_.clear();
+  run_values_.shrink_to_fit();
+  run_ends_.clear();
+  run_ends_.shrink_to_fit();
+
+  encoding_type_ = ENCODING_TYPE_BITPACKED;
+  base_ = min;
+  null_offset_ = max_offset;
+
+  // One padding word, so reads may always touch the next word
+  packed_.assign(packed_words + 1, 0);
+  uint64_t bit_position = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+    int64_t value = values[tuple_itr];
+    uint64_t offset =
+        (value == null_value)
+            ? null_offset_
+            : static_cast<uint64_t>(value) - static_cast<uint64_t>(base_);
+
+    size_t word = bit_position / 64;
+    uint32_t shift = bit_position % 64;
+    packed_[word] |= offset << shift;
+    if (shift != 0 && shift + bit_width_ > 64) {
+      packed_[word + 1] |= offset >> (64 - shift);
+    }
+    bit_position += bit_width_;
+  }
+}
+
+bool EncodedColumn::EncodeDictionary(
+    Tile *tile, const oid_t column_id,
+    const std::shared_ptr<Dictionary> &dictionary) {
+  codes_.reset(new Dictionary::Code[tuple_count_]);
+
+  // Reuse the codes of a dictionary encoded hot tile
+  auto tile_codes = tile->GetDictionaryCodes(column_id);
+  if (tile_codes != nullptr) {
+    dictionary_ = tile->GetDictionaryReference(column_id);
+    PL_MEMCPY(codes_.get(), tile_codes,
+              tuple_count_ * sizeof(Dictionary::Code));
+    encoding_type_ = ENCODING_TYPE_DICTIONARY;
+    return true;
+  }
+
+  dictionary_ = dictionary;
+  if (dictionary_ == nullptr) {
+    dictionary_.reset(new Dictionary(BACKEND_TYPE_MM));
+  }
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+    Value value = tile->GetValue(tuple_itr, column_id);
+    if (value.IsNull()) {
+      codes_[tuple_itr] = Dictionary::NULL_CODE;
+      continue;
+    }
+
+    if (dictionary_->Encode(reinterpret_cast<const char *>(
+                                ValuePeeker::PeekObjectValueWithoutNull(value)),
+                            ValuePeeker::PeekObjectLengthWithoutNull(value),
+                            &codes_[tuple_itr]) == false) {
+      LOG_TRACE("Dictionary full, column %u stays plain", column_id);
+      dictionary_.reset();
+      codes_.reset();
+      return false;
+    }
+  }
+
+  encoding_type_ = ENCODING_TYPE_DICTIONARY;
+  return true;
+}
+
+void EncodedColumn::EncodePlain(Tile *tile, const oid_t column_id,
+                                VarlenPool *pool) {
+  encoding_type_ = ENCODING_TYPE_PLAIN;
+  plain_.reset(new char[tuple_count_ * field_length_]);
+
+  const size_t column_offset = tile->GetSchema()->GetOffset(column_id);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+    char *field = plain_.get() + tuple_itr * field_length_;
+
+    if (is_inlined_) {
+      PL_MEMCPY(field, tile->GetTupleLocation(tuple_itr) + column_offset,
+                field_length_);
+      continue;
+    }
+
+    // Uninlined values must outlive the hot tile's pool
+    PL_ASSERT(pool != nullptr);
+    Value value = tile->GetValue(tuple_itr, column_id);
+    const bool is_in_bytes = false;
+    value.SerializeToTupleStorageAllocateForObjects(
+        field, false, tile->GetSchema()->GetVariableLength(column_id),
+        is_in_bytes, pool);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Decoding
+//===--------------------------------------------------------------------===//
+
+int64_t EncodedColumn::GetInteger(const oid_t tuple_offset) const {
+  if (encoding_type_ == ENCODING_TYPE_RLE) {
+    auto run = std::upper_bound(run_ends_.begin(), run_ends_.end(),
+                                tuple_offset);
+    return run_values_[run - run_ends_.begin()];
+  }
+
+  PL_ASSERT(encoding_type_ == ENCODING_TYPE_BITPACKED);
+  if (bit_width_ == 0) {
+    return has_nulls_ ? GetIntegerNull(field_length_) : base_;
+  }
+
+  uint64_t bit_position = static_cast<uint64_t>(tuple_offset) * bit_width_;
+  size_t word = bit_position / 64;
+  uint32_t shift = bit_position % 64;
+  uint64_t offset = packed_[word] >> shift;
+  if (shift != 0 && shift + bit_width_ > 64) {
+    offset |= packed_[word + 1] << (64 - shift);
+  }
+  if (bit_width_ < 64) offset &= (UINT64_C(1) << bit_width_) - 1;
+
+  if (has_nulls_ && offset == null_offset_) {
+    return GetIntegerNull(field_length_);
+  }
+  return static_cast<int64_t>(static_cast<uint64_t>(base_) + offset);
+}
+
+Value EncodedColumn::GetValue(const oid_t tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+
+  switch (encoding_type_) {
+    case ENCODING_TYPE_RLE:
+    case ENCODING_TYPE_BITPACKED: {
+      char field[sizeof(int64_t)];
+      WriteInteger(field, field_length_, GetInteger(tuple_offset));
+      return Value::InitFromTupleStorage(field, value_type_, true);
+    }
+
+    case ENCODING_TYPE_DICTIONARY: {
+      auto code = codes_[tuple_offset];
+      Varlen *varlen = (code == Dictionary::NULL_CODE)
+                           ? nullptr
+                           : dictionary_->GetVarlen(code);
+      return Value::InitFromTupleStorage(&varlen, value_type_, false);
+    }
+
+    case ENCODING_TYPE_PLAIN:
+    default:
+      return Value::InitFromTupleStorage(
+          plain_.get() + tuple_offset * field_length_, value_type_,
+          is_inlined_);
+  }
+}
+
+template <typename T>
+void EncodedColumn::DecodeBitPacked(const oid_t begin, const oid_t count,
+                                    char *output) const {
+  T *fields = reinterpret_cast<T *>(output);
+  const T null_value = static_cast<T>(GetIntegerNull(sizeof(T)));
+
+  if (bit_width_ == 0) {
+    std::fill(fields, fields + count,
+              has_nulls_ ? null_value : static_cast<T>(base_));
+    return;
+  }
+
+  const uint64_t mask =
+      (bit_width_ < 64) ? (UINT64_C(1) << bit_width_) - 1 : UINT64_MAX;
+  uint64_t bit_position = static_cast<uint64_t>(begin) * bit_width_;
+  for (oid_t tuple_itr = 0; tuple_itr < count; tuple_itr++) {
+    size_t word = bit_position / 64;
+    uint32_t shift = bit_position % 64;
+    uint64_t offset = packed_[word] >> shift;
+    if (shift != 0 && shift + bit_width_ > 64) {
+      offset |= packed_[word + 1] << (64 - shift);
+    }
+    offset &= mask;
+    bit_position += bit_width_;
+
+    fields[tuple_itr] =
+        (has_nulls_ && offset == null_offset_)
+            ? null_value
+            : static_cast<T>(static_cast<uint64_t>(base_) + offset);
+  }
+}
+
+void EncodedColumn::Decode(const oid_t begin, const oid_t count,
+                           char *output) const {
+  PL_ASSERT(begin + count <= tuple_count_);
+
+  switch (encoding_type_) {
+    case ENCODING_TYPE_RLE: {
+      // Fill from the run holding the first slot onwards
+      auto run = std::upper_bound(run_ends_.begin(), run_ends_.end(), begin) -
+                 run_ends_.begin();
+      oid_t tuple_itr = begin;
+      const oid_t end = begin + count;
+      while (tuple_itr < end) {
+        oid_t run_end = std::min(run_ends_[run], end);
+        for (; tuple_itr < run_end; tuple_itr++) {
+          WriteInteger(output + (tuple_itr - begin) * field_length_,
+                       field_length_, run_values_[run]);
+        }
+        run++;
+      }
+    } break;
+
+    case ENCODING_TYPE_BITPACKED:
+      switch (field_length_) {
+        case 1:
+          DecodeBitPacked<int8_t>(begin, count, output);
+          break;
+        case 2:
+          DecodeBitPacked<int16_t>(begin, count, output);
+          break;
+        case 4:
+          DecodeBitPacked<int32_t>(begin, count, output);
+          break;
+        default:
+          DecodeBitPacked<int64_t>(begin, count, output);
+          break;
+      }
+      break;
+
+    case ENCODING_TYPE_DICTIONARY: {
+      Varlen **fields = reinterpret_cast<Varlen **>(output);
+      for (oid_t tuple_itr = 0; tuple_itr < count; tuple_itr++) {
+        auto code = codes_[begin + tuple_itr];
+        fields[tuple_itr] = (code == Dictionary::NULL_CODE)
+                                ? nullptr
+                                : dictionary_->GetVarlen(code);
+      }
+    } break;
+
+    case ENCODING_TYPE_PLAIN:
+    default:
+      PL_MEMCPY(output, plain_.get() + begin * field_length_,
+                count * field_length_);
+      break;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Utilities
+//===--------------------------------------------------------------------===//
+
+int64_t EncodedColumn::GetMemorySize() const {
+  switch (encoding_type_) {
+    case ENCODING_TYPE_RLE:
+      return run_values_.size() * (sizeof(int64_t) + sizeof(oid_t));
+    case ENCODING_TYPE_BITPACKED:
+      return packed_.size() * sizeof(uint64_t);
+    case ENCODING_TYPE_DICTIONARY:
+      return tuple_count_ * sizeof(Dictionary::Code);
+    case ENCODING_TYPE_PLAIN:
+    default:
+      return tuple_count_ * field_length_;
+  }
+}
+
+std::string EncodedColumn::EncodingTypeToString(EncodingType encoding_type) {
+  switch (encoding_type) {
+    case ENCODING_TYPE_PLAIN:
+      return "PLAIN";
+    case ENCODING_TYPE_RLE:
+      return "RLE";
+    case ENCODING_TYPE_BITPACKED:
+      return "BITPACKED";
+    case ENCODING_TYPE_DICTIONARY:
+      return "DICTIONARY";
+    default:
+      return "INVALID";
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
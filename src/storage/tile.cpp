@@ -20,6 +20,9 @@
 #include "common/serializer.h"
 #include "common/types.h"
 #include "common/macros.h"
+#include "common/logger.h"
+#include "common/value_peeker.h"
+#include "common/varlen.h"
 #include "storage/tuple_iterator.h"
 #include "storage/tuple.h"
 #include "storage/storage_manager.h"
@@ -66,13 +69,53 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
   // allocate pool for blob storage if schema not inlined
   if (schema.IsInlined() == false) {
     pool = new VarlenPool(backend_type);
+
+    dictionaries.resize(column_count);
+    dictionary_codes.resize(column_count);
+  }
+}
+
+Tile::Tile(Tile *tile, TileGroupHeader *tile_header, TileGroup *tile_group,
+           const oid_t tuple_count,
+           const std::vector<std::shared_ptr<Dictionary>> &column_dictionaries)
+    : database_id(INVALID_OID),
+      table_id(INVALID_OID),
+      tile_group_id(INVALID_OID),
+      tile_id(INVALID_OID),
+      backend_type(tile->backend_type),
+      schema(tile->schema),
+      data(NULL),
+      tile_group(tile_group),
+      pool(NULL),
+      num_tuple_slots(tile->num_tuple_slots),
+      column_count(tile->column_count),
+      tuple_length(tile->tuple_length),
+      tile_size(0),
+      uninlined_data_size(0),
+      column_header(NULL),
+      column_header_size(INVALID_OID),
+      tile_group_header(tile_header) {
+  PL_ASSERT(tile->IsFrozen() == false);
+  PL_ASSERT(column_dictionaries.size() == column_count);
+
+  // strings that can't be dictionary encoded are copied here
+  if (schema.IsInlined() == false) {
+    pool = new VarlenPool(backend_type);
+  }
+
+  // No tuple slots, only the encoded columns
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    encoded_columns.emplace_back(new EncodedColumn(
+        tile, column_itr, tuple_count, column_dictionaries[column_itr], pool));
   }
 }
 
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
-  auto &storage_manager = storage::StorageManager::GetInstance();
-  storage_manager.Release(backend_type, data);
+  if (data != NULL) {
+    auto &storage_manager = storage::StorageManager::GetInstance();
+    storage_manager.Release(backend_type, data);
+  }
   data = NULL;
 
   // reclaim the tile memory (UNINLINED data)
@@ -96,6 +139,7 @@ Tile::~Tile() {
  */
 void Tile::InsertTuple(const oid_t tuple_offset, Tuple *tuple) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(IsFrozen() == false);
 
   // Find slot location
   char *location = tuple_offset * tuple_length + data;
@@ -112,6 +156,8 @@ Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_id < schema.GetColumnCount());
 
+  if (IsFrozen()) return encoded_columns[column_id]->GetValue(tuple_offset);
+
   const ValueType column_type = schema.GetType(column_id);
 
   const char *tuple_location = GetTupleLocation(tuple_offset);
@@ -131,6 +177,14 @@ Value Tile::GetValueFast(const oid_t tuple_offset, const size_t column_offset,
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_offset < schema.GetLength());
 
+  if (IsFrozen()) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (schema.GetOffset(column_itr) == column_offset) {
+        return encoded_columns[column_itr]->GetValue(tuple_offset);
+      }
+    }
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + column_offset;
 
@@ -144,6 +198,7 @@ Value Tile::GetValueFast(const oid_t tuple_offset, const size_t column_offset,
 void Tile::SetValue(const Value &value, const oid_t tuple_offset,
                     const oid_t column_id) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
+  PL_ASSERT(IsFrozen() == false);
   PL_ASSERT(column_id < schema.GetColumnCount());
 
   char *tuple_location = GetTupleLocation(tuple_offset);
@@ -165,6 +220,7 @@ void Tile::SetValueFast(const Value &value, const oid_t tuple_offset,
                         const size_t column_offset, const bool is_inlined,
                         const size_t column_length) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
+  PL_ASSERT(IsFrozen() == false);
   PL_ASSERT(column_offset < schema.GetLength());
 
   char *tuple_location = GetTupleLocation(tuple_offset);
@@ -176,6 +232,8 @@ void Tile::SetValueFast(const Value &value, const oid_t tuple_offset,
 }
 
 Tile *Tile::CopyTile(BackendType backend_type) {
+  PL_ASSERT(IsFrozen() == false);
+
   auto schema = GetSchema();
   bool tile_columns_inlined = schema->IsInlined();
   auto allocated_tuple_count = GetAllocatedTupleCount();
@@ -210,6 +268,105 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   return new_tile;
 }
 
+//===--------------------------------------------------------------------===//
+// Dictionary Encoding
+//===--------------------------------------------------------------------===//
+
+bool Tile::EncodeDictionary(const oid_t column_id,
+                            const std::shared_ptr<Dictionary> &dictionary) {
+  PL_ASSERT(column_id < column_count);
+  PL_ASSERT(dictionary != nullptr);
+
+  // Frozen tiles were encoded when they were frozen
+  if (IsFrozen()) return GetDictionary(column_id) == dictionary.get();
+
+  if (schema.GetType(column_id) != VALUE_TYPE_VARCHAR ||
+      schema.IsInlined(column_id)) {
+    return false;
+  }
+
+  // Already encoded against this dictionary
+  if (GetDictionary(column_id) == dictionary.get()) return true;
+
+  // Writes after encoding would not be reflected in the codes
+  if (tile_group_header != nullptr &&
+      (tile_group_header->GetCurrentNextTupleSlot() < num_tuple_slots ||
+       tile_group_header->IsFullyCommitted() == false)) {
+    LOG_TRACE("Tile %u is still written, column %u stays unencoded", tile_id,
+              column_id);
+    return false;
+  }
+
+  const size_t column_offset = schema.GetOffset(column_id);
+  std::unique_ptr<Dictionary::Code[]> codes(
+      new Dictionary::Code[num_tuple_slots]);
+
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+    char *field_location = GetTupleLocation(tuple_itr) + column_offset;
+    Value value =
+        Value::InitFromTupleStorage(field_location, VALUE_TYPE_VARCHAR, false);
+
+    if (value.IsNull()) {
+      codes[tuple_itr] = Dictionary::NULL_CODE;
+      continue;
+    }
+
+    Dictionary::Code code;
+    if (dictionary->Encode(reinterpret_cast<const char *>(
+                               ValuePeeker::PeekObjectValueWithoutNull(value)),
+                           ValuePeeker::PeekObjectLengthWithoutNull(value),
+                           &code) == false) {
+      LOG_TRACE("Dictionary full, column %u of tile %u stays unencoded",
+                column_id, tile_id);
+      return false;
+    }
+    codes[tuple_itr] = code;
+
+    // Share the dictionary's copy of the string; the old copy stays valid
+    // in this tile's pool for readers that already hold it, until the pool
+    // is compacted
+    Varlen *varlen = dictionary->GetVarlen(code);
+    PL_MEMCPY(field_location, &varlen, sizeof(varlen));
+  }
+
+  dictionaries[column_id] = dictionary;
+  dictionary_codes[column_id] = std::move(codes);
+
+  return true;
+}
+
+std::unique_ptr<VarlenPool> Tile::CompactPool() {
+  PL_ASSERT(IsFrozen() == false);
+  if (schema.IsInlined()) return nullptr;
+
+  std::unique_ptr<VarlenPool> old_pool(pool);
+  pool = new VarlenPool(backend_type);
+
+  // The encoded columns point at their dictionaries, the others are copied
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    if (schema.IsInlined(column_itr) || GetDictionary(column_itr) != nullptr) {
+      continue;
+    }
+    for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+      SetValue(GetValue(tuple_itr, column_itr), tuple_itr, column_itr);
+    }
+  }
+
+  return old_pool;
+}
+
+//===--------------------------------------------------------------------===//
+// Frozen Tiles
+//===--------------------------------------------------------------------===//
+
+int64_t Tile::GetEncodedSize() const {
+  int64_t encoded_size = 0;
+  for (auto &encoded_column : encoded_columns) {
+    encoded_size += encoded_column->GetMemorySize();
+  }
+  return encoded_size;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -228,6 +385,27 @@ const std::string Tile::GetInfo() const {
   os << "\t-----------------------------------------------------------\n";
   os << "\tDATA\n";
 
+  if (IsFrozen()) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      os << "\t" << GetColumnName(column_itr) << " : "
+         << EncodedColumn::EncodingTypeToString(
+                encoded_columns[column_itr]->GetEncodingType())
+         << "\n";
+    }
+
+    oid_t tuple_count = encoded_columns[0]->GetTupleCount();
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      os << "\t";
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        os << "(" << encoded_columns[column_itr]->GetValue(tuple_itr) << ")";
+      }
+      os << "\n";
+    }
+
+    os << "\t-----------------------------------------------------------\n";
+    return os.str();
+  }
+
   TupleIterator tile_itr(this);
   Tuple tuple(&schema);
 
@@ -28,6 +28,18 @@
 namespace peloton {
 namespace storage {
 
+// Types of the tile group's columns, in column order
+static std::vector<ValueType> GetColumnTypes(
+    const std::vector<catalog::Schema> &tile_schemas,
+    const column_map_type &column_map) {
+  std::vector<ValueType> column_types(column_map.size());
+  for (auto &entry : column_map) {
+    column_types[entry.first] =
+        tile_schemas[entry.second.first].GetType(entry.second.second);
+  }
+  return column_types;
+}
+
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
@@ -54,6 +66,47 @@ TileGroup::TileGroup(BackendType backend_type,
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  zone_map.reset(new ZoneMap(GetColumnTypes(tile_schemas, column_map)));
+}
+
+TileGroup::TileGroup(TileGroup *tile_group, TileGroupHeader *tile_group_header,
+                     const std::vector<std::shared_ptr<Dictionary>> &dictionaries)
+    : database_id(tile_group->database_id),
+      table_id(tile_group->table_id),
+      tile_group_id(tile_group->tile_group_id),
+      backend_type(tile_group->backend_type),
+      tile_schemas(tile_group->tile_schemas),
+      tile_group_header(tile_group_header),
+      table(tile_group->table),
+      num_tuple_slots(tile_group->num_tuple_slots),
+      tile_count(tile_group->tile_count),
+      column_map(tile_group->column_map) {
+  oid_t tuple_count = tile_group->GetNextTupleSlot();
+
+  // Hand every tile the dictionaries of its columns
+  std::vector<std::vector<std::shared_ptr<Dictionary>>> tile_dictionaries(
+      tile_count);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    tile_dictionaries[tile_itr].resize(
+        tile_schemas[tile_itr].GetColumnCount());
+  }
+  for (auto &entry : column_map) {
+    if (entry.first >= dictionaries.size()) continue;
+    tile_dictionaries[entry.second.first][entry.second.second] =
+        dictionaries[entry.first];
+  }
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    std::shared_ptr<Tile> tile(storage::TileFactory::GetFrozenTile(
+        tile_group->GetTile(tile_itr), tile_group_header, this, tuple_count,
+        tile_dictionaries[tile_itr]));
+
+    tiles.push_back(tile);
+  }
+
+  // Statistics over every version, visible or not
+  RebuildZoneMap();
 }
 
 TileGroup::~TileGroup() {
@@ -96,10 +149,16 @@ oid_t TileGroup::GetActiveTupleCount() const {
 /**
  * Copy from tuple.
  */
-void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
+bool TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
   LOG_TRACE("Tile Group Id :: %u status :: %u out of %u slots ", tile_group_id,
             tuple_slot_id, num_tuple_slots);
 
+  // Frozen tiles have no tuple storage to write to
+  if (IsFrozen()) {
+    LOG_ERROR("Cannot copy a tuple into frozen tile group %u", tile_group_id);
+    return false;
+  }
+
   oid_t tile_column_count;
   oid_t column_itr = 0;
 
@@ -117,11 +176,14 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
 
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
-      tile_tuple.SetValue(tile_column_itr, tuple->GetValue(column_itr),
-                          tile->GetPool());
+      Value value = tuple->GetValue(column_itr);
+      tile_tuple.SetValue(tile_column_itr, value, tile->GetPool());
+      zone_map->Update(column_itr, value);
       column_itr++;
     }
   }
+
+  return true;
 }
 
 // This is commented out before merge
@@ -161,7 +223,7 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
   }
 
   // copy tuple.
-  CopyTuple(tuple, tuple_slot_id);
+  if (CopyTuple(tuple, tuple_slot_id) == false) return INVALID_OID;
 
   // Set MVCC info
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot_id) == INVALID_TXN_ID);
@@ -178,6 +240,12 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
  */
 oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
                                          const Tuple *tuple) {
+  if (IsFrozen()) {
+    LOG_ERROR("Cannot recover a tuple into frozen tile group %u",
+              tile_group_id);
+    return INVALID_OID;
+  }
+
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   // No more slots
@@ -211,8 +279,9 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
 
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
-      tile_tuple.SetValue(tile_column_itr, tuple->GetValue(column_itr),
-                          tile->GetPool());
+      Value value = tuple->GetValue(column_itr);
+      tile_tuple.SetValue(tile_column_itr, value, tile->GetPool());
+      zone_map->Update(column_itr, value);
       column_itr++;
     }
   }
@@ -286,6 +355,12 @@ oid_t TileGroup::UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
 oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
                                            const Tuple *tuple,
                                            cid_t commit_id) {
+  if (IsFrozen()) {
+    LOG_ERROR("Cannot recover a tuple into frozen tile group %u",
+              tile_group_id);
+    return INVALID_OID;
+  }
+
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   // No more slots
@@ -311,8 +386,9 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
 
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
-      tile_tuple.SetValue(tile_column_itr, tuple->GetValue(column_itr),
-                          tile->GetPool());
+      Value value = tuple->GetValue(column_itr);
+      tile_tuple.SetValue(tile_column_itr, value, tile->GetPool());
+      zone_map->Update(column_itr, value);
       column_itr++;
     }
   }
@@ -362,8 +438,47 @@ void TileGroup::SetValue(Value &value, oid_t tuple_id, oid_t column_id) {
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+  zone_map->Update(column_id, value);
 }
 
+void TileGroup::RebuildZoneMap() {
+  zone_map.reset(new ZoneMap(GetColumnTypes(tile_schemas, column_map)));
+
+  oid_t tuple_count = GetNextTupleSlot();
+  for (auto &entry : column_map) {
+    Tile *tile = GetTile(entry.second.first);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      zone_map->Update(entry.first,
+                       tile->GetValue(tuple_itr, entry.second.second));
+    }
+  }
+}
+
+bool TileGroup::EncodeDictionary(
+    oid_t column_id, const std::shared_ptr<Dictionary> &dictionary) {
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  return GetTile(tile_offset)->EncodeDictionary(tile_column_id, dictionary);
+}
+
+bool TileGroup::GetDictionaryCode(oid_t tuple_id, oid_t column_id,
+                                  const Dictionary **dictionary,
+                                  Dictionary::Code *code) {
+  PL_ASSERT(tuple_id < GetNextTupleSlot());
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  Tile *tile = GetTile(tile_offset);
+
+  auto codes = tile->GetDictionaryCodes(tile_column_id);
+  if (codes == nullptr) return false;
+
+  *dictionary = tile->GetDictionary(tile_column_id);
+  *code = codes[tuple_id];
+  return true;
+}
+
+
+bool TileGroup::IsFrozen() const { return tiles[0]->IsFrozen(); }
 
 Tile *TileGroup::GetTile(const oid_t tile_offset) const {
   PL_ASSERT(tile_offset < tile_count);
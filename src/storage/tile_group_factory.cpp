@@ -44,5 +44,22 @@ TileGroup *TileGroupFactory::GetTileGroup(
   return tile_group;
 }
 
+TileGroup *TileGroupFactory::GetFrozenTileGroup(
+    TileGroup *tile_group,
+    const std::vector<std::shared_ptr<Dictionary>> &dictionaries) {
+  PL_ASSERT(tile_group->IsFrozen() == false);
+
+  TileGroupHeader *tile_header = new TileGroupHeader(
+      tile_group->backend_type, tile_group->GetAllocatedTupleCount());
+  *tile_header = *tile_group->GetHeader();
+
+  TileGroup *frozen_tile_group =
+      new TileGroup(tile_group, tile_header, dictionaries);
+
+  tile_header->SetTileGroup(frozen_tile_group);
+
+  return frozen_tile_group;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
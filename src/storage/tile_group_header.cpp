@@ -197,5 +197,15 @@ oid_t TileGroupHeader::GetActiveTupleCount() {
   return active_tuple_slots;
 }
 
+bool TileGroupHeader::IsFullyCommitted() const {
+  oid_t tuple_count = GetCurrentNextTupleSlot();
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+       tuple_slot_id++) {
+    auto txn_id = GetTransactionId(tuple_slot_id);
+    if (txn_id != INITIAL_TXN_ID && txn_id != INVALID_TXN_ID) return false;
+  }
+  return true;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
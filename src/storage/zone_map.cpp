@@ -0,0 +1,284 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+#include <utility>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace storage {
+
+ZoneMap::ZoneMap(const std::vector<ValueType> &column_types)
+    : columns_(column_types.size()) {
+  for (oid_t column_itr = 0; column_itr < column_types.size(); column_itr++) {
+    columns_[column_itr].type = column_types[column_itr];
+  }
+}
+
+bool ZoneMap::IsOrdered(const ValueType type) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_REAL:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DECIMAL:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Own a copy of the value, strings may point into tile storage
+static Value CopyValue(const Value &value) {
+  if (value.GetValueType() != VALUE_TYPE_VARCHAR) return value;
+
+  return ValueFactory::GetStringValue(std::string(
+      reinterpret_cast<const char *>(
+          ValuePeeker::PeekObjectValueWithoutNull(value)),
+      ValuePeeker::PeekObjectLengthWithoutNull(value)));
+}
+
+void ZoneMap::Update(const oid_t column_id, const Value &value) {
+  PL_ASSERT(column_id < columns_.size());
+  auto &zone = columns_[column_id];
+
+  zone_map_lock_.Lock();
+
+  if (value.IsNull()) {
+    zone.null_count++;
+  } else if (IsOrdered(zone.type)) {
+    if (zone.min == nullptr) {
+      zone.min.reset(new Value(CopyValue(value)));
+      zone.max.reset(new Value(CopyValue(value)));
+    } else if (value.Compare(*zone.min) == VALUE_COMPARE_LESSTHAN) {
+      zone.min.reset(new Value(CopyValue(value)));
+    } else if (value.Compare(*zone.max) == VALUE_COMPARE_GREATERTHAN) {
+      zone.max.reset(new Value(CopyValue(value)));
+    }
+  }
+
+  zone_map_lock_.Unlock();
+}
+
+bool ZoneMap::GetRange(const oid_t column_id, Value *min, Value *max) const {
+  PL_ASSERT(column_id < columns_.size());
+  auto &zone = columns_[column_id];
+
+  zone_map_lock_.Lock();
+  bool has_range = (zone.min != nullptr);
+  if (has_range) {
+    *min = *zone.min;
+    *max = *zone.max;
+  }
+  zone_map_lock_.Unlock();
+
+  return has_range;
+}
+
+oid_t ZoneMap::GetNullCount(const oid_t column_id) const {
+  PL_ASSERT(column_id < columns_.size());
+
+  zone_map_lock_.Lock();
+  oid_t null_count = columns_[column_id].null_count;
+  zone_map_lock_.Unlock();
+
+  return null_count;
+}
+
+bool ZoneMap::MaySatisfy(const oid_t column_id,
+                         const ExpressionType comparison,
+                         const Value &value) const {
+  PL_ASSERT(column_id < columns_.size());
+  auto &zone = columns_[column_id];
+
+  if (IsOrdered(zone.type) == false || value.IsNull()) return true;
+
+  bool result = true;
+  zone_map_lock_.Lock();
+
+  try {
+    if (zone.min == nullptr) {
+      result = false;
+    } else {
+      switch (comparison) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+          result = zone.min->Compare(value) <= 0 &&
+                   zone.max->Compare(value) >= 0;
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          result = zone.min->Compare(value) < 0;
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          result = zone.min->Compare(value) <= 0;
+          break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          result = zone.max->Compare(value) > 0;
+          break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          result = zone.max->Compare(value) >= 0;
+          break;
+        default:
+          break;
+      }
+    }
+  } catch (Exception &e) {
+    // Types the column can't be compared with
+    result = true;
+  }
+
+  zone_map_lock_.Unlock();
+
+  return result;
+}
+
+const std::string ZoneMap::GetInfo() const {
+  std::ostringstream os;
+
+  os << "\tZONE MAP\n";
+  for (oid_t column_itr = 0; column_itr < columns_.size(); column_itr++) {
+    Value min, max;
+    os << "\tColumn " << column_itr << " : ";
+    if (GetRange(column_itr, &min, &max)) {
+      os << "[" << min.GetInfo() << ", " << max.GetInfo() << "]";
+    } else {
+      os << "no range";
+    }
+    os << " nulls " << GetNullCount(column_itr) << "\n";
+  }
+
+  return os.str();
+}
+
+//===--------------------------------------------------------------------===//
+// Zone Map Predicate
+//===--------------------------------------------------------------------===//
+
+ZoneMapPredicate::ZoneMapPredicate(
+    const expression::AbstractExpression *predicate,
+    const std::vector<Value> &params) {
+  AddConjuncts(predicate, params);
+}
+
+// Mirror of a comparison with its operands swapped
+static ExpressionType FlipComparison(const ExpressionType comparison) {
+  switch (comparison) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return comparison;
+  }
+}
+
+// Get the value of a constant or parameter expression
+static bool GetConstant(const expression::AbstractExpression *expr,
+                        const std::vector<Value> &params, Value *value) {
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto constant =
+          dynamic_cast<const expression::ConstantValueExpression *>(expr);
+      if (constant == nullptr) return false;
+      *value = constant->getValue();
+      return true;
+    }
+    case EXPRESSION_TYPE_VALUE_PARAMETER: {
+      auto parameter =
+          dynamic_cast<const expression::ParameterValueExpression *>(expr);
+      if (parameter == nullptr || parameter->GetValueIdx() >= params.size())
+        return false;
+      *value = params[parameter->GetValueIdx()];
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void ZoneMapPredicate::AddConjuncts(
+    const expression::AbstractExpression *expr,
+    const std::vector<Value> &params) {
+  if (expr == nullptr) return;
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+      AddConjuncts(expr->GetLeft(), params);
+      AddConjuncts(expr->GetRight(), params);
+      return;
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      break;
+
+    default:
+      return;
+  }
+
+  auto left = expr->GetLeft();
+  auto right = expr->GetRight();
+  if (left == nullptr || right == nullptr) return;
+
+  // Put the column on the left
+  auto comparison = expr->GetExpressionType();
+  if (right->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE) {
+    std::swap(left, right);
+    comparison = FlipComparison(comparison);
+  }
+
+  auto column =
+      dynamic_cast<const expression::TupleValueExpression *>(left);
+  if (column == nullptr || column->GetTupleIdx() != 0) return;
+
+  Conjunct conjunct;
+  if (GetConstant(right, params, &conjunct.value) == false) return;
+  conjunct.column_id = column->GetColumnId();
+  conjunct.comparison = comparison;
+  conjuncts_.push_back(conjunct);
+}
+
+bool ZoneMapPredicate::CanSkip(const ZoneMap *zone_map) const {
+  if (zone_map == nullptr) return false;
+
+  for (auto &conjunct : conjuncts_) {
+    if (conjunct.column_id >= zone_map->GetColumnCount()) continue;
+    if (zone_map->MaySatisfy(conjunct.column_id, conjunct.comparison,
+                             conjunct.value) == false) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -22,7 +22,10 @@
 
 #include "parser/parser.h"
 
+#include "optimizer/plan_cache.h"
 #include "optimizer/simple_optimizer.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "executor/plan_executor.h"
 #include "catalog/bootstrapper.h"
 
@@ -50,7 +53,7 @@ TrafficCop::~TrafficCop() {
 Result TrafficCop::ExecuteStatement(
     const std::string &query, std::vector<ResultType> &result,
     std::vector<FieldInfoType> &tuple_descriptor, int &rows_changed,
-    std::string &error_message) {
+    std::string &error_message, concurrency::Transaction *txn) {
   LOG_TRACE("Received %s", query.c_str());
 
   // Prepare the statement
@@ -63,8 +66,8 @@ Result TrafficCop::ExecuteStatement(
 
   // Then, execute the statement
   bool unnamed = true;
-  auto status =
-      ExecuteStatement(statement, unnamed, result, rows_changed, error_message);
+  auto status = ExecuteStatement(statement, unnamed, result, rows_changed,
+                                 error_message, txn);
 
   if (status == Result::RESULT_SUCCESS) {
     LOG_TRACE("Execution succeeded!");
@@ -79,19 +82,68 @@ Result TrafficCop::ExecuteStatement(
 Result TrafficCop::ExecuteStatement(
     const std::shared_ptr<Statement> &statement,
     UNUSED_ATTRIBUTE const bool unnamed, std::vector<ResultType> &result,
-    int &rows_changed, UNUSED_ATTRIBUTE std::string &error_message) {
+    int &rows_changed, UNUSED_ATTRIBUTE std::string &error_message,
+    concurrency::Transaction *txn) {
 
   LOG_TRACE("Execute Statement %s", statement->GetStatementName().c_str());
-  std::vector<Value> params;
+  auto &params = statement->GetParamValues();
   bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
   bridge::peloton_status status = bridge::PlanExecutor::ExecutePlan(
-      statement->GetPlanTree().get(), params, result);
+      statement->GetPlanTree().get(), params, result, txn);
   LOG_TRACE("Statement executed. Result: %d", status.m_result);
 
   rows_changed = status.m_processed;
   return status.m_result;
 }
 
+concurrency::Transaction *TrafficCop::BeginTransaction() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  LOG_TRACE("Begin Transaction %lu", txn->GetTransactionId());
+  return txn;
+}
+
+Result TrafficCop::CommitTransaction(concurrency::Transaction *txn) {
+  PL_ASSERT(txn);
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    AbortTransaction(txn);
+    return Result::RESULT_ABORTED;
+  }
+
+  LOG_TRACE("Commit Transaction %lu", txn->GetTransactionId());
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  return txn_manager.CommitTransaction(txn);
+}
+
+Result TrafficCop::AbortTransaction(concurrency::Transaction *txn) {
+  PL_ASSERT(txn);
+  LOG_TRACE("Abort Transaction %lu", txn->GetTransactionId());
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  return txn_manager.AbortTransaction(txn);
+}
+
+std::unique_ptr<bridge::PlanCursor> TrafficCop::OpenCursor(
+    const std::shared_ptr<Statement> &statement,
+    const std::vector<Value> &params, concurrency::Transaction *txn) {
+  LOG_TRACE("Open cursor for statement %s",
+            statement->GetStatementName().c_str());
+
+  auto cursor = statement->TakeCursor();
+  if (cursor != nullptr && cursor->Reopen(params, txn)) return cursor;
+
+  bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
+  return std::unique_ptr<bridge::PlanCursor>(
+      new bridge::PlanCursor(statement->GetPlanTree().get(), params, txn));
+}
+
+bridge::peloton_status TrafficCop::CloseCursor(
+    const std::shared_ptr<Statement> &statement,
+    std::unique_ptr<bridge::PlanCursor> cursor) {
+  auto status = cursor->Close();
+  statement->KeepCursor(std::move(cursor));
+  return status;
+}
+
 std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     const std::string &statement_name, const std::string &query_string,
     UNUSED_ATTRIBUTE std::string &error_message) {
@@ -101,18 +153,43 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
 
   statement.reset(new Statement(statement_name, query_string));
 
-  auto &peloton_parser = parser::Parser::GetInstance();
-  auto sql_stmt = peloton_parser.BuildParseTree(query_string);
-
-  statement->SetPlanTree(
-      optimizer::SimpleOptimizer::BuildPelotonPlanTree(sql_stmt));
-
-  for(auto stmt : sql_stmt->GetStatements()){
-    if(stmt->GetType() == STATEMENT_TYPE_SELECT){
-      auto tuple_descriptor = GenerateTupleDescriptor(query_string);
-      statement->SetTupleDescriptor(tuple_descriptor);
+  // Queries of the same shape share the plan of their fingerprint, bound to
+  // their literals
+  auto &plan_cache = optimizer::PlanCache::GetInstance();
+  std::string fingerprint;
+  std::vector<Value> literals;
+  if (optimizer::PlanCache::Fingerprint(query_string, fingerprint, literals)) {
+    auto cached_plan = plan_cache.Find(fingerprint);
+    if (cached_plan == nullptr) {
+      std::vector<FieldInfoType> tuple_descriptor;
+      auto plan_tree = BuildPlanTree(fingerprint, tuple_descriptor);
+      if (plan_tree != nullptr) {
+        cached_plan.reset(
+            new optimizer::CachedPlan(fingerprint, tuple_descriptor));
+        plan_tree = cached_plan->Lend(plan_tree);
+      } else {
+        // e.g. a parameter where the grammar only takes a literal
+        cached_plan.reset(new optimizer::CachedPlan(fingerprint));
+      }
+      plan_cache.Insert(cached_plan);
+      BindCachedPlan(*statement, *cached_plan, plan_tree, literals);
+    } else if (cached_plan->IsParameterized()) {
+      // Another instance if all of them are busy
+      auto plan_tree = cached_plan->Acquire();
+      if (plan_tree == nullptr) {
+        std::vector<FieldInfoType> tuple_descriptor;
+        plan_tree =
+            cached_plan->Lend(BuildPlanTree(fingerprint, tuple_descriptor));
+      }
+      BindCachedPlan(*statement, *cached_plan, plan_tree, literals);
     }
-    break;
+  }
+
+  // Planned for this query alone
+  if (statement->GetPlanTree() == nullptr) {
+    std::vector<FieldInfoType> tuple_descriptor;
+    statement->SetPlanTree(BuildPlanTree(query_string, tuple_descriptor));
+    statement->SetTupleDescriptor(tuple_descriptor);
   }
 
   bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
@@ -120,15 +197,60 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   return std::move(statement);
 }
 
-std::vector<FieldInfoType> TrafficCop::GenerateTupleDescriptor(std::string query) {
+std::shared_ptr<planner::AbstractPlan> TrafficCop::BuildPlanTree(
+    const std::string &query_string,
+    std::vector<FieldInfoType> &tuple_descriptor) {
+  Timer<std::micro> timer;
+  timer.Start();
 
-  std::vector<FieldInfoType> tuple_descriptor;
+  auto &peloton_parser = parser::Parser::GetInstance();
+  auto sql_stmt = peloton_parser.BuildParseTree(query_string);
+  if (sql_stmt->is_valid == false || sql_stmt->GetStatements().empty()) {
+    return nullptr;
+  }
+
+  auto plan_tree = optimizer::SimpleOptimizer::BuildPelotonPlanTree(sql_stmt);
+
+  switch (sql_stmt->GetStatement(0)->GetType()) {
+    case STATEMENT_TYPE_SELECT:
+      tuple_descriptor = GenerateTupleDescriptor(sql_stmt->GetStatement(0));
+      break;
+
+    // Statements changing the catalog or its statistics clear the cached
+    // plans once they have run, see the create, drop and analyze executors
+
+    default:
+      break;
+  }
+
+  timer.Stop();
+  optimizer::PlanCache::GetInstance().RecordPlanning(timer.GetDuration());
+  return plan_tree;
+}
+
+void TrafficCop::BindCachedPlan(
+    Statement &statement, const optimizer::CachedPlan &cached_plan,
+    const std::shared_ptr<planner::AbstractPlan> &plan_tree,
+    const std::vector<Value> &literals) {
+  if (plan_tree == nullptr) return;
+
+  statement.SetPlanTree(plan_tree);
+  statement.SetParamValues(literals);
+  statement.SetTupleDescriptor(cached_plan.GetTupleDescriptor());
+}
 
+std::vector<FieldInfoType> TrafficCop::GenerateTupleDescriptor(std::string query) {
   // Set up parser
   auto &peloton_parser = parser::Parser::GetInstance();
   auto sql_stmt = peloton_parser.BuildParseTree(query);
 
-  auto first_stmt = sql_stmt->GetStatement(0);
+  return GenerateTupleDescriptor(sql_stmt->GetStatement(0));
+}
+
+std::vector<FieldInfoType> TrafficCop::GenerateTupleDescriptor(
+    parser::SQLStatement *first_stmt) {
+
+  std::vector<FieldInfoType> tuple_descriptor;
 
 
   //Get the Select Statement
@@ -214,10 +336,23 @@ std::vector<FieldInfoType> TrafficCop::GenerateTupleDescriptor(std::string query
 }
 
 FieldInfoType TrafficCop::GetColumnFieldForValueType(std::string column_name , ValueType column_type){
+  if(column_type == VALUE_TYPE_BOOLEAN){
+    return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_BOOLEAN , 1);
+  }
+
+  // Postgres has no one byte integer
+  if(column_type == VALUE_TYPE_TINYINT || column_type == VALUE_TYPE_SMALLINT){
+    return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_SMALLINT , 2);
+  }
+
   if(column_type == VALUE_TYPE_INTEGER){
     return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_INTEGER , 4);
   }
 
+  if(column_type == VALUE_TYPE_BIGINT){
+    return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_BIGINT , 8);
+  }
+
   if(column_type == VALUE_TYPE_DOUBLE){
     return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_DOUBLE , 8);
   }
@@ -226,6 +361,10 @@ FieldInfoType TrafficCop::GetColumnFieldForValueType(std::string column_name , V
     return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_TEXT , 255);
   }
 
+  if(column_type == VALUE_TYPE_VARBINARY){
+    return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_BYTEA , 255);
+  }
+
   if(column_type == VALUE_TYPE_DECIMAL){
     return std::make_tuple(column_name , POSTGRES_VALUE_TYPE_DECIMAL , 16);
   }
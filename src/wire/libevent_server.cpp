@@ -9,17 +9,17 @@
 // Copyright (c) 2015-16, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
 #include <fstream>
+#include <pthread.h>
+#include <sys/un.h>
 #include "wire/libevent_server.h"
 #include "common/logger.h"
 #include "common/macros.h"
-#include "common/init.h"
-#include "common/thread_pool.h"
 
 namespace peloton {
 namespace wire {
 
-std::vector<SocketManager<PktBuf> *> Server::socket_manager_vector_ = {};
 unsigned int Server::socket_manager_id = 0;
 
 /**
@@ -52,78 +52,183 @@ bool SetNonBlocking(int fd) {
 /**
  * Process refill the buffer and process all packets that can be processed
  */
-void ManageRead(SocketManager<PktBuf> **socket_manager) {
+void ManageRead(SocketManager<PktBuf> *socket_manager) {
   // Startup packet
-  if ((*socket_manager)->first_packet == false) {
-    if (!(*socket_manager)->socket_pkt_manager->ManageFirstPacket()) {
-      close((*socket_manager)->GetSocketFD());
-      event_del((*socket_manager)->ev_read);
-      (*socket_manager)->execution_mutex.unlock();
+  if (socket_manager->first_packet == false) {
+    if (!socket_manager->socket_pkt_manager->ManageFirstPacket()) {
+      socket_manager->loop->RemoveConnection(socket_manager);
       return;
     }
-    (*socket_manager)->first_packet = true;
+    socket_manager->first_packet = true;
   }
   // Regular packet
   else {
-    if (!(*socket_manager)->socket_pkt_manager->ManagePacket()) {
-      close((*socket_manager)->GetSocketFD());
-      event_del((*socket_manager)->ev_read);
-      (*socket_manager)->execution_mutex.unlock();
+    if (!socket_manager->socket_pkt_manager->ManagePacket()) {
+      socket_manager->loop->RemoveConnection(socket_manager);
       return;
     }
   }
-  // Unlock the socket manager mutex
-  (*socket_manager)->execution_mutex.unlock();
 }
 
 /**
- * The function called when there is new data ready to be read
+ * The function called when there is new data ready to be read, on the
+ * thread of the loop owning the connection
  */
 void ReadCallback(UNUSED_ATTRIBUTE int fd, UNUSED_ATTRIBUTE short ev,
                   void *arg) {
-  // Assign a thread if the socket manager is not executing
-  if (((SocketManager<PktBuf> *)arg)->execution_mutex.try_lock()) {
-    ((SocketManager<PktBuf> *)arg)->self = (SocketManager<PktBuf> *)arg;
-    thread_pool.SubmitTask(ManageRead, &((SocketManager<PktBuf> *)arg)->self);
-  }
+  ManageRead((SocketManager<PktBuf> *)arg);
 }
 
 /**
  * This function will be called by libevent when there is a connection
  * ready to be accepted.
  */
-void AcceptCallback(struct evconnlistener *listener, evutil_socket_t client_fd,
+void AcceptCallback(UNUSED_ATTRIBUTE struct evconnlistener *listener,
+                    evutil_socket_t client_fd,
                     UNUSED_ATTRIBUTE struct sockaddr *address,
-                    UNUSED_ATTRIBUTE int socklen, UNUSED_ATTRIBUTE void *ctx) {
+                    UNUSED_ATTRIBUTE int socklen, void *ctx) {
   LOG_INFO("New connection on fd %d", int(client_fd));
-  // Get the event base
-  struct event_base *base = evconnlistener_get_base(listener);
+  ((Server *)ctx)->DispatchConnection(client_fd);
+}
 
-  SetTCPNoDelay(client_fd);
-  /* We've accepted a new client, allocate a socket manager to
-     maintain the state of this client. */
-  SocketManager<PktBuf> *socket_manager =
-      new SocketManager<PktBuf>(client_fd, ++Server::socket_manager_id);
-  socket_manager->socket_pkt_manager.reset(new PacketManager(socket_manager));
+//===--------------------------------------------------------------------===//
+// Server Loop
+//===--------------------------------------------------------------------===//
+
+#define NOTIFY_CONNECTION 'c'
+#define NOTIFY_STOP 's'
+
+ServerLoop::ServerLoop(const int loop_id, const int core_id)
+    : loop_id_(loop_id), core_id_(core_id), connection_count_(0) {
+  base_ = event_base_new();
+  if (!base_) {
+    LOG_ERROR("Couldn't open event base for loop %d", loop_id_);
+    exit(EXIT_FAILURE);
+  }
+
+  if (pipe(notify_fds_) < 0 || !SetNonBlocking(notify_fds_[0])) {
+    LOG_ERROR("Couldn't create notification pipe for loop %d", loop_id_);
+    exit(EXIT_FAILURE);
+  }
+  notify_event_ = event_new(base_, notify_fds_[0], EV_READ | EV_PERSIST,
+                            NotifyCallback, this);
+  event_add(notify_event_, NULL);
+}
+
+ServerLoop::~ServerLoop() {
+  Stop();
+
+  // Close the connections still open, along with the ones never registered
+  AcceptPendingConnections();
+  for (auto &entry : connections_) {
+    event_free(entry.second->ev_read);
+    entry.second->CloseSocket();
+  }
+  connections_.clear();
+
+  event_free(notify_event_);
+  close(notify_fds_[0]);
+  close(notify_fds_[1]);
+  event_base_free(base_);
+}
+
+void ServerLoop::Start() {
+  thread_ = std::thread([this] { event_base_dispatch(base_); });
+
+  // Keep the loop, and the connections' state, on one core
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(core_id_, &cpu_set);
+  if (pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set),
+                             &cpu_set) != 0) {
+    LOG_WARN("Couldn't pin loop %d to core %d", loop_id_, core_id_);
+  }
+}
+
+void ServerLoop::Stop() {
+  if (thread_.joinable() == false) return;
+
+  Notify(NOTIFY_STOP);
+  thread_.join();
+}
+
+void ServerLoop::AddConnection(SocketManager<PktBuf> *socket_manager) {
+  {
+    std::lock_guard<std::mutex> guard(pending_lock_);
+    pending_connections_.push_back(socket_manager);
+  }
+  Notify(NOTIFY_CONNECTION);
+}
+
+void ServerLoop::RemoveConnection(SocketManager<PktBuf> *socket_manager) {
+  PL_ASSERT(socket_manager->loop == this);
+
+  // Forget the socket before closing it, its descriptor may be reused by
+  // the next accepted connection right away
+  event_free(socket_manager->ev_read);
+  socket_manager->ev_read = NULL;
+  socket_manager->CloseSocket();
+
+  connections_.erase(socket_manager->id);
+  connection_count_--;
+}
+
+void ServerLoop::Notify(const char notification) {
+  while (write(notify_fds_[1], &notification, 1) < 0 && errno == EINTR)
+    ;
+}
+
+void ServerLoop::NotifyCallback(evutil_socket_t fd,
+                                UNUSED_ATTRIBUTE short what, void *arg) {
+  ServerLoop *loop = (ServerLoop *)arg;
+
+  // Drain the pipe, one byte per notification
+  char notifications[64];
+  ssize_t count;
+  while ((count = read(fd, notifications, sizeof(notifications))) > 0) {
+    for (ssize_t notification_itr = 0; notification_itr < count;
+         notification_itr++) {
+      if (notifications[notification_itr] == NOTIFY_STOP) {
+        event_base_loopbreak(loop->base_);
+      }
+    }
+  }
+
+  loop->AcceptPendingConnections();
+}
 
-  Server::AddSocketManager(socket_manager);
+void ServerLoop::AcceptPendingConnections() {
+  std::vector<SocketManager<PktBuf> *> pending;
+  {
+    std::lock_guard<std::mutex> guard(pending_lock_);
+    pending.swap(pending_connections_);
+  }
+
+  for (auto socket_manager : pending) {
+    socket_manager->loop = this;
+
+    /* Setup the read event, libevent will call ReadCallback whenever
+     * the clients socket becomes read ready.  Make the
+     * read event persistent so we don't have to re-add after each
+     * read. */
+    socket_manager->ev_read =
+        event_new(base_, socket_manager->GetSocketFD(), EV_READ | EV_PERSIST,
+                  ReadCallback, socket_manager);
 
-  /* Setup the read event, libevent will call ReadCallback whenever
-   * the clients socket becomes read ready.  Make the
-   * read event persistent so we don't have to re-add after each
-   * read. */
-  socket_manager->ev_read = event_new(base, client_fd, EV_READ | EV_PERSIST,
-                                      ReadCallback, socket_manager);
+    /* Setting up the event does not activate, add the event so it
+       becomes active. */
+    event_add(socket_manager->ev_read, NULL);
 
-  /* Setting up the event does not activate, add the event so it
-     becomes active. */
-  event_add(socket_manager->ev_read, NULL);
+    connections_[socket_manager->id].reset(socket_manager);
+    connection_count_++;
+  }
 }
 
-Server::Server() {
-  struct event_base *base;
-  struct evconnlistener *listener;
-  struct event *evstop;
+//===--------------------------------------------------------------------===//
+// Server
+//===--------------------------------------------------------------------===//
+
+Server::Server() : listener_(NULL), next_loop_(0) {
   socket_manager_id = 0;
   port_ = FLAGS_port;
   max_connections_ = FLAGS_max_connections;
@@ -142,14 +247,23 @@ Server::Server() {
   signal(SIGPIPE, SIG_IGN);
 
   // Create our event base
-  base = event_base_new();
-  if (!base) {
+  base_ = event_base_new();
+  if (!base_) {
     LOG_INFO("Couldn't open event base");
     exit(EXIT_FAILURE);
   }
   // Add hang up signal event
-  evstop = evsignal_new(base, SIGHUP, Signal_Callback, base);
-  evsignal_add(evstop, NULL);
+  evstop_ = evsignal_new(base_, SIGHUP, Signal_Callback, base_);
+  evsignal_add(evstop_, NULL);
+
+  // Add close event
+  if (pipe(close_fds_) < 0) {
+    LOG_INFO("Couldn't create close pipe");
+    exit(EXIT_FAILURE);
+  }
+  close_event_ = event_new(base_, close_fds_[0], EV_READ | EV_PERSIST,
+                           CloseCallback, base_);
+  event_add(close_event_, NULL);
 
   if (FLAGS_socket_family == "AF_INET") {
     struct sockaddr_in sin;
@@ -157,19 +271,9 @@ Server::Server() {
     sin.sin_family = AF_INET;
     sin.sin_addr.s_addr = INADDR_ANY;
     sin.sin_port = htons(port_);
-    listener = evconnlistener_new_bind(
-        base, AcceptCallback, NULL, LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE,
+    listener_ = evconnlistener_new_bind(
+        base_, AcceptCallback, this, LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE,
         -1, (struct sockaddr *)&sin, sizeof(sin));
-    if (!listener) {
-      LOG_INFO("Couldn't create listener");
-      exit(EXIT_FAILURE);
-    }
-
-    event_base_dispatch(base);
-
-    evconnlistener_free(listener);
-    event_free(evstop);
-    event_base_free(base);
   }
   // This socket family code is not implemented yet
   else if (FLAGS_socket_family == "AF_UNIX") {
@@ -184,24 +288,76 @@ Server::Server() {
     unlink(serv_addr.sun_path);
     len = strlen(serv_addr.sun_path) + sizeof(serv_addr.sun_family);
 
-    listener = evconnlistener_new_bind(
-        base, AcceptCallback, NULL, LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE,
+    listener_ = evconnlistener_new_bind(
+        base_, AcceptCallback, this, LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE,
         -1, (struct sockaddr *)&serv_addr, len);
-    if (!listener) {
-      LOG_INFO("Couldn't create listener");
-      exit(EXIT_FAILURE);
-    }
-
-    event_base_dispatch(base);
-
-    evconnlistener_free(listener);
-    event_free(evstop);
-    event_base_free(base);
-
   } else {
     LOG_ERROR("Socket family %s not supported", FLAGS_socket_family.c_str());
     exit(EXIT_FAILURE);
   }
+
+  if (!listener_) {
+    LOG_INFO("Couldn't create listener");
+    exit(EXIT_FAILURE);
+  }
+
+  // One event loop per core unless configured otherwise
+  int core_count = std::max(1u, std::thread::hardware_concurrency());
+  int loop_count = FLAGS_event_loops;
+  if (loop_count == 0) loop_count = core_count;
+  for (int loop_itr = 0; loop_itr < loop_count; loop_itr++) {
+    loops_.emplace_back(new ServerLoop(loop_itr, loop_itr % core_count));
+  }
+}
+
+Server::~Server() {
+  // Stops the loops, closing their connections
+  loops_.clear();
+
+  evconnlistener_free(listener_);
+  event_free(close_event_);
+  close(close_fds_[0]);
+  close(close_fds_[1]);
+  event_free(evstop_);
+  event_base_free(base_);
+}
+
+void Server::StartServer() {
+  LOG_INFO("Listening on port %d with %lu event loops", port_, loops_.size());
+  for (auto &loop : loops_) {
+    loop->Start();
+  }
+
+  event_base_dispatch(base_);
+
+  for (auto &loop : loops_) {
+    loop->Stop();
+  }
+}
+
+void Server::CloseServer() {
+  char notification = NOTIFY_STOP;
+  while (write(close_fds_[1], &notification, 1) < 0 && errno == EINTR)
+    ;
+}
+
+void Server::CloseCallback(UNUSED_ATTRIBUTE evutil_socket_t fd,
+                           UNUSED_ATTRIBUTE short what, void *arg) {
+  event_base_loopexit((event_base *)arg, NULL);
+}
+
+void Server::DispatchConnection(evutil_socket_t client_fd) {
+  SetTCPNoDelay(client_fd);
+
+  /* We've accepted a new client, allocate a socket manager to
+     maintain the state of this client. */
+  SocketManager<PktBuf> *socket_manager =
+      new SocketManager<PktBuf>(client_fd, ++socket_manager_id);
+  socket_manager->socket_pkt_manager.reset(new PacketManager(socket_manager));
+
+  // Its loop parses and executes all of its requests
+  loops_[next_loop_]->AddConnection(socket_manager);
+  next_loop_ = (next_loop_ + 1) % loops_.size();
 }
 
 void Server::LogCallback(int severity, UNUSED_ATTRIBUTE const char *msg) {
@@ -15,6 +15,9 @@
 #include <iterator>
 
 #include "wire/marshal.h"
+#include "common/exception.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
 
 #include <netinet/in.h>
 
@@ -155,6 +158,309 @@ void PacketPutCbytes(std::unique_ptr<Packet> &pkt, const uchar *b, int len) {
   pkt->buf.insert(std::end(pkt->buf), b, b + len);
   pkt->len += len;
 }
+/*
+ * Value marshallers
+ */
+
+// Microseconds from the Unix epoch, which timestamps count from, to the
+// 2000-01-01 epoch of Postgres binary timestamps
+#define POSTGRES_EPOCH_OFFSET 946684800000000LL
+
+// Sign words of the Postgres binary numeric
+#define NUMERIC_POS 0x0000
+#define NUMERIC_NEG 0x4000
+
+// write the low "base" bytes of n in network byte order
+static void PacketPutBigEndian(std::unique_ptr<Packet> &pkt, uint64_t n,
+                               int base) {
+  size_t offset = pkt->buf.size();
+  pkt->buf.resize(offset + base);
+  for (int i = base - 1; i >= 0; i--) {
+    pkt->buf[offset + i] = static_cast<uchar>(n & 0xFF);
+    n >>= 8;
+  }
+  pkt->len += base;
+}
+
+// parse a "base" byte network byte order integer, false on a length mismatch
+static bool GetBigEndian(const PktBuf &data, size_t base, uint64_t &n) {
+  if (data.size() != base) return false;
+  n = 0;
+  for (auto byte : data) n = (n << 8) | byte;
+  return true;
+}
+
+static void PacketPutValueBytes(std::unique_ptr<Packet> &pkt,
+                                const char *data, int32_t len) {
+  PacketPutInt(pkt, len, 4);
+  PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data), len);
+}
+
+static void PacketPutTextValue(std::unique_ptr<Packet> &pkt,
+                               const Value &value) {
+  switch (value.GetValueType()) {
+    case VALUE_TYPE_VARCHAR:
+    case VALUE_TYPE_VARBINARY:
+      // copy straight out of the string's storage
+      PacketPutValueBytes(pkt, reinterpret_cast<const char *>(
+                                   ValuePeeker::PeekObjectValueWithoutNull(
+                                       value)),
+                          ValuePeeker::PeekObjectLengthWithoutNull(value));
+      break;
+    default: {
+      // ToString is not const
+      auto str = Value(value).ToString();
+      PacketPutValueBytes(pkt, str.data(), str.size());
+    } break;
+  }
+}
+
+// Integer content of a value described as an integral Postgres type
+static int64_t GetIntegralValue(const Value &value) {
+  switch (value.GetValueType()) {
+    case VALUE_TYPE_BOOLEAN:
+      return ValuePeeker::PeekBoolean(value);
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DECIMAL:
+      return static_cast<int64_t>(ValuePeeker::PeekAsDouble(value));
+    default:
+      return ValuePeeker::PeekAsRawInt64(value);
+  }
+}
+
+/*
+ * The binary numeric is a sequence of base 10000 digits, the first one
+ * 	weighted by 10000^weight, plus the number of decimal digits after
+ * 	the point (dscale).
+ */
+static void PacketPutNumeric(std::unique_ptr<Packet> &pkt,
+                             const std::string &decimal) {
+  bool negative = (decimal.empty() == false && decimal[0] == '-');
+  std::string digits = decimal.substr(negative ? 1 : 0);
+  auto point = digits.find('.');
+  std::string whole = digits.substr(0, point);
+  std::string fraction =
+      (point == std::string::npos) ? "" : digits.substr(point + 1);
+  int dscale = fraction.size();
+
+  // align the groups of four digits on the decimal point
+  whole.insert(0, (4 - whole.size() % 4) % 4, '0');
+  fraction.append((4 - fraction.size() % 4) % 4, '0');
+  digits = whole + fraction;
+
+  std::vector<int> groups;
+  for (size_t i = 0; i < digits.size(); i += 4) {
+    groups.push_back(std::stoi(digits.substr(i, 4)));
+  }
+
+  // strip the leading and trailing zero groups
+  int weight = whole.size() / 4 - 1;
+  size_t first = 0, last = groups.size();
+  while (first < last && groups[first] == 0) {
+    first++;
+    weight--;
+  }
+  while (last > first && groups[last - 1] == 0) last--;
+  if (first == last) {
+    weight = 0;
+    negative = false;
+  }
+
+  int ndigits = last - first;
+  PacketPutInt(pkt, 8 + 2 * ndigits, 4);
+  PacketPutInt(pkt, ndigits, 2);
+  PacketPutInt(pkt, weight, 2);
+  PacketPutInt(pkt, negative ? NUMERIC_NEG : NUMERIC_POS, 2);
+  PacketPutInt(pkt, dscale, 2);
+  for (size_t i = first; i < last; i++) {
+    PacketPutInt(pkt, groups[i], 2);
+  }
+}
+
+static bool GetNumeric(const PktBuf &data, Value &result) {
+  if (data.size() < 8) return false;
+  auto word = [&data](size_t i) {
+    return static_cast<int16_t>((data[2 * i] << 8) | data[2 * i + 1]);
+  };
+
+  int ndigits = word(0), weight = word(1), dscale = word(3);
+  uint16_t sign = word(2);
+  if (ndigits < 0 || dscale < 0 || data.size() != 8 + 2 * (size_t)ndigits)
+    return false;
+  // NaN has no decimal counterpart
+  if (sign != NUMERIC_POS && sign != NUMERIC_NEG) return false;
+
+  // digit i is weighted by 10000^(weight - i)
+  auto digit = [&](int position) {
+    int index = weight - position;
+    return (index >= 0 && index < ndigits) ? word(4 + index) : 0;
+  };
+
+  char group[5];
+  std::string whole, fraction;
+  for (int position = weight; position >= 0; position--) {
+    snprintf(group, sizeof(group), "%04d", digit(position));
+    whole += group;
+  }
+  for (int position = -1; position >= -(dscale + 3) / 4; position--) {
+    snprintf(group, sizeof(group), "%04d", digit(position));
+    fraction += group;
+  }
+  fraction.resize(dscale);
+
+  std::string decimal = (sign == NUMERIC_NEG) ? "-" : "";
+  decimal += whole.empty() ? "0" : whole;
+  if (fraction.empty() == false) decimal += "." + fraction;
+
+  try {
+    result = ValueFactory::GetDecimalValueFromString(decimal);
+  } catch (Exception &e) {
+    // more digits than a decimal holds
+    return false;
+  }
+  return true;
+}
+
+void PacketPutValue(std::unique_ptr<Packet> &pkt, const Value &value,
+                    const PostgresValueType type, const int format) {
+  // NULL is sent as a -1 length
+  if (value.IsNull()) {
+    PacketPutInt(pkt, -1, 4);
+    return;
+  }
+
+  if (format != BINARY_FORMAT_CODE) {
+    PacketPutTextValue(pkt, value);
+    return;
+  }
+
+  switch (type) {
+    case POSTGRES_VALUE_TYPE_BOOLEAN:
+      PacketPutInt(pkt, 1, 4);
+      PacketPutByte(pkt, GetIntegralValue(value) != 0);
+      break;
+
+    case POSTGRES_VALUE_TYPE_SMALLINT:
+      PacketPutInt(pkt, 2, 4);
+      PacketPutBigEndian(pkt, GetIntegralValue(value), 2);
+      break;
+
+    case POSTGRES_VALUE_TYPE_INTEGER:
+      PacketPutInt(pkt, 4, 4);
+      PacketPutBigEndian(pkt, GetIntegralValue(value), 4);
+      break;
+
+    case POSTGRES_VALUE_TYPE_BIGINT:
+      PacketPutInt(pkt, 8, 4);
+      PacketPutBigEndian(pkt, GetIntegralValue(value), 8);
+      break;
+
+    case POSTGRES_VALUE_TYPE_REAL: {
+      float float_val = static_cast<float>(ValuePeeker::PeekAsDouble(value));
+      uint32_t bits;
+      memcpy(&bits, &float_val, sizeof(bits));
+      PacketPutInt(pkt, 4, 4);
+      PacketPutBigEndian(pkt, bits, 4);
+    } break;
+
+    case POSTGRES_VALUE_TYPE_DOUBLE: {
+      double double_val = ValuePeeker::PeekAsDouble(value);
+      uint64_t bits;
+      memcpy(&bits, &double_val, sizeof(bits));
+      PacketPutInt(pkt, 8, 4);
+      PacketPutBigEndian(pkt, bits, 8);
+    } break;
+
+    case POSTGRES_VALUE_TYPE_TIMESTAMPS:
+    case POSTGRES_VALUE_TYPE_TIMESTAMPS2:
+      PacketPutInt(pkt, 8, 4);
+      PacketPutBigEndian(pkt, GetIntegralValue(value) - POSTGRES_EPOCH_OFFSET,
+                         8);
+      break;
+
+    case POSTGRES_VALUE_TYPE_DECIMAL:
+      PacketPutNumeric(pkt, (value.GetValueType() == VALUE_TYPE_DECIMAL)
+                                ? ValuePeeker::PeekDecimalString(value)
+                                : Value(value).ToString());
+      break;
+
+    // the binary format of text and bytea is their raw bytes
+    default:
+      PacketPutTextValue(pkt, value);
+      break;
+  }
+}
+
+bool PacketGetBinaryValue(const PktBuf &data, const PostgresValueType type,
+                          Value &result) {
+  uint64_t n;
+
+  switch (type) {
+    case POSTGRES_VALUE_TYPE_BOOLEAN:
+      if (!GetBigEndian(data, 1, n)) return false;
+      result = ValueFactory::GetBooleanValue(n != 0);
+      return true;
+
+    case POSTGRES_VALUE_TYPE_SMALLINT:
+      if (!GetBigEndian(data, 2, n)) return false;
+      result = ValueFactory::GetSmallIntValue(static_cast<int16_t>(n));
+      return true;
+
+    case POSTGRES_VALUE_TYPE_INTEGER:
+      if (!GetBigEndian(data, 4, n)) return false;
+      result = ValueFactory::GetIntegerValue(static_cast<int32_t>(n));
+      return true;
+
+    case POSTGRES_VALUE_TYPE_BIGINT:
+      if (!GetBigEndian(data, 8, n)) return false;
+      result = ValueFactory::GetBigIntValue(static_cast<int64_t>(n));
+      return true;
+
+    case POSTGRES_VALUE_TYPE_REAL: {
+      if (!GetBigEndian(data, 4, n)) return false;
+      uint32_t bits = static_cast<uint32_t>(n);
+      float float_val;
+      memcpy(&float_val, &bits, sizeof(float_val));
+      result = ValueFactory::GetDoubleValue(float_val);
+      return true;
+    }
+
+    case POSTGRES_VALUE_TYPE_DOUBLE: {
+      if (!GetBigEndian(data, 8, n)) return false;
+      double double_val;
+      memcpy(&double_val, &n, sizeof(double_val));
+      result = ValueFactory::GetDoubleValue(double_val);
+      return true;
+    }
+
+    case POSTGRES_VALUE_TYPE_TIMESTAMPS:
+    case POSTGRES_VALUE_TYPE_TIMESTAMPS2:
+      if (!GetBigEndian(data, 8, n)) return false;
+      result = ValueFactory::GetTimestampValue(static_cast<int64_t>(n) +
+                                               POSTGRES_EPOCH_OFFSET);
+      return true;
+
+    case POSTGRES_VALUE_TYPE_DECIMAL:
+      return GetNumeric(data, result);
+
+    case POSTGRES_VALUE_TYPE_TEXT:
+    case POSTGRES_VALUE_TYPE_BPCHAR:
+    case POSTGRES_VALUE_TYPE_BPCHAR2:
+    case POSTGRES_VALUE_TYPE_VARCHAR:
+    case POSTGRES_VALUE_TYPE_VARCHAR2:
+      result = ValueFactory::GetStringValue(
+          std::string(std::begin(data), std::end(data)));
+      return true;
+
+    case POSTGRES_VALUE_TYPE_BYTEA:
+      result = ValueFactory::GetBinaryValue(data.data(), data.size());
+      return true;
+
+    default:
+      return false;
+  }
+}
+
 /**
  * Check if the buffer has data to be read
  */
@@ -214,8 +520,8 @@ bool ReadPacket(Packet *pkt, bool has_type_field, Client *client) {
   return true;
 }
 
-bool WritePackets(std::vector<std::unique_ptr<Packet>> &packets,
-                  Client *client) {
+bool BufferPackets(std::vector<std::unique_ptr<Packet>> &packets,
+                   Client *client) {
   // iterate through all the packets
   for (size_t i = 0; i < packets.size(); i++) {
     auto pkt = packets[i].get();
@@ -226,6 +532,12 @@ bool WritePackets(std::vector<std::unique_ptr<Packet>> &packets,
   }
   // clear packets
   packets.clear();
+  return true;
+}
+
+bool WritePackets(std::vector<std::unique_ptr<Packet>> &packets,
+                  Client *client) {
+  if (!BufferPackets(packets, client)) return false;
   return client->sock->FlushWriteBuffer();
 }
 
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdio>
 #include <unordered_map>
 
@@ -19,11 +20,16 @@
 #include "wire/marshal.h"
 #include "common/portal.h"
 #include "tcop/tcop.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
 
 #include "planner/abstract_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/update_plan.h"
 #include "planner/delete_plan.h"
+#include "planner/import_plan.h"
+#include "catalog/schema.h"
+#include "storage/data_table.h"
 #include "common/value.h"
 #include "common/value_factory.h"
 
@@ -46,11 +52,6 @@ const std::unordered_map<std::string, std::string>
             "server_version", "9.5devel")("session_authorization", "postgres")(
             "standard_conforming_strings", "on")("TimeZone", "US/Eastern");
 
-/*
- * close_client - Close the socket of the underlying client
- */
-void PacketManager::CloseClient() { client.sock->CloseSocket(); }
-
 void PacketManager::MakeHardcodedParameterStatus(
     ResponseBuffer &responses, const std::pair<std::string, std::string> &kv) {
   std::unique_ptr<Packet> response(new Packet());
@@ -117,7 +118,7 @@ bool PacketManager::ProcessStartupPacket(Packet *pkt,
 
 void PacketManager::PutTupleDescriptor(
     const std::vector<FieldInfoType> &tuple_descriptor,
-    ResponseBuffer &responses) {
+    const std::vector<int16_t> &result_formats, ResponseBuffer &responses) {
 
   if (tuple_descriptor.empty()) return;
 
@@ -126,7 +127,9 @@ void PacketManager::PutTupleDescriptor(
   pkt->msg_type = 'T';
   PacketPutInt(pkt, tuple_descriptor.size(), 2);
 
-  for (auto col : tuple_descriptor) {
+  for (size_t column_itr = 0; column_itr < tuple_descriptor.size();
+       column_itr++) {
+    auto &col = tuple_descriptor[column_itr];
     PacketPutString(pkt, std::get<0>(col));
     // TODO: Table Oid (int32)
     PacketPutInt(pkt, 0, 4);
@@ -138,41 +141,85 @@ void PacketManager::PutTupleDescriptor(
     PacketPutInt(pkt, std::get<2>(col), 2);
     // Type modifier (int32)
     PacketPutInt(pkt, -1, 4);
-    // Format code for text
-    PacketPutInt(pkt, 0, 2);
+    // Format code
+    PacketPutInt(pkt, result_formats.empty() ? TEXT_FORMAT_CODE
+                                             : result_formats[column_itr],
+                 2);
   }
   responses.push_back(std::move(pkt));
 }
 
-void PacketManager::SendDataRows(std::vector<ResultType> &results, int colcount,
-                                 int &rows_affected,
-                                 ResponseBuffer &responses) {
-  if (results.empty() || colcount == 0) return;
+bool PacketManager::SendDataRows(
+    bridge::PlanCursor &cursor,
+    const std::vector<FieldInfoType> &tuple_descriptor,
+    const std::vector<int16_t> &result_formats, int max_rows, int &rows_sent,
+    bool &suspended, ResponseBuffer &responses) {
+  rows_sent = 0;
+  suspended = false;
+
+  // Nothing to send, e.g. INSERT, just run the statement
+  if (tuple_descriptor.empty()) {
+    while (cursor.Next())
+      ;
+    return true;
+  }
+
+  // Queued responses must precede the rows
+  if (!BufferPackets(responses, &client)) return false;
+
+  // Type and format of each described column
+  std::vector<PostgresValueType> types;
+  std::vector<int> formats;
+  for (size_t column_itr = 0; column_itr < tuple_descriptor.size();
+       column_itr++) {
+    types.push_back(
+        static_cast<PostgresValueType>(std::get<1>(tuple_descriptor[column_itr])));
+    formats.push_back(result_formats.empty() ? TEXT_FORMAT_CODE
+                                             : result_formats[column_itr]);
+  }
+
+  auto &pkt = row_packet_;
+  while (max_rows == 0 || rows_sent < max_rows) {
+    if (cursor.Next() == false) return true;
 
-  size_t numrows = results.size() / colcount;
+    auto tile = cursor.GetTile();
+    auto tuple_id = cursor.GetTupleId();
+    oid_t column_count = tile->GetColumnCount();
 
-  // 1 packet per row
-  for (size_t i = 0; i < numrows; i++) {
-    std::unique_ptr<Packet> pkt(new Packet());
+    // Reuse the row packet's buffer
+    pkt->buf.clear();
+    pkt->len = 0;
     pkt->msg_type = 'D';
-    PacketPutInt(pkt, colcount, 2);
-    for (int j = 0; j < colcount; j++) {
-      // length of the row attribute
-      PacketPutInt(pkt, results[i * colcount + j].second.size(), 4);
-      // contents of the row attribute
-      PacketPutBytes(pkt, results[i * colcount + j].second);
+    PacketPutInt(pkt, column_count, 2);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      // Serialized from the tile, columns past the descriptor go as text
+      if (column_itr < types.size()) {
+        PacketPutValue(pkt, tile->GetValue(tuple_id, column_itr),
+                       types[column_itr], formats[column_itr]);
+      } else {
+        PacketPutValue(pkt, tile->GetValue(tuple_id, column_itr),
+                       POSTGRES_VALUE_TYPE_TEXT, TEXT_FORMAT_CODE);
+      }
     }
-    responses.push_back(std::move(pkt));
+
+    // Lands in the socket write buffer, flushed once it is full
+    if (!client.sock->BufferWriteBytes(pkt->buf, pkt->len, pkt->msg_type))
+      return false;
+    rows_sent++;
   }
-  rows_affected = numrows;
+
+  // Row limit reached, the rest waits for the next EXECUTE
+  suspended = true;
+  return true;
 }
 
-/* Gets the first token of a query */
+/* Gets the first token of a query, in upper case */
 std::string get_query_type(std::string query) {
+  boost::trim(query);
   std::vector<std::string> query_tokens;
-  boost::split(query_tokens, query, boost::is_any_of(" "),
+  boost::split(query_tokens, query, boost::is_any_of(" \t\r\n"),
                boost::token_compress_on);
-  return query_tokens[0];
+  return boost::to_upper_copy(query_tokens[0]);
 }
 
 void PacketManager::CompleteCommand(const std::string &query_type, int rows,
@@ -180,18 +227,11 @@ void PacketManager::CompleteCommand(const std::string &query_type, int rows,
   std::unique_ptr<Packet> pkt(new Packet());
   pkt->msg_type = 'C';
   std::string tag = query_type;
-  /* After Begin, we enter a txn block */
-  if (query_type.compare("BEGIN") == 0) txn_state = TXN_BLOCK;
-  /* After commit, we end the txn block */
-  else if (query_type.compare("COMMIT") == 0)
-    txn_state = TXN_IDLE;
-  /* After rollback, the txn block is ended */
-  else if (!query_type.compare("ROLLBACK"))
-    txn_state = TXN_IDLE;
-  /* the rest are custom status messages for each command */
-  else if (!query_type.compare("INSERT"))
+  /* custom status messages for each command, transaction commands (BEGIN,
+   * COMMIT and ROLLBACK) have none */
+  if (!query_type.compare("INSERT"))
     tag += " 0 " + std::to_string(rows);
-  else
+  else if (!IsTransactionCommand(query_type))
     tag += " " + std::to_string(rows);
   PacketPutString(pkt, tag);
 
@@ -221,7 +261,7 @@ bool PacketManager::HardcodedExecuteFilter(std::string query_type) {
 }
 
 // The Simple Query Protocol
-void PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
+bool PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
   std::string q_str;
   PacketGetString(pkt, pkt->len, q_str);
 
@@ -232,45 +272,196 @@ void PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
   if (queries.size() == 1) {
     SendEmptyQueryResponse(responses);
     SendReadyForQuery(txn_state, responses);
-    return;
+    return true;
   }
 
   // Get traffic cop
   auto &tcop = tcop::TrafficCop::GetInstance();
 
+  // The statements run in the session's explicit transaction, or else in
+  // an implicit one spanning the query string
+  bool failed = false;
+
   // iterate till before the trivial string after the last ';'
-  for (auto query : queries) {
+  for (size_t query_itr = 0; query_itr < queries.size(); query_itr++) {
+    auto &query = queries[query_itr];
     if (query.empty()) {
       SendEmptyQueryResponse(responses);
-      SendReadyForQuery(TXN_IDLE, responses);
-      return;
+      break;
+    }
+
+    auto query_type = get_query_type(query);
+    if (IsTransactionCommand(query_type)) {
+      ExecTransactionCommand(query_type, responses);
+      continue;
     }
 
-    std::vector<ResultType> result;
-    std::vector<FieldInfoType> tuple_descriptor;
     std::string error_message;
-    int rows_affected;
+    if (txn_state == TXN_FAIL) {
+      error_message =
+          "current transaction is aborted, commands ignored until end of "
+          "transaction block";
+      SendErrorResponse({{'M', error_message}}, responses);
+      failed = true;
+      break;
+    }
+
+    auto statement = tcop.PrepareStatement("unnamed", query, error_message);
+    if (statement.get() == nullptr) {
+      SendErrorResponse({{'M', error_message}}, responses);
+      FailTransaction();
+      failed = true;
+      break;
+    }
+
+    // The rows of COPY ... FROM STDIN follow in COPY DATA messages, the
+    // query goes on once they are done
+    auto import_plan = GetStdinImportPlan(*statement);
+    if (import_plan != nullptr) {
+      bool last = std::all_of(queries.begin() + query_itr + 1, queries.end(),
+                              [](const std::string &rest) {
+                                return boost::trim_copy(rest).empty();
+                              });
+      if (!last) {
+        error_message =
+            "COPY FROM STDIN has to be the last statement of the query";
+        SendErrorResponse({{'M', error_message}}, responses);
+        FailTransaction();
+        failed = true;
+        break;
+      }
+
+      copy_statement_ = statement;
+      copy_data_.clear();
+      auto table = import_plan->GetTable();
+      SendCopyInResponse(
+          table != nullptr ? table->GetSchema()->GetColumnCount() : 0,
+          responses);
+      return true;
+    }
+
+    // send the attribute names
+    auto tuple_descriptor = statement->GetTupleDescriptor();
+    PutTupleDescriptor(tuple_descriptor, {}, responses);
 
-    // execute the query in Sqlite
-    auto status = tcop.ExecuteStatement(query, result, tuple_descriptor,
-                                        rows_affected, error_message);
+    // stream the result rows as they are produced, always as text
+    auto cursor = tcop.OpenCursor(statement, statement->GetParamValues(),
+                                  GetTransaction());
+    int rows_affected;
+    bool suspended;
+    if (!SendDataRows(*cursor, tuple_descriptor, {}, 0, rows_affected,
+                      suspended, responses)) {
+      return false;
+    }
 
     // check status
-    if (status == Result::RESULT_FAILURE) {
+    auto status = cursor->Close();
+    if (status.m_result != Result::RESULT_SUCCESS) {
+      error_message = "Failed to execute : " + query;
       SendErrorResponse({{'M', error_message}}, responses);
+      FailTransaction();
+      failed = true;
       break;
     }
+    if (tuple_descriptor.empty()) rows_affected = status.m_processed;
 
-    // send the attribute names
-    PutTupleDescriptor(tuple_descriptor, responses);
+    CompleteCommand(query_type, rows_affected, responses);
+  }
 
-    // send the result rows
-    SendDataRows(result, tuple_descriptor.size(), rows_affected, responses);
+  FinishQuery(failed, responses);
+  return true;
+}
 
-    // TODO: should change to query_type
-    CompleteCommand(query, rows_affected, responses);
+void PacketManager::FinishQuery(bool failed, ResponseBuffer &responses) {
+  // End the implicit transaction
+  if (txn_state == TXN_IDLE) {
+    auto result = EndTransaction(!failed);
+    if (!failed && result != Result::RESULT_SUCCESS) {
+      SendErrorResponse({{'M', "Failed to commit the transaction"}},
+                        responses);
+    }
   }
-  SendReadyForQuery('I', responses);
+
+  SendReadyForQuery(txn_state, responses);
+}
+
+planner::ImportPlan *PacketManager::GetStdinImportPlan(
+    const Statement &statement) {
+  auto &plan_tree = statement.GetPlanTree();
+  if (plan_tree == nullptr ||
+      plan_tree->GetPlanNodeType() != PLAN_NODE_TYPE_IMPORT) {
+    return nullptr;
+  }
+  auto import_plan = static_cast<planner::ImportPlan *>(plan_tree.get());
+  return import_plan->IsFromStdin() ? import_plan : nullptr;
+}
+
+void PacketManager::SendCopyInResponse(int column_count,
+                                       ResponseBuffer &responses) {
+  std::unique_ptr<Packet> response(new Packet());
+  response->msg_type = 'G';
+  // textual rows, the columns in text format too
+  PacketPutInt(response, 0, 1);
+  PacketPutInt(response, column_count, 2);
+  for (int column_itr = 0; column_itr < column_count; column_itr++) {
+    PacketPutInt(response, 0, 2);
+  }
+  responses.push_back(std::move(response));
+}
+
+void PacketManager::ExecCopyDataMessage(Packet *pkt) {
+  // Not copying anymore, e.g. the COPY failed to start
+  if (copy_statement_ == nullptr) return;
+  copy_data_.append(pkt->buf.begin() + pkt->ptr, pkt->buf.begin() + pkt->len);
+}
+
+bool PacketManager::ExecCopyDoneMessage(ResponseBuffer &responses) {
+  if (copy_statement_ == nullptr) return true;
+  auto statement = std::move(copy_statement_);
+  copy_statement_ = nullptr;
+
+  // The plan of the statement isn't shared, it takes the rows for this run
+  auto import_plan = GetStdinImportPlan(*statement);
+  import_plan->SetInput(std::move(copy_data_));
+  copy_data_.clear();
+
+  auto &tcop = tcop::TrafficCop::GetInstance();
+  auto cursor = tcop.OpenCursor(statement, statement->GetParamValues(),
+                                GetTransaction());
+  int rows_affected;
+  bool suspended;
+  if (!SendDataRows(*cursor, {}, {}, 0, rows_affected, suspended,
+                    responses)) {
+    return false;
+  }
+  auto status = cursor->Close();
+  import_plan->SetInput(std::string());
+
+  bool failed = (status.m_result != Result::RESULT_SUCCESS);
+  if (failed) {
+    SendErrorResponse(
+        {{'M', "Failed to execute : " + statement->GetQueryString()}},
+        responses);
+    FailTransaction();
+  } else {
+    CompleteCommand("COPY", status.m_processed, responses);
+  }
+
+  FinishQuery(failed, responses);
+  return true;
+}
+
+void PacketManager::ExecCopyFailMessage(Packet *pkt,
+                                        ResponseBuffer &responses) {
+  if (copy_statement_ == nullptr) return;
+  copy_statement_ = nullptr;
+  copy_data_.clear();
+
+  std::string reason;
+  PacketGetString(pkt, pkt->len, reason);
+  SendErrorResponse({{'M', "COPY from stdin failed: " + reason}}, responses);
+  FailTransaction();
+  FinishQuery(true, responses);
 }
 
 /*
@@ -303,8 +494,7 @@ void PacketManager::ExecParseMessage(Packet *pkt, ResponseBuffer &responses) {
   statement =
       tcop.PrepareStatement(statement_name, query_string, error_message);
   if (statement.get() == nullptr) {
-    SendErrorResponse({{'M', error_message}}, responses);
-    SendReadyForQuery(txn_state, responses);
+    SendBatchError(error_message, responses);
     return;
   }
 
@@ -359,14 +549,19 @@ void PacketManager::ExecBindMessage(Packet *pkt, ResponseBuffer &responses) {
     formats[i] = PacketGetInt(pkt, 2);
   }
 
-  // error handling
+  // error handling, no format means all text and a single one applies to
+  // every parameter
   int num_params = PacketGetInt(pkt, 2);
-  if (num_params_format != num_params) {
+  if (num_params_format > 1 && num_params_format != num_params) {
     std::string error_message =
         "Malformed request: num_params_format is not equal to num_params";
-    SendErrorResponse({{'M', error_message}}, responses);
+    SendBatchError(error_message, responses);
     return;
   }
+  if (num_params_format <= 1) {
+    formats.assign(num_params, (num_params_format == 1) ? formats[0]
+                                                         : TEXT_FORMAT_CODE);
+  }
 
   // Get statement info generated in PARSE message
   std::shared_ptr<Statement> statement;
@@ -378,7 +573,7 @@ void PacketManager::ExecBindMessage(Packet *pkt, ResponseBuffer &responses) {
     if (statement.get() == nullptr) {
       std::string error_message = "Invalid unnamed statement";
       LOG_ERROR("%s", error_message.c_str());
-      SendErrorResponse({{'M', error_message}}, responses);
+      SendBatchError(error_message, responses);
       return;
     }
   } else {
@@ -391,7 +586,7 @@ void PacketManager::ExecBindMessage(Packet *pkt, ResponseBuffer &responses) {
     else {
       std::string error_message = "Prepared statement name already exists";
       LOG_ERROR("%s", error_message.c_str());
-      SendErrorResponse({{'M', error_message}}, responses);
+      SendBatchError(error_message, responses);
       return;
     }
   }
@@ -420,70 +615,74 @@ void PacketManager::ExecBindMessage(Packet *pkt, ResponseBuffer &responses) {
 
   PktBuf param;
   for (int param_idx = 0; param_idx < num_params; param_idx++) {
+    // the client may leave parameter types unspecified
+    auto param_type = (param_idx < (int)param_types.size())
+                          ? (PostgresValueType)param_types[param_idx]
+                          : POSTGRES_VALUE_TYPE_INVALID;
+    auto value_type = PostgresValueTypeToPelotonValueType(param_type);
+
     int param_len = PacketGetInt(pkt, 4);
     // BIND packet NULL parameter case
     if (param_len == -1) {
       // NULL mode
       bind_parameters.push_back(
           std::make_pair(ValueType::VALUE_TYPE_INTEGER, std::string("")));
+      param_values->push_back(ValueFactory::GetNullValueByType(
+          (value_type == VALUE_TYPE_INVALID) ? VALUE_TYPE_INTEGER
+                                             : value_type));
     } else {
       PacketGetBytes(pkt, param_len, param);
 
-      if (formats[param_idx] == 0) {
+      if (formats[param_idx] == TEXT_FORMAT_CODE) {
         // TEXT mode
         std::string param_str = std::string(std::begin(param), std::end(param));
         bind_parameters.push_back(
             std::make_pair(ValueType::VALUE_TYPE_VARCHAR, param_str));
-        param_values->push_back(
-            (ValueFactory::GetStringValue(param_str))
-                .CastAs(PostgresValueTypeToPelotonValueType(
-                     (PostgresValueType)param_types[param_idx])));
+        if (value_type == VALUE_TYPE_INVALID) {
+          param_values->push_back(ValueFactory::GetStringValue(param_str));
+        } else {
+          param_values->push_back(
+              (ValueFactory::GetStringValue(param_str)).CastAs(value_type));
+        }
       } else {
         // BINARY mode
-        switch (param_types[param_idx]) {
-          case POSTGRES_VALUE_TYPE_INTEGER: {
-            int int_val = 0;
-            for (size_t i = 0; i < sizeof(int); ++i) {
-              int_val = (int_val << 8) | param[i];
-            }
-            bind_parameters.push_back(std::make_pair(
-                ValueType::VALUE_TYPE_INTEGER, std::to_string(int_val)));
-            param_values->push_back(ValueFactory::GetIntegerValue(int_val));
-          } break;
-          case POSTGRES_VALUE_TYPE_BIGINT: {
-            int64_t int_val = 0;
-            for (size_t i = 0; i < sizeof(int64_t); ++i) {
-              int_val = (int_val << 8) | param[i];
-            }
-            bind_parameters.push_back(std::make_pair(
-                ValueType::VALUE_TYPE_BIGINT, std::to_string(int_val)));
-            param_values->push_back(ValueFactory::GetBigIntValue(int_val));
-          } break;
-          case POSTGRES_VALUE_TYPE_DOUBLE: {
-            double float_val = 0;
-            unsigned long buf = 0;
-            for (size_t i = 0; i < sizeof(double); ++i) {
-              buf = (buf << 8) | param[i];
-            }
-            memcpy(&float_val, &buf, sizeof(double));
-            bind_parameters.push_back(std::make_pair(
-                ValueType::VALUE_TYPE_DOUBLE, std::to_string(float_val)));
-            param_values->push_back(ValueFactory::GetDoubleValue(float_val));
-          } break;
-          default: {
-            LOG_ERROR("Do not support data type: %d", param_types[param_idx]);
-          } break;
+        Value param_value;
+        if (!PacketGetBinaryValue(param, param_type, param_value)) {
+          std::string error_message =
+              "Unsupported binary parameter of type " +
+              std::to_string(param_type) + " and length " +
+              std::to_string(param_len);
+          LOG_ERROR("%s", error_message.c_str());
+          delete param_values;
+          SendBatchError(error_message, responses);
+          return;
         }
+        bind_parameters.push_back(
+            std::make_pair(param_value.GetValueType(), std::string("")));
+        param_values->push_back(param_value);
       }
     }
   }
+
+  // Read result column formats, which follow the same rules
+  int num_result_formats = PacketGetInt(pkt, 2);
+  std::vector<int16_t> result_formats(num_result_formats);
+  for (int i = 0; i < num_result_formats; i++) {
+    result_formats[i] = PacketGetInt(pkt, 2);
+  }
+
   // Construct a portal
 
-  if (param_values->size() > 0) {
-    statement->GetPlanTree()->SetParameterValues(param_values);
+  // The values are bound into the executor context of every execution of
+  // the portal, the plan and the statement are left untouched. Without
+  // parameters the portal takes the literals of the statement's query.
+  if (param_values->empty()) {
+    *param_values = statement->GetParamValues();
   }
 
-  auto portal = new Portal(portal_name, statement, bind_parameters);
+  auto portal = new Portal(portal_name, statement, bind_parameters,
+                           *param_values, result_formats);
+  delete param_values;
   std::shared_ptr<Portal> portal_reference(portal);
 
   auto itr = portals_.find(portal_name);
@@ -515,7 +714,7 @@ void PacketManager::ExecDescribeMessage(Packet *pkt,
     if (portal_itr == portals_.end()) {
       LOG_ERROR("Did not find portal : %s", portal_name.c_str());
       std::vector<FieldInfoType> tuple_descriptor;
-      PutTupleDescriptor(tuple_descriptor, responses);
+      PutTupleDescriptor(tuple_descriptor, {}, responses);
       return;
     }
 
@@ -523,73 +722,208 @@ void PacketManager::ExecDescribeMessage(Packet *pkt,
     if (portal == nullptr) {
       LOG_ERROR("Portal does not exist : %s", portal_name.c_str());
       std::vector<FieldInfoType> tuple_descriptor;
-      PutTupleDescriptor(tuple_descriptor, responses);
+      PutTupleDescriptor(tuple_descriptor, {}, responses);
       return;
     }
 
     auto statement = portal->GetStatement();
-    PutTupleDescriptor(statement->GetTupleDescriptor(), responses);
+    auto tuple_descriptor = statement->GetTupleDescriptor();
+    PutTupleDescriptor(tuple_descriptor,
+                       portal->GetResultFormats(tuple_descriptor.size()),
+                       responses);
   }
 }
 
-void PacketManager::ExecExecuteMessage(Packet *pkt, ResponseBuffer &responses) {
+bool PacketManager::ExecExecuteMessage(Packet *pkt, ResponseBuffer &responses) {
   // EXECUTE message
-  std::vector<ResultType> results;
   std::string error_message, portal_name;
   int rows_affected = 0;
   GetStringToken(pkt, portal_name);
 
+  // maximum number of rows to return, 0 for no limit
+  int max_rows = PacketGetInt(pkt, 4);
+
   // covers weird JDBC edge case of sending double BEGIN statements. Don't
   // execute them
   if (skipped_stmt_) {
     CompleteCommand(skipped_query_type_, rows_affected, responses);
     skipped_stmt_ = false;
-    return;
+    return true;
   }
 
   auto portal = portals_[portal_name];
   if (portal.get() == nullptr) {
-    LOG_ERROR("Did not find portal : %s", portal_name.c_str());
-    SendErrorResponse({{'M', error_message}}, responses);
-    SendReadyForQuery(txn_state, responses);
-    return;
+    error_message = "Did not find portal : " + portal_name;
+    LOG_ERROR("%s", error_message.c_str());
+    SendBatchError(error_message, responses);
+    return true;
   }
 
   auto statement = portal->GetStatement();
-  const auto &query_type = statement->GetQueryType();
   if (statement.get() == nullptr) {
-    LOG_ERROR("Did not find statement in portal : %s", portal_name.c_str());
-    SendErrorResponse({{'M', error_message}}, responses);
-    SendReadyForQuery(txn_state, responses);
-    return;
+    error_message = "Did not find statement in portal : " + portal_name;
+    LOG_ERROR("%s", error_message.c_str());
+    SendBatchError(error_message, responses);
+    return true;
   }
+  const auto &query_type = statement->GetQueryType();
 
-  auto statement_name = statement->GetStatementName();
-  bool unnamed = statement_name.empty();
+  if (IsTransactionCommand(query_type)) {
+    ExecTransactionCommand(query_type, responses);
+    return true;
+  }
 
-  auto &tcop = tcop::TrafficCop::GetInstance();
-  auto status = tcop.ExecuteStatement(statement, unnamed, results,
-                                      rows_affected, error_message);
+  // Resume a suspended execution or start a new one, within the session's
+  // transaction
+  auto cursor = portal->GetCursor();
+  if (cursor == nullptr) {
+    if (txn_state == TXN_FAIL) {
+      SendBatchError(
+          "current transaction is aborted, commands ignored until end of "
+          "transaction block",
+          responses);
+      return true;
+    }
 
-  if (status == Result::RESULT_FAILURE) {
-    LOG_ERROR("Failed to execute: %s", error_message.c_str());
-    SendErrorResponse({{'M', error_message}}, responses);
-    SendReadyForQuery(txn_state, responses);
+    auto &tcop = tcop::TrafficCop::GetInstance();
+    cursor = tcop.OpenCursor(statement, portal->GetParamValues(),
+                             GetTransaction()).release();
+    portal->SetCursor(cursor);
   }
-  // put_row_desc(portal->rowdesc, responses);
+
   auto tuple_descriptor = statement->GetTupleDescriptor();
-  SendDataRows(results, tuple_descriptor.size(), rows_affected, responses);
+  bool suspended;
+  if (!SendDataRows(*cursor, tuple_descriptor,
+                    portal->GetResultFormats(tuple_descriptor.size()),
+                    max_rows, rows_affected, suspended, responses)) {
+    return false;
+  }
+
+  // More rows remain, keep the cursor open in the portal
+  if (suspended) {
+    std::unique_ptr<Packet> response(new Packet());
+    response->msg_type = 's';
+    responses.push_back(std::move(response));
+    return true;
+  }
+
+  // The executor tree is kept for the next execution of the statement
+  auto &tcop = tcop::TrafficCop::GetInstance();
+  auto status = tcop.CloseCursor(statement, portal->ReleaseCursor());
+
+  if (status.m_result != Result::RESULT_SUCCESS) {
+    error_message = "Failed to execute : " + statement->GetQueryString();
+    LOG_ERROR("%s", error_message.c_str());
+    SendBatchError(error_message, responses);
+    return true;
+  }
+
+  if (tuple_descriptor.empty()) rows_affected = status.m_processed;
   CompleteCommand(query_type, rows_affected, responses);
+  return true;
+}
+
+concurrency::Transaction *PacketManager::GetTransaction() {
+  if (txn_ == nullptr) {
+    auto &tcop = tcop::TrafficCop::GetInstance();
+    txn_ = tcop.BeginTransaction();
+  }
+  return txn_;
+}
+
+Result PacketManager::EndTransaction(bool commit) {
+  // Executions suspended in the transaction end with it
+  for (auto &portal : portals_) {
+    if (portal.second != nullptr) portal.second->SetCursor(nullptr);
+  }
+
+  // Nothing was executed
+  if (txn_ == nullptr) {
+    return commit ? Result::RESULT_SUCCESS : Result::RESULT_ABORTED;
+  }
+
+  auto &tcop = tcop::TrafficCop::GetInstance();
+  auto result =
+      commit ? tcop.CommitTransaction(txn_) : tcop.AbortTransaction(txn_);
+  txn_ = nullptr;
+  return result;
+}
+
+void PacketManager::FailTransaction() {
+  if (txn_state == TXN_BLOCK) txn_state = TXN_FAIL;
+}
+
+bool PacketManager::IsTransactionCommand(const std::string &query_type) {
+  return query_type == "BEGIN" || query_type == "COMMIT" ||
+         query_type == "ROLLBACK";
 }
 
+void PacketManager::ExecTransactionCommand(const std::string &query_type,
+                                           ResponseBuffer &responses) {
+  if (query_type == "BEGIN") {
+    // Statements of the current batch so far become part of the block
+    if (txn_state == TXN_IDLE) {
+      GetTransaction();
+      txn_state = TXN_BLOCK;
+    }
+    CompleteCommand(query_type, 0, responses);
+    return;
+  }
+
+  // Outside of a block there is nothing to end
+  if (txn_state == TXN_IDLE) {
+    CompleteCommand(query_type, 0, responses);
+    return;
+  }
+
+  // COMMIT of a failed block rolls it back
+  bool commit = (query_type == "COMMIT" && txn_state == TXN_BLOCK);
+  auto result = EndTransaction(commit);
+  txn_state = TXN_IDLE;
+
+  if (commit && result != Result::RESULT_SUCCESS) {
+    SendErrorResponse({{'M', "Failed to commit the transaction"}}, responses);
+    return;
+  }
+  CompleteCommand(commit ? "COMMIT" : "ROLLBACK", 0, responses);
+}
+
+void PacketManager::SendBatchError(const std::string &error_message,
+                                   ResponseBuffer &responses) {
+  SendErrorResponse({{'M', error_message}}, responses);
+  FailTransaction();
+  skip_to_sync_ = true;
+}
+
+void PacketManager::ExecSyncMessage(ResponseBuffer &responses) {
+  // SYNC ends an implicit transaction, a BEGIN block stays open
+  if (txn_state == TXN_IDLE) {
+    auto result = EndTransaction(!skip_to_sync_);
+    if (!skip_to_sync_ && result != Result::RESULT_SUCCESS) {
+      SendErrorResponse({{'M', "Failed to commit the transaction"}},
+                        responses);
+    }
+  }
+
+  skip_to_sync_ = false;
+  SendReadyForQuery(txn_state, responses);
+}
+
+PacketManager::~PacketManager() { EndTransaction(false); }
+
 /*
  * process_packet - Main switch block; process incoming packets,
  *  Returns false if the session needs to be closed.
  */
 bool PacketManager::ProcessPacket(Packet *pkt, ResponseBuffer &responses) {
+  // The rest of a failed batch is ignored
+  if (skip_to_sync_ && pkt->msg_type != 'S' && pkt->msg_type != 'X') {
+    return true;
+  }
+
   switch (pkt->msg_type) {
     case 'Q': {
-      ExecQueryMessage(pkt, responses);
+      if (!ExecQueryMessage(pkt, responses)) return false;
     } break;
     case 'P': {
       ExecParseMessage(pkt, responses);
@@ -601,11 +935,22 @@ bool PacketManager::ProcessPacket(Packet *pkt, ResponseBuffer &responses) {
       ExecDescribeMessage(pkt, responses);
     } break;
     case 'E': {
-      ExecExecuteMessage(pkt, responses);
+      if (!ExecExecuteMessage(pkt, responses)) return false;
+    } break;
+    case 'd': {
+      ExecCopyDataMessage(pkt);
+    } break;
+    case 'c': {
+      if (!ExecCopyDoneMessage(responses)) return false;
+    } break;
+    case 'f': {
+      ExecCopyFailMessage(pkt, responses);
     } break;
     case 'S': {
-      // SYNC message
-      SendReadyForQuery(txn_state, responses);
+      ExecSyncMessage(responses);
+    } break;
+    case 'H': {
+      // FLUSH message, the responses are written once it is processed
     } break;
     case 'X': {
       return false;
@@ -659,13 +1004,11 @@ bool PacketManager::ManageFirstPacket() {
   bool status;
   // fetch the startup packet
   if (!ReadPacket(&pkt, false, &client)) {
-    CloseClient();
     return false;
   }
   status = ProcessStartupPacket(&pkt, responses);
   if (!WritePackets(responses, &client) || !status) {
-    // close client on write failure or status failure
-    CloseClient();
+    // the loop closes the client on write failure or status failure
     return false;
   }
   return true;
@@ -683,18 +1026,29 @@ bool PacketManager::ManagePacket() {
 		// Process the read packet
 		status = ProcessPacket(&pkt, responses);
 
-		// Write response
-		if (!WritePackets(responses, &client) || !status) {
-		  // close client on write failure or status failure
-		  CloseClient();
+		// Buffer the responses of a pipelined batch, they are written
+		// together once the batch ends with SYNC or the client asks for
+		// them with FLUSH (or the socket buffer fills up)
+		if (!BufferPackets(responses, &client) || !status) {
+		  // the loop closes the client on write failure or status failure
 		  return false;
 		}
+		if (pkt.msg_type == 'S' || pkt.msg_type == 'H' || pkt.msg_type == 'Q' ||
+		    pkt.msg_type == 'c' || pkt.msg_type == 'f') {
+		  if (!client.sock->FlushWriteBuffer()) {
+		    return false;
+		  }
+		}
 		// Can read more?
 		can_read_more = CanRead(&client);
 		pkt.Reset();
     }
 	// Read failed
 	else {
+		// the client went away, rather than having nothing more to send
+		if (client.sock->IsDisconnected()) {
+		  return false;
+		}
 		break;
 	}
   }
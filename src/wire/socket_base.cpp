@@ -35,8 +35,15 @@ bool SocketManager<B>::RefillReadBuffer() {
                       SOCKET_BUFFER_SIZE - rbuf.buf_size);
 
     if (bytes_read < 0) {
+      // interrupted, try again
+      if (errno == EINTR) continue;
+
+      // nothing to read yet, wait for the next read event
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+
 		// Some other error occurred, close the socket, remove
 		// the event and free the client structure.
+      disconnected = true;
       return false;
     }
 
@@ -44,6 +51,7 @@ bool SocketManager<B>::RefillReadBuffer() {
 	  // If the length of bytes returned by read is 0, this means
 	  // that the client disconnected, remove the read event and the
 	  // free the client structure.
+      disconnected = true;
       return false;
     }
 
@@ -292,6 +300,9 @@ bool SocketManager<B>::BufferWriteBytes(B &pkt_buf, size_t len, uchar type) {
 
 template <typename B>
 void SocketManager<B>::CloseSocket() {
+  // The descriptor may already belong to a new connection
+  if (sock_fd < 0) return;
+
   for (;;) {
     int status = close(sock_fd);
     if (status < 0) {
@@ -301,6 +312,7 @@ void SocketManager<B>::CloseSocket() {
         continue;
       }
     }
+    sock_fd = -1;
     return;
   }
 }
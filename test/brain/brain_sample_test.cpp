@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// brain_sample_test.cpp
+//
+// Identification: test/brain/brain_sample_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "brain/sample.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Sample Tests
+//===--------------------------------------------------------------------===//
+
+class SampleTests : public PelotonTest {};
+
+TEST_F(SampleTests, ExecutorSampleTest) {
+  auto sample_rate = peloton_sample_rate;
+  peloton_sample_rate = 1;
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(5, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 20, false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Second column of the first quarter of the rows
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(5, 0))));
+  planner::SeqScanPlan plan(table.get(), predicate, {1});
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&plan, context.get());
+  EXPECT_TRUE(executor.Init());
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  }
+  EXPECT_FALSE(executor.Execute());
+  txn_manager.CommitTransaction(txn);
+
+  // The scan is sampled once: the columns it reads for the layout tuner,
+  // the ids of its predicate columns for the index tuner
+  auto layout_samples = table->TakeLayoutSamples();
+  EXPECT_EQ(1, layout_samples.size());
+  EXPECT_EQ(std::vector<oid_t>({0, 1}), layout_samples[0].GetEnabledColumns());
+
+  auto index_samples = table->TakeIndexSamples();
+  EXPECT_EQ(1, index_samples.size());
+  EXPECT_EQ(std::vector<double>({0}), index_samples[0].columns_accessed_);
+  EXPECT_EQ(brain::SAMPLE_TYPE_ACCESS, index_samples[0].sample_type_);
+  EXPECT_DOUBLE_EQ(0.25, index_samples[0].metric_);
+  EXPECT_EQ(0, table->GetIndexSampleCount());
+
+  table->RecordWriteSample({2}, 3);
+  index_samples = table->TakeIndexSamples();
+  EXPECT_EQ(1, index_samples.size());
+  EXPECT_EQ(std::vector<double>({2}), index_samples[0].columns_accessed_);
+  EXPECT_EQ(brain::SAMPLE_TYPE_UPDATE, index_samples[0].sample_type_);
+  EXPECT_DOUBLE_EQ(3, index_samples[0].weight_);
+
+  // Samples recorded while the buffer is full are dropped
+  auto column_count = table->GetSchema()->GetColumnCount();
+  for (int sample_itr = 0; sample_itr < 2 * SAMPLE_BUFFER_SIZE; sample_itr++) {
+    table->RecordLayoutSample(brain::Sample(column_count, {0}));
+  }
+  layout_samples = table->TakeLayoutSamples();
+  EXPECT_LT(0, layout_samples.size());
+  EXPECT_GE(SAMPLE_BUFFER_SIZE, layout_samples.size());
+
+  // One in every peloton_sample_rate accesses is sampled
+  peloton_sample_rate = 4;
+  int sampled_count = 0;
+  for (int access_itr = 0; access_itr < 8; access_itr++) {
+    if (table->SampleAccess()) sampled_count++;
+  }
+  EXPECT_EQ(2, sampled_count);
+
+  peloton_sample_rate = 0;
+  EXPECT_FALSE(table->SampleAccess());
+
+  peloton_sample_rate = sample_rate;
+}
+
+}  // End test namespace
+}  // End peloton namespace
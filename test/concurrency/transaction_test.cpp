@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "common/harness.h"
 #include "concurrency/transaction_tests_util.h"
@@ -210,5 +213,26 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, WaitForOtherTransactionsTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto other_txn = txn_manager.BeginTransaction();
+  auto txn = txn_manager.BeginTransaction();
+
+  // The waiting transaction does not wait for itself
+  std::atomic<bool> waited(false);
+  std::thread waiter([&txn_manager, txn, &waited] {
+    txn_manager.WaitForOtherTransactions(txn);
+    waited = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(4 * EPOCH_LENGTH));
+  EXPECT_FALSE(waited);
+  txn_manager.CommitTransaction(other_txn);
+  waiter.join();
+  EXPECT_TRUE(waited);
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,232 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_test.cpp
+//
+// Identification: test/executor/exchange_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/aggregate_plan.h"
+#include "planner/exchange_plan.h"
+#include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/limit_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Exchange Tests
+//===--------------------------------------------------------------------===//
+
+class ExchangeTests : public PelotonTest {};
+
+static const size_t degree_of_parallelism = 4;
+
+// Small tile groups, so every worker gets a few of them
+static storage::DataTable *CreatePopulatedTable(int tuple_count) {
+  auto table = ExecutorTestsUtil::CreateTable(10, false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+// Exchange over a scan of A and B of the table, with A < PopulatedValue(limit)
+static std::unique_ptr<planner::ExchangePlan> CreateExchangeScanPlan(
+    storage::DataTable *table, int limit) {
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(limit, 0))));
+  std::unique_ptr<planner::AbstractPlan> scan(
+      new planner::SeqScanPlan(table, predicate, {0, 1}));
+
+  std::unique_ptr<planner::ExchangePlan> exchange(
+      new planner::ExchangePlan(degree_of_parallelism));
+  exchange->AddChild(std::move(scan));
+  return exchange;
+}
+
+// Returns the values of the first column of the rows
+static std::vector<int> RunPlan(const planner::AbstractPlan *plan) {
+  std::vector<int> values;
+  bridge::PlanCursor cursor(plan, {});
+  while (cursor.Next()) {
+    values.push_back(ValuePeeker::PeekAsInteger(
+        cursor.GetTile()->GetValue(cursor.GetTupleId(), 0)));
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  return values;
+}
+
+TEST_F(ExchangeTests, SeqScanTest) {
+  const int tuple_count = 1000;
+  const size_t limit = 500;
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable(tuple_count));
+
+  // Every qualifying tuple once, whichever worker scanned it
+  auto plan = CreateExchangeScanPlan(table.get(), limit);
+  auto values = RunPlan(plan.get());
+  std::set<int> distinct_values(values.begin(), values.end());
+  EXPECT_EQ(limit, values.size());
+  EXPECT_EQ(limit, distinct_values.size());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(0, 0), *distinct_values.begin());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(limit - 1, 0),
+            *distinct_values.rbegin());
+
+  // More workers than tile groups
+  std::unique_ptr<storage::DataTable> small_table(CreatePopulatedTable(15));
+  plan = CreateExchangeScanPlan(small_table.get(), tuple_count);
+  EXPECT_EQ(15U, RunPlan(plan.get()).size());
+}
+
+TEST_F(ExchangeTests, LimitTest) {
+  const int tuple_count = 1000;
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable(tuple_count));
+
+  // The workers still running are stopped once the limit is reached
+  planner::LimitPlan limit_plan(5, 0);
+  limit_plan.AddChild(CreateExchangeScanPlan(table.get(), tuple_count));
+  EXPECT_EQ(5U, RunPlan(&limit_plan).size());
+}
+
+TEST_F(ExchangeTests, AggregateTest) {
+  const int tuple_count = 1000;
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable(tuple_count));
+
+  std::shared_ptr<const catalog::Schema> schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(1)}));
+
+  // COUNT(*), SUM(A), MAX(B) of the morsels of every worker
+  std::vector<planner::AggregatePlan::AggTerm> partial_agg_terms = {
+      {EXPRESSION_TYPE_AGGREGATE_COUNT_STAR, nullptr},
+      {EXPRESSION_TYPE_AGGREGATE_SUM,
+       expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                     0)},
+      {EXPRESSION_TYPE_AGGREGATE_MAX,
+       expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                     1)}};
+  DirectMapList partial_direct_map_list = {
+      {0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}};
+  std::unique_ptr<const planner::ProjectInfo> partial_proj_info(
+      new planner::ProjectInfo(TargetList(),
+                               std::move(partial_direct_map_list)));
+  std::unique_ptr<planner::AggregatePlan> partial_agg_plan(
+      new planner::AggregatePlan(std::move(partial_proj_info), nullptr,
+                                 std::move(partial_agg_terms), {}, schema,
+                                 AGGREGATE_TYPE_PLAIN));
+  partial_agg_plan->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+  std::unique_ptr<planner::ExchangePlan> exchange(
+      new planner::ExchangePlan(degree_of_parallelism));
+  exchange->AddChild(std::move(partial_agg_plan));
+
+  // Merged by SUM, SUM and MAX
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {EXPRESSION_TYPE_AGGREGATE_SUM,
+       expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                     0)},
+      {EXPRESSION_TYPE_AGGREGATE_SUM,
+       expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                     1)},
+      {EXPRESSION_TYPE_AGGREGATE_MAX,
+       expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                     2)}};
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  planner::AggregatePlan agg_plan(std::move(proj_info), nullptr,
+                                  std::move(agg_terms), {}, schema,
+                                  AGGREGATE_TYPE_PLAIN);
+  agg_plan.AddChild(std::move(exchange));
+
+  bridge::PlanCursor cursor(&agg_plan, {});
+  EXPECT_TRUE(cursor.Next());
+  auto tile = cursor.GetTile();
+  auto tuple_id = cursor.GetTupleId();
+  int sum = 0;
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    sum += ExecutorTestsUtil::PopulatedValue(tuple_itr, 0);
+  }
+  EXPECT_EQ(tuple_count,
+            ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 0)));
+  EXPECT_EQ(sum, ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 1)));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 1),
+            ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 2)));
+  EXPECT_FALSE(cursor.Next());
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+}
+
+TEST_F(ExchangeTests, HashJoinTest) {
+  const int outer_tuple_count = 300;
+  const int inner_tuple_count = 200;
+  std::unique_ptr<storage::DataTable> outer_table(
+      CreatePopulatedTable(outer_tuple_count));
+  std::unique_ptr<storage::DataTable> inner_table(
+      CreatePopulatedTable(inner_tuple_count));
+
+  // OUTER.A, INNER.A of OUTER.A = INNER.A, the hash table built from the
+  // tiles of the workers scanning the inner table
+  std::vector<std::unique_ptr<const expression::AbstractExpression>>
+      hash_keys;
+  hash_keys.emplace_back(
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 1, 0));
+  std::unique_ptr<planner::HashPlan> hash_plan(
+      new planner::HashPlan(hash_keys));
+  hash_plan->AddChild(
+      CreateExchangeScanPlan(inner_table.get(), inner_tuple_count));
+
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::shared_ptr<const catalog::Schema> schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(0)}));
+  planner::HashJoinPlan join_plan(JOIN_TYPE_INNER, nullptr,
+                                  std::move(proj_info), schema);
+  join_plan.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(outer_table.get(), nullptr, {0, 1})));
+  join_plan.AddChild(std::move(hash_plan));
+
+  int rows = 0;
+  bridge::PlanCursor cursor(&join_plan, {});
+  while (cursor.Next()) {
+    auto tile = cursor.GetTile();
+    auto tuple_id = cursor.GetTupleId();
+    EXPECT_EQ(ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 0)),
+              ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 1)));
+    rows++;
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  EXPECT_EQ(inner_tuple_count, rows);
+}
+
+}  // End test namespace
+}  // End peloton namespace
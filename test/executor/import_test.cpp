@@ -0,0 +1,188 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_test.cpp
+//
+// Identification: test/executor/import_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/config.h"
+#include "common/value_peeker.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "index/index.h"
+#include "planner/import_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Import Tests
+//===--------------------------------------------------------------------===//
+
+class ImportTests : public PelotonTest {};
+
+static bridge::peloton_status RunImport(planner::ImportPlan *plan) {
+  bridge::PlanCursor cursor(plan, {});
+  while (cursor.Next())
+    ;
+  return cursor.Close();
+}
+
+// The visible tuples of the table, by the value of their first column
+static std::map<int, std::vector<Value>> ScanTable(storage::DataTable *table) {
+  std::map<int, std::vector<Value>> tuples;
+  planner::SeqScanPlan plan(table, nullptr, {0, 1, 2, 3});
+  bridge::PlanCursor cursor(&plan, {});
+  while (cursor.Next()) {
+    std::vector<Value> values;
+    for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+      values.push_back(
+          cursor.GetTile()->GetValue(cursor.GetTupleId(), column_itr));
+    }
+    tuples[ValuePeeker::PeekAsInteger(values[0])] = values;
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  return tuples;
+}
+
+TEST_F(ImportTests, CSVFileTest) {
+  const int tuple_count = 3000;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(100, true));
+
+  // Rows in the order of their keys, a few of them quoted
+  std::string file_path = "/tmp/peloton_import_test.csv";
+  {
+    std::ofstream file(file_path);
+    for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      file << ExecutorTestsUtil::PopulatedValue(tuple_itr, 0) << ","
+           << ExecutorTestsUtil::PopulatedValue(tuple_itr, 1) << ",";
+      if (tuple_itr % 100 == 1) {
+        file << ",\"a, \"\"b\"\"\r\nc\"\r\n";
+      } else {
+        file << ExecutorTestsUtil::PopulatedValue(tuple_itr, 2) << ","
+             << ExecutorTestsUtil::PopulatedValue(tuple_itr, 3) << "\n";
+      }
+    }
+  }
+
+  // Small chunks, so rows and quoted fields straddle the cuts
+  auto chunk_size = FLAGS_import_chunk_size;
+  auto threads = FLAGS_import_threads;
+  FLAGS_import_chunk_size = 1000;
+  FLAGS_import_threads = 4;
+
+  planner::ImportPlan plan(table.get(), file_path,
+                           parser::ImportStatement::kImportCSV);
+  auto status = RunImport(&plan);
+
+  FLAGS_import_chunk_size = chunk_size;
+  FLAGS_import_threads = threads;
+  std::remove(file_path.c_str());
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+  EXPECT_EQ(tuple_count, status.m_processed);
+  EXPECT_EQ(tuple_count, table->GetTupleCount());
+
+  auto tuples = ScanTable(table.get());
+  ASSERT_EQ(tuple_count, tuples.size());
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto &values = tuples[ExecutorTestsUtil::PopulatedValue(tuple_itr, 0)];
+    ASSERT_EQ(4, values.size());
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_itr, 1),
+              ValuePeeker::PeekAsInteger(values[1]));
+    if (tuple_itr % 100 == 1) {
+      EXPECT_TRUE(values[2].IsNull());
+      EXPECT_EQ("a, \"b\"\r\nc",
+                ValuePeeker::PeekStringCopyWithoutNull(values[3]));
+    } else {
+      EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_itr, 2),
+                ValuePeeker::PeekDouble(values[2]));
+      EXPECT_EQ(std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_itr, 3)),
+                ValuePeeker::PeekStringCopyWithoutNull(values[3]));
+    }
+  }
+
+  // Both indexes hold every tuple
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); index_itr++) {
+    std::vector<ItemPointer *> index_entries;
+    table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(tuple_count, index_entries.size());
+  }
+}
+
+TEST_F(ImportTests, TextStdinTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(100, true));
+
+  // What follows the end of data marker is ignored
+  planner::ImportPlan plan(table.get(), "",
+                           parser::ImportStatement::kImportTSV);
+  EXPECT_TRUE(plan.IsFromStdin());
+  plan.SetInput(
+      "10\t11\t\\N\tone\\ttab\n"
+      "20\t21\t22.5\ttwo\r\n"
+      "\\.\n"
+      "30\t31\t32\tthree\n");
+  auto status = RunImport(&plan);
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+  EXPECT_EQ(2, status.m_processed);
+
+  auto tuples = ScanTable(table.get());
+  ASSERT_EQ(2, tuples.size());
+  EXPECT_TRUE(tuples[10][2].IsNull());
+  EXPECT_EQ("one\ttab", ValuePeeker::PeekStringCopyWithoutNull(tuples[10][3]));
+  EXPECT_EQ(22.5, ValuePeeker::PeekDouble(tuples[20][2]));
+  EXPECT_EQ("two", ValuePeeker::PeekStringCopyWithoutNull(tuples[20][3]));
+}
+
+TEST_F(ImportTests, FailureTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(100, true));
+
+  // Nothing is loaded if any row can't be
+  std::vector<std::string> inputs = {
+      // duplicate key
+      "1,2,3,a\n4,5,6,b\n1,8,9,c\n",
+      // missing column
+      "1,2,3,a\n4,5,6\n",
+      // not a number
+      "1,x,3,a\n",
+      // open quote
+      "1,2,3,\"a\n"};
+  for (auto &input : inputs) {
+    planner::ImportPlan plan(table.get(), "",
+                             parser::ImportStatement::kImportCSV);
+    plan.SetInput(std::string(input));
+    EXPECT_NE(Result::RESULT_SUCCESS, RunImport(&plan).m_result);
+  }
+
+  planner::ImportPlan missing_file_plan(table.get(),
+                                        "/tmp/peloton_import_missing.csv",
+                                        parser::ImportStatement::kImportCSV);
+  EXPECT_NE(Result::RESULT_SUCCESS, RunImport(&missing_file_plan).m_result);
+
+  EXPECT_EQ(0, ScanTable(table.get()).size());
+}
+
+}  // End test namespace
+}  // End peloton namespace
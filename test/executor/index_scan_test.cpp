@@ -10,10 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "common/harness.h"
 #include "common/value_factory.h"
+#include "common/value_peeker.h"
 #include "common/logger.h"
 #include "common/statement.h"
 #include "planner/index_scan_plan.h"
@@ -31,6 +34,9 @@
 #include "executor/plan_executor.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "concurrency/transaction_tests_util.h"
+#include "expression/expression_util.h"
+#include "index/index_factory.h"
 #include "catalog/bootstrapper.h"
 #include "catalog/catalog.h"
 #include "parser/parser.h"
@@ -173,6 +179,213 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// First column of the rows with ATTR 0 <= 110 the secondary index returns
+static std::vector<int> SecondaryIndexScan(storage::DataTable *table,
+                                           bool bitmap_scan) {
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(1), {0}, {EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO},
+      {ValueFactory::GetIntegerValue(110)}, {});
+  planner::IndexScanPlan node(table, nullptr, {0, 1, 3}, index_scan_desc);
+  node.SetBitmapScan(bitmap_scan);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<int> values;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (auto tuple_id : *result_tile) {
+      values.push_back(
+          ValuePeeker::PeekAsInteger(result_tile->GetValue(tuple_id, 0)));
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+  return values;
+}
+
+TEST_F(IndexScanTests, BitmapScanTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // The rows were inserted in the order of their first column, so reading
+  // them in the order of their locations returns them sorted
+  std::vector<int> bitmap_values = SecondaryIndexScan(data_table.get(), true);
+  EXPECT_EQ(12, bitmap_values.size());
+  EXPECT_TRUE(std::is_sorted(bitmap_values.begin(), bitmap_values.end()));
+
+  std::vector<int> index_values = SecondaryIndexScan(data_table.get(), false);
+  std::sort(index_values.begin(), index_values.end());
+  EXPECT_EQ(index_values, bitmap_values);
+}
+
+// (id, value) of the rows with id < 5 and value >= 10 of the covering index,
+// which keeps the id and includes the value
+static std::vector<std::pair<int, int>> IndexOnlyScan(
+    storage::DataTable *table, concurrency::Transaction *txn) {
+  auto index = table->GetIndex(1);
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, {0}, {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+      {ValueFactory::GetIntegerValue(5)}, {});
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        1),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(10))));
+
+  planner::IndexScanPlan node(table, predicate.get(), {0, 1},
+                              index_scan_desc);
+  EXPECT_TRUE(node.IsCoveredByIndex());
+  node.SetIndexOnly(true);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::pair<int, int>> rows;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (auto tuple_id : *result_tile) {
+      rows.emplace_back(
+          ValuePeeker::PeekAsInteger(result_tile->GetValue(tuple_id, 0)),
+          ValuePeeker::PeekAsInteger(result_tile->GetValue(tuple_id, 1)));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+TEST_F(IndexScanTests, IndexOnlyScanTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(0));
+
+  // Index on the id including the value
+  std::vector<oid_t> key_attrs = {0, 1};
+  auto key_schema = catalog::Schema::CopySchema(table->GetSchema(), key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto index_metadata = new index::IndexMetadata(
+      "covering_index", 1235, INDEX_TYPE_BWTREE, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      table->GetSchema(), key_schema, key_attrs, false, 1);
+  EXPECT_EQ(1, index_metadata->GetIncludedColumnCount());
+  table->AddIndex(std::shared_ptr<index::Index>(
+      index::IndexFactory::GetInstance(index_metadata)));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < 10; id++) {
+    TransactionTestsUtil::ExecuteInsert(txn, table.get(), id, id * 10);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // The value is not kept in the index on the id alone
+  planner::IndexScanPlan::IndexScanDesc id_scan_desc(
+      table->GetIndex(0), {0}, {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+      {ValueFactory::GetIntegerValue(5)}, {});
+  planner::IndexScanPlan id_scan(table.get(), nullptr, {0, 1}, id_scan_desc);
+  EXPECT_FALSE(id_scan.IsCoveredByIndex());
+  EXPECT_FALSE(id_scan.IsIndexOnly());
+
+  // Every row is answered from the index
+  std::vector<std::pair<int, int>> expected_rows = {
+      {1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(expected_rows, IndexOnlyScan(table.get(), txn));
+  txn_manager.CommitTransaction(txn);
+
+  // A deleted row and a row inserted after the scan began are looked up in
+  // the table, which finds neither of them visible
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteDelete(txn, table.get(), 2));
+  txn_manager.CommitTransaction(txn);
+
+  auto scan_txn = txn_manager.BeginTransaction();
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteInsert(txn, table.get(), -1, 10));
+  txn_manager.CommitTransaction(txn);
+
+  expected_rows = {{1, 10}, {3, 30}, {4, 40}};
+  EXPECT_EQ(expected_rows, IndexOnlyScan(table.get(), scan_txn));
+  txn_manager.CommitTransaction(scan_txn);
+}
+
+// Ids of the rows with id >= 0 an index scan with the limit returns, in
+// the direction of the scan
+static std::vector<int> LimitScan(storage::DataTable *table,
+                                  ScanDirectionType scan_direction,
+                                  size_t limit) {
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(0), {0}, {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO},
+      {ValueFactory::GetIntegerValue(0)}, {});
+  planner::IndexScanPlan node(table, nullptr, {0, 1}, index_scan_desc);
+  node.SetScanDirection(scan_direction);
+  node.SetLimit(limit);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<int> ids;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (auto tuple_id : *result_tile) {
+      ids.push_back(
+          ValuePeeker::PeekAsInteger(result_tile->GetValue(tuple_id, 0)));
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  std::sort(ids.begin(), ids.end());
+  if (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD) {
+    std::reverse(ids.begin(), ids.end());
+  }
+  return ids;
+}
+
+TEST_F(IndexScanTests, LimitScanTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(0));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < 10; id++) {
+    TransactionTestsUtil::ExecuteInsert(txn, table.get(), id, id * 10);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // The index is probed for the first entries in either direction only
+  EXPECT_EQ(std::vector<int>({0, 1, 2}),
+            LimitScan(table.get(), SCAN_DIRECTION_TYPE_FORWARD, 3));
+  EXPECT_EQ(std::vector<int>({9, 8, 7}),
+            LimitScan(table.get(), SCAN_DIRECTION_TYPE_BACKWARD, 3));
+  EXPECT_EQ(10, LimitScan(table.get(), SCAN_DIRECTION_TYPE_BACKWARD, 0).size());
+
+  // The entries of the deleted rows are still in the index, the scan probes
+  // it again until it has as many rows as its limit
+  txn = txn_manager.BeginTransaction();
+  for (int id = 5; id < 10; id++) {
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteDelete(txn, table.get(), id));
+  }
+  txn_manager.CommitTransaction(txn);
+
+  auto ids = LimitScan(table.get(), SCAN_DIRECTION_TYPE_BACKWARD, 3);
+  EXPECT_LE(3, ids.size());
+  ids.resize(3);
+  EXPECT_EQ(std::vector<int>({4, 3, 2}), ids);
+
+  // Unless there are not as many
+  EXPECT_EQ(std::vector<int>({4, 3, 2, 1, 0}),
+            LimitScan(table.get(), SCAN_DIRECTION_TYPE_BACKWARD, 8));
+}
+
 void ShowTable(std::string database_name, std::string table_name) {
   auto table = catalog::Bootstrapper::global_catalog->GetTableFromDatabase(
       database_name, table_name);
@@ -0,0 +1,201 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_index_join_test.cpp
+//
+// Identification: test/executor/nested_loop_index_join_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "planner/delete_plan.h"
+#include "planner/nested_loop_index_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Nested Loop Index Join Tests
+//===--------------------------------------------------------------------===//
+
+class NestedLoopIndexJoinTests : public PelotonTest {};
+
+static const int outer_tuple_count = 300;
+static const int inner_tuple_count = 200;
+
+static storage::DataTable *CreatePopulatedTable(int tuple_count) {
+  auto table = ExecutorTestsUtil::CreateTable(100, true);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+// OUTER.A, INNER.A, INNER.D of outer A joined with the given keys of the
+// inner index, the outer tile holding OUTER.A and OUTER.B
+static std::unique_ptr<planner::NestedLoopIndexJoinPlan> CreateJoinPlan(
+    PelotonJoinType join_type, storage::DataTable *outer_table,
+    storage::DataTable *inner_table, oid_t index_id,
+    const std::vector<oid_t> &key_column_ids,
+    const std::vector<oid_t> &outer_column_ids,
+    expression::AbstractExpression *predicate = nullptr) {
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::shared_ptr<const catalog::Schema> schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(3)}));
+
+  std::vector<ExpressionType> expr_types(key_column_ids.size(),
+                                         EXPRESSION_TYPE_COMPARE_EQUAL);
+  std::vector<Value> values(key_column_ids.size(),
+                            ValueFactory::GetNullValue());
+
+  std::unique_ptr<planner::NestedLoopIndexJoinPlan> plan(
+      new planner::NestedLoopIndexJoinPlan(
+          join_type,
+          std::unique_ptr<const expression::AbstractExpression>(predicate),
+          std::move(proj_info), schema, inner_table, {0, 3},
+          inner_table->GetIndex(index_id), key_column_ids, expr_types, values,
+          outer_column_ids));
+
+  std::unique_ptr<planner::SeqScanPlan> outer_scan(
+      new planner::SeqScanPlan(outer_table, nullptr, {0, 1}));
+  plan->AddChild(std::move(outer_scan));
+  return plan;
+}
+
+// Checks the joined rows, returns how many of them have an inner side
+static int RunJoin(const planner::AbstractPlan *plan, int expected_rows,
+                   const std::vector<Value> &params = {}) {
+  int rows = 0;
+  int matched_rows = 0;
+  bridge::PlanCursor cursor(plan, params);
+  while (cursor.Next()) {
+    auto tile = cursor.GetTile();
+    auto tuple_id = cursor.GetTupleId();
+    rows++;
+
+    auto inner_key = tile->GetValue(tuple_id, 1);
+    if (inner_key.IsNull()) {
+      EXPECT_TRUE(tile->GetValue(tuple_id, 2).IsNull());
+      continue;
+    }
+
+    int key = ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 0));
+    EXPECT_EQ(key, ValuePeeker::PeekAsInteger(inner_key));
+    EXPECT_EQ(std::to_string(key / 10 * 10 + 3),
+              ValuePeeker::PeekStringCopyWithoutNull(
+                  tile->GetValue(tuple_id, 2)));
+    matched_rows++;
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  EXPECT_EQ(expected_rows, rows);
+  return matched_rows;
+}
+
+TEST_F(NestedLoopIndexJoinTests, PrimaryKeyTest) {
+  std::unique_ptr<storage::DataTable> outer_table(
+      CreatePopulatedTable(outer_tuple_count));
+  std::unique_ptr<storage::DataTable> inner_table(
+      CreatePopulatedTable(inner_tuple_count));
+
+  auto inner_plan = CreateJoinPlan(JOIN_TYPE_INNER, outer_table.get(),
+                                   inner_table.get(), 0, {0}, {0});
+  EXPECT_EQ(inner_tuple_count, RunJoin(inner_plan.get(), inner_tuple_count));
+
+  // Outer tuples past the inner keys are joined with nulls
+  auto left_plan = CreateJoinPlan(JOIN_TYPE_LEFT, outer_table.get(),
+                                  inner_table.get(), 0, {0}, {0});
+  EXPECT_EQ(inner_tuple_count, RunJoin(left_plan.get(), outer_tuple_count));
+}
+
+TEST_F(NestedLoopIndexJoinTests, SecondaryIndexTest) {
+  std::unique_ptr<storage::DataTable> outer_table(
+      CreatePopulatedTable(outer_tuple_count));
+  std::unique_ptr<storage::DataTable> inner_table(
+      CreatePopulatedTable(inner_tuple_count));
+
+  // Point probes on both columns of the key
+  auto point_plan = CreateJoinPlan(JOIN_TYPE_INNER, outer_table.get(),
+                                   inner_table.get(), 1, {0, 1}, {0, 1});
+  EXPECT_EQ(inner_tuple_count, RunJoin(point_plan.get(), inner_tuple_count));
+
+  // Range probes on the first column, INNER.B < $0 checked on the inner
+  // tuple
+  const int limit = 50;
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 1, 1),
+      new expression::ParameterValueExpression(VALUE_TYPE_PARAMETER_OFFSET,
+                                               0));
+  auto range_plan = CreateJoinPlan(JOIN_TYPE_INNER, outer_table.get(),
+                                   inner_table.get(), 1, {0}, {0}, predicate);
+  EXPECT_EQ(limit, RunJoin(range_plan.get(), limit,
+                           {ValueFactory::GetIntegerValue(
+                               ExecutorTestsUtil::PopulatedValue(limit, 1))}));
+}
+
+TEST_F(NestedLoopIndexJoinTests, DeletedTuplesTest) {
+  std::unique_ptr<storage::DataTable> outer_table(
+      CreatePopulatedTable(outer_tuple_count));
+  std::unique_ptr<storage::DataTable> inner_table(
+      CreatePopulatedTable(inner_tuple_count));
+
+  // Delete the first deleted_count inner tuples, their index entries stay
+  const int deleted_count = 50;
+  {
+    auto predicate = expression::ExpressionUtil::ComparisonFactory(
+        EXPRESSION_TYPE_COMPARE_LESSTHAN,
+        expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+        expression::ExpressionUtil::ConstantValueFactory(
+            ValueFactory::GetIntegerValue(
+                ExecutorTestsUtil::PopulatedValue(deleted_count, 0))));
+    planner::DeletePlan delete_plan(inner_table.get(), false);
+    std::unique_ptr<planner::SeqScanPlan> scan(
+        new planner::SeqScanPlan(inner_table.get(), predicate, {0}));
+    delete_plan.AddChild(std::move(scan));
+
+    bridge::PlanCursor cursor(&delete_plan, {});
+    while (cursor.Next())
+      ;
+    auto status = cursor.Close();
+    EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+    EXPECT_EQ(deleted_count, status.m_processed);
+  }
+
+  auto inner_plan = CreateJoinPlan(JOIN_TYPE_INNER, outer_table.get(),
+                                   inner_table.get(), 0, {0}, {0});
+  EXPECT_EQ(inner_tuple_count - deleted_count,
+            RunJoin(inner_plan.get(), inner_tuple_count - deleted_count));
+
+  auto left_plan = CreateJoinPlan(JOIN_TYPE_LEFT, outer_table.get(),
+                                  inner_table.get(), 1, {0, 1}, {0, 1});
+  EXPECT_EQ(inner_tuple_count - deleted_count,
+            RunJoin(left_plan.get(), outer_tuple_count));
+}
+
+}  // End test namespace
+}  // End peloton namespace
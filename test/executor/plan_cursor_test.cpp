@@ -0,0 +1,256 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cursor_test.cpp
+//
+// Identification: test/executor/plan_cursor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/index_scan_plan.h"
+#include "planner/insert_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Cursor Tests
+//===--------------------------------------------------------------------===//
+
+class PlanCursorTests : public PelotonTest {};
+
+static const int tuples_per_tile_group = 5;
+static const int tile_group_count = 3;
+
+static storage::DataTable *CreatePopulatedTable() {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(
+      table.get(), tuples_per_tile_group * tile_group_count, false, false,
+      false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  return table.release();
+}
+
+TEST_F(PlanCursorTests, StreamTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+  planner::SeqScanPlan node(table.get(), nullptr, {0, 1});
+
+  bridge::PlanCursor cursor(&node, {});
+
+  // Rows arrive one tile group at a time
+  std::set<int> values;
+  while (cursor.Next()) {
+    auto tile = cursor.GetTile();
+    EXPECT_LE(tile->GetTupleCount(), tuples_per_tile_group);
+    values.insert(
+        tile->GetValue(cursor.GetTupleId(), 0).GetIntegerForTestsOnly());
+  }
+  EXPECT_EQ(tuples_per_tile_group * tile_group_count, values.size());
+  EXPECT_FALSE(cursor.Next());
+
+  auto status = cursor.Close();
+  EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+
+  // Closing again reports the same outcome
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+}
+
+TEST_F(PlanCursorTests, PartialFetchTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+  planner::SeqScanPlan node(table.get(), nullptr, {0});
+
+  // Fetch a few rows, then resume where the first batch stopped
+  std::unique_ptr<bridge::PlanCursor> cursor(new bridge::PlanCursor(&node, {}));
+  std::set<int> values;
+  for (int row = 0; row < 3; row++) {
+    ASSERT_TRUE(cursor->Next());
+    values.insert(cursor->GetTile()
+                      ->GetValue(cursor->GetTupleId(), 0)
+                      .GetIntegerForTestsOnly());
+  }
+  EXPECT_EQ(3, values.size());
+
+  while (cursor->Next()) {
+    values.insert(cursor->GetTile()
+                      ->GetValue(cursor->GetTupleId(), 0)
+                      .GetIntegerForTestsOnly());
+  }
+  EXPECT_EQ(tuples_per_tile_group * tile_group_count, values.size());
+
+  // Abandoning an open cursor still ends its transaction
+  cursor.reset(new bridge::PlanCursor(&node, {}));
+  EXPECT_TRUE(cursor->Next());
+  cursor.reset();
+}
+
+TEST_F(PlanCursorTests, SharedTransactionTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  const int base_count = tuples_per_tile_group * tile_group_count;
+
+  // Inserts of a batch run in the caller's transaction
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int tuple_itr = 0; tuple_itr < 2; tuple_itr++) {
+    planner::InsertPlan node(
+        table.get(),
+        ExecutorTestsUtil::GetTuple(table.get(), base_count + tuple_itr, pool));
+    bridge::PlanCursor cursor(&node, {}, txn);
+    while (cursor.Next());
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  }
+
+  // which stays open, later statements see the earlier ones
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn->GetResult());
+  planner::SeqScanPlan node(table.get(), nullptr, {0});
+  int count = 0;
+  bridge::PlanCursor scan_cursor(&node, {}, txn);
+  while (scan_cursor.Next()) count++;
+  EXPECT_EQ(Result::RESULT_SUCCESS, scan_cursor.Close().m_result);
+  EXPECT_EQ(base_count + 2, count);
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+TEST_F(PlanCursorTests, ReopenTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+
+  // Point lookup on the primary key : attr 0 = $1
+  auto index = table->GetIndex(0);
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+      {ValueFactory::GetBindingOnlyIntegerValue(0)}, {});
+  planner::IndexScanPlan node(table.get(), nullptr, {0, 1}, index_scan_desc);
+
+  bridge::PlanCursor cursor(&node, {ValueFactory::GetIntegerValue(20)});
+  EXPECT_TRUE(cursor.IsReusable());
+  ASSERT_TRUE(cursor.Next());
+  EXPECT_EQ(20, ValuePeeker::PeekInteger(
+                    cursor.GetTile()->GetValue(cursor.GetTupleId(), 0)));
+  EXPECT_FALSE(cursor.Next());
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+
+  // The same executor tree looks up other keys, parameters given as text
+  // are cast to the key type
+  for (auto param : {ValueFactory::GetIntegerValue(40),
+                     ValueFactory::GetStringValue("130")}) {
+    ASSERT_TRUE(cursor.Reopen({param}));
+    ASSERT_TRUE(cursor.Next());
+    EXPECT_EQ(param.CastAs(VALUE_TYPE_INTEGER).Compare(
+                  cursor.GetTile()->GetValue(cursor.GetTupleId(), 0)),
+              VALUE_COMPARE_EQUAL);
+    EXPECT_FALSE(cursor.Next());
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  }
+
+  // Missing keys and partial fetches
+  ASSERT_TRUE(cursor.Reopen({ValueFactory::GetIntegerValue(25)}));
+  EXPECT_FALSE(cursor.Next());
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  ASSERT_TRUE(cursor.Reopen({ValueFactory::GetIntegerValue(0)}));
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+
+  // The plan itself was never bound
+  EXPECT_EQ(VALUE_TYPE_PARAMETER_OFFSET, node.GetValues()[0].GetValueType());
+}
+
+TEST_F(PlanCursorTests, ParameterCastTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+
+  // attr 0 = $1, the parameter takes the column's type
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ParameterValueFactory(VALUE_TYPE_INVALID,
+                                                        0));
+  planner::SeqScanPlan node(table.get(), predicate, {0, 1});
+
+  // Untyped parameters arrive as text
+  bridge::PlanCursor cursor(&node, {ValueFactory::GetStringValue("20")});
+  for (auto key : {20, 130, 25}) {
+    if (key != 20) {
+      ASSERT_TRUE(cursor.Reopen(
+          {ValueFactory::GetStringValue(std::to_string(key))}));
+    }
+    int count = 0;
+    while (cursor.Next()) {
+      EXPECT_EQ(key, ValuePeeker::PeekInteger(cursor.GetTile()->GetValue(
+                         cursor.GetTupleId(), 0)));
+      count++;
+    }
+    EXPECT_EQ(key % 10 == 0 ? 1 : 0, count);
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  }
+}
+
+TEST_F(PlanCursorTests, ChildPredicateReopenTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+
+  // attr 0 = $1 over the tiles of a child scan
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ParameterValueFactory(VALUE_TYPE_INTEGER,
+                                                        0));
+  planner::SeqScanPlan node(nullptr, predicate, {});
+  node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+
+  // Each execution evaluates the predicate with its own parameters
+  bridge::PlanCursor cursor(&node, {ValueFactory::GetIntegerValue(20)});
+  EXPECT_TRUE(cursor.IsReusable());
+  for (auto key : {20, 70, 140}) {
+    if (key != 20) {
+      ASSERT_TRUE(cursor.Reopen({ValueFactory::GetIntegerValue(key)}));
+    }
+    int count = 0;
+    while (cursor.Next()) {
+      EXPECT_EQ(key, ValuePeeker::PeekInteger(cursor.GetTile()->GetValue(
+                         cursor.GetTupleId(), 0)));
+      count++;
+    }
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  }
+}
+
+TEST_F(PlanCursorTests, ExecutorPoolResetTest) {
+  executor::ExecutorContext context(nullptr, {});
+  auto initial_memory = context.GetExecutorContextPool()->GetAllocatedMemory();
+
+  // Values of an execution are freed when the context is reset for the next
+  context.GetExecutorContextPool()->Allocate(1 << 20);
+  EXPECT_LT(initial_memory,
+            context.GetExecutorContextPool()->GetAllocatedMemory());
+  context.Reset(nullptr, {ValueFactory::GetIntegerValue(1)});
+  EXPECT_EQ(initial_memory,
+            context.GetExecutorContextPool()->GetAllocatedMemory());
+}
+
+}  // End test namespace
+}  // End peloton namespace
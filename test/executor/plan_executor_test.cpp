@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_executor_test.cpp
+//
+// Identification: test/executor/plan_executor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "planner/insert_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "tcop/tcop.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Executor Tests
+//===--------------------------------------------------------------------===//
+
+class PlanExecutorTests : public PelotonTest {};
+
+static const int tuples_per_tile_group = 5;
+
+// Rows of the table visible to txn, or to a transaction of its own
+static int CountTuples(storage::DataTable *table,
+                       concurrency::Transaction *txn) {
+  planner::SeqScanPlan node(table, nullptr, {0});
+  bridge::PlanCursor cursor(&node, {}, txn);
+  int count = 0;
+  while (cursor.Next()) count++;
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  return count;
+}
+
+TEST_F(PlanExecutorTests, ExplicitTransactionTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group));
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  auto &tcop = tcop::TrafficCop::GetInstance();
+
+  // BEGIN; INSERT; INSERT;
+  auto txn = tcop.BeginTransaction();
+  for (int tuple_itr = 0; tuple_itr < 2; tuple_itr++) {
+    planner::InsertPlan node(
+        table.get(), ExecutorTestsUtil::GetTuple(table.get(), tuple_itr, pool));
+    std::vector<ResultType> result;
+    auto status = bridge::PlanExecutor::ExecutePlan(&node, {}, result, txn);
+    EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+    EXPECT_EQ(1, status.m_processed);
+  }
+
+  // Nothing is committed before COMMIT
+  EXPECT_EQ(2, CountTuples(table.get(), txn));
+  EXPECT_EQ(0, CountTuples(table.get(), nullptr));
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, tcop.CommitTransaction(txn));
+  EXPECT_EQ(2, CountTuples(table.get(), nullptr));
+
+  // A failed transaction can only be rolled back
+  txn = tcop.BeginTransaction();
+  planner::InsertPlan node(
+      table.get(), ExecutorTestsUtil::GetTuple(table.get(), 2, pool));
+  std::vector<ResultType> result;
+  bridge::PlanExecutor::ExecutePlan(&node, {}, result, txn);
+  txn->SetResult(Result::RESULT_FAILURE);
+  EXPECT_EQ(Result::RESULT_ABORTED, tcop.CommitTransaction(txn));
+  EXPECT_EQ(2, CountTuples(table.get(), nullptr));
+}
+
+}  // End test namespace
+}  // End peloton namespace
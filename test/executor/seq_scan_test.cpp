@@ -314,6 +314,56 @@ TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
 
   txn_manager.CommitTransaction(txn);
 }
+
+TEST_F(SeqScanTests, ZoneMapSkipTest) {
+  const int tuples_per_tile_group = 10;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 5 * tuples_per_tile_group,
+                                   false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // COL_A >= 350 AND 420 > COL_A matches rows 35 to 41, which live in the
+  // fourth and fifth tile groups
+  auto predicate = expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(
+                  ExecutorTestsUtil::PopulatedValue(35, 0)))),
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(
+                  ExecutorTestsUtil::PopulatedValue(42, 0))),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0)));
+
+  std::vector<oid_t> column_ids({0, 1});
+  planner::SeqScanPlan node(table.get(), predicate, column_ids);
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(7, result_tuple_count);
+  EXPECT_EQ(table->GetTileGroupCount() - 2, context->num_tile_groups_skipped);
+}
 }
 
 }  // namespace test
@@ -0,0 +1,285 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/expression/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "expression/string_expression.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Tests
+//===--------------------------------------------------------------------===//
+
+class CompiledExpressionTests : public PelotonTest {};
+
+static const int tuple_count = 50;
+
+// Check that the compiled program agrees with the interpreter on every row
+static void CheckAgainstInterpreter(expression::AbstractExpression *expr,
+                                    storage::TileGroup *tile_group) {
+  auto program = expression::CompiledExpression::Compile(
+      expr, expression::CompiledExpression::GetColumnTypes(tile_group), {},
+      nullptr);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_TRUE(program->Bind(0, tile_group));
+  EXPECT_EQ(expr->GetValueType() == VALUE_TYPE_BOOLEAN,
+            program->GetValueType() == VALUE_TYPE_BOOLEAN);
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+    Value expected = expr->Evaluate(&tuple, nullptr, nullptr);
+    Value actual = program->EvaluateValue(tuple_id);
+
+    EXPECT_EQ(expected.IsNull(), actual.IsNull());
+    // booleans don't support Value::Compare(), they are checked below
+    if (!expected.IsNull() && program->GetValueType() != VALUE_TYPE_BOOLEAN) {
+      EXPECT_EQ(VALUE_COMPARE_EQUAL, expected.Compare(actual));
+    }
+    if (program->GetValueType() == VALUE_TYPE_BOOLEAN) {
+      EXPECT_EQ(expected.IsTrue(), program->EvaluatesTrue(tuple_id));
+      EXPECT_EQ(expected.IsFalse(), program->EvaluatesFalse(tuple_id));
+    }
+  }
+}
+
+TEST_F(CompiledExpressionTests, PredicateTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  // COL_A < 200 AND COL_C >= 52.0
+  std::unique_ptr<expression::AbstractExpression> range(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LESSTHAN,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            0, 0),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(200))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_DOUBLE,
+                                                            0, 2),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetDoubleValue(52.0)))));
+  CheckAgainstInterpreter(range.get(), tile_group.get());
+
+  // COL_D = '123' OR COL_B <> 41
+  std::unique_ptr<expression::AbstractExpression> disjunction(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_OR,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_EQUAL,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetStringValue("123"))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            0, 1),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(41)))));
+  CheckAgainstInterpreter(disjunction.get(), tile_group.get());
+
+  // COL_D > '2' compares lengths first, like Value::Compare
+  std::unique_ptr<expression::AbstractExpression> strings(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetStringValue("2"))));
+  CheckAgainstInterpreter(strings.get(), tile_group.get());
+}
+
+TEST_F(CompiledExpressionTests, StringTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  // COL_D LIKE '1%3' OR COL_D NOT LIKE '%03'
+  std::unique_ptr<expression::AbstractExpression> like(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_OR,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LIKE,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetStringValue("1%3"))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_NOTLIKE,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetStringValue("%03")))));
+  CheckAgainstInterpreter(like.get(), tile_group.get());
+
+  // CHAR_LENGTH(COL_D) > 2
+  std::unique_ptr<expression::AbstractExpression> length(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+          new expression::CharLengthExpression(
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3)),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(2))));
+  CheckAgainstInterpreter(length.get(), tile_group.get());
+
+  // SUBSTRING(COL_D FROM 2 FOR 2)
+  std::unique_ptr<expression::AbstractExpression> substring(
+      new expression::SubstringExpression(
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(2)),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(2))));
+  CheckAgainstInterpreter(substring.get(), tile_group.get());
+}
+
+TEST_F(CompiledExpressionTests, ArithmeticTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  // COL_A * 3 - COL_B
+  std::unique_ptr<expression::AbstractExpression> int_expr(
+      expression::ExpressionUtil::OperatorFactory(
+          EXPRESSION_TYPE_OPERATOR_MINUS, VALUE_TYPE_BIGINT,
+          expression::ExpressionUtil::OperatorFactory(
+              EXPRESSION_TYPE_OPERATOR_MULTIPLY, VALUE_TYPE_BIGINT,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            0, 0),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(3))),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        1)));
+  CheckAgainstInterpreter(int_expr.get(), tile_group.get());
+
+  // COL_C + COL_A promotes to double
+  std::unique_ptr<expression::AbstractExpression> double_expr(
+      expression::ExpressionUtil::OperatorFactory(
+          EXPRESSION_TYPE_OPERATOR_PLUS, VALUE_TYPE_DOUBLE,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_DOUBLE, 0,
+                                                        2),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0)));
+  CheckAgainstInterpreter(double_expr.get(), tile_group.get());
+}
+
+TEST_F(CompiledExpressionTests, LogicalTileJoinTest) {
+  auto left_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(left_group, tuple_count);
+  auto right_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(right_group, tuple_count);
+
+  std::unique_ptr<executor::LogicalTile> left_tile(
+      executor::LogicalTileFactory::WrapTileGroup(left_group));
+  std::unique_ptr<executor::LogicalTile> right_tile(
+      executor::LogicalTileFactory::WrapTileGroup(right_group));
+
+  // Skip some rows so that positions differ from tile offsets
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id += 3) {
+    right_tile->RemoveVisibility(tuple_id);
+  }
+
+  // left.COL_A = right.COL_B - 1
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_EQUAL,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0),
+          expression::ExpressionUtil::OperatorFactory(
+              EXPRESSION_TYPE_OPERATOR_MINUS, VALUE_TYPE_BIGINT,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            1, 1),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(1)))));
+
+  auto program = expression::CompiledExpression::Compile(
+      predicate.get(),
+      expression::CompiledExpression::GetColumnTypes(left_tile.get()),
+      expression::CompiledExpression::GetColumnTypes(right_tile.get()),
+      nullptr);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_TRUE(program->Bind(0, left_tile.get()));
+  ASSERT_TRUE(program->Bind(1, right_tile.get()));
+
+  size_t match_count = 0;
+  for (oid_t right_id : *right_tile) {
+    for (oid_t left_id : *left_tile) {
+      expression::ContainerTuple<executor::LogicalTile> left_tuple(
+          left_tile.get(), left_id);
+      expression::ContainerTuple<executor::LogicalTile> right_tuple(
+          right_tile.get(), right_id);
+      bool expected =
+          predicate->Evaluate(&left_tuple, &right_tuple, nullptr).IsTrue();
+      EXPECT_EQ(expected, program->EvaluatesTrue(left_id, right_id));
+      if (expected) match_count++;
+    }
+  }
+
+  // Every visible right row matches the left row with the same id
+  EXPECT_EQ(right_tile->GetTupleCount(), match_count);
+}
+
+TEST_F(CompiledExpressionTests, UnsupportedTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  auto column_types =
+      expression::CompiledExpression::GetColumnTypes(tile_group.get());
+
+  // LIKE with a pattern that changes per row is left to the interpreter
+  std::unique_ptr<expression::AbstractExpression> like(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_LIKE,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3)));
+  EXPECT_TRUE(expression::CompiledExpression::Compile(like.get(), column_types,
+                                                      {}, nullptr) == nullptr);
+
+  // Comparing an integer with a string
+  std::unique_ptr<expression::AbstractExpression> mismatch(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_EQUAL,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3)));
+  EXPECT_TRUE(expression::CompiledExpression::Compile(
+                  mismatch.get(), column_types, {}, nullptr) == nullptr);
+
+  // Column beyond the input
+  std::unique_ptr<expression::AbstractExpression> out_of_range(
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                    10));
+  EXPECT_TRUE(expression::CompiledExpression::Compile(
+                  out_of_range.get(), column_types, {}, nullptr) == nullptr);
+}
+
+}  // End test namespace
+}  // End peloton namespace
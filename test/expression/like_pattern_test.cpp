@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_pattern_test.cpp
+//
+// Identification: test/expression/like_pattern_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "expression/like_pattern.h"
+#include "expression/string_kernels.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Like Pattern Tests
+//===--------------------------------------------------------------------===//
+
+class LikePatternTests : public PelotonTest {};
+
+TEST_F(LikePatternTests, KindTest) {
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_EXACT,
+            expression::LikePattern("abc").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_EXACT,
+            expression::LikePattern("").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_PREFIX,
+            expression::LikePattern("abc%").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_SUFFIX,
+            expression::LikePattern("%%abc").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_CONTAINS,
+            expression::LikePattern("%abc%").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_ANY,
+            expression::LikePattern("%%").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_GENERAL,
+            expression::LikePattern("a%c").GetKind());
+  EXPECT_EQ(expression::LikePattern::LIKE_MATCH_GENERAL,
+            expression::LikePattern("a_c%").GetKind());
+}
+
+// Every pattern must agree with Value::Like on every value
+TEST_F(LikePatternTests, AgreesWithValueLikeTest) {
+  std::vector<std::string> patterns = {
+      "", "%", "%%", "_", "__", "a", "abc", "abc%", "%abc", "%abc%", "a%",
+      "%a", "%a%", "a%c", "a%b%c", "%b%c", "a_c", "_b_", "%_c", "a%_",
+      "%ab%ab%", "ab%ab", "ab%ba%ab", "%\xc3\xa9%", "_\xc3\xa9", "\xc3\xa9_",
+      "%x_z%", "%%a%%b%%", "a__%", "%b"};
+  std::vector<std::string> values = {
+      "", "a", "b", "c", "ab", "abc", "abcd", "xabc", "xabcx", "abcabc", "ac",
+      "aXc", "aXXc", "abab", "ababab", "abba", "ab ab", "\xc3\xa9",
+      "x\xc3\xa9", "\xc3\xa9x", "a\xc3\xa9", "xyz", "xaz", "aaab", "bbbb",
+      "cab", "acb"};
+
+  for (auto &pattern : patterns) {
+    expression::LikePattern compiled(pattern);
+    Value pattern_value = ValueFactory::GetStringValue(pattern);
+    for (auto &value : values) {
+      Value value_value = ValueFactory::GetStringValue(value);
+      bool expected = value_value.Like(pattern_value).IsTrue();
+      EXPECT_EQ(expected, compiled.Match(value.data(), value.size()))
+          << "'" << value << "' LIKE '" << pattern << "'";
+    }
+  }
+}
+
+TEST_F(LikePatternTests, StringKernelsTest) {
+  // 'h', e-acute, 'llo', a three byte code point and "abcdefgh"
+  std::string value = "h\xc3\xa9llo\xe2\x82\xac" "abcdefgh";
+  EXPECT_EQ(14, expression::StringKernels::CharLength(value.data(),
+                                                      value.size()));
+
+  const char *result;
+  int32_t result_length;
+  expression::StringKernels::Substring(value.data(), value.size(), 2, 4,
+                                       &result, &result_length);
+  EXPECT_EQ("\xc3\xa9llo", std::string(result, result_length));
+
+  // a start before 1 shortens the result
+  expression::StringKernels::Substring(value.data(), value.size(), -1, 4,
+                                       &result, &result_length);
+  EXPECT_EQ("h\xc3\xa9", std::string(result, result_length));
+
+  expression::StringKernels::SubstringFrom(value.data(), value.size(), 7,
+                                           &result, &result_length);
+  EXPECT_EQ("abcdefgh", std::string(result, result_length));
+
+  std::string folded(value);
+  expression::StringKernels::FoldUpper(folded.data(), folded.size(),
+                                       &folded[0]);
+  EXPECT_EQ("H\xc3\xa9LLO\xe2\x82\xac" "ABCDEFGH", folded);
+  expression::StringKernels::FoldLower(folded.data(), folded.size(),
+                                       &folded[0]);
+  EXPECT_EQ(value, folded);
+}
+
+}  // End test namespace
+}  // End peloton namespace
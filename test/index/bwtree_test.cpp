@@ -0,0 +1,232 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bwtree_test.cpp
+//
+// Identification: test/index/bwtree_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include "index/bwtree.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// BwTree Tests
+//===--------------------------------------------------------------------===//
+
+class BwTreeTests : public PelotonTest {};
+
+// Trees are allocated on the heap, the free NodeID stack alone is larger
+// than a thread's stack
+typedef index::BwTree<int64_t, int64_t> TestBwTree;
+
+// Nodes retired to the epoch manager of the tree and not reclaimed yet
+static size_t GetGarbageCount(TestBwTree &tree) {
+  auto &epoch_manager = tree.epoch_manager;
+
+  // No round of GC changes the epochs meanwhile
+  std::lock_guard<std::mutex> lock{epoch_manager.gc_mutex};
+
+  size_t garbage_count = 0;
+  for (auto epoch_p = epoch_manager.head_epoch_p; epoch_p != nullptr;
+       epoch_p = epoch_p->next_p) {
+    for (auto garbage_p = epoch_p->garbage_list_p.load(); garbage_p != nullptr;
+         garbage_p = garbage_p->next_p) {
+      garbage_count++;
+    }
+  }
+  return garbage_count;
+}
+
+// Wait for a few rounds of the shared garbage collector
+static bool WaitForGarbageCount(TestBwTree &tree, size_t garbage_count) {
+  for (int wait_itr = 0; wait_itr < 1000; wait_itr++) {
+    if (GetGarbageCount(tree) == garbage_count) return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+TEST_F(BwTreeTests, GarbageCollectorRegistrationTest) {
+  auto &garbage_collector = index::GarbageCollector::GetInstance();
+  size_t registered_count = garbage_collector.GetRegisteredCount();
+
+  // Every tree collected in the background registers with the one thread
+  std::vector<std::unique_ptr<TestBwTree>> trees;
+  for (int tree_itr = 0; tree_itr < 8; tree_itr++) {
+    trees.emplace_back(new TestBwTree(true));
+  }
+  EXPECT_EQ(registered_count + 8, garbage_collector.GetRegisteredCount());
+  EXPECT_EQ(1, garbage_collector.GetThreadCount());
+
+  // Unless it collects its own garbage
+  std::unique_ptr<TestBwTree> own_tree(new TestBwTree(false));
+  EXPECT_EQ(registered_count + 8, garbage_collector.GetRegisteredCount());
+
+  // Trees unregister when they are freed, while the collector runs
+  trees.resize(4);
+  EXPECT_EQ(registered_count + 4, garbage_collector.GetRegisteredCount());
+  trees.clear();
+  EXPECT_EQ(registered_count, garbage_collector.GetRegisteredCount());
+
+  // Trees created, written and freed by several threads at once
+  std::vector<std::thread> threads;
+  for (int thread_itr = 0; thread_itr < 4; thread_itr++) {
+    threads.emplace_back([] {
+      for (int tree_itr = 0; tree_itr < 20; tree_itr++) {
+        std::unique_ptr<TestBwTree> tree(new TestBwTree(true));
+        for (int64_t key = 0; key < 1000; key++) {
+          tree->Insert(key, key);
+        }
+        for (int64_t key = 0; key < 1000; key += 2) {
+          tree->Delete(key, key);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(registered_count, garbage_collector.GetRegisteredCount());
+  EXPECT_EQ(1, garbage_collector.GetThreadCount());
+}
+
+TEST_F(BwTreeTests, GarbageCollectionTest) {
+  std::unique_ptr<TestBwTree> tree_p(new TestBwTree(false));
+  auto &tree = *tree_p;
+
+  // Consolidations, splits and merges retire nodes
+  const int64_t key_count = 10000;
+  for (int64_t key = 0; key < key_count; key++) {
+    EXPECT_TRUE(tree.Insert(key, key));
+  }
+  for (int64_t key = 0; key < key_count; key++) {
+    if (key % 4 != 0) EXPECT_TRUE(tree.Delete(key, key));
+  }
+  EXPECT_GT(GetGarbageCount(tree), 0);
+
+  // Nothing collects them until the tree registers
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+      2 * index::GarbageCollector::GC_INTERVAL));
+  EXPECT_GT(GetGarbageCount(tree), 0);
+
+  tree.epoch_manager.RegisterCollector();
+  EXPECT_TRUE(WaitForGarbageCount(tree, 0));
+
+  // The nodes still in the tree are left alone
+  std::vector<int64_t> values;
+  for (int64_t key = 0; key < key_count; key++) {
+    values.clear();
+    tree.GetValue(key, values);
+    if (key % 4 == 0) {
+      EXPECT_EQ(std::vector<int64_t>({key}), values);
+    } else {
+      EXPECT_TRUE(values.empty());
+    }
+  }
+
+  // Reads retire nothing
+  EXPECT_TRUE(WaitForGarbageCount(tree, 0));
+}
+
+TEST_F(BwTreeTests, MappingTableSegmentTest) {
+  TestBwTree::MappingTable mapping_table;
+  const size_t segment_size = MAPPING_TABLE_SEGMENT_SIZE;
+  const size_t segment_footprint = sizeof(TestBwTree::MappingTable::Segment);
+  const size_t table_footprint = sizeof(TestBwTree::MappingTable);
+  EXPECT_EQ(table_footprint, mapping_table.GetMemoryFootprint());
+
+  // Fake nodes, the table never follows the pointers
+  auto node = [](NodeID node_id) {
+    return reinterpret_cast<const TestBwTree::BaseNode *>(node_id + 1);
+  };
+
+  // The last entry of a segment and the first one of the next
+  mapping_table[segment_size - 1] = node(segment_size - 1);
+  EXPECT_EQ(table_footprint + segment_footprint,
+            mapping_table.GetMemoryFootprint());
+  mapping_table[segment_size] = node(segment_size);
+  EXPECT_EQ(table_footprint + 2 * segment_footprint,
+            mapping_table.GetMemoryFootprint());
+  EXPECT_EQ(node(segment_size - 1), mapping_table[segment_size - 1].load());
+  EXPECT_EQ(node(segment_size), mapping_table[segment_size].load());
+  EXPECT_TRUE(mapping_table[segment_size + 1].load() == nullptr);
+
+  // The last segment
+  mapping_table[MAPPING_TABLE_SIZE - 1] = node(MAPPING_TABLE_SIZE - 1);
+  EXPECT_EQ(table_footprint + 3 * segment_footprint,
+            mapping_table.GetMemoryFootprint());
+
+  // Threads racing to allocate the same segments install one each
+  const size_t thread_count = 4;
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back([&mapping_table, &node, thread_itr, segment_size] {
+      for (NodeID node_id = 2 * segment_size + thread_itr;
+           node_id < 10 * segment_size; node_id += thread_count) {
+        mapping_table[node_id] = node(node_id);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(table_footprint + 11 * segment_footprint,
+            mapping_table.GetMemoryFootprint());
+  for (NodeID node_id = 2 * segment_size; node_id < 10 * segment_size;
+       node_id++) {
+    EXPECT_EQ(node(node_id), mapping_table[node_id].load());
+  }
+}
+
+TEST_F(BwTreeTests, MappingTableGrowthTest) {
+  std::unique_ptr<TestBwTree> tree_p(new TestBwTree(false));
+  auto &tree = *tree_p;
+  size_t segment_footprint = sizeof(TestBwTree::MappingTable::Segment);
+  size_t table_footprint = sizeof(TestBwTree::MappingTable);
+
+  // A small tree only touches the first segment
+  for (int64_t key = 0; key < 1000; key++) {
+    tree.Insert(key, key);
+  }
+  EXPECT_LT(tree.next_unused_node_id.load(), MAPPING_TABLE_SEGMENT_SIZE);
+  EXPECT_EQ(table_footprint + segment_footprint,
+            tree.mapping_table.GetMemoryFootprint());
+
+  // Enough leaves for NodeIDs to span a few segments
+  const int64_t key_count = 1 << 19;
+  for (int64_t key = 1000; key < key_count; key++) {
+    tree.Insert(key, key);
+  }
+  NodeID next_node_id = tree.next_unused_node_id.load();
+  EXPECT_GT(next_node_id, 2 * MAPPING_TABLE_SEGMENT_SIZE);
+  EXPECT_EQ(table_footprint +
+                ((next_node_id - 1) / MAPPING_TABLE_SEGMENT_SIZE + 1) *
+                    segment_footprint,
+            tree.mapping_table.GetMemoryFootprint());
+
+  // Every key is reached through nodes on both sides of the boundaries
+  std::vector<int64_t> values;
+  for (int64_t key = 0; key < key_count; key++) {
+    values.clear();
+    tree.GetValue(key, values);
+    EXPECT_EQ(1, values.size());
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -13,11 +13,20 @@
 #include "gtest/gtest.h"
 #include "common/harness.h"
 
+#include "catalog/manager.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "index/bwtree_index.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "storage/tuple.h"
 
+#include "executor/executor_tests_util.h"
+
 namespace peloton {
 namespace test {
 
@@ -962,5 +971,495 @@ TEST_F(IndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   delete tuple_schema;
 }
 
+/*
+ * BuildTableIndex() - Builds an index on column A of a table
+ */
+static index::Index *BuildTableIndex(storage::DataTable *table,
+                                     IndexType table_index_type,
+                                     const bool unique_keys) {
+  std::vector<oid_t> key_attrs = {0};
+  auto table_key_schema =
+      catalog::Schema::CopySchema(table->GetSchema(), key_attrs);
+  table_key_schema->SetIndexedColumns(key_attrs);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "bulk_load_index", 126, table_index_type,
+      unique_keys ? INDEX_CONSTRAINT_TYPE_PRIMARY_KEY
+                  : INDEX_CONSTRAINT_TYPE_DEFAULT,
+      table->GetSchema(), table_key_schema, key_attrs, unique_keys);
+
+  return index::IndexFactory::GetInstance(index_metadata);
+}
+
+/*
+ * GetColumnA() - Returns column A of the tuple at a location
+ */
+static int GetColumnA(const ItemPointer *location) {
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(location->block);
+  return ValuePeeker::PeekAsInteger(tile_group->GetValue(location->offset, 0));
+}
+
+/*
+ * ScanColumnA() - Returns the number of entries of an index on column A
+ * with the given value
+ */
+static size_t ScanColumnA(index::Index *index, int value) {
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(value), nullptr);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key.get(), location_ptrs);
+  return location_ptrs.size();
+}
+
+/*
+ * BulkLoadTableIndex() - Bulk loads the tuples of a table into an index
+ *
+ * The tile groups are dealt to the runs in turn, so the runs overlap. The
+ * index owns the locations once they are loaded.
+ */
+static bool BulkLoadTableIndex(storage::DataTable *table,
+                               index::Index *index) {
+  const size_t run_count = 3;
+  std::vector<std::vector<ItemPointer *>> runs(run_count);
+
+  for (oid_t tile_group_offset = 0;
+       tile_group_offset < table->GetTileGroupCount(); tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      runs[tile_group_offset % run_count].push_back(
+          new ItemPointer(tile_group->GetTileGroupId(), tuple_id));
+    }
+  }
+
+  if (index->BulkLoad(runs) == false) {
+    for (auto &run : runs) {
+      for (auto location : run) {
+        delete location;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+TEST_F(IndexTests, BulkLoadTest) {
+  // Enough tuples for the BwTree to need two levels of inner nodes
+  const int tuple_count = 20000;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Column A is unique in the first table, and has two values in the other
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(1000, false));
+  std::unique_ptr<storage::DataTable> group_by_table(
+      ExecutorTestsUtil::CreateTable(1000, false));
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  ExecutorTestsUtil::PopulateTable(group_by_table.get(), tuple_count, false,
+                                   false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  for (auto table_index_type : {INDEX_TYPE_BTREE, INDEX_TYPE_BWTREE}) {
+    std::vector<ItemPointer *> location_ptrs;
+
+    // Every tuple once, in key order
+    std::unique_ptr<index::Index> index(
+        BuildTableIndex(table.get(), table_index_type, true));
+    EXPECT_TRUE(BulkLoadTableIndex(table.get(), index.get()));
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(tuple_count, location_ptrs.size());
+    for (size_t location_itr = 0; location_itr < location_ptrs.size();
+         location_itr++) {
+      EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(location_itr, 0),
+                GetColumnA(location_ptrs[location_itr]));
+    }
+    location_ptrs.clear();
+
+    EXPECT_EQ(1, ScanColumnA(index.get(),
+                             ExecutorTestsUtil::PopulatedValue(12345, 0)));
+
+    // Only empty indexes are bulk loaded, but inserts still work
+    EXPECT_FALSE(BulkLoadTableIndex(table.get(), index.get()));
+    {
+      std::unique_ptr<storage::Tuple> key(
+          new storage::Tuple(index->GetKeySchema(), true));
+      key->SetValue(0, ValueFactory::GetIntegerValue(-1), nullptr);
+      EXPECT_TRUE(index->InsertEntry(key.get(), ItemPointer(0, 0)));
+    }
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(tuple_count + 1, location_ptrs.size());
+    location_ptrs.clear();
+
+    // Duplicate keys violate the unique index, which is left empty
+    index.reset(BuildTableIndex(group_by_table.get(), table_index_type, true));
+    EXPECT_FALSE(BulkLoadTableIndex(group_by_table.get(), index.get()));
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(0, location_ptrs.size());
+
+    // Each key holds half of the tuples, whatever nodes they span
+    index.reset(
+        BuildTableIndex(group_by_table.get(), table_index_type, false));
+    EXPECT_TRUE(BulkLoadTableIndex(group_by_table.get(), index.get()));
+    for (int group_itr = 0; group_itr < 2; group_itr++) {
+      EXPECT_EQ(tuple_count / 2,
+                ScanColumnA(index.get(),
+                            ExecutorTestsUtil::PopulatedValue(group_itr, 0)));
+    }
+  }
+}
+
+/*
+ * ScanTestColumnA() - Returns column A of the entries of an index on column
+ * A satisfying the predicate, in the order of the scan
+ */
+static std::vector<int> ScanTestColumnA(
+    index::Index *index, const std::vector<Value> &value_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, size_t limit) {
+  std::vector<oid_t> tuple_column_id_list(value_list.size(), 0);
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanTest(value_list, tuple_column_id_list, expr_list, scan_direction,
+                  location_ptrs, limit);
+
+  std::vector<int> values;
+  for (auto location : location_ptrs) {
+    values.push_back(GetColumnA(location));
+  }
+  return values;
+}
+
+TEST_F(IndexTests, ReverseScanTest) {
+  // Enough tuples for the BwTree to have many leaf nodes
+  const int tuple_count = 20000;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(1000, false));
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto value = [](int tuple_itr) {
+    return ExecutorTestsUtil::PopulatedValue(tuple_itr, 0);
+  };
+  auto integer_value = [&value](int tuple_itr) {
+    return ValueFactory::GetIntegerValue(value(tuple_itr));
+  };
+
+  for (auto table_index_type : {INDEX_TYPE_BTREE, INDEX_TYPE_BWTREE}) {
+    // Inserted from the last tuple on, so the nodes are split and carry
+    // delta records rather than being bulk loaded
+    std::unique_ptr<index::Index> index(
+        BuildTableIndex(table.get(), table_index_type, true));
+    {
+      std::unique_ptr<storage::Tuple> key(
+          new storage::Tuple(index->GetKeySchema(), true));
+      for (oid_t tile_group_offset = table->GetTileGroupCount();
+           tile_group_offset-- > 0;) {
+        auto tile_group = table->GetTileGroup(tile_group_offset);
+        for (oid_t tuple_id = tile_group->GetNextTupleSlot(); tuple_id-- > 0;) {
+          key->SetValue(0, tile_group->GetValue(tuple_id, 0), nullptr);
+          EXPECT_TRUE(index->InsertEntry(
+              key.get(), ItemPointer(tile_group->GetTileGroupId(), tuple_id)));
+        }
+      }
+    }
+
+    // Every tuple once, in descending key order
+    std::vector<Value> all = {integer_value(0)};
+    std::vector<ExpressionType> all_exprs = {
+        EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO};
+    auto values = ScanTestColumnA(index.get(), all, all_exprs,
+                                  SCAN_DIRECTION_TYPE_BACKWARD, 0);
+    EXPECT_EQ(tuple_count, values.size());
+    for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+      EXPECT_EQ(value(tuple_count - 1 - value_itr), values[value_itr]);
+    }
+
+    // Top 10
+    values = ScanTestColumnA(index.get(), all, all_exprs,
+                             SCAN_DIRECTION_TYPE_BACKWARD, 10);
+    EXPECT_EQ(10, values.size());
+    for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+      EXPECT_EQ(value(tuple_count - 1 - value_itr), values[value_itr]);
+    }
+
+    // A bounded range in both directions, with and without a limit
+    std::vector<Value> range = {integer_value(5000), integer_value(5999)};
+    std::vector<ExpressionType> range_exprs = {
+        EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+        EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO};
+    values = ScanTestColumnA(index.get(), range, range_exprs,
+                             SCAN_DIRECTION_TYPE_BACKWARD, 0);
+    EXPECT_EQ(1000, values.size());
+    for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+      EXPECT_EQ(value(5999 - value_itr), values[value_itr]);
+    }
+
+    values = ScanTestColumnA(index.get(), range, range_exprs,
+                             SCAN_DIRECTION_TYPE_BACKWARD, 5);
+    EXPECT_EQ(std::vector<int>({value(5999), value(5998), value(5997),
+                                value(5996), value(5995)}),
+              values);
+
+    values = ScanTestColumnA(index.get(), range, range_exprs,
+                             SCAN_DIRECTION_TYPE_FORWARD, 3);
+    EXPECT_EQ(std::vector<int>({value(5000), value(5001), value(5002)}),
+              values);
+
+    // Keys lower than the first one, and a point query
+    values = ScanTestColumnA(index.get(), {integer_value(0)},
+                             {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+                             SCAN_DIRECTION_TYPE_BACKWARD, 10);
+    EXPECT_EQ(0, values.size());
+
+    values = ScanTestColumnA(index.get(), {integer_value(1234)},
+                             {EXPRESSION_TYPE_COMPARE_EQUAL},
+                             SCAN_DIRECTION_TYPE_BACKWARD, 1);
+    EXPECT_EQ(std::vector<int>({value(1234)}), values);
+  }
+}
+
+/*
+ * BuildIntsColumns() - Returns a column of each of the given types
+ */
+static std::vector<catalog::Column> BuildIntsColumns(
+    const std::vector<ValueType> &types) {
+  std::vector<catalog::Column> column_list;
+  for (oid_t column_itr = 0; column_itr < types.size(); column_itr++) {
+    bool is_inlined = (types[column_itr] != VALUE_TYPE_VARCHAR);
+    column_list.emplace_back(
+        types[column_itr],
+        is_inlined ? GetTypeSize(types[column_itr]) : 64,
+        "C" + std::to_string(column_itr), is_inlined);
+  }
+  return column_list;
+}
+
+/*
+ * BuildIntsIndex() - Builds an index on columns of the given types, the key
+ * being the whole tuple
+ */
+static index::Index *BuildIntsIndex(IndexType ints_index_type,
+                                    const std::vector<ValueType> &types) {
+  std::vector<oid_t> key_attrs;
+  for (oid_t column_itr = 0; column_itr < types.size(); column_itr++) {
+    key_attrs.push_back(column_itr);
+  }
+  auto ints_key_schema = new catalog::Schema(BuildIntsColumns(types));
+  ints_key_schema->SetIndexedColumns(key_attrs);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "ints_index", 127, ints_index_type, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      ints_key_schema, ints_key_schema, key_attrs, false);
+  return index::IndexFactory::GetInstance(index_metadata);
+}
+
+/*
+ * IsIntsKeyIndex() - Whether the index is a BwTree on IntsKey<KeySize>
+ */
+template <std::size_t KeySize>
+static bool IsIntsKeyIndex(index::Index *ints_index) {
+  typedef index::BWTreeIndex<
+      index::IntsKey<KeySize>, ItemPointer *, index::IntsComparator<KeySize>,
+      index::IntsEqualityChecker<KeySize>, index::IntsHasher<KeySize>,
+      index::ItemPointerComparator, index::ItemPointerHashFunc> IntsIndex;
+  return dynamic_cast<IntsIndex *>(ints_index) != nullptr;
+}
+
+TEST_F(IndexTests, IntsKeySelectionTest) {
+  // The number of words the key is packed into, 0 if it is not an IntsKey
+  std::vector<std::pair<std::vector<ValueType>, size_t>> key_types = {
+      {{VALUE_TYPE_INTEGER}, 1},
+      {{VALUE_TYPE_BIGINT}, 1},
+      {{VALUE_TYPE_TINYINT, VALUE_TYPE_SMALLINT, VALUE_TYPE_INTEGER}, 1},
+      {{VALUE_TYPE_TINYINT, VALUE_TYPE_INTEGER, VALUE_TYPE_BIGINT}, 2},
+      {{VALUE_TYPE_BIGINT, VALUE_TYPE_BIGINT, VALUE_TYPE_INTEGER}, 3},
+      {{VALUE_TYPE_BIGINT, VALUE_TYPE_BIGINT, VALUE_TYPE_BIGINT,
+        VALUE_TYPE_BIGINT}, 4},
+      {{VALUE_TYPE_BIGINT, VALUE_TYPE_BIGINT, VALUE_TYPE_BIGINT,
+        VALUE_TYPE_BIGINT, VALUE_TYPE_TINYINT}, 0},
+      {{VALUE_TYPE_INTEGER, VALUE_TYPE_VARCHAR}, 0},
+      {{VALUE_TYPE_INTEGER, VALUE_TYPE_DOUBLE}, 0}};
+
+  std::vector<bool (*)(index::Index *)> is_ints_key_index = {
+      IsIntsKeyIndex<1>, IsIntsKeyIndex<2>, IsIntsKeyIndex<3>,
+      IsIntsKeyIndex<4>};
+
+  for (auto &entry : key_types) {
+    std::unique_ptr<index::Index> bwtree_index(
+        BuildIntsIndex(INDEX_TYPE_BWTREE, entry.first));
+    std::unique_ptr<index::Index> btree_index(
+        BuildIntsIndex(INDEX_TYPE_BTREE, entry.first));
+    for (size_t key_size = 1; key_size <= is_ints_key_index.size();
+         key_size++) {
+      EXPECT_EQ(key_size == entry.second,
+                is_ints_key_index[key_size - 1](bwtree_index.get()));
+      // B-trees always use a GenericKey
+      EXPECT_FALSE(is_ints_key_index[key_size - 1](btree_index.get()));
+    }
+  }
+}
+
+TEST_F(IndexTests, IntsKeyTupleTest) {
+  std::unique_ptr<catalog::Schema> ints_key_schema(
+      new catalog::Schema(BuildIntsColumns(
+          {VALUE_TYPE_TINYINT, VALUE_TYPE_INTEGER, VALUE_TYPE_BIGINT})));
+
+  // In ascending order. The minimum of each type is its NULL.
+  std::vector<std::vector<int64_t>> rows = {
+      {INT8_MIN + 1, INT32_MIN + 1, INT64_MIN + 1},
+      {-5, 1000, -(1L << 40)},
+      {-1, -1, -1},
+      {-1, -1, 0},
+      {-1, 0, INT64_MIN + 1},
+      {0, 0, 0},
+      {1, INT32_MIN + 1, 1},
+      {1, 1, 1},
+      {5, -1000, 1L << 40},
+      {INT8_MAX, INT32_MAX, INT64_MAX}};
+
+  index::IntsComparator<2> comparator;
+  index::IntsEqualityChecker<2> equality_checker;
+  std::vector<index::IntsKey<2>> keys(rows.size());
+  for (size_t row_itr = 0; row_itr < rows.size(); row_itr++) {
+    auto &row = rows[row_itr];
+    storage::Tuple tuple(ints_key_schema.get(), true);
+    tuple.SetValue(0, ValueFactory::GetTinyIntValue(row[0]), nullptr);
+    tuple.SetValue(1, ValueFactory::GetIntegerValue(row[1]), nullptr);
+    tuple.SetValue(2, ValueFactory::GetBigIntValue(row[2]), nullptr);
+    keys[row_itr].SetFromKey(&tuple);
+
+    // Unpacked with its sign, as scan predicates compare it
+    auto unpacked = keys[row_itr].GetTupleForComparison(ints_key_schema.get());
+    EXPECT_EQ(row[0], ValuePeeker::PeekTinyInt(unpacked.GetValue(0)));
+    EXPECT_EQ(row[1], ValuePeeker::PeekInteger(unpacked.GetValue(1)));
+    EXPECT_EQ(row[2], ValuePeeker::PeekBigInt(unpacked.GetValue(2)));
+  }
+
+  // The packed words order the keys column by column, signs included
+  for (size_t row_itr = 0; row_itr + 1 < rows.size(); row_itr++) {
+    EXPECT_TRUE(comparator(keys[row_itr], keys[row_itr + 1]));
+    EXPECT_FALSE(comparator(keys[row_itr + 1], keys[row_itr]));
+    EXPECT_FALSE(equality_checker(keys[row_itr], keys[row_itr + 1]));
+    EXPECT_TRUE(equality_checker(keys[row_itr], keys[row_itr]));
+  }
+}
+
+TEST_F(IndexTests, IntsKeyScanTest) {
+  std::unique_ptr<index::Index> ints_index(BuildIntsIndex(
+      INDEX_TYPE_BWTREE,
+      {VALUE_TYPE_TINYINT, VALUE_TYPE_INTEGER, VALUE_TYPE_BIGINT}));
+  EXPECT_TRUE(IsIntsKeyIndex<2>(ints_index.get()));
+
+  // Every combination, in ascending key order
+  std::vector<std::vector<int64_t>> rows;
+  for (int64_t a : {-100, -1, 0, 1, 100}) {
+    for (int64_t b = -200; b <= 200; b++) {
+      for (int64_t c : {-(1L << 40), -1L, 0L, 1L << 40}) {
+        rows.push_back({a, b, c});
+      }
+    }
+  }
+
+  // Inserted from the last key on, the location is the row of the key
+  {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(ints_index->GetKeySchema(), true));
+    for (size_t row_itr = rows.size(); row_itr-- > 0;) {
+      key->SetValue(0, ValueFactory::GetTinyIntValue(rows[row_itr][0]),
+                    nullptr);
+      key->SetValue(1, ValueFactory::GetIntegerValue(rows[row_itr][1]),
+                    nullptr);
+      key->SetValue(2, ValueFactory::GetBigIntValue(rows[row_itr][2]),
+                    nullptr);
+      EXPECT_TRUE(ints_index->InsertEntry(key.get(), ItemPointer(row_itr, 0)));
+    }
+  }
+
+  // Compares the scan with the rows satisfying the predicate
+  auto check_scan = [&ints_index, &rows](
+      const std::vector<Value> &value_list,
+      const std::vector<oid_t> &tuple_column_id_list,
+      const std::vector<ExpressionType> &expr_list,
+      ScanDirectionType scan_direction,
+      std::function<bool(const std::vector<int64_t> &)> predicate) {
+    std::vector<ItemPointer *> location_ptrs;
+    ints_index->ScanTest(value_list, tuple_column_id_list, expr_list,
+                         scan_direction, location_ptrs);
+    std::vector<size_t> scanned;
+    for (auto location : location_ptrs) {
+      scanned.push_back(location->block);
+    }
+
+    std::vector<size_t> expected;
+    for (size_t row_itr = 0; row_itr < rows.size(); row_itr++) {
+      if (predicate(rows[row_itr])) expected.push_back(row_itr);
+    }
+    if (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD) {
+      std::reverse(expected.begin(), expected.end());
+    }
+    EXPECT_EQ(expected, scanned);
+  };
+
+  // A range within a negative prefix
+  check_scan({ValueFactory::GetTinyIntValue(-1),
+              ValueFactory::GetIntegerValue(-10),
+              ValueFactory::GetIntegerValue(20)},
+             {0, 1, 1},
+             {EXPRESSION_TYPE_COMPARE_EQUAL,
+              EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+              EXPRESSION_TYPE_COMPARE_LESSTHAN},
+             SCAN_DIRECTION_TYPE_FORWARD, [](const std::vector<int64_t> &row) {
+               return row[0] == -1 && row[1] >= -10 && row[1] < 20;
+             });
+
+  // A predicate on the last column only
+  check_scan({ValueFactory::GetTinyIntValue(-1),
+              ValueFactory::GetTinyIntValue(1),
+              ValueFactory::GetBigIntValue(0)},
+             {0, 0, 2},
+             {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+              EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+              EXPRESSION_TYPE_COMPARE_LESSTHAN},
+             SCAN_DIRECTION_TYPE_FORWARD, [](const std::vector<int64_t> &row) {
+               return row[0] >= -1 && row[0] <= 1 && row[2] < 0;
+             });
+
+  // Negative keys on every column, scanned backward
+  check_scan({ValueFactory::GetTinyIntValue(0),
+              ValueFactory::GetIntegerValue(-150),
+              ValueFactory::GetBigIntValue(0)},
+             {0, 1, 2},
+             {EXPRESSION_TYPE_COMPARE_LESSTHAN,
+              EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+              EXPRESSION_TYPE_COMPARE_LESSTHAN},
+             SCAN_DIRECTION_TYPE_BACKWARD, [](const std::vector<int64_t> &row) {
+               return row[0] < 0 && row[1] <= -150 && row[2] < 0;
+             });
+
+  // A point query and an empty range
+  check_scan({ValueFactory::GetTinyIntValue(100),
+              ValueFactory::GetIntegerValue(-200),
+              ValueFactory::GetBigIntValue(-(1L << 40))},
+             {0, 1, 2},
+             {EXPRESSION_TYPE_COMPARE_EQUAL, EXPRESSION_TYPE_COMPARE_EQUAL,
+              EXPRESSION_TYPE_COMPARE_EQUAL},
+             SCAN_DIRECTION_TYPE_FORWARD, [](const std::vector<int64_t> &row) {
+               return row[0] == 100 && row[1] == -200 &&
+                      row[2] == -(1L << 40);
+             });
+
+  check_scan({ValueFactory::GetTinyIntValue(100)}, {0},
+             {EXPRESSION_TYPE_COMPARE_GREATERTHAN},
+             SCAN_DIRECTION_TYPE_FORWARD,
+             [](const std::vector<int64_t> &) { return false; });
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,364 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimizer_test.cpp
+//
+// Identification: test/optimizer/optimizer_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "optimizer/access_path.h"
+#include "optimizer/column_manager.h"
+#include "optimizer/cost_model.h"
+#include "optimizer/join_enumerator.h"
+#include "optimizer/operators.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/query_operators.h"
+#include "planner/analyze_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimizer Tests
+//===--------------------------------------------------------------------===//
+
+using namespace optimizer;
+
+class OptimizerTests : public PelotonTest {};
+
+static const int small_tuple_count = 100;
+static const int medium_tuple_count = 1000;
+static const int large_tuple_count = 5000;
+
+// Populated table whose first column is unique
+static storage::DataTable *CreatePopulatedTable(int tuple_count,
+                                                oid_t table_oid,
+                                                int tuples_per_tile_group,
+                                                bool analyze) {
+  auto table =
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true, table_oid);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+
+  if (analyze) {
+    planner::AnalyzePlan analyze_plan(table);
+    bridge::PlanCursor cursor(&analyze_plan, {});
+    cursor.Next();
+    cursor.Close();
+  }
+  return table;
+}
+
+static storage::DataTable *CreateAnalyzedTable(int tuple_count,
+                                               oid_t table_oid) {
+  return CreatePopulatedTable(tuple_count, table_oid, 1000, true);
+}
+
+// Operator tree of a table with all its columns
+static std::shared_ptr<OpExpression> MakeGet(ColumnManager &manager,
+                                             storage::DataTable *table) {
+  std::vector<Column *> columns;
+  auto schema = table->GetSchema();
+  for (oid_t column_id = 0; column_id < schema->GetColumnCount();
+       column_id++) {
+    auto schema_column = schema->GetColumn(column_id);
+    Column *column = manager.LookupColumn(table->GetOid(), column_id);
+    if (column == nullptr) {
+      column = manager.AddBaseColumn(
+          schema_column.GetType(), schema_column.GetLength(),
+          schema_column.GetName(), schema_column.IsInlined(), table->GetOid(),
+          column_id);
+    }
+    columns.push_back(column);
+  }
+  return std::make_shared<OpExpression>(LogicalGet::make(table, columns));
+}
+
+// "left.column = right.column" of two gets
+static std::shared_ptr<OpExpression> MakeEqualColumns(
+    std::shared_ptr<OpExpression> left, std::shared_ptr<OpExpression> right,
+    oid_t column_id) {
+  auto term = std::make_shared<OpExpression>(
+      ExprCompare::make(EXPRESSION_TYPE_COMPARE_EQUAL));
+  term->PushChild(std::make_shared<OpExpression>(
+      ExprVariable::make(left->Op().as<LogicalGet>()->columns[column_id])));
+  term->PushChild(std::make_shared<OpExpression>(
+      ExprVariable::make(right->Op().as<LogicalGet>()->columns[column_id])));
+  return term;
+}
+
+static std::shared_ptr<OpExpression> MakeInnerJoin(
+    std::shared_ptr<OpExpression> left, std::shared_ptr<OpExpression> right,
+    std::shared_ptr<OpExpression> predicate) {
+  auto join = std::make_shared<OpExpression>(LogicalInnerJoin::make());
+  join->PushChild(left);
+  join->PushChild(right);
+  join->PushChild(predicate);
+  return join;
+}
+
+// Tables of the gets under the operator tree
+static void GetTables(const OpExpression &expr,
+                      std::set<storage::DataTable *> &tables) {
+  if (expr.Op().type() == OpType::Get) {
+    tables.insert(expr.Op().as<LogicalGet>()->table);
+  }
+  for (auto &child : expr.Children()) GetTables(*child, tables);
+}
+
+static bool HasPlanNode(const planner::AbstractPlan *plan,
+                        PlanNodeType plan_node_type) {
+  if (plan->GetPlanNodeType() == plan_node_type) return true;
+  for (auto &child : plan->GetChildren()) {
+    if (HasPlanNode(child.get(), plan_node_type)) return true;
+  }
+  return false;
+}
+
+TEST_F(OptimizerTests, CostModelTest) {
+  std::unique_ptr<storage::DataTable> table(
+      CreateAnalyzedTable(large_tuple_count, 4001));
+  ColumnManager manager;
+  auto get = MakeGet(manager, table.get());
+
+  auto stats = CostModel::GetTableStats(table.get());
+  EXPECT_EQ(large_tuple_count, stats->GetCardinality());
+
+  // A unique value and a fifth of the range of the second column
+  auto compare = [&get](ExpressionType compare_type, int value) {
+    auto term = std::make_shared<OpExpression>(ExprCompare::make(compare_type));
+    term->PushChild(std::make_shared<OpExpression>(
+        ExprVariable::make(get->Op().as<LogicalGet>()->columns[1])));
+    term->PushChild(std::make_shared<OpExpression>(
+        ExprConstant::make(ValueFactory::GetIntegerValue(value))));
+    return term;
+  };
+  auto equal = compare(EXPRESSION_TYPE_COMPARE_EQUAL,
+                       ExecutorTestsUtil::PopulatedValue(100, 1));
+  auto less = compare(EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                      ExecutorTestsUtil::PopulatedValue(1000, 1));
+  EXPECT_NEAR(1.0 / large_tuple_count,
+              CostModel::EstimateSelectivity(*equal, *stats),
+              0.2 / large_tuple_count);
+  EXPECT_NEAR(0.2, CostModel::EstimateSelectivity(*less, *stats), 0.02);
+
+  auto both = std::make_shared<OpExpression>(ExprBoolOp::make(BoolOpType::And));
+  both->PushChild(equal);
+  both->PushChild(less);
+  EXPECT_NEAR(0.2 / large_tuple_count,
+              CostModel::EstimateSelectivity(*both, *stats),
+              0.05 / large_tuple_count);
+
+  // A few probes of an index beat hashing the whole table, many do not
+  double output = 10;
+  EXPECT_LT(CostModel::IndexNLJoinCost(10, large_tuple_count, output, output),
+            CostModel::HashJoinCost(10, large_tuple_count, output) +
+                large_tuple_count * SEQ_TUPLE_COST);
+  output = large_tuple_count;
+  EXPECT_GT(CostModel::IndexNLJoinCost(large_tuple_count, large_tuple_count,
+                                       output, output),
+            CostModel::HashJoinCost(large_tuple_count, large_tuple_count,
+                                    output) +
+                large_tuple_count * SEQ_TUPLE_COST);
+}
+
+TEST_F(OptimizerTests, AccessPathTest) {
+  // The first index is on the first column, the second one on the first two
+  for (bool analyze : {true, false}) {
+    std::unique_ptr<storage::DataTable> table(
+        CreatePopulatedTable(large_tuple_count, 4101, 100, analyze));
+
+    auto value = [](int row, oid_t column_id) {
+      return ValueFactory::GetIntegerValue(
+          ExecutorTestsUtil::PopulatedValue(row, column_id));
+    };
+
+    // A single row is looked up in the index
+    auto access_path = ChooseAccessPath(
+        table.get(), {0}, {EXPRESSION_TYPE_COMPARE_EQUAL}, {value(100, 0)});
+    EXPECT_EQ(AccessPathType::IndexScan, access_path.type);
+    EXPECT_EQ(0, access_path.index_offset);
+    EXPECT_GT(0.01, access_path.selectivity);
+
+    // Both columns are a prefix of the key of the second index, which has
+    // no match for them
+    access_path = ChooseAccessPath(
+        table.get(), {1, 0},
+        {EXPRESSION_TYPE_COMPARE_EQUAL, EXPRESSION_TYPE_COMPARE_EQUAL},
+        {value(200, 1), value(100, 0)});
+    EXPECT_EQ(AccessPathType::IndexScan, access_path.type);
+    EXPECT_EQ(1, access_path.index_offset);
+    EXPECT_EQ(2, access_path.key_predicates.size());
+
+    // The second column alone does not bound the scan of either index
+    access_path = ChooseAccessPath(
+        table.get(), {1}, {EXPRESSION_TYPE_COMPARE_EQUAL}, {value(100, 1)});
+    EXPECT_EQ(AccessPathType::SeqScan, access_path.type);
+
+    // A twentieth of the table is spread over all of its tile groups
+    access_path = ChooseAccessPath(table.get(), {0},
+                                   {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+                                   {value(large_tuple_count / 20, 0)});
+    EXPECT_EQ(AccessPathType::BitmapScan, access_path.type);
+    EXPECT_NEAR(0.05, access_path.selectivity, 0.01);
+
+    // Strings are not compared with integer keys
+    access_path = ChooseAccessPath(table.get(), {0},
+                                   {EXPRESSION_TYPE_COMPARE_EQUAL},
+                                   {ValueFactory::GetStringValue("100")});
+    EXPECT_EQ(AccessPathType::SeqScan, access_path.type);
+  }
+
+  // Most of the table is read sequentially
+  std::unique_ptr<storage::DataTable> table(
+      CreatePopulatedTable(large_tuple_count, 4102, 100, true));
+  auto access_path = ChooseAccessPath(
+      table.get(), {0}, {EXPRESSION_TYPE_COMPARE_GREATERTHAN},
+      {ValueFactory::GetIntegerValue(
+          ExecutorTestsUtil::PopulatedValue(large_tuple_count / 5, 0))});
+  EXPECT_EQ(AccessPathType::SeqScan, access_path.type);
+}
+
+TEST_F(OptimizerTests, JoinOrderTest) {
+  std::unique_ptr<storage::DataTable> small_table(
+      CreateAnalyzedTable(small_tuple_count, 4011));
+  std::unique_ptr<storage::DataTable> medium_table(
+      CreateAnalyzedTable(medium_tuple_count, 4012));
+  std::unique_ptr<storage::DataTable> large_table(
+      CreateAnalyzedTable(large_tuple_count, 4013));
+
+  ColumnManager manager;
+  auto small_get = MakeGet(manager, small_table.get());
+  auto medium_get = MakeGet(manager, medium_table.get());
+  auto large_get = MakeGet(manager, large_table.get());
+
+  // (LARGE JOIN MEDIUM) JOIN SMALL, with a filter on LARGE above the joins
+  auto joins = MakeInnerJoin(
+      MakeInnerJoin(large_get, medium_get,
+                    MakeEqualColumns(large_get, medium_get, 0)),
+      small_get, MakeEqualColumns(medium_get, small_get, 0));
+  auto filter_term = std::make_shared<OpExpression>(
+      ExprCompare::make(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO));
+  filter_term->PushChild(std::make_shared<OpExpression>(
+      ExprVariable::make(large_get->Op().as<LogicalGet>()->columns[1])));
+  filter_term->PushChild(std::make_shared<OpExpression>(
+      ExprConstant::make(ValueFactory::GetIntegerValue(0))));
+  auto filter = std::make_shared<OpExpression>(LogicalSelect::make());
+  filter->PushChild(joins);
+  filter->PushChild(filter_term);
+
+  // SMALL and MEDIUM are joined first, LARGE gets the filter
+  auto reordered = JoinEnumerator::ReorderJoins(filter);
+  ASSERT_EQ(OpType::InnerJoin, reordered->Op().type());
+
+  std::shared_ptr<OpExpression> inner_join;
+  std::shared_ptr<OpExpression> large_side;
+  for (auto &child : reordered->Children()) {
+    if (child->Op().type() == OpType::InnerJoin) inner_join = child;
+    if (child->Op().type() == OpType::Select) large_side = child;
+  }
+  ASSERT_NE(nullptr, inner_join);
+  ASSERT_NE(nullptr, large_side);
+
+  std::set<storage::DataTable *> tables;
+  GetTables(*inner_join, tables);
+  EXPECT_EQ(std::set<storage::DataTable *>(
+                {small_table.get(), medium_table.get()}),
+            tables);
+  EXPECT_EQ(large_table.get(),
+            large_side->Children()[0]->Op().as<LogicalGet>()->table);
+  EXPECT_EQ(OpType::Compare, large_side->Children()[1]->Op().type());
+}
+
+TEST_F(OptimizerTests, MultiWayJoinPlanTest) {
+  std::unique_ptr<storage::DataTable> small_table(
+      CreateAnalyzedTable(small_tuple_count, 4021));
+  std::unique_ptr<storage::DataTable> medium_table(
+      CreateAnalyzedTable(medium_tuple_count, 4022));
+  std::unique_ptr<storage::DataTable> large_table(
+      CreateAnalyzedTable(large_tuple_count, 4023));
+
+  // SELECT LARGE.A, SMALL.D FROM LARGE JOIN MEDIUM ON LARGE.A = MEDIUM.A
+  // JOIN SMALL ON MEDIUM.A = SMALL.A
+  std::vector<std::unique_ptr<QueryJoinNode>> join_nodes;
+  std::vector<std::unique_ptr<QueryExpression>> query_exprs;
+  auto variable = [&query_exprs](storage::DataTable *table, oid_t column_id) {
+    query_exprs.emplace_back(new Variable(
+        table->GetOid(), column_id, table->GetSchema()->GetColumn(column_id)));
+    return query_exprs.back().get();
+  };
+  auto equal = [&query_exprs](QueryExpression *left, QueryExpression *right) {
+    query_exprs.emplace_back(new OperatorExpression(
+        EXPRESSION_TYPE_COMPARE_EQUAL, VALUE_TYPE_BOOLEAN, {left, right}));
+    return query_exprs.back().get();
+  };
+
+  auto small_node = new Table(small_table.get());
+  auto medium_node = new Table(medium_table.get());
+  auto large_node = new Table(large_table.get());
+  join_nodes.emplace_back(small_node);
+  join_nodes.emplace_back(medium_node);
+  join_nodes.emplace_back(large_node);
+
+  auto first_join = new Join(
+      JOIN_TYPE_INNER, large_node, medium_node,
+      equal(variable(large_table.get(), 0), variable(medium_table.get(), 0)),
+      {large_node}, {medium_node});
+  join_nodes.emplace_back(first_join);
+  auto second_join = new Join(
+      JOIN_TYPE_INNER, first_join, small_node,
+      equal(variable(medium_table.get(), 0), variable(small_table.get(), 0)),
+      {large_node, medium_node}, {small_node});
+  join_nodes.emplace_back(second_join);
+
+  std::unique_ptr<Attribute> large_a(
+      new Attribute(variable(large_table.get(), 0), "a", false));
+  std::unique_ptr<Attribute> small_d(
+      new Attribute(variable(small_table.get(), 3), "d", false));
+  std::shared_ptr<Select> select(new Select(
+      second_join, nullptr, {large_a.get(), small_d.get()}, {}));
+
+  auto plan = Optimizer::GetInstance().GeneratePlan(select);
+  ASSERT_NE(nullptr, plan);
+
+  // The equi-joins need no nested loop over all pairs
+  EXPECT_FALSE(HasPlanNode(plan.get(), PLAN_NODE_TYPE_NESTLOOP));
+
+  // Every tuple of SMALL has a match in the other tables
+  int rows = 0;
+  bridge::PlanCursor cursor(plan.get(), {});
+  while (cursor.Next()) {
+    auto tile = cursor.GetTile();
+    auto tuple_id = cursor.GetTupleId();
+    int key = ValuePeeker::PeekAsInteger(tile->GetValue(tuple_id, 0));
+    EXPECT_EQ(std::to_string(key + 3),
+              ValuePeeker::PeekStringCopyWithoutNull(
+                  tile->GetValue(tuple_id, 1)));
+    rows++;
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  EXPECT_EQ(small_tuple_count, rows);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache_test.cpp
+//
+// Identification: test/optimizer/plan_cache_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_peeker.h"
+#include "optimizer/plan_cache.h"
+#include "planner/mock_plan.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Cache Tests
+//===--------------------------------------------------------------------===//
+
+using namespace optimizer;
+
+class PlanCacheTests : public PelotonTest {};
+
+TEST_F(PlanCacheTests, FingerprintTest) {
+  std::string fingerprint;
+  std::vector<Value> literals;
+
+  // Literals become parameters, the rest is normalized
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "SELECT a, b FROM t1\n  WHERE a = 42 AND  c = 'Peloton' AND d > 2.5",
+      fingerprint, literals));
+  EXPECT_EQ("select a, b from t1 where a = $1 and c = $2 and d > $3",
+            fingerprint);
+  ASSERT_EQ(3, literals.size());
+  EXPECT_EQ(42, ValuePeeker::PeekInteger(literals[0]));
+  EXPECT_EQ(VALUE_TYPE_VARCHAR, literals[1].GetValueType());
+  EXPECT_EQ(2.5, ValuePeeker::PeekDouble(literals[2]));
+
+  // Same shape, same fingerprint
+  std::string other_fingerprint;
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "select a, b from t1 where a = 7 and c = 'x' and d > 0.5",
+      other_fingerprint, literals));
+  EXPECT_EQ(fingerprint, other_fingerprint);
+
+  EXPECT_TRUE(PlanCache::Fingerprint("INSERT INTO t VALUES (5000000000, 'a')",
+                                     fingerprint, literals));
+  EXPECT_EQ("insert into t values ($1, $2)", fingerprint);
+  EXPECT_EQ(VALUE_TYPE_BIGINT, literals[0].GetValueType());
+
+  // Prepared statements have parameters of their own, their literals stay
+  EXPECT_TRUE(PlanCache::Fingerprint("SELECT * FROM t WHERE a = $1",
+                                     fingerprint, literals));
+  EXPECT_EQ("select * from t where a = $1", fingerprint);
+  EXPECT_EQ(0, literals.size());
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "UPDATE t SET b = 'Done' WHERE a = $1 AND c < 2.5", fingerprint,
+      literals));
+  EXPECT_EQ("update t set b = 'Done' where a = $1 and c < 2.5", fingerprint);
+  EXPECT_EQ(0, literals.size());
+
+  // Not cached : other statements, bad strings
+  EXPECT_FALSE(PlanCache::Fingerprint("CREATE TABLE t (a VARCHAR(32))",
+                                      fingerprint, literals));
+  EXPECT_FALSE(PlanCache::Fingerprint("SELECT * FROM t WHERE a = 'x",
+                                      fingerprint, literals));
+  EXPECT_FALSE(PlanCache::Fingerprint("SELECT * FROM t WHERE a = 'x''",
+                                      fingerprint, literals));
+}
+
+TEST_F(PlanCacheTests, QuoteEscapeTest) {
+  std::string fingerprint;
+  std::vector<Value> literals;
+
+  // A doubled quote is part of the string
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "SELECT * FROM t WHERE c = 'it''s' AND d = '''' AND e = ''",
+      fingerprint, literals));
+  EXPECT_EQ("select * from t where c = $1 and d = $2 and e = $3", fingerprint);
+  ASSERT_EQ(3, literals.size());
+  EXPECT_EQ("it's", ValuePeeker::PeekStringCopyWithoutNull(literals[0]));
+  EXPECT_EQ("'", ValuePeeker::PeekStringCopyWithoutNull(literals[1]));
+  EXPECT_EQ("", ValuePeeker::PeekStringCopyWithoutNull(literals[2]));
+
+  // and stays in a string left in place
+  EXPECT_TRUE(PlanCache::Fingerprint("UPDATE t SET b = 'isn''t' WHERE a = $1",
+                                     fingerprint, literals));
+  EXPECT_EQ("update t set b = 'isn''t' where a = $1", fingerprint);
+  EXPECT_EQ(0, literals.size());
+
+  // Quoted identifiers double their quotes too
+  EXPECT_TRUE(PlanCache::Fingerprint("SELECT \"a\"\"b\" FROM t WHERE a = 1",
+                                     fingerprint, literals));
+  EXPECT_EQ("select \"a\"\"b\" from t where a = $1", fingerprint);
+}
+
+TEST_F(PlanCacheTests, NegativeNumberTest) {
+  std::string fingerprint;
+  std::vector<Value> literals;
+
+  // A minus sign without an operand before it belongs to the number
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "SELECT -1, a FROM t WHERE a = -42 AND (-2.5 < b OR c IN (-3, -4))",
+      fingerprint, literals));
+  EXPECT_EQ("select $1, a from t where a = $2 and ($3 < b or c in ($4, $5))",
+            fingerprint);
+  ASSERT_EQ(5, literals.size());
+  EXPECT_EQ(-1, ValuePeeker::PeekInteger(literals[0]));
+  EXPECT_EQ(-42, ValuePeeker::PeekInteger(literals[1]));
+  EXPECT_EQ(-2.5, ValuePeeker::PeekDouble(literals[2]));
+  EXPECT_EQ(-3, ValuePeeker::PeekInteger(literals[3]));
+  EXPECT_EQ(-4, ValuePeeker::PeekInteger(literals[4]));
+
+  // After one, it subtracts
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "SELECT a -1, (a) - 2, 3-4 FROM t WHERE b = 'x' -5", fingerprint,
+      literals));
+  EXPECT_EQ("select a -$1, (a) - $2, $3-$4 from t where b = $5 -$6",
+            fingerprint);
+  ASSERT_EQ(6, literals.size());
+  EXPECT_EQ(1, ValuePeeker::PeekInteger(literals[0]));
+  EXPECT_EQ(4, ValuePeeker::PeekInteger(literals[3]));
+
+  // The minimum of a 32 bit integer is its NULL, it takes a 64 bit one
+  EXPECT_TRUE(PlanCache::Fingerprint(
+      "INSERT INTO t VALUES (-2147483648, -2147483647)", fingerprint,
+      literals));
+  EXPECT_EQ(VALUE_TYPE_BIGINT, literals[0].GetValueType());
+  EXPECT_EQ(-2147483648L, ValuePeeker::PeekBigInt(literals[0]));
+  EXPECT_EQ(VALUE_TYPE_INTEGER, literals[1].GetValueType());
+}
+
+TEST_F(PlanCacheTests, EvictionTest) {
+  // One template per shard
+  PlanCache plan_cache(1);
+
+  EXPECT_EQ(nullptr, plan_cache.Find("select $1"));
+  plan_cache.Insert(std::make_shared<CachedPlan>("select $1"));
+  EXPECT_NE(nullptr, plan_cache.Find("select $1"));
+  EXPECT_EQ(1, plan_cache.GetHitCount());
+  EXPECT_EQ(1, plan_cache.GetMissCount());
+  EXPECT_EQ(0.5, plan_cache.GetHitRate());
+
+  // Fill every shard twice over
+  for (int query_itr = 0; query_itr < 64; query_itr++) {
+    plan_cache.Insert(std::make_shared<CachedPlan>(
+        "select " + std::to_string(query_itr)));
+  }
+  EXPECT_GE(16, plan_cache.GetSize());
+  EXPECT_LE(48, plan_cache.GetEvictionCount());
+
+  plan_cache.Clear();
+  EXPECT_EQ(0, plan_cache.GetSize());
+}
+
+TEST_F(PlanCacheTests, InstanceTest) {
+  auto cached_plan = std::make_shared<CachedPlan>(
+      "select * from t where a = $1", std::vector<FieldInfoType>());
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+
+  // A released instance is lent out again, one execution at a time
+  std::shared_ptr<planner::AbstractPlan> instance(new MockPlan());
+  auto plan_tree = cached_plan->Lend(instance);
+  EXPECT_EQ(instance.get(), plan_tree.get());
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+
+  plan_tree.reset();
+  plan_tree = cached_plan->Acquire();
+  EXPECT_EQ(instance.get(), plan_tree.get());
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+
+  // Instances of an invalidated template are dropped
+  cached_plan->Invalidate();
+  plan_tree.reset();
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+  EXPECT_EQ(1, instance.use_count());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_test.cpp
+//
+// Identification: test/optimizer/stats_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "optimizer/hyperloglog.h"
+#include "optimizer/stats_collector.h"
+#include "optimizer/table_stats.h"
+#include "planner/analyze_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Stats Tests
+//===--------------------------------------------------------------------===//
+
+using namespace optimizer;
+
+class StatsTests : public PelotonTest {};
+
+// Column 0 holds two values, one per half of the rows, the others are unique
+static storage::DataTable *CreatePopulatedTable(int tuple_count) {
+  auto table = ExecutorTestsUtil::CreateTable(1000, false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, true,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+TEST_F(StatsTests, HyperLogLogTest) {
+  HyperLogLog sketch;
+  EXPECT_EQ(0, sketch.Estimate());
+
+  for (int value = 0; value < 100000; value++) {
+    sketch.AddValue(ValueFactory::GetIntegerValue(value));
+  }
+  EXPECT_NEAR(100000, sketch.Estimate(), 5000);
+
+  // Duplicates are not counted
+  double estimate = sketch.Estimate();
+  for (int value = 0; value < 1000; value++) {
+    sketch.AddValue(ValueFactory::GetIntegerValue(value));
+  }
+  EXPECT_EQ(estimate, sketch.Estimate());
+
+  // Small counts are about exact
+  HyperLogLog small_sketch;
+  for (int value = 0; value < 100; value++) {
+    small_sketch.AddValue(ValueFactory::GetStringValue(std::to_string(value)));
+  }
+  EXPECT_NEAR(100, small_sketch.Estimate(), 2);
+
+  // A merged sketch counts the union
+  HyperLogLog other_sketch;
+  for (int value = 50000; value < 150000; value++) {
+    other_sketch.AddValue(ValueFactory::GetIntegerValue(value));
+  }
+  sketch.Merge(other_sketch);
+  EXPECT_NEAR(150000, sketch.Estimate(), 7500);
+}
+
+TEST_F(StatsTests, ColumnStatsTest) {
+  // 0 .. 899 once and 1000 a hundred times, a tenth of the rows are null
+  std::vector<Value> sample;
+  for (int value = 0; value < 900; value++) {
+    sample.push_back(ValueFactory::GetIntegerValue(value));
+  }
+  for (int copy = 0; copy < 100; copy++) {
+    sample.push_back(ValueFactory::GetIntegerValue(1000));
+  }
+  ColumnStats column_stats(std::move(sample), 0.1, 901, 10, 100);
+
+  EXPECT_EQ(0.1, column_stats.GetNullFraction());
+  EXPECT_EQ(901, column_stats.GetDistinctCount());
+  EXPECT_EQ(1, column_stats.GetMostCommonValues().size());
+  EXPECT_NEAR(0.09, column_stats.GetMostCommonFrequencies()[0], 1e-9);
+  EXPECT_EQ(101, column_stats.GetHistogramBounds().size());
+
+  auto one_thousand = ValueFactory::GetIntegerValue(1000);
+  auto four_fifty = ValueFactory::GetIntegerValue(450);
+  EXPECT_NEAR(0.09, column_stats.EstimateSelectivity(
+                        EXPRESSION_TYPE_COMPARE_EQUAL, one_thousand),
+              1e-9);
+  EXPECT_NEAR(0.0009, column_stats.EstimateSelectivity(
+                          EXPRESSION_TYPE_COMPARE_EQUAL, four_fifty),
+              1e-9);
+  EXPECT_NEAR(0.8991, column_stats.EstimateSelectivity(
+                          EXPRESSION_TYPE_COMPARE_NOTEQUAL, four_fifty),
+              1e-9);
+
+  // Half of the histogram, the other half and the common value
+  EXPECT_NEAR(0.405, column_stats.EstimateSelectivity(
+                         EXPRESSION_TYPE_COMPARE_LESSTHAN, four_fifty),
+              0.01);
+  EXPECT_NEAR(0.495, column_stats.EstimateSelectivity(
+                         EXPRESSION_TYPE_COMPARE_GREATERTHAN, four_fifty),
+              0.01);
+  EXPECT_NEAR(0.9, column_stats.EstimateSelectivity(
+                       EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+                       one_thousand),
+              1e-9);
+  EXPECT_NEAR(0.81, column_stats.EstimateSelectivity(
+                        EXPRESSION_TYPE_COMPARE_LESSTHAN, one_thousand),
+              1e-9);
+  EXPECT_NEAR(0, column_stats.EstimateSelectivity(
+                     EXPRESSION_TYPE_COMPARE_GREATERTHAN, one_thousand),
+              1e-9);
+  EXPECT_EQ(0, column_stats.EstimateSelectivity(
+                   EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                   ValueFactory::GetIntegerValue(-1)));
+
+  // Nothing equals null
+  EXPECT_EQ(0, column_stats.EstimateSelectivity(
+                   EXPRESSION_TYPE_COMPARE_EQUAL,
+                   ValueFactory::GetNullValueByType(VALUE_TYPE_INTEGER)));
+}
+
+TEST_F(StatsTests, AnalyzeTest) {
+  const int tuple_count = 40000;
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable(tuple_count));
+  EXPECT_EQ(nullptr, table->GetTableStats());
+
+  auto &stats_collector = StatsCollector::GetInstance();
+  EXPECT_TRUE(stats_collector.NeedsAnalyze(table.get()));
+
+  planner::AnalyzePlan analyze_plan(table.get());
+  bridge::PlanCursor cursor(&analyze_plan, {});
+  EXPECT_FALSE(cursor.Next());
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+
+  auto table_stats = table->GetTableStats();
+  ASSERT_NE(nullptr, table_stats);
+  EXPECT_EQ(tuple_count, table_stats->GetTupleCount());
+  EXPECT_EQ(4, table_stats->GetColumnCount());
+  EXPECT_FALSE(stats_collector.NeedsAnalyze(table.get()));
+
+  // The two values of the first column are its most common ones
+  auto &group_stats = table_stats->GetColumnStats(0);
+  EXPECT_NEAR(2, group_stats.GetDistinctCount(), 0.01);
+  EXPECT_EQ(2, group_stats.GetMostCommonValues().size());
+  EXPECT_TRUE(group_stats.GetHistogramBounds().empty());
+  EXPECT_NEAR(0.5, table_stats->EstimateSelectivity(
+                       0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                       ValueFactory::GetIntegerValue(
+                           ExecutorTestsUtil::PopulatedValue(0, 0))),
+              0.02);
+
+  // The unique columns are described by their histograms
+  for (oid_t column_id = 1; column_id < 4; column_id++) {
+    auto &column_stats = table_stats->GetColumnStats(column_id);
+    EXPECT_EQ(0, column_stats.GetNullFraction());
+    EXPECT_NEAR(tuple_count, column_stats.GetDistinctCount(),
+                tuple_count * 0.05);
+    EXPECT_TRUE(column_stats.GetMostCommonValues().empty());
+    EXPECT_EQ(101, column_stats.GetHistogramBounds().size());
+  }
+  EXPECT_NEAR(0.25, table_stats->EstimateSelectivity(
+                        1, EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                        ValueFactory::GetIntegerValue(
+                            ExecutorTestsUtil::PopulatedValue(10000, 1))),
+              0.02);
+  EXPECT_NEAR(0.75, table_stats->EstimateSelectivity(
+                        2, EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                        ValueFactory::GetDoubleValue(
+                            ExecutorTestsUtil::PopulatedValue(10000, 2))),
+              0.02);
+  EXPECT_NEAR(1.0 / tuple_count,
+              table_stats->EstimateSelectivity(
+                  3, EXPRESSION_TYPE_COMPARE_EQUAL,
+                  ValueFactory::GetStringValue(std::to_string(
+                      ExecutorTestsUtil::PopulatedValue(10000, 3)))),
+              0.1 / tuple_count);
+
+  // A fifth of the table changing calls for another analyze
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count / 5, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_TRUE(stats_collector.NeedsAnalyze(table.get()));
+}
+
+TEST_F(StatsTests, AutoAnalyzeTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable(1000));
+
+  auto &stats_collector = StatsCollector::GetInstance();
+  stats_collector.AddTable(table.get());
+  stats_collector.Start();
+
+  for (int wait_itr = 0; wait_itr < 100; wait_itr++) {
+    if (table->GetTableStats() != nullptr) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  stats_collector.Stop();
+  stats_collector.ClearTables();
+
+  auto table_stats = table->GetTableStats();
+  ASSERT_NE(nullptr, table_stats);
+  EXPECT_EQ(1000, table_stats->GetTupleCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
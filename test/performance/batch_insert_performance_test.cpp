@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// batch_insert_performance_test.cpp
+//
+// Identification: test/performance/batch_insert_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "planner/insert_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Batch Insert Performance Tests
+//===--------------------------------------------------------------------===//
+
+class BatchInsertPerformanceTests : public PelotonTest {};
+
+// Run the inserts of a pipelined batch, each in its own transaction or all
+// of them in the given one
+static double TimeBatch(storage::DataTable *table, int first_id,
+                        int batch_size, concurrency::Transaction *txn) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int tuple_itr = 0; tuple_itr < batch_size; tuple_itr++) {
+    planner::InsertPlan node(
+        table, ExecutorTestsUtil::GetTuple(table, first_id + tuple_itr, pool));
+    bridge::PlanCursor cursor(&node, {}, txn);
+    while (cursor.Next());
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  }
+  if (txn != nullptr) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+  timer.Stop();
+
+  return timer.GetDuration();
+}
+
+TEST_F(BatchInsertPerformanceTests, SharedTransactionTest) {
+  const int batch_size = 50000;
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(TEST_TUPLES_PER_TILEGROUP, false));
+
+  double per_statement = TimeBatch(table.get(), 0, batch_size, nullptr);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  double shared = TimeBatch(table.get(), batch_size, batch_size,
+                            txn_manager.BeginTransaction());
+
+  LOG_INFO("%d inserts", batch_size);
+  LOG_INFO("transaction per statement : %.2lf ms", per_statement);
+  LOG_INFO("transaction per batch : %.2lf ms", shared);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,179 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary_performance_test.cpp
+//
+// Identification: test/performance/dictionary_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "common/harness.h"
+
+#include "common/pool.h"
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/dictionary.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Dictionary Encoding Performance Tests
+//===--------------------------------------------------------------------===//
+
+class DictionaryPerformanceTests : public PelotonTest {};
+
+// Populate an sdbench-style tile group whose COL_D holds one of a few
+// hundred category strings
+static std::shared_ptr<storage::TileGroup> CreateCategoryTileGroup(
+    oid_t tuple_count, int category_count) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::AppendSchemaList(tile_group->GetTileSchemas()));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(tuple_itr), testing_pool);
+    tuple.SetValue(1, ValueFactory::GetIntegerValue(tuple_itr), testing_pool);
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(tuple_itr), testing_pool);
+    Value category = ValueFactory::GetStringValue(
+        "category_" + std::to_string((tuple_itr * 7919) % category_count));
+    tuple.SetValue(3, category, testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    oid_t tuple_slot_id = tile_group->InsertTuple(&tuple);
+    txn_manager.PerformInsert(
+        txn, ItemPointer(tile_group->GetTileGroupId(), tuple_slot_id),
+        index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+  return tile_group;
+}
+
+// Time COL_D = 'category_7' over the tile group
+static size_t TimeEqualityScan(storage::TileGroup *tile_group,
+                               oid_t tuple_count, int iterations,
+                               double *duration) {
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_EQUAL,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetStringValue("category_7"))));
+  auto program = expression::CompiledExpression::Compile(
+      predicate.get(),
+      expression::CompiledExpression::GetColumnTypes(tile_group), {}, nullptr);
+  PL_ASSERT(program != nullptr);
+  program->Bind(0, tile_group);
+
+  size_t matches = 0;
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (program->EvaluatesTrue(tuple_id)) matches++;
+    }
+  }
+  timer.Stop();
+  *duration = timer.GetDuration();
+  return matches;
+}
+
+// Time building a hash set keyed on COL_D, as the hash executor does
+static size_t TimeHashBuild(
+    const std::shared_ptr<storage::TileGroup> &tile_group, int iterations,
+    double *duration) {
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  std::vector<oid_t> column_ids = {3};
+  size_t group_count = 0;
+
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    std::unordered_set<
+        expression::ContainerTuple<executor::LogicalTile>,
+        expression::ContainerTupleHasher<executor::LogicalTile>,
+        expression::ContainerTupleComparator<executor::LogicalTile>> groups;
+    for (oid_t tuple_id : *logical_tile) {
+      groups.insert(expression::ContainerTuple<executor::LogicalTile>(
+          logical_tile.get(), tuple_id, &column_ids));
+    }
+    group_count = groups.size();
+  }
+  timer.Stop();
+  *duration = timer.GetDuration();
+  return group_count;
+}
+
+TEST_F(DictionaryPerformanceTests, CategoryColumnTest) {
+  const oid_t tuple_count = 100000;
+  const int category_count = 500;
+  const int iterations = 10;
+
+  auto tile_group = CreateCategoryTileGroup(tuple_count, category_count);
+  auto tile = tile_group->GetTile(tile_group->GetTileIdFromColumnId(3));
+
+  // Plain varchar storage
+  double plain_scan, plain_hash;
+  size_t plain_matches =
+      TimeEqualityScan(tile_group.get(), tuple_count, iterations, &plain_scan);
+  size_t plain_groups = TimeHashBuild(tile_group, iterations, &plain_hash);
+  int64_t plain_memory = tile->GetPool()->GetAllocatedMemory();
+
+  // Encode the cold tile group and drop the tile's copies of the strings,
+  // nothing else reads them here
+  std::shared_ptr<storage::Dictionary> dictionary(
+      new storage::Dictionary(BACKEND_TYPE_MM));
+  EXPECT_TRUE(tile_group->EncodeDictionary(3, dictionary));
+  tile->CompactPool().reset();
+
+  double encoded_scan, encoded_hash;
+  size_t encoded_matches = TimeEqualityScan(tile_group.get(), tuple_count,
+                                            iterations, &encoded_scan);
+  size_t encoded_groups = TimeHashBuild(tile_group, iterations, &encoded_hash);
+  // The slots keep their Varlen pointers in both layouts, only what comes
+  // on top of them is compared
+  int64_t encoded_memory = tile->GetPool()->GetAllocatedMemory() +
+                           dictionary->GetMemorySize() +
+                           tuple_count * sizeof(storage::Dictionary::Code);
+
+  EXPECT_EQ(plain_matches, encoded_matches);
+  EXPECT_EQ(plain_groups, encoded_groups);
+  EXPECT_EQ(static_cast<size_t>(category_count), encoded_groups);
+
+  LOG_INFO("%u rows, %d categories", tuple_count, category_count);
+  LOG_INFO("memory : varlen pool %ld bytes, encoded %ld bytes (tile pool, "
+           "dictionary and codes), %lu bytes of slot pointers in both",
+           plain_memory, encoded_memory, tuple_count * sizeof(Varlen *));
+  LOG_INFO("equality scan : plain %.2lf ms, encoded %.2lf ms", plain_scan,
+           encoded_scan);
+  LOG_INFO("hash build : plain %.2lf ms, encoded %.2lf ms", plain_hash,
+           encoded_hash);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// expression_performance_test.cpp
+//
+// Identification: test/performance/expression_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Expression Performance Tests
+//===--------------------------------------------------------------------===//
+
+class ExpressionPerformanceTests : public PelotonTest {};
+
+static expression::AbstractExpression *Column(ValueType type, int column_id) {
+  return expression::ExpressionUtil::TupleValueFactory(type, 0, column_id);
+}
+
+static expression::AbstractExpression *Compare(
+    ExpressionType type, expression::AbstractExpression *left,
+    const Value &constant) {
+  return expression::ExpressionUtil::ComparisonFactory(
+      type, left, expression::ExpressionUtil::ConstantValueFactory(constant));
+}
+
+static expression::AbstractExpression *And(
+    expression::AbstractExpression *left,
+    expression::AbstractExpression *right) {
+  return expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND, left, right);
+}
+
+// Run the predicate over every row with both engines and report the times
+static void RunPredicate(const std::string &name,
+                         expression::AbstractExpression *predicate,
+                         storage::TileGroup *tile_group, oid_t tuple_count,
+                         int iterations) {
+  size_t interpreted_matches = 0;
+  Timer<std::milli> interpreted_timer;
+  interpreted_timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue()) {
+        interpreted_matches++;
+      }
+    }
+  }
+  interpreted_timer.Stop();
+
+  auto program = expression::CompiledExpression::Compile(
+      predicate, expression::CompiledExpression::GetColumnTypes(tile_group),
+      {}, nullptr);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_TRUE(program->Bind(0, tile_group));
+
+  size_t compiled_matches = 0;
+  Timer<std::milli> compiled_timer;
+  compiled_timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (program->EvaluatesTrue(tuple_id)) {
+        compiled_matches++;
+      }
+    }
+  }
+  compiled_timer.Stop();
+
+  EXPECT_EQ(interpreted_matches, compiled_matches);
+
+  LOG_INFO("%s : %lu instructions, selectivity %.3lf", name.c_str(),
+           program->GetInstructionCount(),
+           (double)compiled_matches / (tuple_count * iterations));
+  LOG_INFO("%s : interpreted %.2lf ms, compiled %.2lf ms, speedup %.2lfx",
+           name.c_str(), interpreted_timer.GetDuration(),
+           compiled_timer.GetDuration(),
+           interpreted_timer.GetDuration() / compiled_timer.GetDuration());
+}
+
+TEST_F(ExpressionPerformanceTests, PredicateTest) {
+  const oid_t tuple_count = 100000;
+  const int iterations = 10;
+
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  // COL_A is 10 * id, COL_B is 10 * id + 1, COL_C is 10 * id + 2 and COL_D
+  // is the string form of 10 * id + 3.
+
+  // Q6-style range scan : COL_A >= 100000 AND COL_A < 600000 AND
+  // COL_C >= 200000.0 AND COL_B < 900000
+  std::unique_ptr<expression::AbstractExpression> range(
+      And(And(Compare(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                      Column(VALUE_TYPE_INTEGER, 0),
+                      ValueFactory::GetIntegerValue(100000)),
+              Compare(EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                      Column(VALUE_TYPE_INTEGER, 0),
+                      ValueFactory::GetIntegerValue(600000))),
+          And(Compare(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                      Column(VALUE_TYPE_DOUBLE, 2),
+                      ValueFactory::GetDoubleValue(200000.0)),
+              Compare(EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                      Column(VALUE_TYPE_INTEGER, 1),
+                      ValueFactory::GetIntegerValue(900000)))));
+  RunPredicate("range", range.get(), tile_group.get(), tuple_count,
+               iterations);
+
+  // Q1-style arithmetic filter : COL_C * 0.9 + COL_A > 500000.0
+  std::unique_ptr<expression::AbstractExpression> arithmetic(Compare(
+      EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+      expression::ExpressionUtil::OperatorFactory(
+          EXPRESSION_TYPE_OPERATOR_PLUS, VALUE_TYPE_DOUBLE,
+          expression::ExpressionUtil::OperatorFactory(
+              EXPRESSION_TYPE_OPERATOR_MULTIPLY, VALUE_TYPE_DOUBLE,
+              Column(VALUE_TYPE_DOUBLE, 2),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetDoubleValue(0.9))),
+          Column(VALUE_TYPE_INTEGER, 0)),
+      ValueFactory::GetDoubleValue(500000.0)));
+  RunPredicate("arithmetic", arithmetic.get(), tile_group.get(), tuple_count,
+               iterations);
+
+  // Point predicate on a string column : COL_D = '500003'
+  std::unique_ptr<expression::AbstractExpression> equality(
+      Compare(EXPRESSION_TYPE_COMPARE_EQUAL, Column(VALUE_TYPE_VARCHAR, 3),
+              ValueFactory::GetStringValue("500003")));
+  RunPredicate("string equality", equality.get(), tile_group.get(),
+               tuple_count, iterations);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// frozen_scan_performance_test.cpp
+//
+// Identification: test/performance/frozen_scan_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/expression_util.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tuple.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Frozen Scan Performance Tests
+//===--------------------------------------------------------------------===//
+
+class FrozenScanPerformanceTests : public PelotonTest {};
+
+// Order-like rows : a date-ish key in long runs, a small quantity, a price
+// and one of a few statuses
+static std::shared_ptr<storage::TileGroup> CreateOrderTileGroup(
+    oid_t tuple_count) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::AppendSchemaList(tile_group->GetTileSchemas()));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(tuple_itr / 1000),
+                   testing_pool);
+    tuple.SetValue(1, ValueFactory::GetIntegerValue((tuple_itr * 7919) % 50),
+                   testing_pool);
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(tuple_itr % 997),
+                   testing_pool);
+    tuple.SetValue(3, ValueFactory::GetStringValue(
+                          "status_" + std::to_string(tuple_itr % 4)),
+                   testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    oid_t tuple_slot_id = tile_group->InsertTuple(&tuple);
+    txn_manager.PerformInsert(
+        txn, ItemPointer(tile_group->GetTileGroupId(), tuple_slot_id),
+        index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+  return tile_group;
+}
+
+// Time COL_B < 10 AND COL_D = 'status_1', binding once per pass as a scan
+// binds once per tile group
+static size_t TimeScan(storage::TileGroup *tile_group, oid_t tuple_count,
+                       int iterations, double *duration) {
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LESSTHAN,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            0, 1),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(10))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_EQUAL,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetStringValue("status_1")))));
+  auto program = expression::CompiledExpression::Compile(
+      predicate.get(),
+      expression::CompiledExpression::GetColumnTypes(tile_group), {}, nullptr);
+  PL_ASSERT(program != nullptr);
+
+  size_t matches = 0;
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    program->Bind(0, tile_group);
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (program->EvaluatesTrue(tuple_id)) matches++;
+    }
+  }
+  timer.Stop();
+  *duration = timer.GetDuration();
+  return matches;
+}
+
+TEST_F(FrozenScanPerformanceTests, ScanTest) {
+  const oid_t tuple_count = 100000;
+  const int iterations = 10;
+
+  auto tile_group = CreateOrderTileGroup(tuple_count);
+
+  Timer<std::milli> freeze_timer;
+  freeze_timer.Start();
+  std::unique_ptr<storage::TileGroup> frozen_tile_group(
+      storage::TileGroupFactory::GetFrozenTileGroup(tile_group.get(), {}));
+  freeze_timer.Stop();
+
+  double hot_scan, frozen_scan;
+  size_t hot_matches =
+      TimeScan(tile_group.get(), tuple_count, iterations, &hot_scan);
+  size_t frozen_matches =
+      TimeScan(frozen_tile_group.get(), tuple_count, iterations, &frozen_scan);
+  EXPECT_EQ(hot_matches, frozen_matches);
+
+  int64_t hot_size = 0, frozen_size = 0;
+  for (oid_t tile_itr = 0; tile_itr < tile_group->NumTiles(); tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    hot_size += tile->GetInlinedSize();
+    if (tile->GetPool() != nullptr) {
+      hot_size += tile->GetPool()->GetAllocatedMemory();
+    }
+    frozen_size += frozen_tile_group->GetTile(tile_itr)->GetEncodedSize();
+  }
+
+  LOG_INFO("%u rows, froze in %.2lf ms", tuple_count,
+           freeze_timer.GetDuration());
+  LOG_INFO("size : hot %ld bytes, frozen %ld bytes (without dictionaries)",
+           hot_size, frozen_size);
+  LOG_INFO("scan : hot %.2lf ms, frozen %.2lf ms", hot_scan, frozen_scan);
+}
+
+}  // End test namespace
+}  // End peloton namespace
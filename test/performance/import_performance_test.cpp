@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// import_performance_test.cpp
+//
+// Identification: test/performance/import_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "planner/import_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Import Performance Tests
+//===--------------------------------------------------------------------===//
+
+class ImportPerformanceTests : public PelotonTest {};
+
+TEST_F(ImportPerformanceTests, BulkLoadTest) {
+  const int tuples_per_tile_group = 1000;
+  const int tuple_count = 200000;
+
+  // Tuple at a time, the way INSERT does it
+  std::unique_ptr<storage::DataTable> insert_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  Timer<std::milli> insert_timer;
+  insert_timer.Start();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(insert_table.get(), tuple_count, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+  insert_timer.Stop();
+
+  // The same tuples as CSV
+  std::string input;
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    input += std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_itr, 0)) +
+             "," +
+             std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_itr, 1)) +
+             "," +
+             std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_itr, 2)) +
+             "," +
+             std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_itr, 3)) +
+             "\n";
+  }
+
+  std::unique_ptr<storage::DataTable> import_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  planner::ImportPlan plan(import_table.get(), "",
+                           parser::ImportStatement::kImportCSV);
+  plan.SetInput(std::move(input));
+
+  Timer<std::milli> import_timer;
+  import_timer.Start();
+  bridge::PlanCursor cursor(&plan, {});
+  while (cursor.Next())
+    ;
+  auto status = cursor.Close();
+  import_timer.Stop();
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, status.m_result);
+  EXPECT_EQ(tuple_count, status.m_processed);
+  EXPECT_EQ(insert_table->GetTupleCount(), import_table->GetTupleCount());
+
+  LOG_INFO("%d tuples", tuple_count);
+  LOG_INFO("tuple at a time : %.2lf ms, %.0lf tuples/s",
+           insert_timer.GetDuration(),
+           tuple_count / (insert_timer.GetDuration() / 1000));
+  LOG_INFO("bulk import : %.2lf ms, %.0lf tuples/s",
+           import_timer.GetDuration(),
+           tuple_count / (import_timer.GetDuration() / 1000));
+}
+
+}  // End test namespace
+}  // End peloton namespace
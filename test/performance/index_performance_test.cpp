@@ -14,15 +14,28 @@
 #include "gtest/gtest.h"
 #include "common/harness.h"
 
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
 #include <vector>
 #include <thread>
 
+#include "catalog/manager.h"
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/container_tuple.h"
+#include "index/bwtree.h"
 #include "index/index_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "storage/tuple.h"
 
+#include "executor/executor_tests_util.h"
+
 namespace peloton {
 namespace test {
 
@@ -389,6 +402,221 @@ static void TestIndexPerformance(const IndexType& index_type) {
   return;
 }
 
+/*
+ * GetProcessStatus() - Returns a numeric field of /proc/self/status, e.g.
+ * Threads or VmRSS (in kB), or 0 if it is not available
+ */
+static size_t GetProcessStatus(const std::string &field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size() + 1, field + ":") == 0) {
+      return std::stoul(line.substr(field.size() + 1));
+    }
+  }
+  return 0;
+}
+
+/*
+ * ManyIndexesTest() - Reports the threads and memory used by a schema with
+ * many BwTree indexes, which share a single garbage collection thread
+ */
+TEST_F(IndexPerformanceTests, ManyIndexesTest) {
+  const size_t index_count = 500;
+  const size_t num_key = 1000;
+
+  auto &garbage_collector = index::GarbageCollector::GetInstance();
+  size_t thread_count = GetProcessStatus("Threads");
+  size_t vm_size = GetProcessStatus("VmSize");
+  size_t vm_rss = GetProcessStatus("VmRSS");
+  size_t registered_count = garbage_collector.GetRegisteredCount();
+
+  std::vector<std::unique_ptr<catalog::Schema>> tuple_schemas;
+  std::vector<std::unique_ptr<index::Index>> indexes;
+  std::unique_ptr<storage::Tuple> key;
+  for (size_t index_itr = 0; index_itr < index_count; index_itr++) {
+    indexes.emplace_back(BuildIndex(false, INDEX_TYPE_BWTREE));
+    tuple_schemas.emplace_back(tuple_schema);
+    if (key == nullptr) key.reset(new storage::Tuple(key_schema, true));
+
+    for (size_t key_itr = 0; key_itr < num_key; key_itr++) {
+      auto key_value = ValueFactory::GetIntegerValue(key_itr);
+      key->SetValue(0, key_value, nullptr);
+      key->SetValue(1, key_value, nullptr);
+      EXPECT_TRUE(indexes.back()->InsertEntry(key.get(), item0));
+    }
+  }
+
+  LOG_INFO("%lu BwTree indexes of %lu keys: %lu more threads, "
+           "%lu more kB of virtual memory, %lu more kB resident",
+           index_count, num_key, GetProcessStatus("Threads") - thread_count,
+           GetProcessStatus("VmSize") - vm_size,
+           GetProcessStatus("VmRSS") - vm_rss);
+
+  // A single thread collects the garbage of all of them
+  EXPECT_EQ(registered_count + index_count,
+            garbage_collector.GetRegisteredCount());
+  EXPECT_EQ(1, garbage_collector.GetThreadCount());
+  EXPECT_LE(GetProcessStatus("Threads"), thread_count + 1);
+
+  indexes.clear();
+  EXPECT_EQ(registered_count, garbage_collector.GetRegisteredCount());
+}
+
+/*
+ * BuildIndexTest() - Compares building an index on column A of a table by
+ * inserting its tuples one at a time with bulk loading them
+ */
+TEST_F(IndexPerformanceTests, BuildIndexTest) {
+  const int tuple_count = 200000;
+  const size_t run_count = std::max(1u, std::thread::hardware_concurrency());
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(10000, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<ItemPointer> locations;
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      locations.push_back(ItemPointer(tile_group->GetTileGroupId(), tuple_id));
+    }
+  }
+
+  std::vector<oid_t> key_attrs = {0};
+  for (auto index_type : {INDEX_TYPE_BTREE, INDEX_TYPE_BWTREE}) {
+    double durations[2];
+    for (int bulk_load = 0; bulk_load < 2; bulk_load++) {
+      auto index_key_schema =
+          catalog::Schema::CopySchema(table->GetSchema(), key_attrs);
+      index_key_schema->SetIndexedColumns(key_attrs);
+      std::unique_ptr<index::Index> index(
+          index::IndexFactory::GetInstance(new index::IndexMetadata(
+              "build_index", 127, index_type, INDEX_CONSTRAINT_TYPE_DEFAULT,
+              table->GetSchema(), index_key_schema, key_attrs, false)));
+
+      // A run of tile groups per thread, owned by the index once loaded
+      std::vector<std::vector<ItemPointer *>> runs(run_count);
+      for (size_t location_itr = 0;
+           bulk_load == 1 && location_itr < locations.size(); location_itr++) {
+        runs[location_itr * run_count / locations.size()].push_back(
+            new ItemPointer(locations[location_itr]));
+      }
+
+      Timer<> timer;
+      timer.Start();
+      if (bulk_load == 1) {
+        EXPECT_TRUE(index->BulkLoad(runs));
+      } else {
+        std::unique_ptr<storage::Tuple> key(
+            new storage::Tuple(index_key_schema, true));
+        for (auto &location : locations) {
+          auto tile_group =
+              catalog::Manager::GetInstance().GetTileGroup(location.block);
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), location.offset);
+          key->SetFromTuple(&tuple, key_attrs, index->GetPool());
+          index->InsertEntry(key.get(), location);
+        }
+      }
+      timer.Stop();
+      durations[bulk_load] = timer.GetDuration();
+
+      std::vector<ItemPointer *> location_ptrs;
+      index->ScanAllKeys(location_ptrs);
+      EXPECT_EQ(locations.size(), location_ptrs.size());
+    }
+
+    LOG_INFO("%d tuples, type = %d: inserted in %.3lf s, "
+             "bulk loaded in %.3lf s with %lu runs",
+             tuple_count, (int)index_type, durations[0], durations[1],
+             run_count);
+  }
+}
+
+/*
+ * LookupTest() - Reports the point lookups per second on indexes whose keys
+ * are made of 1, 2 and 8 BIGINT columns (8, 16 and 64 byte keys)
+ */
+TEST_F(IndexPerformanceTests, LookupTest) {
+  const size_t num_key = 100000;
+  const size_t num_lookup = 200000;
+
+  for (size_t column_count : {1, 2, 8}) {
+    std::vector<catalog::Column> columns;
+    for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
+      columns.push_back(catalog::Column(VALUE_TYPE_BIGINT,
+                                        GetTypeSize(VALUE_TYPE_BIGINT),
+                                        "K" + std::to_string(column_itr),
+                                        true));
+    }
+    std::vector<oid_t> key_attrs(column_count);
+    std::iota(key_attrs.begin(), key_attrs.end(), 0);
+    std::unique_ptr<catalog::Schema> table_schema(
+        new catalog::Schema(columns));
+
+    // The last column tells the keys apart, as in composite keys whose
+    // leading columns are shared by many rows
+    auto set_key = [column_count](storage::Tuple *key, size_t key_itr) {
+      for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
+        auto key_value = (column_itr + 1 == column_count) ? key_itr : 1;
+        key->SetValue(column_itr, ValueFactory::GetBigIntValue(key_value),
+                      nullptr);
+      }
+    };
+
+    for (auto index_type : {INDEX_TYPE_BTREE, INDEX_TYPE_BWTREE}) {
+      auto index_key_schema = new catalog::Schema(columns);
+      index_key_schema->SetIndexedColumns(key_attrs);
+      std::unique_ptr<index::Index> index(
+          index::IndexFactory::GetInstance(new index::IndexMetadata(
+              "lookup_index", 128, index_type, INDEX_CONSTRAINT_TYPE_DEFAULT,
+              table_schema.get(), index_key_schema, key_attrs, false)));
+
+      std::unique_ptr<storage::Tuple> key(
+          new storage::Tuple(index_key_schema, true));
+      for (size_t key_itr = 0; key_itr < num_key; key_itr++) {
+        set_key(key.get(), key_itr);
+        index->InsertEntry(key.get(), ItemPointer(key_itr, 0));
+      }
+
+      // Random keys, so that the searches inside nodes do not repeat
+      std::vector<std::unique_ptr<storage::Tuple>> lookup_keys;
+      std::mt19937 generator(0);
+      std::uniform_int_distribution<size_t> distribution(0, num_key - 1);
+      for (size_t key_itr = 0; key_itr < 1024; key_itr++) {
+        lookup_keys.emplace_back(new storage::Tuple(index_key_schema, true));
+        set_key(lookup_keys.back().get(), distribution(generator));
+      }
+
+      size_t found_count = 0;
+      std::vector<ItemPointer *> location_ptrs;
+      Timer<> timer;
+      timer.Start();
+      for (size_t lookup_itr = 0; lookup_itr < num_lookup; lookup_itr++) {
+        location_ptrs.clear();
+        index->ScanKey(lookup_keys[lookup_itr % lookup_keys.size()].get(),
+                       location_ptrs);
+        found_count += location_ptrs.size();
+      }
+      timer.Stop();
+      EXPECT_EQ(num_lookup, found_count);
+
+      LOG_INFO("%lu byte keys, type = %d (%s): %.0lf lookups/s",
+               column_count * sizeof(int64_t), (int)index_type,
+               index->GetTypeName().c_str(),
+               num_lookup / timer.GetDuration());
+    }
+  }
+}
+
 TEST_F(IndexPerformanceTests, MultiThreadedTest) {
   std::vector<IndexType> index_types = {INDEX_TYPE_BTREE};
 
@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_performance_test.cpp
+//
+// Identification: test/performance/join_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/nested_loop_index_join_plan.h"
+#include "planner/nested_loop_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Join Performance Tests
+//===--------------------------------------------------------------------===//
+
+class JoinPerformanceTests : public PelotonTest {};
+
+static storage::DataTable *CreatePopulatedTable(int tuple_count) {
+  auto table = ExecutorTestsUtil::CreateTable(1000, true);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+// Runs the join, returns the number of rows
+static int RunJoin(const planner::AbstractPlan *plan, double *duration) {
+  int rows = 0;
+  Timer<std::milli> timer;
+  timer.Start();
+  bridge::PlanCursor cursor(plan, {});
+  while (cursor.Next()) rows++;
+  EXPECT_EQ(Result::RESULT_SUCCESS, cursor.Close().m_result);
+  timer.Stop();
+
+  *duration = timer.GetDuration();
+  return rows;
+}
+
+static std::unique_ptr<const planner::ProjectInfo> CreateJoinProjection() {
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  return std::unique_ptr<const planner::ProjectInfo>(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+}
+
+TEST_F(JoinPerformanceTests, IndexJoinTest) {
+  const int outer_tuple_count = 1000;
+  const int inner_tuple_count = 20000;
+
+  std::unique_ptr<storage::DataTable> outer_table(
+      CreatePopulatedTable(outer_tuple_count));
+  std::unique_ptr<storage::DataTable> inner_table(
+      CreatePopulatedTable(inner_tuple_count));
+  std::shared_ptr<const catalog::Schema> schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(0)}));
+
+  // SELECT o.a, i.a FROM o, i WHERE o.a = i.a, comparing every pair
+  std::unique_ptr<const expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_EQUAL,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0,
+                                                        0),
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 1,
+                                                        0)));
+  planner::NestedLoopJoinPlan nested_loop_plan(
+      JOIN_TYPE_INNER, std::move(predicate), CreateJoinProjection(), schema);
+  std::unique_ptr<planner::AbstractPlan> outer_scan(
+      new planner::SeqScanPlan(outer_table.get(), nullptr, {0}));
+  std::unique_ptr<planner::AbstractPlan> inner_scan(
+      new planner::SeqScanPlan(inner_table.get(), nullptr, {0}));
+  nested_loop_plan.AddChild(std::move(outer_scan));
+  nested_loop_plan.AddChild(std::move(inner_scan));
+
+  // The same join probing the primary key of the inner table
+  planner::NestedLoopIndexJoinPlan index_plan(
+      JOIN_TYPE_INNER, nullptr, CreateJoinProjection(), schema,
+      inner_table.get(), {0}, inner_table->GetIndex(0), {0},
+      {EXPRESSION_TYPE_COMPARE_EQUAL}, {ValueFactory::GetNullValue()}, {0});
+  outer_scan.reset(new planner::SeqScanPlan(outer_table.get(), nullptr, {0}));
+  index_plan.AddChild(std::move(outer_scan));
+
+  double nested_loop_duration, index_duration;
+  EXPECT_EQ(outer_tuple_count,
+            RunJoin(&nested_loop_plan, &nested_loop_duration));
+  EXPECT_EQ(outer_tuple_count, RunJoin(&index_plan, &index_duration));
+
+  LOG_INFO("%d outer tuples, %d inner tuples", outer_tuple_count,
+           inner_tuple_count);
+  LOG_INFO("nested loop join : %.2lf ms", nested_loop_duration);
+  LOG_INFO("nested loop index join : %.2lf ms", index_duration);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// prepared_statement_performance_test.cpp
+//
+// Identification: test/performance/prepared_statement_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Prepared Statement Performance Tests
+//===--------------------------------------------------------------------===//
+
+class PreparedStatementPerformanceTests : public PelotonTest {};
+
+// Look up every key once, returns the number of rows found
+static int RunLookups(const planner::AbstractPlan *plan, int key_count,
+                      bool reuse, double *duration) {
+  std::unique_ptr<bridge::PlanCursor> cursor;
+  std::vector<Value> params(1);
+  int found = 0;
+
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    params[0] = ValueFactory::GetIntegerValue(
+        ExecutorTestsUtil::PopulatedValue(key_itr, 0));
+
+    // A new executor tree per execution, or the one of the last execution
+    if (reuse == false || cursor == nullptr ||
+        cursor->Reopen(params) == false) {
+      cursor.reset(new bridge::PlanCursor(plan, params));
+    }
+
+    while (cursor->Next()) found++;
+    EXPECT_EQ(Result::RESULT_SUCCESS, cursor->Close().m_result);
+  }
+  timer.Stop();
+
+  *duration = timer.GetDuration();
+  return found;
+}
+
+TEST_F(PreparedStatementPerformanceTests, PointLookupTest) {
+  const int tuples_per_tile_group = 1000;
+  const int tile_group_count = 50;
+  const int key_count = tuples_per_tile_group * tile_group_count;
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), key_count, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+
+  // SELECT a, b FROM t WHERE a = $1, on the primary key
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(0), {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+      {ValueFactory::GetBindingOnlyIntegerValue(0)}, {});
+  planner::IndexScanPlan node(table.get(), nullptr, {0, 1}, index_scan_desc);
+
+  double fresh_duration, reused_duration;
+  EXPECT_EQ(key_count, RunLookups(&node, key_count, false, &fresh_duration));
+  EXPECT_EQ(key_count, RunLookups(&node, key_count, true, &reused_duration));
+
+  LOG_INFO("%d point lookups", key_count);
+  LOG_INFO("executor tree per lookup : %.2lf ms, %.2lf us/lookup",
+           fresh_duration, fresh_duration * 1000 / key_count);
+  LOG_INFO("reused executor tree : %.2lf ms, %.2lf us/lookup", reused_duration,
+           reused_duration * 1000 / key_count);
+}
+
+}  // End test namespace
+}  // End peloton namespace
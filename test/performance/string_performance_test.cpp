@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_performance_test.cpp
+//
+// Identification: test/performance/string_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "expression/comparison_expression.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// String Predicate Performance Tests
+//===--------------------------------------------------------------------===//
+
+class StringPerformanceTests : public PelotonTest {};
+
+// Count the rows on which the predicate holds
+static size_t CountMatches(expression::AbstractExpression *predicate,
+                           storage::TileGroup *tile_group, oid_t tuple_count,
+                           int iterations) {
+  size_t matches = 0;
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue()) {
+        matches++;
+      }
+    }
+  }
+  return matches;
+}
+
+// Time COL_D LIKE pattern with Value::Like, the precompiled pattern and the
+// compiled program
+static void RunLike(const std::string &pattern, storage::TileGroup *tile_group,
+                    oid_t tuple_count, int iterations) {
+  // Value::Like re-parses the pattern for every row
+  std::unique_ptr<expression::AbstractExpression> reparsed(
+      new expression::ComparisonExpression<expression::CmpLike>(
+          EXPRESSION_TYPE_COMPARE_LIKE,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetStringValue(pattern))));
+
+  // The factory builds a LikeExpression over the precompiled pattern
+  std::unique_ptr<expression::AbstractExpression> precompiled(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_LIKE,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                        3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetStringValue(pattern))));
+
+  Timer<std::milli> reparsed_timer;
+  reparsed_timer.Start();
+  size_t reparsed_matches =
+      CountMatches(reparsed.get(), tile_group, tuple_count, iterations);
+  reparsed_timer.Stop();
+
+  Timer<std::milli> precompiled_timer;
+  precompiled_timer.Start();
+  size_t precompiled_matches =
+      CountMatches(precompiled.get(), tile_group, tuple_count, iterations);
+  precompiled_timer.Stop();
+
+  auto program = expression::CompiledExpression::Compile(
+      precompiled.get(),
+      expression::CompiledExpression::GetColumnTypes(tile_group), {}, nullptr);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_TRUE(program->Bind(0, tile_group));
+
+  size_t compiled_matches = 0;
+  Timer<std::milli> compiled_timer;
+  compiled_timer.Start();
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (program->EvaluatesTrue(tuple_id)) {
+        compiled_matches++;
+      }
+    }
+  }
+  compiled_timer.Stop();
+
+  EXPECT_EQ(reparsed_matches, precompiled_matches);
+  EXPECT_EQ(reparsed_matches, compiled_matches);
+
+  LOG_INFO("LIKE '%s' : %lu matches, Value::Like %.2lf ms, precompiled "
+           "%.2lf ms, compiled %.2lf ms",
+           pattern.c_str(), compiled_matches, reparsed_timer.GetDuration(),
+           precompiled_timer.GetDuration(), compiled_timer.GetDuration());
+}
+
+TEST_F(StringPerformanceTests, LikeTest) {
+  const oid_t tuple_count = 100000;
+  const int iterations = 10;
+
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  // COL_D is the string form of 10 * id + 3
+
+  // prefix, suffix, contains and general shapes
+  RunLike("12%", tile_group.get(), tuple_count, iterations);
+  RunLike("%73", tile_group.get(), tuple_count, iterations);
+  RunLike("%345%", tile_group.get(), tuple_count, iterations);
+  RunLike("1%2_3", tile_group.get(), tuple_count, iterations);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wire_format_performance_test.cpp
+//
+// Identification: test/performance/wire_format_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "wire/marshal.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Wire Format Performance Tests
+//===--------------------------------------------------------------------===//
+
+class WireFormatPerformanceTests : public PelotonTest {};
+
+// Encode a value in binary and decode it back as a bind parameter would be
+static Value RoundTrip(const Value &value, PostgresValueType type) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  wire::PacketPutValue(pkt, value, type, BINARY_FORMAT_CODE);
+
+  // skip the length
+  wire::PktBuf data(pkt->buf.begin() + 4, pkt->buf.end());
+  EXPECT_EQ(data.size(), wire::PacketGetInt(pkt.get(), 4));
+
+  Value result;
+  EXPECT_TRUE(wire::PacketGetBinaryValue(data, type, result));
+  return result;
+}
+
+TEST_F(WireFormatPerformanceTests, RoundTripTest) {
+  std::vector<std::pair<Value, PostgresValueType>> values = {
+      {ValueFactory::GetSmallIntValue(-1234), POSTGRES_VALUE_TYPE_SMALLINT},
+      {ValueFactory::GetIntegerValue(-123456789), POSTGRES_VALUE_TYPE_INTEGER},
+      {ValueFactory::GetBigIntValue(-1234567890123L),
+       POSTGRES_VALUE_TYPE_BIGINT},
+      {ValueFactory::GetDoubleValue(-3.25), POSTGRES_VALUE_TYPE_DOUBLE},
+      {ValueFactory::GetDoubleValue(0.5), POSTGRES_VALUE_TYPE_REAL},
+      {ValueFactory::GetTimestampValue(1467000000123456L),
+       POSTGRES_VALUE_TYPE_TIMESTAMPS},
+      {ValueFactory::GetStringValue("peloton"), POSTGRES_VALUE_TYPE_TEXT},
+      {ValueFactory::GetDecimalValueFromString("-12345.0067"),
+       POSTGRES_VALUE_TYPE_DECIMAL},
+      {ValueFactory::GetDecimalValueFromString("0.000000000001"),
+       POSTGRES_VALUE_TYPE_DECIMAL},
+      {ValueFactory::GetDecimalValueFromString("0"),
+       POSTGRES_VALUE_TYPE_DECIMAL}};
+
+  for (auto &entry : values) {
+    auto result = RoundTrip(entry.first, entry.second);
+    EXPECT_EQ(VALUE_COMPARE_EQUAL, entry.first.Compare(result))
+        << entry.first.GetInfo() << " came back as " << result.GetInfo();
+  }
+
+  // Booleans can't be compared
+  EXPECT_TRUE(RoundTrip(ValueFactory::GetBooleanValue(true),
+                        POSTGRES_VALUE_TYPE_BOOLEAN).IsTrue());
+
+  // Postgres binary timestamps count from 2000-01-01
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  wire::PacketPutValue(pkt, ValueFactory::GetTimestampValue(946684800000000L),
+                       POSTGRES_VALUE_TYPE_TIMESTAMPS, BINARY_FORMAT_CODE);
+  EXPECT_EQ(wire::PktBuf({0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0}), pkt->buf);
+
+  // 12345.0067 is 1,2345 and 0067 in base 10000 digits
+  pkt.reset(new wire::Packet());
+  wire::PacketPutValue(
+      pkt, ValueFactory::GetDecimalValueFromString("12345.0067"),
+      POSTGRES_VALUE_TYPE_DECIMAL, BINARY_FORMAT_CODE);
+  EXPECT_EQ(wire::PktBuf({0, 0, 0, 14, 0, 3, 0, 1, 0, 0, 0, 12, 0, 1, 0x09,
+                          0x29, 0, 67}),
+            pkt->buf);
+}
+
+// Serialize every row of the scan in the given format, as Execute would
+static size_t TimeSerialize(const planner::AbstractPlan *plan,
+                            const std::vector<PostgresValueType> &types,
+                            int format, double *duration) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  size_t bytes = 0;
+
+  Timer<std::milli> timer;
+  timer.Start();
+  bridge::PlanCursor cursor(plan, {});
+  while (cursor.Next()) {
+    auto tile = cursor.GetTile();
+    auto tuple_id = cursor.GetTupleId();
+
+    pkt->buf.clear();
+    pkt->len = 0;
+    wire::PacketPutInt(pkt, types.size(), 2);
+    for (oid_t column_itr = 0; column_itr < types.size(); column_itr++) {
+      wire::PacketPutValue(pkt, tile->GetValue(tuple_id, column_itr),
+                           types[column_itr], format);
+    }
+    bytes += pkt->len;
+  }
+  cursor.Close();
+  timer.Stop();
+
+  *duration = timer.GetDuration();
+  return bytes;
+}
+
+TEST_F(WireFormatPerformanceTests, SerializeTest) {
+  const int tuples_per_tile_group = 10000;
+  const int tile_group_count = 20;
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(),
+                                   tuples_per_tile_group * tile_group_count,
+                                   false, true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Numeric-heavy result : two integers and a double
+  planner::SeqScanPlan node(table.get(), nullptr, {0, 1, 2});
+  std::vector<PostgresValueType> types = {POSTGRES_VALUE_TYPE_INTEGER,
+                                          POSTGRES_VALUE_TYPE_INTEGER,
+                                          POSTGRES_VALUE_TYPE_DOUBLE};
+
+  double text_duration, binary_duration;
+  size_t text_bytes =
+      TimeSerialize(&node, types, TEXT_FORMAT_CODE, &text_duration);
+  size_t binary_bytes =
+      TimeSerialize(&node, types, BINARY_FORMAT_CODE, &binary_duration);
+  EXPECT_GT(text_bytes, 0);
+  EXPECT_GT(binary_bytes, 0);
+
+  LOG_INFO("%d rows", tuples_per_tile_group * tile_group_count);
+  LOG_INFO("text : %.2lf ms, %lu bytes", text_duration, text_bytes);
+  LOG_INFO("binary : %.2lf ms, %lu bytes", binary_duration, binary_bytes);
+}
+
+}  // End test namespace
+}  // End peloton namespace
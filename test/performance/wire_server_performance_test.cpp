@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wire_server_performance_test.cpp
+//
+// Identification: test/performance/wire_server_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/config.h"
+#include "common/timer.h"
+#include "wire/libevent_server.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Wire Server Performance Tests
+//===--------------------------------------------------------------------===//
+
+class WireServerPerformanceTests : public PelotonTest {};
+
+static bool SendBytes(int fd, const std::vector<unsigned char> &bytes) {
+  size_t sent = 0;
+  while (sent < bytes.size()) {
+    ssize_t count = send(fd, bytes.data() + sent, bytes.size() - sent, 0);
+    if (count <= 0) return false;
+    sent += count;
+  }
+  return true;
+}
+
+static bool ReceiveBytes(int fd, unsigned char *bytes, size_t len) {
+  size_t received = 0;
+  while (received < len) {
+    ssize_t count = recv(fd, bytes + received, len - received, 0);
+    if (count <= 0) return false;
+    received += count;
+  }
+  return true;
+}
+
+// Read messages until ReadyForQuery
+static bool WaitForReady(int fd) {
+  for (;;) {
+    unsigned char header[5];
+    if (!ReceiveBytes(fd, header, sizeof(header))) return false;
+    uint32_t len;
+    memcpy(&len, header + 1, sizeof(len));
+    std::vector<unsigned char> body(ntohl(len) - sizeof(len));
+    if (!ReceiveBytes(fd, body.data(), body.size())) return false;
+    if (header[0] == 'Z') return true;
+  }
+}
+
+// Open a session, returns -1 on failure
+static int Connect(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+
+  struct timeval timeout = {10, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+
+  // Startup packet : length, protocol 3.0 and the options
+  std::string options("user\0postgres\0database\0default\0\0", 32);
+  uint32_t len = htonl(8 + options.size());
+  uint32_t version = htonl(3 << 16);
+  std::vector<unsigned char> startup(8);
+  memcpy(startup.data(), &len, 4);
+  memcpy(startup.data() + 4, &version, 4);
+  startup.insert(startup.end(), options.begin(), options.end());
+
+  if (!SendBytes(fd, startup) || !WaitForReady(fd)) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Each generator thread drives its connections in lock step : a Sync on
+// every one of them, then every ReadyForQuery
+static void GenerateLoad(std::vector<int> connections, int rounds,
+                         std::atomic<size_t> *round_trips) {
+  const std::vector<unsigned char> sync = {'S', 0, 0, 0, 4};
+  unsigned char ready[6];
+
+  for (int round = 0; round < rounds; round++) {
+    for (auto fd : connections) {
+      if (!SendBytes(fd, sync)) return;
+    }
+    for (auto fd : connections) {
+      if (!ReceiveBytes(fd, ready, sizeof(ready)) || ready[0] != 'Z') return;
+      (*round_trips)++;
+    }
+  }
+}
+
+static double RunLoad(int port, int loop_count, int connection_count,
+                      int generator_count, size_t round_trips_per_run) {
+  FLAGS_port = port;
+  FLAGS_event_loops = loop_count;
+  FLAGS_socket_family = "AF_INET";
+
+  wire::Server server;
+  std::thread server_thread([&server] { server.StartServer(); });
+
+  std::vector<std::vector<int>> connections(generator_count);
+  for (int connection_itr = 0; connection_itr < connection_count;
+       connection_itr++) {
+    int fd = Connect(port);
+    EXPECT_GE(fd, 0);
+    if (fd >= 0) connections[connection_itr % generator_count].push_back(fd);
+  }
+
+  // Connections are spread round-robin over the loops
+  size_t min_count = connection_count, max_count = 0;
+  for (size_t loop_itr = 0; loop_itr < server.GetLoopCount(); loop_itr++) {
+    auto count = server.GetLoop(loop_itr)->GetConnectionCount();
+    min_count = std::min(min_count, count);
+    max_count = std::max(max_count, count);
+  }
+  EXPECT_LE(max_count - min_count, 1);
+
+  int rounds = round_trips_per_run / connection_count;
+  std::atomic<size_t> round_trips(0);
+  std::vector<std::thread> generators;
+
+  Timer<std::milli> timer;
+  timer.Start();
+  for (auto &generator_connections : connections) {
+    generators.push_back(std::thread(GenerateLoad, generator_connections,
+                                     rounds, &round_trips));
+  }
+  for (auto &generator : generators) {
+    generator.join();
+  }
+  timer.Stop();
+  EXPECT_EQ(rounds * connection_count, round_trips);
+
+  for (auto &generator_connections : connections) {
+    for (auto fd : generator_connections) close(fd);
+  }
+  server.CloseServer();
+  server_thread.join();
+
+  return round_trips / (timer.GetDuration() / 1000);
+}
+
+TEST_F(WireServerPerformanceTests, ConnectionScalingTest) {
+  const int port = 15721;
+  const size_t round_trips_per_run = 100000;
+  const int generator_count = 4;
+  int core_count = std::max(1u, std::thread::hardware_concurrency());
+
+  // A single loop against one per core
+  std::vector<int> loop_counts = {1};
+  if (core_count > 1) loop_counts.push_back(core_count);
+
+  for (int connection_count : {4, 64, 256}) {
+    for (int loop_count : loop_counts) {
+      double throughput = RunLoad(port, loop_count, connection_count,
+                                  generator_count, round_trips_per_run);
+      LOG_INFO("%d connections, %d loops : %.0lf round trips/s",
+               connection_count, loop_count, throughput);
+    }
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
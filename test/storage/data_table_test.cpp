@@ -10,10 +10,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <thread>
+
 #include "common/harness.h"
 
+#include "catalog/schema.h"
+#include "common/value_factory.h"
+#include "index/index_factory.h"
+#include "optimizer/plan_cache.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
+#include "storage/tuple.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_tests_util.h"
 
@@ -88,5 +95,106 @@ TEST_F(DataTableTests, GlobalTableTest) {
   delete data_table_pointer;
 }
 
+TEST_F(DataTableTests, OnlineIndexBuildTest) {
+  const int tuple_count = 50;
+
+  // The tuples are inserted while the table has no index
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(10, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Index on the second column
+  auto tuple_schema = data_table->GetSchema();
+  std::vector<oid_t> key_attrs = {1};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto index_metadata = new index::IndexMetadata(
+      "online_index", 125, INDEX_TYPE_BWTREE, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      tuple_schema, key_schema, key_attrs, false);
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetInstance(index_metadata));
+
+  data_table->AddIndexOnline(index);
+  EXPECT_FALSE(index->IsReadable());
+  txn_manager.WaitForRunningTransactions();
+
+  // A plan cached while the index cannot be scanned
+  auto &plan_cache = optimizer::PlanCache::GetInstance();
+  plan_cache.Insert(
+      std::make_shared<optimizer::CachedPlan>("select * from t where a = $1"));
+  EXPECT_NE(nullptr, plan_cache.Find("select * from t where a = $1"));
+
+  // A writer inserts as many tuples while the index is built
+  std::thread writer([&data_table, &txn_manager, tuple_count]() {
+    auto pool = TestingHarness::GetInstance().GetTestingPool();
+    for (int tuple_id = tuple_count; tuple_id < 2 * tuple_count; tuple_id++) {
+      auto tuple =
+          ExecutorTestsUtil::GetTuple(data_table.get(), tuple_id, pool);
+      auto txn = txn_manager.BeginTransaction();
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          data_table->InsertTuple(tuple.get(), txn, &index_entry_ptr);
+      EXPECT_NE(INVALID_OID, location.block);
+      txn_manager.PerformInsert(txn, location, index_entry_ptr);
+      txn_manager.CommitTransaction(txn);
+    }
+  });
+
+  // A tile group at a time, across two threads
+  size_t build_count = 0;
+  while (data_table->BuildIndex(index, 1, 2, 0) == false) {
+    build_count++;
+  }
+  writer.join();
+  EXPECT_TRUE(index->IsReadable());
+  EXPECT_LT(0, build_count);
+  EXPECT_EQ(nullptr, plan_cache.Find("select * from t where a = $1"));
+
+  // The tile groups added since are maintained by the writers
+  EXPECT_TRUE(data_table->BuildIndex(index, 1, 2, 0));
+  EXPECT_EQ(data_table->GetTileGroupCount(), index->GetIndexedTileGroupOff());
+
+  // Tuples written during the build are found once, like the others
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  for (int tuple_id = 0; tuple_id < 2 * tuple_count; tuple_id++) {
+    key->SetValue(0, ValueFactory::GetIntegerValue(
+                         ExecutorTestsUtil::PopulatedValue(tuple_id, 1)),
+                  nullptr);
+    std::vector<ItemPointer *> locations;
+    index->ScanKey(key.get(), locations);
+    EXPECT_EQ(1, locations.size());
+  }
+}
+
+TEST_F(DataTableTests, OnlineUniqueIndexBuildTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(10, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), 50, false, false, false,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto tuple_schema = data_table->GetSchema();
+  std::vector<oid_t> key_attrs = {0};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto index_metadata = new index::IndexMetadata(
+      "online_unique_index", 126, INDEX_TYPE_BWTREE,
+      INDEX_CONSTRAINT_TYPE_UNIQUE, tuple_schema, key_schema, key_attrs, true);
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetInstance(index_metadata));
+
+  // The writers do not maintain unique indexes, scans never read it
+  data_table->AddIndexOnline(index);
+  EXPECT_TRUE(data_table->BuildIndex(index, 1, 2, 0));
+  EXPECT_FALSE(index->IsReadable());
+  EXPECT_EQ(data_table->GetTileGroupCount(), index->GetIndexedTileGroupOff());
+}
+
 }  // End test namespace
 }  // End peloton namespace
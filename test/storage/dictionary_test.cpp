@@ -0,0 +1,292 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary_test.cpp
+//
+// Identification: test/storage/dictionary_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/data_table.h"
+#include "storage/dictionary.h"
+#include "storage/table_factory.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Dictionary Tests
+//===--------------------------------------------------------------------===//
+
+class DictionaryTests : public PelotonTest {};
+
+static const int tuple_count = 64;
+
+static const int distinct_count = 5;
+
+// Fill the tile group with COL_D cycling through a few strings
+static void PopulateLowCardinality(
+    std::shared_ptr<storage::TileGroup> tile_group,
+    int populate_count = tuple_count) {
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::AppendSchemaList(tile_group->GetTileSchemas()));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  for (int tuple_itr = 0; tuple_itr < populate_count; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(tuple_itr), testing_pool);
+    tuple.SetValue(1, ValueFactory::GetIntegerValue(tuple_itr), testing_pool);
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(tuple_itr), testing_pool);
+    Value string_value = ValueFactory::GetStringValue(
+        "status_" + std::to_string(tuple_itr % distinct_count));
+    tuple.SetValue(3, string_value, testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    oid_t tuple_slot_id = tile_group->InsertTuple(&tuple);
+    txn_manager.PerformInsert(
+        txn, ItemPointer(tile_group->GetTileGroupId(), tuple_slot_id),
+        index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(DictionaryTests, EncodeTest) {
+  storage::Dictionary dictionary(BACKEND_TYPE_MM);
+  std::string first = "shipped", second = "returned";
+
+  storage::Dictionary::Code first_code, second_code, code;
+  EXPECT_TRUE(dictionary.Encode(first.data(), first.size(), &first_code));
+  EXPECT_TRUE(dictionary.Encode(second.data(), second.size(), &second_code));
+  EXPECT_NE(first_code, second_code);
+
+  // Encoding again gives the same code
+  EXPECT_TRUE(dictionary.Encode(first.data(), first.size(), &code));
+  EXPECT_EQ(first_code, code);
+  EXPECT_EQ(2, dictionary.GetEntryCount());
+
+  EXPECT_TRUE(dictionary.Lookup(second.data(), second.size(), &code));
+  EXPECT_EQ(second_code, code);
+  EXPECT_FALSE(dictionary.Lookup("lost", 4, &code));
+
+  const char *data;
+  int32_t length;
+  dictionary.GetString(first_code, &data, &length);
+  EXPECT_EQ(first, std::string(data, length));
+  EXPECT_EQ(std::hash<std::string>()(first), dictionary.GetHash(first_code));
+}
+
+TEST_F(DictionaryTests, TileGroupTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateLowCardinality(tile_group);
+
+  std::shared_ptr<storage::Dictionary> dictionary(
+      new storage::Dictionary(BACKEND_TYPE_MM));
+
+  // Only uninlined varchar columns can be encoded
+  EXPECT_FALSE(tile_group->EncodeDictionary(0, dictionary));
+  EXPECT_TRUE(tile_group->EncodeDictionary(3, dictionary));
+  EXPECT_EQ(distinct_count, dictionary->GetEntryCount());
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    // Values read the same after encoding
+    std::string expected = "status_" + std::to_string(tuple_id % distinct_count);
+    Value value = tile_group->GetValue(tuple_id, 3);
+    EXPECT_EQ(VALUE_COMPARE_EQUAL,
+              value.Compare(ValueFactory::GetStringValue(expected)));
+
+    const storage::Dictionary *tuple_dictionary;
+    storage::Dictionary::Code code, expected_code;
+    EXPECT_TRUE(
+        tile_group->GetDictionaryCode(tuple_id, 3, &tuple_dictionary, &code));
+    EXPECT_EQ(dictionary.get(), tuple_dictionary);
+    EXPECT_TRUE(
+        dictionary->Lookup(expected.data(), expected.size(), &expected_code));
+    EXPECT_EQ(expected_code, code);
+  }
+
+  // Columns that are not encoded have no codes
+  const storage::Dictionary *tuple_dictionary;
+  storage::Dictionary::Code code;
+  EXPECT_FALSE(tile_group->GetDictionaryCode(0, 2, &tuple_dictionary, &code));
+}
+
+TEST_F(DictionaryTests, WrittenTileGroupTest) {
+  std::shared_ptr<storage::Dictionary> dictionary(
+      new storage::Dictionary(BACKEND_TYPE_MM));
+
+  // A tile group that still takes inserts is left alone
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateLowCardinality(tile_group, tuple_count / 2);
+  EXPECT_FALSE(tile_group->EncodeDictionary(3, dictionary));
+
+  // So is one with a version owned by a running transaction
+  tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateLowCardinality(tile_group);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(txn_manager.AcquireOwnership(txn, tile_group->GetHeader(), 0));
+  EXPECT_FALSE(tile_group->EncodeDictionary(3, dictionary));
+  txn_manager.YieldOwnership(txn, tile_group->GetTileGroupId(), 0);
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_TRUE(tile_group->EncodeDictionary(3, dictionary));
+  const storage::Dictionary *tuple_dictionary;
+  storage::Dictionary::Code code;
+  EXPECT_TRUE(tile_group->GetDictionaryCode(0, 3, &tuple_dictionary, &code));
+}
+
+TEST_F(DictionaryTests, HashAndEqualityTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateLowCardinality(tile_group);
+
+  // Hash join and hash executor keys are container tuples over logical tiles
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  std::vector<oid_t> column_ids = {3};
+
+  // Hash codes before encoding
+  std::vector<size_t> hashes;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    expression::ContainerTuple<executor::LogicalTile> tuple(
+        logical_tile.get(), tuple_id, &column_ids);
+    hashes.push_back(tuple.HashCode());
+  }
+
+  std::shared_ptr<storage::Dictionary> dictionary(
+      new storage::Dictionary(BACKEND_TYPE_MM));
+  EXPECT_TRUE(tile_group->EncodeDictionary(3, dictionary));
+
+  // Hashing codes must match hashing values, so encoded and plain tiles can
+  // meet in the same hash table
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    expression::ContainerTuple<executor::LogicalTile> tuple(
+        logical_tile.get(), tuple_id, &column_ids);
+    EXPECT_EQ(hashes[tuple_id], tuple.HashCode());
+
+    // the first row with the same string, and a row with another one
+    expression::ContainerTuple<executor::LogicalTile> same(
+        logical_tile.get(), tuple_id % distinct_count, &column_ids);
+    expression::ContainerTuple<executor::LogicalTile> other(
+        logical_tile.get(), (tuple_id + 1) % distinct_count, &column_ids);
+    EXPECT_TRUE(tuple.EqualsNoSchemaCheck(same));
+    EXPECT_FALSE(tuple.EqualsNoSchemaCheck(other));
+  }
+}
+
+TEST_F(DictionaryTests, CompiledEqualityTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateLowCardinality(tile_group);
+
+  std::shared_ptr<storage::Dictionary> dictionary(
+      new storage::Dictionary(BACKEND_TYPE_MM));
+  EXPECT_TRUE(tile_group->EncodeDictionary(3, dictionary));
+
+  // present and absent constants, both operand orders
+  std::vector<std::unique_ptr<expression::AbstractExpression>> predicates;
+  for (auto constant : {"status_2", "status_9"}) {
+    predicates.emplace_back(expression::ExpressionUtil::ComparisonFactory(
+        EXPRESSION_TYPE_COMPARE_EQUAL,
+        expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0, 3),
+        expression::ExpressionUtil::ConstantValueFactory(
+            ValueFactory::GetStringValue(constant))));
+    predicates.emplace_back(expression::ExpressionUtil::ComparisonFactory(
+        EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+        expression::ExpressionUtil::ConstantValueFactory(
+            ValueFactory::GetStringValue(constant)),
+        expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0,
+                                                      3)));
+  }
+
+  for (auto &predicate : predicates) {
+    auto program = expression::CompiledExpression::Compile(
+        predicate.get(),
+        expression::CompiledExpression::GetColumnTypes(tile_group.get()), {},
+        nullptr);
+    ASSERT_TRUE(program != nullptr);
+    ASSERT_TRUE(program->Bind(0, tile_group.get()));
+
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_id);
+      EXPECT_EQ(predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue(),
+                program->EvaluatesTrue(tuple_id));
+    }
+  }
+}
+
+TEST_F(DictionaryTests, DataTableTest) {
+  // COL_D is dictionary encoded, COL_C can't be
+  auto column_c = ExecutorTestsUtil::GetColumnInfo(2);
+  auto column_d = ExecutorTestsUtil::GetColumnInfo(3);
+  column_c.SetDictionaryEncoded(true);
+  column_d.SetDictionaryEncoded(true);
+  EXPECT_FALSE(column_c.IsDictionaryEncoded());
+
+  catalog::Schema *table_schema =
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(1), column_c,
+                           column_d});
+  EXPECT_TRUE(table_schema->IsDictionaryEncoded(3));
+
+  std::unique_ptr<storage::DataTable> table(storage::TableFactory::GetDataTable(
+      INVALID_OID, INVALID_OID, table_schema, "DICTIONARY_TABLE", tuple_count,
+      true, false));
+  EXPECT_TRUE(table->GetDictionary(2) == nullptr);
+  ASSERT_TRUE(table->GetDictionary(3) != nullptr);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto tile_group = table->GetTileGroup(0);
+  auto tile = tile_group->GetTile(tile_group->GetTileIdFromColumnId(3));
+  auto plain_memory = tile->GetPool()->GetAllocatedMemory();
+
+  EXPECT_TRUE(table->EncodeTileGroup(0));
+  EXPECT_EQ(tuple_count, table->GetDictionary(3)->GetEntryCount());
+
+  // The tile's copies of the strings are gone
+  tile = tile_group->GetTile(tile_group->GetTileIdFromColumnId(3));
+  EXPECT_LT(tile->GetPool()->GetAllocatedMemory(), plain_memory);
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    const storage::Dictionary *dictionary;
+    storage::Dictionary::Code code;
+    EXPECT_TRUE(tile_group->GetDictionaryCode(tuple_id, 3, &dictionary, &code));
+    EXPECT_EQ(table->GetDictionary(3).get(), dictionary);
+    auto expected = std::to_string(
+        ExecutorTestsUtil::PopulatedValue(tuple_id, 3));
+    EXPECT_EQ(VALUE_COMPARE_EQUAL,
+              tile_group->GetValue(tuple_id, 3).Compare(
+                  ValueFactory::GetStringValue(expected)));
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,343 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// frozen_tile_group_test.cpp
+//
+// Identification: test/storage/frozen_tile_group_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "catalog/manager.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/compiled_expression.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/data_table.h"
+#include "storage/encoded_column.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "storage/zone_map.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Frozen Tile Group Tests
+//===--------------------------------------------------------------------===//
+
+class FrozenTileGroupTests : public PelotonTest {};
+
+static const int tuple_count = 200;
+
+// COL_A has long runs, COL_B a narrow range with NULLs, COL_C doubles and
+// COL_D a few strings with NULLs
+static void PopulateColdTileGroup(
+    std::shared_ptr<storage::TileGroup> tile_group) {
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::AppendSchemaList(tile_group->GetTileSchemas()));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(tuple_itr / 50),
+                   testing_pool);
+    if (tuple_itr % 10 == 0) {
+      tuple.SetValue(1, ValueFactory::GetNullValueByType(VALUE_TYPE_INTEGER),
+                     testing_pool);
+    } else {
+      tuple.SetValue(
+          1, ValueFactory::GetIntegerValue(5000 + (tuple_itr * 37) % 1000),
+          testing_pool);
+    }
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(tuple_itr * 1.5),
+                   testing_pool);
+    if (tuple_itr % 7 == 0) {
+      tuple.SetValue(3, ValueFactory::GetNullStringValue(), testing_pool);
+    } else {
+      tuple.SetValue(3, ValueFactory::GetStringValue(
+                            "status_" + std::to_string(tuple_itr % 5)),
+                     testing_pool);
+    }
+
+    ItemPointer *index_entry_ptr = nullptr;
+    oid_t tuple_slot_id = tile_group->InsertTuple(&tuple);
+    txn_manager.PerformInsert(
+        txn, ItemPointer(tile_group->GetTileGroupId(), tuple_slot_id),
+        index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+}
+
+static bool SameValue(const Value &left, const Value &right) {
+  if (left.IsNull() || right.IsNull()) return left.IsNull() == right.IsNull();
+  return left.Compare(right) == VALUE_COMPARE_EQUAL;
+}
+
+TEST_F(FrozenTileGroupTests, EncodingTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateColdTileGroup(tile_group);
+
+  std::unique_ptr<storage::TileGroup> frozen_tile_group(
+      storage::TileGroupFactory::GetFrozenTileGroup(tile_group.get(), {}));
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+  EXPECT_FALSE(tile_group->IsFrozen());
+  EXPECT_EQ(tile_group->GetTileGroupId(),
+            frozen_tile_group->GetTileGroupId());
+  EXPECT_EQ(tuple_count, frozen_tile_group->GetNextTupleSlot());
+
+  // Each column gets the encoding that suits it
+  auto integer_tile = frozen_tile_group->GetTile(0);
+  auto mixed_tile = frozen_tile_group->GetTile(1);
+  EXPECT_EQ(storage::EncodedColumn::ENCODING_TYPE_RLE,
+            integer_tile->GetEncodedColumn(0)->GetEncodingType());
+  EXPECT_EQ(storage::EncodedColumn::ENCODING_TYPE_BITPACKED,
+            integer_tile->GetEncodedColumn(1)->GetEncodingType());
+  EXPECT_EQ(storage::EncodedColumn::ENCODING_TYPE_PLAIN,
+            mixed_tile->GetEncodedColumn(0)->GetEncodingType());
+  EXPECT_EQ(storage::EncodedColumn::ENCODING_TYPE_DICTIONARY,
+            mixed_tile->GetEncodedColumn(1)->GetEncodingType());
+  EXPECT_LT(integer_tile->GetEncodedSize(),
+            tile_group->GetTile(0)->GetInlinedSize());
+
+  // Values read the same
+  for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      EXPECT_TRUE(SameValue(tile_group->GetValue(tuple_itr, column_itr),
+                            frozen_tile_group->GetValue(tuple_itr, column_itr)))
+          << "column " << column_itr << " tuple " << tuple_itr;
+    }
+  }
+
+  // A decoded batch matches the hot tile's fields
+  auto hot_tile = tile_group->GetTile(0);
+  auto hot_schema = hot_tile->GetSchema();
+  for (oid_t column_itr = 0; column_itr < 2; column_itr++) {
+    auto encoded_column = integer_tile->GetEncodedColumn(column_itr);
+    const oid_t begin = 13, count = 101;
+    std::vector<char> batch(count * encoded_column->GetFieldLength());
+    encoded_column->Decode(begin, count, batch.data());
+
+    for (oid_t tuple_itr = 0; tuple_itr < count; tuple_itr++) {
+      auto field = hot_tile->GetTupleLocation(begin + tuple_itr) +
+                   hot_schema->GetOffset(column_itr);
+      EXPECT_EQ(*reinterpret_cast<const int32_t *>(field),
+                reinterpret_cast<const int32_t *>(batch.data())[tuple_itr]);
+    }
+  }
+}
+
+TEST_F(FrozenTileGroupTests, ZoneMapTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateColdTileGroup(tile_group);
+
+  std::unique_ptr<storage::TileGroup> frozen_tile_group(
+      storage::TileGroupFactory::GetFrozenTileGroup(tile_group.get(), {}));
+  auto zone_map = frozen_tile_group->GetZoneMap();
+  ASSERT_TRUE(zone_map != nullptr);
+
+  // Rebuilding at freeze time gives what inserts maintained
+  auto hot_zone_map = tile_group->GetZoneMap();
+  ASSERT_TRUE(hot_zone_map != nullptr);
+  EXPECT_EQ(hot_zone_map->GetInfo(), zone_map->GetInfo());
+
+  Value min, max;
+  EXPECT_TRUE(zone_map->GetRange(0, &min, &max));
+  EXPECT_TRUE(SameValue(ValueFactory::GetIntegerValue(0), min));
+  EXPECT_TRUE(
+      SameValue(ValueFactory::GetIntegerValue((tuple_count - 1) / 50), max));
+  EXPECT_EQ(0, zone_map->GetNullCount(0));
+
+  EXPECT_TRUE(zone_map->GetRange(1, &min, &max));
+  EXPECT_EQ(tuple_count / 10, zone_map->GetNullCount(1));
+
+  EXPECT_TRUE(zone_map->GetRange(3, &min, &max));
+  EXPECT_TRUE(SameValue(ValueFactory::GetStringValue("status_0"), min));
+  EXPECT_TRUE(SameValue(ValueFactory::GetStringValue("status_4"), max));
+  EXPECT_EQ((tuple_count + 6) / 7, zone_map->GetNullCount(3));
+}
+
+TEST_F(FrozenTileGroupTests, CompiledScanTest) {
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  PopulateColdTileGroup(tile_group);
+
+  std::unique_ptr<storage::TileGroup> frozen_tile_group(
+      storage::TileGroupFactory::GetFrozenTileGroup(tile_group.get(), {}));
+
+  // COL_B > 5500 AND COL_D = 'status_3'
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                            0, 1),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetIntegerValue(5500))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_EQUAL,
+              expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR,
+                                                            0, 3),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  ValueFactory::GetStringValue("status_3")))));
+
+  auto program = expression::CompiledExpression::Compile(
+      predicate.get(),
+      expression::CompiledExpression::GetColumnTypes(tile_group.get()), {},
+      nullptr);
+  ASSERT_TRUE(program != nullptr);
+  ASSERT_TRUE(program->Bind(0, frozen_tile_group.get()));
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                         tuple_itr);
+    EXPECT_EQ(predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue(),
+              program->EvaluatesTrue(tuple_itr));
+  }
+}
+
+TEST_F(FrozenTileGroupTests, DataTableTest) {
+  const int tuples_per_tile_group = 10;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 3 * tuples_per_tile_group,
+                                   false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The active tile group still takes inserts
+  auto last_offset = table->GetTileGroupCount() - 1;
+  EXPECT_FALSE(table->FreezeTileGroup(last_offset));
+
+  // A version owned by a running transaction keeps the tile group hot
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(txn, tile_group->GetHeader(), 0));
+  EXPECT_FALSE(table->FreezeTileGroup(0));
+  txn_manager.YieldOwnership(txn, tile_group_id, 0);
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_TRUE(table->FreezeTileGroup(0));
+  EXPECT_FALSE(table->FreezeTileGroup(0));
+  auto frozen_tile_group = table->GetTileGroup(0);
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+  EXPECT_EQ(tile_group_id, frozen_tile_group->GetTileGroupId());
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuples_per_tile_group; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+      EXPECT_TRUE(SameValue(tile_group->GetValue(tuple_itr, column_itr),
+                            frozen_tile_group->GetValue(tuple_itr, column_itr)));
+    }
+  }
+
+  // Frozen tiles take no tuples in place
+  std::unique_ptr<storage::Tuple> tuple(
+      new storage::Tuple(table->GetSchema(), true));
+  frozen_tile_group->CopyTuple(0, tuple.get());
+  EXPECT_FALSE(frozen_tile_group->CopyTuple(tuple.get(), 0));
+  EXPECT_EQ(INVALID_OID,
+            frozen_tile_group->InsertTupleFromRecovery(1, 0, tuple.get()));
+  EXPECT_EQ(INVALID_OID,
+            frozen_tile_group->InsertTupleFromCheckpoint(0, tuple.get(), 1));
+
+  // Updating a frozen tuple moves its new version to a hot tile group
+  txn = txn_manager.BeginTransaction();
+  auto frozen_header = frozen_tile_group->GetHeader();
+  ItemPointer old_location(tile_group_id, 0);
+  EXPECT_TRUE(txn_manager.PerformRead(txn, old_location));
+  EXPECT_TRUE(txn_manager.AcquireOwnership(txn, frozen_header, 0));
+
+  ItemPointer new_location = table->AcquireVersion();
+  auto new_tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(new_location.block);
+  EXPECT_FALSE(new_tile_group->IsFrozen());
+
+  std::unique_ptr<storage::Tuple> new_tuple(
+      new storage::Tuple(table->GetSchema(), true));
+  frozen_tile_group->CopyTuple(0, new_tuple.get());
+  new_tuple->SetValue(0, ValueFactory::GetIntegerValue(-1), nullptr);
+  EXPECT_TRUE(new_tile_group->CopyTuple(new_tuple.get(), new_location.offset));
+  txn_manager.PerformUpdate(txn, old_location, new_location);
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_NE(MAX_CID, frozen_header->GetEndCommitId(0));
+  EXPECT_EQ(new_location.block, frozen_header->GetPrevItemPointer(0).block);
+  EXPECT_TRUE(SameValue(ValueFactory::GetIntegerValue(-1),
+                        new_tile_group->GetValue(new_location.offset, 0)));
+}
+
+TEST_F(FrozenTileGroupTests, ConcurrentWriteTest) {
+  const int tuples_per_tile_group = 10;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 3 * tuples_per_tile_group,
+                                   false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // A transaction gets hold of the hot tile group before the freeze
+  auto tile_group = table->GetTileGroup(0);
+  auto header = tile_group->GetHeader();
+  txn = txn_manager.BeginTransaction();
+
+  // The freeze waits for it
+  std::atomic<bool> frozen(false);
+  std::thread freeze_thread([&table, &frozen] {
+    frozen = table->FreezeTileGroup(0);
+  });
+  while (header->GetTransactionId(tuples_per_tile_group - 1) ==
+         INITIAL_TXN_ID) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Its writes to the hot tile group would be lost, they conflict instead
+  EXPECT_FALSE(txn_manager.IsOwnable(txn, header, 0));
+  EXPECT_FALSE(txn_manager.AcquireOwnership(txn, header, 0));
+  EXPECT_FALSE(frozen);
+  txn_manager.AbortTransaction(txn);
+
+  freeze_thread.join();
+  EXPECT_TRUE(frozen);
+
+  // The frozen versions are free to be written
+  auto frozen_tile_group = table->GetTileGroup(0);
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+  auto frozen_header = frozen_tile_group->GetHeader();
+  txn = txn_manager.BeginTransaction();
+  for (oid_t tuple_itr = 0; tuple_itr < tuples_per_tile_group; tuple_itr++) {
+    EXPECT_EQ(INITIAL_TXN_ID, frozen_header->GetTransactionId(tuple_itr));
+    EXPECT_TRUE(txn_manager.PerformRead(
+        txn, ItemPointer(frozen_tile_group->GetTileGroupId(), tuple_itr)));
+  }
+  EXPECT_TRUE(txn_manager.AcquireOwnership(txn, frozen_header, 0));
+  txn_manager.YieldOwnership(txn, frozen_tile_group->GetTileGroupId(), 0);
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+}  // End test namespace
+}  // End peloton namespace
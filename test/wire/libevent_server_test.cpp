@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// libevent_server_test.cpp
+//
+// Identification: test/wire/libevent_server_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "wire/libevent_server.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Libevent Server Tests
+//===--------------------------------------------------------------------===//
+
+class LibeventServerTests : public PelotonTest {};
+
+// Hand the loop the server end of a new socket pair, returns the client end
+static int Connect(wire::ServerLoop &loop, unsigned int id) {
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+  // Accepted sockets are non-blocking
+  fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+
+  struct timeval timeout = {10, 0};
+  setsockopt(fds[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  auto socket_manager = new wire::SocketManager<wire::PktBuf>(fds[0], id);
+  socket_manager->socket_pkt_manager.reset(
+      new wire::PacketManager(socket_manager));
+  loop.AddConnection(socket_manager);
+  return fds[1];
+}
+
+static bool WaitForConnectionCount(const wire::ServerLoop &loop,
+                                   size_t count) {
+  for (int wait_itr = 0; wait_itr < 10000; wait_itr++) {
+    if (loop.GetConnectionCount() == count) return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+static bool SendBytes(int fd, const std::vector<unsigned char> &bytes) {
+  size_t sent = 0;
+  while (sent < bytes.size()) {
+    ssize_t count = send(fd, bytes.data() + sent, bytes.size() - sent, 0);
+    if (count <= 0) return false;
+    sent += count;
+  }
+  return true;
+}
+
+static bool ReceiveBytes(int fd, unsigned char *bytes, size_t len) {
+  size_t received = 0;
+  while (received < len) {
+    ssize_t count = recv(fd, bytes + received, len - received, 0);
+    if (count <= 0) return false;
+    received += count;
+  }
+  return true;
+}
+
+// Read messages until ReadyForQuery
+static bool WaitForReady(int fd) {
+  for (;;) {
+    unsigned char header[5];
+    if (!ReceiveBytes(fd, header, sizeof(header))) return false;
+    uint32_t len;
+    memcpy(&len, header + 1, sizeof(len));
+    std::vector<unsigned char> body(ntohl(len) - sizeof(len));
+    if (!ReceiveBytes(fd, body.data(), body.size())) return false;
+    if (header[0] == 'Z') return true;
+  }
+}
+
+// Send the startup packet, protocol 3.0, and wait for the session
+static bool Startup(int fd) {
+  std::string options("user\0postgres\0database\0default\0\0", 32);
+  uint32_t len = htonl(8 + options.size());
+  uint32_t version = htonl(3 << 16);
+  std::vector<unsigned char> startup(8);
+  memcpy(startup.data(), &len, 4);
+  memcpy(startup.data() + 4, &version, 4);
+  startup.insert(startup.end(), options.begin(), options.end());
+
+  return SendBytes(fd, startup) && WaitForReady(fd);
+}
+
+// A round trip on an open session
+static bool Sync(int fd) {
+  const std::vector<unsigned char> sync = {'S', 0, 0, 0, 4};
+  return SendBytes(fd, sync) && WaitForReady(fd);
+}
+
+TEST_F(LibeventServerTests, ConnectionTest) {
+  wire::ServerLoop first_loop(0, 0);
+  wire::ServerLoop second_loop(1, 0);
+  first_loop.Start();
+  second_loop.Start();
+
+  // Each loop serves the connections handed to it
+  std::vector<int> clients;
+  clients.push_back(Connect(first_loop, 1));
+  clients.push_back(Connect(second_loop, 2));
+  clients.push_back(Connect(first_loop, 3));
+  EXPECT_TRUE(WaitForConnectionCount(first_loop, 2));
+  EXPECT_TRUE(WaitForConnectionCount(second_loop, 1));
+  for (auto fd : clients) {
+    EXPECT_TRUE(Startup(fd));
+  }
+
+  // A client going away removes its connection from its own loop only
+  close(clients[0]);
+  EXPECT_TRUE(WaitForConnectionCount(first_loop, 1));
+  EXPECT_EQ(1, second_loop.GetConnectionCount());
+
+  // The next connection likely reuses the closed descriptor, it must not
+  // be closed again behind the new connection's back
+  clients[0] = Connect(first_loop, 4);
+  EXPECT_TRUE(WaitForConnectionCount(first_loop, 2));
+  EXPECT_TRUE(Startup(clients[0]));
+  for (auto fd : clients) {
+    EXPECT_TRUE(Sync(fd));
+  }
+
+  // A client closing during its startup
+  int client = Connect(second_loop, 5);
+  EXPECT_TRUE(WaitForConnectionCount(second_loop, 2));
+  close(client);
+  EXPECT_TRUE(WaitForConnectionCount(second_loop, 1));
+  EXPECT_TRUE(Sync(clients[1]));
+
+  // The loops close the connections left when they go away
+  first_loop.Stop();
+  second_loop.Stop();
+  for (auto fd : clients) {
+    close(fd);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
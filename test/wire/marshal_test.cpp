@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// marshal_test.cpp
+//
+// Identification: test/wire/marshal_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "wire/marshal.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Marshal Tests
+//===--------------------------------------------------------------------===//
+
+class MarshalTests : public PelotonTest {};
+
+// Write a value as a column, then read back its length and bytes
+static wire::PktBuf PutValue(const Value &value, const PostgresValueType type,
+                             const int format) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  wire::PacketPutValue(pkt, value, type, format);
+
+  wire::PktBuf data;
+  int len = wire::PacketGetInt(pkt.get(), 4);
+  EXPECT_EQ(pkt->len, len + 4);
+  wire::PacketGetBytes(pkt.get(), len, data);
+  return data;
+}
+
+// Encode a value in binary as a data row does and decode it as a bind
+// parameter is
+static Value RoundTrip(const Value &value, const PostgresValueType type) {
+  auto data = PutValue(value, type, BINARY_FORMAT_CODE);
+
+  Value result;
+  EXPECT_TRUE(wire::PacketGetBinaryValue(data, type, result));
+  return result;
+}
+
+TEST_F(MarshalTests, BinaryValueTest) {
+  // The minimum of each integer type is its NULL
+  for (int16_t n : std::vector<int16_t>(
+           {0, 1, -1, 12345, std::numeric_limits<int16_t>::min() + 1,
+            std::numeric_limits<int16_t>::max()})) {
+    auto value = ValueFactory::GetSmallIntValue(n);
+    EXPECT_EQ(2, PutValue(value, POSTGRES_VALUE_TYPE_SMALLINT,
+                          BINARY_FORMAT_CODE).size());
+    auto result = RoundTrip(value, POSTGRES_VALUE_TYPE_SMALLINT);
+    EXPECT_EQ(VALUE_TYPE_SMALLINT, result.GetValueType());
+    EXPECT_EQ(n, ValuePeeker::PeekSmallInt(result));
+  }
+
+  for (int32_t n : std::vector<int32_t>(
+           {0, 1, -1, 1 << 20, std::numeric_limits<int32_t>::min() + 1,
+            std::numeric_limits<int32_t>::max()})) {
+    auto value = ValueFactory::GetIntegerValue(n);
+    EXPECT_EQ(4, PutValue(value, POSTGRES_VALUE_TYPE_INTEGER,
+                          BINARY_FORMAT_CODE).size());
+    auto result = RoundTrip(value, POSTGRES_VALUE_TYPE_INTEGER);
+    EXPECT_EQ(VALUE_TYPE_INTEGER, result.GetValueType());
+    EXPECT_EQ(n, ValuePeeker::PeekInteger(result));
+  }
+
+  for (int64_t n : std::vector<int64_t>(
+           {0, 1, -1, 1L << 40, std::numeric_limits<int64_t>::min() + 1,
+            std::numeric_limits<int64_t>::max()})) {
+    auto value = ValueFactory::GetBigIntValue(n);
+    EXPECT_EQ(8, PutValue(value, POSTGRES_VALUE_TYPE_BIGINT,
+                          BINARY_FORMAT_CODE).size());
+    auto result = RoundTrip(value, POSTGRES_VALUE_TYPE_BIGINT);
+    EXPECT_EQ(VALUE_TYPE_BIGINT, result.GetValueType());
+    EXPECT_EQ(n, ValuePeeker::PeekBigInt(result));
+  }
+
+  for (double n : {0.0, -0.5, 3.141592653589793, 1e300, -1e-300}) {
+    auto value = ValueFactory::GetDoubleValue(n);
+    EXPECT_EQ(8, PutValue(value, POSTGRES_VALUE_TYPE_DOUBLE,
+                          BINARY_FORMAT_CODE).size());
+    auto result = RoundTrip(value, POSTGRES_VALUE_TYPE_DOUBLE);
+    EXPECT_EQ(VALUE_TYPE_DOUBLE, result.GetValueType());
+    EXPECT_EQ(n, ValuePeeker::PeekDouble(result));
+  }
+
+  // The binary format of text is its bytes
+  for (std::string str :
+       {std::string(), std::string("peloton"), std::string("with\0nul", 8),
+        std::string(1000, 'x')}) {
+    auto value = ValueFactory::GetStringValue(str);
+    auto data = PutValue(value, POSTGRES_VALUE_TYPE_TEXT, BINARY_FORMAT_CODE);
+    EXPECT_EQ(str, std::string(data.begin(), data.end()));
+    auto result = RoundTrip(value, POSTGRES_VALUE_TYPE_TEXT);
+    EXPECT_EQ(VALUE_TYPE_VARCHAR, result.GetValueType());
+    EXPECT_EQ(str, ValuePeeker::PeekStringCopyWithoutNull(result));
+  }
+
+  // NULL is a -1 length whatever the format
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  auto null_value = ValueFactory::GetNullValueByType(VALUE_TYPE_INTEGER);
+  wire::PacketPutValue(pkt, null_value, POSTGRES_VALUE_TYPE_INTEGER,
+                       BINARY_FORMAT_CODE);
+  EXPECT_EQ(-1, wire::PacketGetInt(pkt.get(), 4));
+}
+
+TEST_F(MarshalTests, TextValueTest) {
+  // Text columns are what a text bind parameter is cast from
+  std::vector<std::pair<Value, PostgresValueType>> values = {
+      {ValueFactory::GetSmallIntValue(-12345), POSTGRES_VALUE_TYPE_SMALLINT},
+      {ValueFactory::GetIntegerValue(-1 << 20), POSTGRES_VALUE_TYPE_INTEGER},
+      {ValueFactory::GetBigIntValue(-(1L << 40)), POSTGRES_VALUE_TYPE_BIGINT},
+      {ValueFactory::GetDoubleValue(-0.5), POSTGRES_VALUE_TYPE_DOUBLE},
+      {ValueFactory::GetStringValue("peloton"), POSTGRES_VALUE_TYPE_TEXT}};
+
+  for (auto &entry : values) {
+    auto &value = entry.first;
+    auto data = PutValue(value, entry.second, TEXT_FORMAT_CODE);
+    EXPECT_EQ(Value(value).ToString(), std::string(data.begin(), data.end()));
+
+    auto result = ValueFactory::GetStringValue(
+                      std::string(data.begin(), data.end()))
+                      .CastAs(value.GetValueType());
+    EXPECT_EQ(value.GetValueType(), result.GetValueType());
+    EXPECT_TRUE(value == result);
+  }
+}
+
+TEST_F(MarshalTests, MalformedBinaryValueTest) {
+  // A length that does not match the type is rejected
+  Value result;
+  wire::PktBuf data(3, 0);
+  EXPECT_FALSE(wire::PacketGetBinaryValue(data, POSTGRES_VALUE_TYPE_SMALLINT,
+                                          result));
+  EXPECT_FALSE(wire::PacketGetBinaryValue(data, POSTGRES_VALUE_TYPE_INTEGER,
+                                          result));
+  EXPECT_FALSE(wire::PacketGetBinaryValue(data, POSTGRES_VALUE_TYPE_BIGINT,
+                                          result));
+  EXPECT_FALSE(wire::PacketGetBinaryValue(data, POSTGRES_VALUE_TYPE_DOUBLE,
+                                          result));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,328 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// packet_manager_test.cpp
+//
+// Identification: test/wire/packet_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/statement.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+#include "wire/marshal.h"
+#include "wire/wire.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Packet Manager Tests
+//===--------------------------------------------------------------------===//
+
+class PacketManagerTests : public PelotonTest {};
+
+// Process a message of the client, returns the type of its first response
+static wire::uchar Process(wire::PacketManager &packet_manager,
+                           std::unique_ptr<wire::Packet> &pkt) {
+  wire::ResponseBuffer responses;
+  EXPECT_TRUE(packet_manager.ProcessPacket(pkt.get(), responses));
+  return responses.empty() ? 0 : responses[0]->msg_type;
+}
+
+// Bind a portal to the statement with a text parameter
+static std::unique_ptr<wire::Packet> BindMessage(
+    const std::string &portal_name, const std::string &statement_name,
+    const std::string &param) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  pkt->msg_type = 'B';
+  wire::PacketPutString(pkt, portal_name);
+  wire::PacketPutString(pkt, statement_name);
+  // all the parameters as text
+  wire::PacketPutInt(pkt, 0, 2);
+  wire::PacketPutInt(pkt, 1, 2);
+  wire::PacketPutInt(pkt, param.size(), 4);
+  wire::PacketPutCbytes(pkt, (const wire::uchar *)param.c_str(),
+                        param.size());
+  // all the result columns as text
+  wire::PacketPutInt(pkt, 0, 2);
+  return pkt;
+}
+
+// Bind a portal to the statement with a binary int4 parameter, and the
+// given format for each result column
+static std::unique_ptr<wire::Packet> BinaryBindMessage(
+    const std::string &portal_name, const std::string &statement_name,
+    int param, const std::vector<int> &result_formats) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  pkt->msg_type = 'B';
+  wire::PacketPutString(pkt, portal_name);
+  wire::PacketPutString(pkt, statement_name);
+  // a single format code applies to all the parameters
+  wire::PacketPutInt(pkt, 1, 2);
+  wire::PacketPutInt(pkt, BINARY_FORMAT_CODE, 2);
+  wire::PacketPutInt(pkt, 1, 2);
+  wire::PacketPutInt(pkt, 4, 4);
+  wire::PacketPutInt(pkt, param, 4);
+  wire::PacketPutInt(pkt, result_formats.size(), 2);
+  for (auto format : result_formats) {
+    wire::PacketPutInt(pkt, format, 2);
+  }
+  return pkt;
+}
+
+static std::unique_ptr<wire::Packet> ExecuteMessage(
+    const std::string &portal_name) {
+  std::unique_ptr<wire::Packet> pkt(new wire::Packet());
+  pkt->msg_type = 'E';
+  wire::PacketPutString(pkt, portal_name);
+  wire::PacketPutInt(pkt, 0, 4);
+  return pkt;
+}
+
+// The first column of the data rows the server wrote to the socket
+static std::vector<std::string> ReadFirstColumns(
+    wire::SocketManager<wire::PktBuf> &socket, int client_fd) {
+  EXPECT_TRUE(socket.FlushWriteBuffer());
+
+  std::vector<wire::uchar> data(8192);
+  ssize_t size = read(client_fd, data.data(), data.size());
+  EXPECT_GT(size, 0);
+
+  std::vector<std::string> columns;
+  ssize_t offset = 0;
+  while (offset + 5 <= size) {
+    wire::uchar type = data[offset];
+    int len = (data[offset + 1] << 24) | (data[offset + 2] << 16) |
+              (data[offset + 3] << 8) | data[offset + 4];
+    // DataRow : column count, then the length and bytes of each column
+    if (type == 'D') {
+      int column_len = (data[offset + 7] << 24) | (data[offset + 8] << 16) |
+                       (data[offset + 9] << 8) | data[offset + 10];
+      columns.emplace_back(data.begin() + offset + 11,
+                           data.begin() + offset + 11 + column_len);
+    }
+    offset += 1 + len;
+  }
+  return columns;
+}
+
+// The columns of the data rows the server wrote to the socket
+static std::vector<std::vector<std::string>> ReadRows(
+    wire::SocketManager<wire::PktBuf> &socket, int client_fd) {
+  EXPECT_TRUE(socket.FlushWriteBuffer());
+
+  std::vector<wire::uchar> data(8192);
+  ssize_t size = read(client_fd, data.data(), data.size());
+  EXPECT_GT(size, 0);
+
+  auto get_int = [&data](ssize_t offset, int base) {
+    int n = 0;
+    for (int byte_itr = 0; byte_itr < base; byte_itr++) {
+      n = (n << 8) | data[offset + byte_itr];
+    }
+    return n;
+  };
+
+  std::vector<std::vector<std::string>> rows;
+  ssize_t offset = 0;
+  while (offset + 5 <= size) {
+    wire::uchar type = data[offset];
+    int len = get_int(offset + 1, 4);
+    if (type == 'D') {
+      std::vector<std::string> row;
+      int column_count = get_int(offset + 5, 2);
+      ssize_t column_offset = offset + 7;
+      for (int column_itr = 0; column_itr < column_count; column_itr++) {
+        int column_len = get_int(column_offset, 4);
+        row.emplace_back(data.begin() + column_offset + 4,
+                         data.begin() + column_offset + 4 + column_len);
+        column_offset += 4 + column_len;
+      }
+      rows.push_back(row);
+    }
+    offset += 1 + len;
+  }
+  return rows;
+}
+
+// The big endian bytes of a binary column
+template <typename T>
+static std::string BinaryColumn(T value) {
+  std::string column(sizeof(T), 0);
+  for (size_t byte_itr = 0; byte_itr < sizeof(T); byte_itr++) {
+    column[sizeof(T) - 1 - byte_itr] = (value >> (8 * byte_itr)) & 0xff;
+  }
+  return column;
+}
+
+TEST_F(PacketManagerTests, PortalParametersTest) {
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 20, false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // SELECT a FROM t WHERE a = $1 on the primary key
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(0), {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+      {ValueFactory::GetBindingOnlyIntegerValue(0)}, {});
+  std::shared_ptr<planner::AbstractPlan> plan(
+      new planner::IndexScanPlan(table.get(), nullptr, {0}, index_scan_desc));
+
+  std::shared_ptr<Statement> statement(
+      new Statement("lookup", "SELECT a FROM t WHERE a = $1"));
+  statement->SetQueryType("SELECT");
+  statement->SetParamTypes({POSTGRES_VALUE_TYPE_INTEGER});
+  statement->SetTupleDescriptor(
+      {std::make_tuple("a", POSTGRES_VALUE_TYPE_INTEGER, 4)});
+  statement->SetPlanTree(plan);
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  wire::SocketManager<wire::PktBuf> socket(fds[0], 0);
+  {
+    wire::PacketManager packet_manager(&socket);
+    packet_manager.statement_cache_.insert(
+        std::make_pair("lookup", statement));
+
+    // Two portals of the statement bound before either executes
+    auto bind_first = BindMessage("first", "lookup", "30");
+    auto bind_second = BindMessage("second", "lookup", "70");
+    EXPECT_EQ('2', Process(packet_manager, bind_first));
+    EXPECT_EQ('2', Process(packet_manager, bind_second));
+
+    // Each portal runs with its own parameters
+    auto execute_first = ExecuteMessage("first");
+    EXPECT_EQ('C', Process(packet_manager, execute_first));
+    EXPECT_EQ(std::vector<std::string>({"30"}),
+              ReadFirstColumns(socket, fds[1]));
+
+    auto execute_second = ExecuteMessage("second");
+    EXPECT_EQ('C', Process(packet_manager, execute_second));
+    EXPECT_EQ(std::vector<std::string>({"70"}),
+              ReadFirstColumns(socket, fds[1]));
+
+    // And again, on the executor tree kept by the statement
+    execute_first = ExecuteMessage("first");
+    EXPECT_EQ('C', Process(packet_manager, execute_first));
+    EXPECT_EQ(std::vector<std::string>({"30"}),
+              ReadFirstColumns(socket, fds[1]));
+
+    std::unique_ptr<wire::Packet> sync(new wire::Packet());
+    sync->msg_type = 'S';
+    EXPECT_EQ('Z', Process(packet_manager, sync));
+  }
+
+  socket.CloseSocket();
+  close(fds[1]);
+}
+
+TEST_F(PacketManagerTests, ResultFormatsTest) {
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 20, false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // SELECT a, b, c, d FROM t WHERE a = $1 on the primary key
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(0), {0}, {EXPRESSION_TYPE_COMPARE_EQUAL},
+      {ValueFactory::GetBindingOnlyIntegerValue(0)}, {});
+  std::shared_ptr<planner::AbstractPlan> plan(new planner::IndexScanPlan(
+      table.get(), nullptr, {0, 1, 2, 3}, index_scan_desc));
+
+  std::shared_ptr<Statement> statement(
+      new Statement("lookup", "SELECT a, b, c, d FROM t WHERE a = $1"));
+  statement->SetQueryType("SELECT");
+  statement->SetParamTypes({POSTGRES_VALUE_TYPE_INTEGER});
+  statement->SetTupleDescriptor(
+      {std::make_tuple("a", POSTGRES_VALUE_TYPE_INTEGER, 4),
+       std::make_tuple("b", POSTGRES_VALUE_TYPE_BIGINT, 8),
+       std::make_tuple("c", POSTGRES_VALUE_TYPE_DOUBLE, 8),
+       std::make_tuple("d", POSTGRES_VALUE_TYPE_TEXT, 255)});
+  statement->SetPlanTree(plan);
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  wire::SocketManager<wire::PktBuf> socket(fds[0], 0);
+  {
+    wire::PacketManager packet_manager(&socket);
+    packet_manager.statement_cache_.insert(
+        std::make_pair("lookup", statement));
+
+    int tuple_id = 3;
+    auto a = ExecutorTestsUtil::PopulatedValue(tuple_id, 0);
+    auto b = ExecutorTestsUtil::PopulatedValue(tuple_id, 1);
+    double c = ExecutorTestsUtil::PopulatedValue(tuple_id, 2);
+    auto d = std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_id, 3));
+    uint64_t c_bits;
+    memcpy(&c_bits, &c, sizeof(c_bits));
+
+    // Each column in its own format, b is sent as the int8 it is described
+    // as rather than the integer it is stored as
+    auto bind_mixed = BinaryBindMessage(
+        "mixed", "lookup", a, {BINARY_FORMAT_CODE, BINARY_FORMAT_CODE,
+                               TEXT_FORMAT_CODE, BINARY_FORMAT_CODE});
+    EXPECT_EQ('2', Process(packet_manager, bind_mixed));
+    auto execute_mixed = ExecuteMessage("mixed");
+    EXPECT_EQ('C', Process(packet_manager, execute_mixed));
+    EXPECT_EQ(std::vector<std::vector<std::string>>(
+                  {{BinaryColumn<int32_t>(a), BinaryColumn<int64_t>(b),
+                    Value(ValueFactory::GetDoubleValue(c)).ToString(), d}}),
+              ReadRows(socket, fds[1]));
+
+    // And the other way around
+    auto bind_swapped = BinaryBindMessage(
+        "swapped", "lookup", a, {TEXT_FORMAT_CODE, TEXT_FORMAT_CODE,
+                                 BINARY_FORMAT_CODE, TEXT_FORMAT_CODE});
+    EXPECT_EQ('2', Process(packet_manager, bind_swapped));
+    auto execute_swapped = ExecuteMessage("swapped");
+    EXPECT_EQ('C', Process(packet_manager, execute_swapped));
+    EXPECT_EQ(std::vector<std::vector<std::string>>(
+                  {{std::to_string(a), std::to_string(b),
+                    BinaryColumn<uint64_t>(c_bits), d}}),
+              ReadRows(socket, fds[1]));
+
+    // A parameter of the wrong length is rejected
+    std::unique_ptr<wire::Packet> bind_short(new wire::Packet());
+    bind_short->msg_type = 'B';
+    wire::PacketPutString(bind_short, "short");
+    wire::PacketPutString(bind_short, "lookup");
+    wire::PacketPutInt(bind_short, 1, 2);
+    wire::PacketPutInt(bind_short, BINARY_FORMAT_CODE, 2);
+    wire::PacketPutInt(bind_short, 1, 2);
+    wire::PacketPutInt(bind_short, 2, 4);
+    wire::PacketPutInt(bind_short, a, 2);
+    wire::PacketPutInt(bind_short, 0, 2);
+    EXPECT_EQ('E', Process(packet_manager, bind_short));
+
+    std::unique_ptr<wire::Packet> sync(new wire::Packet());
+    sync->msg_type = 'S';
+    EXPECT_EQ('Z', Process(packet_manager, sync));
+  }
+
+  socket.CloseSocket();
+  close(fds[1]);
+}
+
+}  // End test namespace
+}  // End peloton namespace